@@ -0,0 +1,419 @@
+/*
+ * bench.c
+ * Benchmark de randare: cost SPI per frame, ca CSV
+ *
+ * Scenarii:
+ *   menu       - fiecare ecran desenat de Menu_DrawCurrent (un rand per ecran)
+ *   countdown  - Game_Start + tick-uri pana la capatul countdown-ului
+ *   gameplay   - N secunde de Game_Update la 50 Hz, CPU vs CPU
+ *   restart    - acelasi countdown, cand un meci se termina in timpul gameplay-ului
+ *
+ * Coloane: scenario,frame,bytes,windows,cs_toggles,pixels,wire_us,elapsed_us
+ *   wire_us    = octeti * timpul unui octet la viteza SPI configurata
+ *   elapsed_us = timp virtual scurs (include delay_ms din animatii)
+ *
+ * Utilizare:
+ *   ./pong_bench [-s secunde] [-r seed] [-o fisier.csv]
+ *   ./pong_bench -p pasi [-r seed]   - doar Physics_Step, pasi/secunda pe host;
+ *                                      swept la viteza maxima, colturi, paleta
+ *                                      care intra in minge
+ *   ./pong_bench -a stari [-r seed]  - Physics_InterceptY vs varianta iterativa:
+ *                                      ns / ticuri TSC per apel pe host (M0+ nemasurat)
+ *   ./pong_bench -n cadre [-r seed]  - decodorul NEC pe latimi de puls sintetice
+ *   ./pong_bench -j trace [-o f.csv] - filtrul ADC al joystick-ului pe un traseu
+ *                                      (un esantion pe linie, la JOYSTICK_SAMPLE_HZ;
+ *                                      "synth" = treapta cu zgomot, din -r seed)
+ *   ./pong_bench -k                  - scenarii pentru scheduler.c pe timpul simulat
+ *   ./pong_bench -w secunde          - meniu in asteptare: input la 1 ms + WAIT,
+ *                                      input la 10 ms + WAIT, input la 10 ms + VLPS
+ *                                      tickless, acelasi in VLPR (rezidenta, treziri/s,
+ *                                      curent estimat, latenta buton, derivatia
+ *                                      g_systick_ms)
+ *   ./pong_bench -u                  - secventiatorul audio pe timpul simulat: nota
+ *                                      TPM2 la mijlocul fiecarei note, durata,
+ *                                      prioritati, schimbare RUN/VLPR in mijlocul
+ *                                      unei note (cu -DAUDIO_DAC: frecventa din
+ *                                      iesirea DAC0, polifonie)
+ *   ./pong_bench -m esantioane       - mixerul din synth.c: corectitudine si
+ *                                      ns / ticuri TSC per esantion, 1..4 voci
+ *   ./pong_bench -f                  - kv_store.c pe flash-ul simulat: persistenta,
+ *                                      uzura pe sectoare, CRC, caderi de tensiune
+ *                                      la fiecare operatie flash, latenta scrierii
+ *   ./pong_bench -l                  - log.c golit de UART0 TX: formatare, ring plin,
+ *                                      cost per LOG, schimbare RUN/VLPR si VLPS in
+ *                                      timpul golirii (cu -DLOG_TOKENIZED: cadrele
+ *                                      decodate cu logtok.c, octeti pe fir vs text)
+ *   ./pong_bench -g [-s secunde]     - profiler.c (build cu -DPROFILER): cosurile,
+ *                                      faza spi vs timpul pe fir, latenta input ->
+ *                                      ecran vs paletele de pe panou, gameplay cu
+ *                                      dump-ul [PROF] citit inapoi de profdump.c
+ *   ./pong_bench -d                  - coada DMA din st7735_simple.c: SAR/DAR/BCR/DCR
+ *                                      per descriptor, umplerea SMOD, CS/DC pe fir,
+ *                                      asteptarea cu coada plina
+ *   ./pong_bench -e                  - coada de input: rafale din ISR-urile butonului
+ *                                      (cu sarituri), TPM1 (NEC) si ADC0; ordinea
+ *                                      stamp-urilor, pierderi sub / peste capacitate,
+ *                                      latenta raportata de InputEvents_GetStats
+ *   ./pong_bench -t                  - costul SPI per ecran de meniu (build cu
+ *                                      -DST7735_STATS): textul opac celula cu
+ *                                      celula vs DrawTextLine, aceiasi pixeli
+ *
+ * Scenariile de randare si main() sunt aici; fiecare mod de mai sus e in
+ * bench_<modul>.c, cu verificarile si asteptarea comune din bench.h.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "bench.h"
+#include "sim.h"
+#include "panel.h"
+#include "shim/board.h"
+#include "../source/drivers/headers/game_config.h"
+#include "../source/drivers/headers/st7735_simple.h"
+#include "../source/drivers/headers/joystick.h"
+#include "../source/drivers/headers/ir_remote.h"
+#include "../source/drivers/headers/menu.h"
+#include "../source/drivers/headers/pong_game.h"
+#include "../source/drivers/headers/scheduler.h"
+#include "../source/drivers/headers/log.h"
+
+extern volatile uint32_t g_systick_ms;
+
+#define INTRO_PRESS_MS      6000U   /* "Press to Start" apasat dupa animatie */
+
+typedef struct {
+    uint32_t frames;
+    uint64_t bytes;
+    uint64_t max_bytes;
+    uint64_t wire_us;
+    uint64_t max_wire_us;
+} Summary_t;
+
+enum { SC_MENU = 0, SC_COUNTDOWN, SC_GAMEPLAY, SC_RESTART, NUM_SCENARIOS };
+
+static const char *scenario_names[NUM_SCENARIOS] = {
+    "menu", "countdown", "gameplay", "restart"
+};
+
+static const char *screen_names[] = {
+    "INTRO", "BOOT_HELP", "MAIN", "START", "SELECT_INPUT", "SELECT_P1",
+    "SELECT_P2", "DIFFICULTY", "GAMEPLAY", "GAME_OVER", "PAUSED"
+};
+
+static FILE *csv;
+static Summary_t summary[NUM_SCENARIOS];
+
+/*============================================================================
+ * HOST HOOKS
+ *============================================================================*/
+
+int Host_Printf(const char *fmt, ...) {
+    (void)fmt;
+    return 0;
+}
+
+void Host_Finish(void) {
+    fprintf(stderr, "[BENCH] simulation stopped unexpectedly\n");
+    exit(1);
+}
+
+/*============================================================================
+ * MEASUREMENT
+ *============================================================================*/
+
+typedef struct {
+    Panel_Stats_t stats;
+    uint64_t cycles;
+} Mark_t;
+
+static Mark_t Begin(void) {
+    Mark_t m = { *Panel_GetStats(), sim_cycles };
+    return m;
+}
+
+static void End(const Mark_t *m, uint8_t scenario, const char *frame) {
+    ST7735_WaitIdle();
+    Sim_Sync();
+
+    const Panel_Stats_t *s = Panel_GetStats();
+    uint64_t bytes = s->bytes - m->stats.bytes;
+    uint64_t wire_us = bytes * Sim_SpiByteCycles() / (SIM_CORE_HZ / 1000000U);
+    uint64_t elapsed_us = (sim_cycles - m->cycles) / (SIM_CORE_HZ / 1000000U);
+
+    fprintf(csv, "%s,%s,%llu,%llu,%llu,%llu,%llu,%llu\n",
+            scenario_names[scenario], frame,
+            (unsigned long long)bytes,
+            (unsigned long long)(s->windows - m->stats.windows),
+            (unsigned long long)(s->cs_toggles - m->stats.cs_toggles),
+            (unsigned long long)(s->pixels - m->stats.pixels),
+            (unsigned long long)wire_us, (unsigned long long)elapsed_us);
+
+    Summary_t *sum = &summary[scenario];
+    sum->frames++;
+    sum->bytes += bytes;
+    sum->wire_us += wire_us;
+    if (bytes > sum->max_bytes) sum->max_bytes = bytes;
+    if (wire_us > sum->max_wire_us) sum->max_wire_us = wire_us;
+}
+
+/*============================================================================
+ * SHARED (bench.h)
+ *============================================================================*/
+
+void Bench_Check(BenchChecks_t *c, bool ok, const char *what) {
+    c->checks++;
+    if (!ok) {
+        c->failures++;
+        fprintf(stderr, "%s: FAIL %s\n", c->name, what);
+    }
+}
+
+int Bench_Report(const BenchChecks_t *c) {
+    fprintf(stderr, "%s: %u checks, %u failures\n", c->name, (unsigned)c->checks, (unsigned)c->failures);
+    return c->failures ? 1 : 0;
+}
+
+void Bench_WaitUntil(uint64_t cycles) {
+    while (sim_cycles < cycles) {
+        Sim_Idle();
+    }
+}
+
+void Bench_PressButton(void *arg) {
+    Sim_PinEdge(BTN_PORT, JOYSTICK_SW_PIN, arg != NULL);
+}
+
+double Bench_ElapsedNs(const struct timespec* t0, const struct timespec* t1) {
+    return (double)(t1->tv_sec - t0->tv_sec) * 1e9 + (double)(t1->tv_nsec - t0->tv_nsec);
+}
+
+void Bench_SysTickOnRunMode(const RunModeClocks_t* clocks) {
+    uint32_t ticks;
+    uint32_t old_load = SysTick->LOAD + 1U;
+    uint32_t load = clocks->core_hz / 1000U;
+
+    (void)Scheduler_ReadTick(&ticks);
+    uint32_t rest = (uint32_t)((uint64_t)(old_load - ticks) * load / old_load);
+    if (rest < 2U) rest = 2U;
+
+    SysTick->LOAD = rest - 1U;
+    SysTick->VAL = 0U;
+    SysTick->LOAD = load - 1U;
+}
+
+void Bench_RunScheduler(uint32_t ms) {
+    uint64_t end = sim_cycles + SIM_MS_TO_CYCLES(ms);
+    while (sim_cycles < end) {
+        if (!Scheduler_RunOnce()) Scheduler_Idle();
+    }
+}
+
+bool Bench_LogDrained(void) {
+    return Log_IsIdle() && (UART0->S1 & UART0_S1_TC_MASK);
+}
+
+void Bench_LogWaitDrained(void) {
+    while (!Bench_LogDrained()) {
+        Sim_Idle();
+    }
+}
+
+/*============================================================================
+ * SCENARIOS
+ *============================================================================*/
+
+static void BenchMenus(void) {
+    for (Screen_t screen = SCREEN_INTRO; screen <= SCREEN_PAUSED; screen++) {
+        if (screen == SCREEN_GAMEPLAY) continue;
+
+        if (screen == SCREEN_INTRO) {
+            /* Animatia asteapta butonul - il apasam dupa ce a inceput bucla demo */
+            uint64_t press = sim_cycles + SIM_MS_TO_CYCLES(INTRO_PRESS_MS);
+            Sim_Schedule(press, Bench_PressButton, NULL);
+            Sim_Schedule(press + SIM_MS_TO_CYCLES(50), Bench_PressButton, (void *)1);
+        }
+
+        g_currentScreen = screen;
+        g_menuState.selectedIndex = 0;
+
+        Mark_t m = Begin();
+        Menu_DrawCurrent();
+        End(&m, SC_MENU, screen_names[screen]);
+
+        Joystick_Reset();
+    }
+}
+
+/* Game_Start + tick-urile de 50 Hz pana se termina countdown-ul */
+static void RunCountdown(void) {
+    uint64_t next = sim_cycles;
+
+    Game_Start();
+    while (Game_IsInTransition()) {
+        next += SIM_MS_TO_CYCLES(GAME_FRAME_MS);
+        Bench_WaitUntil(next);
+        Game_Update();
+    }
+}
+
+static void BenchCountdown(void) {
+    Mark_t m = Begin();
+    RunCountdown();
+    End(&m, SC_COUNTDOWN, "0");
+}
+
+static void BenchGameplay(uint32_t seconds) {
+    uint32_t frames = seconds * (1000U / GAME_FRAME_MS);
+    uint64_t next = sim_cycles;
+    char name[16];
+
+    for (uint32_t f = 0; f < frames; f++) {
+        next += SIM_MS_TO_CYCLES(GAME_FRAME_MS);
+        Bench_WaitUntil(next);
+        snprintf(name, sizeof(name), "%u", (unsigned)f);
+
+        if (!Game_IsRunning()) {
+            Mark_t m = Begin();
+            RunCountdown();
+            End(&m, SC_RESTART, name);
+            next = sim_cycles;
+            continue;
+        }
+
+        Mark_t m = Begin();
+        Game_Update();
+        End(&m, SC_GAMEPLAY, name);
+
+        if (sim_cycles > next) next = sim_cycles;
+    }
+}
+
+/*============================================================================
+ * MAIN
+ *============================================================================*/
+
+int main(int argc, char **argv) {
+    uint32_t seconds = 30;
+    unsigned seed = 1;
+    const char *out = NULL;
+    uint32_t physics_steps = 0;
+    uint32_t intercept_samples = 0;
+    uint32_t nec_frames = 0;
+    const char *adc_trace = NULL;
+    bool sched = false;
+    uint32_t idle_seconds = 0;
+    bool audio = false;
+    uint32_t synth_samples = 0;
+    bool kv = false;
+    bool logging = false;
+    bool profiler = false;
+    bool lcd_dma = false;
+    bool lcd_text = false;
+    bool input = false;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "s:r:o:p:a:n:j:kw:um:flgdte")) != -1) {
+        switch (opt) {
+            case 's': seconds = (uint32_t)atoi(optarg); break;
+            case 'r': seed = (unsigned)strtoul(optarg, NULL, 0); break;
+            case 'o': out = optarg; break;
+            case 'p': physics_steps = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'a': intercept_samples = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'n': nec_frames = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'j': adc_trace = optarg; break;
+            case 'k': sched = true; break;
+            case 'w': idle_seconds = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'u': audio = true; break;
+            case 'm': synth_samples = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'f': kv = true; break;
+            case 'l': logging = true; break;
+            case 'g': profiler = true; break;
+            case 'd': lcd_dma = true; break;
+            case 't': lcd_text = true; break;
+            case 'e': input = true; break;
+            default:
+                fprintf(stderr, "usage: %s [-s seconds] [-r seed] [-o out.csv] [-p steps] [-a states] [-n frames] [-j adc_trace] [-k] [-w seconds] [-u] [-m samples] [-f] [-l] [-g] [-d] [-t] [-e]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    if (physics_steps) {
+        return BenchPhysics(physics_steps, seed);
+    }
+    if (intercept_samples) {
+        return BenchIntercept(intercept_samples, seed);
+    }
+    if (nec_frames) {
+        return BenchNec(nec_frames, seed);
+    }
+    if (adc_trace) {
+        return BenchAdcFilter(adc_trace, out, seed);
+    }
+    if (sched) {
+        return BenchScheduler();
+    }
+    if (idle_seconds) {
+        return BenchIdle(idle_seconds);
+    }
+    if (audio) {
+        return BenchAudio();
+    }
+    if (synth_samples) {
+        return BenchSynth(synth_samples);
+    }
+    if (kv) {
+        return BenchKvStore();
+    }
+    if (logging) {
+        return BenchLog();
+    }
+    if (profiler) {
+        return BenchProfiler(seconds);
+    }
+    if (lcd_dma) {
+        return BenchSt7735Dma();
+    }
+    if (lcd_text) {
+        return BenchSt7735Text();
+    }
+    if (input) {
+        return BenchInput();
+    }
+
+    csv = out ? fopen(out, "w") : stdout;
+    if (!csv) {
+        perror(out);
+        return 1;
+    }
+    fprintf(csv, "scenario,frame,bytes,windows,cs_toggles,pixels,wire_us,elapsed_us\n");
+
+    BOARD_InitBootClocks();
+    SysTick_Config(SystemCoreClock / 1000U);
+    srand(seed);
+
+    ST7735_Init();
+    Joystick_Init();
+    IR_Init();
+
+    BenchMenus();
+
+    g_player1_input = INPUT_CPU_HARD;
+    g_player2_input = INPUT_CPU_HARD;
+    g_currentDifficulty = DIFF_NORMAL;
+    BenchCountdown();
+    BenchGameplay(seconds);
+
+    if (csv != stdout) fclose(csv);
+
+    fprintf(stderr, "%-10s %7s %12s %10s %12s %12s\n",
+            "scenario", "frames", "bytes/frame", "max bytes", "wire us/fr", "max wire us");
+    for (uint8_t i = 0; i < NUM_SCENARIOS; i++) {
+        const Summary_t *s = &summary[i];
+        if (!s->frames) continue;
+        fprintf(stderr, "%-10s %7u %12llu %10llu %12llu %12llu\n", scenario_names[i], s->frames,
+                (unsigned long long)(s->bytes / s->frames), (unsigned long long)s->max_bytes,
+                (unsigned long long)(s->wire_us / s->frames), (unsigned long long)s->max_wire_us);
+    }
+    return 0;
+}
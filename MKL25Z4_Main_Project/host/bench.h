@@ -0,0 +1,109 @@
+/*
+ * bench.h
+ * Ce au in comun modurile pong_bench: verificarile, asteptarea pe timpul
+ * simulat si intrarile fiecarui mod (bench_*.c, cate un fisier per modul
+ * din firmware). main() si scenariile de randare raman in bench.c.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "../source/drivers/headers/run_mode.h"
+
+#define GAME_FRAME_MS       20U     /* PIT canal 1, 50 Hz */
+#define BTN_PORT            3U      /* PTD */
+#define IR_RX_PORT          0U      /* PTA */
+#define IR_RX_PIN           12U     /* Iesirea receptorului IR, activa in 0 */
+
+/* Ticuri TSC pe host, pentru costul per apel (0 pe alte arhitecturi) */
+#if defined(__x86_64__) || defined(__i386__)
+#define BENCH_TSC()     __rdtsc()
+#else
+#define BENCH_TSC()     0ULL
+#endif
+
+/*============================================================================
+ * CHECKS
+ *============================================================================*/
+
+/* Verificarile unui mod; name prefixeaza mesajele ("kv: FAIL ...") */
+typedef struct {
+    const char *name;
+    uint32_t checks;
+    uint32_t failures;
+} BenchChecks_t;
+
+/**
+ * Numara o verificare; daca ok e fals scrie "<name>: FAIL <what>"
+ */
+void Bench_Check(BenchChecks_t *c, bool ok, const char *what);
+
+/**
+ * Scrie "<name>: N checks, M failures"
+ * @return codul de iesire al modului (1 daca a picat ceva)
+ */
+int Bench_Report(const BenchChecks_t *c);
+
+/*============================================================================
+ * SIMULATION HELPERS
+ *============================================================================*/
+
+/**
+ * Ruleaza simularea (Sim_Idle) pana la cycles; poate depasi pana la
+ * urmatorul eveniment programat
+ */
+void Bench_WaitUntil(uint64_t cycles);
+
+/**
+ * Callback Sim_Schedule: butonul joystick-ului (arg != NULL = eliberat)
+ */
+void Bench_PressButton(void *arg);
+
+/**
+ * Listener RunMode: SysTick reprogramat pe ceasul nou, ca in main; restul
+ * milisecundei curente e pastrat, convertit la ceasul nou
+ */
+void Bench_SysTickOnRunMode(const RunModeClocks_t* clocks);
+
+/**
+ * Scheduler_RunOnce / Scheduler_Idle timp de ms milisecunde simulate
+ */
+void Bench_RunScheduler(uint32_t ms);
+
+/**
+ * Ringul din log.c gol si ultimul octet iesit de pe UART0
+ */
+bool Bench_LogDrained(void);
+void Bench_LogWaitDrained(void);
+
+/**
+ * Timp real pe host intre doua clock_gettime, in ns
+ */
+double Bench_ElapsedNs(const struct timespec* t0, const struct timespec* t1);
+
+/*============================================================================
+ * MODES
+ *============================================================================*/
+
+int BenchPhysics(uint32_t steps, unsigned seed);                        /* -p */
+int BenchIntercept(uint32_t samples, unsigned seed);                    /* -a */
+int BenchNec(uint32_t frames, unsigned seed);                           /* -n */
+int BenchAdcFilter(const char* path, const char* out, unsigned seed);   /* -j */
+int BenchScheduler(void);                                               /* -k */
+int BenchIdle(uint32_t seconds);                                        /* -w */
+int BenchAudio(void);                                                   /* -u */
+int BenchSynth(uint32_t samples);                                       /* -m */
+int BenchKvStore(void);                                                 /* -f */
+int BenchLog(void);                                                     /* -l */
+int BenchProfiler(uint32_t seconds);                                    /* -g */
+int BenchSt7735Dma(void);                                               /* -d */
+int BenchSt7735Text(void);                                              /* -t */
+int BenchInput(void);                                                   /* -e */
+
+#endif /* BENCH_H */
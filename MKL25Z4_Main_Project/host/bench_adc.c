@@ -0,0 +1,180 @@
+/*
+ * bench_adc.c
+ * pong_bench -j: filtrul ADC al joystick-ului pe un traseu inregistrat sau sintetic
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <math.h>
+#include <string.h>
+#include "bench.h"
+#include "sim.h"
+#include "../source/drivers/headers/physics.h"
+#include "../source/drivers/headers/adc_filter.h"
+#include "../source/drivers/headers/joystick.h"
+#include "../source/drivers/headers/input_events.h"
+#include "../source/drivers/headers/run_mode.h"
+#include "shim/board.h"
+
+/*============================================================================
+ * ADC FILTER
+ *============================================================================*/
+
+static BenchChecks_t adc_checks = { "adc", 0, 0 };
+
+#define ADC_SYNTH_SAMPLES   3000U
+#define ADC_SYNTH_LOW       2048U       /* Joystick centrat */
+#define ADC_SYNTH_HIGH      3900U       /* Joystick tras in jos */
+
+/* Centrat 1 s, tras 1 s, centrat 1 s; zgomot ~N(0, 40 LSB) (suma de 4 uniforme) */
+static uint16_t* AdcSynth(unsigned seed, uint32_t* count) {
+    Physics_State_t rng;
+    uint16_t* raw = malloc(ADC_SYNTH_SAMPLES * sizeof(*raw));
+    if (!raw) return NULL;
+
+    Physics_Init(&rng, seed);
+    for (uint32_t i = 0; i < ADC_SYNTH_SAMPLES; i++) {
+        int32_t level = (i >= 1000 && i < 2000) ? ADC_SYNTH_HIGH : ADC_SYNTH_LOW;
+        int32_t noise = 0;
+        for (uint8_t k = 0; k < 4; k++) noise += (int32_t)(Physics_Random(&rng) % 71U) - 35;
+        raw[i] = (uint16_t)(level + noise);
+    }
+
+    *count = ADC_SYNTH_SAMPLES;
+    return raw;
+}
+
+static uint16_t* AdcLoad(const char* path, uint32_t* count) {
+    FILE* f = fopen(path, "r");
+    uint32_t cap = 4096, n = 0;
+    uint16_t* raw = malloc(cap * sizeof(*raw));
+    char line[64];
+
+    if (!f || !raw) {
+        if (f) fclose(f);
+        free(raw);
+        return NULL;
+    }
+
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#' || line[0] == '\n') continue;
+        if (n == cap) {
+            uint16_t* grown = realloc(raw, (cap *= 2) * sizeof(*raw));
+            if (!grown) break;
+            raw = grown;
+        }
+        raw[n++] = (uint16_t)(strtoul(line, NULL, 0) & 0xFFFFU);
+    }
+
+    fclose(f);
+    *count = n;
+    return raw;
+}
+
+/* Zgomot estimat din diferenta a doua esantioane consecutive: RMS / sqrt(2) */
+static double AdcNoise(const uint16_t* v, uint32_t n) {
+    double sum = 0;
+    for (uint32_t i = 1; i < n; i++) {
+        double d = (double)v[i] - (double)v[i - 1];
+        sum += d * d;
+    }
+    return n > 1 ? sqrt(sum / (2.0 * (n - 1))) : 0.0;
+}
+
+/* O secunda de esantionare continua (trigger TPM0) in modul curent */
+static void AdcSampleRate(const char* mode) {
+    SimAdcStats_t a0, a1;
+
+    Sim_GetAdcStats(&a0);
+    Bench_WaitUntil(sim_cycles + SIM_MS_TO_CYCLES(1000));
+    Sim_GetAdcStats(&a1);
+    InputEvents_Flush();
+
+    uint32_t conversions = a1.conversions - a0.conversions;
+    uint32_t lost = a1.triggers_lost - a0.triggers_lost;
+    uint32_t conv_us = (uint32_t)(a1.last_cycles / SIM_US_TO_CYCLES(1));
+    fprintf(stderr, "adc: %-4s %u conversions/s, %u triggers lost, %u us per conversion\n",
+            mode, (unsigned)conversions, (unsigned)lost, (unsigned)conv_us);
+
+    Bench_Check(&adc_checks, lost == 0, "no TPM0 trigger lost to a busy ADC");
+    Bench_Check(&adc_checks, conversions + 1U >= JOYSTICK_SAMPLE_HZ && conversions <= JOYSTICK_SAMPLE_HZ + 1U,
+                "one conversion per TPM0 overflow");
+    Bench_Check(&adc_checks, conv_us * JOYSTICK_SAMPLE_HZ < 1000000U / 2U,
+                "hardware average fits in half a sample period (ADACK margin)");
+}
+
+int BenchAdcFilter(const char* path, const char* out, unsigned seed) {
+    bool synth = strcmp(path, "synth") == 0;
+    uint32_t n = 0;
+    uint16_t* raw = synth ? AdcSynth(seed, &n) : AdcLoad(path, &n);
+    uint16_t* filtered;
+    AdcFilter_t f;
+    struct timespec t0, t1;
+
+    if (!raw || n == 0) {
+        fprintf(stderr, "adc: no samples in %s\n", path);
+        free(raw);
+        return 1;
+    }
+    filtered = malloc(n * sizeof(*filtered));
+    if (!filtered) {
+        free(raw);
+        return 1;
+    }
+
+    AdcFilter_Init(&f, JOYSTICK_FILTER_SHIFT);
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (uint32_t i = 0; i < n; i++) {
+        filtered[i] = AdcFilter_Feed(&f, raw[i]);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    if (out) {
+        FILE* o = fopen(out, "w");
+        if (!o) {
+            perror(out);
+        } else {
+            fprintf(o, "sample,raw,filtered\n");
+            for (uint32_t i = 0; i < n; i++) {
+                fprintf(o, "%u,%u,%u\n", (unsigned)i, raw[i], filtered[i]);
+            }
+            fclose(o);
+        }
+    }
+
+    fprintf(stderr, "adc: %u samples (%.2f s at %u Hz), filter shift %u\n",
+            (unsigned)n, (double)n / JOYSTICK_SAMPLE_HZ, (unsigned)JOYSTICK_SAMPLE_HZ,
+            (unsigned)JOYSTICK_FILTER_SHIFT);
+    fprintf(stderr, "adc: noise raw %.1f LSB, filtered %.1f LSB\n",
+            AdcNoise(raw, n), AdcNoise(filtered, n));
+
+    /* Treapta sintetica: timpul 10% -> 90% dupa front */
+    if (synth) {
+        const uint32_t lo = ADC_SYNTH_LOW + (ADC_SYNTH_HIGH - ADC_SYNTH_LOW) / 10;
+        const uint32_t hi = ADC_SYNTH_HIGH - (ADC_SYNTH_HIGH - ADC_SYNTH_LOW) / 10;
+        uint32_t t10 = 0, t90 = 0;
+        for (uint32_t i = 1000; i < 2000; i++) {
+            if (!t10 && filtered[i] >= lo) t10 = i;
+            if (!t90 && filtered[i] >= hi) t90 = i;
+        }
+        fprintf(stderr, "adc: step 10-90%% in %.1f ms\n",
+                (double)(t90 - t10) * 1000.0 / JOYSTICK_SAMPLE_HZ);
+    }
+
+    fprintf(stderr, "adc: %.1f ns/sample on host\n", Bench_ElapsedNs(&t0, &t1) / n);
+
+    free(raw);
+    free(filtered);
+
+    /* Driverul pe ADC0 simulat: fiecare overflow TPM0 trebuie sa gaseasca
+     * ADC-ul liber (media hardware incape in perioada de esantionare) */
+    BOARD_InitBootClocks();
+    RunMode_Init();
+    Joystick_Init();
+    AdcSampleRate("RUN");
+    RunMode_Set(RUN_MODE_VLPR);
+    AdcSampleRate("VLPR");
+    RunMode_Set(RUN_MODE_RUN);
+    return Bench_Report(&adc_checks);
+}
@@ -0,0 +1,298 @@
+/*
+ * bench_audio.c
+ * pong_bench -u: secventiatorul audio (si sintetizatorul DAC0) pe timpul simulat
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "bench.h"
+#include "sim.h"
+#include "shim/board.h"
+#include "../source/drivers/headers/audio.h"
+#include "../source/drivers/headers/synth.h"
+#include "../source/drivers/headers/song.h"
+#include "../source/drivers/headers/run_mode.h"
+#include "../source/drivers/headers/power.h"
+
+/*============================================================================
+ * AUDIO
+ *============================================================================*/
+
+static BenchChecks_t audio_checks = { "audio", 0, 0 };
+
+static void AudioNop(void *arg) {
+    (void)arg;
+}
+
+/* Exact la momentul cerut: Sim_Idle ar sari pana la urmatorul tick SysTick */
+static void AudioWaitUntil(uint64_t cycles) {
+    Sim_Schedule(cycles, AudioNop, NULL);
+    Bench_WaitUntil(cycles);
+}
+
+#if defined(AUDIO_DAC)
+
+/* Blocurile mixate inaintea celui care se aude */
+#define AUDIO_LAG_MS        (2U * SYNTH_BLOCK * 1000U / SYNTH_SAMPLE_HZ)
+
+/* Iesirea DAC0 din simulare: ultimele esantioane (256 ms) */
+#define AUDIO_DAC_HISTORY   4096U
+
+static uint16_t dac_samples[AUDIO_DAC_HISTORY];
+static uint64_t dac_count;
+static uint64_t dac_last_when;
+static uint64_t dac_first_sound;        /* 0 = inca nimic de la AudioPlayAndWaitSound */
+static uint64_t dac_sound_end;          /* Sfarsitul ultimului esantion diferit de liniste */
+
+static void AudioDacSink(uint16_t value, uint64_t when) {
+    dac_samples[dac_count++ % AUDIO_DAC_HISTORY] = value;
+    dac_last_when = when;
+    if (value != SYNTH_DAC_MID) {
+        if (dac_first_sound == 0) dac_first_sound = when;
+        dac_sound_end = when + SIM_CORE_HZ / SYNTH_SAMPLE_HZ;
+    }
+}
+
+/* Frecventa pe ultimele window_ms din DAC (0 = liniste, 1 = nemasurabila):
+ * treceri crescatoare prin mijloc, interpolate intre esantioane */
+static uint32_t AudioToneHz(uint32_t window_ms) {
+    uint32_t n = window_ms * (SYNTH_SAMPLE_HZ / 1000U);
+    double t_first = 0, t_last = 0;
+    uint32_t crossings = 0;
+    bool sound = false;
+
+    /* Fluxul oprit: DAC-ul tine ultimul esantion, adica mijlocul */
+    if (dac_count < n || dac_last_when + SIM_MS_TO_CYCLES(1) < sim_cycles) return 0;
+
+    for (uint64_t j = dac_count - n + 1; j < dac_count; j++) {
+        int32_t a = (int32_t)dac_samples[(j - 1) % AUDIO_DAC_HISTORY] - (int32_t)SYNTH_DAC_MID;
+        int32_t b = (int32_t)dac_samples[j % AUDIO_DAC_HISTORY] - (int32_t)SYNTH_DAC_MID;
+        if (a != 0 || b != 0) sound = true;
+        if (a < 0 && b >= 0) {
+            double t = (double)(j - 1) + (double)-a / (double)(b - a);
+            if (crossings++ == 0) t_first = t;
+            t_last = t;
+        }
+    }
+    if (!sound) return 0;
+    if (crossings < 2) return 1;
+    return (uint32_t)((crossings - 1) * (double)SYNTH_SAMPLE_HZ / (t_last - t_first) + 0.5);
+}
+
+/* O voce la volum maxim: 127 * 255 >> SYNTH_MIX_SHIFT */
+#define AUDIO_VOICE_PEAK    ((127U * SYNTH_VOLUME_MAX) >> SYNTH_MIX_SHIFT)
+
+/* Cea mai mare abatere de la mijloc pe ultimele window_ms */
+static uint32_t AudioPeak(uint32_t window_ms) {
+    uint32_t n = window_ms * (SYNTH_SAMPLE_HZ / 1000U);
+    uint32_t peak = 0;
+
+    for (uint64_t j = (dac_count > n) ? dac_count - n : 0; j < dac_count; j++) {
+        int32_t d = (int32_t)dac_samples[j % AUDIO_DAC_HISTORY] - (int32_t)SYNTH_DAC_MID;
+        uint32_t a = (uint32_t)(d < 0 ? -d : d);
+        if (a > peak) peak = a;
+    }
+    return peak;
+}
+
+#else
+
+#define AUDIO_LAG_MS        0U
+
+/* Frecventa de pe TPM2_CH0 citita din registre (0 = liniste); tonul e
+ * instantaneu, window_ms nu conteaza */
+static uint32_t AudioToneHz(uint32_t window_ms) {
+    const TPM_Type *t = &sim_tpm[2];
+
+    if (!(t->SC & TPM_SC_CMOD_MASK) || !(t->CONTROLS[0].CnSC & TPM_CnSC_MSB_MASK)) return 0;
+    if (t->CONTROLS[0].CnV != (t->MOD + 1U) / 2U) return 0;
+    return (RunMode_GetClocks()->tpm_hz >> (t->SC & TPM_SC_PS_MASK)) / (t->MOD + 1U);
+}
+
+#endif
+
+/* Momentul la care se aude efectul pornit acum: pe DAC primul esantion
+ * diferit de liniste (dupa blocurile deja mixate), pe buzzer imediat */
+static uint64_t AudioPlayAndWaitSound(AudioEffect_t fx) {
+#if defined(AUDIO_DAC)
+    uint64_t limit = sim_cycles + SIM_MS_TO_CYCLES(AUDIO_LAG_MS + 10U);
+    dac_first_sound = 0;
+    Audio_Play(fx);
+    while (dac_first_sound == 0 && sim_cycles < limit) {
+        Sim_Idle();
+    }
+    return dac_first_sound ? dac_first_sound : sim_cycles;
+#else
+    Audio_Play(fx);
+    return sim_cycles;
+#endif
+}
+
+/* Fereastra de masura pentru o nota: jumatatea ei dinainte de mijloc,
+ * cel mult 16 ms */
+static uint32_t AudioWindowMs(uint16_t note_ms) {
+    uint32_t w = note_ms / 2U - 1U;
+    return w > 16U ? 16U : w;
+}
+
+/* Perioada din melodie (ticuri la SONG_TONE_HZ, 0 = pauza), cu 1% toleranta */
+static bool AudioToneIs(uint32_t hz, uint16_t period) {
+    if (period == 0) return hz == 0;
+
+    uint32_t expected = SONG_TONE_HZ / period;
+    return hz * 100U >= expected * 99U && hz * 100U <= expected * 101U;
+}
+
+/* Notele asteptate, decodate de player-ul din firmware */
+#define AUDIO_MAX_NOTES     64U
+
+static uint8_t AudioExpected(AudioEffect_t fx, SongNote_t *notes) {
+    SongPlayer_t p;
+    uint8_t count = 0;
+
+    Song_Start(&p, Audio_GetSong(fx));
+    while (count < AUDIO_MAX_NOTES && Song_Next(&p, &notes[count])) count++;
+    return count;
+}
+
+/* Reda un efect si verifica tonul la mijlocul fiecarei note; switch_ms != 0
+ * trece in VLPR la acel moment (relativ la inceput) */
+static void AudioRunEffect(AudioEffect_t fx, uint32_t switch_ms) {
+    static const char *names[AUDIO_FX_COUNT] = { "paddle", "wall", "goal", "speed_up", "game_over" };
+    AudioStats_t s0, s1;
+    SongNote_t notes[AUDIO_MAX_NOTES];
+    uint8_t count = AudioExpected(fx, notes);
+    uint32_t at_ms = 0, wrong = 0;
+    bool switched = false;
+
+    Audio_GetStats(&s0);
+    uint64_t start = AudioPlayAndWaitSound(fx);
+
+    for (uint8_t i = 0; i < count; i++) {
+        uint32_t mid = at_ms + notes[i].ms / 2U;
+        if (switch_ms && !switched && switch_ms < mid) {
+            AudioWaitUntil(start + SIM_MS_TO_CYCLES(switch_ms));
+            RunMode_Set(RUN_MODE_VLPR);
+            switched = true;
+        }
+        AudioWaitUntil(start + SIM_MS_TO_CYCLES(mid));
+        if (!AudioToneIs(AudioToneHz(AudioWindowMs(notes[i].ms)), notes[i].period)) wrong++;
+        at_ms += notes[i].ms;
+    }
+
+    /* Sfarsitul ultimei note: PIT-ul tine si o eventuala schimbare de mod */
+    while (Audio_IsPlaying() && sim_cycles < start + SIM_MS_TO_CYCLES(at_ms + 10U)) {
+        Sim_Idle();
+    }
+#if defined(AUDIO_DAC)
+    /* Mixerul termina nota inainte sa se auda: se asteapta blocurile ramase,
+     * sfarsitul e ultimul esantion de sunet */
+    AudioWaitUntil(sim_cycles + SIM_MS_TO_CYCLES(AUDIO_LAG_MS + 4U));
+    uint32_t end_us = (uint32_t)((dac_sound_end - start) / SIM_US_TO_CYCLES(1));
+#else
+    uint32_t end_us = (uint32_t)((sim_cycles - start) / SIM_US_TO_CYCLES(1));
+#endif
+    uint32_t hz_after = AudioToneHz(4);
+    Audio_GetStats(&s1);
+
+    fprintf(stderr, "audio: %-9s %u notes, %4u ms, ended at %7.3f ms%s\n", names[fx],
+            (unsigned)count, (unsigned)at_ms, end_us / 1000.0, switched ? " (VLPR mid-note)" : "");
+
+    char what[64];
+    snprintf(what, sizeof(what), "%s: tone at each note midpoint", names[fx]);
+    Bench_Check(&audio_checks, wrong == 0, what);
+    snprintf(what, sizeof(what), "%s: one note timer per note", names[fx]);
+    Bench_Check(&audio_checks, s1.notes - s0.notes == count, what);
+    snprintf(what, sizeof(what), "%s: ends on time, silent", names[fx]);
+    Bench_Check(&audio_checks, !Audio_IsPlaying() && hz_after == 0 &&
+                               end_us + 1000U >= at_ms * 1000U && end_us <= at_ms * 1000U + 1000U, what);
+
+    if (switched) RunMode_Set(RUN_MODE_RUN);
+}
+
+int BenchAudio(void) {
+    AudioStats_t s0, s1;
+    SongNote_t over[AUDIO_MAX_NOTES];
+#if !defined(AUDIO_DAC)
+    SongNote_t goal[AUDIO_MAX_NOTES];
+#endif
+
+    BOARD_InitBootClocks();
+    SysTick_Config(SystemCoreClock / 1000U);
+    Power_Init();
+    RunMode_Init();
+    RunMode_AddListener(Bench_SysTickOnRunMode);
+#if defined(AUDIO_DAC)
+    Sim_SetDacSink(AudioDacSink);
+#endif
+    Audio_Init();
+
+    for (AudioEffect_t fx = 0; fx < AUDIO_FX_COUNT; fx++) {
+        AudioRunEffect(fx, 0);
+    }
+
+    /* O nota lunga intrerupta de trecerea in VLPR (TPM 4 MHz, bus 800 kHz) */
+    AudioRunEffect(AUDIO_FX_GAME_OVER, 200);
+
+#if defined(AUDIO_DAC)
+    /* Polifonie: paleta in timpul game over ia o voce libera, se aude
+     * peste el (varful depaseste o singura voce), apoi game over continua */
+    AudioExpected(AUDIO_FX_GAME_OVER, over);
+    Audio_GetStats(&s0);
+    uint64_t start = AudioPlayAndWaitSound(AUDIO_FX_GAME_OVER);
+    AudioWaitUntil(start + SIM_MS_TO_CYCLES(10));
+    Audio_Play(AUDIO_FX_PADDLE);
+    AudioWaitUntil(start + SIM_MS_TO_CYCLES(40));
+    uint32_t peak = AudioPeak(16);
+    AudioWaitUntil(start + SIM_MS_TO_CYCLES(100));
+    Audio_GetStats(&s1);
+    Bench_Check(&audio_checks, s1.played - s0.played == 2 && s1.dropped == s0.dropped &&
+                               s1.preempted == s0.preempted && peak > AUDIO_VOICE_PEAK &&
+                               AudioToneIs(AudioToneHz(16), over[0].period), "paddle mixed over game over");
+
+    Audio_Stop();
+    AudioWaitUntil(sim_cycles + SIM_MS_TO_CYCLES(AUDIO_LAG_MS + 4U));
+    Bench_Check(&audio_checks, AudioToneHz(4) == 0, "stop silences the DAC");
+
+    /* Toate vocile ocupate: paleta inlocuieste vocea cu prioritatea cea mai mica */
+    Audio_GetStats(&s0);
+    Audio_Play(AUDIO_FX_GAME_OVER);
+    Audio_Play(AUDIO_FX_GOAL);
+    Audio_Play(AUDIO_FX_SPEED_UP);
+    Audio_Play(AUDIO_FX_WALL);
+    Audio_Play(AUDIO_FX_PADDLE);
+    Audio_GetStats(&s1);
+    Bench_Check(&audio_checks, s1.played - s0.played == 5 && s1.preempted - s0.preempted == 1 &&
+                               s1.dropped == s0.dropped, "all voices busy: lowest priority replaced");
+    Audio_Stop();
+#else
+    /* Prioritate mai mica in timpul game over: ignorat, game over continua */
+    AudioExpected(AUDIO_FX_GAME_OVER, over);
+    Audio_GetStats(&s0);
+    uint64_t start = sim_cycles;
+    Audio_Play(AUDIO_FX_GAME_OVER);
+    AudioWaitUntil(start + SIM_MS_TO_CYCLES(10));
+    Audio_Play(AUDIO_FX_PADDLE);
+    AudioWaitUntil(start + SIM_MS_TO_CYCLES(40));
+    Audio_GetStats(&s1);
+    Bench_Check(&audio_checks, s1.dropped - s0.dropped == 1 && AudioToneIs(AudioToneHz(0), over[0].period),
+                               "lower priority dropped");
+
+    /* Prioritate mai mare: goal intrerupe imediat o lovitura de paleta */
+    Audio_Stop();
+    Bench_Check(&audio_checks, AudioToneHz(0) == 0, "stop silences the buzzer");
+    AudioExpected(AUDIO_FX_GOAL, goal);
+    Audio_GetStats(&s0);
+    start = sim_cycles;
+    Audio_Play(AUDIO_FX_PADDLE);
+    AudioWaitUntil(start + SIM_MS_TO_CYCLES(10));
+    Audio_Play(AUDIO_FX_GOAL);
+    AudioWaitUntil(start + SIM_MS_TO_CYCLES(20));
+    Audio_GetStats(&s1);
+    Bench_Check(&audio_checks, s1.preempted - s0.preempted == 1 && AudioToneIs(AudioToneHz(0), goal[0].period),
+                               "higher priority preempts");
+    Audio_Stop();
+#endif
+
+    return Bench_Report(&audio_checks);
+}
@@ -0,0 +1,232 @@
+/*
+ * bench_idle.c
+ * pong_bench -w: meniul in asteptare, WAIT vs VLPS tickless, RUN vs VLPR
+ */
+
+#include <stdio.h>
+#include "bench.h"
+#include "sim.h"
+#include "shim/board.h"
+#include "../source/drivers/headers/joystick.h"
+#include "../source/drivers/headers/ir_remote.h"
+#include "../source/drivers/headers/input_events.h"
+#include "../source/drivers/headers/scheduler.h"
+#include "../source/drivers/headers/power.h"
+#include "../source/drivers/headers/run_mode.h"
+
+/*============================================================================
+ * IDLE POWER
+ *============================================================================*/
+
+#define IDLE_PRESS_PERIOD_MS    737U    /* Apasari de buton, defazate fata de ui */
+#define IDLE_PRESS_HOLD_MS      60U
+
+extern volatile uint32_t g_systick_ms;
+
+static BenchChecks_t idle_checks = { "idle", 0, 0 };
+
+static uint64_t idle_press_cycles;
+static uint32_t idle_presses, idle_latency_max_us;
+static uint64_t idle_latency_sum_us;
+static uint32_t idle_slow_runs;         /* Task-uri rulate in RUN pe alt ceas decat PEE */
+static bool idle_vlpr;
+static uint32_t idle_switches;          /* Treceri RUN/VLPR facute de ui */
+static int64_t idle_switch_err_us;      /* Cat s-a mutat Scheduler_NowUs fata de timpul simulat */
+static uint64_t idle_switch_masked;     /* Cel mai lung interval cu IRQ-uri oprite intr-o schimbare */
+
+/* Iesirile din VLPS, de la intreruperea care a trezit CPU-ul: pana la
+ * revenirea din SMC_SetPowerModeVlps si pana la PEE (relock-ul din PBE) */
+static uint32_t idle_wakes;
+static uint64_t idle_wake_sum, idle_wake_min, idle_wake_max, idle_clocked_max;
+static bool idle_wake_relock_ok;
+
+static void IdleWake(const SimWake_t *w) {
+    uint64_t resumed = w->resumed - w->event;
+    uint64_t clocked = w->clocked - w->event;
+
+    if (idle_wakes == 0 || resumed < idle_wake_min) idle_wake_min = resumed;
+    if (resumed > idle_wake_max) idle_wake_max = resumed;
+    if (clocked > idle_clocked_max) idle_clocked_max = clocked;
+    idle_wake_sum += resumed;
+    idle_wakes++;
+
+    /* Din VLPR nu e relock; din PEE, PLL-ul porneste la trezire si se
+     * blocheaza in paralel cu iesirea din VLPS */
+    uint64_t expect = resumed;
+    if (!idle_vlpr && SIM_US_TO_CYCLES(SIM_PLL_LOCK_US) > expect) expect = SIM_US_TO_CYCLES(SIM_PLL_LOCK_US);
+    if (clocked < expect || clocked > expect + SIM_US_TO_CYCLES(1)) idle_wake_relock_ok = false;
+}
+
+/* Scheduler_NowUs minus timpul simulat */
+static int64_t IdleClockErrUs(void) {
+    return (int64_t)Scheduler_NowUs() - (int64_t)(sim_cycles / SIM_US_TO_CYCLES(1));
+}
+
+static void IdleInputTask(void) {
+    SimClocks_t c;
+
+    /* Dupa VLPS din PEE, MCG iese in PBE: Power_Sleep trebuie sa revina
+     * in PEE inainte ca vreun task sa ruleze */
+    Sim_GetClocks(&c);
+    if (RunMode_Get() == RUN_MODE_RUN && c.core_hz != BOARD_BOOTCLOCKRUN_CORE_CLOCK) {
+        idle_slow_runs++;
+    }
+
+    Joystick_Process();
+    IR_Process();
+}
+
+/* Ca UiTask din meniu: consuma evenimentele la 20 Hz */
+static void IdleUiTask(void) {
+    InputEvent_t ev;
+
+    while (InputEvents_Pop(&ev)) {
+        if (ev.source != INPUT_SRC_BUTTON) continue;
+
+        uint32_t us = (uint32_t)((sim_cycles - idle_press_cycles) / SIM_US_TO_CYCLES(1));
+        idle_presses++;
+        idle_latency_sum_us += us;
+        if (us > idle_latency_max_us) idle_latency_max_us = us;
+
+        /* Ca UiTask: evenimentul trece in RUN (relock PLL); fara ecran de
+         * redesenat, RunMode_Update coboara inapoi imediat */
+        if (idle_vlpr) {
+            RunModeStats_t rs0, rs1;
+            RunMode_GetStats(&rs0);
+            int64_t err = IdleClockErrUs();
+            Sim_TakeIrqMaskedMax();
+            RunMode_Set(RUN_MODE_RUN);
+            RunMode_Update(false);
+            idle_switch_err_us += IdleClockErrUs() - err;
+            uint64_t masked = Sim_TakeIrqMaskedMax();
+            if (masked > idle_switch_masked) idle_switch_masked = masked;
+            RunMode_GetStats(&rs1);
+            idle_switches += (rs1.to_run - rs0.to_run) + (rs1.to_vlpr - rs0.to_vlpr);
+        }
+    }
+}
+
+static Task_t idle_input = { .name = "input", .run = IdleInputTask, .period_ms = 1,  .priority = 0 };
+static Task_t idle_ui    = { .name = "ui",    .run = IdleUiTask,    .period_ms = 50, .priority = 2 };
+
+static void IdlePress(void *arg) {
+    bool release = (arg != NULL);
+
+    if (!release) idle_press_cycles = sim_cycles;
+    Bench_PressButton(arg);
+}
+
+static void RunIdlePolicy(const char *name, uint16_t input_ms, bool deep, bool vlpr, uint32_t seconds) {
+    SimPowerStats_t sp0, sp1;
+    PowerStats_t ps0, ps1;
+
+    Scheduler_Init();
+    idle_input.enabled = idle_ui.enabled = false;
+    Scheduler_SetPeriod(&idle_input, input_ms);
+    Scheduler_Add(&idle_input, true);
+    Scheduler_Add(&idle_ui, true);
+    Joystick_SetLowPower(input_ms > 1);
+    Power_SetDeepSleep(deep);
+    idle_vlpr = vlpr;
+    RunMode_Set(vlpr ? RUN_MODE_VLPR : RUN_MODE_RUN);
+    InputEvents_Flush();
+
+    idle_presses = 0;
+    idle_latency_max_us = 0;
+    idle_latency_sum_us = 0;
+    idle_slow_runs = 0;
+    idle_switches = 0;
+    idle_switch_err_us = 0;
+    idle_switch_masked = 0;
+    idle_wakes = 0;
+    idle_wake_sum = idle_wake_min = idle_wake_max = idle_clocked_max = 0;
+    idle_wake_relock_ok = true;
+
+    uint64_t start = sim_cycles;
+    uint32_t start_ms = g_systick_ms;
+    for (uint32_t t = IDLE_PRESS_PERIOD_MS / 2; t < seconds * 1000U; t += IDLE_PRESS_PERIOD_MS) {
+        Sim_Schedule(start + SIM_MS_TO_CYCLES(t), IdlePress, NULL);
+        Sim_Schedule(start + SIM_MS_TO_CYCLES(t + IDLE_PRESS_HOLD_MS), IdlePress, (void *)1);
+    }
+
+    Sim_GetPowerStats(&sp0);
+    Power_GetStats(&ps0);
+    Sim_SetWakeSink(IdleWake);
+    Bench_RunScheduler(seconds * 1000U);
+    Sim_SetWakeSink(NULL);
+    Sim_GetPowerStats(&sp1);
+    Power_GetStats(&ps1);
+
+    RunMode_Set(RUN_MODE_RUN);
+
+    /* Doar intervalul politicii */
+    SimPowerStats_t sp = {
+        .wait_cycles = sp1.wait_cycles - sp0.wait_cycles,
+        .vlpw_cycles = sp1.vlpw_cycles - sp0.vlpw_cycles,
+        .vlpr_cycles = sp1.vlpr_cycles - sp0.vlpr_cycles,
+        .vlps_cycles = sp1.vlps_cycles - sp0.vlps_cycles,
+    };
+    uint64_t total = sim_cycles - start;
+    uint64_t wait = sp.wait_cycles + sp.vlpw_cycles;
+    uint64_t run = total - wait - sp.vlpr_cycles - sp.vlps_cycles;
+    uint32_t wakeups = (ps1.wait_entries - ps0.wait_entries) + (ps1.vlps_entries - ps0.vlps_entries);
+    int32_t drift = (int32_t)((g_systick_ms - start_ms) - (uint32_t)(total / SIM_MS_TO_CYCLES(1)));
+
+    fprintf(stderr, "%-10s %6.2f %6.2f %6.2f %6.2f %9.1f %8u %8u %8u %8d %8.1f %8.1f\n", name,
+            100.0 * run / total, 100.0 * sp.vlpr_cycles / total, 100.0 * wait / total,
+            100.0 * sp.vlps_cycles / total, (double)wakeups / seconds,
+            (unsigned)Sim_EstimateCurrentUa(&sp, total),
+            (unsigned)(idle_presses ? idle_latency_sum_us / idle_presses : 0),
+            (unsigned)idle_latency_max_us, (int)drift,
+            (double)idle_wake_max / SIM_US_TO_CYCLES(1), (double)idle_clocked_max / SIM_US_TO_CYCLES(1));
+
+    /* Eroarea SysTick la o schimbare de mod: restul milisecundei e convertit
+     * la ceasul nou; ramane doar relock-ul PLL, numarat pe ceasul vechi */
+    double switch_err_us = idle_switches ? (double)idle_switch_err_us / idle_switches : 0.0;
+    if (vlpr) {
+        fprintf(stderr, "%-10s %u RUN/VLPR switches, SysTick error %+.1f us per switch, IRQs masked max %u us\n",
+                "", (unsigned)idle_switches, switch_err_us,
+                (unsigned)(idle_switch_masked / SIM_US_TO_CYCLES(1)));
+    }
+
+    uint32_t relocks = ps1.pll_relocks - ps0.pll_relocks;
+    uint32_t vlps = ps1.vlps_entries - ps0.vlps_entries;
+    Bench_Check(&idle_checks, idle_slow_runs == 0, "tasks run on the PEE clocks after a VLPS wake-up");
+    Bench_Check(&idle_checks, relocks == ((deep && !vlpr) ? vlps : 0U),
+                "every VLPS entered from PEE relocks the PLL, none from VLPR");
+    Bench_Check(&idle_checks, idle_wakes == sp1.vlps_entries - sp0.vlps_entries &&
+                              (idle_wakes == 0 || (idle_wake_min == SIM_US_TO_CYCLES(SIM_VLPS_EXIT_US) &&
+                                                   idle_wake_max == idle_wake_min)),
+                "every VLPS wake-up returns from SMC_SetPowerModeVlps SIM_VLPS_EXIT_US after its event");
+    Bench_Check(&idle_checks, idle_wake_relock_ok,
+                "back on the pre-sleep clock one PLL lock after the event from PEE, at once from VLPR");
+    Bench_Check(&idle_checks, switch_err_us > -(double)SIM_PLL_LOCK_US && switch_err_us < (double)SIM_PLL_LOCK_US,
+                "a RUN/VLPR switch keeps the SysTick time within one PLL lock");
+    Bench_Check(&idle_checks, idle_switch_masked < SIM_US_TO_CYCLES(SIM_PLL_LOCK_US),
+                "a RUN/VLPR switch keeps IRQs enabled across the PLL relock");
+}
+
+/* Acelasi meniu (niciun ecran redesenat), patru politici de somn;
+ * wait% include VLPW (WAIT din VLPR). lat_us e dominat de perioada ui-ului
+ * (50 ms); wake_us / clock_us (maxime) sunt doar trezirea din VLPS: de la
+ * eveniment pana dupa SMC_SetPowerModeVlps, respectiv pana la ceasul de
+ * dinainte de somn (relock-ul PLL inclus) */
+int BenchIdle(uint32_t seconds) {
+    BOARD_InitBootClocks();
+    SysTick_Config(SystemCoreClock / 1000U);
+    Power_Init();
+    RunMode_Init();
+    RunMode_AddListener(Bench_SysTickOnRunMode);
+    Joystick_Init();
+    IR_Init();
+    Sim_SetAdc(JOYSTICK_VRY_CHANNEL, 2048);
+    Bench_PressButton((void *)1);
+
+    fprintf(stderr, "%-10s %6s %6s %6s %6s %9s %8s %8s %8s %8s %8s %8s\n", "policy", "run%", "vlpr%",
+            "wait%", "vlps%", "wakeups/s", "est_uA", "lat_us", "max_us", "drift_ms", "wake_us", "clock_us");
+    RunIdlePolicy("1ms-wait", 1, false, false, seconds);
+    RunIdlePolicy("10ms-wait", 10, false, false, seconds);
+    RunIdlePolicy("10ms-vlps", 10, true, false, seconds);
+    RunIdlePolicy("vlpr-vlps", 10, true, true, seconds);
+    return Bench_Report(&idle_checks);
+}
@@ -0,0 +1,306 @@
+/*
+ * bench_input.c
+ * pong_bench -e: coada de input din input_events.c cu rafale din ISR-urile
+ * simulate - butonul pe PTD4 (cu sarituri), cadre NEC pe PTA12 prin TPM1,
+ * stick-ul prin ADC0 - ordinea, pierderile si latenta raportata
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "bench.h"
+#include "sim.h"
+#include "shim/board.h"
+#include "../source/drivers/headers/joystick.h"
+#include "../source/drivers/headers/ir_remote.h"
+#include "../source/drivers/headers/input_events.h"
+#include "../source/drivers/headers/scheduler.h"
+
+/*============================================================================
+ * INPUT QUEUE
+ *============================================================================*/
+
+#define INPUT_MAX_FIRED         32U
+#define INPUT_BOUNCE_US         300U    /* Intre doua sarituri ale contactului */
+#define INPUT_BOUNCES           3U      /* Sarituri la apasare si la eliberare */
+#define INPUT_HOLD_MS           60U
+#define INPUT_UI_PERIOD_MS      50U     /* Ca UiTask */
+
+extern volatile uint32_t g_systick_ms;
+
+static BenchChecks_t input_checks = { "input", 0, 0 };
+
+/* Momentul (g_systick_ms) frontului care trebuie sa produca fiecare eveniment */
+typedef struct {
+    uint32_t ms[INPUT_MAX_FIRED];
+    uint8_t action[INPUT_MAX_FIRED];
+    uint32_t count;
+    uint32_t popped;
+} Fired_t;
+
+static Fired_t fired[INPUT_NUM_SOURCES];
+static bool input_consume;
+static uint32_t input_latency_sum, input_latency_max, input_order_errors;
+
+static void FiredReset(void) {
+    memset(fired, 0, sizeof(fired));
+}
+
+static void Fire(InputSource_t source, UI_Action_t action) {
+    Fired_t *f = &fired[source];
+    if (f->count < INPUT_MAX_FIRED) {
+        f->ms[f->count] = g_systick_ms;
+        f->action[f->count] = (uint8_t)action;
+    }
+    f->count++;
+}
+
+/* Evenimentul scos trebuie sa fie urmatorul frontul al sursei lui */
+static bool Matches(const InputEvent_t *ev, uint32_t window_ms) {
+    Fired_t *f = &fired[ev->source];
+    if (f->popped >= f->count || f->popped >= INPUT_MAX_FIRED) return false;
+
+    uint32_t at = f->ms[f->popped];
+    uint8_t action = f->action[f->popped];
+    f->popped++;
+    return ev->action == action && (ev->stamp_ms - at) <= window_ms;
+}
+
+/*----------------------------------------------------------------------------
+ * Surse
+ *----------------------------------------------------------------------------*/
+
+static void ButtonDown(void *arg) {
+    (void)arg;
+    Fire(INPUT_SRC_BUTTON, ACTION_SELECT);
+    Bench_PressButton(NULL);
+}
+
+/* Apasare cu sarituri la ambele capete; o singura apasare asteptata */
+static void SchedulePress(uint64_t t) {
+    Sim_Schedule(t, ButtonDown, NULL);
+    for (uint8_t i = 0; i < INPUT_BOUNCES; i++) {
+        Sim_Schedule(t += SIM_US_TO_CYCLES(INPUT_BOUNCE_US), Bench_PressButton, (void *)1);
+        Sim_Schedule(t += SIM_US_TO_CYCLES(INPUT_BOUNCE_US), Bench_PressButton, NULL);
+    }
+    t += SIM_MS_TO_CYCLES(INPUT_HOLD_MS);
+    Sim_Schedule(t, Bench_PressButton, (void *)1);
+    for (uint8_t i = 0; i < INPUT_BOUNCES; i++) {
+        Sim_Schedule(t += SIM_US_TO_CYCLES(INPUT_BOUNCE_US), Bench_PressButton, NULL);
+        Sim_Schedule(t += SIM_US_TO_CYCLES(INPUT_BOUNCE_US), Bench_PressButton, (void *)1);
+    }
+}
+
+static void IrEdge(void *arg) {
+    Sim_PinEdge(IR_RX_PORT, IR_RX_PIN, arg != NULL);
+}
+
+/* Frontul bitului de stop: acolo decodeaza ISR-ul TPM1 */
+static void IrStop(void *arg) {
+    Fire(INPUT_SRC_IR, (UI_Action_t)(uintptr_t)arg);
+    IrEdge(NULL);
+}
+
+static uint64_t IrMark(uint64_t t, uint32_t mark_us, uint32_t space_us) {
+    Sim_Schedule(t, IrEdge, NULL);
+    t += SIM_US_TO_CYCLES(mark_us);
+    Sim_Schedule(t, IrEdge, (void *)1);
+    return t + SIM_US_TO_CYCLES(space_us);
+}
+
+/* Un cadru NEC complet, fara repeat-uri */
+static void ScheduleIrFrame(uint64_t t, uint32_t code) {
+    t = IrMark(t, 9000, 4500);
+    for (uint8_t i = 0; i < 32; i++) t = IrMark(t, 560, (code >> i) & 1U ? 1690 : 560);
+    UI_Action_t action = (code == IR_CODE_UP) ? ACTION_UP : ACTION_DOWN;
+    Sim_Schedule(t, IrStop, (void *)(uintptr_t)action);
+    Sim_Schedule(t + SIM_US_TO_CYCLES(560), IrEdge, (void *)1);
+}
+
+static void StickMove(void *arg) {
+    uint16_t raw = (uint16_t)(uintptr_t)arg;
+
+    if (raw != 2048U) Fire(INPUT_SRC_JOYSTICK, raw > 2048U ? ACTION_DOWN : ACTION_UP);
+    Sim_SetAdc(JOYSTICK_VRY_CHANNEL, raw);
+}
+
+static void ScheduleStick(uint64_t t, bool down) {
+    Sim_Schedule(t, StickMove, (void *)(uintptr_t)(down ? 4000U : 100U));
+    Sim_Schedule(t + SIM_MS_TO_CYCLES(150), StickMove, (void *)(uintptr_t)2048U);
+}
+
+/*----------------------------------------------------------------------------
+ * Task-uri
+ *----------------------------------------------------------------------------*/
+
+static void InputTask(void) {
+    Joystick_Process();
+    IR_Process();
+}
+
+/* Ca UiTask: consuma tot la 20 Hz si masoara latenta fata de front */
+static void UiTask(void) {
+    InputEvent_t ev;
+
+    if (!input_consume) return;
+    while (InputEvents_Pop(&ev)) {
+        Fired_t *f = &fired[ev.source];
+        if (f->popped < f->count && f->popped < INPUT_MAX_FIRED) {
+            uint32_t latency = g_systick_ms - f->ms[f->popped];
+            input_latency_sum += latency;
+            if (latency > input_latency_max) input_latency_max = latency;
+        }
+        if (!Matches(&ev, 1)) input_order_errors++;
+    }
+}
+
+static Task_t input_task = { .name = "input", .run = InputTask, .period_ms = 1,  .priority = 0 };
+static Task_t ui_task    = { .name = "ui",    .run = UiTask,    .period_ms = INPUT_UI_PERIOD_MS, .priority = 2 };
+
+/*----------------------------------------------------------------------------
+ * Scenarii
+ *----------------------------------------------------------------------------*/
+
+/* Rafale intretesute din toate sursele, sub capacitatea ringurilor, si
+ * nimeni nu consuma: Pop trebuie sa le dea pe toate, in ordinea stamp-urilor */
+static void InputBursts(void) {
+    InputStats_t st0, st1;
+    InputEvent_t ev;
+    static const uint8_t counts[INPUT_NUM_SOURCES] = { 12, 10, 8 };
+
+    FiredReset();
+    InputEvents_GetStats(&st0);
+
+    uint64_t start = sim_cycles;
+    for (uint32_t k = 0; k < counts[INPUT_SRC_BUTTON]; k++) {
+        SchedulePress(start + SIM_MS_TO_CYCLES(100U + k * 290U));
+    }
+    for (uint32_t k = 0; k < counts[INPUT_SRC_IR]; k++) {
+        ScheduleIrFrame(start + SIM_MS_TO_CYCLES(80U + k * 330U), (k & 1U) ? IR_CODE_UP : IR_CODE_DOWN);
+    }
+    for (uint32_t k = 0; k < counts[INPUT_SRC_JOYSTICK]; k++) {
+        ScheduleStick(start + SIM_MS_TO_CYCLES(200U + k * 410U), (k & 1U) == 0U);
+    }
+    Bench_RunScheduler(4000);
+
+    uint32_t n = 0, prev = 0;
+    bool ordered = true, matched = true;
+    while (InputEvents_Pop(&ev)) {
+        if (n++ && (int32_t)(ev.stamp_ms - prev) < 0) ordered = false;
+        prev = ev.stamp_ms;
+        /* Stick-ul trece pragul dupa filtrul IIR, in cateva esantioane */
+        if (!Matches(&ev, ev.source == INPUT_SRC_JOYSTICK ? 20U : 1U)) matched = false;
+    }
+    InputEvents_GetStats(&st1);
+
+    bool all = true;
+    for (uint8_t s = 0; s < INPUT_NUM_SOURCES; s++) {
+        if (fired[s].count != counts[s] || fired[s].popped != counts[s]) all = false;
+    }
+    Bench_Check(&input_checks, all && n == 30U, "bursts: every press, frame and stick move delivered once (bounce ignored)");
+    Bench_Check(&input_checks, st1.dropped == st0.dropped, "bursts: nothing dropped below ring capacity");
+    Bench_Check(&input_checks, ordered, "bursts: Pop returns the events in timestamp order");
+    Bench_Check(&input_checks, matched, "bursts: each event stamped at its own edge, in source order");
+}
+
+/* Doua apasari reale cu 30 ms de linie linistita intre ele */
+static void InputDoublePress(void) {
+    InputEvent_t ev;
+    uint32_t n = 0;
+
+    uint64_t t = sim_cycles + SIM_MS_TO_CYCLES(10);
+    Sim_Schedule(t, Bench_PressButton, NULL);
+    Sim_Schedule(t + SIM_MS_TO_CYCLES(20), Bench_PressButton, (void *)1);
+    Sim_Schedule(t + SIM_MS_TO_CYCLES(50), Bench_PressButton, NULL);
+    Sim_Schedule(t + SIM_MS_TO_CYCLES(70), Bench_PressButton, (void *)1);
+    /* Si un front izolat la 10 ms dupa eliberare: saritura, nu apasare */
+    Sim_Schedule(t + SIM_MS_TO_CYCLES(80), Bench_PressButton, NULL);
+    Sim_Schedule(t + SIM_MS_TO_CYCLES(81), Bench_PressButton, (void *)1);
+    Bench_RunScheduler(200);
+
+    while (InputEvents_PopSource(INPUT_SRC_BUTTON, &ev)) n++;
+    Bench_Check(&input_checks, n == 2U, "double press 50 ms apart gives two events, a late bounce none");
+}
+
+/* Ring plin: cele mai vechi raman, surplusul e numarat exact */
+static void InputOverflow(void) {
+    InputStats_t st0, st1;
+    InputEvent_t ev;
+    const uint32_t presses = INPUT_RING_SIZE + 5U;
+
+    FiredReset();
+    InputEvents_GetStats(&st0);
+    uint64_t start = sim_cycles;
+    for (uint32_t k = 0; k < presses; k++) {
+        SchedulePress(start + SIM_MS_TO_CYCLES(10U + k * 100U));
+    }
+    Bench_RunScheduler(presses * 100U + 200U);
+    InputEvents_GetStats(&st1);
+
+    uint32_t n = 0;
+    bool oldest = true;
+    while (InputEvents_Pop(&ev)) {
+        if (!Matches(&ev, 1)) oldest = false;
+        n++;
+    }
+    Bench_Check(&input_checks, n == INPUT_RING_SIZE && oldest, "overflow: the ring keeps the oldest INPUT_RING_SIZE presses");
+    Bench_Check(&input_checks, st1.dropped - st0.dropped == presses - INPUT_RING_SIZE,
+                "overflow: dropped counts exactly the presses past capacity");
+}
+
+/* Consumator la 20 Hz; latenta din InputEvents_GetStats vs cea masurata
+ * aici, de la front la Pop */
+static void InputLatency(void) {
+    InputStats_t st0, st1;
+
+    FiredReset();
+    input_latency_sum = input_latency_max = input_order_errors = 0;
+    InputEvents_GetStats(&st0);
+    input_consume = true;
+
+    uint64_t start = sim_cycles;
+    for (uint32_t k = 0; k < 10U; k++) {
+        SchedulePress(start + SIM_MS_TO_CYCLES(30U + k * 137U));
+        ScheduleIrFrame(start + SIM_MS_TO_CYCLES(60U + k * 251U), (k & 1U) ? IR_CODE_UP : IR_CODE_DOWN);
+    }
+    Bench_RunScheduler(3000);
+    input_consume = false;
+    InputEvents_GetStats(&st1);
+
+    uint32_t consumed = st1.consumed - st0.consumed;
+    uint32_t sum = st1.latency_sum_ms - st0.latency_sum_ms;
+    Bench_Check(&input_checks, consumed == 20U && input_order_errors == 0U, "latency: 20 events consumed, in order");
+    /* Frontul poate cadea inaintea tic-ului SysTick din aceeasi milisecunda */
+    Bench_Check(&input_checks, sum <= input_latency_sum && sum + consumed >= input_latency_sum &&
+                st1.latency_max_ms <= input_latency_max && st1.latency_max_ms + 1U >= input_latency_max,
+                "latency: reported sum and max match edge -> Pop measured here, within 1 ms per event");
+    Bench_Check(&input_checks, input_latency_max <= INPUT_UI_PERIOD_MS,
+                "latency: at most one ui period");
+
+    fprintf(stderr, "input: %u events, latency avg %u ms, max %u ms (ui every %u ms)\n",
+            (unsigned)consumed, (unsigned)(consumed ? sum / consumed : 0),
+            (unsigned)st1.latency_max_ms, (unsigned)INPUT_UI_PERIOD_MS);
+}
+
+int BenchInput(void) {
+    BOARD_InitBootClocks();
+    SysTick_Config(SystemCoreClock / 1000U);
+    Sim_SetAdc(JOYSTICK_VRY_CHANNEL, 2048);
+    Joystick_Init();
+    IR_Init();
+
+    Scheduler_Init();
+    Scheduler_Add(&input_task, true);
+    Scheduler_Add(&ui_task, true);
+
+    /* Calibrarea stick-ului pe primele esantioane */
+    Bench_RunScheduler(200);
+    InputEvents_Flush();
+
+    /* Primul: latency_max_ms din InputEvents_GetStats nu se reseteaza */
+    InputLatency();
+    InputBursts();
+    InputDoublePress();
+    InputOverflow();
+
+    return Bench_Report(&input_checks);
+}
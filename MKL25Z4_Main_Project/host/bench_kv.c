@@ -0,0 +1,232 @@
+/*
+ * bench_kv.c
+ * pong_bench -f: kv_store.c si settings.c pe flash-ul simulat
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "bench.h"
+#include "sim.h"
+#include "shim/board.h"
+#include "../source/drivers/headers/kv_store.h"
+#include "../source/drivers/headers/settings.h"
+#include "../source/drivers/headers/power.h"
+#include "../source/drivers/headers/menu.h"
+
+/*============================================================================
+ * KV STORE (kv_store.c + portul KL25Z pe flash-ul simulat)
+ *============================================================================*/
+
+#define KV_KEY_COUNTER      5U
+#define KV_KEY_NAME         9U
+#define KV_TEST_UPDATES     2000U
+
+#define KV_VLPR_UPDATES     300U
+
+extern volatile uint32_t g_systick_ms;
+
+static BenchChecks_t kv_checks = { "kv", 0, 0 };
+
+static uint32_t KvGetCounter(void) {
+    uint32_t value = 0;
+    return KvStore_Get(KV_KEY_COUNTER, &value, sizeof(value)) == sizeof(value) ? value : UINT32_MAX;
+}
+
+static bool KvSetCounter(uint32_t value) {
+    return KvStore_Set(KV_KEY_COUNTER, &value, sizeof(value)) && KvStore_Flush();
+}
+
+/* Latenta unui KvStore_Flush in timp simulat (comenzile FTFA) */
+static uint32_t KvFlushUs(uint32_t value, bool* compacted) {
+    KvStoreStats_t s0, s1;
+
+    KvStore_GetStats(&s0);
+    uint64_t start = sim_cycles;
+    KvSetCounter(value);
+    uint32_t us = (uint32_t)((sim_cycles - start) / (SIM_CORE_HZ / 1000000U));
+    KvStore_GetStats(&s1);
+    *compacted = s1.compactions != s0.compactions;
+    return us;
+}
+
+/* Caderi de tensiune la fiecare operatie a unei scrieri (un append sau o
+ * compactare): dupa reset contorul are valoarea veche sau pe cea noua, iar
+ * store-ul scrie mai departe */
+static void KvPowerCutSweep(bool compaction) {
+    uint32_t bad = 0, cuts = 0;
+
+    for (uint32_t ops = 1; ; ops++) {
+        KvStoreStats_t st;
+
+        /* Toate sectoarele folosite o data; sectorul activ aproape plin
+         * (urmatoarea scriere sterge un sector cu header valid) sau pe
+         * jumatate */
+        Sim_FlashWipe();
+        KvStore_Init();
+        KvStore_Set(KV_KEY_NAME, "pong", 4U);
+        uint32_t value = 0;
+        do {
+            KvSetCounter(++value);
+            KvStore_GetStats(&st);
+        } while (st.compactions <= KV_SECTORS ||
+                 st.used + (compaction ? 8U : KV_SECTOR_SIZE / 2U) <= KV_SECTOR_SIZE);
+
+        Sim_FlashPowerCut(ops);
+        bool done = KvSetCounter(value + 1U);
+        Sim_FlashPowerCut(0);
+        if (done) break;
+        cuts++;
+
+        char name[4] = { 0 };
+        KvStore_Init();
+        uint32_t got = KvGetCounter();
+        bool ok = (got == value || got == value + 1U) &&
+                  KvStore_Get(KV_KEY_NAME, name, sizeof(name)) == 4U && memcmp(name, "pong", 4) == 0;
+
+        /* Si dupa cadere: scrierile noi ajung in flash si supravietuiesc */
+        ok = ok && KvSetCounter(value + 2U) && KvSetCounter(value + 3U);
+        KvStore_Init();
+        ok = ok && KvGetCounter() == value + 3U;
+        if (!ok) {
+            bad++;
+            fprintf(stderr, "kv: power cut after %u ops -> counter %u (wrote %u)\n",
+                    (unsigned)ops, (unsigned)got, (unsigned)(value + 1U));
+        }
+    }
+    fprintf(stderr, "kv: %u power cut points in one %s\n", (unsigned)cuts,
+            compaction ? "compaction" : "append");
+    Bench_Check(&kv_checks, cuts > 0 && bad == 0, compaction ? "power cut during compaction" : "power cut during append");
+}
+
+int BenchKvStore(void) {
+    KvStoreStats_t st;
+    SimFlashStats_t fs;
+    uint32_t value;
+    bool compacted;
+
+    BOARD_InitBootClocks();
+    SysTick_Config(SystemCoreClock / 1000U);
+    Power_Init();
+    RunMode_Init();
+    RunMode_AddListener(Bench_SysTickOnRunMode);
+
+    /* Flash gol: nimic de citit; o valoare scrisa supravietuieste resetului */
+    Sim_FlashWipe();
+    Bench_Check(&kv_checks, !KvStore_Init() && KvGetCounter() == UINT32_MAX, "empty flash -> no values");
+    KvSetCounter(1234U);
+    KvStore_Set(KV_KEY_NAME, "pong", 4U);
+    Bench_Check(&kv_checks, KvStore_IsDirty() && KvGetCounter() == 1234U, "Get sees the pending value");
+    KvStore_Flush();
+    KvStore_Init();
+    char name[KV_VALUE_MAX] = { 0 };
+    Bench_Check(&kv_checks, KvGetCounter() == 1234U && KvStore_Get(KV_KEY_NAME, name, sizeof(name)) == 4U &&
+                            memcmp(name, "pong", 4) == 0, "values survive a reset");
+
+    /* Aceeasi valoare: nicio scriere */
+    Sim_GetFlashStats(&fs);
+    uint32_t words = fs.words;
+    value = 1234U;
+    KvStore_Set(KV_KEY_COUNTER, &value, sizeof(value));
+    KvStore_Flush();
+    Sim_GetFlashStats(&fs);
+    Bench_Check(&kv_checks, !KvStore_IsDirty() && fs.words == words, "unchanged value is not rewritten");
+
+    /* Din VLPR (meniurile): portul trece in RUN pentru FTFA si revine */
+    RunModeStats_t r0, r1;
+    RunMode_GetStats(&r0);
+    RunMode_Set(RUN_MODE_VLPR);
+    Bench_Check(&kv_checks, KvSetCounter(4321U) && RunMode_Get() == RUN_MODE_VLPR, "flush from VLPR");
+    RunMode_GetStats(&r1);
+    RunMode_Set(RUN_MODE_RUN);
+    Bench_Check(&kv_checks, r1.to_run - r0.to_run == 1U, "one RUN switch for the flush");
+
+    /* Din VLPR peste compactari: tot o singura trecere in RUN per flush */
+    uint32_t vlpr_compactions = 0, extra_switches = 0;
+    RunMode_Set(RUN_MODE_VLPR);
+    for (value = 1; value <= KV_VLPR_UPDATES; value++) {
+        RunMode_GetStats(&r0);
+        KvFlushUs(value, &compacted);
+        RunMode_GetStats(&r1);
+        if (compacted) vlpr_compactions++;
+        if (r1.to_run - r0.to_run != 1U) extra_switches++;
+    }
+    RunMode_Set(RUN_MODE_RUN);
+    Bench_Check(&kv_checks, vlpr_compactions > 0 && extra_switches == 0, "one RUN switch per flush, compaction included");
+
+    /* Multe scrieri: sectoarele sunt sterse pe rand, niciun cuvant rescris */
+    uint32_t append_max_us = 0, compact_max_us = 0, compactions = 0;
+    uint32_t ms0 = g_systick_ms;
+    uint64_t t0 = sim_cycles;
+    for (value = 1; value <= KV_TEST_UPDATES; value++) {
+        uint32_t us = KvFlushUs(value, &compacted);
+        if (compacted) {
+            compactions++;
+            if (us > compact_max_us) compact_max_us = us;
+        } else if (us > append_max_us) {
+            append_max_us = us;
+        }
+    }
+    uint32_t sim_ms = (uint32_t)((sim_cycles - t0) / SIM_MS_TO_CYCLES(1));
+    int32_t drift = (int32_t)((g_systick_ms - ms0) - sim_ms);
+    Sim_GetFlashStats(&fs);
+    uint32_t lo = UINT32_MAX, hi = 0;
+    for (uint8_t s = 0; s < SIM_FLASH_SECTORS; s++) {
+        if (fs.erases[s] < lo) lo = fs.erases[s];
+        if (fs.erases[s] > hi) hi = fs.erases[s];
+    }
+    fprintf(stderr, "kv: %u updates -> %u compactions, erases per sector %u..%u, %u words programmed\n",
+            KV_TEST_UPDATES, (unsigned)compactions, (unsigned)lo, (unsigned)hi, (unsigned)fs.words);
+    fprintf(stderr, "kv: flush latency append %u us, compaction %u us (max)\n",
+            (unsigned)append_max_us, (unsigned)compact_max_us);
+    Bench_Check(&kv_checks, compactions > SIM_FLASH_SECTORS && hi - lo <= 1U, "wear spread evenly across sectors");
+    Bench_Check(&kv_checks, fs.overwrites == 0, "no word programmed twice without erase");
+    Bench_Check(&kv_checks, append_max_us < 1000U, "append flush under 1 ms");
+
+    /* Stergerile ruleaza cu intreruperile oprite: fara corectia din LPTMR0,
+     * g_systick_ms ar ramane in urma cu ~13 ms la fiecare compactare */
+    fprintf(stderr, "kv: g_systick_ms drift %d ms over %u ms of flushes (%u erases)\n",
+            (int)drift, (unsigned)sim_ms, (unsigned)compactions);
+    Bench_Check(&kv_checks, drift >= -(int32_t)compactions - 1 && drift <= 1, "g_systick_ms keeps time across erases");
+
+    KvStore_Init();
+    KvStore_GetStats(&st);
+    Bench_Check(&kv_checks, KvGetCounter() == KV_TEST_UPDATES && KvStore_Get(KV_KEY_NAME, name, sizeof(name)) == 4U,
+                            "latest values after many compactions");
+
+    /* Un bit schimbat in ultima inregistrare: CRC-ul o respinge, ramane
+     * valoarea precedenta, iar urmatoarea scriere compacteaza */
+    uint8_t *last = (uint8_t *)(uintptr_t)(SIM_FLASH_BASE + st.sector * SIM_FLASH_SECTOR + st.used - 4U);
+    *last ^= 0x01U;
+    KvStore_Init();
+    KvStore_GetStats(&st);
+    Bench_Check(&kv_checks, st.crc_errors == 1U && KvGetCounter() == KV_TEST_UPDATES - 1U, "CRC rejects a corrupt record");
+    KvFlushUs(7U, &compacted);
+    KvStore_Init();
+    KvStore_GetStats(&st);
+    Bench_Check(&kv_checks, compacted && st.crc_errors == 0 && KvGetCounter() == 7U, "corrupt sector compacted away");
+
+    KvPowerCutSweep(false);
+    KvPowerCutSweep(true);
+
+    /* Setarile: schimbate din meniu, scrise la Settings_Flush, citite la pornire */
+    SettingsResults_t res;
+    Sim_FlashWipe();
+    g_player1_input = INPUT_JOYSTICK;
+    g_player2_input = INPUT_REMOTE;
+    g_currentDifficulty = DIFF_NORMAL;
+    Settings_Init();
+    Bench_Check(&kv_checks, !Settings_Changed(), "defaults are not written");
+    g_player2_input = INPUT_CPU_HARD;
+    g_currentDifficulty = DIFF_HARD;
+    Settings_RecordMatch(2, 3, 5);
+    Bench_Check(&kv_checks, Settings_Changed() && Settings_Flush(), "settings flush");
+    g_player2_input = INPUT_REMOTE;
+    g_currentDifficulty = DIFF_EASY;
+    Settings_Init();
+    Settings_GetResults(&res);
+    Bench_Check(&kv_checks, g_player2_input == INPUT_CPU_HARD && g_currentDifficulty == DIFF_HARD &&
+                            res.matches == 1U && res.wins[1] == 1U && res.last_score[1] == 5U,
+                            "settings and results restored at boot");
+
+    return Bench_Report(&kv_checks);
+}
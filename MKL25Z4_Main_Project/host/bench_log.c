@@ -0,0 +1,262 @@
+/*
+ * bench_log.c
+ * pong_bench -l: log.c golit de UART0 TX pe timpul simulat
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "bench.h"
+#include "sim.h"
+#include "logtok.h"
+#include "shim/board.h"
+#include "../source/drivers/headers/log.h"
+#include "../source/drivers/headers/run_mode.h"
+#include "../source/drivers/headers/power.h"
+
+/*============================================================================
+ * LOG (ringul din log.c golit de UART0 TX pe timpul simulat)
+ *============================================================================*/
+
+static BenchChecks_t log_checks = { "log", 0, 0 };
+
+/* Octetii iesiti pe pin, cu momentul bitului de stop al ultimului; cu
+ * LOG_TOKENIZED log_text e textul decodat, log_wire numara octetii */
+static char log_text[4096];
+static uint32_t log_len;
+static uint32_t log_wire;
+static uint64_t log_last_when;
+#if defined(LOG_TOKENIZED)
+static LogTok_t log_dec;
+#endif
+
+static void LogUartSink(uint8_t byte, uint64_t when) {
+#if defined(LOG_TOKENIZED)
+    char text[LOGTOK_TEXT_MAX];
+    size_t n = LogTok_Feed(&log_dec, byte, text);
+    for (size_t i = 0; i < n && log_len < sizeof(log_text) - 1U; i++) {
+        log_text[log_len++] = text[i];
+    }
+#else
+    if (log_len < sizeof(log_text) - 1U) log_text[log_len++] = (char)byte;
+#endif
+    log_text[log_len] = '\0';
+    log_wire++;
+    log_last_when = when;
+}
+
+static void LogClear(void) {
+    log_len = 0;
+    log_wire = 0;
+    log_text[0] = '\0';
+}
+
+#if defined(LOG_TOKENIZED)
+static uint32_t LogDictionaryCount(const LogTok_t *dec) {
+    uint32_t count = 0;
+    for (uint32_t off = 0; off < dec->size; off++) {
+        if (dec->strings[off] != '\0' && (off == 0 || dec->strings[off - 1U] == '\0')) count++;
+    }
+    return count;
+}
+#endif
+
+static uint32_t LogCyclesToUs(uint64_t cycles) {
+    return (uint32_t)(cycles / SIM_US_TO_CYCLES(1));
+}
+
+int BenchLog(void) {
+    LogStats_t st;
+    SimUartStats_t us;
+    char expect[2048];
+    uint32_t n;
+
+    BOARD_InitBootClocks();
+    SysTick_Config(SystemCoreClock / 1000U);
+    BOARD_InitDebugConsole();
+    Power_Init();
+    RunMode_Init();
+    RunMode_AddListener(Bench_SysTickOnRunMode);
+#if defined(LOG_TOKENIZED)
+    Bench_Check(&log_checks, LogTok_LoadElf(&log_dec, "/proc/self/exe"), "log_fmt section in the ELF");
+#endif
+    Sim_SetUartSink(LogUartSink);
+    Log_Init();
+    Bench_LogWaitDrained();
+    LogClear();
+    /* LOG_BOOT de dinaintea lui Log_Init (power.c) nu e in contoarele lui */
+    Sim_GetUartStats(&us);
+    Log_GetStats(&st);
+    uint32_t boot_bytes = us.bytes - st.bytes;
+
+    uint64_t byte_cycles = Sim_UartByteCycles();
+    fprintf(stderr, "log: UART0 %.1f us per byte in RUN\n", (double)byte_cycles / SIM_US_TO_CYCLES(1));
+
+    /* Formatarea: aceleasi rezultate ca printf pentru subsetul suportat */
+    uint64_t t0 = sim_cycles;
+    LOG("[T] %d %i %u|%5d", -42, 0, 4000000000U, 17);
+    LOG("|%-5d|%05d|%x %X", -3, -12, 0xbeefU, 0xbeefU);
+    LOG("|%08X|%c%%\r\n", 0x1aU, 'z');
+    Bench_Check(&log_checks, sim_cycles == t0 && log_len == 0, "LOG returns before the first byte leaves");
+    Bench_LogWaitDrained();
+    Bench_Check(&log_checks, strcmp(log_text, "[T] -42 0 4000000000|   17|-3   |-0012|beef BEEF|0000001A|z%\r\n") == 0,
+                             "integer formats match printf");
+    Bench_Check(&log_checks, log_last_when - t0 <= (uint64_t)(log_wire + 1U) * byte_cycles &&
+                             log_last_when - t0 >= (uint64_t)log_wire * byte_cycles,
+                             "drain runs at the line rate, back to back");
+    fprintf(stderr, "log: %u bytes drained in %u us\n", (unsigned)log_wire, LogCyclesToUs(log_last_when - t0));
+#if defined(LOG_TOKENIZED)
+    fprintf(stderr, "log: tokenized, %u bytes of text in %u bytes on the wire\n",
+            (unsigned)log_len, (unsigned)log_wire);
+#endif
+
+    /* Ringul plin: apelurile nu asteapta, pierderile apar ca o linie in locul lor */
+    LogClear();
+    Log_GetStats(&st);
+    uint32_t written0 = st.written;
+    t0 = sim_cycles;
+    for (uint32_t i = 0; i < 40U; i++) {
+        LOG("[B] line %02u\r\n", (unsigned)i);
+    }
+    LOG("[B] after\r\n");
+    Bench_Check(&log_checks, sim_cycles == t0, "a full ring never blocks the caller");
+    Log_GetStats(&st);
+    uint32_t kept = st.written - written0;
+    Bench_Check(&log_checks, st.dropped == 41U - kept && kept >= LOG_RING_SIZE && kept < 41U, "overflow is counted");
+    Bench_LogWaitDrained();
+
+    /* Ce a incaput, in ordine, apoi raportul (si "after" s-a pierdut) */
+    n = 0;
+    expect[0] = '\0';
+    for (uint32_t i = 0; i < kept; i++) {
+        n += (uint32_t)snprintf(expect + n, sizeof(expect) - n, "[B] line %02u\r\n", (unsigned)i);
+    }
+    snprintf(expect + n, sizeof(expect) - n, "[LOG] %u dropped\r\n", (unsigned)(41U - kept));
+    Bench_Check(&log_checks, strcmp(log_text, expect) == 0, "kept lines in order, then the drop report");
+#if defined(LOG_TOKENIZED)
+    Bench_Check(&log_checks, log_wire * 3U <= log_len, "short lines are at least 3x smaller on the wire");
+    fprintf(stderr, "log: burst, %u bytes of text in %u bytes on the wire\n",
+            (unsigned)log_len, (unsigned)log_wire);
+#endif
+    fprintf(stderr, "log: 41 writes in a burst -> %u kept, %u dropped\n", (unsigned)kept, (unsigned)(41U - kept));
+
+    /* Dupa o pierdere: raportul iese inaintea a ce s-a scris dupa ea */
+    LogClear();
+    Log_GetStats(&st);
+    written0 = st.written;
+    uint32_t lost0 = st.dropped;
+    for (uint32_t i = 0; i < LOG_RING_SIZE + 4U; i++) {
+        LOG("[C] %u\r\n", (unsigned)i);
+    }
+    Log_GetStats(&st);
+    kept = st.written - written0;
+    uint32_t lost = st.dropped - lost0;
+    while (log_len < 20U) {
+        Sim_Idle();
+    }
+    LOG("[C] next\r\n");
+    Bench_LogWaitDrained();
+    n = 0;
+    for (uint32_t i = 0; i < kept; i++) {
+        n += (uint32_t)snprintf(expect + n, sizeof(expect) - n, "[C] %u\r\n", (unsigned)i);
+    }
+    snprintf(expect + n, sizeof(expect) - n, "[LOG] %u dropped\r\n[C] next\r\n", (unsigned)lost);
+    Bench_Check(&log_checks, strcmp(log_text, expect) == 0, "drop report precedes later records");
+
+    /* Costul pe host al unui LOG (include Sim_Touch pe registrele din port) */
+    struct timespec h0, h1;
+    double ns = 0.0;
+    uint64_t tsc = 0;
+    uint32_t calls = 0;
+    for (uint32_t round = 0; round < 200U; round++) {
+        Bench_LogWaitDrained();
+        clock_gettime(CLOCK_MONOTONIC, &h0);
+        uint64_t c0 = BENCH_TSC();
+        for (uint32_t i = 0; i < LOG_RING_SIZE / 2U; i++) {
+            LOG("[P] %u %u\r\n", (unsigned)round, (unsigned)i);
+        }
+        uint64_t c1 = BENCH_TSC();
+        clock_gettime(CLOCK_MONOTONIC, &h1);
+        ns += Bench_ElapsedNs(&h0, &h1);
+        tsc += c1 - c0;
+        calls += LOG_RING_SIZE / 2U;
+    }
+    Bench_LogWaitDrained();
+    fprintf(stderr, "log: %.1f ns, %.1f TSC ticks per LOG on the host (PRINTF of the same line: %u us on the wire)\n",
+            ns / calls, (double)tsc / calls, LogCyclesToUs(12U * byte_cycles));
+
+    /* RUN -> VLPR cu ringul plin: se asteapta doar octetul din shifter, TIE revine */
+    LogClear();
+    for (uint32_t i = 0; i < 8U; i++) {
+        LOG("[V] %u\r\n", (unsigned)i);
+    }
+    while (log_len < 10U) {
+        Sim_Idle();
+    }
+    t0 = sim_cycles;
+    RunMode_Set(RUN_MODE_VLPR);
+    uint64_t switch_cycles = sim_cycles - t0;
+    Bench_Check(&log_checks, switch_cycles <= 2U * byte_cycles, "RUN -> VLPR waits for the written bytes, not the ring");
+    Bench_Check(&log_checks, !Log_IsIdle() && (UART0->C2 & UART0_C2_TIE_MASK), "TX interrupt re-armed after the switch");
+    uint64_t vlpr_byte_cycles = Sim_UartByteCycles();
+    Bench_LogWaitDrained();
+    n = 0;
+    for (uint32_t i = 0; i < 8U; i++) {
+        n += (uint32_t)snprintf(expect + n, sizeof(expect) - n, "[V] %u\r\n", (unsigned)i);
+    }
+    Bench_Check(&log_checks, strcmp(log_text, expect) == 0, "text intact across RUN -> VLPR");
+    Bench_Check(&log_checks, vlpr_byte_cycles > 0 && vlpr_byte_cycles * 100U < byte_cycles * 103U &&
+                             vlpr_byte_cycles * 100U > byte_cycles * 97U, "VLPR baud within 3%");
+    fprintf(stderr, "log: RUN -> VLPR mid-drain waited %u us, VLPR %.1f us per byte\n",
+            LogCyclesToUs(switch_cycles), (double)vlpr_byte_cycles / SIM_US_TO_CYCLES(1));
+    RunMode_Set(RUN_MODE_RUN);
+
+    /* VLPS permis (meniu): fiecare intrerupere TX tine CPU-ul treaz pana la ultimul octet */
+    PowerStats_t p0, p1;
+    LogClear();
+    Power_SetDeepSleep(true);
+    Power_GetStats(&p0);
+    t0 = sim_cycles;
+    LOG("[S] deep sleep allowed, %u bytes\r\n", 34U);
+    while (!Bench_LogDrained()) {
+        DisableGlobalIRQ();
+        Power_Sleep(10);
+        EnableGlobalIRQ(0);
+    }
+    Power_GetStats(&p1);
+    Power_SetDeepSleep(false);
+    Bench_Check(&log_checks, strcmp(log_text, "[S] deep sleep allowed, 34 bytes\r\n") == 0 && p1.vlps_entries == p0.vlps_entries &&
+                             log_last_when - t0 <= (uint64_t)(log_len + 1U) * byte_cycles,
+                             "no VLPS while the UART is sending");
+
+#if defined(LOG_TOKENIZED)
+    /* LOG_BOOT: cadrul pleaca pe loc, dupa ce era deja in ring */
+    LogClear();
+    LOG("[K] queued %u\r\n", 1U);
+    LOG_BOOT("[K] boot %d, %x\r\n", -7, 0x5aU);
+    Bench_Check(&log_checks, Log_IsIdle() && strncmp(log_text, "[K] queued 1\r\n", 14) == 0,
+                             "LOG_BOOT waits for the ring before writing");
+    LOG("[K] after %u\r\n", 2U);
+    Bench_LogWaitDrained();
+    Bench_Check(&log_checks, strcmp(log_text, "[K] queued 1\r\n[K] boot -7, 5a\r\n[K] after 2\r\n") == 0,
+                             "LOG_BOOT frame in order, the TX interrupt drains again after it");
+#endif
+
+    Sim_GetUartStats(&us);
+    Log_GetStats(&st);
+    Bench_Check(&log_checks, us.overruns == 0, "no byte written over a busy data register");
+    Bench_Check(&log_checks, st.bytes + boot_bytes == us.bytes, "every byte from Log_NextByte reached the pin");
+    fprintf(stderr, "log: %u records, %u dropped, ring high-water %u/%u, %u bytes\n",
+            (unsigned)st.written, (unsigned)st.dropped, (unsigned)st.max_used, (unsigned)LOG_RING_SIZE,
+            (unsigned)st.bytes);
+
+#if defined(LOG_TOKENIZED)
+    Bench_Check(&log_checks, log_dec.errors == 0, "every frame decoded with a known token");
+    fprintf(stderr, "log: %u frames decoded, %u formats (%u bytes) kept out of flash\n",
+            (unsigned)log_dec.frames, (unsigned)LogDictionaryCount(&log_dec), (unsigned)log_dec.size);
+    LogTok_Free(&log_dec);
+#endif
+
+    Sim_SetUartSink(NULL);
+    return Bench_Report(&log_checks);
+}
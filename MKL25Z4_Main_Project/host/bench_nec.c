@@ -0,0 +1,120 @@
+/*
+ * bench_nec.c
+ * pong_bench -n: decodorul NEC pe latimi de puls sintetice
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "bench.h"
+#include "sim.h"
+#include "../source/drivers/headers/physics.h"
+#include "../source/drivers/headers/nec_decoder.h"
+
+/*============================================================================
+ * NEC DECODER
+ *============================================================================*/
+
+#define NEC_MAX_PULSES  80
+
+typedef struct {
+    uint32_t width[NEC_MAX_PULSES];
+    uint8_t count;
+} Pulses_t;
+
+/* Latimi nominale cu jitter de +-jitter us (receptorul lungeste/scurteaza mark-urile) */
+static void PushPulse(Physics_State_t* rng, Pulses_t* p, uint32_t us, uint32_t jitter) {
+    int32_t j = jitter ? (int32_t)(Physics_Random(rng) % (2 * jitter + 1)) - (int32_t)jitter : 0;
+    p->width[p->count++] = (uint32_t)((int32_t)us + j);
+}
+
+static void NecFrame(Physics_State_t* rng, Pulses_t* p, uint32_t code, uint32_t jitter) {
+    PushPulse(rng, p, 40000, 0);                /* Linie in repaus */
+    PushPulse(rng, p, 9000, jitter);
+    PushPulse(rng, p, 4500, jitter);
+    for (uint8_t i = 0; i < 32; i++) {
+        PushPulse(rng, p, 560, jitter);
+        PushPulse(rng, p, (code >> i) & 1U ? 1690 : 560, jitter);
+    }
+    PushPulse(rng, p, 560, jitter);
+}
+
+static void NecRepeat(Physics_State_t* rng, Pulses_t* p, uint32_t jitter) {
+    PushPulse(rng, p, 96000, 0);
+    PushPulse(rng, p, 9000, jitter);
+    PushPulse(rng, p, 2250, jitter);
+    PushPulse(rng, p, 560, jitter);
+}
+
+/* Ruleaza pulsurile si numara evenimentele; *code = ultimul cod decodat */
+static void NecRun(NecDecoder_t* d, const Pulses_t* p, uint32_t counts[4], uint32_t* code) {
+    for (uint8_t i = 0; i < p->count; i++) {
+        NecEvent_t ev = NecDecoder_Feed(d, p->width[i]);
+        counts[ev]++;
+        if (ev == NEC_EVENT_CODE) *code = d->code;
+    }
+}
+
+int BenchNec(uint32_t frames, unsigned seed) {
+    Physics_State_t rng;
+    NecDecoder_t d;
+    uint32_t failures = 0;
+    uint64_t edges = 0;
+    struct timespec t0, t1;
+    double ns = 0;
+
+    Physics_Init(&rng, seed);
+    NecDecoder_Reset(&d);
+
+    for (uint32_t f = 0; f < frames; f++) {
+        /* Cod NEC valid (comanda + inversul ei), 0-3 repeat-uri */
+        uint32_t cmd = Physics_Random(&rng) & 0xFFU;
+        uint32_t code = (Physics_Random(&rng) & 0xFFFFU) | (cmd << 16) | ((~cmd & 0xFFU) << 24);
+        uint8_t repeats = Physics_Random(&rng) % 4U;
+        uint8_t kind = Physics_Random(&rng) % 4U;
+        Pulses_t p = { { 0 }, 0 };
+        uint32_t counts[4] = { 0 };
+        uint32_t got = 0;
+
+        NecFrame(&rng, &p, code, 150);
+        for (uint8_t r = 0; r < repeats; r++) NecRepeat(&rng, &p, 150);
+
+        /* Zgomot: glitch in mijlocul cadrului, cadru trunchiat, sau inversul stricat */
+        uint32_t expect_codes = 1;
+        uint32_t expect_repeats = repeats;
+        if (kind == 1) {
+            uint8_t at = 3 + Physics_Random(&rng) % 60U;
+            p.width[at] = 60;
+            expect_codes = 0;
+        } else if (kind == 2) {
+            p.count = 3 + Physics_Random(&rng) % 60U;
+            expect_codes = 0;
+            expect_repeats = 0;
+        } else if (kind == 3) {
+            /* Bitul 24 (primul din inversul comenzii) e inversat */
+            uint8_t at = 3 + 24 * 2 + 1;
+            p.width[at] = (p.width[at] > 1000) ? 560 : 1690;
+            expect_codes = 0;
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        NecRun(&d, &p, counts, &got);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        ns += Bench_ElapsedNs(&t0, &t1);
+        edges += p.count;
+
+        /* Repeat-urile dupa un cadru stricat sunt tot valide (ultimul cod se pastreaza) */
+        bool ok = counts[NEC_EVENT_CODE] == expect_codes &&
+                  (kind == 2 || counts[NEC_EVENT_REPEAT] == expect_repeats) &&
+                  (!expect_codes || got == code);
+        if (!ok && failures++ < 5) {
+            fprintf(stderr, "nec: frame %u kind %u code %08X: codes=%u repeats=%u errors=%u got %08X\n",
+                    (unsigned)f, kind, (unsigned)code, counts[NEC_EVENT_CODE],
+                    counts[NEC_EVENT_REPEAT], counts[NEC_EVENT_ERROR], (unsigned)got);
+        }
+    }
+
+    fprintf(stderr, "nec: %u frames (clean, glitch, truncated, bad inverse), %u failures\n",
+            (unsigned)frames, (unsigned)failures);
+    fprintf(stderr, "nec: %.1f ns/edge on host\n", edges ? ns / edges : 0.0);
+    return failures ? 1 : 0;
+}
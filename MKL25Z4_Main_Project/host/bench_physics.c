@@ -0,0 +1,274 @@
+/*
+ * bench_physics.c
+ * pong_bench -p / -a: Physics_Step pe host (partide, cazuri swept la limita),
+ * Physics_InterceptY vs varianta iterativa
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "bench.h"
+#include "sim.h"
+#include "../source/drivers/headers/physics.h"
+#include "../source/drivers/headers/game_config.h"
+
+/*============================================================================
+ * PHYSICS
+ *============================================================================*/
+
+/* Paletele urmaresc mingea cu 2 px/frame, dar sar peste un frame din trei -
+ * la viteza mare mingea le scapa, deci exista si lovituri, si goluri */
+static void TrackInputs(const Physics_State_t* s, uint32_t step, Physics_Inputs_t* in) {
+    int16_t ball_c = FIX_TO_INT(s->ball.y) + BALL_SIZE / 2;
+
+    for (uint8_t p = 0; p < 2; p++) {
+        int16_t d = ball_c - (s->paddle_y[p] + PADDLE_HEIGHT / 2);
+        if (d > 2) d = 2;
+        if (d < -2) d = -2;
+        in->paddle_dy[p] = (step % 3U == p) ? 0 : d;
+    }
+}
+
+static BenchChecks_t phys_checks = { "physics", 0, 0 };
+
+/* Un frame din starea data; paletele pornesc din p1/p2 si se misca cu dy1/dy2 */
+static uint8_t StepFrom(Physics_State_t* s, fix_t x, fix_t y, fix_t dx, fix_t dy,
+                        int16_t p1, int16_t p2, int16_t dy1, int16_t dy2) {
+    Physics_Inputs_t in = { { dy1, dy2 } };
+
+    s->ball = (PhysBall_t){ x, y, dx, dy };
+    s->paddle_y[0] = p1;
+    s->paddle_y[1] = p2;
+    return Physics_Step(s, &in);
+}
+
+/* Viteza maxima (7 px/frame, 8 cu o treapta in plus): din fiecare pozitie
+ * sub-pixel de dinaintea fetei mingea trebuie sa loveasca si sa se intoarca,
+ * inclusiv cand capatul frame-ului e in spatele paletei (x < PADDLE_X_P1),
+ * unde vechiul test punct-in-interval o lasa sa treaca */
+static void CheckMaxSpeed(Physics_State_t* s, int16_t speed) {
+    const fix_t dx = INT_TO_FIX(speed);
+    const int16_t top = PADDLE_START_Y;
+    const fix_t y = INT_TO_FIX(top + PADDLE_HEIGHT / 2 - BALL_SIZE / 2);
+    uint32_t starts = 0, behind = 0, hits = 0;
+    char what[64];
+
+    for (fix_t o = 0; o < dx; o += 3) {
+        /* P1: muchia stanga la o dupa fata, mingea merge spre stanga */
+        uint8_t ev = StepFrom(s, PHYS_FACE_P1 + o, y, -dx, 0, top, top, 0, 0);
+        if (PHYS_FACE_P1 + o - dx < INT_TO_FIX(PADDLE_X_P1)) behind++;
+        if ((ev & PHYS_EV_HIT_P1) && s->ball.dx == dx && s->ball.x >= PHYS_FACE_P1) hits++;
+
+        /* P2: oglinda */
+        ev = StepFrom(s, PHYS_FACE_P2 - INT_TO_FIX(BALL_SIZE) - o, y, dx, 0, top, top, 0, 0);
+        if ((ev & PHYS_EV_HIT_P2) && s->ball.dx == -dx &&
+            s->ball.x + INT_TO_FIX(BALL_SIZE) <= PHYS_FACE_P2) hits++;
+        starts += 2;
+    }
+
+    fprintf(stderr, "physics: %d px/frame: %u starts, %u end behind the paddle, %u hits\n",
+            speed, (unsigned)starts, (unsigned)behind, (unsigned)hits);
+    snprintf(what, sizeof(what), "%d px/frame ball hits from every sub-pixel start", speed);
+    Bench_Check(&phys_checks, behind > 0 && hits == starts, what);
+}
+
+/* Colturi: la contact, muchia de jos a mingii pe muchia de sus a paletei
+ * (si invers) e lovitura; cu 1/256 px mai departe nu mai e */
+static void CheckCorners(Physics_State_t* s) {
+    const fix_t dx = -INT_TO_FIX(7);
+    const fix_t x = PHYS_FACE_P1 + INT_TO_FIX(7) / 2;     /* Contact la jumatatea frame-ului */
+    const int16_t top = 40;
+    const fix_t above = INT_TO_FIX(top - BALL_SIZE);
+    const fix_t below = INT_TO_FIX(top + PADDLE_HEIGHT);
+    const fix_t dy = INT_TO_FIX(3);
+
+    Bench_Check(&phys_checks, StepFrom(s, x, above, dx, 0, top, top, 0, 0) & PHYS_EV_HIT_P1,
+                "top corner: ball bottom on the paddle top is a hit");
+    Bench_Check(&phys_checks, !(StepFrom(s, x, above - 1, dx, 0, top, top, 0, 0) & PHYS_EV_HIT_P1),
+                "top corner: 1/256 px above is a miss");
+    Bench_Check(&phys_checks, StepFrom(s, x, below, dx, 0, top, top, 0, 0) & PHYS_EV_HIT_P1,
+                "bottom corner: ball top on the paddle bottom is a hit");
+    Bench_Check(&phys_checks, !(StepFrom(s, x, below + 1, dx, 0, top, top, 0, 0) & PHYS_EV_HIT_P1),
+                "bottom corner: 1/256 px below is a miss");
+
+    /* Pe diagonala: Y-ul conteaza in momentul contactului, nu la capetele frame-ului */
+    uint8_t ev = StepFrom(s, x, above - dy / 2, dx, dy, top, top, 0, 0);
+    Bench_Check(&phys_checks, (ev & PHYS_EV_HIT_P1) && s->ball.dx > 0 && s->ball.dy < 0,
+                "diagonal corner: contact Y on the paddle top is a hit, deflected up");
+    Bench_Check(&phys_checks, !(StepFrom(s, x, above - dy / 2 - 1, dx, dy, top, top, 0, 0) & PHYS_EV_HIT_P1),
+                "diagonal corner: 1/256 px earlier is a miss");
+
+    /* Perete si paleta in acelasi frame, paleta lipita de perete */
+    ev = StepFrom(s, x, PHYS_BALL_MIN_Y + FIX_ONE, dx, -dy, PADDLE_MIN_Y, PADDLE_MIN_Y, 0, 0);
+    Bench_Check(&phys_checks, (ev & (PHYS_EV_HIT_P1 | PHYS_EV_WALL)) == (PHYS_EV_HIT_P1 | PHYS_EV_WALL) &&
+                s->ball.y >= PHYS_BALL_MIN_Y && s->ball.dx > 0 && s->ball.dy > 0,
+                "wall corner: wall and paddle in one frame, ball leaves down and right");
+}
+
+/* Paleta care intra in drumul mingii in frame-ul contactului: conteaza
+ * pozitia de dupa miscare, in ambele sensuri */
+static void CheckMovingPaddle(Physics_State_t* s) {
+    const fix_t dx = -INT_TO_FIX(7);
+    const fix_t x = PHYS_FACE_P1 + INT_TO_FIX(3);
+    const fix_t y = INT_TO_FIX(64);                         /* 2 px sub paleta de la 40 */
+
+    Bench_Check(&phys_checks, !(StepFrom(s, x, y, dx, 0, 40, 40, 0, 0) & PHYS_EV_HIT_P1),
+                "still paddle: ball 2 px below it misses");
+    Bench_Check(&phys_checks, StepFrom(s, x, y, dx, 0, 40, 40, PADDLE_SPEED, 0) & PHYS_EV_HIT_P1,
+                "paddle moving down into the ball hits it");
+    Bench_Check(&phys_checks, !(StepFrom(s, x, y, dx, 0, 44, 44, -PADDLE_SPEED, 0) & PHYS_EV_HIT_P1),
+                "paddle moving up away from the ball misses it");
+    Bench_Check(&phys_checks, StepFrom(s, PHYS_FACE_P2 - INT_TO_FIX(BALL_SIZE + 3), y, -dx, 0, 40, 40, 0, PADDLE_SPEED) &
+                PHYS_EV_HIT_P2, "P2 moving down into the ball hits it");
+}
+
+/* counts[b] = frame-uri cu evenimentul (1 << b); counts[5] = mingea in afara peretilor */
+static uint64_t RunPhysics(Physics_State_t* s, uint32_t steps, uint32_t counts[6]) {
+    Physics_Inputs_t in;
+    uint8_t level = 0;
+
+    for (uint32_t i = 0; i < steps; i++) {
+        TrackInputs(s, i, &in);
+        uint8_t ev = Physics_Step(s, &in);
+
+        for (uint8_t b = 0; b < 5; b++) {
+            if (ev & (1U << b)) counts[b]++;
+        }
+        if (s->ball.y < PHYS_BALL_MIN_Y || s->ball.y > PHYS_BALL_MAX_Y) counts[5]++;
+
+        if (ev & (PHYS_EV_GOAL_P1 | PHYS_EV_GOAL_P2)) {
+            Physics_Serve(s, (ev & PHYS_EV_GOAL_P1) ? -1 : 1);
+            level = 0;
+        } else if (i % SPEED_UP_INTERVAL == SPEED_UP_INTERVAL - 1 && level < MAX_SPEED_LEVEL) {
+            level++;
+            Physics_SpeedUp(s, level % 2 == 0);
+        }
+    }
+    return (uint64_t)s->ball.x ^ ((uint64_t)s->ball.y << 32) ^ s->rng;
+}
+
+int BenchPhysics(uint32_t steps, unsigned seed) {
+    Physics_State_t s;
+    uint32_t counts[6] = { 0 };
+    uint32_t check[6] = { 0 };
+    struct timespec t0, t1;
+
+    Physics_Init(&s, seed);
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    uint64_t h1 = RunPhysics(&s, steps, counts);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    /* Aceeasi stare initiala trebuie sa dea exact aceeasi partida */
+    Physics_Init(&s, seed);
+    uint64_t h2 = RunPhysics(&s, steps, check);
+
+    double sec = (double)(t1.tv_sec - t0.tv_sec) + (double)(t1.tv_nsec - t0.tv_nsec) * 1e-9;
+    bool bounded = counts[5] == 0;
+    bool same = (h1 == h2) && !memcmp(counts, check, sizeof(counts));
+
+    fprintf(stderr, "physics: %u steps in %.3f s = %.1f Msteps/s\n",
+            (unsigned)steps, sec, sec > 0 ? steps / sec / 1e6 : 0.0);
+    fprintf(stderr, "physics: hits P1=%u P2=%u goals P1=%u P2=%u\n",
+            counts[1], counts[2], counts[3], counts[4]);
+    fprintf(stderr, "physics: ball inside walls=%s deterministic=%s\n",
+            bounded ? "yes" : "NO", same ? "yes" : "NO");
+    Bench_Check(&phys_checks, bounded, "ball inside walls");
+    Bench_Check(&phys_checks, same, "same seed, same match");
+
+    CheckMaxSpeed(&s, BALL_SPEED_X + MAX_SPEED_LEVEL);
+    CheckMaxSpeed(&s, BALL_SPEED_X + MAX_SPEED_LEVEL + 1);
+    CheckCorners(&s);
+    CheckMovingPaddle(&s);
+    return Bench_Report(&phys_checks);
+}
+
+/*============================================================================
+ * AI INTERCEPT
+ *============================================================================*/
+
+#define AI_HORIZON      200
+
+/* Referinta: predictia iterativa folosita de AI inainte de varianta analitica */
+static fix_t InterceptIterative(const PhysBall_t* b, fix_t target_x, uint16_t max_frames) {
+    fix_t sim_x = b->x;
+    fix_t sim_y = b->y;
+    fix_t sim_dy = b->dy;
+    uint8_t flips;
+
+    for (uint16_t i = 0; i < max_frames; i++) {
+        sim_x += b->dx;
+        sim_y = Physics_FoldY(sim_y + sim_dy, &flips);
+        if (flips & 1U) sim_dy = -sim_dy;
+
+        if ((b->dx > 0 && sim_x >= target_x) || (b->dx < 0 && sim_x <= target_x)) {
+            return sim_y;
+        }
+    }
+    return PHYS_NO_INTERCEPT;
+}
+
+static BenchChecks_t icpt_checks = { "intercept", 0, 0 };
+
+/* Stari aleatoare: orice pozitie din teren, viteze sub-pixel pana la 8 x 4 px/frame.
+ * Costul e doar pe host (ns si ticuri TSC, ca -m si -l); pe M0+ nu e masurat */
+int BenchIntercept(uint32_t samples, unsigned seed) {
+    Physics_State_t rng;
+    PhysBall_t* balls = malloc(samples * sizeof(PhysBall_t));
+    fix_t* targets = malloc(samples * sizeof(fix_t));
+    uint32_t mismatches = 0, misses = 0;
+    volatile fix_t sink = 0;
+    struct timespec t0, t1, t2;
+
+    if (!balls || !targets) return 1;
+    Physics_Init(&rng, seed);
+
+    for (uint32_t i = 0; i < samples; i++) {
+        PhysBall_t* b = &balls[i];
+        b->x = (fix_t)(Physics_Random(&rng) % INT_TO_FIX(FIELD_WIDTH + 2 * BALL_SIZE)) - INT_TO_FIX(BALL_SIZE);
+        b->y = PHYS_BALL_MIN_Y + (fix_t)(Physics_Random(&rng) % (PHYS_BALL_MAX_Y - PHYS_BALL_MIN_Y + 1));
+        b->dx = (fix_t)(Physics_Random(&rng) % INT_TO_FIX(8)) + 1;
+        b->dy = (fix_t)(Physics_Random(&rng) % INT_TO_FIX(8)) - INT_TO_FIX(4);
+        if (Physics_Random(&rng) & 1U) b->dx = -b->dx;
+        targets[i] = (b->dx > 0) ? PHYS_FACE_P2 : PHYS_FACE_P1;
+    }
+
+    for (uint32_t i = 0; i < samples; i++) {
+        fix_t a = InterceptIterative(&balls[i], targets[i], AI_HORIZON);
+        fix_t c = Physics_InterceptY(&balls[i], targets[i], AI_HORIZON);
+        if (c == PHYS_NO_INTERCEPT) misses++;
+        if (a != c && mismatches++ < 5) {
+            fprintf(stderr, "intercept: x=%d y=%d dx=%d dy=%d -> iterative %d, closed %d\n",
+                    (int)balls[i].x, (int)balls[i].y, (int)balls[i].dx, (int)balls[i].dy,
+                    (int)a, (int)c);
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    uint64_t c0 = BENCH_TSC();
+    for (uint32_t i = 0; i < samples; i++) sink += InterceptIterative(&balls[i], targets[i], AI_HORIZON);
+    uint64_t c1 = BENCH_TSC();
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    uint64_t c2 = BENCH_TSC();
+    for (uint32_t i = 0; i < samples; i++) sink += Physics_InterceptY(&balls[i], targets[i], AI_HORIZON);
+    uint64_t c3 = BENCH_TSC();
+    clock_gettime(CLOCK_MONOTONIC, &t2);
+    (void)sink;
+
+    double ns_iter = Bench_ElapsedNs(&t0, &t1) / samples;
+    double ns_closed = Bench_ElapsedNs(&t1, &t2) / samples;
+    double tsc_iter = (double)(c1 - c0) / samples;
+    double tsc_closed = (double)(c3 - c2) / samples;
+
+    Bench_Check(&icpt_checks, mismatches == 0, "closed form matches the iterative walk on every state");
+    Bench_Check(&icpt_checks, misses < samples, "some states reach the paddle face within the horizon");
+
+    fprintf(stderr, "intercept: %u states, %u beyond the horizon\n", (unsigned)samples, (unsigned)misses);
+    fprintf(stderr, "intercept: iterative %.1f ns, %.1f TSC ticks per call; closed-form %.1f ns, %.1f TSC ticks per call (x%.1f)\n",
+            ns_iter, tsc_iter, ns_closed, tsc_closed, ns_closed > 0 ? ns_iter / ns_closed : 0.0);
+    fprintf(stderr, "intercept: host figures only, the cycles on the M0+ are not measured\n");
+
+    free(balls);
+    free(targets);
+    return Bench_Report(&icpt_checks);
+}
@@ -0,0 +1,619 @@
+/*
+ * bench_prof.c
+ * pong_bench -g: profiler.c, cosuri, span-uri, latenta input -> ecran
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "sim.h"
+#include "panel.h"
+#include "logtok.h"
+#include "profdump.h"
+#include "shim/board.h"
+#include "../source/drivers/headers/profiler.h"
+#include "../source/drivers/headers/log.h"
+#include "../source/drivers/headers/app.h"
+#include "../source/drivers/headers/st7735_simple.h"
+#include "../source/drivers/headers/joystick.h"
+#include "../source/drivers/headers/ir_remote.h"
+#include "../source/drivers/headers/pong_game.h"
+#include "../source/drivers/headers/compositor.h"
+#include "../source/drivers/headers/scheduler.h"
+#include "../source/drivers/headers/power.h"
+
+/*============================================================================
+ * PROFILER (histogramele din profiler.c, dump-ul citit cu profdump.c)
+ *============================================================================*/
+
+#if defined(PROFILER)
+static BenchChecks_t prof_checks = { "prof", 0, 0 };
+
+/* Textul de pe UART taiat in linii pentru ProfDump_Line */
+static char prof_line[256];
+static uint32_t prof_line_len;
+static ProfDump_t prof_dump;
+#if defined(LOG_TOKENIZED)
+static LogTok_t prof_dec;
+#endif
+
+static void ProfFeedChar(char c) {
+    if (prof_line_len < sizeof(prof_line) - 1U) prof_line[prof_line_len++] = c;
+    if (c != '\n') return;
+
+    prof_line[prof_line_len] = '\0';
+    ProfDump_Line(&prof_dump, prof_line);
+    prof_line_len = 0;
+}
+
+static void ProfUartSink(uint8_t byte, uint64_t when) {
+    (void)when;
+#if defined(LOG_TOKENIZED)
+    char text[LOGTOK_TEXT_MAX];
+    size_t n = LogTok_Feed(&prof_dec, byte, text);
+    for (size_t i = 0; i < n; i++) ProfFeedChar(text[i]);
+#else
+    ProfFeedChar((char)byte);
+#endif
+}
+
+/* Prof_Poll la ritmul task-ului ui pana iese tot dump-ul inceput */
+static void ProfDrainDump(void) {
+    uint64_t next = sim_cycles;
+
+    for (uint8_t i = 0; i < 40U; i++) {
+        next += SIM_MS_TO_CYCLES(50);
+        Bench_WaitUntil(next);
+        Prof_Poll();
+    }
+    Bench_LogWaitDrained();
+}
+
+/* Cosurile: limitele lui Prof_BucketLow = cele refacute de profdump.c,
+ * fiecare limita cade in cosul ei, cu un ciclu mai putin in cel dinainte */
+static void ProfBucketChecks(void) {
+    ProfHist_t h;
+    bool same = true, monotonic = true, placed = true;
+
+    for (uint8_t b = 0; b < PROF_BUCKETS; b++) {
+        uint32_t low = Prof_BucketLow(b);
+        if (low != ProfDump_BucketLow(&prof_dump, b)) same = false;
+        if (b && low <= Prof_BucketLow((uint8_t)(b - 1U))) monotonic = false;
+
+        Prof_Record(PROF_INPUT, low);
+        if (b) Prof_Record(PROF_INPUT, low - 1U);
+        Prof_Take(PROF_INPUT, &h);
+        if (h.buckets[b] != 1U || (b && h.buckets[b - 1U] != 1U)) placed = false;
+    }
+    Bench_Check(&prof_checks, same, "Prof_BucketLow matches the host-side bucket bounds");
+    Bench_Check(&prof_checks, monotonic, "bucket bounds increase");
+    Bench_Check(&prof_checks, placed, "each bound lands in its own bucket, bound - 1 in the previous one");
+
+    Prof_Record(PROF_INPUT, 0x7FFFFFFFU);
+    Prof_Record(PROF_INPUT, 0xFFFFF000U);
+    Prof_Take(PROF_INPUT, &h);
+    Bench_Check(&prof_checks, h.buckets[PROF_BUCKETS - 1U] == 2U, "long samples land in the overflow bucket");
+    Bench_Check(&prof_checks, h.count == 2 && h.min == 0x7FFFFFFFU && h.max == 0xFFFFF000U,
+                "exact count, min and max beside the buckets");
+
+    /* Cu intreruperile oprite peste trecerea SysTick (ISR in asteptare)
+     * timpul merge inainte, nu inapoi cu 1 ms */
+    uint32_t key = DisableGlobalIRQ();
+    uint64_t start = sim_cycles;
+    uint32_t t0 = Prof_Now();
+    Sim_Advance(SIM_MS_TO_CYCLES(1) + SIM_US_TO_CYCLES(300));
+    uint32_t t1 = Prof_Now();
+    uint64_t elapsed = sim_cycles - start;
+    EnableGlobalIRQ(key);
+    Bench_Check(&prof_checks, t1 - t0 + 48U >= elapsed && t1 - t0 <= elapsed + 48U,
+                "Prof_Now counts a SysTick wrap whose ISR is still pending");
+
+    uint32_t skipped = Prof_GetSkipped();
+    RunMode_Set(RUN_MODE_VLPR);
+    Prof_Record(PROF_INPUT, 1000U);
+    RunMode_Set(RUN_MODE_RUN);
+    Prof_Take(PROF_INPUT, &h);
+    Bench_Check(&prof_checks, h.count == 0 && Prof_GetSkipped() == skipped + 1U, "samples in VLPR are only counted");
+}
+
+/* Faza spi se termina cand coada DMA s-a golit, nu la iesirea din Flush */
+static void ProfSpanChecks(void) {
+    ProfHist_t h;
+
+    ST7735_WaitIdle();
+    Prof_Take(PROF_SPI, &h);
+
+    /* Simulatorul muta octetii la scrierea registrelor; cu intreruperile
+     * mascate, intreruperea de final ramane in asteptare ca pe placa */
+    uint64_t start = sim_cycles;
+    uint32_t key = DisableGlobalIRQ();
+    Prof_SpanStart(PROF_SPI);
+    ST7735_FillRectAsync(0, 0, ST7735_WIDTH, ST7735_HEIGHT, COLOR_BLACK, NULL, NULL);
+    bool busy = ST7735_IsBusy();
+    Prof_SpanClose(PROF_SPI, ST7735_IsBusy);
+    EnableGlobalIRQ(key);
+
+    ST7735_WaitIdle();
+    uint64_t wire = sim_cycles - start;
+    Prof_Take(PROF_SPI, &h);
+    Bench_Check(&prof_checks, busy && h.count == 1, "span closed with the queue busy, recorded from the DMA interrupt");
+    Bench_Check(&prof_checks, h.max + SIM_US_TO_CYCLES(20) >= wire && h.max <= wire + SIM_US_TO_CYCLES(20),
+                              "full-screen span matches the simulated transfer time");
+    fprintf(stderr, "prof: full screen fill %u us on the wire, span %u us\n",
+            (unsigned)(wire / SIM_US_TO_CYCLES(1)), (unsigned)(h.max / SIM_US_TO_CYCLES(1)));
+
+    /* Fara nimic in coada, Close inregistreaza imediat; End fara Close e ignorat */
+    Prof_SpanStart(PROF_SPI);
+    Prof_SpanEnd(PROF_SPI);
+    Prof_SpanClose(PROF_SPI, ST7735_IsBusy);
+    Prof_Take(PROF_SPI, &h);
+    Bench_Check(&prof_checks, h.count == 1, "idle queue closes the span at once, early End ignored");
+}
+
+/* Latenta input -> ecran, direct prin Tag/Commit/Done */
+static void ProfLatencyChecks(void) {
+    ProfHist_t h;
+    uint32_t stamp;
+
+    ST7735_WaitIdle();
+    for (uint8_t p = PROF_LAT_BUTTON; p < PROF_PHASES; p++) Prof_Take((ProfPhase_t)p, &h);
+
+    /* Coada goala: Commit inchide masuratoarea pe loc */
+    uint64_t start = sim_cycles;
+    stamp = Prof_Now();
+    Bench_WaitUntil(sim_cycles + SIM_MS_TO_CYCLES(3));
+    Prof_LatencyTag(INPUT_SRC_BUTTON, stamp);
+    Prof_LatencyCommit(ST7735_IsBusy);
+    uint64_t total = sim_cycles - start;
+    Prof_Take(PROF_LAT_BUTTON, &h);
+    Bench_Check(&prof_checks, h.count == 1 && h.max + SIM_US_TO_CYCLES(20) >= total && h.max <= total + SIM_US_TO_CYCLES(20),
+                              "idle display: latency recorded at commit");
+
+    /* Cu transferul in coada, abia ISR-ul DMA inchide masuratoarea; din doua
+     * input-uri nedesenate conteaza cel mai vechi */
+    start = sim_cycles;
+    stamp = Prof_Now();
+    Bench_WaitUntil(sim_cycles + SIM_MS_TO_CYCLES(1));
+    Prof_LatencyTag(INPUT_SRC_IR, stamp);
+    Prof_LatencyTag(INPUT_SRC_IR, Prof_Now());
+    uint32_t key = DisableGlobalIRQ();
+    ST7735_FillRectAsync(0, 0, ST7735_WIDTH, ST7735_HEIGHT, COLOR_BLACK, NULL, NULL);
+    bool busy = ST7735_IsBusy();
+    Prof_LatencyCommit(ST7735_IsBusy);
+    EnableGlobalIRQ(key);
+
+    ST7735_WaitIdle();
+    total = sim_cycles - start;
+    Prof_Take(PROF_LAT_IR, &h);
+    Bench_Check(&prof_checks, busy && h.count == 1, "busy display: latency recorded from the DMA interrupt, once");
+    Bench_Check(&prof_checks, h.max + SIM_US_TO_CYCLES(20) >= total && h.max <= total + SIM_US_TO_CYCLES(20),
+                              "latency runs from the oldest tag to the end of the transfer");
+
+    /* Un input mai vechi de PROF_LAT_MAX_MS nu mai e masurat */
+    stamp = Prof_Now();
+    Bench_WaitUntil(sim_cycles + SIM_MS_TO_CYCLES(PROF_LAT_MAX_MS + 10U));
+    Prof_LatencyTag(INPUT_SRC_JOYSTICK, stamp);
+    Prof_LatencyCommit(ST7735_IsBusy);
+    Prof_Take(PROF_LAT_JOYSTICK, &h);
+    Bench_Check(&prof_checks, h.count == 0, "stale tags are dropped");
+
+    /* Prof_Now numara la 48 MHz si in VLPR; latentele se inregistreaza si acolo
+     * (o trecere RUN <-> VLPR numara ms-ul inceput intreg) */
+    start = sim_cycles;
+    stamp = Prof_Now();
+    RunMode_Set(RUN_MODE_VLPR);
+    Bench_WaitUntil(sim_cycles + SIM_MS_TO_CYCLES(5));
+    Prof_LatencyTag(INPUT_SRC_BUTTON, stamp);
+    Prof_LatencyCommit(ST7735_IsBusy);
+    total = sim_cycles - start;
+    RunMode_Set(RUN_MODE_RUN);
+    Prof_Take(PROF_LAT_BUTTON, &h);
+    Bench_Check(&prof_checks, h.count == 1 && h.max + SIM_US_TO_CYCLES(20) >= total &&
+                              h.max <= total + SIM_MS_TO_CYCLES(1) + SIM_US_TO_CYCLES(20),
+                              "latency measured across a RUN -> VLPR switch");
+}
+
+/* Meciul de mai jos cu task-urile din MKL25Z4_Main_Project.c: input 1 ms,
+ * joc 20 ms, ui 50 ms (fara coborarea in VLPR) */
+static void ProfLatInputTask(void) {
+    Joystick_Process();
+    IR_Process();
+}
+
+static void ProfLatGameTask(void) {
+    InputEvent_t ev;
+
+    while (g_currentScreen == SCREEN_GAMEPLAY && InputEvents_Pop(&ev)) App_HandleInput(&ev);
+    if (g_currentScreen != SCREEN_GAMEPLAY) return;
+    if (!App_GameTick()) Game_Start();
+}
+
+static void ProfLatUiTask(void) {
+    InputEvent_t ev;
+    Screen_t screen = g_currentScreen;
+
+    while (g_currentScreen == screen && InputEvents_Pop(&ev)) App_HandleInput(&ev);
+    App_Redraw();
+}
+
+static Task_t prof_lat_input = { .name = "input", .run = ProfLatInputTask, .period_ms = 1,  .priority = 0 };
+static Task_t prof_lat_game  = { .name = "game",  .run = ProfLatGameTask,  .period_ms = 20, .priority = 1 };
+static Task_t prof_lat_ui    = { .name = "ui",    .run = ProfLatUiTask,    .period_ms = 50, .priority = 2 };
+
+/* Referinta pentru latente: paleta vazuta pe panou (varful culorii ei pe o
+ * coloana), citita la fiecare PROF_REF_POLL_US. Un input deschide o
+ * masuratoare pe paleta lui, prima miscare vizibila o inchide */
+#define PROF_REF_POLL_US        250U
+
+typedef struct {
+    uint64_t count, min, max, sum;      /* Cicluri */
+} ProfRefStats_t;
+
+static const int16_t prof_ref_x[2] = { PADDLE_X_P1 + 1, PADDLE_X_P2 + 1 };
+static const uint16_t prof_ref_color[2] = { COLOR_CYAN, COLOR_MAGENTA };
+static int16_t prof_ref_y[2];
+static uint64_t prof_ref_edge[2];
+static bool prof_ref_open[2];
+static uint8_t prof_ref_source[2];
+static ProfRefStats_t prof_ref[INPUT_NUM_SOURCES];
+static bool prof_ref_running;
+
+static int16_t ProfRefPaddleY(uint8_t i) {
+    for (int16_t y = 0; y < ST7735_HEIGHT; y++) {
+        if (Panel_GetPixel(prof_ref_x[i], y) == prof_ref_color[i]) return y;
+    }
+    return -1;
+}
+
+static void ProfRefPoll(void *arg) {
+    (void)arg;
+    for (uint8_t i = 0; i < 2; i++) {
+        int16_t y = ProfRefPaddleY(i);
+        if (y == prof_ref_y[i]) continue;
+        prof_ref_y[i] = y;
+        if (!prof_ref_open[i]) continue;
+
+        /* Ca Prof_LatencyTag: un input prea vechi nu se mai masoara */
+        uint64_t lat = sim_cycles - prof_ref_edge[i];
+        prof_ref_open[i] = false;
+        if (lat > SIM_MS_TO_CYCLES(PROF_LAT_MAX_MS)) continue;
+
+        ProfRefStats_t *r = &prof_ref[prof_ref_source[i]];
+        if (r->count == 0 || lat < r->min) r->min = lat;
+        if (lat > r->max) r->max = lat;
+        r->sum += lat;
+        r->count++;
+    }
+    if (prof_ref_running) Sim_Schedule(sim_cycles + SIM_US_TO_CYCLES(PROF_REF_POLL_US), ProfRefPoll, NULL);
+}
+
+static void ProfRefInput(uint8_t paddle, uint8_t source) {
+    prof_ref_edge[paddle] = sim_cycles;
+    prof_ref_source[paddle] = source;
+    prof_ref_open[paddle] = true;
+}
+
+static void ProfIrEdge(void *arg) {
+    Sim_PinEdge(IR_RX_PORT, IR_RX_PIN, arg != NULL);
+}
+
+static void ProfIrStart(void *arg) {
+    (void)arg;
+    ProfRefInput(0, INPUT_SRC_IR);
+    ProfIrEdge(NULL);
+}
+
+/* Stick-ul scos din centru porneste paleta P2 */
+static void ProfJoystick(void *arg) {
+    uint16_t raw = (uint16_t)(uintptr_t)arg;
+
+    if (raw != 2048U) ProfRefInput(1, INPUT_SRC_JOYSTICK);
+    Sim_SetAdc(JOYSTICK_VRY_CHANNEL, raw);
+}
+
+static uint64_t ProfIrMark(uint64_t t, uint32_t mark_us, uint32_t space_us) {
+    Sim_Schedule(t, ProfIrEdge, NULL);
+    t += SIM_US_TO_CYCLES(mark_us);
+    Sim_Schedule(t, ProfIrEdge, (void *)1);
+    return t + SIM_US_TO_CYCLES(space_us);
+}
+
+/* Un cadru NEC fara repeat-uri; intoarce cat dureaza pana la decodare
+ * (frontul bitului de stop) */
+static uint64_t ProfIrFrame(uint64_t start, uint32_t code) {
+    Sim_Schedule(start, ProfIrStart, NULL);
+    uint64_t t = start + SIM_US_TO_CYCLES(9000);
+    Sim_Schedule(t, ProfIrEdge, (void *)1);
+    t += SIM_US_TO_CYCLES(4500);
+
+    for (uint8_t i = 0; i < 32; i++) t = ProfIrMark(t, 560, (code >> i) & 1U ? 1690 : 560);
+    ProfIrMark(t, 560, 0);
+    return t - start;
+}
+
+#define PROF_LAT_PRESSES        8U
+#define PROF_LAT_PERIOD_MS      600U
+#define PROF_LAT_TOLERANCE_US   3000U   /* Sfarsitul cozii DMA vs paleta pe panou, filtrul joystick-ului */
+
+static bool ProfLatMatches(const ProfDumpPhase_t *ph, const ProfRefStats_t *r) {
+    uint64_t tol = SIM_US_TO_CYCLES(PROF_LAT_TOLERANCE_US);
+    uint64_t avg = ph->count ? ph->sum / ph->count : 0;
+    uint64_t ref_avg = r->count ? r->sum / r->count : 0;
+
+    return ph->count == r->count && r->count > 0 &&
+           ph->min + tol >= r->min && ph->min <= r->min + tol &&
+           ph->max + tol >= r->max && ph->max <= r->max + tol &&
+           avg + tol >= ref_avg && avg <= ref_avg + tol;
+}
+
+/* P1 pe telecomanda, P2 pe joystick, apoi pauza / reluare din buton; latentele
+ * din dump se compara cu paletele vazute pe panou (golurile si serviciile din
+ * meci intarzie unele input-uri pana la urmatorul frame jucat) */
+static void ProfLatencyGame(void) {
+    g_player1_input = INPUT_REMOTE;
+    g_player2_input = INPUT_JOYSTICK;
+    Sim_SetAdc(JOYSTICK_VRY_CHANNEL, 2048);
+
+    Scheduler_Init();
+    Scheduler_Add(&prof_lat_input, true);
+    Scheduler_Add(&prof_lat_game, true);
+    Scheduler_Add(&prof_lat_ui, true);
+
+    /* Countdown-ul si calibrarea joystick-ului */
+    g_currentScreen = SCREEN_GAMEPLAY;
+    g_needsRedraw = 0;
+    InputEvents_Flush();
+    Game_Start();
+    Bench_RunScheduler(4000);
+
+    memset(prof_ref, 0, sizeof(prof_ref));
+    for (uint8_t i = 0; i < 2; i++) prof_ref_y[i] = ProfRefPaddleY(i);
+    prof_ref_running = true;
+    ProfRefPoll(NULL);
+
+    /* Tastele si stick-ul alterneaza sus / jos, paletele raman departe de pereti */
+    /* Un cadru NEC are mereu 16 biti de 1 (adresa, comanda si complementele lor),
+     * deci toate dureaza la fel */
+    uint64_t start = sim_cycles, decode = 0;
+    for (uint32_t i = 0; i < PROF_LAT_PRESSES; i++) {
+        uint64_t t = start + SIM_MS_TO_CYCLES(i * PROF_LAT_PERIOD_MS + 7U * i);
+        decode = ProfIrFrame(t, (i & 1U) ? IR_CODE_UP : IR_CODE_DOWN);
+
+        t += SIM_MS_TO_CYCLES(PROF_LAT_PERIOD_MS / 2U);
+        Sim_Schedule(t, ProfJoystick, (void *)(uintptr_t)((i & 1U) ? 0 : 4095));
+        Sim_Schedule(t + SIM_MS_TO_CYCLES(150), ProfJoystick, (void *)(uintptr_t)2048);
+    }
+    Bench_RunScheduler(PROF_LAT_PRESSES * PROF_LAT_PERIOD_MS + 500U);
+    prof_ref_running = false;
+
+    /* Butonul: pauza (redesenata de ui), apoi reluarea (desenata direct) */
+    start = sim_cycles;
+    for (uint32_t i = 0; i < 2U * PROF_LAT_PRESSES; i++) {
+        uint64_t t = start + SIM_MS_TO_CYCLES(i * PROF_LAT_PERIOD_MS / 2U + 3U * i);
+        Sim_Schedule(t, Bench_PressButton, NULL);
+        Sim_Schedule(t + SIM_MS_TO_CYCLES(50), Bench_PressButton, (void *)1);
+    }
+    Bench_RunScheduler(PROF_LAT_PRESSES * PROF_LAT_PERIOD_MS + 500U);
+    Game_SetPaused(false);
+    g_currentScreen = SCREEN_GAMEPLAY;
+
+    /* Un dump doar cu meciul asta */
+    Bench_WaitUntil(sim_cycles + SIM_MS_TO_CYCLES(PROF_DUMP_MS));
+    ProfDrainDump();
+
+    const ProfDumpPhase_t *btn = &prof_dump.phase[PROF_LAT_BUTTON];
+    const ProfDumpPhase_t *ir = &prof_dump.phase[PROF_LAT_IR];
+    const ProfDumpPhase_t *joy = &prof_dump.phase[PROF_LAT_JOYSTICK];
+    uint64_t frame = SIM_MS_TO_CYCLES(GAME_FRAME_MS), flush = SIM_MS_TO_CYCLES(3);
+
+    Bench_Check(&prof_checks, ProfLatMatches(ir, &prof_ref[INPUT_SRC_IR]), "ir latency count, min, avg and max match the panel");
+    Bench_Check(&prof_checks, ProfLatMatches(joy, &prof_ref[INPUT_SRC_JOYSTICK]), "joystick latency matches the panel");
+    Bench_Check(&prof_checks, ir->min >= decode && ir->min <= decode + frame + flush,
+                              "ir: from the first edge of the frame, at least the decode time");
+    Bench_Check(&prof_checks, joy->min <= frame + flush, "joystick: a move in play shows within one game frame");
+    Bench_Check(&prof_checks, btn->count == 2U * PROF_LAT_PRESSES && btn->max <= SIM_MS_TO_CYCLES(50) + SIM_MS_TO_CYCLES(30) + flush,
+                              "button: every pause / resume measured, at most one ui period + a full-screen redraw");
+
+    fprintf(stderr, "prof: ir frame decoded %u us after its first edge\n",
+            (unsigned)(decode / SIM_US_TO_CYCLES(1)));
+    for (uint8_t i = PROF_LAT_BUTTON; i < PROF_PHASES; i++) {
+        const ProfDumpPhase_t *ph = &prof_dump.phase[i];
+        const ProfRefStats_t *r = &prof_ref[i - PROF_LAT_BUTTON];
+        fprintf(stderr, "prof: %-8s %3llu samples  min %6llu  avg %6llu  p99 %6llu  max %6llu us",
+                ProfDump_PhaseName(i), (unsigned long long)ph->count,
+                (unsigned long long)(ProfDump_CyclesToNs(&prof_dump, ph->min) / 1000U),
+                (unsigned long long)(ProfDump_CyclesToNs(&prof_dump, ProfDump_Average(&prof_dump, i)) / 1000U),
+                (unsigned long long)(ProfDump_CyclesToNs(&prof_dump, ProfDump_Percentile(&prof_dump, i, 990)) / 1000U),
+                (unsigned long long)(ProfDump_CyclesToNs(&prof_dump, ph->max) / 1000U));
+        if (r->count) {
+            fprintf(stderr, "  (panel: %llu, %llu..%llu us)", (unsigned long long)r->count,
+                    (unsigned long long)(r->min / SIM_US_TO_CYCLES(1)),
+                    (unsigned long long)(r->max / SIM_US_TO_CYCLES(1)));
+        }
+        fprintf(stderr, "\n");
+    }
+}
+
+/* Simulatorul nu numara timp pentru codul C, deci in meci ai si physics
+ * ies 0. Aici aceleasi PROF_BEGIN/END inconjoara durate modelate
+ * (Sim_Advance): ai 800..1599 cicluri, physics 2400 si o coliziune de
+ * 10800 la fiecare 25 de pasi. Din dump: count, min si max exacte,
+ * percentilele cu eroarea unui cos */
+#define PROF_MODEL_SAMPLES      1000U
+
+static uint32_t prof_model[2][PROF_MODEL_SAMPLES];
+
+static int ProfCmpCycles(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static bool ProfModelMatches(uint8_t phase, uint32_t *cycles) {
+    const ProfDumpPhase_t *ph = &prof_dump.phase[phase];
+    static const uint16_t permille[] = { 500, 900, 990 };
+    uint64_t sum = 0;
+    bool ok;
+
+    qsort(cycles, PROF_MODEL_SAMPLES, sizeof(cycles[0]), ProfCmpCycles);
+    for (uint32_t i = 0; i < PROF_MODEL_SAMPLES; i++) sum += cycles[i];
+
+    /* Prof_Now citeste SysTick: +-1 ciclu la fiecare capat */
+    ok = ph->count == PROF_MODEL_SAMPLES &&
+         ph->min + 2U >= cycles[0] && ph->min <= cycles[0] + 2U &&
+         ph->max + 2U >= cycles[PROF_MODEL_SAMPLES - 1U] && ph->max <= cycles[PROF_MODEL_SAMPLES - 1U] + 2U &&
+         ph->sum + 2U * PROF_MODEL_SAMPLES >= sum && ph->sum <= sum + 2U * PROF_MODEL_SAMPLES;
+
+    fprintf(stderr, "prof: %-8s %6u modelled  min %6llu", ProfDump_PhaseName(phase),
+            (unsigned)ph->count, (unsigned long long)ProfDump_CyclesToNs(&prof_dump, ph->min));
+    for (uint8_t i = 0; i < sizeof(permille) / sizeof(permille[0]); i++) {
+        uint32_t exact = cycles[(PROF_MODEL_SAMPLES * permille[i] + 999U) / 1000U - 1U];
+        uint32_t got = ProfDump_Percentile(&prof_dump, phase, permille[i]);
+
+        /* Cosuri de un sfert de octava: sub 19% */
+        if ((uint64_t)got * 5U > (uint64_t)exact * 6U || (uint64_t)got * 6U < (uint64_t)exact * 5U) ok = false;
+        fprintf(stderr, "  p%u %6llu (exact %llu)", permille[i] / 10U,
+                (unsigned long long)ProfDump_CyclesToNs(&prof_dump, got),
+                (unsigned long long)ProfDump_CyclesToNs(&prof_dump, exact));
+    }
+    fprintf(stderr, "  max %6llu ns\n", (unsigned long long)ProfDump_CyclesToNs(&prof_dump, ph->max));
+    return ok;
+}
+
+static void ProfModelChecks(void) {
+    uint32_t seed = 1U;
+
+    /* profdump.c aduna dump-urile: aici doar esantioanele modelate */
+    ProfDump_Init(&prof_dump);
+
+    for (uint32_t i = 0; i < PROF_MODEL_SAMPLES; i++) {
+        seed = seed * 1103515245U + 12345U;
+        uint32_t ai = 800U + (seed >> 16) % 800U;
+        uint32_t physics = (i % 25U == 24U) ? 10800U : 2400U;
+        prof_model[0][i] = ai;
+        prof_model[1][i] = physics;
+
+        PROF_BEGIN(PROF_AI);
+        Sim_Advance(ai);
+        PROF_END(PROF_AI);
+        PROF_BEGIN(PROF_PHYSICS);
+        Sim_Advance(physics);
+        PROF_END(PROF_PHYSICS);
+    }
+    Bench_WaitUntil(sim_cycles + SIM_MS_TO_CYCLES(PROF_DUMP_MS));
+    ProfDrainDump();
+
+    Bench_Check(&prof_checks, ProfModelMatches(PROF_AI, prof_model[0]),
+                "ai: modelled durations, exact count/min/max/sum, p50/p90/p99 within one bucket");
+    Bench_Check(&prof_checks, ProfModelMatches(PROF_PHYSICS, prof_model[1]),
+                "physics: modelled durations with 4% collisions, p99 on the collision cost");
+    ProfDump_Init(&prof_dump);
+}
+
+int BenchProfiler(uint32_t seconds) {
+    LogStats_t st;
+
+    BOARD_InitBootClocks();
+    SysTick_Config(SystemCoreClock / 1000U);
+    BOARD_InitDebugConsole();
+    Power_Init();
+    RunMode_Init();
+    RunMode_AddListener(Bench_SysTickOnRunMode);
+    ProfDump_Init(&prof_dump);
+#if defined(LOG_TOKENIZED)
+    Bench_Check(&prof_checks, LogTok_LoadElf(&prof_dec, "/proc/self/exe"), "log_fmt section in the ELF");
+#endif
+    Sim_SetUartSink(ProfUartSink);
+    Log_Init();
+    Bench_LogWaitDrained();
+
+    ST7735_Init();
+    Joystick_Init();
+    IR_Init();
+
+    ProfBucketChecks();
+    ProfSpanChecks();
+    ProfLatencyChecks();
+    ProfLatencyGame();
+    ProfModelChecks();
+
+    /* CPU vs CPU, cu dump-ul la ritmul ui-ului (50 ms) ca in firmware */
+    g_player1_input = INPUT_CPU_HARD;
+    g_player2_input = INPUT_CPU_HARD;
+    g_currentDifficulty = DIFF_NORMAL;
+    uint32_t frames = seconds * (1000U / GAME_FRAME_MS);
+    uint32_t max_bytes = 0;
+    uint64_t next = sim_cycles;
+
+    Game_Start();
+    for (uint32_t f = 0; f < frames; f++) {
+        next += SIM_MS_TO_CYCLES(GAME_FRAME_MS);
+        Bench_WaitUntil(next);
+        if (!Game_IsRunning()) Game_Start();
+        Game_Update();
+        if (Compositor_GetLastFrameBytes() > max_bytes) max_bytes = Compositor_GetLastFrameBytes();
+        if (f % (50U / GAME_FRAME_MS + 1U) == 0) Prof_Poll();
+        if (sim_cycles > next) next = sim_cycles;
+    }
+    ST7735_WaitIdle();
+    Bench_WaitUntil(sim_cycles + SIM_MS_TO_CYCLES(PROF_DUMP_MS));
+    ProfDrainDump();
+    Log_GetStats(&st);
+
+    const ProfDumpPhase_t *ai = &prof_dump.phase[PROF_AI];
+    const ProfDumpPhase_t *render = &prof_dump.phase[PROF_RENDER];
+    const ProfDumpPhase_t *spi = &prof_dump.phase[PROF_SPI];
+    uint64_t in_buckets[PROF_PHASES] = { 0 };
+    bool complete = true, averaged = true;
+    for (uint8_t i = 0; i < PROF_PHASES; i++) {
+        const ProfDumpPhase_t *ph = &prof_dump.phase[i];
+        for (uint8_t b = 0; b < PROF_BUCKETS; b++) in_buckets[i] += ph->buckets[b];
+        if (in_buckets[i] != ph->count) complete = false;
+        if (ph->count && (ProfDump_Average(&prof_dump, i) < ph->min ||
+                          ProfDump_Average(&prof_dump, i) > ph->max)) averaged = false;
+    }
+
+    Bench_Check(&prof_checks, prof_dump.dumps >= seconds * 1000U / PROF_DUMP_MS, "one dump every PROF_DUMP_MS");
+    Bench_Check(&prof_checks, prof_dump.errors == 0, "every [PROF] line parsed");
+    Bench_Check(&prof_checks, st.dropped == 0, "the dump never overflows the LOG ring");
+    Bench_Check(&prof_checks, complete, "bucket counts add up to each phase count");
+    Bench_Check(&prof_checks, averaged, "each average (S lines) between min and max");
+    Bench_Check(&prof_checks, ai->count > 0 && ai->count == prof_dump.phase[PROF_PHYSICS].count &&
+                              ai->count == render->count, "ai, physics and render once per game frame");
+    Bench_Check(&prof_checks, spi->count >= render->count, "an spi span for every rendered frame");
+    Bench_Check(&prof_checks, spi->max >= (uint64_t)max_bytes * Sim_SpiByteCycles(),
+                              "the longest spi span covers the largest frame on the wire");
+    Bench_Check(&prof_checks, ProfDump_Percentile(&prof_dump, PROF_SPI, 500) <= ProfDump_Percentile(&prof_dump, PROF_SPI, 990) &&
+                              ProfDump_Percentile(&prof_dump, PROF_SPI, 990) <= spi->max &&
+                              ProfDump_Percentile(&prof_dump, PROF_SPI, 500) >= spi->min, "percentiles ordered within min..max");
+
+    fprintf(stderr, "prof: %u dumps, %u log records, largest frame %u bytes (%u us on the wire)\n",
+            (unsigned)prof_dump.dumps, (unsigned)st.written, (unsigned)max_bytes,
+            (unsigned)((uint64_t)max_bytes * Sim_SpiByteCycles() / SIM_US_TO_CYCLES(1)));
+    /* ai si physics au doar numarul: codul C nu consuma timp simulat */
+    fprintf(stderr, "prof: ai, physics %llu samples each, 0 ns in the simulator (see the modelled run)\n",
+            (unsigned long long)ai->count);
+    for (uint8_t i = 0; i < PROF_LAT_BUTTON; i++) {
+        const ProfDumpPhase_t *ph = &prof_dump.phase[i];
+        if (!ph->count || i == PROF_AI || i == PROF_PHYSICS) continue;
+        fprintf(stderr, "prof: %-8s %6llu samples  min %6llu  p50 %6llu  p99 %6llu  max %6llu ns\n",
+                ProfDump_PhaseName(i), (unsigned long long)ph->count,
+                (unsigned long long)ProfDump_CyclesToNs(&prof_dump, ph->min),
+                (unsigned long long)ProfDump_CyclesToNs(&prof_dump, ProfDump_Percentile(&prof_dump, i, 500)),
+                (unsigned long long)ProfDump_CyclesToNs(&prof_dump, ProfDump_Percentile(&prof_dump, i, 990)),
+                (unsigned long long)ProfDump_CyclesToNs(&prof_dump, ph->max));
+    }
+
+#if defined(LOG_TOKENIZED)
+    LogTok_Free(&prof_dec);
+#endif
+    Sim_SetUartSink(NULL);
+    return Bench_Report(&prof_checks);
+}
+#else
+int BenchProfiler(uint32_t seconds) {
+    (void)seconds;
+    fprintf(stderr, "prof: built without -DPROFILER, the PROF_* markers compile to nothing\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,153 @@
+/*
+ * bench_sched.c
+ * pong_bench -k: scenarii pentru scheduler.c pe timpul simulat
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "bench.h"
+#include "sim.h"
+#include "shim/board.h"
+#include "../source/drivers/headers/scheduler.h"
+
+/*============================================================================
+ * SCHEDULER
+ *============================================================================*/
+
+extern volatile uint32_t g_systick_ms;
+
+/* Task-urile de test consuma timp simulat, ca un task real care asteapta SPI */
+static char sched_order[16];
+static uint8_t sched_order_len;
+static uint32_t sched_work_us[4] = { 0 };
+static uint8_t sched_work_idx;
+static uint32_t sched_notify_us, sched_latency_max_us;
+static BenchChecks_t sched_checks = { "sched", 0, 0 };
+
+static void SchedLog(char c) {
+    if (sched_order_len < sizeof(sched_order) - 1) sched_order[sched_order_len++] = c;
+}
+
+static void TaskHi(void)   { SchedLog('H'); }
+static void TaskLo(void)   { SchedLog('L'); }
+static void TaskLo2(void)  { SchedLog('l'); }
+static void TaskSlow(void) { Sim_Advance(SIM_MS_TO_CYCLES(7)); }
+
+static void TaskVarying(void) {
+    Sim_Advance(SIM_US_TO_CYCLES(sched_work_us[sched_work_idx++ & 3U]));
+}
+
+static void TaskEvent(void) {
+    uint32_t latency = Scheduler_NowUs() - sched_notify_us;
+    if (latency > sched_latency_max_us) sched_latency_max_us = latency;
+}
+
+static Task_t task_hi   = { .name = "hi",   .run = TaskHi,      .period_ms = 10, .priority = 0 };
+static Task_t task_lo   = { .name = "lo",   .run = TaskLo,      .period_ms = 10, .priority = 1 };
+static Task_t task_lo2  = { .name = "lo2",  .run = TaskLo2,     .period_ms = 5,  .priority = 1 };
+static Task_t task_slow = { .name = "slow", .run = TaskSlow,    .period_ms = 5,  .priority = 0 };
+static Task_t task_var  = { .name = "var",  .run = TaskVarying, .period_ms = 10, .priority = 0 };
+static Task_t task_ev   = { .name = "ev",   .run = TaskEvent,   .period_ms = 0,  .priority = 0 };
+
+/* Echivalentul unui ISR: notifica task-ul de evenimente */
+static void NotifyEvent(void *arg) {
+    (void)arg;
+    sched_notify_us = Scheduler_NowUs();
+    Scheduler_Notify(&task_ev);
+}
+
+static void SchedReset(void) {
+    Scheduler_Init();
+    task_hi.enabled = task_lo.enabled = task_lo2.enabled = false;
+    task_slow.enabled = task_var.enabled = task_ev.enabled = false;
+    sched_order_len = 0;
+    memset(sched_order, 0, sizeof(sched_order));
+}
+
+int BenchScheduler(void) {
+    uint32_t idle;
+
+    BOARD_InitBootClocks();
+    SysTick_Config(SystemCoreClock / 1000U);
+
+    /* Prioritatea intai, apoi deadline-ul cel mai apropiat (lo2: 5 ms) */
+    SchedReset();
+    Scheduler_Add(&task_lo, true);
+    Scheduler_Add(&task_lo2, true);
+    Scheduler_Add(&task_hi, true);
+    Bench_RunScheduler(1);
+    fprintf(stderr, "sched: order at t=0: %s\n", sched_order);
+    Bench_Check(&sched_checks, strcmp(sched_order, "HlL") == 0, "priority, then earliest deadline");
+
+    /* Perioade: 100 ms -> 10 rulari pentru 10 ms, 20 pentru 5 ms */
+    Bench_RunScheduler(99);
+    Bench_Check(&sched_checks, task_hi.runs == 10 && task_lo.runs == 10 && task_lo2.runs == 20,
+                               "periodic release count");
+    Bench_Check(&sched_checks, task_hi.overruns == 0 && task_lo.overruns == 0, "no overruns when idle");
+    idle = Scheduler_GetIdleCount();
+    Bench_Check(&sched_checks, idle > 0, "idles in __WFI when nothing is ready");
+    fprintf(stderr, "sched: 100 ms: hi=%u lo=%u lo2=%u runs, %u idle entries\n",
+            (unsigned)task_hi.runs, (unsigned)task_lo.runs, (unsigned)task_lo2.runs,
+            (unsigned)idle);
+
+    /* 7 ms de lucru la 5 ms perioada: fiecare rulare e overrun, fara rafala */
+    SchedReset();
+    Scheduler_Add(&task_slow, true);
+    Bench_RunScheduler(100);
+    fprintf(stderr, "sched: 7 ms task every 5 ms: %u runs, %u overruns, wcet %u us\n",
+            (unsigned)task_slow.runs, (unsigned)task_slow.overruns, (unsigned)task_slow.wcet_us);
+    Bench_Check(&sched_checks, task_slow.overruns == task_slow.runs, "overrun counted on every late finish");
+    Bench_Check(&sched_checks, task_slow.runs <= 100 / 7 + 1, "no catch-up burst after overrun");
+
+    /* WCET pe durate variabile */
+    SchedReset();
+    sched_work_us[0] = 100;
+    sched_work_us[1] = 300;
+    sched_work_us[2] = 900;
+    sched_work_us[3] = 200;
+    sched_work_idx = 0;
+    Scheduler_Add(&task_var, true);
+    Bench_RunScheduler(40);
+    fprintf(stderr, "sched: varying task: wcet %u us, total %u us over %u runs\n",
+            (unsigned)task_var.wcet_us, (unsigned)task_var.total_us, (unsigned)task_var.runs);
+    Bench_Check(&sched_checks, task_var.wcet_us >= 900 && task_var.wcet_us <= 901, "wcet tracks the longest run");
+    Bench_Check(&sched_checks, task_var.total_us >= 1500 && task_var.total_us <= 1504, "total run time");
+
+    /* Task notificat din "ISR": ruleaza o data per notificare, imediat */
+    SchedReset();
+    Scheduler_Add(&task_ev, true);
+    sched_latency_max_us = 0;
+    for (uint32_t i = 0; i < 5; i++) {
+        Sim_Schedule(sim_cycles + SIM_US_TO_CYCLES(3333 * (i + 1)), NotifyEvent, NULL);
+    }
+    Bench_RunScheduler(20);
+    fprintf(stderr, "sched: event task: %u runs, max latency %u us\n",
+            (unsigned)task_ev.runs, (unsigned)sched_latency_max_us);
+    Bench_Check(&sched_checks, task_ev.runs == 5, "one run per notification");
+    Bench_Check(&sched_checks, sched_latency_max_us < 1000, "notified task runs before the next tick");
+
+    /* Timpul citit cu intreruperile oprite, la fiecare 100 us, de la 700 us
+     * intr-o milisecunda pana dupa trecerea SysTick al carei ISR asteapta:
+     * nu sare inapoi si nu pierde */
+    bool monotonic = true, exact = true;
+    uint32_t ticks;
+    Scheduler_ReadTick(&ticks);
+    Sim_Advance(SysTick->LOAD + 1U - ticks + SIM_US_TO_CYCLES(700));
+    uint32_t key = DisableGlobalIRQ();
+    uint64_t start = sim_cycles;
+    uint32_t t0 = Scheduler_NowUs(), prev = t0;
+    for (uint32_t i = 0; i < 9; i++) {
+        Sim_Advance(SIM_US_TO_CYCLES(100));
+        uint32_t now = Scheduler_NowUs();
+        if ((int32_t)(now - prev) <= 0) monotonic = false;
+        if (now - t0 != (uint32_t)((sim_cycles - start) / SIM_US_TO_CYCLES(1))) exact = false;
+        prev = now;
+    }
+    uint32_t ms = Scheduler_ReadTick(&ticks);
+    EnableGlobalIRQ(key);
+    fprintf(stderr, "sched: IRQs masked for 900 us, time advanced %u us\n", (unsigned)(prev - t0));
+    Bench_Check(&sched_checks, monotonic && exact, "Scheduler_NowUs counts a SysTick wrap whose ISR is pending");
+    Bench_Check(&sched_checks, ms == g_systick_ms, "the pending tick is counted once, after its ISR");
+
+    return Bench_Report(&sched_checks);
+}
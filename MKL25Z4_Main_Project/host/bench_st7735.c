@@ -0,0 +1,418 @@
+/*
+ * bench_st7735.c
+ * pong_bench -d: coada DMA din st7735_simple.c la nivel de registre -
+ * descriptorii TX/RX scrisi de DMA_StartNext, umplerea prin SMOD,
+ * secventa CS/DC pe fir si asteptarea cu coada plina
+ * pong_bench -t: costul SPI al fiecarui ecran de meniu, textul opac pe
+ * calea veche (celula cu celula, refacuta aici din ST7735_FillRect /
+ * ST7735_DrawPixel) fata de DrawTextLine
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "bench.h"
+#include "sim.h"
+#include "panel.h"
+#include "shim/board.h"
+#include "../source/drivers/headers/st7735_simple.h"
+#include "../source/drivers/headers/menu.h"
+
+/*============================================================================
+ * DMA / SPI CAPTURE
+ *============================================================================*/
+
+#define LCD_DMA_TX_CH       0U
+#define LCD_DMA_RX_CH       1U
+#define LCD_CS_PIN          4U      /* PTC4 */
+#define LCD_DC_PIN          3U      /* PTC3 */
+#define DMA_CAPTURE_MAX     16U
+#define SPI_CAPTURE_MAX     4096U
+
+/* DCR-urile pe care DMA_StartNext trebuie sa le scrie */
+#define DCR_COMMON          (DMA_DCR_ERQ_MASK | DMA_DCR_CS_MASK | DMA_DCR_D_REQ_MASK | \
+                             DMA_DCR_SSIZE(1) | DMA_DCR_DSIZE(1))
+#define DCR_TX_BLIT         (DCR_COMMON | DMA_DCR_SINC_MASK)
+#define DCR_TX_FILL         (DCR_COMMON | DMA_DCR_SINC_MASK | DMA_DCR_SMOD(1))
+#define DCR_RX              (DCR_COMMON | DMA_DCR_EINT_MASK)
+
+typedef struct {
+    uint8_t tx_ch;
+    uint32_t sar, dar, bcr, dcr;
+    uint32_t rx_sar, rx_dar, rx_bcr, rx_dcr;
+    uint8_t pattern[16];            /* Primii 16 octeti de la SAR */
+    bool cs, dc;                    /* Pinii LCD la pornire */
+} DmaCapture_t;
+
+typedef struct {
+    uint8_t byte;
+    bool dc;
+    bool dma;
+} SpiCapture_t;
+
+static BenchChecks_t lcd_checks = { "st7735", 0, 0 };
+
+static DmaCapture_t dma_cap[DMA_CAPTURE_MAX];
+static uint32_t dma_cap_count;
+static SpiCapture_t spi_cap[SPI_CAPTURE_MAX];
+static uint32_t spi_cap_count;
+static uint8_t done_order[DMA_CAPTURE_MAX];
+static uint32_t done_count;
+
+static void CaptureDmaStart(uint8_t tx_ch) {
+    if (dma_cap_count >= DMA_CAPTURE_MAX) return;
+
+    DmaCapture_t *c = &dma_cap[dma_cap_count++];
+    uint32_t pins = sim_gpio[2].PDOR;
+    c->tx_ch = tx_ch;
+    c->sar = sim_dma0.DMA[LCD_DMA_TX_CH].SAR;
+    c->dar = sim_dma0.DMA[LCD_DMA_TX_CH].DAR;
+    c->bcr = sim_dma0.DMA[LCD_DMA_TX_CH].DSR_BCR & DMA_DSR_BCR_BCR_MASK;
+    c->dcr = sim_dma0.DMA[LCD_DMA_TX_CH].DCR;
+    c->rx_sar = sim_dma0.DMA[LCD_DMA_RX_CH].SAR;
+    c->rx_dar = sim_dma0.DMA[LCD_DMA_RX_CH].DAR;
+    c->rx_bcr = sim_dma0.DMA[LCD_DMA_RX_CH].DSR_BCR & DMA_DSR_BCR_BCR_MASK;
+    c->rx_dcr = sim_dma0.DMA[LCD_DMA_RX_CH].DCR;
+    memcpy(c->pattern, (const void *)(uintptr_t)c->sar, sizeof(c->pattern));
+    c->cs = (pins >> LCD_CS_PIN) & 1U;
+    c->dc = (pins >> LCD_DC_PIN) & 1U;
+}
+
+static void CaptureSpi(uint8_t byte, bool dc, bool dma) {
+    if (spi_cap_count >= SPI_CAPTURE_MAX) return;
+    spi_cap[spi_cap_count++] = (SpiCapture_t){ byte, dc, dma };
+}
+
+static void RecordDone(void *ctx) {
+    if (done_count < DMA_CAPTURE_MAX) done_order[done_count] = (uint8_t)(uintptr_t)ctx;
+    done_count++;
+}
+
+static void ResetCapture(void) {
+    dma_cap_count = 0;
+    spi_cap_count = 0;
+    done_count = 0;
+}
+
+static bool PinsIdle(void) {
+    return (sim_gpio[2].PDOR >> LCD_CS_PIN) & 1U;
+}
+
+/* Dupa ultimul DMA1_IRQHandler: CS ridicat, cererile DMA ale SPI oprite.
+ * DONE nu se poate verifica: in sim DSR_BCR e memorie simpla, fara
+ * stergerea la scrierea lui 1, deci valoarea scrisa de ISR arata la fel
+ * ca cea lasata de DmaFinish */
+static bool DmaIdle(void) {
+    Sim_Advance(0);
+    return PinsIdle() && !ST7735_IsBusy() &&
+           !(sim_spi0.C2 & (SPI_C2_TXDMAE_MASK | SPI_C2_RXDMAE_MASK));
+}
+
+/* CASET x0..x1, RASET y0..y1, RAMWR - comenzi cu DC = 0, argumente cu DC = 1,
+ * scrise de CPU (nu DMA) */
+static bool WindowOnWire(uint32_t at, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1) {
+    static const bool dc[11] = { 0, 1, 1, 1, 1, 0, 1, 1, 1, 1, 0 };
+    const uint8_t bytes[11] = { ST7735_CASET, 0, x0, 0, x1, ST7735_RASET, 0, y0, 0, y1, ST7735_RAMWR };
+
+    if (at + 11U > spi_cap_count) return false;
+    for (uint32_t i = 0; i < 11U; i++) {
+        const SpiCapture_t *s = &spi_cap[at + i];
+        if (s->byte != bytes[i] || s->dc != dc[i] || s->dma) return false;
+    }
+    return true;
+}
+
+/* len octeti de date prin DMA (DC = 1) incepand cu at, egali cu expect[i % period] */
+static bool DataOnWire(uint32_t at, uint32_t len, const uint8_t *expect, uint32_t period) {
+    if (at + len > spi_cap_count) return false;
+    for (uint32_t i = 0; i < len; i++) {
+        const SpiCapture_t *s = &spi_cap[at + i];
+        if (!s->dc || !s->dma || s->byte != expect[i % period]) return false;
+    }
+    return true;
+}
+
+/*============================================================================
+ * CASES
+ *============================================================================*/
+
+/* Umplere: SAR pe fill_pattern (aliniat, SMOD = 16 octeti), bucla peste 16 */
+static void CheckFill(void) {
+    const uint8_t color[2] = { COLOR_MAGENTA >> 8, COLOR_MAGENTA & 0xFF };
+    const uint32_t len = 30U * 4U * 2U;
+
+    ResetCapture();
+    ST7735_FillRectAsync(10, 20, 30, 4, COLOR_MAGENTA, RecordDone, (void *)1);
+    ST7735_WaitIdle();
+
+    const DmaCapture_t *c = &dma_cap[0];
+    bool pattern = true;
+    for (uint8_t i = 0; i < 16; i++) pattern &= c->pattern[i] == color[i & 1];
+
+    Bench_Check(&lcd_checks, dma_cap_count == 1 && c->tx_ch == LCD_DMA_TX_CH, "fill: one TX descriptor on channel 0");
+    Bench_Check(&lcd_checks, (c->sar & 15U) == 0 && pattern, "fill: SAR on a 16-byte aligned color pattern");
+    Bench_Check(&lcd_checks, c->dar == (uint32_t)(uintptr_t)&sim_spi0.D, "fill: TX DAR = SPI0->D");
+    Bench_Check(&lcd_checks, c->bcr == len && c->rx_bcr == len, "fill: TX and RX BCR = w * h * 2");
+    Bench_Check(&lcd_checks, c->dcr == DCR_TX_FILL, "fill: TX DCR = SINC | SMOD(16 B), 8-bit, cycle steal, no EINT");
+    Bench_Check(&lcd_checks, c->rx_sar == (uint32_t)(uintptr_t)&sim_spi0.D && c->rx_dcr == DCR_RX,
+                "fill: RX SPI0->D -> dummy, EINT, no increment");
+    Bench_Check(&lcd_checks, !c->cs && c->dc, "fill: CS low, DC high when the DMA starts");
+    Bench_Check(&lcd_checks, WindowOnWire(0, 10, 20, 39, 23), "fill: CASET/RASET/RAMWR with DC low on the commands");
+    Bench_Check(&lcd_checks, spi_cap_count == 11U + len && DataOnWire(11, len, color, 2),
+                "fill: SMOD wraps the pattern over all w * h pixels");
+    Bench_Check(&lcd_checks, Panel_GetPixel(10, 20) == COLOR_MAGENTA && Panel_GetPixel(39, 23) == COLOR_MAGENTA &&
+                Panel_GetPixel(40, 23) != COLOR_MAGENTA, "fill: exactly the rectangle on the panel");
+    Bench_Check(&lcd_checks, done_count == 1 && DmaIdle(), "fill: callback once, CS high, SPI DMA off");
+}
+
+/* Blit: SAR pe buffer-ul apelantului, fara SMOD */
+static void CheckBlit(void) {
+    static uint8_t pixels[4 * 2 * 2];
+
+    for (uint8_t i = 0; i < sizeof(pixels); i++) pixels[i] = (uint8_t)(0x11U * i + 1U);
+    ResetCapture();
+    ST7735_BlitAsync(100, 50, 4, 2, pixels, RecordDone, (void *)2);
+    ST7735_WaitIdle();
+
+    const DmaCapture_t *c = &dma_cap[0];
+    Bench_Check(&lcd_checks, dma_cap_count == 1 && c->sar == (uint32_t)(uintptr_t)pixels,
+                "blit: TX SAR = caller's buffer");
+    Bench_Check(&lcd_checks, c->bcr == sizeof(pixels) && c->rx_bcr == sizeof(pixels), "blit: TX and RX BCR = w * h * 2");
+    Bench_Check(&lcd_checks, c->dcr == DCR_TX_BLIT && c->rx_dcr == DCR_RX, "blit: TX DCR = SINC without SMOD");
+    Bench_Check(&lcd_checks, WindowOnWire(0, 100, 50, 103, 51) &&
+                DataOnWire(11, sizeof(pixels), pixels, sizeof(pixels)), "blit: window, then the buffer byte for byte");
+    Bench_Check(&lcd_checks, Panel_GetPixel(100, 50) == ((pixels[0] << 8) | pixels[1]) &&
+                Panel_GetPixel(103, 51) == ((pixels[14] << 8) | pixels[15]), "blit: big-endian RGB565 on the panel");
+    Bench_Check(&lcd_checks, done_count == 1 && DmaIdle(), "blit: callback once, CS high, SPI DMA off");
+}
+
+static void ReleaseDma(void *arg) {
+    Sim_SetSpiDmaHold(false);
+}
+
+/* Coada plina: SPI-ul tinut pe loc umple coada; urmatorul Enqueue asteapta
+ * in bucla pana cand intreruperea DMA elibereaza un slot */
+static void CheckQueueFull(void) {
+    static uint8_t pixels[ST7735_DMA_QUEUE_DEPTH][2];
+    const uint64_t hold = SIM_MS_TO_CYCLES(2);
+
+    ResetCapture();
+    Sim_SetSpiDmaHold(true);
+    for (uint8_t i = 0; i < ST7735_DMA_QUEUE_DEPTH - 1U; i++) {
+        pixels[i][0] = i;
+        pixels[i][1] = (uint8_t)~i;
+        ST7735_BlitAsync(i, 100, 1, 1, pixels[i], RecordDone, (void *)(uintptr_t)(i + 1U));
+    }
+    Bench_Check(&lcd_checks, ST7735_IsBusy() && done_count == 0 && dma_cap_count == 0 && !PinsIdle(),
+                "queue: first transfer armed and held, CS stays low");
+    Bench_Check(&lcd_checks, spi_cap_count == 11U && WindowOnWire(0, 0, 100, 0, 100),
+                "queue: only the first window went out");
+
+    uint8_t last = ST7735_DMA_QUEUE_DEPTH - 1U;
+    pixels[last][0] = 0xA5;
+    pixels[last][1] = 0x5A;
+    uint64_t start = sim_cycles;
+    Sim_Schedule(start + hold, ReleaseDma, NULL);
+    ST7735_BlitAsync(last, 100, 1, 1, pixels[last], RecordDone, (void *)(uintptr_t)(last + 1U));
+    ST7735_WaitIdle();
+
+    Bench_Check(&lcd_checks, sim_cycles >= start + hold, "queue: a full queue waits for the DMA interrupt");
+
+    bool fifo = done_count == ST7735_DMA_QUEUE_DEPTH && dma_cap_count == ST7735_DMA_QUEUE_DEPTH;
+    for (uint8_t i = 0; fifo && i < ST7735_DMA_QUEUE_DEPTH; i++) {
+        const DmaCapture_t *c = &dma_cap[i];
+        fifo = done_order[i] == i + 1U && c->sar == (uint32_t)(uintptr_t)pixels[i] && c->bcr == 2U &&
+               c->dcr == DCR_TX_BLIT && !c->cs && c->dc;
+    }
+    Bench_Check(&lcd_checks, fifo, "queue: every descriptor and callback in FIFO order");
+
+    /* Pe fir: fereastra + 2 octeti de date per transfer, in ordine */
+    bool wire = spi_cap_count == ST7735_DMA_QUEUE_DEPTH * 13U;
+    for (uint8_t i = 0; wire && i < ST7735_DMA_QUEUE_DEPTH; i++) {
+        wire = WindowOnWire(i * 13U, i, 100, i, 100) && DataOnWire(i * 13U + 11U, 2, pixels[i], 2);
+    }
+    Bench_Check(&lcd_checks, wire, "queue: window and data of each transfer, none lost or repeated");
+    Bench_Check(&lcd_checks, DmaIdle(), "queue: CS high, SPI DMA off after the last transfer");
+}
+
+/*============================================================================
+ * ST7735 DMA
+ *============================================================================*/
+
+int BenchSt7735Dma(void) {
+    BOARD_InitBootClocks();
+    ST7735_Init();
+
+    Sim_SetDmaStartSink(CaptureDmaStart);
+    Sim_SetSpiSink(CaptureSpi);
+    CheckFill();
+    CheckBlit();
+    CheckQueueFull();
+    Sim_SetSpiSink(NULL);
+    Sim_SetDmaStartSink(NULL);
+
+    return Bench_Report(&lcd_checks);
+}
+
+/*============================================================================
+ * PER-CELL TEXT
+ *============================================================================*/
+
+/* pong_bench e legat cu --wrap pe functiile de text ale driverului
+ * (BENCH_WRAP in Makefile), deci apelurile din menu.c si pong_game.c trec
+ * pe aici. Normal merg mai departe la driver; cu text_per_cell textul opac
+ * e desenat ca inainte de DrawTextLine: fiecare celula a glifei e un pixel
+ * sau un FillRect separat, fundalul inclus */
+void __real_ST7735_DrawChar(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size);
+void __real_ST7735_DrawString(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg);
+void __real_ST7735_DrawStringScaled(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size);
+void __real_ST7735_DrawStringCentered(int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size);
+
+static bool text_per_cell;
+
+static void DrawCharCells(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size) {
+    const uint8_t* glyph = ST7735_GetGlyph(c);
+    if (glyph == NULL) return;
+
+    for (int8_t i = 0; i < 5; i++) {
+        uint8_t line = glyph[i];
+        for (int8_t j = 0; j < 7; j++) {
+            uint16_t cell = (line & (1 << j)) ? color : bg;
+            if (size == 1) {
+                ST7735_DrawPixel(x + i, y + j, cell);
+            } else {
+                ST7735_FillRect(x + i * size, y + j * size, size, size, cell);
+            }
+        }
+    }
+}
+
+void __wrap_ST7735_DrawChar(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size) {
+    if (!text_per_cell || bg == color) {
+        __real_ST7735_DrawChar(x, y, c, color, bg, size);
+        return;
+    }
+    DrawCharCells(x, y, c, color, bg, size);
+}
+
+void __wrap_ST7735_DrawStringScaled(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size) {
+    if (!text_per_cell || bg == color) {
+        __real_ST7735_DrawStringScaled(x, y, str, color, bg, size);
+        return;
+    }
+    for (; *str; str++, x += FONT_WIDTH * size) {
+        DrawCharCells(x, y, *str, color, bg, size);
+    }
+}
+
+void __wrap_ST7735_DrawString(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg) {
+    if (!text_per_cell || bg == color) {
+        __real_ST7735_DrawString(x, y, str, color, bg);
+        return;
+    }
+    __wrap_ST7735_DrawStringScaled(x, y, str, color, bg, 1);
+}
+
+void __wrap_ST7735_DrawStringCentered(int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size) {
+    if (!text_per_cell || bg == color) {
+        __real_ST7735_DrawStringCentered(y, str, color, bg, size);
+        return;
+    }
+    int16_t len = strlen(str);
+    __wrap_ST7735_DrawStringScaled((ST7735_WIDTH - len * FONT_WIDTH * size) / 2, y, str, color, bg, size);
+}
+
+/*============================================================================
+ * MENU TEXT COST (-DST7735_STATS)
+ *============================================================================*/
+
+#if defined(ST7735_STATS)
+static BenchChecks_t text_checks = { "text", 0, 0 };
+
+static const struct {
+    Screen_t screen;
+    const char *name;
+} text_screens[] = {
+    { SCREEN_BOOT_HELP, "BOOT_HELP" }, { SCREEN_MAIN, "MAIN" }, { SCREEN_START, "START" },
+    { SCREEN_SELECT_INPUT, "SELECT_INPUT" }, { SCREEN_SELECT_P1, "SELECT_P1" },
+    { SCREEN_SELECT_P2, "SELECT_P2" }, { SCREEN_DIFFICULTY, "DIFFICULTY" },
+    { SCREEN_GAME_OVER, "GAME_OVER" }, { SCREEN_PAUSED, "PAUSED" },
+};
+
+static uint16_t text_fb[ST7735_WIDTH * ST7735_HEIGHT];
+
+/* Un ecran desenat de Menu_DrawCurrent peste un panou negru; contoarele
+ * driverului trebuie sa fie exact traficul vazut de panou */
+static Panel_Stats_t DrawScreen(Screen_t screen, bool per_cell) {
+    ST7735_FillScreen(COLOR_BLACK);
+    ST7735_WaitIdle();
+    Sim_Sync();
+
+    g_currentScreen = screen;
+    g_menuState.selectedIndex = 0;
+    text_per_cell = per_cell;
+    ST7735_ResetStats();
+    Panel_Stats_t before = *Panel_GetStats();
+
+    Menu_DrawCurrent();
+    ST7735_Stats_t st;
+    ST7735_GetStats(&st);
+    text_per_cell = false;
+    Sim_Sync();
+
+    const Panel_Stats_t *after = Panel_GetStats();
+    Panel_Stats_t d = {
+        .bytes = after->bytes - before.bytes,
+        .windows = after->windows - before.windows,
+        .cs_toggles = after->cs_toggles - before.cs_toggles,
+        .pixels = after->pixels - before.pixels,
+    };
+    Bench_Check(&text_checks, st.bytes == d.bytes && st.windows == d.windows &&
+                st.cs_toggles == d.cs_toggles, "driver counters match the panel");
+    return d;
+}
+
+static uint64_t WireUs(uint64_t bytes) {
+    return bytes * Sim_SpiByteCycles() / (SIM_CORE_HZ / 1000000U);
+}
+
+/*============================================================================
+ * ST7735 TEXT
+ *============================================================================*/
+
+int BenchSt7735Text(void) {
+    char what[64];
+
+    BOARD_InitBootClocks();
+    ST7735_Init();
+
+    fprintf(stderr, "%-13s %17s %15s %13s %15s\n", "screen",
+            "bytes", "windows", "CS", "wire us");
+    fprintf(stderr, "%-13s %8s %8s %7s %7s %6s %6s %7s %7s\n", "",
+            "cell", "line", "cell", "line", "cell", "line", "cell", "line");
+    for (uint8_t i = 0; i < sizeof(text_screens) / sizeof(text_screens[0]); i++) {
+        Panel_Stats_t cell = DrawScreen(text_screens[i].screen, true);
+        memcpy(text_fb, Panel_Framebuffer(), sizeof(text_fb));
+        Panel_Stats_t line = DrawScreen(text_screens[i].screen, false);
+
+        fprintf(stderr, "%-13s %8llu %8llu %7llu %7llu %6llu %6llu %7llu %7llu\n",
+                text_screens[i].name,
+                (unsigned long long)cell.bytes, (unsigned long long)line.bytes,
+                (unsigned long long)cell.windows, (unsigned long long)line.windows,
+                (unsigned long long)cell.cs_toggles, (unsigned long long)line.cs_toggles,
+                (unsigned long long)WireUs(cell.bytes), (unsigned long long)WireUs(line.bytes));
+
+        snprintf(what, sizeof(what), "%s: same pixels on both paths", text_screens[i].name);
+        Bench_Check(&text_checks, memcmp(text_fb, Panel_Framebuffer(), sizeof(text_fb)) == 0, what);
+        snprintf(what, sizeof(what), "%s: fewer bytes and windows with DrawTextLine",
+                 text_screens[i].name);
+        Bench_Check(&text_checks, line.bytes < cell.bytes && line.windows < cell.windows, what);
+    }
+
+    return Bench_Report(&text_checks);
+}
+#else
+int BenchSt7735Text(void) {
+    fprintf(stderr, "text: built without -DST7735_STATS, the driver has no SPI counters to compare\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,126 @@
+/*
+ * bench_synth.c
+ * pong_bench -m: mixerul din synth.c, corectitudine si cost per esantion
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "bench.h"
+#include "sim.h"
+#include "../source/drivers/headers/synth.h"
+
+/*============================================================================
+ * SYNTH (mixerul din synth.c, direct, fara simulare)
+ *============================================================================*/
+
+/* Bugetul pe M0+ la SYNTH_SAMPLE_HZ: core 48 MHz in RUN, 4 MHz in VLPR */
+#define SYNTH_RUN_CYCLES    (48000000U / SYNTH_SAMPLE_HZ)
+#define SYNTH_VLPR_CYCLES   (4000000U / SYNTH_SAMPLE_HZ)
+
+static BenchChecks_t synth_checks = { "synth", 0, 0 };
+static uint32_t synth_done_calls;
+
+/* Dupa nota de test urmeaza o pauza lunga */
+static void SynthRestAfterNote(uint8_t voice) {
+    synth_done_calls++;
+    Synth_Note(voice, 0, 1000U);
+}
+
+static void SynthMixBlocks(uint16_t *out, uint32_t n) {
+    for (uint32_t i = 0; i < n; i += SYNTH_BLOCK) {
+        Synth_Mix(&out[i], (n - i < SYNTH_BLOCK) ? n - i : SYNTH_BLOCK);
+    }
+}
+
+static void SynthChecks(void) {
+    static uint16_t out[SYNTH_SAMPLE_HZ];
+    uint32_t crossings = 0, lo = 4095, hi = 0;
+
+    /* 440 Hz sinus pe o secunda: 440 treceri crescatoare prin mijloc */
+    Synth_Init(NULL);
+    Synth_SetVoice(0, SYNTH_WAVE_SINE, SYNTH_VOLUME_MAX);
+    Synth_Note(0, Synth_StepForMilliHz(440000U), SYNTH_SAMPLE_HZ);
+    SynthMixBlocks(out, SYNTH_SAMPLE_HZ);
+    for (uint32_t i = 1; i < SYNTH_SAMPLE_HZ; i++) {
+        if (out[i - 1] < SYNTH_DAC_MID && out[i] >= SYNTH_DAC_MID) crossings++;
+    }
+    Bench_Check(&synth_checks, crossings >= 439U && crossings <= 440U, "440 Hz sine");
+
+    /* Patru dreptunghiuri in faza, volum maxim: fara depasire de 12 biti */
+    Synth_Init(NULL);
+    for (uint8_t v = 0; v < SYNTH_VOICES; v++) {
+        Synth_SetVoice(v, SYNTH_WAVE_SQUARE, SYNTH_VOLUME_MAX);
+        Synth_Note(v, Synth_StepForMilliHz(1000000U), SYNTH_BLOCK * 4U);
+    }
+    SynthMixBlocks(out, SYNTH_BLOCK * 4U);
+    for (uint32_t i = 0; i < SYNTH_BLOCK * 4U; i++) {
+        if (out[i] < lo) lo = out[i];
+        if (out[i] > hi) hi = out[i];
+    }
+    fprintf(stderr, "synth: %u voices full scale -> %u..%u of 0..4095\n", SYNTH_VOICES,
+            (unsigned)lo, (unsigned)hi);
+    Bench_Check(&synth_checks, hi <= 4095U && lo < SYNTH_DAC_MID && hi > SYNTH_DAC_MID &&
+                               hi - lo > 3U * 4095U / 4U, "4 voices use the range without wrapping");
+
+    /* O nota de 100 de esantioane peste granita de bloc: callback-ul vine
+     * exact la esantionul 100, iar pauza de dupa e liniste */
+    synth_done_calls = 0;
+    Synth_Init(SynthRestAfterNote);
+    Synth_SetVoice(0, SYNTH_WAVE_SQUARE, SYNTH_VOLUME_MAX);
+    Synth_Note(0, Synth_StepForMilliHz(1000000U), 100U);
+    SynthMixBlocks(out, SYNTH_BLOCK * 4U);
+    uint32_t last_sound = 0;
+    for (uint32_t i = 0; i < SYNTH_BLOCK * 4U; i++) {
+        if (out[i] != SYNTH_DAC_MID) last_sound = i;
+    }
+    Bench_Check(&synth_checks, synth_done_calls == 1 && last_sound == 99U && Synth_IsActive(0),
+                               "note ends mid-block on its sample");
+
+    /* Fara voci: liniste, Synth_Mix raporteaza 0 voci active */
+    Synth_Init(NULL);
+    bool silent = Synth_Mix(out, SYNTH_BLOCK) == 0;
+    for (uint32_t i = 0; i < SYNTH_BLOCK; i++) {
+        if (out[i] != SYNTH_DAC_MID) silent = false;
+    }
+    Bench_Check(&synth_checks, silent, "no voices -> DAC midpoint");
+}
+
+int BenchSynth(uint32_t samples) {
+    static const SynthWave_t waves[SYNTH_VOICES] = {
+        SYNTH_WAVE_SQUARE, SYNTH_WAVE_TRIANGLE, SYNTH_WAVE_SINE, SYNTH_WAVE_SQUARE
+    };
+    static const uint32_t mhz[SYNTH_VOICES] = { 440000U, 659255U, 880000U, 1318510U };
+    static uint16_t block[SYNTH_BLOCK];
+    volatile uint32_t sink = 0;
+    struct timespec t0, t1;
+
+    SynthChecks();
+
+    fprintf(stderr, "synth: %u Hz, block %u, M0+ budget %u cycles/sample (RUN), %u (VLPR)\n",
+            SYNTH_SAMPLE_HZ, SYNTH_BLOCK, SYNTH_RUN_CYCLES, SYNTH_VLPR_CYCLES);
+    fprintf(stderr, "%-7s %10s %12s\n", "voices", "ns/sample", "tsc/sample");
+    for (uint8_t voices = 0; voices <= SYNTH_VOICES; voices++) {
+        Synth_Init(NULL);
+        for (uint8_t v = 0; v < voices; v++) {
+            Synth_SetVoice(v, waves[v], SYNTH_VOLUME_MAX / 2U);
+            Synth_Note(v, Synth_StepForMilliHz(mhz[v]), UINT32_MAX);
+        }
+
+        uint32_t blocks = samples / SYNTH_BLOCK;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        uint64_t c0 = BENCH_TSC();
+        for (uint32_t b = 0; b < blocks; b++) {
+            Synth_Mix(block, SYNTH_BLOCK);
+            sink += block[b % SYNTH_BLOCK];
+        }
+        uint64_t c1 = BENCH_TSC();
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+
+        double n = (double)blocks * SYNTH_BLOCK;
+        fprintf(stderr, "%-7u %10.2f %12.2f\n", voices, n > 0 ? Bench_ElapsedNs(&t0, &t1) / n : 0.0,
+                n > 0 ? (double)(c1 - c0) / n : 0.0);
+    }
+    (void)sink;
+
+    return Bench_Report(&synth_checks);
+}
@@ -0,0 +1,106 @@
+/*
+ * logdec.c
+ * Reface textul consolei dintr-un build cu -DLOG_TOKENIZED
+ *
+ * Formatele nu sunt in flash: dictionarul e sectiunea log_fmt din ELF-ul
+ * cu care a fost programata placa (Debug/MKL25Z4_Main_Project.axf). Fluxul
+ * vine dintr-un fisier sau de la stdin, ex:
+ *   stty -F /dev/ttyACM0 115200 raw && ./logdec firmware.axf < /dev/ttyACM0
+ *
+ * Utilizare:
+ *   ./logdec firmware.axf [captura.bin]  - decodeaza (implicit stdin)
+ *   ./logdec -l firmware.axf             - dictionarul: token, format
+ *
+ * La final: cadre, erori si octeti pe fir fata de textul refacut (stderr).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "logtok.h"
+
+static void PrintEscaped(const char *s) {
+    for (; *s; s++) {
+        if (*s == '\r') fputs("\\r", stdout);
+        else if (*s == '\n') fputs("\\n", stdout);
+        else fputc(*s, stdout);
+    }
+}
+
+/* Formatele sunt separate de 0 (plus umplutura de aliniere) */
+static void ListDictionary(const LogTok_t *dec) {
+    uint32_t count = 0;
+
+    for (uint32_t off = 0; off < dec->size; ) {
+        const char *s = dec->strings + off;
+        size_t len = strlen(s);
+        if (len) {
+            printf("0x%04llX  \"", (unsigned long long)(dec->base + off));
+            PrintEscaped(s);
+            printf("\"\n");
+            count++;
+        }
+        off += (uint32_t)len + 1U;
+    }
+    fprintf(stderr, "logdec: %u formats, %u bytes kept out of flash\n", (unsigned)count, (unsigned)dec->size);
+}
+
+int main(int argc, char **argv) {
+    bool list = false;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "l")) != -1) {
+        switch (opt) {
+            case 'l': list = true; break;
+            default:
+                fprintf(stderr, "usage: %s [-l] firmware.elf [capture]\n", argv[0]);
+                return 2;
+        }
+    }
+    if (optind >= argc) {
+        fprintf(stderr, "usage: %s [-l] firmware.elf [capture]\n", argv[0]);
+        return 2;
+    }
+
+    LogTok_t dec;
+    if (!LogTok_LoadElf(&dec, argv[optind])) {
+        fprintf(stderr, "logdec: %s: no log_fmt section (not built with -DLOG_TOKENIZED?)\n", argv[optind]);
+        return 1;
+    }
+    if (list) {
+        ListDictionary(&dec);
+        LogTok_Free(&dec);
+        return 0;
+    }
+
+    FILE *in = stdin;
+    if (optind + 1 < argc) {
+        in = fopen(argv[optind + 1], "rb");
+        if (!in) {
+            perror(argv[optind + 1]);
+            LogTok_Free(&dec);
+            return 1;
+        }
+    }
+
+    /* Fara buffer la iesire: liniile apar cand vin de pe UART */
+    setvbuf(stdout, NULL, _IONBF, 0);
+    char text[LOGTOK_TEXT_MAX];
+    int c;
+    while ((c = fgetc(in)) != EOF) {
+        size_t n = LogTok_Feed(&dec, (uint8_t)c, text);
+        if (n) fwrite(text, 1, n, stdout);
+    }
+    if (in != stdin) fclose(in);
+
+    fprintf(stderr, "logdec: %u frames, %u errors, %u bytes on the wire -> %u bytes of text",
+            (unsigned)dec.frames, (unsigned)dec.errors, (unsigned)dec.wire_bytes, (unsigned)dec.text_bytes);
+    if (dec.wire_bytes) {
+        fprintf(stderr, " (%.1fx)", (double)dec.text_bytes / dec.wire_bytes);
+    }
+    fprintf(stderr, "\n");
+
+    LogTok_Free(&dec);
+    return dec.errors ? 1 : 0;
+}
@@ -0,0 +1,234 @@
+/*
+ * logtok.c
+ * Dictionarul din ELF si decodarea cadrelor din logtok.h
+ *
+ * Cadrul (log.c, Log_Encode): LOG_FRAME_START + nargs, apoi 1 + nargs
+ * varint-uri (7 biti pe octet, LSB intai, bitul 7 = mai urmeaza). Formatarea
+ * repeta subsetul din log.c (%d %i %u %x %X %c %%, '-', '0', latime);
+ * argumentele lipsa sunt 0, ca pe placa.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <elf.h>
+#include "logtok.h"
+
+/*============================================================================
+ * ELF
+ *============================================================================*/
+
+static uint8_t *ReadFile(const char *path, size_t *size) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return NULL;
+
+    uint8_t *data = NULL;
+    size_t cap = 0, len = 0;
+    for (;;) {
+        if (len == cap) {
+            cap = cap ? cap * 2U : 65536U;
+            uint8_t *grown = realloc(data, cap);
+            if (!grown) {
+                free(data);
+                fclose(f);
+                return NULL;
+            }
+            data = grown;
+        }
+        size_t n = fread(data + len, 1, cap - len, f);
+        if (n == 0) break;
+        len += n;
+    }
+    fclose(f);
+    *size = len;
+    return data;
+}
+
+/* Sectiunea dupa nume; tabelele de sectiuni la fel ca in <elf.h> */
+#define FIND_SECTION(Ehdr, Shdr)                                                        \
+    do {                                                                                \
+        const Ehdr *eh = (const Ehdr *)data;                                            \
+        if (size < sizeof(Ehdr) || eh->e_shoff + (uint64_t)eh->e_shnum * sizeof(Shdr) > size || \
+            eh->e_shstrndx >= eh->e_shnum) {                                            \
+            return false;                                                               \
+        }                                                                               \
+        const Shdr *sh = (const Shdr *)(data + eh->e_shoff);                            \
+        const Shdr *names = &sh[eh->e_shstrndx];                                        \
+        for (uint32_t i = 0; i < eh->e_shnum; i++) {                                    \
+            if (sh[i].sh_name >= names->sh_size) continue;                              \
+            if (strcmp((const char *)data + names->sh_offset + sh[i].sh_name, name) != 0) continue; \
+            if (sh[i].sh_type == SHT_NOBITS || sh[i].sh_offset + sh[i].sh_size > size) return false; \
+            *offset = sh[i].sh_offset;                                                  \
+            *len = sh[i].sh_size;                                                       \
+            *addr = sh[i].sh_addr;                                                      \
+            return true;                                                                \
+        }                                                                               \
+        return false;                                                                   \
+    } while (0)
+
+static bool FindSection32(const uint8_t *data, size_t size, const char *name,
+                          uint64_t *offset, uint64_t *len, uint64_t *addr) {
+    FIND_SECTION(Elf32_Ehdr, Elf32_Shdr);
+}
+
+static bool FindSection64(const uint8_t *data, size_t size, const char *name,
+                          uint64_t *offset, uint64_t *len, uint64_t *addr) {
+    FIND_SECTION(Elf64_Ehdr, Elf64_Shdr);
+}
+
+/*============================================================================
+ * FORMATTER
+ *============================================================================*/
+
+static size_t Append(char *out, size_t len, const char *text, size_t n) {
+    if (len + n > LOGTOK_TEXT_MAX - 1U) n = LOGTOK_TEXT_MAX - 1U - len;
+    memcpy(out + len, text, n);
+    return len + n;
+}
+
+static size_t Format(char *out, const char *fmt, const uint32_t *args, uint8_t nargs) {
+    size_t len = 0;
+    uint8_t next = 0;
+
+    while (*fmt) {
+        if (*fmt != '%') {
+            len = Append(out, len, fmt++, 1);
+            continue;
+        }
+
+        /* Specificatorul, copiat pentru snprintf */
+        const char *spec = fmt++;
+        while (*fmt == '-' || *fmt == '0') fmt++;
+        while (*fmt >= '0' && *fmt <= '9') fmt++;
+        char conv = *fmt;
+        if (conv == '\0') break;
+        fmt++;
+        if (conv == '%') {
+            len = Append(out, len, "%", 1);
+            continue;
+        }
+
+        char pattern[16], piece[48];
+        size_t plen = (size_t)(fmt - spec);
+        if (plen >= sizeof(pattern)) plen = sizeof(pattern) - 1U;
+        memcpy(pattern, spec, plen);
+        pattern[plen] = '\0';
+
+        uint32_t arg = (next < nargs) ? args[next] : 0U;
+        next++;
+        int n;
+        switch (conv) {
+            case 'd':
+            case 'i': n = snprintf(piece, sizeof(piece), pattern, (int)(int32_t)arg); break;
+            case 'u':
+            case 'x':
+            case 'X': n = snprintf(piece, sizeof(piece), pattern, (unsigned)arg); break;
+            case 'c': n = snprintf(piece, sizeof(piece), "%c", (char)arg); break;
+            default:  n = snprintf(piece, sizeof(piece), "%%%c", conv); break;
+        }
+        if (n > 0) len = Append(out, len, piece, ((size_t)n < sizeof(piece)) ? (size_t)n : sizeof(piece) - 1U);
+    }
+    out[len] = '\0';
+    return len;
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+bool LogTok_LoadElf(LogTok_t *dec, const char *path) {
+    size_t size;
+    uint64_t offset, len, addr;
+    bool found = false;
+
+    memset(dec, 0, sizeof(*dec));
+    uint8_t *data = ReadFile(path, &size);
+    if (!data) return false;
+
+    if (size >= EI_NIDENT && memcmp(data, ELFMAG, SELFMAG) == 0 && data[EI_DATA] == ELFDATA2LSB) {
+        if (data[EI_CLASS] == ELFCLASS32) {
+            found = FindSection32(data, size, "log_fmt", &offset, &len, &addr);
+        } else if (data[EI_CLASS] == ELFCLASS64) {
+            found = FindSection64(data, size, "log_fmt", &offset, &len, &addr);
+        }
+    }
+
+    if (found) {
+        /* Un 0 in plus: ultimul format e terminat si daca sectiunea e taiata */
+        dec->strings = malloc(len + 1U);
+        if (dec->strings) {
+            memcpy(dec->strings, data + offset, len);
+            dec->strings[len] = '\0';
+            dec->size = (uint32_t)len;
+            dec->base = addr;
+        } else {
+            found = false;
+        }
+    }
+    free(data);
+    return found;
+}
+
+void LogTok_Free(LogTok_t *dec) {
+    free(dec->strings);
+    dec->strings = NULL;
+    dec->size = 0;
+}
+
+const char *LogTok_Lookup(const LogTok_t *dec, uint32_t token) {
+    if (token < dec->base || token - dec->base >= dec->size) return NULL;
+    return dec->strings + (token - dec->base);
+}
+
+size_t LogTok_Feed(LogTok_t *dec, uint8_t byte, char *out) {
+    dec->wire_bytes++;
+    out[0] = '\0';
+
+    if (!dec->in_frame) {
+        if (byte >= LOG_FRAME_START && byte <= LOG_FRAME_START + LOG_MAX_ARGS) {
+            dec->in_frame = true;
+            dec->nargs = (uint8_t)(byte - LOG_FRAME_START);
+            dec->count = 0;
+            dec->shift = 0;
+            dec->values[0] = 0;
+            return 0;
+        }
+        /* Text (PRINTF); ce nu e ASCII si nu incepe un cadru se pierde */
+        if (byte >= 0x80U) {
+            dec->errors++;
+            return 0;
+        }
+        out[0] = (char)byte;
+        out[1] = '\0';
+        dec->text_bytes++;
+        return 1;
+    }
+
+    dec->values[dec->count] |= (uint32_t)(byte & 0x7FU) << dec->shift;
+    if (byte & 0x80U) {
+        dec->shift += 7;
+        if (dec->shift > 28) {
+            dec->in_frame = false;
+            dec->errors++;
+            return (size_t)snprintf(out, LOGTOK_TEXT_MAX, "<logtok: bad varint>\r\n");
+        }
+        return 0;
+    }
+
+    dec->shift = 0;
+    if (++dec->count <= dec->nargs) {
+        dec->values[dec->count] = 0;
+        return 0;
+    }
+
+    dec->in_frame = false;
+    const char *fmt = LogTok_Lookup(dec, dec->values[0]);
+    if (!fmt) {
+        dec->errors++;
+        return (size_t)snprintf(out, LOGTOK_TEXT_MAX, "<logtok: unknown token 0x%X>\r\n", dec->values[0]);
+    }
+    dec->frames++;
+    size_t len = Format(out, fmt, &dec->values[1], dec->nargs);
+    dec->text_bytes += (uint32_t)len;
+    return len;
+}
@@ -0,0 +1,59 @@
+/*
+ * logtok.h
+ * Decodorul cadrelor LOG_TOKENIZED (source/drivers/headers/log.h)
+ *
+ * Dictionarul e sectiunea log_fmt din ELF-ul firmware-ului: tokenul e
+ * adresa formatului in sectiune. Fluxul de pe UART e dat octet cu octet;
+ * textul (PRINTF ramase) trece neschimbat, cadrele devin linii formatate
+ * cu acelasi subset printf ca log.c.
+ */
+
+#ifndef LOGTOK_H
+#define LOGTOK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "../source/drivers/headers/log.h"
+
+typedef struct {
+    char *strings;              /* Continutul log_fmt (copie) */
+    uint64_t base;              /* sh_addr: tokenul primului octet */
+    uint32_t size;
+
+    /* Cadrul in curs */
+    bool in_frame;
+    uint8_t nargs;
+    uint8_t count;              /* Varint-uri complete (token + argumente) */
+    uint8_t shift;
+    uint32_t values[1U + LOG_MAX_ARGS];
+
+    /* Contoare */
+    uint32_t frames;
+    uint32_t errors;            /* Token necunoscut sau varint prea lung */
+    uint32_t wire_bytes;
+    uint32_t text_bytes;        /* Text produs, cadre + octeti trecuti */
+} LogTok_t;
+
+/**
+ * Incarca dictionarul din ELF (32 sau 64 de biti)
+ * @return false daca fisierul nu e ELF sau nu are sectiunea log_fmt
+ */
+bool LogTok_LoadElf(LogTok_t *dec, const char *path);
+
+void LogTok_Free(LogTok_t *dec);
+
+/**
+ * Formatul unui token, NULL daca nu e in dictionar
+ */
+const char *LogTok_Lookup(const LogTok_t *dec, uint32_t token);
+
+/**
+ * Un octet de pe fir
+ * @param out textul produs (terminat cu 0), cel putin LOGTOK_TEXT_MAX octeti
+ * @return lungimea textului din out (0 = nimic inca)
+ */
+#define LOGTOK_TEXT_MAX     256U
+size_t LogTok_Feed(LogTok_t *dec, uint8_t byte, char *out);
+
+#endif /* LOGTOK_H */
@@ -0,0 +1,185 @@
+/*
+ * main.c
+ * Build host: ruleaza firmware-ul (source/) pe Linux cu un ST7735 virtual
+ *
+ * Utilizare:
+ *   ./pong_host [-t trace] [-o dir] [-d ms] [-T ms] [-q]
+ *     -t trace   input scriptat (vezi trace.h)
+ *     -o dir     unde se scriu capturile (implicit .)
+ *     -d ms      captura periodica la fiecare ms de timp virtual
+ *     -T ms      durata maxima a simularii (implicit 60000)
+ *     -q         fara PRINTF si fara consola UART0 (LOG) din firmware
+ *
+ * La final scrie <dir>/final.png si un rezumat pe stdout.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <unistd.h>
+#include "sim.h"
+#include "panel.h"
+#include "trace.h"
+#include "logtok.h"
+#include "../source/drivers/headers/input_events.h"
+#include "../source/drivers/headers/joystick.h"
+#include "../source/drivers/headers/scheduler.h"
+#include "../source/drivers/headers/power.h"
+#include "../source/drivers/headers/run_mode.h"
+#if defined(SDK_OS_FREE_RTOS)
+#include "../source/pong_rtos.h"
+#endif
+
+/* main() din MKL25Z4_Main_Project.c, redenumit la compilare */
+extern int Firmware_Main(void);
+
+static const char *out_dir = ".";
+static uint32_t dump_every_ms = 0;
+static bool quiet = false;
+
+/*============================================================================
+ * HOST HOOKS
+ *============================================================================*/
+
+int Host_Printf(const char *fmt, ...) {
+    if (quiet) return 0;
+
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vfprintf(stderr, fmt, ap);
+    va_end(ap);
+    return n;
+}
+
+/* Consola UART0: ce trimite firmware-ul pe fir (LOG, log_kl25z.c) */
+#if defined(LOG_TOKENIZED)
+/* Cadrele decodate cu dictionarul din propriul ELF, ca logdec */
+static LogTok_t uart_dec;
+
+static void UartSink(uint8_t byte, uint64_t when) {
+    char text[LOGTOK_TEXT_MAX];
+    (void)when;
+    size_t n = LogTok_Feed(&uart_dec, byte, text);
+    if (n) fwrite(text, 1, n, stderr);
+}
+#else
+static void UartSink(uint8_t byte, uint64_t when) {
+    (void)when;
+    fputc(byte, stderr);
+}
+#endif
+
+void Host_Finish(void) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/final.png", out_dir);
+    Panel_WriteImage(path);
+
+    const Panel_Stats_t *s = Panel_GetStats();
+    printf("time_ms=%llu spi_bytes=%llu windows=%llu cs_toggles=%llu pixels=%llu\n",
+           (unsigned long long)(sim_cycles / SIM_MS_TO_CYCLES(1)),
+           (unsigned long long)s->bytes, (unsigned long long)s->windows,
+           (unsigned long long)s->cs_toggles, (unsigned long long)s->pixels);
+
+    InputStats_t in;
+    InputEvents_GetStats(&in);
+    printf("input_events=%lu input_dropped=%lu input_max_latency_ms=%lu adc_samples=%lu\n",
+           (unsigned long)in.consumed, (unsigned long)in.dropped,
+           (unsigned long)in.latency_max_ms, (unsigned long)Joystick_GetSampleCount());
+
+#if defined(SDK_OS_FREE_RTOS)
+    RtosTaskStats_t ts;
+    for (uint8_t i = 0; PongRtos_GetTaskStats(i, &ts); i++) {
+        printf("task=%s runs=%lu wcet_us=%lu total_ms=%lu stack_free_words=%lu\n", ts.name,
+               (unsigned long)ts.runs, (unsigned long)ts.wcet_us,
+               (unsigned long)(ts.total_us / 1000U), (unsigned long)ts.stack_free_words);
+    }
+    RtosQueueStats_t qs;
+    PongRtos_GetQueueStats(&qs);
+    printf("ui_queue_max=%u ui_queue_full=%lu game_state_writes=%lu\n",
+           qs.ui_queue_max, (unsigned long)qs.ui_queue_full,
+           (unsigned long)qs.game_state_writes);
+#else
+    for (uint8_t i = 0; Scheduler_GetTask(i) != NULL; i++) {
+        const Task_t *t = Scheduler_GetTask(i);
+        printf("task=%s runs=%lu overruns=%lu wcet_us=%lu total_ms=%lu\n", t->name,
+               (unsigned long)t->runs, (unsigned long)t->overruns,
+               (unsigned long)t->wcet_us, (unsigned long)(t->total_us / 1000U));
+    }
+    printf("idle=%lu\n", (unsigned long)Scheduler_GetIdleCount());
+
+    SimPowerStats_t sp;
+    PowerStats_t ps;
+    RunModeStats_t rs;
+    Sim_GetPowerStats(&sp);
+    Power_GetStats(&ps);
+    RunMode_GetStats(&rs);
+    uint64_t run = sim_cycles - sp.wait_cycles - sp.vlpr_cycles - sp.vlpw_cycles - sp.vlps_cycles;
+    printf("power run_ms=%llu wait_ms=%llu vlpr_ms=%llu vlpw_ms=%llu vlps_ms=%llu "
+           "vlps_entries=%lu aborts=%lu relocks=%lu wakeups_timer=%lu wakeups_event=%lu "
+           "to_vlpr=%lu to_run=%lu est_mcu_uA=%llu\n",
+           (unsigned long long)(run / SIM_MS_TO_CYCLES(1)),
+           (unsigned long long)(sp.wait_cycles / SIM_MS_TO_CYCLES(1)),
+           (unsigned long long)(sp.vlpr_cycles / SIM_MS_TO_CYCLES(1)),
+           (unsigned long long)(sp.vlpw_cycles / SIM_MS_TO_CYCLES(1)),
+           (unsigned long long)(sp.vlps_cycles / SIM_MS_TO_CYCLES(1)),
+           (unsigned long)ps.vlps_entries, (unsigned long)ps.vlps_aborts,
+           (unsigned long)ps.pll_relocks, (unsigned long)ps.timer_wakeups, (unsigned long)ps.event_wakeups,
+           (unsigned long)rs.to_vlpr, (unsigned long)rs.to_run,
+           (unsigned long long)Sim_EstimateCurrentUa(&sp, sim_cycles));
+#endif
+    fflush(stdout);
+    exit(0);
+}
+
+static void PeriodicDump(void *arg) {
+    (void)arg;
+    char path[512];
+    snprintf(path, sizeof(path), "%s/frame_%06llu.png", out_dir,
+             (unsigned long long)(sim_cycles / SIM_MS_TO_CYCLES(1)));
+    Panel_WriteImage(path);
+    Sim_Schedule(sim_cycles + SIM_MS_TO_CYCLES(dump_every_ms), PeriodicDump, NULL);
+}
+
+/*============================================================================
+ * MAIN
+ *============================================================================*/
+
+int main(int argc, char **argv) {
+    const char *trace = NULL;
+    uint32_t max_ms = 60000;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "t:o:d:T:q")) != -1) {
+        switch (opt) {
+            case 't': trace = optarg; break;
+            case 'o': out_dir = optarg; break;
+            case 'd': dump_every_ms = (uint32_t)atoi(optarg); break;
+            case 'T': max_ms = (uint32_t)atoi(optarg); break;
+            case 'q': quiet = true; break;
+            default:
+                fprintf(stderr, "usage: %s [-t trace] [-o dir] [-d ms] [-T ms] [-q]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    if (trace && !Trace_Load(trace, out_dir)) {
+        return 1;
+    }
+    if (dump_every_ms) {
+        Sim_Schedule(SIM_MS_TO_CYCLES(dump_every_ms), PeriodicDump, NULL);
+    }
+    Sim_SetStopTime(SIM_MS_TO_CYCLES(max_ms));
+    if (!quiet) {
+#if defined(LOG_TOKENIZED)
+        if (!LogTok_LoadElf(&uart_dec, "/proc/self/exe")) {
+            fprintf(stderr, "no log_fmt section in /proc/self/exe\n");
+            return 1;
+        }
+#endif
+        Sim_SetUartSink(UartSink);
+    }
+
+    Firmware_Main();
+    Host_Finish();
+    return 0;
+}
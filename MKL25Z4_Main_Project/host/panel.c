@@ -0,0 +1,242 @@
+/*
+ * panel.c
+ * ST7735 virtual
+ *
+ * Doar comenzile care schimba continutul sunt interpretate (CASET, RASET,
+ * RAMWR, SWRESET, MADCTL); restul secventei de init e acceptat si ignorat.
+ * Coordonatele sunt cele ale driverului (MADCTL 0xA8 = landscape, MV=1),
+ * deci framebuffer-ul e deja in orientarea ecranului.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "panel.h"
+
+#define CMD_SWRESET     0x01
+#define CMD_CASET       0x2A
+#define CMD_RASET       0x2B
+#define CMD_RAMWR       0x2C
+#define CMD_MADCTL      0x36
+
+static uint16_t framebuffer[PANEL_HEIGHT][PANEL_WIDTH];
+static Panel_Stats_t stats;
+
+static bool cs_level = true;
+static uint8_t cmd = 0;
+static uint8_t arg_index = 0;
+static uint8_t args[4];
+
+static uint16_t col_start = 0, col_end = PANEL_WIDTH - 1;
+static uint16_t row_start = 0, row_end = PANEL_HEIGHT - 1;
+static uint16_t cur_col = 0, cur_row = 0;
+static uint8_t pixel_hi = 0;
+static bool have_hi = false;
+
+static void ResetState(void) {
+    cmd = 0;
+    arg_index = 0;
+    have_hi = false;
+    col_start = 0; col_end = PANEL_WIDTH - 1;
+    row_start = 0; row_end = PANEL_HEIGHT - 1;
+}
+
+void Panel_Pins(bool cs, bool dc, bool rst) {
+    (void)dc;
+    if (!rst) {
+        ResetState();
+    }
+    if (cs_level && !cs) {
+        stats.cs_toggles++;
+    }
+    cs_level = cs;
+}
+
+static void PutPixel(uint16_t color) {
+    if (cur_col < PANEL_WIDTH && cur_row < PANEL_HEIGHT) {
+        framebuffer[cur_row][cur_col] = color;
+    }
+    stats.pixels++;
+
+    /* Fereastra se parcurge pe randuri, apoi se reia de la inceput */
+    if (++cur_col > col_end) {
+        cur_col = col_start;
+        if (++cur_row > row_end) {
+            cur_row = row_start;
+        }
+    }
+}
+
+void Panel_Write(uint8_t byte, bool dc) {
+    stats.bytes++;
+
+    if (!dc) {
+        cmd = byte;
+        arg_index = 0;
+        have_hi = false;
+        if (cmd == CMD_CASET) stats.windows++;
+        if (cmd == CMD_RAMWR) {
+            cur_col = col_start;
+            cur_row = row_start;
+        }
+        if (cmd == CMD_SWRESET) ResetState();
+        return;
+    }
+
+    switch (cmd) {
+        case CMD_CASET:
+        case CMD_RASET:
+            if (arg_index < 4) args[arg_index] = byte;
+            if (++arg_index == 4) {
+                uint16_t start = ((uint16_t)args[0] << 8) | args[1];
+                uint16_t end = ((uint16_t)args[2] << 8) | args[3];
+                if (cmd == CMD_CASET) {
+                    col_start = start; col_end = end;
+                } else {
+                    row_start = start; row_end = end;
+                }
+            }
+            break;
+
+        case CMD_RAMWR:
+            if (!have_hi) {
+                pixel_hi = byte;
+                have_hi = true;
+            } else {
+                PutPixel(((uint16_t)pixel_hi << 8) | byte);
+                have_hi = false;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+const uint16_t* Panel_Framebuffer(void) {
+    return &framebuffer[0][0];
+}
+
+uint16_t Panel_GetPixel(int16_t x, int16_t y) {
+    if (x < 0 || x >= PANEL_WIDTH || y < 0 || y >= PANEL_HEIGHT) return 0;
+    return framebuffer[y][x];
+}
+
+bool Panel_WritePPM(const char *path) {
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        perror(path);
+        return false;
+    }
+
+    fprintf(f, "P6\n%d %d\n255\n", PANEL_WIDTH, PANEL_HEIGHT);
+    for (int y = 0; y < PANEL_HEIGHT; y++) {
+        uint8_t row[PANEL_WIDTH * 3];
+        for (int x = 0; x < PANEL_WIDTH; x++) {
+            uint16_t c = framebuffer[y][x];
+            uint8_t r = (c >> 11) & 0x1F, g = (c >> 5) & 0x3F, b = c & 0x1F;
+            row[x * 3]     = (r << 3) | (r >> 2);
+            row[x * 3 + 1] = (g << 2) | (g >> 4);
+            row[x * 3 + 2] = (b << 3) | (b >> 2);
+        }
+        fwrite(row, 1, sizeof(row), f);
+    }
+
+    fclose(f);
+    return true;
+}
+
+/*============================================================================
+ * PNG (necomprimat: un singur bloc deflate "stored", fara zlib)
+ *============================================================================*/
+
+static uint32_t Crc32(uint32_t crc, const uint8_t *data, size_t len) {
+    crc = ~crc;
+    while (len--) {
+        crc ^= *data++;
+        for (int k = 0; k < 8; k++) {
+            crc = (crc >> 1) ^ (0xEDB88320U & -(crc & 1U));
+        }
+    }
+    return ~crc;
+}
+
+static void PutBE32(uint8_t *p, uint32_t v) {
+    p[0] = v >> 24; p[1] = v >> 16; p[2] = v >> 8; p[3] = v;
+}
+
+static void WriteChunk(FILE *f, const char *type, const uint8_t *data, uint32_t len) {
+    uint8_t hdr[8];
+    PutBE32(hdr, len);
+    memcpy(hdr + 4, type, 4);
+    fwrite(hdr, 1, 8, f);
+    if (len) fwrite(data, 1, len, f);
+
+    uint8_t crc[4];
+    PutBE32(crc, Crc32(Crc32(0, (const uint8_t *)type, 4), data, len));
+    fwrite(crc, 1, 4, f);
+}
+
+bool Panel_WritePNG(const char *path) {
+    enum { ROW = 1 + PANEL_WIDTH * 3, RAW = ROW * PANEL_HEIGHT };
+    static uint8_t idat[2 + 5 + RAW + 4];
+
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        perror(path);
+        return false;
+    }
+
+    static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    fwrite(signature, 1, 8, f);
+
+    uint8_t ihdr[13] = { 0 };
+    PutBE32(ihdr, PANEL_WIDTH);
+    PutBE32(ihdr + 4, PANEL_HEIGHT);
+    ihdr[8] = 8;        /* 8 biti per canal */
+    ihdr[9] = 2;        /* RGB */
+    WriteChunk(f, "IHDR", ihdr, sizeof(ihdr));
+
+    /* zlib: CMF/FLG, bloc final stored (LEN/NLEN little-endian), Adler-32 */
+    uint8_t *p = idat;
+    *p++ = 0x78; *p++ = 0x01;
+    *p++ = 0x01;
+    *p++ = RAW & 0xFF; *p++ = RAW >> 8;
+    *p++ = ~RAW & 0xFF; *p++ = (~RAW >> 8) & 0xFF;
+
+    uint32_t a = 1, b = 0;
+    for (int y = 0; y < PANEL_HEIGHT; y++) {
+        uint8_t *row = p;
+        *p++ = 0;       /* Filtru: None */
+        for (int x = 0; x < PANEL_WIDTH; x++) {
+            uint16_t c = framebuffer[y][x];
+            uint8_t r = (c >> 11) & 0x1F, g = (c >> 5) & 0x3F, bl = c & 0x1F;
+            *p++ = (r << 3) | (r >> 2);
+            *p++ = (g << 2) | (g >> 4);
+            *p++ = (bl << 3) | (bl >> 2);
+        }
+        for (uint8_t *q = row; q < p; q++) {
+            a = (a + *q) % 65521U;
+            b = (b + a) % 65521U;
+        }
+    }
+    PutBE32(p, (b << 16) | a);
+    p += 4;
+
+    WriteChunk(f, "IDAT", idat, (uint32_t)(p - idat));
+    WriteChunk(f, "IEND", NULL, 0);
+
+    fclose(f);
+    return true;
+}
+
+bool Panel_WriteImage(const char *path) {
+    size_t len = strlen(path);
+    if (len > 4 && strcmp(path + len - 4, ".png") == 0) {
+        return Panel_WritePNG(path);
+    }
+    return Panel_WritePPM(path);
+}
+
+const Panel_Stats_t* Panel_GetStats(void) {
+    return &stats;
+}
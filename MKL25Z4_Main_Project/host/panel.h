@@ -0,0 +1,67 @@
+/*
+ * panel.h
+ * ST7735 virtual: decodeaza fluxul SPI (CASET/RASET/RAMWR) intr-un
+ * framebuffer 160x128 RGB565 si numara traficul vazut pe fir
+ */
+
+#ifndef PANEL_H
+#define PANEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define PANEL_WIDTH     160
+#define PANEL_HEIGHT    128
+
+/* Trafic vazut de panou (independent de ST7735_STATS din firmware) */
+typedef struct {
+    uint64_t bytes;         /* Octeti primiti cu CS activ */
+    uint64_t windows;       /* Comenzi CASET */
+    uint64_t cs_toggles;    /* Fronturi descrescatoare pe CS */
+    uint64_t pixels;        /* Pixeli scrisi prin RAMWR */
+} Panel_Stats_t;
+
+/**
+ * Starea pinilor de control (apelat la orice schimbare pe PTC)
+ */
+void Panel_Pins(bool cs, bool dc, bool rst);
+
+/**
+ * Un octet shiftat pe MOSI cu CS activ
+ * @param dc 0 = comanda, 1 = date
+ */
+void Panel_Write(uint8_t byte, bool dc);
+
+/**
+ * Framebuffer-ul curent, rand cu rand (RGB565)
+ */
+const uint16_t* Panel_Framebuffer(void);
+
+/**
+ * Culoarea unui pixel (pentru verificari din harness)
+ */
+uint16_t Panel_GetPixel(int16_t x, int16_t y);
+
+/**
+ * Scrie framebuffer-ul ca PPM binar (P6)
+ * @return true daca fisierul a fost scris
+ */
+bool Panel_WritePPM(const char *path);
+
+/**
+ * Scrie framebuffer-ul ca PNG RGB necomprimat
+ * @return true daca fisierul a fost scris
+ */
+bool Panel_WritePNG(const char *path);
+
+/**
+ * PNG daca path se termina in ".png", altfel PPM
+ */
+bool Panel_WriteImage(const char *path);
+
+/**
+ * Statistici cumulate de la pornire
+ */
+const Panel_Stats_t* Panel_GetStats(void);
+
+#endif /* PANEL_H */
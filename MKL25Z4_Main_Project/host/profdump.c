@@ -0,0 +1,147 @@
+/*
+ * profdump.c
+ * Liniile [PROF] din profdump.h adunate in histograme
+ *
+ *   [PROF] H seq core_khz shift<<8|sub_bits ignorate
+ *   [PROF] P faza count min max
+ *   [PROF] S faza suma_lo suma_hi
+ *   [PROF] B faza cos<<16|n cos<<16|n cos<<16|n   (hex, 0 = nefolosit)
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "profdump.h"
+
+/* Ordinea din ProfPhase_t */
+static const char *phase_names[PROF_PHASES] = {
+    [PROF_INPUT]   = "input",
+    [PROF_AI]      = "ai",
+    [PROF_PHYSICS] = "physics",
+    [PROF_RENDER]  = "render",
+    [PROF_SPI]     = "spi",
+    [PROF_LAT_BUTTON]   = "lat_btn",
+    [PROF_LAT_IR]       = "lat_ir",
+    [PROF_LAT_JOYSTICK] = "lat_joy",
+};
+
+void ProfDump_Init(ProfDump_t *d) {
+    memset(d, 0, sizeof(*d));
+    d->core_khz = 48000U;
+    d->shift = PROF_SHIFT;
+    d->sub_bits = PROF_SUB_BITS;
+}
+
+bool ProfDump_Line(ProfDump_t *d, const char *line) {
+    const char *p = strstr(line, "[PROF] ");
+    if (!p) return false;
+    p += 7;
+
+    unsigned a, b, c, e;
+    switch (*p) {
+        case 'H':
+            if (sscanf(p + 1, "%u %u %u %u", &a, &b, &c, &e) != 4 || b == 0) break;
+            d->dumps++;
+            d->seq = a;
+            d->core_khz = b;
+            d->shift = (uint8_t)(c >> 8);
+            d->sub_bits = (uint8_t)(c & 0xFFU);
+            d->skipped += e;
+            return true;
+
+        case 'P':
+            if (sscanf(p + 1, "%u %u %u %u", &a, &b, &c, &e) != 4 || a >= PROF_PHASES) break;
+            if (b) {
+                ProfDumpPhase_t *ph = &d->phase[a];
+                if (ph->count == 0 || c < ph->min) ph->min = c;
+                if (e > ph->max) ph->max = e;
+                ph->count += b;
+            }
+            return true;
+
+        case 'S':
+            if (sscanf(p + 1, "%u %u %u", &a, &b, &c) != 3 || a >= PROF_PHASES) break;
+            d->phase[a].sum += ((uint64_t)c << 32) | b;
+            return true;
+
+        case 'B': {
+            unsigned packed[3];
+            if (sscanf(p + 1, "%u %x %x %x", &a, &packed[0], &packed[1], &packed[2]) != 4 ||
+                a >= PROF_PHASES) {
+                break;
+            }
+            for (uint8_t i = 0; i < 3; i++) {
+                unsigned bucket = packed[i] >> 16;
+                if ((packed[i] & 0xFFFFU) == 0) continue;
+                if (bucket >= PROF_BUCKETS) {
+                    d->errors++;
+                    continue;
+                }
+                d->phase[a].buckets[bucket] += packed[i] & 0xFFFFU;
+            }
+            return true;
+        }
+
+        default:
+            break;
+    }
+    d->errors++;
+    return true;
+}
+
+const char *ProfDump_PhaseName(uint8_t phase) {
+    return (phase < PROF_PHASES) ? phase_names[phase] : "?";
+}
+
+uint32_t ProfDump_Average(const ProfDump_t *d, uint8_t phase) {
+    const ProfDumpPhase_t *ph = &d->phase[phase];
+    return ph->count ? (uint32_t)(ph->sum / ph->count) : 0;
+}
+
+/* Inversul lui Prof_Bucket din profiler.c */
+uint32_t ProfDump_BucketLow(const ProfDump_t *d, uint8_t bucket) {
+    uint32_t mask = (1U << d->sub_bits) - 1U;
+
+    if (bucket <= mask) return (uint32_t)bucket << d->shift;
+
+    uint32_t msb = (uint32_t)(bucket >> d->sub_bits) + d->sub_bits - 1U;
+    uint64_t v = (1ULL << msb) | ((uint64_t)(bucket & mask) << (msb - d->sub_bits));
+    v <<= d->shift;
+    return (v > UINT32_MAX) ? UINT32_MAX : (uint32_t)v;
+}
+
+uint32_t ProfDump_Percentile(const ProfDump_t *d, uint8_t phase, uint32_t permille) {
+    const ProfDumpPhase_t *ph = &d->phase[phase];
+    uint64_t total = 0;
+
+    /* Numarul din cosuri (saturate la 65535) poate fi sub count */
+    for (uint8_t b = 0; b < PROF_BUCKETS; b++) total += ph->buckets[b];
+    if (total == 0) return 0;
+
+    /* Rangul, numarat de la 1 */
+    uint64_t rank = (total * permille + 999U) / 1000U;
+    if (rank == 0) rank = 1;
+
+    uint64_t seen = 0;
+    for (uint8_t b = 0; b < PROF_BUCKETS; b++) {
+        if (ph->buckets[b] == 0) continue;
+        if (seen + ph->buckets[b] < rank) {
+            seen += ph->buckets[b];
+            continue;
+        }
+
+        uint64_t lo = ProfDump_BucketLow(d, b);
+        uint64_t hi = (b + 1U < PROF_BUCKETS) ? ProfDump_BucketLow(d, (uint8_t)(b + 1U)) : ph->max;
+        if (lo < ph->min) lo = ph->min;
+        if (hi > ph->max) hi = ph->max;
+        if (hi < lo) hi = lo;
+
+        /* Esantioanele presupuse uniforme in cos */
+        uint64_t v = lo + (hi - lo) * (rank - seen) / ph->buckets[b];
+        return (uint32_t)v;
+    }
+    return ph->max;
+}
+
+uint64_t ProfDump_CyclesToNs(const ProfDump_t *d, uint64_t cycles) {
+    return cycles * 1000000ULL / d->core_khz;
+}
@@ -0,0 +1,68 @@
+/*
+ * profdump.h
+ * Citirea dump-ului [PROF] din profiler.c (source/drivers/headers/profiler.h)
+ *
+ * Liniile vin din textul consolei (build text sau iesirea lui logdec);
+ * orice nu incepe cu "[PROF] " e ignorat. Histogramele dump-urilor
+ * succesive se aduna. Cosurile se refac din shift / sub_bits din antet,
+ * deci un dump de la un firmware cu alta configuratie se citeste la fel.
+ */
+
+#ifndef PROFDUMP_H
+#define PROFDUMP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../source/drivers/headers/profiler.h"
+
+typedef struct {
+    uint64_t count;
+    uint32_t min;               /* Cicluri */
+    uint32_t max;
+    uint64_t sum;               /* Din liniile S; media = sum / count */
+    uint64_t buckets[PROF_BUCKETS];
+} ProfDumpPhase_t;
+
+typedef struct {
+    uint32_t dumps;             /* Antete H vazute */
+    uint32_t seq;               /* Ultimul */
+    uint32_t core_khz;
+    uint8_t shift;
+    uint8_t sub_bits;
+    uint64_t skipped;           /* Esantioane din VLPR, neinregistrate */
+    uint32_t errors;            /* Linii [PROF] care nu se potrivesc */
+    ProfDumpPhase_t phase[PROF_PHASES];
+} ProfDump_t;
+
+void ProfDump_Init(ProfDump_t *d);
+
+/**
+ * O linie de text (cu sau fara \r\n)
+ * @return true daca linia era [PROF]
+ */
+bool ProfDump_Line(ProfDump_t *d, const char *line);
+
+const char *ProfDump_PhaseName(uint8_t phase);
+
+/**
+ * Media fazei in cicluri (0 fara esantioane)
+ */
+uint32_t ProfDump_Average(const ProfDump_t *d, uint8_t phase);
+
+/**
+ * Limita de jos a unui cos, in cicluri, pentru configuratia din antet
+ */
+uint32_t ProfDump_BucketLow(const ProfDump_t *d, uint8_t bucket);
+
+/**
+ * Percentila (permille: 500 = mediana, 999 = p99.9), in cicluri,
+ * interpolata liniar in cosul ei si limitata la [min, max]
+ */
+uint32_t ProfDump_Percentile(const ProfDump_t *d, uint8_t phase, uint32_t permille);
+
+/**
+ * Cicluri -> nanosecunde la frecventa din antet
+ */
+uint64_t ProfDump_CyclesToNs(const ProfDump_t *d, uint64_t cycles);
+
+#endif /* PROFDUMP_H */
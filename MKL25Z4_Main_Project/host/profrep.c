@@ -0,0 +1,106 @@
+/*
+ * profrep.c
+ * Tabele de percentile din dump-ul [PROF] al unui build cu -DPROFILER
+ *
+ * Intrarea e textul consolei, dintr-un fisier sau de la stdin, ex:
+ *   stty -F /dev/ttyACM0 115200 raw && ./profrep < /dev/ttyACM0
+ *   ./logdec firmware.axf < /dev/ttyACM0 | ./profrep     (cu -DLOG_TOKENIZED)
+ *   ./pong_host -t traces/demo.trace 2>&1 | ./profrep    (build host -DPROFILER)
+ *
+ * Utilizare:
+ *   ./profrep [captura.txt]    - tabelul cumulat, la fiecare dump si la final
+ *   ./profrep -d [captura.txt] - fiecare dump separat (intervalul lui)
+ *
+ * Timpii sunt in microsecunde; percentilele sunt interpolate in cosuri
+ * (eroare sub ~19% fata de durata reala), min, medie si max sunt exacte.
+ * Randurile lat_* sunt latenta input -> ecran per sursa.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "profdump.h"
+
+static const uint32_t percentiles[] = { 500, 900, 990, 999 };
+#define NUM_PERCENTILES     (sizeof(percentiles) / sizeof(percentiles[0]))
+
+static void PrintUs(const ProfDump_t *d, uint64_t cycles) {
+    uint64_t ns = ProfDump_CyclesToNs(d, cycles);
+    printf(" %9llu.%02llu", (unsigned long long)(ns / 1000U), (unsigned long long)(ns % 1000U / 10U));
+}
+
+static void PrintTable(const ProfDump_t *d) {
+    printf("dump %u (%u seen), %u kHz core, %llu samples skipped in VLPR\n",
+           (unsigned)d->seq, (unsigned)d->dumps, (unsigned)d->core_khz,
+           (unsigned long long)d->skipped);
+    printf("%-8s %10s %12s %12s %12s %12s %12s %12s %12s\n", "phase", "count",
+           "min us", "avg us", "p50 us", "p90 us", "p99 us", "p99.9 us", "max us");
+
+    for (uint8_t i = 0; i < PROF_PHASES; i++) {
+        const ProfDumpPhase_t *ph = &d->phase[i];
+        printf("%-8s %10llu", ProfDump_PhaseName(i), (unsigned long long)ph->count);
+        if (!ph->count) {
+            printf("\n");
+            continue;
+        }
+        PrintUs(d, ph->min);
+        PrintUs(d, ProfDump_Average(d, i));
+        for (uint8_t p = 0; p < NUM_PERCENTILES; p++) {
+            PrintUs(d, ProfDump_Percentile(d, i, percentiles[p]));
+        }
+        PrintUs(d, ph->max);
+        printf("\n");
+    }
+    printf("\n");
+    fflush(stdout);
+}
+
+int main(int argc, char **argv) {
+    bool each = false;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "d")) != -1) {
+        switch (opt) {
+            case 'd': each = true; break;
+            default:
+                fprintf(stderr, "usage: %s [-d] [capture]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    FILE *in = stdin;
+    if (optind < argc) {
+        in = fopen(argv[optind], "r");
+        if (!in) {
+            perror(argv[optind]);
+            return 1;
+        }
+    }
+
+    static ProfDump_t dump;
+    char line[512];
+    ProfDump_Init(&dump);
+
+    while (fgets(line, sizeof(line), in)) {
+        /* Un antet nou inchide dump-ul anterior */
+        if (strstr(line, "[PROF] H ") && dump.dumps) {
+            PrintTable(&dump);
+            if (each) {
+                uint32_t dumps = dump.dumps;
+                ProfDump_Init(&dump);
+                dump.dumps = dumps;
+            }
+        }
+        ProfDump_Line(&dump, line);
+    }
+    if (in != stdin) fclose(in);
+
+    if (!dump.dumps) {
+        fprintf(stderr, "profrep: no [PROF] dump in the input (not built with -DPROFILER?)\n");
+        return 1;
+    }
+    PrintTable(&dump);
+    if (dump.errors) fprintf(stderr, "profrep: %u malformed [PROF] lines\n", (unsigned)dump.errors);
+    return dump.errors ? 1 : 0;
+}
@@ -0,0 +1,26 @@
+/*
+ * rtos_glue.c
+ * Legatura dintre port-ul FreeRTOS POSIX si simulator (doar `make rtos`)
+ *
+ * Task-urile sunt thread-uri Linux, dar port-ul lasa sa ruleze unul
+ * singur odata, deci simulatorul (single-threaded) ramane consistent.
+ * Kernel-ul numara tick-uri in timp real; timpul simulat e tras dupa el
+ * din idle hook: cand toate task-urile asteapta, ceasul virtual sare la
+ * tick-ul curent (si ISR-urile simulate de pana atunci se executa).
+ */
+
+#include "sim.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+uint32_t Host_RtosNowUs(void) {
+    return (uint32_t)(sim_cycles / SIM_US_TO_CYCLES(1));
+}
+
+void vApplicationIdleHook(void) {
+    uint64_t target = SIM_MS_TO_CYCLES((uint64_t)xTaskGetTickCount());
+
+    if (sim_cycles < target) {
+        Sim_Advance(target - sim_cycles);
+    }
+}
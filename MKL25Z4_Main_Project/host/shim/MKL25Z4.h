@@ -0,0 +1,511 @@
+/*
+ * MKL25Z4.h (host shim)
+ * Inlocuieste header-ul de device pentru build-ul host
+ *
+ * Pastreaza numele de registre, mastile si IRQn-urile folosite de firmware.
+ * Instantele (SPI0, GPIOC, TPM1...) sunt structuri din sim.c, accesate prin
+ * Sim_Touch ca simulatorul sa vada fiecare scriere in ordine.
+ *
+ * Registrele care pe hardware au 8 biti si sunt scrise ca "comanda"
+ * (SPI D, GPIO PSOR/PCOR/PTOR) sunt mai late aici ca sa poata tine o
+ * valoare santinela intre doua accese.
+ */
+
+#ifndef HOST_MKL25Z4_H
+#define HOST_MKL25Z4_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../sim.h"
+
+#define __IO    volatile
+#define __I     volatile const
+#define __O     volatile
+
+/*============================================================================
+ * INTERRUPTS
+ *============================================================================*/
+
+typedef enum IRQn {
+    NonMaskableInt_IRQn  = -14,
+    HardFault_IRQn       = -13,
+    SVCall_IRQn          = -5,
+    PendSV_IRQn          = -2,
+    SysTick_IRQn         = -1,
+    DMA0_IRQn            = 0,
+    DMA1_IRQn            = 1,
+    DMA2_IRQn            = 2,
+    DMA3_IRQn            = 3,
+    FTFA_IRQn            = 5,
+    LVD_LVW_IRQn         = 6,
+    LLWU_IRQn            = 7,
+    I2C0_IRQn            = 8,
+    I2C1_IRQn            = 9,
+    SPI0_IRQn            = 10,
+    SPI1_IRQn            = 11,
+    UART0_IRQn           = 12,
+    UART1_IRQn           = 13,
+    UART2_IRQn           = 14,
+    ADC0_IRQn            = 15,
+    CMP0_IRQn            = 16,
+    TPM0_IRQn            = 17,
+    TPM1_IRQn            = 18,
+    TPM2_IRQn            = 19,
+    RTC_IRQn             = 20,
+    RTC_Seconds_IRQn     = 21,
+    PIT_IRQn             = 22,
+    USB0_IRQn            = 24,
+    DAC0_IRQn            = 25,
+    TSI0_IRQn            = 26,
+    MCG_IRQn             = 27,
+    LPTMR0_IRQn          = 28,
+    PORTA_IRQn           = 30,
+    PORTD_IRQn           = 31
+} IRQn_Type;
+
+#define SIM_NUM_IRQS    32
+
+/*============================================================================
+ * CMSIS CORE
+ *============================================================================*/
+
+extern uint32_t SystemCoreClock;
+
+#define __NOP()             Sim_Idle()
+#define __WFI()             Sim_Wfi()
+#define __DMB()             __asm__ volatile("" ::: "memory")
+#define __DSB()             __asm__ volatile("" ::: "memory")
+#define __ISB()             __asm__ volatile("" ::: "memory")
+#define __disable_irq()     Sim_IrqMaskAll(true)
+#define __enable_irq()      Sim_IrqMaskAll(false)
+
+static inline void NVIC_EnableIRQ(IRQn_Type irq)  { Sim_IrqEnable(irq, true); }
+static inline void NVIC_DisableIRQ(IRQn_Type irq) { Sim_IrqEnable(irq, false); }
+static inline void NVIC_SetPriority(IRQn_Type irq, uint32_t prio) { (void)irq; (void)prio; }
+
+/* VAL numara in jos de la LOAD; sim.c il actualizeaza la fiecare acces.
+ * O scriere in VAL il sterge (reincarcare din LOAD), ca pe Cortex-M0+ */
+typedef struct {
+    __IO uint32_t CTRL;
+    __IO uint32_t LOAD;
+    __IO uint32_t VAL;
+    __I  uint32_t CALIB;
+} SysTick_Type;
+
+extern SysTick_Type sim_systick;
+#define SysTick ((SysTick_Type *)Sim_Touch(&sim_systick))
+
+/* SCB: SCR (SLEEPDEEP alege intre WAIT si STOP la __WFI) si ICSR, din
+ * care doar PENDSTSET (SysTick in asteptare) e actualizat de sim.c */
+typedef struct {
+    __IO uint32_t ICSR;
+    __IO uint32_t SCR;
+} SCB_Type;
+
+#define SCB_ICSR_PENDSTSET_Msk  (1UL << 26)
+#define SCB_SCR_SLEEPDEEP_Msk   (0x4U)
+
+extern SCB_Type sim_scb;
+#define SCB     ((SCB_Type *)Sim_Touch(&sim_scb))
+
+static inline uint32_t SysTick_Config(uint32_t ticks) {
+    sim_systick.LOAD = ticks - 1U;
+    sim_systick.CTRL = 0x7U;
+    Sim_SysTickConfig(ticks);
+    return 0;
+}
+
+/*============================================================================
+ * SPI
+ *============================================================================*/
+
+typedef struct {
+    __IO uint8_t C1;
+    __IO uint8_t C2;
+    __IO uint8_t BR;
+    __IO uint8_t S;
+    __IO uint16_t D;            /* 0x100 = gol (santinela host) */
+    __IO uint8_t M;
+} SPI_Type;
+
+#define SPI_C1_SPE_MASK         (0x40U)
+#define SPI_C1_MSTR_MASK        (0x10U)
+#define SPI_C2_RXDMAE_MASK      (0x4U)
+#define SPI_C2_TXDMAE_MASK      (0x20U)
+#define SPI_BR_SPR_MASK         (0xFU)
+#define SPI_BR_SPR(x)           ((uint8_t)(x) & SPI_BR_SPR_MASK)
+#define SPI_BR_SPPR_SHIFT       (4U)
+#define SPI_BR_SPPR(x)          (((uint8_t)(x) << SPI_BR_SPPR_SHIFT) & 0x70U)
+#define SPI_S_SPTEF_MASK        (0x20U)
+#define SPI_S_SPRF_MASK         (0x80U)
+
+extern SPI_Type sim_spi0;
+#define SPI0    ((SPI_Type *)Sim_Touch(&sim_spi0))
+
+/*============================================================================
+ * GPIO / PORT
+ *============================================================================*/
+
+typedef struct {
+    __IO uint32_t PDOR;
+    __O  uint32_t PSOR;
+    __O  uint32_t PCOR;
+    __O  uint32_t PTOR;
+    __I  uint32_t PDIR;
+    __IO uint32_t PDDR;
+} GPIO_Type;
+
+typedef struct {
+    __IO uint32_t PCR[32];
+    __O  uint32_t GPCLR;
+    __O  uint32_t GPCHR;
+    __IO uint32_t ISFR;
+} PORT_Type;
+
+#define PORT_PCR_PS_MASK        (0x1U)
+#define PORT_PCR_PE_MASK        (0x2U)
+#define PORT_PCR_PFE_MASK       (0x10U)
+#define PORT_PCR_MUX_MASK       (0x700U)
+#define PORT_PCR_MUX_SHIFT      (8U)
+#define PORT_PCR_MUX(x)         (((uint32_t)(x) << PORT_PCR_MUX_SHIFT) & PORT_PCR_MUX_MASK)
+#define PORT_PCR_IRQC_MASK      (0xF0000U)
+#define PORT_PCR_IRQC_SHIFT     (16U)
+#define PORT_PCR_IRQC(x)        (((uint32_t)(x) << PORT_PCR_IRQC_SHIFT) & PORT_PCR_IRQC_MASK)
+#define PORT_PCR_ISF_MASK       (0x1000000U)
+
+extern GPIO_Type sim_gpio[5];
+extern PORT_Type sim_port[5];
+
+#define GPIOA   ((GPIO_Type *)Sim_Touch(&sim_gpio[0]))
+#define GPIOB   ((GPIO_Type *)Sim_Touch(&sim_gpio[1]))
+#define GPIOC   ((GPIO_Type *)Sim_Touch(&sim_gpio[2]))
+#define GPIOD   ((GPIO_Type *)Sim_Touch(&sim_gpio[3]))
+#define GPIOE   ((GPIO_Type *)Sim_Touch(&sim_gpio[4]))
+#define PORTA   ((PORT_Type *)Sim_Touch(&sim_port[0]))
+#define PORTB   ((PORT_Type *)Sim_Touch(&sim_port[1]))
+#define PORTC   ((PORT_Type *)Sim_Touch(&sim_port[2]))
+#define PORTD   ((PORT_Type *)Sim_Touch(&sim_port[3]))
+#define PORTE   ((PORT_Type *)Sim_Touch(&sim_port[4]))
+
+/*============================================================================
+ * DMA / DMAMUX
+ *============================================================================*/
+
+typedef struct {
+    struct {
+        __IO uint32_t SAR;
+        __IO uint32_t DAR;
+        __IO uint32_t DSR_BCR;
+        __IO uint32_t DCR;
+    } DMA[4];
+} DMA_Type;
+
+typedef struct {
+    __IO uint8_t CHCFG[4];
+} DMAMUX_Type;
+
+#define DMA_DSR_BCR_BCR_MASK    (0xFFFFFFU)
+#define DMA_DSR_BCR_BCR(x)      ((uint32_t)(x) & DMA_DSR_BCR_BCR_MASK)
+#define DMA_DSR_BCR_DONE_MASK   (0x1000000U)
+#define DMA_DSR_BCR_BSY_MASK    (0x2000000U)
+#define DMA_DCR_EINT_MASK       (0x80000000U)
+#define DMA_DCR_ERQ_MASK        (0x40000000U)
+#define DMA_DCR_CS_MASK         (0x20000000U)
+#define DMA_DCR_AA_MASK         (0x10000000U)
+#define DMA_DCR_EADREQ_MASK     (0x800000U)
+#define DMA_DCR_SINC_MASK       (0x400000U)
+#define DMA_DCR_SSIZE_SHIFT     (20U)
+#define DMA_DCR_SSIZE(x)        (((uint32_t)(x) << DMA_DCR_SSIZE_SHIFT) & 0x300000U)
+#define DMA_DCR_DINC_MASK       (0x80000U)
+#define DMA_DCR_DSIZE_SHIFT     (17U)
+#define DMA_DCR_DSIZE(x)        (((uint32_t)(x) << DMA_DCR_DSIZE_SHIFT) & 0x60000U)
+#define DMA_DCR_START_MASK      (0x10000U)
+#define DMA_DCR_SMOD_SHIFT      (12U)
+#define DMA_DCR_SMOD(x)         (((uint32_t)(x) << DMA_DCR_SMOD_SHIFT) & 0xF000U)
+#define DMA_DCR_DMOD_SHIFT      (8U)
+#define DMA_DCR_DMOD(x)         (((uint32_t)(x) << DMA_DCR_DMOD_SHIFT) & 0xF00U)
+#define DMA_DCR_D_REQ_MASK      (0x80U)
+
+#define DMAMUX_CHCFG_SOURCE(x)  ((uint8_t)(x) & 0x3FU)
+#define DMAMUX_CHCFG_TRIG_MASK  (0x40U)
+#define DMAMUX_CHCFG_ENBL_MASK  (0x80U)
+
+typedef enum _dma_request_source {
+    kDmaRequestMux0Disable  = 0 | 0x100U,
+    kDmaRequestMux0SPI0Rx   = 16 | 0x100U,
+    kDmaRequestMux0SPI0Tx   = 17 | 0x100U,
+    kDmaRequestMux0TPM0Overflow = 54 | 0x100U,
+    kDmaRequestMux0TPM1Overflow = 55 | 0x100U,
+    kDmaRequestMux0TPM2Overflow = 56 | 0x100U,
+} dma_request_source_t;
+
+extern DMA_Type sim_dma0;
+extern DMAMUX_Type sim_dmamux0;
+#define DMA0        ((DMA_Type *)Sim_Touch(&sim_dma0))
+#define DMAMUX0     ((DMAMUX_Type *)Sim_Touch(&sim_dmamux0))
+
+/*============================================================================
+ * TPM
+ *============================================================================*/
+
+typedef struct {
+    __IO uint32_t SC;
+    __IO uint32_t CNT;
+    __IO uint32_t MOD;
+    struct {
+        __IO uint32_t CnSC;
+        __IO uint32_t CnV;
+    } CONTROLS[6];
+    __IO uint32_t STATUS;
+    __IO uint32_t CONF;
+} TPM_Type;
+
+#define TPM_SC_PS_MASK          (0x7U)
+#define TPM_SC_PS(x)            ((uint32_t)(x) & TPM_SC_PS_MASK)
+#define TPM_SC_CMOD_SHIFT       (3U)
+#define TPM_SC_CMOD_MASK        (0x18U)
+#define TPM_SC_CMOD(x)          (((uint32_t)(x) << TPM_SC_CMOD_SHIFT) & TPM_SC_CMOD_MASK)
+#define TPM_SC_TOIE_MASK        (0x40U)
+#define TPM_SC_TOF_MASK         (0x80U)
+#define TPM_SC_DMA_MASK         (0x100U)
+#define TPM_CnSC_ELSA_MASK      (0x4U)
+#define TPM_CnSC_ELSB_MASK      (0x8U)
+#define TPM_CnSC_MSA_MASK       (0x10U)
+#define TPM_CnSC_MSB_MASK       (0x20U)
+#define TPM_CnSC_CHIE_MASK      (0x40U)
+#define TPM_CnSC_CHF_MASK       (0x80U)
+#define TPM_STATUS_CH0F_MASK    (0x1U)
+#define TPM_STATUS_TOF_MASK     (0x100U)
+
+/* STATUS e write-1-to-clear: simulatorul il rescrie la fiecare acces cu
+ * o stampila in bitii 30/31, ca sa recunoasca orice scriere a firmware-ului */
+#define SIM_TPM_STATUS_STAMP    (0xC0000000U)
+
+extern TPM_Type sim_tpm[3];
+#define TPM0    ((TPM_Type *)Sim_Touch(&sim_tpm[0]))
+#define TPM1    ((TPM_Type *)Sim_Touch(&sim_tpm[1]))
+#define TPM2    ((TPM_Type *)Sim_Touch(&sim_tpm[2]))
+
+/*============================================================================
+ * PIT
+ *============================================================================*/
+
+typedef struct {
+    __IO uint32_t MCR;
+    struct {
+        __IO uint32_t LDVAL;
+        __I  uint32_t CVAL;
+        __IO uint32_t TCTRL;
+        __IO uint32_t TFLG;
+    } CHANNEL[2];
+} PIT_Type;
+
+#define PIT_MCR_MDIS_MASK       (0x2U)
+#define PIT_TCTRL_TEN_MASK      (0x1U)
+#define PIT_TCTRL_TIE_MASK      (0x2U)
+#define PIT_TFLG_TIF_MASK       (0x1U)
+
+extern PIT_Type sim_pit;
+#define PIT     ((PIT_Type *)Sim_Touch(&sim_pit))
+
+/*============================================================================
+ * ADC
+ *============================================================================*/
+
+typedef struct {
+    __IO uint32_t SC1[2];
+    __IO uint32_t CFG1;
+    __IO uint32_t CFG2;
+    __I  uint32_t R[2];
+    __IO uint32_t SC2;
+    __IO uint32_t SC3;
+} ADC_Type;
+
+#define ADC_SC1_ADCH_MASK       (0x1FU)
+#define ADC_SC1_ADCH(x)         ((uint32_t)(x) & ADC_SC1_ADCH_MASK)
+#define ADC_SC1_AIEN_MASK       (0x40U)
+#define ADC_SC1_COCO_MASK       (0x80U)
+#define ADC_CFG1_ADICLK_MASK    (0x3U)
+#define ADC_CFG1_ADICLK(x)      ((uint32_t)(x) & ADC_CFG1_ADICLK_MASK)
+#define ADC_CFG1_MODE_MASK      (0xCU)
+#define ADC_CFG1_MODE_SHIFT     (2U)
+#define ADC_CFG1_MODE(x)        (((uint32_t)(x) << ADC_CFG1_MODE_SHIFT) & ADC_CFG1_MODE_MASK)
+#define ADC_CFG1_ADLSMP_MASK    (0x10U)
+#define ADC_CFG1_ADIV_MASK      (0x60U)
+#define ADC_CFG1_ADIV_SHIFT     (5U)
+#define ADC_CFG1_ADIV(x)        (((uint32_t)(x) << ADC_CFG1_ADIV_SHIFT) & ADC_CFG1_ADIV_MASK)
+#define ADC_CFG1_ADLPC_MASK     (0x80U)
+#define ADC_CFG2_ADHSC_MASK     (0x4U)
+#define ADC_CFG2_ADACKEN_MASK   (0x8U)
+#define ADC_SC2_ADTRG_MASK      (0x40U)
+#define ADC_SC2_ADACT_MASK      (0x80U)
+#define ADC_SC3_AVGS_MASK       (0x3U)
+#define ADC_SC3_AVGS(x)         ((uint32_t)(x) & ADC_SC3_AVGS_MASK)
+#define ADC_SC3_AVGE_MASK       (0x4U)
+#define ADC_SC3_ADCO_MASK       (0x8U)
+
+extern ADC_Type sim_adc0;
+#define ADC0    ((ADC_Type *)Sim_Touch(&sim_adc0))
+
+/*============================================================================
+ * DAC
+ *============================================================================*/
+
+typedef struct {
+    struct {
+        __IO uint8_t DATL;
+        __IO uint8_t DATH;
+    } DAT[2];
+    uint8_t RESERVED_0[28];
+    __IO uint8_t SR;
+    __IO uint8_t C0;
+    __IO uint8_t C1;
+    __IO uint8_t C2;
+} DAC_Type;
+
+#define DAC_C0_DACEN_MASK       (0x80U)
+#define DAC_C0_DACRFS_MASK      (0x40U)
+#define DAC_C0_DACTRGSEL_MASK   (0x20U)
+#define DAC_C1_DMAEN_MASK       (0x80U)
+
+extern DAC_Type sim_dac0;
+#define DAC0    ((DAC_Type *)Sim_Touch(&sim_dac0))
+
+/*============================================================================
+ * SIM (sursele de ceas, divizoarele si triggerul hardware pentru ADC0)
+ *============================================================================*/
+
+typedef struct {
+    __IO uint32_t SOPT2;
+    __IO uint32_t SOPT7;
+    __IO uint32_t CLKDIV1;
+} SIM_Type;
+
+#define SIM_SOPT2_PLLFLLSEL_MASK        (0x10000U)
+#define SIM_SOPT2_PLLFLLSEL_SHIFT       (16U)
+#define SIM_SOPT2_PLLFLLSEL(x)          (((uint32_t)(x) << SIM_SOPT2_PLLFLLSEL_SHIFT) & SIM_SOPT2_PLLFLLSEL_MASK)
+#define SIM_SOPT2_TPMSRC_MASK           (0x3000000U)
+#define SIM_SOPT2_TPMSRC_SHIFT          (24U)
+#define SIM_SOPT2_TPMSRC(x)             (((uint32_t)(x) << SIM_SOPT2_TPMSRC_SHIFT) & SIM_SOPT2_TPMSRC_MASK)
+#define SIM_SOPT2_UART0SRC_MASK         (0xC000000U)
+#define SIM_SOPT2_UART0SRC_SHIFT        (26U)
+#define SIM_SOPT2_UART0SRC(x)           (((uint32_t)(x) << SIM_SOPT2_UART0SRC_SHIFT) & SIM_SOPT2_UART0SRC_MASK)
+#define SIM_CLKDIV1_OUTDIV4_MASK        (0x70000U)
+#define SIM_CLKDIV1_OUTDIV4_SHIFT       (16U)
+#define SIM_CLKDIV1_OUTDIV1_MASK        (0xF0000000U)
+#define SIM_CLKDIV1_OUTDIV1_SHIFT       (28U)
+
+#define SIM_SOPT7_ADC0TRGSEL_MASK       (0xFU)
+#define SIM_SOPT7_ADC0TRGSEL(x)         ((uint32_t)(x) & SIM_SOPT7_ADC0TRGSEL_MASK)
+#define SIM_SOPT7_ADC0PRETRGSEL_MASK    (0x10U)
+#define SIM_SOPT7_ADC0ALTTRGEN_MASK     (0x80U)
+
+extern SIM_Type sim_sim;
+#define SIM     ((SIM_Type *)Sim_Touch(&sim_sim))
+
+/*============================================================================
+ * LPTMR (ceas LPO de 1 kHz; numara si in VLPS)
+ *============================================================================*/
+
+typedef struct {
+    __IO uint32_t CSR;
+    __IO uint32_t PSR;
+    __IO uint32_t CMR;
+    __IO uint32_t CNR;          /* O scriere "ingheata" valoarea pentru citire */
+} LPTMR_Type;
+
+#define LPTMR_CSR_TEN_MASK      (0x1U)
+#define LPTMR_CSR_TMS_MASK      (0x2U)
+#define LPTMR_CSR_TFC_MASK      (0x4U)
+#define LPTMR_CSR_TIE_MASK      (0x40U)
+#define LPTMR_CSR_TCF_MASK      (0x80U)
+#define LPTMR_PSR_PCS_MASK      (0x3U)
+#define LPTMR_PSR_PCS(x)        ((uint32_t)(x) & LPTMR_PSR_PCS_MASK)
+#define LPTMR_PSR_PBYP_MASK     (0x4U)
+#define LPTMR_PSR_PRESCALE_SHIFT (3U)
+#define LPTMR_PSR_PRESCALE_MASK (0x78U)
+#define LPTMR_PSR_PRESCALE(x)   (((uint32_t)(x) << LPTMR_PSR_PRESCALE_SHIFT) & LPTMR_PSR_PRESCALE_MASK)
+#define LPTMR_CMR_COMPARE(x)    ((uint32_t)(x) & 0xFFFFU)
+#define LPTMR_CNR_COUNTER_MASK  (0xFFFFU)
+
+extern LPTMR_Type sim_lptmr0;
+#define LPTMR0  ((LPTMR_Type *)Sim_Touch(&sim_lptmr0))
+
+/*============================================================================
+ * MCG - doar S: sim.c il scrie din modelul de ceas (CLOCK_SetMcgConfig si
+ * iesirea din VLPS)
+ *============================================================================*/
+
+typedef struct {
+    __I  uint8_t S;
+} MCG_Type;
+
+#define MCG_S_CLKST_MASK        (0xCU)
+#define MCG_S_CLKST_SHIFT       (2U)
+#define MCG_S_LOCK0_MASK        (0x40U)
+
+#define MCG_S_CLKST_IRC         (1U)        /* BLPI */
+#define MCG_S_CLKST_EXT         (2U)        /* PBE: cristalul direct */
+#define MCG_S_CLKST_PLL         (3U)        /* PEE */
+
+extern MCG_Type sim_mcg;
+#define MCG     ((MCG_Type *)Sim_Touch(&sim_mcg))
+
+/*============================================================================
+ * SMC (moduri de consum)
+ *============================================================================*/
+
+typedef struct {
+    __IO uint8_t PMPROT;
+    __IO uint8_t PMCTRL;
+    __IO uint8_t STOPCTRL;
+    __I  uint8_t PMSTAT;
+} SMC_Type;
+
+#define SMC_PMPROT_AVLP_MASK    (0x20U)
+#define SMC_PMCTRL_STOPM_MASK   (0x7U)
+#define SMC_PMCTRL_STOPM_SHIFT  (0U)
+#define SMC_PMCTRL_STOPA_MASK   (0x8U)
+#define SMC_PMCTRL_RUNM_MASK    (0x60U)
+#define SMC_PMCTRL_RUNM_SHIFT   (5U)
+#define SMC_PMCTRL_RUNM(x)      (((uint8_t)(x) << SMC_PMCTRL_RUNM_SHIFT) & SMC_PMCTRL_RUNM_MASK)
+#define SMC_PMSTAT_RUN          (0x01U)     /* PMSTAT e actualizat din PMCTRL[RUNM] */
+#define SMC_PMSTAT_VLPR         (0x04U)
+
+extern SMC_Type sim_smc;
+#define SMC     ((SMC_Type *)Sim_Touch(&sim_smc))
+
+/*============================================================================
+ * UART0 (LPSCI) - doar emisia: baud din BDH/BDL/C4 si UART0SRC, TDRE/TC
+ * urmeaza bufferul si registrul de deplasare (sim.c)
+ *============================================================================*/
+
+typedef struct {
+    __IO uint8_t BDH;
+    __IO uint8_t BDL;
+    __IO uint8_t C1;
+    __IO uint8_t C2;
+    __IO uint8_t S1;
+    __IO uint8_t S2;
+    __IO uint8_t C3;
+    __IO uint16_t D;            /* 0x100 = gol (santinela host) */
+    __IO uint8_t MA1;
+    __IO uint8_t MA2;
+    __IO uint8_t C4;
+    __IO uint8_t C5;
+} UART0_Type;
+
+#define UART0_BDH_SBR_MASK      (0x1FU)
+#define UART0_C2_RE_MASK        (0x4U)
+#define UART0_C2_TE_MASK        (0x8U)
+#define UART0_C2_TCIE_MASK      (0x40U)
+#define UART0_C2_TIE_MASK       (0x80U)
+#define UART0_S1_TC_MASK        (0x40U)
+#define UART0_S1_TDRE_MASK      (0x80U)
+#define UART0_C4_OSR_MASK       (0x1FU)
+#define UART0_C5_BOTHEDGE_MASK  (0x2U)
+
+extern UART0_Type sim_uart0;
+#define UART0   ((UART0_Type *)Sim_Touch(&sim_uart0))
+
+#endif /* HOST_MKL25Z4_H */
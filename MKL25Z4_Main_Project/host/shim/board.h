@@ -0,0 +1,22 @@
+/*
+ * board.h (host shim)
+ */
+
+#ifndef HOST_BOARD_H
+#define HOST_BOARD_H
+
+#include "clock_config.h"
+#include "fsl_common.h"
+#include "fsl_debug_console.h"
+
+#define BOARD_DEBUG_UART_TYPE       DEBUG_CONSOLE_DEVICE_TYPE_LPSCI
+#define BOARD_DEBUG_UART_BASEADDR   (uint32_t)(uintptr_t)UART0
+#define BOARD_DEBUG_UART_BAUDRATE   115200U
+
+/* Ca board.c: UART0 pe MCGPLLCLK/2 (48 MHz) */
+static inline void BOARD_InitDebugConsole(void) {
+    CLOCK_SetLpsci0Clock(1U);
+    DbgConsole_Init(BOARD_DEBUG_UART_BASEADDR, BOARD_DEBUG_UART_BAUDRATE, BOARD_DEBUG_UART_TYPE, 48000000U);
+}
+
+#endif /* HOST_BOARD_H */
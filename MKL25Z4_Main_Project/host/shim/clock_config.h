@@ -0,0 +1,53 @@
+/*
+ * clock_config.h (host shim)
+ * Aceleasi configuratii ca board/clock_config.c (RUN si VLPR)
+ */
+
+#ifndef HOST_CLOCK_CONFIG_H
+#define HOST_CLOCK_CONFIG_H
+
+#include "fsl_common.h"
+
+#define BOARD_XTAL0_CLK_HZ              SIM_XTAL0_HZ
+#define BOARD_BOOTCLOCKRUN_CORE_CLOCK   48000000U
+#define BOARD_BOOTCLOCKVLPR_CORE_CLOCK  4000000U
+
+static const mcg_config_t mcgConfig_BOARD_BootClockRUN = {
+    .mcgMode = kMCG_ModePEE,
+    .irclkEnableMode = 1U,
+    .ircs = kMCG_IrcSlow,
+    .fcrdiv = 0U,
+    .pll0Config = { .enableMode = 0U, .prdiv = 1U, .vdiv = 0U },
+};
+static const sim_clock_config_t simConfig_BOARD_BootClockRUN = {
+    .pllFllSel = SIM_PLLFLLSEL_MCGPLLCLK_CLK,
+    .clkdiv1 = 0x10010000U,
+};
+static const osc_config_t oscConfig_BOARD_BootClockRUN = {
+    .freq = SIM_XTAL0_HZ,
+};
+
+static const mcg_config_t mcgConfig_BOARD_BootClockVLPR = {
+    .mcgMode = kMCG_ModeBLPI,
+    .irclkEnableMode = 1U,
+    .ircs = kMCG_IrcFast,
+    .fcrdiv = 0U,
+    .pll0Config = { .enableMode = 0U, .prdiv = 0U, .vdiv = 0U },
+};
+static const sim_clock_config_t simConfig_BOARD_BootClockVLPR = {
+    .pllFllSel = SIM_PLLFLLSEL_MCGFLLCLK_CLK,
+    .clkdiv1 = 0x40000U,
+};
+
+static inline void BOARD_BootClockRUN(void) {
+    CLOCK_SetSimSafeDivs();
+    CLOCK_SetMcgConfig(&mcgConfig_BOARD_BootClockRUN);
+    CLOCK_SetSimConfig(&simConfig_BOARD_BootClockRUN);
+    SystemCoreClock = BOARD_BOOTCLOCKRUN_CORE_CLOCK;
+}
+
+static inline void BOARD_InitBootClocks(void) {
+    BOARD_BootClockRUN();
+}
+
+#endif /* HOST_CLOCK_CONFIG_H */
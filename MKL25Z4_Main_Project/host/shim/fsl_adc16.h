@@ -0,0 +1,130 @@
+/*
+ * fsl_adc16.h (host shim)
+ * Scrierea SC1[n] (sau triggerul hardware din SIM_SOPT7) porneste o
+ * conversie; R[n] si COCO apar dupa timpul de conversie din CFG1/SC3
+ * (sim.c), cu valoarea din Sim_SetAdc. Media hardware nu schimba valoarea
+ * simulata, doar durata.
+ */
+
+#ifndef HOST_FSL_ADC16_H
+#define HOST_FSL_ADC16_H
+
+#include "fsl_common.h"
+
+enum _adc16_channel_status_flags {
+    kADC16_ChannelConversionDoneFlag = ADC_SC1_COCO_MASK
+};
+
+typedef enum _adc16_resolution {
+    kADC16_ResolutionSE8Bit = 0U,
+    kADC16_ResolutionSE12Bit = 1U,
+    kADC16_ResolutionSE10Bit = 2U,
+    kADC16_ResolutionSE16Bit = 3U
+} adc16_resolution_t;
+
+/* Ca in SDK: valorile merg direct in CFG1[ADICLK] si CFG1[ADIV] */
+typedef enum _adc16_clock_source {
+    kADC16_ClockSourceAlt0 = 0U,            /* Bus */
+    kADC16_ClockSourceAlt1 = 1U,            /* Bus / 2 */
+    kADC16_ClockSourceAlt2 = 2U,            /* OSCERCLK */
+    kADC16_ClockSourceAlt3 = 3U,            /* ADACK */
+    kADC16_ClockSourceAsynchronousClock = kADC16_ClockSourceAlt3
+} adc16_clock_source_t;
+
+typedef enum _adc16_clock_divider {
+    kADC16_ClockDivider1 = 0U,
+    kADC16_ClockDivider2 = 1U,
+    kADC16_ClockDivider4 = 2U,
+    kADC16_ClockDivider8 = 3U
+} adc16_clock_divider_t;
+
+typedef enum _adc16_hardware_average_mode {
+    kADC16_HardwareAverageCount4 = 0U,
+    kADC16_HardwareAverageCount8 = 1U,
+    kADC16_HardwareAverageCount16 = 2U,
+    kADC16_HardwareAverageCount32 = 3U,
+    kADC16_HardwareAverageDisabled = 4U
+} adc16_hardware_average_mode_t;
+
+typedef struct _adc16_config {
+    uint32_t referenceVoltageSource;
+    adc16_clock_source_t clockSource;
+    bool enableAsynchronousClock;
+    adc16_clock_divider_t clockDivider;
+    adc16_resolution_t resolution;
+    uint32_t longSampleMode;
+    bool enableHighSpeed;
+    bool enableLowPower;
+    bool enableContinuousConversion;
+} adc16_config_t;
+
+typedef struct _adc16_channel_config {
+    uint32_t channelNumber;
+    bool enableInterruptOnConversionCompleted;
+    bool enableDifferentialConversion;
+} adc16_channel_config_t;
+
+static inline void ADC16_GetDefaultConfig(adc16_config_t *config) {
+    config->referenceVoltageSource = 0;
+    config->clockSource = kADC16_ClockSourceAsynchronousClock;
+    config->enableAsynchronousClock = true;
+    config->clockDivider = kADC16_ClockDivider8;
+    config->resolution = kADC16_ResolutionSE12Bit;
+    config->longSampleMode = 0;
+    config->enableHighSpeed = false;
+    config->enableLowPower = false;
+    config->enableContinuousConversion = false;
+}
+
+static inline void ADC16_Init(ADC_Type *base, const adc16_config_t *config) {
+    uint32_t cfg1 = ADC_CFG1_ADICLK(config->clockSource) | ADC_CFG1_ADIV(config->clockDivider) |
+                    ADC_CFG1_MODE(config->resolution);
+    uint32_t cfg2 = 0;
+
+    if (config->longSampleMode) cfg1 |= ADC_CFG1_ADLSMP_MASK;
+    if (config->enableLowPower) cfg1 |= ADC_CFG1_ADLPC_MASK;
+    if (config->enableHighSpeed) cfg2 |= ADC_CFG2_ADHSC_MASK;
+    if (config->enableAsynchronousClock) cfg2 |= ADC_CFG2_ADACKEN_MASK;
+    base->CFG1 = cfg1;
+    base->CFG2 = cfg2;
+    base->SC1[0] = ADC_SC1_ADCH(31);
+}
+
+static inline status_t ADC16_DoAutoCalibration(ADC_Type *base) {
+    (void)base;
+    return kStatus_Success;
+}
+
+static inline void ADC16_SetChannelConfig(ADC_Type *base, uint32_t group, const adc16_channel_config_t *config) {
+    uint32_t sc1 = ADC_SC1_ADCH(config->channelNumber);
+    if (config->enableInterruptOnConversionCompleted) {
+        sc1 |= ADC_SC1_AIEN_MASK;
+    }
+    base->SC1[group] = sc1;
+}
+
+static inline void ADC16_EnableHardwareTrigger(ADC_Type *base, bool enable) {
+    if (enable) {
+        base->SC2 |= ADC_SC2_ADTRG_MASK;
+    } else {
+        base->SC2 &= ~ADC_SC2_ADTRG_MASK;
+    }
+}
+
+static inline void ADC16_SetHardwareAverage(ADC_Type *base, adc16_hardware_average_mode_t mode) {
+    uint32_t sc3 = base->SC3 & ~(ADC_SC3_AVGE_MASK | ADC_SC3_AVGS_MASK);
+    if (mode != kADC16_HardwareAverageDisabled) {
+        sc3 |= ADC_SC3_AVGE_MASK | ADC_SC3_AVGS(mode);
+    }
+    base->SC3 = sc3;
+}
+
+static inline uint32_t ADC16_GetChannelStatusFlags(ADC_Type *base, uint32_t group) {
+    return base->SC1[group] & ADC_SC1_COCO_MASK;
+}
+
+static inline uint32_t ADC16_GetChannelConversionValue(ADC_Type *base, uint32_t group) {
+    return base->R[group];
+}
+
+#endif /* HOST_FSL_ADC16_H */
@@ -0,0 +1,150 @@
+/*
+ * fsl_clock.h (host shim)
+ * Configuratiile MCG/SIM ajung in modelul de ceas din sim.c (PEE si BLPI,
+ * plus PBE dupa VLPS), gating-ul e ignorat
+ */
+
+#ifndef HOST_FSL_CLOCK_H
+#define HOST_FSL_CLOCK_H
+
+#include "fsl_common.h"
+
+#define SIM_PLLFLLSEL_MCGFLLCLK_CLK     0U
+#define SIM_PLLFLLSEL_MCGPLLCLK_CLK     1U
+
+typedef enum _clock_name {
+    kCLOCK_CoreSysClk,
+    kCLOCK_PlatClk,
+    kCLOCK_BusClk,
+    kCLOCK_FlashClk,
+    kCLOCK_PllFllSelClk
+} clock_name_t;
+
+typedef enum _clock_ip_name {
+    kCLOCK_IpInvalid = 0,
+    kCLOCK_PortA, kCLOCK_PortB, kCLOCK_PortC, kCLOCK_PortD, kCLOCK_PortE,
+    kCLOCK_Spi0, kCLOCK_Spi1,
+    kCLOCK_Adc0, kCLOCK_Dac0,
+    kCLOCK_Tpm0, kCLOCK_Tpm1, kCLOCK_Tpm2,
+    kCLOCK_Pit0, kCLOCK_Lptmr0,
+    kCLOCK_Dma0, kCLOCK_Dmamux0,
+    kCLOCK_Uart0, kCLOCK_Ftf0
+} clock_ip_name_t;
+
+/* Modurile din board/clock_config.c si PBE (iesirea din STOP din PEE) */
+typedef enum _mcg_mode {
+    kMCG_ModeBLPI = 2U,
+    kMCG_ModePBE = 6U,
+    kMCG_ModePEE = 7U
+} mcg_mode_t;
+
+typedef enum _mcg_irc_mode {
+    kMCG_IrcSlow = 0U,
+    kMCG_IrcFast
+} mcg_irc_mode_t;
+
+typedef struct _mcg_pll_config {
+    uint8_t enableMode;
+    uint8_t prdiv;
+    uint8_t vdiv;
+} mcg_pll_config_t;
+
+typedef struct _mcg_config {
+    mcg_mode_t mcgMode;
+    uint8_t irclkEnableMode;
+    mcg_irc_mode_t ircs;
+    uint8_t fcrdiv;
+    mcg_pll_config_t pll0Config;
+} mcg_config_t;
+
+typedef struct _sim_clock_config {
+    uint8_t pllFllSel;
+    uint32_t clkdiv1;
+} sim_clock_config_t;
+
+typedef struct _osc_config {
+    uint32_t freq;
+} osc_config_t;
+
+static inline void CLOCK_EnableClock(clock_ip_name_t name)  { (void)name; }
+static inline void CLOCK_DisableClock(clock_ip_name_t name) { (void)name; }
+
+static inline void CLOCK_SetTpmClock(uint32_t src) {
+    SIM->SOPT2 = (SIM->SOPT2 & ~SIM_SOPT2_TPMSRC_MASK) | SIM_SOPT2_TPMSRC(src);
+}
+
+static inline void CLOCK_SetLpsci0Clock(uint32_t src) {
+    SIM->SOPT2 = (SIM->SOPT2 & ~SIM_SOPT2_UART0SRC_MASK) | SIM_SOPT2_UART0SRC(src);
+}
+
+/* OSC0 ramane pornit in model: PLL-ul il foloseste doar in PEE */
+static inline void CLOCK_InitOsc0(osc_config_t const *config) { (void)config; }
+static inline void CLOCK_DeinitOsc0(void) {}
+static inline void CLOCK_SetXtal0Freq(uint32_t freq) { (void)freq; }
+
+static inline void CLOCK_SetSimSafeDivs(void) {
+    SIM->CLKDIV1 = 0x10030000U;
+}
+
+static inline void CLOCK_SetSimConfig(sim_clock_config_t const *config) {
+    SIM->CLKDIV1 = config->clkdiv1;
+    SIM->SOPT2 = (SIM->SOPT2 & ~SIM_SOPT2_PLLFLLSEL_MASK) | SIM_SOPT2_PLLFLLSEL(config->pllFllSel);
+}
+
+/* PEE: cristal 8 MHz / (PRDIV + 1) * (VDIV + 24); BLPI: IRC-ul ales */
+static inline status_t CLOCK_SetMcgConfig(mcg_config_t const *config) {
+    SimMcg_t mcg;
+
+    mcg.irc_hz = (config->ircs == kMCG_IrcFast) ? (SIM_FAST_IRC_HZ >> config->fcrdiv) : SIM_SLOW_IRC_HZ;
+    mcg.fll_hz = 0;
+    if (config->mcgMode == kMCG_ModePEE) {
+        mcg.pll_hz = SIM_XTAL0_HZ / (config->pll0Config.prdiv + 1U) * (config->pll0Config.vdiv + 24U);
+        mcg.mcgout_hz = mcg.pll_hz;
+    } else {
+        mcg.pll_hz = 0;
+        mcg.mcgout_hz = mcg.irc_hz;
+    }
+    Sim_SetMcg(&mcg);
+    return kStatus_Success;
+}
+
+static inline mcg_mode_t CLOCK_GetMode(void) {
+    switch ((MCG->S & MCG_S_CLKST_MASK) >> MCG_S_CLKST_SHIFT) {
+        case MCG_S_CLKST_PLL: return kMCG_ModePEE;
+        case MCG_S_CLKST_EXT: return kMCG_ModePBE;
+        default:              return kMCG_ModeBLPI;
+    }
+}
+
+/* PBE -> PEE: MCGOUTCLK trece pe PLL (ca in SDK, fara sa astepte LOCK0) */
+static inline status_t CLOCK_SetPeeMode(void) {
+    SimMcg_t mcg;
+
+    Sim_GetMcg(&mcg);
+    mcg.mcgout_hz = mcg.pll_hz;
+    Sim_SetMcg(&mcg);
+    return kStatus_Success;
+}
+
+static inline uint32_t CLOCK_GetFreq(clock_name_t name) {
+    SimClocks_t c;
+    Sim_GetClocks(&c);
+    switch (name) {
+        case kCLOCK_BusClk:
+        case kCLOCK_FlashClk:    return c.bus_hz;
+        case kCLOCK_PllFllSelClk: return c.pllfll_hz;
+        default:                 return c.core_hz;
+    }
+}
+
+static inline uint32_t CLOCK_GetBusClkFreq(void)       { return CLOCK_GetFreq(kCLOCK_BusClk); }
+static inline uint32_t CLOCK_GetCoreSysClkFreq(void)   { return CLOCK_GetFreq(kCLOCK_CoreSysClk); }
+static inline uint32_t CLOCK_GetPllFllSelClkFreq(void) { return CLOCK_GetFreq(kCLOCK_PllFllSelClk); }
+
+static inline uint32_t CLOCK_GetInternalRefClkFreq(void) {
+    SimClocks_t c;
+    Sim_GetClocks(&c);
+    return c.irc_hz;
+}
+
+#endif /* HOST_FSL_CLOCK_H */
@@ -0,0 +1,44 @@
+/*
+ * fsl_common.h (host shim)
+ * Subsetul din fsl_common folosit de firmware
+ */
+
+#ifndef HOST_FSL_COMMON_H
+#define HOST_FSL_COMMON_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "MKL25Z4.h"
+
+typedef int32_t status_t;
+
+#define DEBUG_CONSOLE_DEVICE_TYPE_LPSCI 3U
+
+enum {
+    kStatus_Success = 0,
+    kStatus_Fail = 1
+};
+
+static inline void EnableIRQ(IRQn_Type irq) {
+    Sim_IrqEnable(irq, true);
+}
+
+static inline void DisableIRQ(IRQn_Type irq) {
+    Sim_IrqEnable(irq, false);
+}
+
+static inline uint32_t DisableGlobalIRQ(void) {
+    Sim_IrqMaskAll(true);
+    return 0;
+}
+
+static inline void EnableGlobalIRQ(uint32_t primask) {
+    (void)primask;
+    Sim_IrqMaskAll(false);
+}
+
+/* Ca in SDK: fsl_common aduce si fsl_clock */
+#include "fsl_clock.h"
+
+#endif /* HOST_FSL_COMMON_H */
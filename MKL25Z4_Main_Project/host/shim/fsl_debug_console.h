@@ -0,0 +1,33 @@
+/*
+ * fsl_debug_console.h (host shim)
+ * PRINTF merge pe stderr (oprit cu -q), fara sa treaca prin UART0-ul
+ * simulat. Init/Deinit fac pe UART0 ce face LPSCI_Init/Deinit: baud-ul
+ * din ceasul dat, C2 rescris (TIE sters), iar Deinit asteapta TC.
+ */
+
+#ifndef HOST_FSL_DEBUG_CONSOLE_H
+#define HOST_FSL_DEBUG_CONSOLE_H
+
+#include "fsl_common.h"
+#include "fsl_lpsci.h"
+
+int Host_Printf(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+#define PRINTF  Host_Printf
+
+static inline status_t DbgConsole_Init(uint32_t baseAddr, uint32_t baudRate, uint8_t device, uint32_t clkSrcFreq) {
+    (void)baseAddr; (void)device;
+    if (LPSCI_SetBaudRate(UART0, baudRate, clkSrcFreq) != kStatus_Success) return kStatus_Fail;
+    UART0->C2 = UART0_C2_TE_MASK | UART0_C2_RE_MASK;
+    return kStatus_Success;
+}
+
+static inline status_t DbgConsole_Deinit(void) {
+    while (!(UART0->S1 & UART0_S1_TC_MASK)) {
+        __NOP();
+    }
+    UART0->C2 = 0;
+    return kStatus_Success;
+}
+
+#endif /* HOST_FSL_DEBUG_CONSOLE_H */
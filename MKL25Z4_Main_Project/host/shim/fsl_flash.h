@@ -0,0 +1,54 @@
+/*
+ * fsl_flash.h (host shim)
+ * Subsetul din drivers/fsl_flash.h folosit de kv_store_kl25z.c, peste
+ * flash-ul simulat din sim.c (stergere si programare cu timpii din datasheet)
+ */
+
+#ifndef HOST_FSL_FLASH_H
+#define HOST_FSL_FLASH_H
+
+#include "fsl_common.h"
+
+#define FOUR_CHAR_CODE(a, b, c, d) (((d) << 24) | ((c) << 16) | ((b) << 8) | ((a)))
+
+enum {
+    kStatus_FLASH_Success = 0,
+    kStatus_FLASH_InvalidArgument = 4,
+    kStatus_FLASH_AlignmentError = 101,
+    kStatus_FLASH_AccessError = 103,
+    kStatus_FLASH_EraseKeyError = 107
+};
+
+enum {
+    kFLASH_ApiEraseKey = FOUR_CHAR_CODE('k', 'f', 'e', 'k')
+};
+
+typedef struct {
+    uint32_t PFlashBlockBase;
+    uint32_t PFlashTotalSize;
+    uint32_t PFlashSectorSize;
+} flash_config_t;
+
+static inline status_t FLASH_Init(flash_config_t *config) {
+    config->PFlashBlockBase = 0;
+    config->PFlashTotalSize = 0x20000U;
+    config->PFlashSectorSize = SIM_FLASH_SECTOR;
+    return kStatus_FLASH_Success;
+}
+
+static inline status_t FLASH_Erase(flash_config_t *config, uint32_t start, uint32_t lengthInBytes,
+                                   uint32_t key) {
+    if (key != kFLASH_ApiEraseKey) return kStatus_FLASH_EraseKeyError;
+    if ((start | lengthInBytes) & (config->PFlashSectorSize - 1U)) return kStatus_FLASH_AlignmentError;
+    return Sim_FlashErase(start, lengthInBytes) ? kStatus_FLASH_Success : kStatus_FLASH_AccessError;
+}
+
+static inline status_t FLASH_Program(flash_config_t *config, uint32_t start, uint32_t *src,
+                                     uint32_t lengthInBytes) {
+    (void)config;
+    if (src == NULL) return kStatus_FLASH_InvalidArgument;
+    if ((start | lengthInBytes) & 3U) return kStatus_FLASH_AlignmentError;
+    return Sim_FlashProgram(start, src, lengthInBytes) ? kStatus_FLASH_Success : kStatus_FLASH_AccessError;
+}
+
+#endif /* HOST_FSL_FLASH_H */
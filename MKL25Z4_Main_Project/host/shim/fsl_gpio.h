@@ -0,0 +1,41 @@
+/*
+ * fsl_gpio.h (host shim)
+ */
+
+#ifndef HOST_FSL_GPIO_H
+#define HOST_FSL_GPIO_H
+
+#include "fsl_common.h"
+
+typedef enum _gpio_pin_direction {
+    kGPIO_DigitalInput = 0U,
+    kGPIO_DigitalOutput = 1U
+} gpio_pin_direction_t;
+
+typedef struct _gpio_pin_config {
+    gpio_pin_direction_t pinDirection;
+    uint8_t outputLogic;
+} gpio_pin_config_t;
+
+static inline void GPIO_WritePinOutput(GPIO_Type *base, uint32_t pin, uint8_t output) {
+    if (output) {
+        base->PSOR = 1U << pin;
+    } else {
+        base->PCOR = 1U << pin;
+    }
+}
+
+static inline void GPIO_PinInit(GPIO_Type *base, uint32_t pin, const gpio_pin_config_t *config) {
+    if (config->pinDirection == kGPIO_DigitalInput) {
+        base->PDDR &= ~(1U << pin);
+    } else {
+        GPIO_WritePinOutput(base, pin, config->outputLogic);
+        base->PDDR |= (1U << pin);
+    }
+}
+
+static inline uint32_t GPIO_ReadPinInput(GPIO_Type *base, uint32_t pin) {
+    return (base->PDIR >> pin) & 1U;
+}
+
+#endif /* HOST_FSL_GPIO_H */
@@ -0,0 +1,76 @@
+/*
+ * fsl_lpsci.h (host shim)
+ * Subsetul din drivers/fsl_lpsci.h folosit de consola si de log_kl25z.c;
+ * fiecare acces trece prin Sim_Touch, ca in bucla de emisie sim.c sa vada
+ * octetul scris inainte de urmatoarea citire a lui S1
+ */
+
+#ifndef HOST_FSL_LPSCI_H
+#define HOST_FSL_LPSCI_H
+
+#include "fsl_common.h"
+
+enum _lpsci_interrupt_enable_t {
+    kLPSCI_TxDataRegEmptyInterruptEnable = (UART0_C2_TIE_MASK << 8),
+    kLPSCI_TransmissionCompleteInterruptEnable = (UART0_C2_TCIE_MASK << 8)
+};
+
+enum _lpsci_status_flag_t {
+    kLPSCI_TxDataRegEmptyFlag = UART0_S1_TDRE_MASK,
+    kLPSCI_TransmissionCompleteFlag = UART0_S1_TC_MASK
+};
+
+static inline UART0_Type *LPSCI_Regs(UART0_Type *base) {
+    return (UART0_Type *)Sim_Touch(base);
+}
+
+/* Aceeasi cautare ca in SDK: OSR 4..32, SBR cel mai apropiat */
+static inline status_t LPSCI_SetBaudRate(UART0_Type *base, uint32_t baudRate_Bps, uint32_t srcClock_Hz) {
+    uint32_t best_diff = baudRate_Bps;
+    uint32_t osr = 0, sbr = 0;
+
+    for (uint32_t o = 4; o <= 32U; o++) {
+        uint32_t s = srcClock_Hz / (baudRate_Bps * o);
+        if (s == 0) s = 1;
+        uint32_t diff = srcClock_Hz / (o * s) - baudRate_Bps;
+        if (diff > baudRate_Bps - srcClock_Hz / (o * (s + 1U))) {
+            diff = baudRate_Bps - srcClock_Hz / (o * (s + 1U));
+            s++;
+        }
+        if (diff <= best_diff) {
+            best_diff = diff;
+            osr = o;
+            sbr = s;
+        }
+    }
+    if (best_diff >= (baudRate_Bps / 100U) * 3U) return kStatus_Fail;
+
+    UART0_Type *regs = LPSCI_Regs(base);
+    regs->C5 = (osr < 8U) ? UART0_C5_BOTHEDGE_MASK : 0;
+    regs->C4 = (uint8_t)(osr - 1U);
+    regs->BDH = (uint8_t)((sbr >> 8) & UART0_BDH_SBR_MASK);
+    regs->BDL = (uint8_t)sbr;
+    return kStatus_Success;
+}
+
+static inline uint32_t LPSCI_GetStatusFlags(UART0_Type *base) {
+    return LPSCI_Regs(base)->S1;
+}
+
+static inline void LPSCI_EnableInterrupts(UART0_Type *base, uint32_t mask) {
+    LPSCI_Regs(base)->C2 |= (uint8_t)(mask >> 8);
+}
+
+static inline void LPSCI_DisableInterrupts(UART0_Type *base, uint32_t mask) {
+    LPSCI_Regs(base)->C2 &= (uint8_t)~(mask >> 8);
+}
+
+static inline uint32_t LPSCI_GetEnabledInterrupts(UART0_Type *base) {
+    return (uint32_t)LPSCI_Regs(base)->C2 << 8;
+}
+
+static inline void LPSCI_WriteByte(UART0_Type *base, uint8_t data) {
+    LPSCI_Regs(base)->D = data;
+}
+
+#endif /* HOST_FSL_LPSCI_H */
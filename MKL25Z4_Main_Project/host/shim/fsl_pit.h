@@ -0,0 +1,66 @@
+/*
+ * fsl_pit.h (host shim)
+ * Aceeasi interfata ca drivers/fsl_pit.h; TFLG e sters explicit
+ * (pe hardware e write-1-to-clear)
+ */
+
+#ifndef HOST_FSL_PIT_H
+#define HOST_FSL_PIT_H
+
+#include "fsl_common.h"
+
+typedef enum {
+    kPIT_Chnl_0 = 0U,
+    kPIT_Chnl_1 = 1U
+} pit_chnl_t;
+
+enum {
+    kPIT_TimerFlag = PIT_TFLG_TIF_MASK
+};
+
+enum {
+    kPIT_TimerInterruptEnable = PIT_TCTRL_TIE_MASK
+};
+
+typedef struct {
+    bool enableRunInDebug;
+} pit_config_t;
+
+static inline void PIT_GetDefaultConfig(pit_config_t *config) {
+    config->enableRunInDebug = false;
+}
+
+static inline void PIT_Init(PIT_Type *base, const pit_config_t *config) {
+    (void)config;
+    base->MCR = 0;
+}
+
+static inline void PIT_SetTimerPeriod(PIT_Type *base, pit_chnl_t channel, uint32_t count) {
+    base->CHANNEL[channel].LDVAL = count;
+}
+
+static inline void PIT_EnableInterrupts(PIT_Type *base, pit_chnl_t channel, uint32_t mask) {
+    base->CHANNEL[channel].TCTRL |= mask;
+}
+
+static inline void PIT_DisableInterrupts(PIT_Type *base, pit_chnl_t channel, uint32_t mask) {
+    base->CHANNEL[channel].TCTRL &= ~mask;
+}
+
+static inline uint32_t PIT_GetStatusFlags(PIT_Type *base, pit_chnl_t channel) {
+    return base->CHANNEL[channel].TFLG;
+}
+
+static inline void PIT_ClearStatusFlags(PIT_Type *base, pit_chnl_t channel, uint32_t mask) {
+    base->CHANNEL[channel].TFLG &= ~mask;
+}
+
+static inline void PIT_StartTimer(PIT_Type *base, pit_chnl_t channel) {
+    base->CHANNEL[channel].TCTRL |= PIT_TCTRL_TEN_MASK;
+}
+
+static inline void PIT_StopTimer(PIT_Type *base, pit_chnl_t channel) {
+    base->CHANNEL[channel].TCTRL &= ~PIT_TCTRL_TEN_MASK;
+}
+
+#endif /* HOST_FSL_PIT_H */
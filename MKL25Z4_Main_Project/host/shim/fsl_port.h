@@ -0,0 +1,51 @@
+/*
+ * fsl_port.h (host shim)
+ * Aceleasi operatii pe PCR/ISFR ca driverul SDK; ISFR e sters explicit
+ * (pe hardware e write-1-to-clear)
+ */
+
+#ifndef HOST_FSL_PORT_H
+#define HOST_FSL_PORT_H
+
+#include "fsl_common.h"
+
+typedef enum _port_mux {
+    kPORT_PinDisabledOrAnalog = 0U,
+    kPORT_MuxAsGpio = 1U,
+    kPORT_MuxAlt2 = 2U,
+    kPORT_MuxAlt3 = 3U,
+    kPORT_MuxAlt4 = 4U,
+    kPORT_MuxAlt5 = 5U,
+    kPORT_MuxAlt6 = 6U,
+    kPORT_MuxAlt7 = 7U
+} port_mux_t;
+
+typedef enum _port_interrupt {
+    kPORT_InterruptOrDMADisabled = 0x0U,
+    kPORT_DMARisingEdge = 0x1U,
+    kPORT_DMAFallingEdge = 0x2U,
+    kPORT_DMAEitherEdge = 0x3U,
+    kPORT_InterruptLogicZero = 0x8U,
+    kPORT_InterruptRisingEdge = 0x9U,
+    kPORT_InterruptFallingEdge = 0xAU,
+    kPORT_InterruptEitherEdge = 0xBU,
+    kPORT_InterruptLogicOne = 0xCU
+} port_interrupt_t;
+
+static inline void PORT_SetPinMux(PORT_Type *base, uint32_t pin, port_mux_t mux) {
+    base->PCR[pin] = (base->PCR[pin] & ~PORT_PCR_MUX_MASK) | PORT_PCR_MUX(mux);
+}
+
+static inline void PORT_SetPinInterruptConfig(PORT_Type *base, uint32_t pin, port_interrupt_t config) {
+    base->PCR[pin] = (base->PCR[pin] & ~PORT_PCR_IRQC_MASK) | PORT_PCR_IRQC(config);
+}
+
+static inline uint32_t PORT_GetPinsInterruptFlags(PORT_Type *base) {
+    return base->ISFR;
+}
+
+static inline void PORT_ClearPinsInterruptFlags(PORT_Type *base, uint32_t mask) {
+    base->ISFR &= ~mask;
+}
+
+#endif /* HOST_FSL_PORT_H */
@@ -0,0 +1,74 @@
+/*
+ * fsl_smc.h (host shim)
+ * Aceeasi interfata ca drivers/fsl_smc.h, pentru modurile folosite de
+ * firmware (RUN/VLPR, WAIT si VLPS); __WFI decide modul dupa
+ * SCB->SCR[SLEEPDEEP], PMSTAT urmeaza PMCTRL[RUNM] in sim.c
+ */
+
+#ifndef HOST_FSL_SMC_H
+#define HOST_FSL_SMC_H
+
+#include "fsl_common.h"
+
+enum {
+    kStatus_SMC_StopAbort = 1001
+};
+
+typedef enum {
+    kSMC_AllowPowerModeVlp = SMC_PMPROT_AVLP_MASK
+} smc_power_mode_protection_t;
+
+typedef enum {
+    kSMC_StopNormal = 0U,
+    kSMC_StopVlps = 2U
+} smc_power_mode_stop_t;
+
+typedef enum {
+    kSMC_PowerStateRun = SMC_PMSTAT_RUN,
+    kSMC_PowerStateVlpr = SMC_PMSTAT_VLPR
+} smc_power_state_t;
+
+static inline void SMC_SetPowerModeProtection(SMC_Type *base, uint8_t allowedModes) {
+    base->PMPROT = allowedModes;
+}
+
+static inline smc_power_state_t SMC_GetPowerModeState(SMC_Type *base) {
+    return (smc_power_state_t)base->PMSTAT;
+}
+
+static inline status_t SMC_SetPowerModeRun(SMC_Type *base) {
+    base->PMCTRL = (base->PMCTRL & ~SMC_PMCTRL_RUNM_MASK) | SMC_PMCTRL_RUNM(0U);
+    return kStatus_Success;
+}
+
+static inline status_t SMC_SetPowerModeVlpr(SMC_Type *base) {
+    base->PMCTRL = (base->PMCTRL & ~SMC_PMCTRL_RUNM_MASK) | SMC_PMCTRL_RUNM(2U);
+    return kStatus_Success;
+}
+
+static inline status_t SMC_SetPowerModeWait(SMC_Type *base) {
+    (void)base;
+    SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+    __DSB();
+    __WFI();
+    __ISB();
+    return kStatus_Success;
+}
+
+static inline status_t SMC_SetPowerModeVlps(SMC_Type *base) {
+    uint8_t reg = base->PMCTRL;
+    reg &= ~SMC_PMCTRL_STOPM_MASK;
+    reg |= (kSMC_StopVlps << SMC_PMCTRL_STOPM_SHIFT);
+    base->PMCTRL = reg;
+
+    SCB->SCR |= SCB_SCR_SLEEPDEEP_Msk;
+
+    (void)base->PMCTRL;
+    __DSB();
+    __WFI();
+    __ISB();
+
+    return (base->PMCTRL & SMC_PMCTRL_STOPA_MASK) ? kStatus_SMC_StopAbort : kStatus_Success;
+}
+
+#endif /* HOST_FSL_SMC_H */
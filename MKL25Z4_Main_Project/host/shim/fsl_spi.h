@@ -0,0 +1,87 @@
+/*
+ * fsl_spi.h (host shim)
+ * Doar initializarea master; transferurile merg direct pe registre
+ */
+
+#ifndef HOST_FSL_SPI_H
+#define HOST_FSL_SPI_H
+
+#include "fsl_common.h"
+
+enum _spi_flags {
+    kSPI_RxBufferFullFlag = SPI_S_SPRF_MASK,
+    kSPI_TxBufferEmptyFlag = SPI_S_SPTEF_MASK
+};
+
+typedef enum _spi_clock_polarity {
+    kSPI_ClockPolarityActiveHigh = 0x0U,
+    kSPI_ClockPolarityActiveLow
+} spi_clock_polarity_t;
+
+typedef enum _spi_clock_phase {
+    kSPI_ClockPhaseFirstEdge = 0x0U,
+    kSPI_ClockPhaseSecondEdge
+} spi_clock_phase_t;
+
+typedef enum _spi_shift_direction {
+    kSPI_MsbFirst = 0x0U,
+    kSPI_LsbFirst
+} spi_shift_direction_t;
+
+typedef struct _spi_master_config {
+    bool enableMaster;
+    bool enableStopInWaitMode;
+    spi_clock_polarity_t polarity;
+    spi_clock_phase_t phase;
+    spi_shift_direction_t direction;
+    uint32_t outputMode;
+    uint32_t pinMode;
+    uint32_t baudRate_Bps;
+} spi_master_config_t;
+
+static inline void SPI_MasterGetDefaultConfig(spi_master_config_t *config) {
+    config->enableMaster = true;
+    config->enableStopInWaitMode = false;
+    config->polarity = kSPI_ClockPolarityActiveHigh;
+    config->phase = kSPI_ClockPhaseFirstEdge;
+    config->direction = kSPI_MsbFirst;
+    config->outputMode = 0;
+    config->pinMode = 0;
+    config->baudRate_Bps = 500000U;
+}
+
+/* Aceeasi cautare ca in SDK: cel mai apropiat baud <= cel cerut,
+ * prescaler 1..8 si divizor 2..512; sim.c citeste BR */
+static inline void SPI_MasterSetBaudRate(SPI_Type *base, uint32_t baudRate_Bps, uint32_t srcClock_Hz) {
+    uint32_t min_diff = 0xFFFFFFFFU;
+    uint32_t best_prescaler = 0, best_divisor = 0;
+
+    for (uint32_t prescaler = 0; prescaler <= 7U && min_diff; prescaler++) {
+        uint32_t divisor_value = 2U;
+        for (uint32_t divisor = 0; divisor <= 8U && min_diff; divisor++) {
+            uint32_t real = srcClock_Hz / ((prescaler + 1U) * divisor_value);
+            if (baudRate_Bps >= real && baudRate_Bps - real < min_diff) {
+                min_diff = baudRate_Bps - real;
+                best_prescaler = prescaler;
+                best_divisor = divisor;
+            }
+            divisor_value *= 2U;
+        }
+    }
+    base->BR = SPI_BR_SPR(best_divisor) | SPI_BR_SPPR(best_prescaler);
+}
+
+static inline void SPI_MasterInit(SPI_Type *base, const spi_master_config_t *config, uint32_t srcClock_Hz) {
+    base->C1 = SPI_C1_MSTR_MASK;
+    SPI_MasterSetBaudRate(base, config->baudRate_Bps, srcClock_Hz);
+}
+
+static inline void SPI_Enable(SPI_Type *base, bool enable) {
+    if (enable) {
+        base->C1 |= SPI_C1_SPE_MASK;
+    } else {
+        base->C1 &= ~SPI_C1_SPE_MASK;
+    }
+}
+
+#endif /* HOST_FSL_SPI_H */
@@ -0,0 +1,10 @@
+/*
+ * peripherals.h (host shim)
+ */
+
+#ifndef HOST_PERIPHERALS_H
+#define HOST_PERIPHERALS_H
+
+static inline void BOARD_InitBootPeripherals(void) {}
+
+#endif /* HOST_PERIPHERALS_H */
@@ -0,0 +1,10 @@
+/*
+ * pin_mux.h (host shim)
+ */
+
+#ifndef HOST_PIN_MUX_H
+#define HOST_PIN_MUX_H
+
+static inline void BOARD_InitBootPins(void) {}
+
+#endif /* HOST_PIN_MUX_H */
@@ -0,0 +1,1380 @@
+/*
+ * sim.c
+ * MCU virtual pentru build-ul host
+ *
+ * Model de executie:
+ * - codul firmware ruleaza "instantaneu"; timpul avanseaza doar cu octetii
+ *   SPI de pe fir si in __WFI / __NOP (care sar la urmatorul eveniment)
+ * - un transfer DMA se executa complet la pornire (CPU-ul e considerat
+ *   blocat pe durata lui), apoi intreruperea de final intra in asteptare
+ * - intreruperile se livreaza la urmatorul acces de registru, in ordinea
+ *   prioritatii NVIC, fara imbricare
+ * - ceasurile core/bus/TPM urmeaza MCG si SIM; timerele isi pastreaza
+ *   valoarea la o schimbare de ceas, viteza de executie a codului nu e
+ *   modelata (si in VLPR codul ruleaza "instantaneu")
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "sim.h"
+#include "panel.h"
+#include "shim/MKL25Z4.h"
+
+/*============================================================================
+ * BOARD WIRING
+ *============================================================================*/
+
+#define LCD_PORT        2U      /* PTC */
+#define LCD_RST_PIN     0U
+#define LCD_DC_PIN      3U
+#define LCD_CS_PIN      4U
+
+#define SPI_D_EMPTY     0x100U
+#define UART_D_EMPTY    0x100U
+#define UART_FRAME_BITS 10U     /* Start + 8 date + stop */
+
+#define DMAMUX_SRC_SPI0_RX  16U
+#define DMAMUX_SRC_SPI0_TX  17U
+#define DMAMUX_SRC_TPM0_OVF 54U     /* + i pentru TPMi */
+
+#define VECTOR_OFFSET   16      /* Exceptiile core au IRQn negativ */
+#define NUM_VECTORS     (VECTOR_OFFSET + SIM_NUM_IRQS)
+
+/*============================================================================
+ * PERIPHERAL INSTANCES
+ *============================================================================*/
+
+uint64_t sim_cycles = 0;
+uint32_t SystemCoreClock = SIM_CORE_HZ;
+
+SPI_Type sim_spi0 = { .S = SPI_S_SPTEF_MASK | SPI_S_SPRF_MASK, .D = SPI_D_EMPTY };
+GPIO_Type sim_gpio[5];
+PORT_Type sim_port[5];
+DMA_Type sim_dma0;
+DMAMUX_Type sim_dmamux0;
+TPM_Type sim_tpm[3];
+PIT_Type sim_pit;
+ADC_Type sim_adc0;
+DAC_Type sim_dac0;
+SIM_Type sim_sim = { .SOPT2 = SIM_SOPT2_PLLFLLSEL_MASK, .CLKDIV1 = 0x10010000U };
+SysTick_Type sim_systick;
+SCB_Type sim_scb;
+LPTMR_Type sim_lptmr0;
+SMC_Type sim_smc = { .PMSTAT = SMC_PMSTAT_RUN };
+MCG_Type sim_mcg = { .S = (MCG_S_CLKST_PLL << MCG_S_CLKST_SHIFT) | MCG_S_LOCK0_MASK };
+UART0_Type sim_uart0 = { .S1 = UART0_S1_TDRE_MASK | UART0_S1_TC_MASK, .D = UART_D_EMPTY };
+
+/*============================================================================
+ * INTERRUPT VECTORS (handler-ele lipsa din firmware cad pe DefaultISR)
+ *============================================================================*/
+
+void Sim_DefaultISR(void) {}
+
+#define WEAK_ISR(name)  void name(void) __attribute__((weak, alias("Sim_DefaultISR")))
+
+WEAK_ISR(SysTick_Handler);
+WEAK_ISR(DMA0_IRQHandler);
+WEAK_ISR(DMA1_IRQHandler);
+WEAK_ISR(DMA2_IRQHandler);
+WEAK_ISR(DMA3_IRQHandler);
+WEAK_ISR(FTFA_IRQHandler);
+WEAK_ISR(SPI0_IRQHandler);
+WEAK_ISR(UART0_IRQHandler);
+WEAK_ISR(ADC0_IRQHandler);
+WEAK_ISR(TPM0_IRQHandler);
+WEAK_ISR(TPM1_IRQHandler);
+WEAK_ISR(TPM2_IRQHandler);
+WEAK_ISR(PIT_IRQHandler);
+WEAK_ISR(DAC0_IRQHandler);
+WEAK_ISR(LPTMR0_IRQHandler);
+WEAK_ISR(PORTA_IRQHandler);
+WEAK_ISR(PORTD_IRQHandler);
+
+typedef void (*Isr_t)(void);
+
+static const Isr_t vectors[NUM_VECTORS] = {
+    [VECTOR_OFFSET + SysTick_IRQn] = SysTick_Handler,
+    [VECTOR_OFFSET + DMA0_IRQn]    = DMA0_IRQHandler,
+    [VECTOR_OFFSET + DMA1_IRQn]    = DMA1_IRQHandler,
+    [VECTOR_OFFSET + DMA2_IRQn]    = DMA2_IRQHandler,
+    [VECTOR_OFFSET + DMA3_IRQn]    = DMA3_IRQHandler,
+    [VECTOR_OFFSET + FTFA_IRQn]    = FTFA_IRQHandler,
+    [VECTOR_OFFSET + SPI0_IRQn]    = SPI0_IRQHandler,
+    [VECTOR_OFFSET + UART0_IRQn]   = UART0_IRQHandler,
+    [VECTOR_OFFSET + ADC0_IRQn]    = ADC0_IRQHandler,
+    [VECTOR_OFFSET + TPM0_IRQn]    = TPM0_IRQHandler,
+    [VECTOR_OFFSET + TPM1_IRQn]    = TPM1_IRQHandler,
+    [VECTOR_OFFSET + TPM2_IRQn]    = TPM2_IRQHandler,
+    [VECTOR_OFFSET + PIT_IRQn]     = PIT_IRQHandler,
+    [VECTOR_OFFSET + DAC0_IRQn]    = DAC0_IRQHandler,
+    [VECTOR_OFFSET + LPTMR0_IRQn]  = LPTMR0_IRQHandler,
+    [VECTOR_OFFSET + PORTA_IRQn]   = PORTA_IRQHandler,
+    [VECTOR_OFFSET + PORTD_IRQn]   = PORTD_IRQHandler,
+};
+
+/*============================================================================
+ * STATE
+ *============================================================================*/
+
+static bool irq_enabled[NUM_VECTORS];
+static bool irq_pending[NUM_VECTORS];
+static bool irq_masked = false;
+static uint64_t irq_masked_since, irq_masked_max;
+static bool in_isr = false;
+static bool in_timers = false;
+
+/* Dupa reset ceasurile sunt cele din BOARD_BootClockRUN (PEE, 96 MHz PLL) */
+static SimMcg_t mcg = { 96000000U, 96000000U, 0, SIM_SLOW_IRC_HZ };
+static uint32_t core_div = 1;           /* Cicluri SIM_CORE_HZ pe tic de core */
+static uint32_t bus_div = 2;
+static uint32_t tpm_div = 0;            /* 0 = TPMSRC oprit */
+static uint32_t clock_regs_shadow[6];   /* CLKDIV1, SOPT2, SPI0->BR, UART0 BDH/BDL/C4 */
+static bool mcg_changed = true;
+
+static SimWakeFn wake_sink;
+static SimWake_t wake;
+static bool wake_relocking;             /* Iesire din VLPS in PBE, PEE inca nereluat */
+
+static uint32_t systick_ticks = 0;      /* Perioada, in ticuri de core */
+static uint64_t systick_period = 0;
+static uint64_t systick_next = 0;
+static uint32_t systick_owed = 0;       /* Ticuri expirate in timp ce CPU-ul era ocupat (ex: DMA) */
+static uint32_t systick_shadow_load, systick_shadow_val;  /* Ultimele valori publicate */
+
+static uint64_t pit_next[2];
+static bool pit_running[2];
+
+static uint64_t tpm_base[3];
+static uint32_t tpm_shadow_cnt[3];
+static uint64_t tpm_wraps[3];
+static uint32_t tpm_flags[3];           /* Flag-urile reale din STATUS */
+static uint32_t tpm_status_stamp[3];    /* Valoarea lasata in STATUS la ultimul acces */
+static bool tpm_counting[3];            /* CMOD != 0 la ultima actualizare */
+
+/* Pini cu functie de input capture: PTA12 ALT3 = TPM1_CH0 (IR) */
+typedef struct {
+    uint8_t port, pin, mux, tpm, channel;
+} TpmCapturePin_t;
+
+static const TpmCapturePin_t capture_pins[] = {
+    { 0, 12, 3, 1, 0 },
+};
+
+static bool lptmr_running = false;
+static uint64_t lptmr_base;             /* Ultima resetare a numaratorului */
+static uint64_t lptmr_next;             /* Urmatoarea potrivire CNR == CMR */
+
+static bool deep_sleep = false;         /* In VLPS: ceasurile core/bus oprite */
+static SimPowerStats_t power;
+static bool in_vlpr = false;
+static uint64_t vlpr_since;             /* Intrarea in VLPR curenta */
+static uint64_t vlpr_total;             /* Tot timpul in VLPR, inclusiv VLPW si VLPS */
+static uint64_t vlpr_vlps;              /* Din care VLPS */
+
+static uint32_t adc_shadow_sc1 = ADC_SC1_ADCH(31);
+static uint16_t adc_value[32];
+static bool adc_busy = false;
+static uint64_t adc_done;
+static SimAdcStats_t adc_stats;
+
+static SimDacFn dac_sink = NULL;
+static SimSpiFn spi_sink = NULL;
+static SimDmaStartFn dma_start_sink = NULL;
+static bool spi_dma_hold = false;
+
+static uint8_t *flash;                  /* SIM_FLASH_BASE, mapat in SimReset */
+static SimFlashStats_t flash_stats;
+static uint32_t flash_cut_ops;          /* Operatii pana la cadere (0 = niciuna) */
+static bool flash_dead;
+
+static uint32_t spi_byte_cycles = 32;       /* BR = 0: 8 biti la bus/2 = 12 MHz */
+
+static uint64_t uart_byte_cycles = 0;       /* 0 = fara ceas sau SBR = 0 */
+static bool uart_shifting = false;
+static uint8_t uart_shift_byte;
+static uint64_t uart_shift_done;            /* Ultimul bit de stop al octetului din shifter */
+static bool uart_buffered = false;          /* Octet in D, asteapta shifter-ul (TDRE = 0) */
+static uint8_t uart_buffer;
+static SimUartFn uart_sink = NULL;
+static SimUartStats_t uart_stats;
+static uint64_t stop_cycles = 0;
+
+typedef struct SimEvent {
+    uint64_t when;
+    SimEventFn fn;
+    void *arg;
+    struct SimEvent *next;
+} SimEvent_t;
+
+static SimEvent_t *events = NULL;
+
+/*============================================================================
+ * NVIC
+ *============================================================================*/
+
+void Sim_IrqEnable(int32_t irq, bool enable) {
+    irq_enabled[VECTOR_OFFSET + irq] = enable;
+    if (enable) Sim_Sync();
+}
+
+void Sim_IrqPend(int32_t irq) {
+    irq_pending[VECTOR_OFFSET + irq] = true;
+}
+
+void Sim_IrqMaskAll(bool masked) {
+    if (masked && !irq_masked) {
+        irq_masked_since = sim_cycles;
+    } else if (!masked && irq_masked && sim_cycles - irq_masked_since > irq_masked_max) {
+        irq_masked_max = sim_cycles - irq_masked_since;
+    }
+    irq_masked = masked;
+    if (!masked) Sim_Sync();
+}
+
+uint64_t Sim_TakeIrqMaskedMax(void) {
+    uint64_t max = irq_masked_max;
+    irq_masked_max = 0;
+    return max;
+}
+
+void Sim_SysTickConfig(uint32_t ticks) {
+    systick_ticks = ticks;
+    systick_period = (uint64_t)ticks * core_div;
+    systick_next = sim_cycles + systick_period;
+    systick_shadow_load = sim_systick.LOAD;
+    systick_shadow_val = sim_systick.VAL;
+    irq_enabled[VECTOR_OFFSET + SysTick_IRQn] = true;
+}
+
+/*============================================================================
+ * PANEL WIRING (SPI0 + PTC0/3/4)
+ *============================================================================*/
+
+static void SpiShift(uint8_t byte, bool dma) {
+    uint32_t pins = sim_gpio[LCD_PORT].PDOR;
+    if (!(pins & (1U << LCD_CS_PIN))) {
+        Panel_Write(byte, (pins >> LCD_DC_PIN) & 1U);
+        if (spi_sink) spi_sink(byte, (pins >> LCD_DC_PIN) & 1U, dma);
+    }
+    sim_cycles += spi_byte_cycles;
+}
+
+static void GpioChanged(uint8_t port, uint32_t old_pins, uint32_t new_pins) {
+    if (port != LCD_PORT || old_pins == new_pins) return;
+    Panel_Pins((new_pins >> LCD_CS_PIN) & 1U,
+               (new_pins >> LCD_DC_PIN) & 1U,
+               (new_pins >> LCD_RST_PIN) & 1U);
+}
+
+/*============================================================================
+ * TPM FLAGS
+ *============================================================================*/
+
+/* Scrie flag-urile in STATUS cu o stampila noua (alterneaza bitii 30/31) */
+static void TpmPublish(uint8_t i) {
+    uint32_t stamp = (tpm_status_stamp[i] & 0x80000000U) ? 0x40000000U : 0x80000000U;
+    tpm_status_stamp[i] = tpm_flags[i] | stamp;
+    sim_tpm[i].STATUS = tpm_status_stamp[i];
+}
+
+static void TpmClearFlags(uint8_t i, uint32_t mask) {
+    tpm_flags[i] &= ~mask;
+    if (mask & TPM_STATUS_TOF_MASK) sim_tpm[i].SC &= ~TPM_SC_TOF_MASK;
+    for (uint8_t ch = 0; ch < 6; ch++) {
+        if (mask & (1U << ch)) sim_tpm[i].CONTROLS[ch].CnSC &= ~TPM_CnSC_CHF_MASK;
+    }
+}
+
+static void TpmSetFlag(uint8_t i, uint32_t flag, bool irq_enabled) {
+    tpm_flags[i] |= flag;
+    TpmPublish(i);
+    if (irq_enabled) Sim_IrqPend(TPM0_IRQn + i);
+}
+
+/*============================================================================
+ * ADC
+ *============================================================================*/
+
+static bool AdcOnAdack(void) {
+    return (sim_adc0.CFG1 & ADC_CFG1_ADICLK_MASK) == 3U;
+}
+
+/* Durata unei conversii (cu media hardware) pe configuratia curenta */
+static uint64_t AdcConversionCycles(void) {
+    static const uint8_t bct[4] = { 17U, 20U, 20U, 25U };     /* Dupa CFG1[MODE] */
+    uint32_t cfg1 = sim_adc0.CFG1;
+    uint64_t adck;
+
+    switch (cfg1 & ADC_CFG1_ADICLK_MASK) {
+        case 0:  adck = bus_div; break;
+        case 1:  adck = 2U * bus_div; break;
+        case 2:  adck = SIM_CORE_HZ / SIM_XTAL0_HZ; break;
+        default: adck = SIM_CORE_HZ / SIM_ADACK_HZ; break;
+    }
+    adck <<= (cfg1 & ADC_CFG1_ADIV_MASK) >> ADC_CFG1_ADIV_SHIFT;
+
+    uint32_t sample = bct[(cfg1 & ADC_CFG1_MODE_MASK) >> ADC_CFG1_MODE_SHIFT] +
+                      ((cfg1 & ADC_CFG1_ADLSMP_MASK) ? 20U : 0U);
+    uint32_t count = (sim_adc0.SC3 & ADC_SC3_AVGE_MASK) ? (4U << (sim_adc0.SC3 & ADC_SC3_AVGS_MASK)) : 1U;
+    return adck * (5U + count * sample) + 5U * bus_div;
+}
+
+/* Rezultatul conversiei pe canalul din SC1[0] (fara zgomot) */
+static void AdcComplete(void) {
+    uint32_t ch = sim_adc0.SC1[0] & ADC_SC1_ADCH_MASK;
+
+    adc_busy = false;
+    sim_adc0.SC2 &= ~ADC_SC2_ADACT_MASK;
+    if (ch == 31) return;
+
+    *(volatile uint32_t *)&sim_adc0.R[0] = adc_value[ch];
+    sim_adc0.SC1[0] |= ADC_SC1_COCO_MASK;
+    adc_shadow_sc1 = sim_adc0.SC1[0];
+    adc_stats.conversions++;
+    if (sim_adc0.SC1[0] & ADC_SC1_AIEN_MASK) {
+        Sim_IrqPend(ADC0_IRQn);
+    }
+}
+
+/* Porneste (sau reia) o conversie la momentul when */
+static void AdcStart(uint64_t when) {
+    if ((sim_adc0.SC1[0] & ADC_SC1_ADCH_MASK) == 31) {
+        adc_busy = false;
+        sim_adc0.SC2 &= ~ADC_SC2_ADACT_MASK;
+        return;
+    }
+    adc_stats.last_cycles = (uint32_t)AdcConversionCycles();
+    adc_done = when + adc_stats.last_cycles;
+    adc_busy = true;
+    sim_adc0.SC2 |= ADC_SC2_ADACT_MASK;
+}
+
+/* Trigger hardware la when: conversia in curs o termina pe cea veche
+ * daca a ajuns la capat, altfel triggerul se pierde */
+static void AdcTrigger(uint64_t when) {
+    if (adc_busy && adc_done <= when) AdcComplete();
+    if (adc_busy) {
+        adc_stats.triggers_lost++;
+        return;
+    }
+    AdcStart(when);
+}
+
+static void UpdateAdc(void) {
+    if (adc_busy && sim_cycles >= adc_done) AdcComplete();
+}
+
+static uint64_t AdcNextDone(void) {
+    return adc_busy ? adc_done : UINT64_MAX;
+}
+
+/* Triggerul alternativ din SIM_SOPT7: 8 + i = overflow TPMi */
+static bool AdcTriggeredBy(uint8_t tpm) {
+    return (sim_adc0.SC2 & ADC_SC2_ADTRG_MASK) &&
+           (sim_sim.SOPT7 & SIM_SOPT7_ADC0ALTTRGEN_MASK) &&
+           (sim_sim.SOPT7 & SIM_SOPT7_ADC0TRGSEL_MASK) == 8U + tpm;
+}
+
+/*============================================================================
+ * LPTMR (doar LPO, mod timer)
+ *============================================================================*/
+
+static uint64_t LptmrTickCycles(void) {
+    uint32_t psr = sim_lptmr0.PSR;
+    uint64_t tick = SIM_CORE_HZ / SIM_LPO_HZ;
+
+    if (!(psr & LPTMR_PSR_PBYP_MASK)) {
+        tick <<= ((psr & LPTMR_PSR_PRESCALE_MASK) >> LPTMR_PSR_PRESCALE_SHIFT) + 1U;
+    }
+    return tick;
+}
+
+static void UpdateLptmr(void) {
+    if (!lptmr_running) return;
+
+    uint64_t tick = LptmrTickCycles();
+    while (sim_cycles >= lptmr_next) {
+        sim_lptmr0.CSR |= LPTMR_CSR_TCF_MASK;
+        if (sim_lptmr0.CSR & LPTMR_CSR_TIE_MASK) {
+            Sim_IrqPend(LPTMR0_IRQn);
+        }
+        if (sim_lptmr0.CSR & LPTMR_CSR_TFC_MASK) {
+            lptmr_next += 0x10000ULL * tick;
+        } else {
+            /* Fara TFC numaratorul revine la 0 la fiecare potrivire */
+            lptmr_base = lptmr_next;
+            lptmr_next += ((uint64_t)LPTMR_CMR_COMPARE(sim_lptmr0.CMR) + 1) * tick;
+        }
+    }
+    sim_lptmr0.CNR = (uint32_t)(((sim_cycles - lptmr_base) / tick) & LPTMR_CNR_COUNTER_MASK);
+}
+
+/*============================================================================
+ * CLOCKS (MCG + SIM_CLKDIV1 / SIM_SOPT2)
+ *============================================================================*/
+
+static uint32_t ClockDiv(uint32_t hz) {
+    return hz ? SIM_CORE_HZ / hz : 0;
+}
+
+static void ComputeClocks(SimClocks_t *c) {
+    uint32_t clkdiv1 = sim_sim.CLKDIV1;
+    uint32_t sopt2 = sim_sim.SOPT2;
+
+    c->core_hz = mcg.mcgout_hz / (((clkdiv1 & SIM_CLKDIV1_OUTDIV1_MASK) >> SIM_CLKDIV1_OUTDIV1_SHIFT) + 1U);
+    c->bus_hz = c->core_hz / (((clkdiv1 & SIM_CLKDIV1_OUTDIV4_MASK) >> SIM_CLKDIV1_OUTDIV4_SHIFT) + 1U);
+    c->pllfll_hz = (sopt2 & SIM_SOPT2_PLLFLLSEL_MASK) ? mcg.pll_hz / 2U : mcg.fll_hz;
+    c->irc_hz = mcg.irc_hz;
+
+    switch ((sopt2 & SIM_SOPT2_TPMSRC_MASK) >> SIM_SOPT2_TPMSRC_SHIFT) {
+        case 1:  c->tpm_hz = c->pllfll_hz; break;
+        case 2:  c->tpm_hz = SIM_XTAL0_HZ; break;
+        case 3:  c->tpm_hz = c->irc_hz; break;
+        default: c->tpm_hz = 0; break;
+    }
+    switch ((sopt2 & SIM_SOPT2_UART0SRC_MASK) >> SIM_SOPT2_UART0SRC_SHIFT) {
+        case 1:  c->uart0_hz = c->pllfll_hz; break;
+        case 2:  c->uart0_hz = SIM_XTAL0_HZ; break;
+        case 3:  c->uart0_hz = c->irc_hz; break;
+        default: c->uart0_hz = 0; break;
+    }
+}
+
+/* Un termen viitor numarat in ticuri vechi devine acelasi numar de ticuri noi */
+static uint64_t Rescale(uint64_t next, uint32_t old_div, uint32_t new_div) {
+    if (next <= sim_cycles || old_div == 0) return next;
+
+    uint64_t ticks = (next - sim_cycles + old_div - 1U) / old_div;
+    return sim_cycles + ticks * new_div;
+}
+
+static void UpdateTpm(void);
+static void FlushWrites(void);
+static void WakeDone(void);
+
+static void UpdateClocks(void) {
+    uint32_t regs[6] = { sim_sim.CLKDIV1, sim_sim.SOPT2, sim_spi0.BR,
+                         sim_uart0.BDH, sim_uart0.BDL, sim_uart0.C4 };
+    if (!mcg_changed && memcmp(regs, clock_regs_shadow, sizeof(regs)) == 0) return;
+    memcpy(clock_regs_shadow, regs, sizeof(regs));
+    mcg_changed = false;
+
+    SimClocks_t c;
+    ComputeClocks(&c);
+    uint32_t new_core = ClockDiv(c.core_hz);
+    uint32_t new_bus = ClockDiv(c.bus_hz);
+    uint32_t new_tpm = ClockDiv(c.tpm_hz);
+
+    if (new_core != core_div) {
+        systick_next = Rescale(systick_next, core_div, new_core);
+        systick_period = (uint64_t)systick_ticks * new_core;
+        core_div = new_core;
+    }
+    if (new_bus != bus_div) {
+        for (uint8_t ch = 0; ch < 2; ch++) {
+            pit_next[ch] = Rescale(pit_next[ch], bus_div, new_bus);
+        }
+        bus_div = new_bus;
+    }
+    if (new_tpm != tpm_div) {
+        /* CNT ramane pe loc, faza din ticul curent se pierde */
+        UpdateTpm();
+        for (uint8_t i = 0; i < 3; i++) {
+            tpm_base[i] = sim_cycles - (uint64_t)(sim_tpm[i].CNT & 0xFFFFU) * new_tpm;
+            tpm_wraps[i] = 0;
+        }
+        tpm_div = new_tpm;
+    }
+
+    /* SPI0: baud = bus / ((SPPR + 1) * 2^(SPR + 1)) */
+    uint32_t br = sim_spi0.BR;
+    spi_byte_cycles = 8U * (((br & 0x70U) >> SPI_BR_SPPR_SHIFT) + 1U) * (2U << (br & SPI_BR_SPR_MASK)) * bus_div;
+
+    /* UART0: baud = ceas UART0SRC / ((OSR + 1) * SBR); octetul din shifter
+     * isi pastreaza termenul */
+    uint32_t sbr = ((uint32_t)(sim_uart0.BDH & UART0_BDH_SBR_MASK) << 8) | sim_uart0.BDL;
+    uint32_t osr = (sim_uart0.C4 & UART0_C4_OSR_MASK) + 1U;
+    uint64_t uart_div = ClockDiv(c.uart0_hz);
+    uart_byte_cycles = (uint64_t)UART_FRAME_BITS * osr * sbr * uart_div;
+}
+
+/* MCG_S: CLKST dupa sursa lui MCGOUTCLK, LOCK0 cat PLL-ul e pornit */
+static void McgPublish(void) {
+    uint8_t clkst = MCG_S_CLKST_IRC;
+    if (mcg.pll_hz && mcg.mcgout_hz == mcg.pll_hz) {
+        clkst = MCG_S_CLKST_PLL;
+    } else if (mcg.mcgout_hz == SIM_XTAL0_HZ) {
+        clkst = MCG_S_CLKST_EXT;
+    }
+    *(volatile uint8_t *)&sim_mcg.S = (uint8_t)((clkst << MCG_S_CLKST_SHIFT) |
+                                                 (mcg.pll_hz ? MCG_S_LOCK0_MASK : 0U));
+}
+
+void Sim_SetMcg(const SimMcg_t *next) {
+    FlushWrites();
+    if (next->pll_hz && !mcg.pll_hz) {
+        Sim_Advance(SIM_US_TO_CYCLES(SIM_PLL_LOCK_US));
+    }
+    mcg = *next;
+    mcg_changed = true;
+    McgPublish();
+    Sim_Sync();
+
+    if (wake_relocking && mcg.pll_hz && mcg.mcgout_hz == mcg.pll_hz) WakeDone();
+}
+
+void Sim_GetMcg(SimMcg_t *out) {
+    Sim_Sync();
+    *out = mcg;
+}
+
+void Sim_GetClocks(SimClocks_t *out) {
+    Sim_Sync();
+    ComputeClocks(out);
+}
+
+/* PMSTAT urmeaza PMCTRL[RUNM] imediat (RUNM = 10: VLPR) */
+static void UpdateRunMode(void) {
+    bool vlpr = ((sim_smc.PMCTRL & SMC_PMCTRL_RUNM_MASK) >> SMC_PMCTRL_RUNM_SHIFT) == 2U;
+    if (vlpr == in_vlpr) return;
+
+    if (vlpr) {
+        vlpr_since = sim_cycles;
+    } else {
+        vlpr_total += sim_cycles - vlpr_since;
+    }
+    in_vlpr = vlpr;
+    *(volatile uint8_t *)&sim_smc.PMSTAT = vlpr ? SMC_PMSTAT_VLPR : SMC_PMSTAT_RUN;
+}
+
+/*============================================================================
+ * UART0 (doar TX: buffer de un octet + registrul de deplasare)
+ *============================================================================*/
+
+/* S1 si cererea de intrerupere (pe nivel: ramane cat TIE/TCIE si flag-ul) */
+static void UartPublish(void) {
+    uint8_t s1 = 0;
+    if (!uart_buffered) s1 |= UART0_S1_TDRE_MASK;
+    if (!uart_buffered && !uart_shifting) s1 |= UART0_S1_TC_MASK;
+    sim_uart0.S1 = s1;
+
+    if (((sim_uart0.C2 & UART0_C2_TIE_MASK) && (s1 & UART0_S1_TDRE_MASK)) ||
+        ((sim_uart0.C2 & UART0_C2_TCIE_MASK) && (s1 & UART0_S1_TC_MASK))) {
+        Sim_IrqPend(UART0_IRQn);
+    }
+}
+
+static void UartStartShift(uint8_t byte, uint64_t when) {
+    uart_shift_byte = byte;
+    uart_shift_done = when + uart_byte_cycles;
+    uart_shifting = true;
+}
+
+/* Fara ceas (SBR = 0 sau UART0SRC oprit) octetul ramane in shifter */
+static void UartWrite(uint8_t byte) {
+    if (!uart_shifting) {
+        UartStartShift(byte, sim_cycles);
+    } else if (!uart_buffered) {
+        uart_buffer = byte;
+        uart_buffered = true;
+    } else {
+        uart_stats.overruns++;      /* Scris cu TDRE = 0 */
+    }
+    UartPublish();
+}
+
+static void UpdateUart(void) {
+    while (uart_shifting && uart_byte_cycles && sim_cycles >= uart_shift_done) {
+        uart_stats.bytes++;
+        if (uart_sink) uart_sink(uart_shift_byte, uart_shift_done);
+
+        uart_shifting = false;
+        if (uart_buffered) {
+            uart_buffered = false;
+            UartStartShift(uart_buffer, uart_shift_done);
+        }
+    }
+    UartPublish();
+}
+
+static uint64_t UartNextDone(void) {
+    return (uart_shifting && uart_byte_cycles) ? uart_shift_done : UINT64_MAX;
+}
+
+/*============================================================================
+ * PENDING WRITES
+ *============================================================================*/
+
+static void FlushWrites(void) {
+    /* Modul de rulare si ceasurile, inaintea timerelor care depind de ele */
+    UpdateRunMode();
+    UpdateClocks();
+
+    /* SPI: octetul scris in D pleaca pe fir (daca nu e DMA) */
+    if (sim_spi0.D != SPI_D_EMPTY) {
+        uint8_t byte = (uint8_t)sim_spi0.D;
+        sim_spi0.D = SPI_D_EMPTY;
+        SpiShift(byte, false);
+    }
+
+    /* UART0: octetul scris in D intra in shifter sau asteapta in buffer */
+    if (sim_uart0.D != UART_D_EMPTY) {
+        UartWrite((uint8_t)sim_uart0.D);
+        sim_uart0.D = UART_D_EMPTY;
+    }
+
+    /* GPIO: PSOR/PCOR/PTOR -> PDOR */
+    for (uint8_t p = 0; p < 5; p++) {
+        GPIO_Type *g = &sim_gpio[p];
+        if (g->PSOR | g->PCOR | g->PTOR) {
+            uint32_t old_pins = g->PDOR;
+            g->PDOR = ((old_pins | g->PSOR) & ~g->PCOR) ^ g->PTOR;
+            g->PSOR = g->PCOR = g->PTOR = 0;
+            GpioChanged(p, old_pins, g->PDOR);
+        }
+    }
+
+    /* SysTick: orice scriere in VAL il sterge, iar numaratorul reincarca
+     * LOAD-ul de atunci la ciclul urmator. Un LOAD nou conteaza abia de la
+     * urmatoarea reincarcare */
+    if (systick_period) {
+        if (sim_systick.VAL != systick_shadow_val) {
+            systick_next = sim_cycles + (uint64_t)(sim_systick.LOAD + 1U) * core_div;
+            systick_shadow_val = sim_systick.VAL;
+        }
+        if (sim_systick.LOAD != systick_shadow_load) {
+            systick_ticks = sim_systick.LOAD + 1U;
+            systick_period = (uint64_t)systick_ticks * core_div;
+            systick_shadow_load = sim_systick.LOAD;
+        }
+    }
+
+    /* TPM: orice scriere in CNT il reseteaza; scrierile in STATUS sterg
+     * flag-uri. Un TPM care cere DMA numara de la CNT-ul ramas la pornire
+     * (CMOD 0 -> x): cererile se numara per overflow, iar cu baza veche ar
+     * veni toate deodata (pentru TOF si ADC conteaza doar ca a existat) */
+    for (uint8_t i = 0; i < 3; i++) {
+        bool counting = (sim_tpm[i].SC & TPM_SC_CMOD_MASK) != 0;
+        if (sim_tpm[i].CNT != tpm_shadow_cnt[i]) {
+            tpm_base[i] = sim_cycles;
+            tpm_wraps[i] = 0;
+        }
+        if (counting && !tpm_counting[i] && (sim_tpm[i].SC & TPM_SC_DMA_MASK) && tpm_div) {
+            uint64_t div = (uint64_t)tpm_div << (sim_tpm[i].SC & TPM_SC_PS_MASK);
+            tpm_base[i] = sim_cycles - (uint64_t)(sim_tpm[i].CNT & 0xFFFFU) * div;
+            tpm_wraps[i] = 0;
+        }
+        tpm_counting[i] = counting;
+        if (sim_tpm[i].STATUS != tpm_status_stamp[i]) {
+            TpmClearFlags(i, sim_tpm[i].STATUS & ~SIM_TPM_STATUS_STAMP);
+        }
+        TpmPublish(i);
+    }
+
+    /* PIT: pornire canal (TEN 0 -> 1) reincarca LDVAL */
+    for (uint8_t ch = 0; ch < 2; ch++) {
+        bool en = (sim_pit.CHANNEL[ch].TCTRL & PIT_TCTRL_TEN_MASK) != 0;
+        if (en && !pit_running[ch]) {
+            pit_next[ch] = sim_cycles + ((uint64_t)sim_pit.CHANNEL[ch].LDVAL + 1) * bus_div;
+        }
+        pit_running[ch] = en;
+    }
+
+    /* LPTMR: pornirea reseteaza numaratorul, oprirea sterge si TCF */
+    bool lptmr_en = (sim_lptmr0.CSR & LPTMR_CSR_TEN_MASK) != 0;
+    if (lptmr_en && !lptmr_running) {
+        lptmr_base = sim_cycles;
+        lptmr_next = sim_cycles + ((uint64_t)LPTMR_CMR_COMPARE(sim_lptmr0.CMR) + 1) * LptmrTickCycles();
+    } else if (!lptmr_en && lptmr_running) {
+        sim_lptmr0.CSR &= ~LPTMR_CSR_TCF_MASK;
+        sim_lptmr0.CNR = 0;
+    }
+    lptmr_running = lptmr_en;
+
+    /* ADC: o scriere in SC1[0] porneste o conversie (doar cu trigger software) */
+    if (sim_adc0.SC1[0] != adc_shadow_sc1) {
+        adc_shadow_sc1 = sim_adc0.SC1[0];
+        if (!(sim_adc0.SC2 & ADC_SC2_ADTRG_MASK)) {
+            AdcStart(sim_cycles);
+        }
+    }
+}
+
+/*============================================================================
+ * DMA (cererile SPI0 TX/RX si overflow-ul TPM)
+ *============================================================================*/
+
+static uint8_t DmaSource(uint8_t ch) {
+    return sim_dmamux0.CHCFG[ch] & 0x3FU;
+}
+
+static bool DmaArmed(uint8_t ch, uint8_t source) {
+    return (sim_dmamux0.CHCFG[ch] & DMAMUX_CHCFG_ENBL_MASK) &&
+           DmaSource(ch) == source &&
+           (sim_dma0.DMA[ch].DCR & DMA_DCR_ERQ_MASK) &&
+           (sim_dma0.DMA[ch].DSR_BCR & DMA_DSR_BCR_BCR_MASK) != 0;
+}
+
+static void DmaFinish(uint8_t ch, uint32_t count) {
+    uint32_t bcr = sim_dma0.DMA[ch].DSR_BCR & DMA_DSR_BCR_BCR_MASK;
+    bcr = (count >= bcr) ? 0 : bcr - count;
+    sim_dma0.DMA[ch].DSR_BCR = bcr | (bcr == 0 ? DMA_DSR_BCR_DONE_MASK : 0);
+    if (bcr == 0 && (sim_dma0.DMA[ch].DCR & DMA_DCR_EINT_MASK)) {
+        Sim_IrqPend(DMA0_IRQn + ch);
+    }
+}
+
+/* Octeti per transfer (SSIZE: 0 = 32, 1 = 8, 2 = 16 biti) */
+static uint32_t DmaUnitBytes(uint32_t dcr) {
+    static const uint8_t bytes[4] = { 4, 1, 2, 4 };
+    return bytes[(dcr >> DMA_DCR_SSIZE_SHIFT) & 3U];
+}
+
+/* Canalul DMA cerut de overflow-ul TPMi (SC[DMA]), 4 = niciunul */
+static uint8_t DmaTpmChannel(uint8_t tpm) {
+    if (!(sim_tpm[tpm].SC & TPM_SC_DMA_MASK)) return 4;
+    for (uint8_t ch = 0; ch < 4; ch++) {
+        if (DmaArmed(ch, DMAMUX_SRC_TPM0_OVF + tpm)) return ch;
+    }
+    return 4;
+}
+
+/* Cereri pana la BCR = 0 (cel putin una, canalul e armat) */
+static uint32_t DmaRequestsLeft(uint8_t ch) {
+    uint32_t left = (sim_dma0.DMA[ch].DSR_BCR & DMA_DSR_BCR_BCR_MASK) /
+                    DmaUnitBytes(sim_dma0.DMA[ch].DCR);
+    return left ? left : 1U;
+}
+
+/* O cerere de periferic: un transfer SSIZE (DAR fix, SAR cu SINC si SMOD).
+ * Scrierile in DAC0 DAT0 ajung la Sim_SetDacSink cu momentul cererii. */
+static void DmaRequest(uint8_t ch, uint64_t when) {
+    uint32_t dcr = sim_dma0.DMA[ch].DCR;
+    uint32_t unit = DmaUnitBytes(dcr);
+    uint32_t sar = sim_dma0.DMA[ch].SAR;
+    uint32_t dar = sim_dma0.DMA[ch].DAR;
+    uint32_t smod = (dcr >> DMA_DCR_SMOD_SHIFT) & 0xFU;
+    uint32_t size = smod ? (16U << (smod - 1)) : 0;
+    uint32_t value = 0;
+
+    memcpy(&value, (const void *)(uintptr_t)sar, unit);
+    memcpy((void *)(uintptr_t)dar, &value, unit);
+    if (dar == (uint32_t)(uintptr_t)&sim_dac0.DAT[0] && dac_sink &&
+        (sim_dac0.C0 & DAC_C0_DACEN_MASK)) {
+        dac_sink((uint16_t)(value & 0xFFFU), when);
+    }
+
+    if (dcr & DMA_DCR_SINC_MASK) {
+        sar = size ? ((sar & ~(size - 1)) | ((sar + unit) & (size - 1))) : sar + unit;
+        sim_dma0.DMA[ch].SAR = sar;
+    }
+    DmaFinish(ch, unit);
+}
+
+static void RunDma(void) {
+    if (!(sim_spi0.C2 & SPI_C2_TXDMAE_MASK) || spi_dma_hold) return;
+
+    for (uint8_t tx = 0; tx < 4; tx++) {
+        if (!DmaArmed(tx, DMAMUX_SRC_SPI0_TX)) continue;
+        if (dma_start_sink) dma_start_sink(tx);
+
+        uint32_t dcr = sim_dma0.DMA[tx].DCR;
+        uint32_t count = sim_dma0.DMA[tx].DSR_BCR & DMA_DSR_BCR_BCR_MASK;
+        uint32_t sar = sim_dma0.DMA[tx].SAR;
+        uint32_t smod = (dcr >> DMA_DCR_SMOD_SHIFT) & 0xFU;
+        uint32_t size = smod ? (16U << (smod - 1)) : 0;
+
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t addr = sar;
+            if (dcr & DMA_DCR_SINC_MASK) {
+                addr = size ? ((sar & ~(size - 1)) | ((sar + i) & (size - 1))) : sar + i;
+            }
+            SpiShift(*(const uint8_t *)(uintptr_t)addr, true);
+        }
+        sim_dma0.DMA[tx].SAR = (dcr & DMA_DCR_SINC_MASK) && !size ? sar + count : sar;
+        DmaFinish(tx, count);
+
+        /* Canalul RX primeste acelasi numar de octeti */
+        if (sim_spi0.C2 & SPI_C2_RXDMAE_MASK) {
+            for (uint8_t rx = 0; rx < 4; rx++) {
+                if (DmaArmed(rx, DMAMUX_SRC_SPI0_RX)) {
+                    DmaFinish(rx, count);
+                }
+            }
+        }
+    }
+}
+
+/*============================================================================
+ * TIMERS
+ *============================================================================*/
+
+static void UpdateTpm(void) {
+    for (uint8_t i = 0; i < 3; i++) {
+        TPM_Type *t = &sim_tpm[i];
+        if ((t->SC & TPM_SC_CMOD_MASK) && tpm_div) {
+            uint64_t div = (uint64_t)tpm_div << (t->SC & TPM_SC_PS_MASK);
+            uint64_t period = (uint64_t)(t->MOD & 0xFFFFU) + 1;
+            uint64_t ticks = (sim_cycles - tpm_base[i]) / div;
+            t->CNT = (uint32_t)(ticks % period);
+
+            /* Overflow: TOF in SC si STATUS, cate un trigger pentru ADC0
+             * si cate o cerere DMA per overflow, la momentul lui. Cererile
+             * de dupa BCR = 0 se pierd, ca pe placa daca ISR-ul intarzie. */
+            if (ticks / period > tpm_wraps[i]) {
+                uint8_t dma = DmaTpmChannel(i);
+                for (uint64_t w = tpm_wraps[i] + 1; dma < 4 && w <= ticks / period; w++) {
+                    DmaRequest(dma, tpm_base[i] + w * period * div);
+                    dma = DmaTpmChannel(i);
+                }
+                if (AdcTriggeredBy(i)) {
+                    for (uint64_t w = tpm_wraps[i] + 1; w <= ticks / period; w++) {
+                        AdcTrigger(tpm_base[i] + w * period * div);
+                    }
+                }
+                tpm_wraps[i] = ticks / period;
+                t->SC |= TPM_SC_TOF_MASK;
+                TpmSetFlag(i, TPM_STATUS_TOF_MASK, (t->SC & TPM_SC_TOIE_MASK) != 0);
+            }
+        }
+        tpm_shadow_cnt[i] = t->CNT;
+    }
+}
+
+/* Urmatorul overflow care produce o intrerupere, un trigger ADC sau
+ * sfarsitul unui transfer DMA (cererile dinainte nu trezesc CPU-ul) */
+static uint64_t TpmNextWrap(uint8_t i) {
+    TPM_Type *t = &sim_tpm[i];
+    if (!(t->SC & TPM_SC_CMOD_MASK) || !tpm_div) return UINT64_MAX;
+
+    uint8_t dma = DmaTpmChannel(i);
+    uint64_t wraps;
+    if ((t->SC & TPM_SC_TOIE_MASK) || AdcTriggeredBy(i)) {
+        wraps = 1;
+    } else if (dma < 4) {
+        wraps = DmaRequestsLeft(dma);
+    } else {
+        return UINT64_MAX;
+    }
+
+    uint64_t div = (uint64_t)tpm_div << (t->SC & TPM_SC_PS_MASK);
+    uint64_t period = (uint64_t)(t->MOD & 0xFFFFU) + 1;
+    return tpm_base[i] + (tpm_wraps[i] + wraps) * period * div;
+}
+
+static void RunTimers(void) {
+    if (in_timers) return;
+    in_timers = true;
+
+    if (systick_period) {
+        while (sim_cycles >= systick_next) {
+            systick_owed++;
+            Sim_IrqPend(SysTick_IRQn);
+            systick_next += systick_period;
+        }
+        sim_systick.VAL = (uint32_t)((systick_next - sim_cycles + core_div - 1U) / core_div) - 1U;
+        systick_shadow_val = sim_systick.VAL;
+    }
+    if (systick_owed) {
+        sim_scb.ICSR |= SCB_ICSR_PENDSTSET_Msk;
+    } else {
+        sim_scb.ICSR &= ~SCB_ICSR_PENDSTSET_Msk;
+    }
+
+    for (uint8_t ch = 0; ch < 2; ch++) {
+        if (!pit_running[ch]) continue;
+        while (sim_cycles >= pit_next[ch]) {
+            sim_pit.CHANNEL[ch].TFLG |= PIT_TFLG_TIF_MASK;
+            if (sim_pit.CHANNEL[ch].TCTRL & PIT_TCTRL_TIE_MASK) {
+                Sim_IrqPend(PIT_IRQn);
+            }
+            pit_next[ch] += ((uint64_t)sim_pit.CHANNEL[ch].LDVAL + 1) * bus_div;
+        }
+        *(volatile uint32_t *)&sim_pit.CHANNEL[ch].CVAL =
+            (uint32_t)((pit_next[ch] - sim_cycles + bus_div - 1U) / bus_div) - 1U;
+    }
+
+    UpdateLptmr();
+    UpdateUart();
+
+    while (events && events->when <= sim_cycles) {
+        SimEvent_t *e = events;
+        events = e->next;
+        e->fn(e->arg);
+        free(e);
+    }
+
+    UpdateTpm();
+    UpdateAdc();
+    in_timers = false;
+}
+
+/*============================================================================
+ * DISPATCH
+ *============================================================================*/
+
+static int NextPendingVector(void) {
+    for (int v = 0; v < NUM_VECTORS; v++) {
+        if (irq_pending[v] && irq_enabled[v]) return v;
+    }
+    return -1;
+}
+
+static void Dispatch(void) {
+    if (in_isr || irq_masked) return;
+
+    int v;
+    while ((v = NextPendingVector()) >= 0) {
+        irq_pending[v] = false;
+        in_isr = true;
+        if (v == VECTOR_OFFSET + SysTick_IRQn) {
+            /* Pe hardware DMA-ul ruleaza in fundal si SysTick nu pierde
+             * ticuri; aici transferul blocheaza timpul, deci le recuperam */
+            while (systick_owed) {
+                systick_owed--;
+                SysTick_Handler();
+            }
+        } else if (vectors[v]) {
+            vectors[v]();
+        }
+        in_isr = false;
+
+        FlushWrites();
+        RunDma();
+        RunTimers();
+    }
+}
+
+/*============================================================================
+ * CORE
+ *============================================================================*/
+
+void Sim_SetStopTime(uint64_t cycles) {
+    stop_cycles = cycles;
+}
+
+static void CheckStop(void) {
+    static bool finishing = false;
+    if (stop_cycles && sim_cycles >= stop_cycles && !finishing) {
+        finishing = true;
+        FlushWrites();
+        Host_Finish();
+    }
+}
+
+void Sim_Sync(void) {
+    FlushWrites();
+    RunDma();
+    RunTimers();
+    Dispatch();
+    CheckStop();
+}
+
+void* Sim_Touch(void *periph) {
+    Sim_Sync();
+    return periph;
+}
+
+void Sim_Advance(uint64_t cycles) {
+    FlushWrites();
+    sim_cycles += cycles;
+    Sim_Sync();
+}
+
+static bool AnyIrqPending(void) {
+    for (int v = 0; v < NUM_VECTORS; v++) {
+        if (irq_pending[v] && irq_enabled[v]) return true;
+    }
+    return false;
+}
+
+void Sim_Idle(void) {
+    FlushWrites();
+    bool pending = AnyIrqPending();
+    RunDma();
+
+    /* Un transfer DMA pornit abia acum (SPI eliberat) a terminat deja:
+     * intreruperea lui trezeste CPU-ul fara sa treaca timp */
+    if (!pending && AnyIrqPending()) {
+        Sim_Sync();
+        return;
+    }
+
+    uint64_t next = UINT64_MAX;
+    if (systick_period && systick_next < next) next = systick_next;
+    for (uint8_t ch = 0; ch < 2; ch++) {
+        if (pit_running[ch] && pit_next[ch] < next) next = pit_next[ch];
+    }
+    if (lptmr_running && lptmr_next < next) next = lptmr_next;
+    if (UartNextDone() < next) next = UartNextDone();
+    if (AdcNextDone() < next) next = AdcNextDone();
+    if (events && events->when < next) next = events->when;
+    for (uint8_t i = 0; i < 3; i++) {
+        uint64_t wrap = TpmNextWrap(i);
+        if (wrap < next) next = wrap;
+    }
+    if (stop_cycles && stop_cycles < next) next = stop_cycles;
+
+    if (next == UINT64_MAX) {
+        fprintf(stderr, "[SIM] deadlock: no timer or event left at %llu cycles\n",
+                (unsigned long long)sim_cycles);
+        Host_Finish();
+    }
+
+    if (next > sim_cycles) sim_cycles = next;
+    Sim_Sync();
+}
+
+/* VLPS: timerele pe ceasul core/bus stau pe loc cat doarme CPU-ul; la fel
+ * UART0 (PLL-ul e oprit, iar MCGIRCLK nu e pastrat in STOP) si ADC-ul,
+ * daca nu merge pe ADACK */
+static void FreezeCoreClocks(uint64_t cycles) {
+    systick_next += cycles;
+    if (uart_shifting) uart_shift_done += cycles;
+    if (adc_busy && !AdcOnAdack()) adc_done += cycles;
+    for (uint8_t ch = 0; ch < 2; ch++) {
+        pit_next[ch] += cycles;
+    }
+    for (uint8_t i = 0; i < 3; i++) {
+        tpm_base[i] += cycles;
+    }
+}
+
+static void WakeDone(void) {
+    wake.clocked = sim_cycles;
+    wake_relocking = false;
+    if (wake_sink) wake_sink(&wake);
+}
+
+/* PLL-ul pornit din nou la iesirea din VLPS s-a blocat: LOCK0 = 1 */
+static void PllLocked(void *arg) {
+    mcg.pll_hz = (uint32_t)(uintptr_t)arg;
+    mcg_changed = true;
+    McgPublish();
+}
+
+/* STOP din PEE: PLL-ul se opreste, iar MCG iese in PBE (MCGOUTCLK = cristalul)
+ * si reporneste PLL-ul; firmware-ul revine in PEE dupa LOCK0. Din BLPI
+ * (VLPR) iesirea e tot in BLPI */
+static bool StopExitMcg(void) {
+    if (!mcg.pll_hz || mcg.mcgout_hz != mcg.pll_hz) return false;
+
+    uint32_t pll_hz = mcg.pll_hz;
+    mcg.mcgout_hz = SIM_XTAL0_HZ;
+    mcg.pll_hz = 0;
+    mcg_changed = true;
+    McgPublish();
+    power.pll_relocks++;
+    Sim_Schedule(sim_cycles + SIM_US_TO_CYCLES(SIM_PLL_LOCK_US), PllLocked,
+                 (void *)(uintptr_t)pll_hz);
+    return true;
+}
+
+static void DeepSleep(void) {
+    FlushWrites();
+    RunDma();
+    RunTimers();
+
+    if (AnyIrqPending()) {
+        sim_smc.PMCTRL |= SMC_PMCTRL_STOPA_MASK;
+        power.vlps_aborts++;
+        return;
+    }
+    sim_smc.PMCTRL &= ~SMC_PMCTRL_STOPA_MASK;
+
+    uint64_t start = sim_cycles;
+    deep_sleep = true;
+    while (!AnyIrqPending()) {
+        uint64_t next = UINT64_MAX;
+        if (lptmr_running) next = lptmr_next;
+        if (AdcOnAdack() && AdcNextDone() < next) next = AdcNextDone();
+        if (events && events->when < next) next = events->when;
+        if (stop_cycles && stop_cycles < next) next = stop_cycles;
+
+        if (next == UINT64_MAX) {
+            fprintf(stderr, "[SIM] deadlock: VLPS with no wakeup source at %llu cycles\n",
+                    (unsigned long long)sim_cycles);
+            Host_Finish();
+        }
+
+        if (next > sim_cycles) {
+            FreezeCoreClocks(next - sim_cycles);
+            sim_cycles = next;
+        }
+        RunTimers();
+        if (stop_cycles && sim_cycles >= stop_cycles) break;
+    }
+    deep_sleep = false;
+
+    power.vlps_entries++;
+    power.vlps_cycles += sim_cycles - start;
+    if (in_vlpr) vlpr_vlps += sim_cycles - start;
+    wake.event = sim_cycles;
+    bool relock = StopExitMcg();
+
+    /* Iesirea din VLPS consuma timp cu CPU-ul (si timerele) pornite */
+    Sim_Advance(SIM_US_TO_CYCLES(SIM_VLPS_EXIT_US));
+    wake.resumed = sim_cycles;
+    if (relock) {
+        wake_relocking = true;
+    } else {
+        WakeDone();
+    }
+}
+
+void Sim_Wfi(void) {
+    if (sim_scb.SCR & SCB_SCR_SLEEPDEEP_Msk) {
+        DeepSleep();
+        return;
+    }
+
+    uint64_t start = sim_cycles;
+    Sim_Idle();
+    if (in_vlpr) {
+        power.vlpw_cycles += sim_cycles - start;
+    } else {
+        power.wait_cycles += sim_cycles - start;
+    }
+}
+
+void Sim_GetPowerStats(SimPowerStats_t *out) {
+    uint64_t vlpr = vlpr_total + (in_vlpr ? sim_cycles - vlpr_since : 0);
+
+    *out = power;
+    out->vlpr_cycles = vlpr - power.vlpw_cycles - vlpr_vlps;
+}
+
+void Sim_SetWakeSink(SimWakeFn fn) {
+    wake_sink = fn;
+}
+
+uint32_t Sim_EstimateCurrentUa(const SimPowerStats_t *stats, uint64_t total_cycles) {
+    if (total_cycles == 0) return 0;
+
+    uint64_t run = total_cycles - stats->wait_cycles - stats->vlpw_cycles -
+                   stats->vlpr_cycles - stats->vlps_cycles;
+    return (uint32_t)((run * SIM_RUN_UA + stats->wait_cycles * SIM_WAIT_UA +
+                       stats->vlpr_cycles * SIM_VLPR_UA + stats->vlpw_cycles * SIM_VLPW_UA +
+                       stats->vlps_cycles * SIM_VLPS_UA) / total_cycles);
+}
+
+/*============================================================================
+ * EVENTS + INPUTS
+ *============================================================================*/
+
+void Sim_Schedule(uint64_t when, SimEventFn fn, void *arg) {
+    SimEvent_t *e = malloc(sizeof(*e));
+    if (!e) {
+        perror("malloc");
+        exit(1);
+    }
+    e->when = when;
+    e->fn = fn;
+    e->arg = arg;
+
+    SimEvent_t **pp = &events;
+    while (*pp && (*pp)->when <= when) pp = &(*pp)->next;
+    e->next = *pp;
+    *pp = e;
+}
+
+void Sim_SetSpiSink(SimSpiFn fn) {
+    spi_sink = fn;
+}
+
+void Sim_SetDmaStartSink(SimDmaStartFn fn) {
+    dma_start_sink = fn;
+}
+
+void Sim_SetSpiDmaHold(bool hold) {
+    spi_dma_hold = hold;
+}
+
+void Sim_SetDacSink(SimDacFn fn) {
+    dac_sink = fn;
+}
+
+void Sim_GetAdcStats(SimAdcStats_t *out) {
+    Sim_Sync();
+    *out = adc_stats;
+}
+
+void Sim_SetAdc(uint8_t channel, uint16_t value) {
+    adc_value[channel & 31] = value;
+}
+
+/* Input capture: CnV primeste CNT-ul de la front, daca ELSA/ELSB il cer */
+static void TpmCapture(uint8_t i, uint8_t ch, bool rising) {
+    TPM_Type *t = &sim_tpm[i];
+    uint32_t cnsc = t->CONTROLS[ch].CnSC;
+
+    if (deep_sleep || !tpm_div) return;     /* Ceasul TPM e oprit (VLPS sau TPMSRC = 0) */
+    if (!(t->SC & TPM_SC_CMOD_MASK) || (cnsc & (TPM_CnSC_MSA_MASK | TPM_CnSC_MSB_MASK))) return;
+    if (!(cnsc & (rising ? TPM_CnSC_ELSA_MASK : TPM_CnSC_ELSB_MASK))) return;
+
+    UpdateTpm();
+    t->CONTROLS[ch].CnV = t->CNT;
+    t->CONTROLS[ch].CnSC |= TPM_CnSC_CHF_MASK;
+    TpmSetFlag(i, 1U << ch, (cnsc & TPM_CnSC_CHIE_MASK) != 0);
+}
+
+void Sim_PinEdge(uint8_t port, uint8_t pin, bool level) {
+    GPIO_Type *g = &sim_gpio[port];
+    uint32_t mask = 1U << pin;
+    bool old_level = (g->PDIR & mask) != 0;
+    if (old_level == level) return;
+
+    *(volatile uint32_t *)&g->PDIR = level ? (g->PDIR | mask) : (g->PDIR & ~mask);
+
+    uint32_t mux = (sim_port[port].PCR[pin] & PORT_PCR_MUX_MASK) >> PORT_PCR_MUX_SHIFT;
+    for (uint8_t i = 0; i < sizeof(capture_pins) / sizeof(capture_pins[0]); i++) {
+        const TpmCapturePin_t *c = &capture_pins[i];
+        if (c->port == port && c->pin == pin && c->mux == mux) {
+            TpmCapture(c->tpm, c->channel, level);
+        }
+    }
+
+    /* Intreruperea de pin (IRQC) merge pe orice functie digitala a pinului */
+    uint32_t irqc = (sim_port[port].PCR[pin] & PORT_PCR_IRQC_MASK) >> PORT_PCR_IRQC_SHIFT;
+    bool fire = (irqc == 0x9 && level) || (irqc == 0xA && !level) || irqc == 0xB ||
+                (irqc == 0x8 && !level) || (irqc == 0xC && level);
+    if (!fire) return;
+
+    sim_port[port].ISFR |= mask;
+    if (port == 0) Sim_IrqPend(PORTA_IRQn);
+    if (port == 3) Sim_IrqPend(PORTD_IRQn);
+}
+
+uint32_t Sim_SpiByteCycles(void) {
+    return spi_byte_cycles;
+}
+
+void Sim_SetUartSink(SimUartFn fn) {
+    uart_sink = fn;
+}
+
+uint64_t Sim_UartByteCycles(void) {
+    Sim_Sync();
+    return uart_byte_cycles;
+}
+
+void Sim_GetUartStats(SimUartStats_t *out) {
+    *out = uart_stats;
+}
+
+/*============================================================================
+ * FLASH
+ *============================================================================*/
+
+static bool FlashInRange(uint32_t addr, uint32_t len) {
+    return addr >= SIM_FLASH_BASE && len <= SIM_FLASH_SIZE &&
+           addr - SIM_FLASH_BASE <= SIM_FLASH_SIZE - len;
+}
+
+/* true daca operatia curenta e cea la care cade tensiunea */
+static bool FlashCutNow(void) {
+    if (flash_cut_ops == 0) return false;
+    if (--flash_cut_ops == 0) {
+        flash_dead = true;
+        return true;
+    }
+    return false;
+}
+
+/* Comanda FTFA: CPU-ul asteapta (codul ruleaza din RAM). Cu PRIMASK setat,
+ * ticurile SysTick expirate intre timp se contopesc intr-unul singur in
+ * asteptare, ca pe placa (systick_owed recupereaza doar timpul blocat de DMA) */
+static void FlashBusy(uint64_t cycles) {
+    uint32_t owed = systick_owed;
+
+    flash_stats.busy_cycles += cycles;
+    Sim_Advance(cycles);
+    if (irq_masked && systick_owed > owed) {
+        systick_owed = owed ? owed : 1U;
+    }
+}
+
+/* FTFA refuza comenzile in VLPR (ACCERR) */
+bool Sim_FlashErase(uint32_t addr, uint32_t len) {
+    if (flash_dead || in_vlpr || !FlashInRange(addr, len)) return false;
+
+    for (uint32_t a = addr; a < addr + len; a += SIM_FLASH_SECTOR) {
+        uint8_t *sector = &flash[(a - SIM_FLASH_BASE) & ~(SIM_FLASH_SECTOR - 1U)];
+
+        if (FlashCutNow()) {
+            /* Stergere intrerupta: doar prima jumatate a ajuns la 0xFF */
+            memset(sector, 0xFF, SIM_FLASH_SECTOR / 2U);
+            return false;
+        }
+        memset(sector, 0xFF, SIM_FLASH_SECTOR);
+        flash_stats.erases[(a - SIM_FLASH_BASE) / SIM_FLASH_SECTOR]++;
+        FlashBusy(SIM_US_TO_CYCLES(SIM_FLASH_ERASE_US));
+    }
+    return true;
+}
+
+bool Sim_FlashProgram(uint32_t addr, const uint32_t *src, uint32_t len) {
+    if (flash_dead || in_vlpr || !FlashInRange(addr, len)) return false;
+
+    for (uint32_t i = 0; i < len / 4U; i++) {
+        uint32_t word;
+        uint32_t value = src[i];
+        uint8_t *dst = &flash[addr - SIM_FLASH_BASE + i * 4U];
+
+        memcpy(&word, dst, 4);
+        if (FlashCutNow()) {
+            /* Scriere intrerupta: doar jumatatea de jos a cuvantului */
+            word &= value | 0xFFFF0000U;
+            memcpy(dst, &word, 4);
+            return false;
+        }
+        if (word != 0xFFFFFFFFU) flash_stats.overwrites++;
+        word &= value;
+        memcpy(dst, &word, 4);
+        flash_stats.words++;
+        FlashBusy(SIM_US_TO_CYCLES(SIM_FLASH_PGM4_US));
+    }
+    return true;
+}
+
+void Sim_FlashPowerCut(uint32_t ops) {
+    flash_cut_ops = ops;
+    flash_dead = false;
+}
+
+void Sim_FlashWipe(void) {
+    memset(flash, 0xFF, SIM_FLASH_SIZE);
+    memset(&flash_stats, 0, sizeof(flash_stats));
+    flash_cut_ops = 0;
+    flash_dead = false;
+}
+
+void Sim_GetFlashStats(SimFlashStats_t *out) {
+    *out = flash_stats;
+}
+
+/*============================================================================
+ * RESET STATE
+ *============================================================================*/
+
+__attribute__((constructor))
+static void SimReset(void) {
+    for (uint8_t p = 0; p < 5; p++) {
+        *(volatile uint32_t *)&sim_gpio[p].PDIR = 0xFFFFFFFFU;    /* Pull-up-uri */
+    }
+    sim_adc0.SC1[0] = ADC_SC1_ADCH(31);
+    for (uint8_t ch = 0; ch < 32; ch++) {
+        adc_value[ch] = 2048;       /* Joystick centrat */
+    }
+
+    /* Executabilul e legat fara PIE: adresele mici sunt libere */
+    flash = mmap((void *)(uintptr_t)SIM_FLASH_BASE, SIM_FLASH_SIZE, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+    if (flash != (uint8_t *)(uintptr_t)SIM_FLASH_BASE) {
+        fprintf(stderr, "[SIM] cannot map flash at 0x%05X\n", SIM_FLASH_BASE);
+        exit(1);
+    }
+    Sim_FlashWipe();
+}
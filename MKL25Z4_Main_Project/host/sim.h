@@ -0,0 +1,349 @@
+/*
+ * sim.h
+ * MCU virtual pentru build-ul host: timp in cicluri, NVIC, SysTick si
+ * perifericele atinse de firmware (SPI0, GPIO, PORT, DMA, TPM, PIT, ADC0,
+ * DAC0, LPTMR0, SMC, MCG/SIM, FTFA, UART0 TX)
+ *
+ * Registrele sunt structuri obisnuite in RAM. Fiecare acces prin macro-urile
+ * din shim/MKL25Z4.h (SPI0, GPIOC, TPM1...) trece intai prin Sim_Touch, care
+ * proceseaza scrierea anterioara (octet SPI, set/clear GPIO, start DMA),
+ * avanseaza timerele si livreaza intreruperile in asteptare. Astfel codul
+ * din source/ ruleaza nemodificat, iar rezultatul e determinist.
+ */
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================
+ * CLOCKS
+ *============================================================================*/
+
+/* Unitatea de timp a simularii: ceasul core in RUN (BOARD_BootClockRUN).
+ * Ceasurile reale (core, bus, TPM) sunt derivate din MCG si SIM_CLKDIV1 /
+ * SIM_SOPT2 si trebuie sa divida exact SIM_CORE_HZ. */
+#define SIM_CORE_HZ         48000000U
+#define SIM_LPO_HZ          1000U       /* Ceasul LPTMR0 (PCS = 1) */
+#define SIM_XTAL0_HZ        8000000U
+#define SIM_FAST_IRC_HZ     4000000U
+#define SIM_SLOW_IRC_HZ     32768U
+#define SIM_ADACK_HZ        4000000U    /* ADACK tipic, ADLPC = ADHSC = 0 */
+
+/* Relock-ul PLL la intrarea in PEE (t_pll_lock din datasheet, cu marja) */
+#define SIM_PLL_LOCK_US     420U
+
+/* Iesirea din VLPS pana la prima instructiune (ordinul de marime din
+ * datasheet pentru VLPS -> RUN; timp in care CPU-ul e considerat activ) */
+#define SIM_VLPS_EXIT_US    5U
+
+#define SIM_MS_TO_CYCLES(ms)    ((uint64_t)(ms) * (SIM_CORE_HZ / 1000U))
+#define SIM_US_TO_CYCLES(us)    ((uint64_t)(us) * (SIM_CORE_HZ / 1000000U))
+
+/* Timpul virtual curent, in cicluri de core */
+extern uint64_t sim_cycles;
+
+/*============================================================================
+ * CORE
+ *============================================================================*/
+
+/**
+ * Apelat inaintea fiecarui acces la registre: proceseaza scrierea
+ * precedenta, timerele ajunse la termen si intreruperile in asteptare
+ * @return periph (pentru folosirea in macro-urile de registre)
+ */
+void* Sim_Touch(void *periph);
+
+/**
+ * Acelasi lucru ca Sim_Touch, fara periferic (ex: dupa EnableIRQ)
+ */
+void Sim_Sync(void);
+
+/**
+ * __WFI / __NOP: sare direct la urmatorul eveniment programat
+ */
+void Sim_Idle(void);
+
+/**
+ * __WFI: WAIT (ca Sim_Idle) sau, cu SCB->SCR[SLEEPDEEP], VLPS - ceasurile
+ * core/bus se opresc (SysTick, PIT, TPM ingheata, DMA si capturile TPM nu
+ * mai merg), raman LPTMR0, ADC-ul (ADACK) si intreruperile de pin.
+ * Iese la prima intrerupere activata in asteptare, chiar cu PRIMASK setat.
+ */
+void Sim_Wfi(void);
+
+/**
+ * Consuma timp (ex: octeti SPI pe fir)
+ */
+void Sim_Advance(uint64_t cycles);
+
+/**
+ * Timpul virtual la care simularea se opreste (0 = niciodata)
+ */
+void Sim_SetStopTime(uint64_t cycles);
+
+/**
+ * Apelat o singura data cand timpul atinge limita; trebuie sa nu revina
+ * (host main scrie rezultatele si iese)
+ */
+extern void Host_Finish(void);
+
+/*============================================================================
+ * NVIC + SYSTICK
+ *============================================================================*/
+
+void Sim_IrqEnable(int32_t irq, bool enable);
+void Sim_IrqPend(int32_t irq);
+void Sim_IrqMaskAll(bool masked);
+
+/**
+ * Cel mai lung interval cu intreruperile oprite (__disable_irq pana la
+ * __enable_irq) de la apelul anterior, in cicluri; apoi reporneste de la 0
+ */
+uint64_t Sim_TakeIrqMaskedMax(void);
+void Sim_SysTickConfig(uint32_t ticks);
+
+/*============================================================================
+ * CLOCKS
+ *============================================================================*/
+
+/* Iesirile MCG (0 = oprit); scrise de CLOCK_SetMcgConfig din shim */
+typedef struct {
+    uint32_t mcgout_hz;     /* MCGOUTCLK, inainte de OUTDIV1 */
+    uint32_t pll_hz;        /* MCGPLLCLK */
+    uint32_t fll_hz;        /* MCGFLLCLK */
+    uint32_t irc_hz;        /* MCGIRCLK */
+} SimMcg_t;
+
+/* Ceasurile vazute de periferice */
+typedef struct {
+    uint32_t core_hz;       /* MCGOUTCLK / (OUTDIV1 + 1) */
+    uint32_t bus_hz;        /* core / (OUTDIV4 + 1): SPI0, PIT */
+    uint32_t pllfll_hz;     /* MCGPLLCLK/2 sau MCGFLLCLK (SOPT2[PLLFLLSEL]) */
+    uint32_t irc_hz;        /* MCGIRCLK */
+    uint32_t tpm_hz;        /* SOPT2[TPMSRC]: 0 = oprit, 1 = PLLFLL, 3 = IRC */
+    uint32_t uart0_hz;      /* SOPT2[UART0SRC], aceleasi surse */
+} SimClocks_t;
+
+/**
+ * Schimba iesirile MCG; la pornirea PLL-ului timpul avanseaza cu
+ * SIM_PLL_LOCK_US (pe ceasurile vechi). SysTick, PIT si TPM sunt
+ * rebazate: isi pastreaza valoarea, numara mai departe cu noul ceas.
+ */
+void Sim_SetMcg(const SimMcg_t *mcg);
+
+/**
+ * Iesirile MCG curente (in PBE, cat PLL-ul se reblocheaza, pll_hz = 0)
+ */
+void Sim_GetMcg(SimMcg_t *out);
+
+/**
+ * Ceasurile curente (si dupa scrieri in SIM_CLKDIV1 / SIM_SOPT2)
+ */
+void Sim_GetClocks(SimClocks_t *out);
+
+/*============================================================================
+ * EVENTS (injectate de trace / harness)
+ *============================================================================*/
+
+typedef void (*SimEventFn)(void *arg);
+
+/**
+ * Programeaza un apel unic la momentul when (cicluri absolute)
+ * Evenimentele cu acelasi moment ruleaza in ordinea programarii
+ */
+void Sim_Schedule(uint64_t when, SimEventFn fn, void *arg);
+
+/*============================================================================
+ * PERIPHERAL INPUTS / OUTPUTS
+ *============================================================================*/
+
+/**
+ * Seteaza valoarea returnata de ADC0 pe un canal (12 biti)
+ */
+void Sim_SetAdc(uint8_t channel, uint16_t value);
+
+/* ADC0: o conversie dureaza 5 ADCK + 5 cicli de bus, plus, pentru fiecare
+ * esantion din media hardware, 17/20/25 ADCK (8, 10-12, 16 biti) si 20 ADCK
+ * cu ADLSMP. ADCK = CFG1[ADICLK] / 2^ADIV. Pe ADACK merge si in VLPS. Un
+ * trigger hardware venit in timpul unei conversii se pierde, ca pe placa;
+ * o scriere in SC1[0] o reia de la capat. */
+typedef struct {
+    uint32_t conversions;       /* Terminate (COCO) */
+    uint32_t triggers_lost;     /* Triggere hardware cu ADC-ul ocupat */
+    uint32_t last_cycles;       /* Durata ultimei conversii, cicluri SIM_CORE_HZ */
+} SimAdcStats_t;
+
+void Sim_GetAdcStats(SimAdcStats_t *out);
+
+/**
+ * Front pe un pin de intrare: actualizeaza PDIR si, daca PCR[IRQC]
+ * cere acel front, seteaza ISFR si ridica intreruperea portului
+ * @param port 0 = PORTA ... 4 = PORTE
+ */
+void Sim_PinEdge(uint8_t port, uint8_t pin, bool level);
+
+/* Un esantion scris de DMA in DAC0 DAT0 (12 biti), la momentul cererii */
+typedef void (*SimDacFn)(uint16_t value, uint64_t when);
+
+/**
+ * Primeste iesirea DAC0 (NULL = nimic); doar scrierile DMA, cu DAC-ul pornit
+ */
+void Sim_SetDacSink(SimDacFn fn);
+
+/**
+ * Cicluri SIM_CORE_HZ pe octet SPI la viteza curenta (SPI0->BR si bus)
+ */
+uint32_t Sim_SpiByteCycles(void);
+
+/* Un octet shiftat pe SPI0 cu CS activ (ce vede panoul), din D sau prin DMA */
+typedef void (*SimSpiFn)(uint8_t byte, bool dc, bool dma);
+
+/* Un transfer SPI0 TX prin DMA, inainte de primul octet: registrele
+ * canalului (si ale canalului RX) se citesc direct din sim_dma0 */
+typedef void (*SimDmaStartFn)(uint8_t tx_ch);
+
+/**
+ * Primeste octetii de pe SPI0 / pornirea transferurilor DMA (NULL = nimic)
+ */
+void Sim_SetSpiSink(SimSpiFn fn);
+void Sim_SetDmaStartSink(SimDmaStartFn fn);
+
+/**
+ * Tine cererile DMA ale SPI0 in asteptare (ca un SPI foarte lent): canalul
+ * armat nu transfera nimic pana la eliberare. Pentru testele cozii DMA.
+ */
+void Sim_SetSpiDmaHold(bool hold);
+
+/*============================================================================
+ * UART0 (consola)
+ * Doar emisia: un octet in D asteapta cat timp shifter-ul trimite altul
+ * (TDRE = 0), TC = 1 cand amandoua sunt goale. Un octet dureaza 10 biti
+ * la baud-ul din BDH/BDL/C4 si ceasul SOPT2[UART0SRC]; in VLPS sta pe loc.
+ * TIE/TCIE cer intreruperea cat timp flag-ul e setat. PRINTF nu trece pe
+ * aici (Host_Printf scrie direct), doar ce scrie firmware-ul in UART0->D.
+ *============================================================================*/
+
+/* Un octet iesit de pe fir (la bitul de stop) */
+typedef void (*SimUartFn)(uint8_t byte, uint64_t when);
+
+typedef struct {
+    uint32_t bytes;             /* Octeti trimisi */
+    uint32_t overruns;          /* Scrieri in D cu TDRE = 0 (pierdute) */
+} SimUartStats_t;
+
+/**
+ * Primeste octetii trimisi pe UART0 (NULL = nimic)
+ */
+void Sim_SetUartSink(SimUartFn fn);
+
+/**
+ * Cicluri SIM_CORE_HZ pe octet la baud-ul curent (0 = UART fara ceas)
+ */
+uint64_t Sim_UartByteCycles(void);
+
+void Sim_GetUartStats(SimUartStats_t *out);
+
+/*============================================================================
+ * FLASH (FTFA)
+ * Doar zona din kv_store: SIM_FLASH_SIZE octeti mapati chiar la adresa de
+ * pe placa, ca firmware-ul sa citeasca direct. Stergerea pune 0xFF, scrierea
+ * poate doar sa stearga biti (AND), ca pe flash-ul real; in VLPR comenzile
+ * esueaza, ca pe FTFA.
+ *============================================================================*/
+
+#define SIM_FLASH_BASE      0x0001F000U
+#define SIM_FLASH_SIZE      0x1000U
+#define SIM_FLASH_SECTOR    1024U
+#define SIM_FLASH_SECTORS   (SIM_FLASH_SIZE / SIM_FLASH_SECTOR)
+
+/* Valorile tipice din datasheet-ul KL25 (t_ersscr, t_pgm4) */
+#define SIM_FLASH_ERASE_US  14000U
+#define SIM_FLASH_PGM4_US   65U
+
+typedef struct {
+    uint32_t erases[SIM_FLASH_SECTORS];
+    uint32_t words;             /* Cuvinte programate */
+    uint32_t overwrites;        /* ... peste un cuvant care nu era sters */
+    uint64_t busy_cycles;       /* Timpul petrecut in comenzi */
+} SimFlashStats_t;
+
+/**
+ * Sterge sectoarele din [addr, addr + len); timpul avanseaza cu
+ * SIM_FLASH_ERASE_US per sector
+ * @return false in afara zonei, in VLPR sau dupa o cadere de tensiune
+ */
+bool Sim_FlashErase(uint32_t addr, uint32_t len);
+
+/**
+ * Programeaza cuvinte de 32 de biti, SIM_FLASH_PGM4_US fiecare
+ */
+bool Sim_FlashProgram(uint32_t addr, const uint32_t *src, uint32_t len);
+
+/**
+ * Cadere de tensiune dupa ops operatii (cuvinte programate sau sectoare
+ * sterse; 0 = dezarmat): ultima e lasata pe jumatate, iar comenzile
+ * urmatoare esueaza pana la urmatorul apel
+ */
+void Sim_FlashPowerCut(uint32_t ops);
+
+/**
+ * Toata zona stearsa (0xFF) si contoarele la zero
+ */
+void Sim_FlashWipe(void);
+
+void Sim_GetFlashStats(SimFlashStats_t *out);
+
+/*============================================================================
+ * POWER
+ *============================================================================*/
+
+/* Curent tipic MCU (fara placa, display, LED-uri) din datasheet-ul KL25:
+ * RUN/WAIT la 48 MHz core, VLPR/VLPW la 4 MHz core, 0.8 MHz bus - doar
+ * pentru estimari relative intre politici */
+#define SIM_RUN_UA          6100U
+#define SIM_WAIT_UA         3700U
+#define SIM_VLPR_UA         250U
+#define SIM_VLPW_UA         140U
+#define SIM_VLPS_UA         2U
+
+typedef struct {
+    uint64_t wait_cycles;       /* __WFI fara SLEEPDEEP, din RUN */
+    uint64_t vlpw_cycles;       /* __WFI fara SLEEPDEEP, din VLPR */
+    uint64_t vlpr_cycles;       /* Treaz in VLPR (PMSTAT = VLPR) */
+    uint64_t vlps_cycles;       /* __WFI cu SLEEPDEEP (fara iesirea din VLPS) */
+    uint32_t vlps_entries;
+    uint32_t vlps_aborts;       /* Intrerupere deja in asteptare la intrare */
+    uint32_t pll_relocks;       /* Iesiri din VLPS intrat din PEE (MCG in PBE) */
+} SimPowerStats_t;
+
+/**
+ * Timpul petrecut in fiecare mod; restul (sim_cycles minus toate
+ * celelalte) e RUN, inclusiv asteptarile active cu __NOP
+ */
+void Sim_GetPowerStats(SimPowerStats_t *out);
+
+/**
+ * Curentul mediu estimat (uA) pe total_cycles, cu RUN = restul
+ */
+uint32_t Sim_EstimateCurrentUa(const SimPowerStats_t *stats, uint64_t total_cycles);
+
+/* O iesire din VLPS, in cicluri: intreruperea care a trezit CPU-ul, revenirea
+ * din SMC_SetPowerModeVlps (dupa SIM_VLPS_EXIT_US) si trecerea inapoi in PEE
+ * dupa relock (= resumed daca VLPS a fost intrat din VLPR) */
+typedef struct {
+    uint64_t event;
+    uint64_t resumed;
+    uint64_t clocked;
+} SimWake_t;
+
+typedef void (*SimWakeFn)(const SimWake_t *wake);
+
+/**
+ * Primeste fiecare iesire din VLPS, cand CPU-ul e din nou pe ceasul de
+ * dinainte (NULL = nimic)
+ */
+void Sim_SetWakeSink(SimWakeFn fn);
+
+#endif /* SIM_H */
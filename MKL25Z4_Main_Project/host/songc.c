@@ -0,0 +1,432 @@
+/*
+ * songc.c
+ * Compilatorul de melodii: songs/<nume>.song -> tablouri de octeti (song.h)
+ *
+ * Sintaxa, cuvinte separate prin spatii, '#' = comentariu pana la capat:
+ *   tempo 50       durata unui tic, in ms (1..255)
+ *   C5/4  F#4  Bb3 nota, optional /tici (1..255); fara /tici = durata
+ *                  notei precedente (in ordinea din text)
+ *   r/2            pauza
+ *   [3 ... ]       corpul se canta de 3 ori
+ *
+ * Frecventele sunt temperate (A4 = 440 Hz) si ajung in blob ca perioade
+ * la SONG_TONE_HZ. Fiecare blob e decodat inapoi cu song.c (player-ul din
+ * firmware) si comparat cu lista de note asteptata.
+ *
+ * Utilizare:
+ *   ./songc -c songs.c -H songs.h fisier.song...   - genereaza sursele
+ *   ./songc fisier.song...                          - doar statistici
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <unistd.h>
+#include <math.h>
+#include "../source/drivers/headers/song.h"
+
+/*============================================================================
+ * LIMITS
+ *============================================================================*/
+
+#define MAX_ITEMS           1024
+#define MAX_BLOB            2048
+#define MAX_NOTES           8192
+#define MAX_SONGS           32
+
+/* Proiectul de test: char notes[] + int duration[] */
+#define ARRAYS_BYTES_PER_NOTE   (sizeof(char) + sizeof(int))
+
+typedef enum { IT_NOTE, IT_TEMPO, IT_LOOP, IT_ENDLOOP } ItemType_t;
+
+typedef struct {
+    ItemType_t type;
+    uint16_t period;        /* 0 = pauza */
+    uint8_t ticks;          /* Durata rezolvata (ordinea din text) */
+    uint8_t arg;            /* tempo / repetari */
+} Item_t;
+
+typedef struct {
+    char name[64];
+    Item_t items[MAX_ITEMS];
+    uint32_t count;
+    uint8_t tempo;
+    uint8_t blob[MAX_BLOB];
+    uint32_t size;
+    uint32_t notes;         /* Note cantate, cu buclele desfasurate */
+} Song_t;
+
+static Song_t songs[MAX_SONGS];
+
+/*============================================================================
+ * PARSER
+ *============================================================================*/
+
+/* "C#4", "Bb3" -> perioada la SONG_TONE_HZ; 0 = nota invalida */
+static uint32_t NotePeriod(const char *s) {
+    static const int8_t semis[7] = { 9, 11, 0, 2, 4, 5, 7 };   /* A..G fata de C */
+    char letter = (char)toupper((unsigned char)s[0]);
+
+    if (letter < 'A' || letter > 'G') return 0;
+    int semi = semis[letter - 'A'];
+    s++;
+    if (*s == '#') { semi++; s++; }
+    else if (*s == 'b') { semi--; s++; }
+    if (!isdigit((unsigned char)*s) || s[1] != '\0') return 0;
+
+    int midi = 12 * (*s - '0' + 1) + semi;
+    double hz = 440.0 * pow(2.0, (midi - 69) / 12.0);
+    return (uint32_t)lround(SONG_TONE_HZ / hz);
+}
+
+static bool ParseByte(const char *s, uint8_t *out) {
+    char *end;
+    long v = strtol(s, &end, 10);
+    if (*s == '\0' || *end != '\0' || v < 1 || v > 255) return false;
+    *out = (uint8_t)v;
+    return true;
+}
+
+static bool Parse(const char *path, Song_t *song) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        return false;
+    }
+
+    const char *base = strrchr(path, '/');
+    base = base ? base + 1 : path;
+    snprintf(song->name, sizeof(song->name), "%.*s", (int)strcspn(base, "."), base);
+    song->count = 0;
+    song->tempo = 0;
+
+    char line[512];
+    unsigned line_no = 0;
+    uint8_t prev_ticks = 1;
+    uint32_t depth = 0;
+    bool ok = true;
+
+    while (ok && fgets(line, sizeof(line), f)) {
+        line_no++;
+        char *hash = strchr(line, '#');
+        if (hash) *hash = '\0';
+
+        for (char *tok = strtok(line, " \t\r\n"); tok && ok; tok = strtok(NULL, " \t\r\n")) {
+            if (song->count >= MAX_ITEMS) {
+                fprintf(stderr, "%s:%u: too many items\n", path, line_no);
+                ok = false;
+                break;
+            }
+            Item_t *it = &song->items[song->count];
+
+            if (strcmp(tok, "tempo") == 0) {
+                char *arg = strtok(NULL, " \t\r\n");
+                if (!arg || !ParseByte(arg, &it->arg)) {
+                    fprintf(stderr, "%s:%u: tempo needs 1..255 ms\n", path, line_no);
+                    ok = false;
+                    break;
+                }
+                it->type = IT_TEMPO;
+                if (song->tempo == 0 && song->count == 0) {
+                    song->tempo = it->arg;      /* Tempo-ul de inceput intra in antet */
+                    continue;
+                }
+            } else if (tok[0] == '[') {
+                if (!ParseByte(tok + 1, &it->arg) || ++depth > SONG_MAX_LOOPS) {
+                    fprintf(stderr, "%s:%u: bad loop '%s' (1..255, depth %u)\n", path, line_no,
+                            tok, (unsigned)SONG_MAX_LOOPS);
+                    ok = false;
+                    break;
+                }
+                it->type = IT_LOOP;
+            } else if (strcmp(tok, "]") == 0) {
+                if (depth == 0 || song->items[song->count - 1].type == IT_LOOP) {
+                    fprintf(stderr, "%s:%u: unmatched or empty loop\n", path, line_no);
+                    ok = false;
+                    break;
+                }
+                depth--;
+                it->type = IT_ENDLOOP;
+            } else {
+                char *slash = strchr(tok, '/');
+                if (slash) {
+                    *slash = '\0';
+                    if (!ParseByte(slash + 1, &prev_ticks)) {
+                        fprintf(stderr, "%s:%u: bad duration '%s'\n", path, line_no, slash + 1);
+                        ok = false;
+                        break;
+                    }
+                }
+                uint32_t period = (strcmp(tok, "r") == 0) ? 0 : NotePeriod(tok);
+                if (strcmp(tok, "r") != 0 && (period < 2 || period > 0xFFFFU)) {
+                    fprintf(stderr, "%s:%u: bad or out of range note '%s'\n", path, line_no, tok);
+                    ok = false;
+                    break;
+                }
+                it->type = IT_NOTE;
+                it->period = (uint16_t)period;
+                it->ticks = prev_ticks;
+            }
+            song->count++;
+        }
+    }
+    fclose(f);
+
+    if (ok && depth != 0) {
+        fprintf(stderr, "%s: unterminated loop\n", path);
+        ok = false;
+    }
+    if (song->tempo == 0) song->tempo = 1;
+    return ok;
+}
+
+/*============================================================================
+ * ENCODER
+ *============================================================================*/
+
+static bool Emit(Song_t *song, uint8_t byte) {
+    if (song->size >= MAX_BLOB) return false;
+    song->blob[song->size++] = byte;
+    return true;
+}
+
+/* 0 daca ticks nu e o putere a lui 2 reprezentabila in D */
+static uint8_t DurCode(uint8_t ticks) {
+    for (uint8_t d = 1; d <= SONG_DUR_MAX_CODE; d++) {
+        if (ticks == (1U << (d - 1U))) return d;
+    }
+    return 0;
+}
+
+static bool Encode(const char *path, Song_t *song) {
+    uint16_t pitches[SONG_MAX_PITCHES];
+    uint8_t num_pitches = 0;
+
+    /* Tabelul de perioade, in ordinea primei aparitii */
+    for (uint32_t i = 0; i < song->count; i++) {
+        const Item_t *it = &song->items[i];
+        if (it->type != IT_NOTE || it->period == 0) continue;
+
+        uint8_t p = 0;
+        while (p < num_pitches && pitches[p] != it->period) p++;
+        if (p == num_pitches) {
+            if (num_pitches == SONG_MAX_PITCHES) {
+                fprintf(stderr, "%s: more than %u distinct notes\n", path, (unsigned)SONG_MAX_PITCHES);
+                return false;
+            }
+            pitches[num_pitches++] = it->period;
+        }
+    }
+
+    song->size = 0;
+    Emit(song, num_pitches);
+    Emit(song, song->tempo);
+    for (uint8_t p = 0; p < num_pitches; p++) {
+        Emit(song, (uint8_t)(pitches[p] & 0xFFU));
+        Emit(song, (uint8_t)(pitches[p] >> 8));
+    }
+
+    /* Durata din player; -1 = necunoscuta (la intrarea intr-o bucla,
+     * a doua trecere vine cu durata de la sfarsitul corpului) */
+    int player_ticks = 1;
+    bool ok = true;
+
+    for (uint32_t i = 0; i < song->count && ok; i++) {
+        const Item_t *it = &song->items[i];
+
+        switch (it->type) {
+            case IT_TEMPO:
+                ok = Emit(song, SONG_EVENT(SONG_PITCH_CMD, SONG_CMD_TEMPO)) && Emit(song, it->arg);
+                break;
+
+            case IT_LOOP:
+                ok = Emit(song, SONG_EVENT(SONG_PITCH_CMD, SONG_CMD_LOOP)) && Emit(song, it->arg);
+                player_ticks = -1;
+                break;
+
+            case IT_ENDLOOP:
+                ok = Emit(song, SONG_EVENT(SONG_PITCH_CMD, SONG_CMD_ENDLOOP));
+                break;
+
+            case IT_NOTE: {
+                uint8_t pitch = SONG_PITCH_REST;
+                if (it->period != 0) {
+                    pitch = 0;
+                    while (pitches[pitch] != it->period) pitch++;
+                }
+
+                uint8_t dur = 0;
+                if (player_ticks != it->ticks) {
+                    dur = DurCode(it->ticks);
+                    if (dur == 0) {
+                        ok = Emit(song, SONG_EVENT(SONG_PITCH_CMD, SONG_CMD_LEN)) && Emit(song, it->ticks);
+                    }
+                    player_ticks = it->ticks;
+                }
+                ok = ok && Emit(song, SONG_EVENT(pitch, dur));
+                break;
+            }
+        }
+    }
+    ok = ok && Emit(song, SONG_EVENT(SONG_PITCH_CMD, SONG_CMD_END));
+
+    if (!ok) fprintf(stderr, "%s: song larger than %u bytes\n", path, (unsigned)MAX_BLOB);
+    return ok;
+}
+
+/*============================================================================
+ * VERIFY
+ *============================================================================*/
+
+/* Lista asteptata, cu buclele desfasurate si tempo-ul in ordinea redarii */
+static uint32_t Expand(const Song_t *song, uint32_t from, uint32_t to, uint8_t *tempo,
+                       SongNote_t *out, uint32_t n) {
+    for (uint32_t i = from; i < to; i++) {
+        const Item_t *it = &song->items[i];
+
+        if (it->type == IT_TEMPO) {
+            *tempo = it->arg;
+        } else if (it->type == IT_NOTE) {
+            if (n < MAX_NOTES) {
+                out[n].period = it->period;
+                out[n].ms = (uint16_t)(it->ticks * *tempo);
+            }
+            n++;
+        } else if (it->type == IT_LOOP) {
+            uint32_t end = i + 1, depth = 1;
+            while (depth) {
+                if (song->items[end].type == IT_LOOP) depth++;
+                if (song->items[end].type == IT_ENDLOOP) depth--;
+                end++;
+            }
+            for (uint8_t r = 0; r < it->arg; r++) {
+                n = Expand(song, i + 1, end - 1, tempo, out, n);
+            }
+            i = end - 1;
+        }
+    }
+    return n;
+}
+
+static bool Verify(const char *path, Song_t *song) {
+    static SongNote_t expected[MAX_NOTES];
+    uint8_t tempo = song->tempo;
+    uint32_t n = Expand(song, 0, song->count, &tempo, expected, 0);
+
+    if (n > MAX_NOTES) {
+        fprintf(stderr, "%s: more than %u notes after unrolling\n", path, (unsigned)MAX_NOTES);
+        return false;
+    }
+
+    SongPlayer_t player;
+    SongNote_t note;
+    uint32_t i = 0;
+
+    Song_Start(&player, song->blob);
+    while (Song_Next(&player, &note)) {
+        if (i >= n || note.period != expected[i].period || note.ms != expected[i].ms) {
+            fprintf(stderr, "%s: note %u decodes as %u/%u ms, expected %u/%u ms\n", path,
+                    (unsigned)i, note.period, note.ms,
+                    i < n ? expected[i].period : 0, i < n ? expected[i].ms : 0);
+            return false;
+        }
+        i++;
+    }
+    if (i != n) {
+        fprintf(stderr, "%s: decoded %u notes, expected %u\n", path, (unsigned)i, (unsigned)n);
+        return false;
+    }
+    song->notes = n;
+    return true;
+}
+
+/*============================================================================
+ * OUTPUT
+ *============================================================================*/
+
+static void WriteSource(FILE *f, const char *header, const Song_t *list, uint32_t count) {
+    fprintf(f, "/*\n * songs.c\n * Generat de host/songc din songs/<nume>.song - nu se editeaza manual\n */\n\n");
+    fprintf(f, "#include \"headers/%s\"\n", header);
+    for (uint32_t s = 0; s < count; s++) {
+        const Song_t *song = &list[s];
+        fprintf(f, "\n/* %s: %u note, %u octeti */\n", song->name, (unsigned)song->notes,
+                (unsigned)song->size);
+        fprintf(f, "const uint8_t song_%s[%u] = {", song->name, (unsigned)song->size);
+        for (uint32_t i = 0; i < song->size; i++) {
+            fprintf(f, "%s0x%02X%s", (i % 12) ? " " : "\n    ", song->blob[i],
+                    (i + 1 < song->size) ? "," : "");
+        }
+        fprintf(f, "\n};\n");
+    }
+}
+
+static void WriteHeader(FILE *f, const char *header, const Song_t *list, uint32_t count) {
+    char guard[64];
+    uint32_t i;
+
+    for (i = 0; header[i] && i < sizeof(guard) - 1; i++) {
+        guard[i] = isalnum((unsigned char)header[i]) ? (char)toupper((unsigned char)header[i]) : '_';
+    }
+    guard[i] = '\0';
+
+    fprintf(f, "/*\n * %s\n * Generat de host/songc din songs/<nume>.song - nu se editeaza manual\n */\n\n", header);
+    fprintf(f, "#ifndef %s\n#define %s\n\n#include <stdint.h>\n\n", guard, guard);
+    for (uint32_t s = 0; s < count; s++) {
+        fprintf(f, "extern const uint8_t song_%s[%u];\n", list[s].name, (unsigned)list[s].size);
+    }
+    fprintf(f, "\n#endif /* %s */\n", guard);
+}
+
+/*============================================================================
+ * MAIN
+ *============================================================================*/
+
+int main(int argc, char **argv) {
+    const char *source = NULL;
+    const char *header = NULL;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "c:H:")) != -1) {
+        switch (opt) {
+            case 'c': source = optarg; break;
+            case 'H': header = optarg; break;
+            default:
+                fprintf(stderr, "usage: %s [-c songs.c -H songs.h] file.song...\n", argv[0]);
+                return 2;
+        }
+    }
+    if (optind >= argc || (!source != !header) || argc - optind > MAX_SONGS) {
+        fprintf(stderr, "usage: %s [-c songs.c -H songs.h] file.song... (max %u)\n", argv[0],
+                (unsigned)MAX_SONGS);
+        return 2;
+    }
+
+    uint32_t count = 0;
+    fprintf(stderr, "%-12s %6s %6s %10s %12s\n", "song", "notes", "bytes", "bytes/note", "arrays bytes");
+    for (int a = optind; a < argc; a++) {
+        Song_t *song = &songs[count++];
+        if (!Parse(argv[a], song) || !Encode(argv[a], song) || !Verify(argv[a], song)) {
+            return 1;
+        }
+        fprintf(stderr, "%-12s %6u %6u %10.2f %12u\n", song->name, (unsigned)song->notes,
+                (unsigned)song->size, song->notes ? (double)song->size / song->notes : 0.0,
+                (unsigned)(song->notes * ARRAYS_BYTES_PER_NOTE));
+    }
+
+    if (source) {
+        FILE *c = fopen(source, "w");
+        FILE *h = fopen(header, "w");
+        if (!c || !h) {
+            perror(!c ? source : header);
+            return 1;
+        }
+        const char *base = strrchr(header, '/');
+        base = base ? base + 1 : header;
+        WriteSource(c, base, songs, count);
+        WriteHeader(h, base, songs, count);
+        fclose(c);
+        fclose(h);
+    }
+    return 0;
+}
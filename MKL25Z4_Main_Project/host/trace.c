@@ -0,0 +1,179 @@
+/*
+ * trace.c
+ * Input scriptat: joystick (ADC0 + PTD4) si telecomanda IR (PTA12)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include "trace.h"
+#include "sim.h"
+#include "panel.h"
+#include "../source/drivers/headers/joystick.h"
+#include "../source/drivers/headers/ir_remote.h"
+
+/*============================================================================
+ * WIRING
+ *============================================================================*/
+
+#define PORT_A          0U
+#define PORT_D          3U
+#define IR_PIN          12U         /* PTA12, ca in ir_remote.c */
+#define BTN_PRESS_MS    50U
+
+/* NEC (us) */
+#define NEC_LEAD_MARK   9000U
+#define NEC_LEAD_SPACE  4500U
+#define NEC_RPT_SPACE   2250U
+#define NEC_BIT_MARK    560U
+#define NEC_ZERO_SPACE  560U
+#define NEC_ONE_SPACE   1690U
+#define NEC_PERIOD_US   108000U
+
+static const char *dump_dir = ".";
+
+/*============================================================================
+ * EVENTS
+ *============================================================================*/
+
+static void JoyEvent(void *arg) {
+    int32_t pct = (int32_t)(intptr_t)arg;
+    int32_t raw = 2048 + pct * 2048 / 100;
+    if (raw < 0) raw = 0;
+    if (raw > 4095) raw = 4095;
+    Sim_SetAdc(JOYSTICK_VRY_CHANNEL, (uint16_t)raw);
+}
+
+static void BtnEvent(void *arg) {
+    Sim_PinEdge(PORT_D, JOYSTICK_SW_PIN, arg != NULL);
+}
+
+/* Iesirea receptorului IR e activa in 0 */
+static void IrEvent(void *arg) {
+    Sim_PinEdge(PORT_A, IR_PIN, arg != NULL);
+}
+
+static void DumpEvent(void *arg) {
+    char *name = arg;
+    char path[512];
+    if (strchr(name, '/')) {
+        snprintf(path, sizeof(path), "%s", name);
+    } else {
+        snprintf(path, sizeof(path), "%s/%s", dump_dir, name);
+    }
+    Panel_WriteImage(path);
+    free(name);
+}
+
+static void EndEvent(void *arg) {
+    (void)arg;
+    Sim_SetStopTime(sim_cycles);
+}
+
+/*============================================================================
+ * IR WAVEFORM
+ *============================================================================*/
+
+static uint64_t IrMark(uint64_t t, uint32_t mark_us, uint32_t space_us) {
+    Sim_Schedule(t, IrEvent, NULL);
+    t += SIM_US_TO_CYCLES(mark_us);
+    Sim_Schedule(t, IrEvent, (void *)1);
+    return t + SIM_US_TO_CYCLES(space_us);
+}
+
+static void ScheduleNec(uint64_t start, uint32_t code, uint32_t hold_ms) {
+    uint64_t t = IrMark(start, NEC_LEAD_MARK, NEC_LEAD_SPACE);
+    for (uint8_t i = 0; i < 32; i++) {
+        t = IrMark(t, NEC_BIT_MARK, (code >> i) & 1U ? NEC_ONE_SPACE : NEC_ZERO_SPACE);
+    }
+    IrMark(t, NEC_BIT_MARK, 0);
+
+    /* Repeat-uri la 108 ms cat timp tasta e tinuta */
+    uint64_t end = start + SIM_MS_TO_CYCLES(hold_ms);
+    for (uint64_t r = start + SIM_US_TO_CYCLES(NEC_PERIOD_US); r < end; r += SIM_US_TO_CYCLES(NEC_PERIOD_US)) {
+        t = IrMark(r, NEC_LEAD_MARK, NEC_RPT_SPACE);
+        IrMark(t, NEC_BIT_MARK, 0);
+    }
+}
+
+static bool ParseIrKey(const char *key, uint32_t *code) {
+    if (strcasecmp(key, "up") == 0) *code = IR_CODE_UP;
+    else if (strcasecmp(key, "down") == 0) *code = IR_CODE_DOWN;
+    else if (strcasecmp(key, "select") == 0) *code = IR_CODE_SELECT;
+    else {
+        char *end;
+        *code = (uint32_t)strtoul(key, &end, 16);
+        return *end == '\0';
+    }
+    return true;
+}
+
+/*============================================================================
+ * PARSER
+ *============================================================================*/
+
+bool Trace_Load(const char *path, const char *out_dir) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        return false;
+    }
+    dump_dir = out_dir;
+
+    char line[256];
+    unsigned line_no = 0;
+    uint64_t prev_ms = 0;
+    bool ok = true;
+
+    while (fgets(line, sizeof(line), f)) {
+        line_no++;
+        char *hash = strchr(line, '#');
+        if (hash) *hash = '\0';
+
+        char time_str[32], cmd[32], arg1[128] = "", arg2[32] = "";
+        int n = sscanf(line, "%31s %31s %127s %31s", time_str, cmd, arg1, arg2);
+        if (n <= 0) continue;
+        if (n < 2) {
+            fprintf(stderr, "%s:%u: missing command\n", path, line_no);
+            ok = false;
+            continue;
+        }
+
+        uint64_t ms = strtoull(time_str + (time_str[0] == '+'), NULL, 10);
+        if (time_str[0] == '+') ms += prev_ms;
+        prev_ms = ms;
+        uint64_t when = SIM_MS_TO_CYCLES(ms);
+
+        if (strcmp(cmd, "joy") == 0) {
+            Sim_Schedule(when, JoyEvent, (void *)(intptr_t)atoi(arg1));
+        } else if (strcmp(cmd, "btn") == 0) {
+            Sim_Schedule(when, BtnEvent, NULL);
+            Sim_Schedule(when + SIM_MS_TO_CYCLES(BTN_PRESS_MS), BtnEvent, (void *)1);
+        } else if (strcmp(cmd, "ir") == 0) {
+            uint32_t code;
+            if (!ParseIrKey(arg1, &code)) {
+                fprintf(stderr, "%s:%u: bad IR key '%s'\n", path, line_no, arg1);
+                ok = false;
+                continue;
+            }
+            ScheduleNec(when, code, n >= 4 ? (uint32_t)atoi(arg2) : 0);
+        } else if (strcmp(cmd, "dump") == 0) {
+            char name[160];
+            if (n >= 3) {
+                snprintf(name, sizeof(name), "%s", arg1);
+            } else {
+                snprintf(name, sizeof(name), "frame_%06llu.png", (unsigned long long)ms);
+            }
+            Sim_Schedule(when, DumpEvent, strdup(name));
+        } else if (strcmp(cmd, "end") == 0) {
+            Sim_Schedule(when, EndEvent, NULL);
+        } else {
+            fprintf(stderr, "%s:%u: unknown command '%s'\n", path, line_no, cmd);
+            ok = false;
+        }
+    }
+
+    fclose(f);
+    return ok;
+}
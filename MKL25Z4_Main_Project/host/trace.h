@@ -0,0 +1,27 @@
+/*
+ * trace.h
+ * Input scriptat pentru build-ul host
+ *
+ * Format (o comanda pe linie, '#' = comentariu):
+ *   <ms> joy <procent>          Joystick Y, -100 (sus) .. 100 (jos)
+ *   <ms> btn                    Apasare buton joystick (PTD4, 50 ms)
+ *   <ms> ir <tasta> [hold_ms]   Cadru NEC pe PTA12 (+ repeat-uri cat e tinut)
+ *                               tasta: up, down, select sau cod hex (0xBA45FF00)
+ *   <ms> dump [fisier]          Salveaza ecranul (.png sau .ppm)
+ *   <ms> end                    Opreste simularea
+ * Timpul poate fi absolut ("1500") sau relativ la linia anterioara ("+200").
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdbool.h>
+
+/**
+ * Citeste fisierul si programeaza evenimentele in simulator
+ * @param out_dir directorul pentru "dump" fara cale
+ * @return false daca fisierul nu poate fi citit sau are erori
+ */
+bool Trace_Load(const char *path, const char *out_dir);
+
+#endif /* TRACE_H */
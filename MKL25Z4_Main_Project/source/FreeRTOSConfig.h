@@ -0,0 +1,114 @@
+/*
+ * FreeRTOSConfig.h
+ * Configurarea kernel-ului pentru varianta FreeRTOS (pong_rtos.c)
+ *
+ * Folosit doar cu -DSDK_OS_FREE_RTOS. Pe placa: port-ul ARM_CM0 + heap_4;
+ * pe host (HOST_BUILD): port-ul POSIX + heap_3, cu stive mai mari pentru
+ * thread-urile Linux si timpul de rulare luat din simulator.
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#include <stdint.h>
+
+extern uint32_t SystemCoreClock;
+
+/*============================================================================
+ * KERNEL
+ *============================================================================*/
+
+#define configUSE_PREEMPTION                    1
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+#define configUSE_TICKLESS_IDLE                 0
+#define configCPU_CLOCK_HZ                      (SystemCoreClock)
+#define configTICK_RATE_HZ                      ((TickType_t)1000)
+#define configMAX_PRIORITIES                    5
+#define configMAX_TASK_NAME_LEN                 8
+#define configUSE_16_BIT_TICKS                  0
+#define configIDLE_SHOULD_YIELD                 1
+#define configUSE_TASK_NOTIFICATIONS            1
+#define configUSE_MUTEXES                       1
+#define configUSE_RECURSIVE_MUTEXES             0
+#define configUSE_COUNTING_SEMAPHORES           0
+#define configQUEUE_REGISTRY_SIZE               0
+#define configUSE_TIME_SLICING                  0
+
+/* g_systick_ms e incrementat din vApplicationTickHook */
+#if defined(HOST_BUILD)
+#define configUSE_IDLE_HOOK                     1   /* Avanseaza timpul simulat */
+#else
+#define configUSE_IDLE_HOOK                     0
+#endif
+#define configUSE_TICK_HOOK                     1
+
+/*============================================================================
+ * MEMORY
+ *============================================================================*/
+
+#define configSUPPORT_STATIC_ALLOCATION         0
+#define configSUPPORT_DYNAMIC_ALLOCATION        1
+
+#if defined(HOST_BUILD)
+/* Thread-urile POSIX au nevoie de cel putin PTHREAD_STACK_MIN */
+#define configMINIMAL_STACK_SIZE                ((uint16_t)4096)
+#define configTOTAL_HEAP_SIZE                   ((size_t)(512 * 1024))
+#define RTOS_STACK_WORDS(target)                (configMINIMAL_STACK_SIZE + (target))
+#else
+/* 16 KB SRAM: ~6 KB pentru kernel, stive si cozi */
+#define configMINIMAL_STACK_SIZE                ((uint16_t)90)
+#define configTOTAL_HEAP_SIZE                   ((size_t)(6 * 1024))
+#define RTOS_STACK_WORDS(target)                (target)
+#endif
+
+/*============================================================================
+ * DEBUG / STATISTICI
+ *============================================================================*/
+
+#define configCHECK_FOR_STACK_OVERFLOW          2
+#define configUSE_MALLOC_FAILED_HOOK            1
+#define configUSE_TRACE_FACILITY                1
+#define configGENERATE_RUN_TIME_STATS           1
+
+/* Timp de rulare in microsecunde: SysTick->VAL pe placa, simulatorul pe host */
+#if defined(HOST_BUILD)
+extern uint32_t Host_RtosNowUs(void);
+#define portGET_RUN_TIME_COUNTER_VALUE()        Host_RtosNowUs()
+#else
+extern uint32_t Scheduler_NowUs(void);
+#define portGET_RUN_TIME_COUNTER_VALUE()        Scheduler_NowUs()
+#endif
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+
+#define configASSERT(x)                         do { if (!(x)) { taskDISABLE_INTERRUPTS(); for (;;) { } } } while (0)
+
+/*============================================================================
+ * API INCLUS
+ *============================================================================*/
+
+#define INCLUDE_vTaskDelay                      1
+#define INCLUDE_vTaskDelayUntil                 1
+#define INCLUDE_xTaskDelayUntil                 1
+#define INCLUDE_vTaskSuspend                    1
+#define INCLUDE_uxTaskGetStackHighWaterMark     1
+#define INCLUDE_xTaskGetSchedulerState          1
+#define INCLUDE_xTaskGetCurrentTaskHandle       1
+#define INCLUDE_vTaskDelete                     0
+
+/*============================================================================
+ * CORTEX-M0+ (doar pe placa)
+ *============================================================================*/
+
+#if !defined(HOST_BUILD)
+/* KL25Z are 2 biti de prioritate; kernel-ul ruleaza la cea mai mica */
+#define configPRIO_BITS                         2
+#define configKERNEL_INTERRUPT_PRIORITY         (3 << (8 - configPRIO_BITS))
+#define configMAX_SYSCALL_INTERRUPT_PRIORITY    (1 << (8 - configPRIO_BITS))
+
+/* Vectorii din startup_mkl25z4.c */
+#define vPortSVCHandler                         SVC_Handler
+#define xPortPendSVHandler                      PendSV_Handler
+#define xPortSysTickHandler                     SysTick_Handler
+#endif
+
+#endif /* FREERTOS_CONFIG_H */
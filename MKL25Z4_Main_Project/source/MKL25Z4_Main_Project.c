@@ -5,51 +5,60 @@
  * Cu suport pentru Joystick si Telecomanda IR (cu hold)
  * 
  * Timere:
- * - SysTick: Timer global pentru milisecunde
+ * - SysTick: Timer global pentru milisecunde (si ritmul scheduler-ului)
+ * - TPM0: Trigger ADC pentru joystick (folosit in joystick.c)
  * - TPM1: Masurare pulsuri IR (folosit in ir_remote.c)
- * - PIT: Update periodic UI (20Hz pentru meniu, 50Hz pentru joc)
+ * - TPM2 + PIT ch1: Ton PWM si durata notelor pentru buzzer (audio.c);
+ *   cu -DAUDIO_DAC TPM2 da ritmul esantioanelor DAC0 prin DMA ch2
+ * - LPTMR0: Trezire din VLPS cand CPU-ul doarme in meniuri (power.c)
+ * - UART0: Consola; mesajele LOG (log.c) pleaca din intreruperea TX-empty
+ *   (cu -DLOG_TOKENIZED: cadre binare, textul e refacut de host/logdec)
+ *
+ * Task-uri (scheduler.c, prioritate 0 = cea mai mare):
+ * - input (1 ms, 0):  joystick + IR
+ * - game  (20 ms, 1): fizica + desenare, doar in timpul jocului
+ * - ui    (50 ms, 2): evenimente de input, meniuri si ecranul de pauza
+ * In afara jocului input-ul trece la 10 ms (ADC la cerere), iar intre
+ * activari CPU-ul sta in VLPS; in joc ramane in WAIT, cu SysTick.
+ * Meniurile, pauza si game over ruleaza in VLPR (4 MHz, run_mode.c);
+ * orice eveniment de input sau redesenare trece intai in RUN (48 MHz).
+ *
+ * Flash: ultimii 4 KB (0x1F000) pastreaza setarile si rezultatele
+ * (settings.c, kv_store.c), scrise doar dupa desenarea unui meniu.
+ *
+ * Logica ecranelor e in drivers/app.c (App_*); cu -DSDK_OS_FREE_RTOS
+ * aceleasi functii ruleaza in task-uri FreeRTOS (pong_rtos.c), iar
+ * SysTick e al kernel-ului.
  */
 
-#include <stdio.h>
-#include <stdlib.h>
 #include "board.h"
 #include "peripherals.h"
 #include "pin_mux.h"
 #include "clock_config.h"
 #include "MKL25Z4.h"
 #include "fsl_debug_console.h"
-#include "fsl_pit.h"
 
 /* Modulele noastre */
 #include "drivers/headers/game_config.h"
-#include "drivers/headers/st7735_simple.h"
 #include "drivers/headers/joystick.h"
 #include "drivers/headers/ir_remote.h"
-#include "drivers/headers/menu.h"
-#include "drivers/headers/pong_game.h"
+#include "drivers/headers/input_events.h"
+#include "drivers/headers/scheduler.h"
+#include "drivers/headers/power.h"
+#include "drivers/headers/run_mode.h"
+#include "drivers/headers/app.h"
+#include "drivers/headers/log.h"
+#include "drivers/headers/profiler.h"
+#include "pong_rtos.h"
 
 /*============================================================================
  * GLOBAL VARIABLES
  *============================================================================*/
 
-/* Variabile globale din game_config.h */
-InputType_t g_player1_input = INPUT_JOYSTICK;   /* Default: Joystick */
-InputType_t g_player2_input = INPUT_REMOTE;     /* Default: Telecomanda */
-Screen_t g_currentScreen = SCREEN_INTRO;
-MenuState_t g_menuState = {0, 3};
-volatile uint8_t g_needsRedraw = 1;
-Difficulty_t g_currentDifficulty = DIFF_NORMAL;
-
 /* Timer global - incrementat de SysTick */
 volatile uint32_t g_systick_ms = 0;
 
-/* Flag-uri pentru update periodic */
-static volatile bool g_update_ui = false;
-static volatile bool g_update_game = false;
-
-/* Pause menu state */
-static uint8_t g_pause_selection = 0;
-
+#if !defined(SDK_OS_FREE_RTOS)
 /*============================================================================
  * SYSTICK HANDLER - 1ms timer
  *============================================================================*/
@@ -58,22 +67,23 @@ void SysTick_Handler(void) {
     g_systick_ms++;
 }
 
-/*============================================================================
- * PIT HANDLER - Update periodic
- *============================================================================*/
+/* 1 ms si dupa o schimbare RUN/VLPR. VAL tine ciclii ramasi din ms-ul
+ * curent la LOAD-ul vechi: restul e convertit la core_hz nou si incarcat
+ * o singura data (LOAD scurt, VAL sters), apoi LOAD-ul intreg, care
+ * conteaza de la reincarcarea urmatoare. Ms-ul inceput nu se pierde si
+ * nu se numara de doua ori. */
+static void SysTick_OnRunMode(const RunModeClocks_t* clocks) {
+    uint32_t ticks;
+    uint32_t old_load = SysTick->LOAD + 1U;
+    uint32_t load = clocks->core_hz / 1000U;
 
-void PIT_IRQHandler(void) {
-    /* Channel 0 - UI/Menu update (50ms = 20Hz) */
-    if (PIT_GetStatusFlags(PIT, kPIT_Chnl_0) & kPIT_TimerFlag) {
-        PIT_ClearStatusFlags(PIT, kPIT_Chnl_0, kPIT_TimerFlag);
-        g_update_ui = true;
-    }
-    
-    /* Channel 1 - Game update (20ms = 50Hz) */
-    if (PIT_GetStatusFlags(PIT, kPIT_Chnl_1) & kPIT_TimerFlag) {
-        PIT_ClearStatusFlags(PIT, kPIT_Chnl_1, kPIT_TimerFlag);
-        g_update_game = true;
-    }
+    (void)Scheduler_ReadTick(&ticks);
+    uint32_t rest = (uint32_t)((uint64_t)(old_load - ticks) * load / old_load);
+    if (rest < 2U) rest = 2U;
+
+    SysTick->LOAD = rest - 1U;
+    SysTick->VAL = 0U;
+    SysTick->LOAD = load - 1U;
 }
 
 /*============================================================================
@@ -81,148 +91,113 @@ void PIT_IRQHandler(void) {
  *============================================================================*/
 
 static void Timer_Init(void) {
-    /* SysTick - 1ms interrupt */
+    /* SysTick - 1ms interrupt; perioadele task-urilor sunt in ms */
     SysTick_Config(SystemCoreClock / 1000U);
     
-    /* PIT - Periodic Interrupt Timer */
-    pit_config_t pitConfig;
-    PIT_GetDefaultConfig(&pitConfig);
-    PIT_Init(PIT, &pitConfig);
-    
-    /* Channel 0 - 50ms pentru meniu (20Hz) */
-    /* Bus clock = 24MHz, pentru 50ms: 24000000 * 0.05 = 1200000 */
-    PIT_SetTimerPeriod(PIT, kPIT_Chnl_0, CLOCK_GetBusClkFreq() / 20U - 1U);
-    PIT_EnableInterrupts(PIT, kPIT_Chnl_0, kPIT_TimerInterruptEnable);
+    /* LPTMR0 tine timpul cat SysTick sta in VLPS */
+    Power_Init();
     
-    /* Channel 1 - 20ms pentru joc (50Hz) */
-    PIT_SetTimerPeriod(PIT, kPIT_Chnl_1, CLOCK_GetBusClkFreq() / 50U - 1U);
-    PIT_EnableInterrupts(PIT, kPIT_Chnl_1, kPIT_TimerInterruptEnable);
+    /* Inaintea driverelor: fiecare isi inregistreaza listener-ul la init */
+    RunMode_Init();
+    RunMode_AddListener(SysTick_OnRunMode);
     
-    EnableIRQ(PIT_IRQn);
-    
-    /* Pornim doar timer-ul pentru UI initial */
-    PIT_StartTimer(PIT, kPIT_Chnl_0);
-    
-    PRINTF("[TIMER] SysTick + PIT initialized\r\n");
+    LOG_BOOT("[TIMER] SysTick initialized\r\n");
 }
 
 /*============================================================================
- * INPUT PROCESSING
+ * TASKS
  *============================================================================*/
 
-/* Proceseaza input pentru meniu */
-static void ProcessMenuInput(void) {
-    UI_Action_t action = ACTION_NONE;
-    
-    /* Verificam Joystick */
-    action = Joystick_GetMenuAction();
+static void InputTask(void);
+static void GameTask(void);
+static void UiTask(void);
+
+static Task_t input_task = { .name = "input", .run = InputTask, .period_ms = 1,  .priority = 0 };
+static Task_t game_task  = { .name = "game",  .run = GameTask,  .period_ms = 20, .priority = 1 };
+static Task_t ui_task    = { .name = "ui",    .run = UiTask,    .period_ms = 50, .priority = 2 };
+
+/* Perioada input-ului in meniuri: 10 ms e sub pragul de 50 ms al ui-ului */
+#define INPUT_IDLE_PERIOD_MS    10
+
+/* Apelat din app.c cand incepe / se termina un meci */
+void App_SetGameRunning(bool running) {
+    Scheduler_SetEnabled(&game_task, running);
+}
+
+/*============================================================================
+ * TASK FUNCTIONS
+ *============================================================================*/
+
+/* Input-urile - mereu, la fiecare ms (esantioanele ADC vin la 1 kHz) */
+static void InputTask(void) {
+    PROF_BEGIN(PROF_INPUT);
+    Joystick_Process();
+    IR_Process();
+    PROF_END(PROF_INPUT);
+}
+
+/* Update joc la 50Hz, activ doar cat ruleaza un meci */
+static void GameTask(void) {
+    InputEvent_t ev;
     
-    /* Daca nu e joystick, verificam IR */
-    if (action == ACTION_NONE) {
-        action = IR_GetMenuAction();
+    /* Pauza se verifica la fiecare frame, nu doar la ritmul meniurilor */
+    while (g_currentScreen == SCREEN_GAMEPLAY && InputEvents_Pop(&ev)) {
+        App_HandleInput(&ev);
     }
+    if (g_currentScreen != SCREEN_GAMEPLAY) return;
     
-    /* Executam actiunea */
-    if (action != ACTION_NONE) {
-        switch(action) {
-            case ACTION_UP:
-                PRINTF("[UI] UP\r\n");
-                Menu_MoveUp();
-                break;
-                
-            case ACTION_DOWN:
-                PRINTF("[UI] DOWN\r\n");
-                Menu_MoveDown();
-                break;
-                
-            case ACTION_SELECT:
-                PRINTF("[UI] SELECT\r\n");
-                Menu_Select();
-                break;
-                
-            case ACTION_BACK:
-                PRINTF("[UI] BACK\r\n");
-                g_menuState.selectedIndex = g_menuState.maxItems - 1;
-                Menu_Select();
-                break;
-                
-            default:
-                break;
-        }
+    if (!App_GameTick()) {
+        /* Oprim task-ul de joc */
+        Scheduler_SetEnabled(&game_task, false);
+        App_GameOver();
     }
 }
 
-/* Proceseaza input pentru ecranul de pauza */
-static void ProcessPauseInput(void) {
-    UI_Action_t action = ACTION_NONE;
-    
-    /* Verificam Joystick */
-    action = Joystick_GetMenuAction();
+/* Jocul cere raspuns la 1 ms; meniurile pot dormi intre esantioane */
+static void UpdatePowerMode(void) {
+    bool playing = (g_currentScreen == SCREEN_GAMEPLAY);
     
-    /* Daca nu e joystick, verificam IR */
-    if (action == ACTION_NONE) {
-        action = IR_GetMenuAction();
-    }
-    
-    if (action != ACTION_NONE) {
-        switch(action) {
-            case ACTION_UP:
-                g_pause_selection = 0;
-                g_needsRedraw = 1;
-                break;
-                
-            case ACTION_DOWN:
-                g_pause_selection = 1;
-                g_needsRedraw = 1;
-                break;
-                
-            case ACTION_SELECT:
-                if (g_pause_selection == 0) {
-                    /* Resume */
-                    PRINTF("[GAME] Resumed\r\n");
-                    Game_SetPaused(false);
-                    g_currentScreen = SCREEN_GAMEPLAY;
-                    Game_DrawField();
-                    Game_DrawScore();
-                } else {
-                    /* Exit to menu */
-                    PRINTF("[GAME] Exit to menu\r\n");
-                    g_currentScreen = SCREEN_MAIN;
-                    g_menuState.selectedIndex = 0;
-                    g_menuState.maxItems = 3;
-                    g_needsRedraw = 1;
-                    
-                    /* Oprim timer-ul de joc */
-                    PIT_StopTimer(PIT, kPIT_Chnl_1);
-                }
-                break;
-                
-            default:
-                break;
-        }
-    }
+    /* VLPR abia dupa ce ultimul ecran a iesit pe SPI (altfel, la tick-ul urmator) */
+    RunMode_Update(playing || g_needsRedraw);
+    Scheduler_SetEnabled(&game_task, playing);
+    Joystick_SetLowPower(!playing);
+    Scheduler_SetPeriod(&input_task, playing ? 1 : INPUT_IDLE_PERIOD_MS);
+    /* VLPS doar din VLPR: din PEE trezirea trece prin PBE si relock-ul PLL */
+    Power_SetDeepSleep(!playing && RunMode_Get() == RUN_MODE_VLPR);
 }
 
-/* Verifica daca se cere pauza in timpul jocului */
-static void CheckGamePause(void) {
-    /* Butonul joystick = pauza */
-    if (Joystick_ButtonPressed()) {
-        PRINTF("[GAME] Paused\r\n");
-        Game_SetPaused(true);
-        g_currentScreen = SCREEN_PAUSED;
-        g_pause_selection = 0;
-        g_needsRedraw = 1;
+/* Evenimentele de input si meniurile la 20Hz */
+static void UiTask(void) {
+    InputEvent_t ev;
+    Screen_t screen = g_currentScreen;
+    
+    /* Dupa o schimbare de ecran, restul evenimentelor sunt pentru noul ecran */
+    while (g_currentScreen == screen && InputEvents_Pop(&ev)) {
+        /* Handler-ele pot desena direct (ex: reluarea din pauza) */
+        RunMode_Set(RUN_MODE_RUN);
+        App_HandleInput(&ev);
     }
+    
+    if (g_needsRedraw) RunMode_Set(RUN_MODE_RUN);
+    App_Redraw();
+    UpdatePowerMode();
 }
+#endif
 
 /*============================================================================
  * DELAY FUNCTION (blocant - doar pentru animatii la init)
  *============================================================================*/
 
 void delay_ms(uint32_t ms) {
+#if defined(SDK_OS_FREE_RTOS)
+    if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) {
+        vTaskDelay(pdMS_TO_TICKS(ms));
+        return;
+    }
+#endif
     uint32_t start = g_systick_ms;
     while ((g_systick_ms - start) < ms) {
-        __asm volatile("nop");
+        __NOP();
     }
 }
 
@@ -237,132 +212,52 @@ int main(void) {
     BOARD_InitBootPeripherals();
     BOARD_InitDebugConsole();
     
-    PRINTF("\r\n");
-    PRINTF("========================================\r\n");
-    PRINTF("     PONG GAME - FRDM-KL25Z + ST7735   \r\n");
-    PRINTF("     Joystick + IR Remote Control      \r\n");
-    PRINTF("========================================\r\n\r\n");
+    LOG_BOOT("\r\n");
+    LOG_BOOT("========================================\r\n");
+    LOG_BOOT("     PONG GAME - FRDM-KL25Z + ST7735   \r\n");
+    LOG_BOOT("     Joystick + IR Remote Control      \r\n");
+    LOG_BOOT("========================================\r\n\r\n");
     
-    PRINTF("=== PINOUT ===\r\n");
-    PRINTF("DISPLAY (ST7735):\r\n");
-    PRINTF("  SCK -> PTC5    SDA -> PTC6\r\n");
-    PRINTF("  DC  -> PTC3    CS  -> PTC4\r\n");
-    PRINTF("  RES -> PTC0    BL/VCC -> 3.3V\r\n");
-    PRINTF("\r\n");
-    PRINTF("JOYSTICK:\r\n");
-    PRINTF("  VRY -> PTB1 (ADC0_SE9)\r\n");
-    PRINTF("  SW  -> PTD4\r\n");
-    PRINTF("  VCC -> 3.3V   GND -> GND\r\n");
-    PRINTF("\r\n");
-    PRINTF("IR REMOTE:\r\n");
-    PRINTF("  OUT -> PTA12\r\n");
-    PRINTF("  VCC -> 3.3V   GND -> GND\r\n");
-    PRINTF("==============\r\n\r\n");
+    LOG_BOOT("=== PINOUT ===\r\n");
+    LOG_BOOT("DISPLAY (ST7735):\r\n");
+    LOG_BOOT("  SCK -> PTC5    SDA -> PTC6\r\n");
+    LOG_BOOT("  DC  -> PTC3    CS  -> PTC4\r\n");
+    LOG_BOOT("  RES -> PTC0    BL/VCC -> 3.3V\r\n");
+    LOG_BOOT("\r\n");
+    LOG_BOOT("JOYSTICK:\r\n");
+    LOG_BOOT("  VRY -> PTB1 (ADC0_SE9)\r\n");
+    LOG_BOOT("  SW  -> PTD4\r\n");
+    LOG_BOOT("  VCC -> 3.3V   GND -> GND\r\n");
+    LOG_BOOT("\r\n");
+    LOG_BOOT("IR REMOTE:\r\n");
+    LOG_BOOT("  OUT -> PTA12\r\n");
+    LOG_BOOT("  VCC -> 3.3V   GND -> GND\r\n");
+    LOG_BOOT("\r\n");
+#if defined(AUDIO_DAC)
+    LOG_BOOT("SPEAKER (prin amplificator):\r\n");
+    LOG_BOOT("  IN  -> PTE30 (DAC0_OUT)  GND -> GND\r\n");
+#else
+    LOG_BOOT("BUZZER:\r\n");
+    LOG_BOOT("  +   -> PTB2 (TPM2_CH0)   - -> GND\r\n");
+#endif
+    LOG_BOOT("==============\r\n\r\n");
     
-    /* Init Timer (SysTick + PIT) */
+#if defined(SDK_OS_FREE_RTOS)
+    /* Modulele se initializeaza din task-ul UI (App_Init), cu kernel-ul pornit */
+    PongRtos_Start();
+#else
+    /* Init Timer (SysTick) */
     Timer_Init();
     
-    /* Seed pentru random */
-    srand(g_systick_ms ^ 0xDEADBEEF);
-    
-    /* Init Module */
-    PRINTF("Initializing ST7735...\r\n");
-    ST7735_Init();
-    PRINTF("ST7735 OK!\r\n");
-    
-    PRINTF("Initializing Joystick...\r\n");
-    Joystick_Init();
-    PRINTF("Joystick OK!\r\n");
-    
-    PRINTF("Initializing IR Remote...\r\n");
-    IR_Init();
-    PRINTF("IR Remote OK!\r\n");
+    App_Init();
     
-    PRINTF("\r\n=== CONTROLS ===\r\n");
-    PRINTF("Joystick: Up/Down = Navigate, Press = Select\r\n");
-    PRINTF("Remote:   CH- = Up, CH = Down, PREV = Select\r\n");
-    PRINTF("In Game:  Joystick Button = Pause\r\n");
-    PRINTF("          Hold CH-/CH for continuous movement\r\n");
-    PRINTF("================\r\n\r\n");
-    
-    /* Deseneaza ecranul initial (intro animation) */
-    Menu_DrawCurrent();
-    
-    PRINTF(">>> System Ready! <<<\r\n\r\n");
-    
-    /* Main Loop */
-    while (1) {
-        /* Proceseaza input-urile - mereu */
-        Joystick_Process();
-        IR_Process();
-        
-        /* Comportament bazat pe ecranul curent */
-        switch (g_currentScreen) {
-            case SCREEN_GAMEPLAY:
-                /* In timpul jocului */
-                if (!Game_IsPaused()) {
-                    /* Verifica daca se cere pauza */
-                    CheckGamePause();
-                    
-                    /* Update joc la 50Hz (controlat de PIT) */
-                    if (g_update_game) {
-                        g_update_game = false;
-                        
-                        Game_Update();
-                        
-                        /* Verifica daca jocul s-a terminat */
-                        if (!Game_IsRunning() && Game_GetWinner() != 0) {
-                            PRINTF("\r\n=== GAME OVER ===\r\n");
-                            PRINTF("Winner: Player %d\r\n", Game_GetWinner());
-                            PRINTF("Score: %d - %d\r\n\r\n", 
-                                   Game_GetScore(1), Game_GetScore(2));
-                            
-                            /* Oprim timer-ul de joc */
-                            PIT_StopTimer(PIT, kPIT_Chnl_1);
-                            
-                            g_currentScreen = SCREEN_GAME_OVER;
-                            g_menuState.selectedIndex = 0;
-                            g_menuState.maxItems = 2;
-                            g_needsRedraw = 1;
-                        }
-                    }
-                }
-                break;
-                
-            case SCREEN_PAUSED:
-                /* In pauza - proceseaza meniul de pauza */
-                if (g_update_ui) {
-                    g_update_ui = false;
-                    ProcessPauseInput();
-                    
-                    if (g_needsRedraw && g_currentScreen == SCREEN_PAUSED) {
-                        Menu_DrawPauseScreen();
-                        g_needsRedraw = 0;
-                    }
-                }
-                break;
-                
-            default:
-                /* In meniu - update la 20Hz */
-                if (g_update_ui) {
-                    g_update_ui = false;
-                    ProcessMenuInput();
-                    
-                    if (g_needsRedraw) {
-                        Menu_DrawCurrent();
-                    }
-                    
-                    /* Daca s-a pornit jocul, activeaza timer-ul de joc */
-                    if (g_currentScreen == SCREEN_GAMEPLAY) {
-                        PIT_StartTimer(PIT, kPIT_Chnl_1);
-                    }
-                }
-                break;
-        }
-        
-        /* Economiseste energie cand nu e nimic de facut */
-        __WFI();
-    }
+    /* Task-urile inlocuiesc bucla principala */
+    Scheduler_Init();
+    Scheduler_Add(&input_task, true);
+    Scheduler_Add(&game_task, false);
+    Scheduler_Add(&ui_task, true);
+    Scheduler_Run();
+#endif
     
     return 0;
 }
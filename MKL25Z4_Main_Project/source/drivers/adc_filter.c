@@ -0,0 +1,40 @@
+/*
+ * adc_filter.c
+ * Filtru IIR de ordinul 1 in virgula fixa
+ *
+ * Doar adunari si shift-uri (Cortex-M0+ nu are impartire hardware).
+ */
+
+#include "headers/adc_filter.h"
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+void AdcFilter_Init(AdcFilter_t* f, uint8_t shift) {
+    f->state = 0;
+    f->shift = shift;
+    f->primed = false;
+}
+
+uint16_t AdcFilter_Feed(AdcFilter_t* f, uint16_t sample) {
+    int32_t x = (int32_t)sample << 16;
+
+    if (!f->primed) {
+        /* Fara rampa de la 0 la pornire */
+        f->state = x;
+        f->primed = true;
+    } else {
+        f->state += (x - f->state) >> f->shift;
+    }
+
+    return AdcFilter_Get(f);
+}
+
+void AdcFilter_SetShift(AdcFilter_t* f, uint8_t shift) {
+    f->shift = shift;
+}
+
+uint16_t AdcFilter_Get(const AdcFilter_t* f) {
+    return (uint16_t)((f->state + 0x8000) >> 16);
+}
@@ -0,0 +1,260 @@
+/*
+ * app.c
+ * Logica ecranelor: evenimente de input, meniuri, pauza, game over
+ *
+ * Nu stie cine o apeleaza - scheduler-ul cooperativ (MKL25Z4_Main_Project.c),
+ * task-urile FreeRTOS (pong_rtos.c) sau thread-urile Zephyr (zephyr/).
+ * Varianta furnizeaza doar App_SetGameRunning.
+ */
+
+#include "headers/app.h"
+#include "headers/st7735_simple.h"
+#include "headers/joystick.h"
+#include "headers/ir_remote.h"
+#include "headers/audio.h"
+#include "headers/menu.h"
+#include "headers/pong_game.h"
+#include "headers/settings.h"
+#include "headers/log.h"
+#include "headers/profiler.h"
+#include "fsl_debug_console.h"
+#include <stdlib.h>
+
+/*============================================================================
+ * GLOBAL VARIABLES
+ *============================================================================*/
+
+/* Variabile globale din game_config.h */
+InputType_t g_player1_input = INPUT_JOYSTICK;   /* Default: Joystick */
+InputType_t g_player2_input = INPUT_REMOTE;     /* Default: Telecomanda */
+Screen_t g_currentScreen = SCREEN_INTRO;
+MenuState_t g_menuState = {0, 3};
+volatile uint8_t g_needsRedraw = 1;
+Difficulty_t g_currentDifficulty = DIFF_NORMAL;
+
+/* Pause menu state */
+static uint8_t g_pause_selection = 0;
+
+/* Extern: timer global (SysTick / tick-ul RTOS) */
+extern volatile uint32_t g_systick_ms;
+
+/*============================================================================
+ * INPUT PROCESSING
+ *============================================================================*/
+
+/* Input pentru meniuri */
+static void HandleMenuEvent(const InputEvent_t* ev) {
+    switch ((UI_Action_t)ev->action) {
+        case ACTION_UP:
+            LOG("[UI] UP\r\n");
+            Menu_MoveUp();
+            break;
+            
+        case ACTION_DOWN:
+            LOG("[UI] DOWN\r\n");
+            Menu_MoveDown();
+            break;
+            
+        case ACTION_SELECT:
+            LOG("[UI] SELECT\r\n");
+            Menu_Select();
+            break;
+            
+        case ACTION_BACK:
+            LOG("[UI] BACK\r\n");
+            g_menuState.selectedIndex = g_menuState.maxItems - 1;
+            Menu_Select();
+            break;
+            
+        default:
+            break;
+    }
+    
+    /* Daca s-a pornit jocul, porneste si tick-ul de joc */
+    if (g_currentScreen == SCREEN_GAMEPLAY) {
+        App_SetGameRunning(true);
+    }
+}
+
+/* Input pentru ecranul de pauza */
+static void HandlePauseEvent(const InputEvent_t* ev) {
+    switch ((UI_Action_t)ev->action) {
+        case ACTION_UP:
+            g_pause_selection = 0;
+            g_needsRedraw = 1;
+            break;
+            
+        case ACTION_DOWN:
+            g_pause_selection = 1;
+            g_needsRedraw = 1;
+            break;
+            
+        case ACTION_SELECT:
+            if (g_pause_selection == 0) {
+                /* Resume */
+                LOG("[GAME] Resumed\r\n");
+                Game_SetPaused(false);
+                g_currentScreen = SCREEN_GAMEPLAY;
+                Game_DrawField();
+                Game_DrawScore();
+            } else {
+                /* Exit to menu */
+                LOG("[GAME] Exit to menu\r\n");
+                g_currentScreen = SCREEN_MAIN;
+                g_menuState.selectedIndex = 0;
+                g_menuState.maxItems = 3;
+                g_needsRedraw = 1;
+                
+                /* Oprim tick-ul de joc */
+                App_SetGameRunning(false);
+            }
+            break;
+            
+        default:
+            break;
+    }
+}
+
+/* In timpul jocului paletele citesc direct starea joystick/IR - evenimentele
+ * de meniu se arunca; butonul joystick = pauza */
+static void HandleGameplayEvent(const InputEvent_t* ev) {
+    if (ev->source == INPUT_SRC_BUTTON) {
+        LOG("[GAME] Paused\r\n");
+        Game_SetPaused(true);
+        g_currentScreen = SCREEN_PAUSED;
+        g_pause_selection = 0;
+        g_needsRedraw = 1;
+    }
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+void App_Init(void) {
+    /* Seed pentru random */
+    srand(g_systick_ms ^ 0xDEADBEEF);
+    
+    /* Mesajele din bucla principala (LOG) trec prin ring, nu prin PRINTF */
+    Log_Init();
+    
+    /* Init Module */
+    LOG_BOOT("Initializing ST7735...\r\n");
+    ST7735_Init();
+    LOG_BOOT("ST7735 OK!\r\n");
+    
+    LOG_BOOT("Initializing Joystick...\r\n");
+    Joystick_Init();
+    LOG_BOOT("Joystick OK!\r\n");
+    
+    LOG_BOOT("Initializing IR Remote...\r\n");
+    IR_Init();
+    LOG_BOOT("IR Remote OK!\r\n");
+    
+    LOG_BOOT("Initializing Audio...\r\n");
+    Audio_Init();
+    LOG_BOOT("Audio OK!\r\n");
+    
+    /* Setarile salvate inainte de primul ecran (meniul le afiseaza) */
+    Settings_Init();
+    
+    LOG_BOOT("\r\n=== CONTROLS ===\r\n");
+    LOG_BOOT("Joystick: Up/Down = Navigate, Press = Select\r\n");
+    LOG_BOOT("Remote:   CH- = Up, CH = Down, PREV = Select\r\n");
+    LOG_BOOT("In Game:  Joystick Button = Pause\r\n");
+    LOG_BOOT("          Hold CH-/CH for continuous movement\r\n");
+    LOG_BOOT("================\r\n\r\n");
+    
+    /* Deseneaza ecranul initial (intro animation) */
+    Menu_DrawCurrent();
+    
+    LOG_BOOT(">>> System Ready! <<<\r\n\r\n");
+}
+
+void App_HandleInput(const InputEvent_t* ev) {
+#if defined(PROFILER)
+    Screen_t screen = g_currentScreen;
+#endif
+    
+    switch (g_currentScreen) {
+        case SCREEN_GAMEPLAY:
+            HandleGameplayEvent(ev);
+            break;
+            
+        case SCREEN_PAUSED:
+            HandlePauseEvent(ev);
+            break;
+            
+        default:
+            HandleMenuEvent(ev);
+            break;
+    }
+    
+#if defined(PROFILER)
+    /* Latenta input -> ecran: un eveniment care schimba ecranul e masurat
+     * pana la App_Redraw, sau de acum daca handler-ul a desenat direct
+     * (reluarea din pauza, pornirea jocului - in joc App_Redraw nu deseneaza) */
+    if (g_needsRedraw || g_currentScreen != screen) {
+        Prof_LatencyTag(ev->source, ev->stamp_cycles);
+        if (!g_needsRedraw || g_currentScreen == SCREEN_GAMEPLAY) {
+            Prof_LatencyCommit(ST7735_IsBusy);
+        }
+    }
+#endif
+}
+
+void App_Redraw(void) {
+    /* Dump-ul profiler-ului (-DPROFILER) merge la ritmul ui-ului */
+    PROF_POLL();
+    
+    if (!g_needsRedraw) return;
+    
+    switch (g_currentScreen) {
+        case SCREEN_GAMEPLAY:
+            /* Jocul se deseneaza singur din Game_Update */
+            g_needsRedraw = 0;
+            break;
+            
+        case SCREEN_PAUSED:
+            Menu_DrawPauseScreen();
+            PROF_LATENCY_COMMIT(ST7735_IsBusy);
+            g_needsRedraw = 0;
+            break;
+            
+        default:
+            Menu_DrawCurrent();
+            PROF_LATENCY_COMMIT(ST7735_IsBusy);
+            
+            /* Flash-ul se scrie doar aici, pe ecranele de meniu: cu SPI-ul
+             * liber, DMA-ul display-ului nu citeste din flash in timpul
+             * unei comenzi */
+            if (Settings_Changed()) {
+                ST7735_WaitIdle();
+                Settings_Flush();
+            }
+            break;
+    }
+}
+
+bool App_GameTick(void) {
+    if (Game_IsPaused()) return true;
+    
+    Game_Update();
+    
+    return Game_IsRunning() || Game_GetWinner() == 0;
+}
+
+void App_GameOver(void) {
+    LOG("\r\n=== GAME OVER ===\r\n");
+    LOG("Winner: Player %d\r\n", Game_GetWinner());
+    LOG("Score: %d - %d\r\n\r\n", 
+        Game_GetScore(1), Game_GetScore(2));
+    
+    /* Salvat la desenarea ecranului de game over */
+    Settings_RecordMatch(Game_GetWinner(), (uint8_t)Game_GetScore(1), (uint8_t)Game_GetScore(2));
+    
+    g_currentScreen = SCREEN_GAME_OVER;
+    g_menuState.selectedIndex = 0;
+    g_menuState.maxItems = 2;
+    g_needsRedraw = 1;
+}
@@ -0,0 +1,147 @@
+/*
+ * audio.c
+ * Secventiatorul de efecte sonore - partea independenta de hardware
+ *
+ * Audio_Play porneste prima nota si se intoarce; fiecare nota urmatoare e
+ * pornita din Audio_NoteDone, apelat de port la expirarea timerului de
+ * nota. Bucla principala nu asteapta niciodata dupa buzzer (varianta din
+ * TestProjects/MKL25Z4_Pizeo_Buzzer facea busy-wait pe toata durata).
+ */
+
+#include "headers/audio.h"
+#include "headers/songs.h"
+#include <stddef.h>
+
+/*============================================================================
+ * EFFECTS
+ * Melodiile sunt in songs/<nume>.song, compilate de host/songc in songs.c
+ *============================================================================*/
+
+typedef struct {
+    const uint8_t* song;
+    uint8_t priority;       /* Un efect intrerupe doar prioritati <= a lui */
+    SynthWave_t wave;       /* Timbrul pe DAC; buzzer-ul canta doar dreptunghi */
+    uint8_t volume;
+} AudioTrack_t;
+
+static const AudioTrack_t tracks[AUDIO_FX_COUNT] = {
+    [AUDIO_FX_PADDLE]    = { song_paddle,    0, SYNTH_WAVE_SQUARE,   160 },
+    [AUDIO_FX_WALL]      = { song_wall,      0, SYNTH_WAVE_TRIANGLE, 160 },
+    [AUDIO_FX_GOAL]      = { song_goal,      2, SYNTH_WAVE_SINE,     SYNTH_VOLUME_MAX },
+    [AUDIO_FX_SPEED_UP]  = { song_speed_up,  1, SYNTH_WAVE_TRIANGLE, SYNTH_VOLUME_MAX },
+    [AUDIO_FX_GAME_OVER] = { song_game_over, 3, SYNTH_WAVE_SQUARE,   SYNTH_VOLUME_MAX },
+};
+
+/*============================================================================
+ * GLOBAL VARIABLES
+ *============================================================================*/
+
+typedef struct {
+    const AudioTrack_t* volatile track;     /* NULL = voce libera */
+    SongPlayer_t player;
+} AudioVoice_t;
+
+/* Scrise din Audio_Play (intreruperea de nota mascata) si din ISR */
+static AudioVoice_t voices[AUDIO_VOICES];
+static AudioStats_t stats;
+
+/*============================================================================
+ * PRIVATE FUNCTIONS
+ *============================================================================*/
+
+/* O nota = un octet decodat; la sfarsitul melodiei vocea se opreste */
+static void Audio_NextNote(uint8_t voice) {
+    AudioVoice_t* v = &voices[voice];
+    SongNote_t note;
+
+    if (Song_Next(&v->player, &note)) {
+        stats.notes++;
+        Audio_HwNote(voice, note.period, note.ms);
+    } else {
+        v->track = NULL;
+        Audio_HwStop(voice);
+    }
+}
+
+/* Vocea pe care canta track: aceeasi melodie, o voce libera sau cea mai
+ * putin importanta; AUDIO_VOICES daca toate au prioritate mai mare */
+static uint8_t Audio_PickVoice(const AudioTrack_t* track) {
+    uint8_t pick = AUDIO_VOICES;
+
+    for (uint8_t i = 0; i < AUDIO_VOICES; i++) {
+        if (voices[i].track == track) return i;
+    }
+    for (uint8_t i = 0; i < AUDIO_VOICES; i++) {
+        if (voices[i].track == NULL) return i;
+    }
+    for (uint8_t i = 0; i < AUDIO_VOICES; i++) {
+        if (voices[i].track->priority <= track->priority &&
+            (pick == AUDIO_VOICES || voices[i].track->priority < voices[pick].track->priority)) {
+            pick = i;
+        }
+    }
+    return pick;
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+void Audio_Init(void) {
+    for (uint8_t i = 0; i < AUDIO_VOICES; i++) {
+        voices[i].track = NULL;
+    }
+    Audio_HwInit();
+}
+
+void Audio_Play(AudioEffect_t fx) {
+    if (fx >= AUDIO_FX_COUNT) return;
+    const AudioTrack_t* track = &tracks[fx];
+
+    Audio_HwMaskIrq(true);
+    uint8_t voice = Audio_PickVoice(track);
+    if (voice == AUDIO_VOICES) {
+        stats.dropped++;
+    } else {
+        AudioVoice_t* v = &voices[voice];
+        if (v->track != NULL) stats.preempted++;
+        stats.played++;
+        v->track = track;
+        Song_Start(&v->player, track->song);
+        Audio_HwTimbre(voice, track->wave, track->volume);
+        Audio_NextNote(voice);
+    }
+    Audio_HwMaskIrq(false);
+}
+
+void Audio_Stop(void) {
+    Audio_HwMaskIrq(true);
+    for (uint8_t i = 0; i < AUDIO_VOICES; i++) {
+        voices[i].track = NULL;
+        Audio_HwStop(i);
+    }
+    Audio_HwMaskIrq(false);
+}
+
+bool Audio_IsPlaying(void) {
+    for (uint8_t i = 0; i < AUDIO_VOICES; i++) {
+        if (voices[i].track != NULL) return true;
+    }
+    return false;
+}
+
+const uint8_t* Audio_GetSong(AudioEffect_t fx) {
+    return (fx < AUDIO_FX_COUNT) ? tracks[fx].song : NULL;
+}
+
+void Audio_GetStats(AudioStats_t* out) {
+    Audio_HwMaskIrq(true);
+    *out = stats;
+    Audio_HwMaskIrq(false);
+}
+
+void Audio_NoteDone(uint8_t voice) {
+    if (voice >= AUDIO_VOICES || voices[voice].track == NULL) return;
+
+    Audio_NextNote(voice);
+}
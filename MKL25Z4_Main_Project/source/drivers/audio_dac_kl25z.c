@@ -0,0 +1,200 @@
+/*
+ * audio_dac_kl25z.c
+ * Sunet polifonic pe DAC0 cu DMA, pe FRDM-KL25Z (build cu -DAUDIO_DAC)
+ * Pin: PTE30 (DAC0_OUT, functie analogica implicita) -> amplificator/difuzor
+ *
+ * Fiecare efect canta pe vocea lui din synth.h. DMA canal 2 copiaza un
+ * esantion de 16 biti in DAC0_DAT0 la fiecare overflow TPM2, adica la
+ * SYNTH_SAMPLE_HZ, dintr-un buffer circular de doua blocuri (SMOD): cat
+ * timp un bloc e redat, celalalt e mixat. Intreruperea DMA de la sfarsitul
+ * fiecarui bloc reincarca BCR (inainte de urmatorul overflow) si mixeaza
+ * blocul abia terminat. Durata notelor e numarata de mixer in esantioane,
+ * deci PIT canal 1 ramane liber, iar TPM2 doar da ritmul (PTB2 nefolosit).
+ *
+ * O nota pornita din Audio_Play intra in urmatorul bloc mixat: cel mult
+ * doua blocuri de intarziere cand sunetul ruleaza deja. Dupa doua blocuri
+ * fara nicio voce, TPM2 si DMA-ul se opresc, iar DAC-ul ramane la mijloc.
+ *
+ * La o schimbare RUN/VLPR se recalculeaza doar MOD-ul TPM2 (48 MHz sau
+ * 4 MHz / SYNTH_SAMPLE_HZ), rata de esantionare nu se schimba. In VLPR
+ * mixarea costa mai mult din CPU (pong_bench -m da ciclii per esantion).
+ */
+
+#if defined(AUDIO_DAC)
+
+#include "headers/audio.h"
+#include "headers/synth.h"
+#include "headers/power.h"
+#include "headers/run_mode.h"
+#include "headers/log.h"
+#include "MKL25Z4.h"
+#include "fsl_clock.h"
+#include "fsl_debug_console.h"
+
+/*============================================================================
+ * HARDWARE CONFIGURATION
+ *============================================================================*/
+
+#define AUDIO_TPM           TPM2
+#define AUDIO_DMA_CH        2U          /* 0 si 1 sunt ale display-ului */
+#define AUDIO_DMA_IRQ       DMA2_IRQn
+
+/* Doua blocuri de esantioane pe 16 biti = 256 octeti, SMOD = 5 */
+#define AUDIO_BLOCK_BYTES   (SYNTH_BLOCK * 2U)
+#define AUDIO_BUFFER_BYTES  (2U * AUDIO_BLOCK_BYTES)
+#define AUDIO_DMA_SMOD      5U
+
+/* Sursa TPM la pornire (BOARD_BootClockRUN) */
+#define AUDIO_TPM_BOOT_HZ   48000000U
+
+/*============================================================================
+ * NOTE -> VOICE
+ * Pasul de faza pentru perioada p (ticuri la SONG_TONE_HZ):
+ *   2^32 * SONG_TONE_HZ / (SYNTH_SAMPLE_HZ * p)
+ * calculat ca (375 << 22) / p << 10 - o impartire pe 32 de biti per nota,
+ * nimic per esantion
+ *============================================================================*/
+
+#define AUDIO_STEP_Q22          ((SONG_TONE_HZ / SYNTH_SAMPLE_HZ) << 22)
+#define AUDIO_SAMPLES_PER_MS    (SYNTH_SAMPLE_HZ / 1000U)
+#define AUDIO_LATENCY_MS        (2U * SYNTH_BLOCK / AUDIO_SAMPLES_PER_MS)
+
+/*============================================================================
+ * GLOBAL VARIABLES
+ *============================================================================*/
+
+static uint16_t samples[2U * SYNTH_BLOCK] __attribute__((aligned(AUDIO_BUFFER_BYTES)));
+static uint8_t next_block;          /* Blocul pe care il termina urmatoarea intrerupere */
+static uint8_t silent_blocks;
+static volatile bool streaming;
+
+/*============================================================================
+ * PRIVATE FUNCTIONS
+ *============================================================================*/
+
+static void Audio_StopStream(void) {
+    AUDIO_TPM->SC = 0;
+    DMA0->DMA[AUDIO_DMA_CH].DCR = 0;
+    DMA0->DMA[AUDIO_DMA_CH].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+    streaming = false;
+}
+
+/* Ambele blocuri sunt mixate inainte de primul overflow */
+static void Audio_StartStream(void) {
+    streaming = true;
+    silent_blocks = 0;
+    next_block = 0;
+    Synth_Mix(&samples[0], SYNTH_BLOCK);
+    Synth_Mix(&samples[SYNTH_BLOCK], SYNTH_BLOCK);
+
+    DMA0->DMA[AUDIO_DMA_CH].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+    DMA0->DMA[AUDIO_DMA_CH].SAR = (uint32_t)samples;
+    DMA0->DMA[AUDIO_DMA_CH].DAR = (uint32_t)&DAC0->DAT[0];
+    DMA0->DMA[AUDIO_DMA_CH].DSR_BCR = DMA_DSR_BCR_BCR(AUDIO_BLOCK_BYTES);
+    DMA0->DMA[AUDIO_DMA_CH].DCR = DMA_DCR_EINT_MASK | DMA_DCR_ERQ_MASK | DMA_DCR_CS_MASK |
+                                  DMA_DCR_SINC_MASK | DMA_DCR_SSIZE(2) | DMA_DCR_DSIZE(2) |
+                                  DMA_DCR_SMOD(AUDIO_DMA_SMOD);
+
+    AUDIO_TPM->CNT = 0;
+    AUDIO_TPM->SC = TPM_SC_DMA_MASK | TPM_SC_CMOD(1);
+}
+
+/* Doar perioada esantioanelor; un flux in curs continua de unde era */
+static void Audio_OnRunMode(const RunModeClocks_t* clocks) {
+    uint32_t sc = AUDIO_TPM->SC;
+
+    AUDIO_TPM->SC = 0;
+    AUDIO_TPM->MOD = clocks->tpm_hz / SYNTH_SAMPLE_HZ - 1U;
+    AUDIO_TPM->CNT = 0;
+    AUDIO_TPM->SC = sc;
+}
+
+/*============================================================================
+ * INTERRUPT HANDLER - Sfarsit de bloc
+ *============================================================================*/
+
+void DMA2_IRQHandler(void) {
+    DMA0->DMA[AUDIO_DMA_CH].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+
+    /* Blocul terminat si cel din DMA sunt liniste: nimic de cantat */
+    if (silent_blocks >= 2U) {
+        Audio_StopStream();
+        return;
+    }
+    DMA0->DMA[AUDIO_DMA_CH].DSR_BCR = DMA_DSR_BCR_BCR(AUDIO_BLOCK_BYTES);
+
+    uint16_t* block = &samples[next_block * SYNTH_BLOCK];
+    next_block ^= 1U;
+    if (Synth_Mix(block, SYNTH_BLOCK) != 0) {
+        silent_blocks = 0;
+    } else {
+        silent_blocks++;
+    }
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+void Audio_HwTimbre(uint8_t voice, SynthWave_t wave, uint8_t volume) {
+    Synth_SetVoice(voice, wave, volume);
+}
+
+void Audio_HwNote(uint8_t voice, uint16_t period, uint16_t ms) {
+    uint32_t step = (period == 0) ? 0 : (AUDIO_STEP_Q22 / period) << 10;
+
+    Synth_Note(voice, step, (uint32_t)ms * AUDIO_SAMPLES_PER_MS);
+    Power_StayAwake(ms + AUDIO_LATENCY_MS);
+    if (!streaming) {
+        Audio_StartStream();
+    }
+}
+
+void Audio_HwStop(uint8_t voice) {
+    Synth_Stop(voice);
+}
+
+void Audio_HwMaskIrq(bool masked) {
+    if (masked) {
+        DisableIRQ(AUDIO_DMA_IRQ);
+    } else {
+        EnableIRQ(AUDIO_DMA_IRQ);
+    }
+}
+
+void Audio_HwInit(void) {
+    /* Enable clocks */
+    CLOCK_EnableClock(kCLOCK_Dac0);
+    CLOCK_EnableClock(kCLOCK_Tpm2);
+    CLOCK_EnableClock(kCLOCK_Dmamux0);
+    CLOCK_EnableClock(kCLOCK_Dma0);
+
+    /* DAC0: referinta VDDA, fara buffer intern - DAT0 e iesirea */
+    DAC0->C1 = 0;
+    DAC0->C0 = DAC_C0_DACEN_MASK | DAC_C0_DACRFS_MASK;
+    DAC0->DAT[0].DATL = (uint8_t)(SYNTH_DAC_MID & 0xFFU);
+    DAC0->DAT[0].DATH = (uint8_t)(SYNTH_DAC_MID >> 8);
+
+    Synth_Init(Audio_NoteDone);
+    streaming = false;
+
+    /* TPM2: MCGPLLCLK/2 = 48MHz, overflow la SYNTH_SAMPLE_HZ */
+    CLOCK_SetTpmClock(1U);
+    AUDIO_TPM->SC = 0;
+    AUDIO_TPM->MOD = AUDIO_TPM_BOOT_HZ / SYNTH_SAMPLE_HZ - 1U;
+
+    DMAMUX0->CHCFG[AUDIO_DMA_CH] = 0;
+    DMAMUX0->CHCFG[AUDIO_DMA_CH] = DMAMUX_CHCFG_ENBL_MASK |
+                                   DMAMUX_CHCFG_SOURCE(kDmaRequestMux0TPM2Overflow & 0xFF);
+
+    /* BCR trebuie reincarcat intr-o perioada de esantion */
+    NVIC_SetPriority(AUDIO_DMA_IRQ, 1);
+    EnableIRQ(AUDIO_DMA_IRQ);
+
+    RunMode_AddListener(Audio_OnRunMode);
+
+    LOG_BOOT("[Audio] Initialized on PTE30 with DAC0, DMA ch%u paced by TPM2 at %u Hz, %u voices\r\n",
+             AUDIO_DMA_CH, SYNTH_SAMPLE_HZ, SYNTH_VOICES);
+}
+
+#endif /* AUDIO_DAC */
@@ -0,0 +1,196 @@
+/*
+ * audio_kl25z.c
+ * Partea hardware a buzzer-ului pe FRDM-KL25Z
+ * Pin: PTB2 (TPM2_CH0, PWM edge-aligned, factor de umplere 50%)
+ *
+ * Proiectul de test (TestProjects/MKL25Z4_Pizeo_Buzzer) folosea TPM1_CH0
+ * pe PTB0, dar TPM1 e ocupat de receptorul IR, iar TPM0 da ritmul ADC-ului.
+ * Durata notei e numarata de PIT canal 1 in mod one-shot: o intrerupere
+ * la sfarsitul fiecarei note, care porneste urmatoarea (audio.c).
+ *
+ * In VLPS TPM2 si PIT stau pe loc, deci fiecare nota tine CPU-ul treaz
+ * (Power_StayAwake). La o schimbare RUN/VLPR prescaler-ul TPM2 si
+ * perioada PIT sunt recalculate, iar restul notei curente e reluat.
+ *
+ * Portul implicit; cu -DAUDIO_DAC il inlocuieste audio_dac_kl25z.c.
+ */
+
+#if !defined(AUDIO_DAC)
+
+#include "headers/audio.h"
+#include "headers/power.h"
+#include "headers/run_mode.h"
+#include "headers/log.h"
+#include "MKL25Z4.h"
+#include "fsl_port.h"
+#include "fsl_pit.h"
+#include "fsl_clock.h"
+#include "fsl_debug_console.h"
+
+/*============================================================================
+ * HARDWARE CONFIGURATION
+ *============================================================================*/
+
+#define AUDIO_PIN           2U
+#define AUDIO_PORT          PORTB
+#define AUDIO_TPM           TPM2
+#define AUDIO_TPM_CHANNEL   0U
+#define AUDIO_PIT_CHANNEL   kPIT_Chnl_1
+
+/* PTB2 ALT3 = TPM2_CH0 */
+#define AUDIO_PIN_MUX       kPORT_MuxAlt3
+
+/*============================================================================
+ * TIMER
+ * RUN:  TPM2 @ 48MHz / 8 = 6MHz = SONG_TONE_HZ, MOD = perioada - 1
+ * VLPR: TPM2 @ 4MHz / 1 = 4MHz, perioada scalata cu 4/6 (Q16, fara impartire)
+ * Ceasul numaratorului nu trece de SONG_TONE_HZ, deci MOD incape in 16 biti.
+ *============================================================================*/
+
+/* Sursa TPM si bus-ul la pornire (BOARD_BootClockRUN) */
+#define AUDIO_TPM_BOOT_HZ   48000000U
+#define AUDIO_BUS_BOOT_HZ   24000000U
+
+/*============================================================================
+ * GLOBAL VARIABLES
+ *============================================================================*/
+
+static uint8_t tpm_prescaler;
+static uint32_t tone_scale_q16;     /* Ceasul TPM2 dupa prescaler / SONG_TONE_HZ */
+static uint32_t pit_ticks_per_ms;
+static uint16_t note_period;        /* Nota curenta, pentru reluare la schimbarea de mod */
+
+/*============================================================================
+ * INTERRUPT HANDLER - Sfarsit de nota
+ *============================================================================*/
+
+void Audio_HwPitIrq(void) {
+    if (!(PIT_GetStatusFlags(PIT, AUDIO_PIT_CHANNEL) & kPIT_TimerFlag)) return;
+
+    PIT_ClearStatusFlags(PIT, AUDIO_PIT_CHANNEL, kPIT_TimerFlag);
+    PIT_StopTimer(PIT, AUDIO_PIT_CHANNEL);
+    Audio_NoteDone(0);
+}
+
+#if !defined(SDK_OS_FREE_RTOS)
+void PIT_IRQHandler(void) {
+    Audio_HwPitIrq();
+}
+#endif
+
+/*============================================================================
+ * PRIVATE FUNCTIONS
+ *============================================================================*/
+
+/* Cel mai mic prescaler care aduce TPM2 sub SONG_TONE_HZ; impartirile
+ * se fac doar aici, o data per schimbare de mod */
+static void Audio_SetTimebase(uint32_t tpm_hz, uint32_t bus_hz) {
+    uint8_t ps = 0;
+    while (ps < 7U && (tpm_hz >> ps) > SONG_TONE_HZ) ps++;
+
+    tpm_prescaler = ps;
+    tone_scale_q16 = (uint32_t)(((uint64_t)(tpm_hz >> ps) << 16) / SONG_TONE_HZ);
+    pit_ticks_per_ms = bus_hz / 1000U;
+}
+
+/* MOD si CnV sunt scrise cu timerul oprit, ca sa intre imediat in vigoare */
+static void Audio_StartTone(uint16_t song_period) {
+    AUDIO_TPM->SC = 0;
+    if (song_period == 0) {
+        AUDIO_TPM->CONTROLS[AUDIO_TPM_CHANNEL].CnSC = 0;
+        return;
+    }
+
+    uint32_t period = (song_period * tone_scale_q16) >> 16;
+    AUDIO_TPM->MOD = period - 1U;
+    AUDIO_TPM->CONTROLS[AUDIO_TPM_CHANNEL].CnSC = TPM_CnSC_MSB_MASK | TPM_CnSC_ELSB_MASK;
+    AUDIO_TPM->CONTROLS[AUDIO_TPM_CHANNEL].CnV = period / 2U;
+    AUDIO_TPM->CNT = 0;
+    AUDIO_TPM->SC = TPM_SC_PS(tpm_prescaler) | TPM_SC_CMOD(1);
+}
+
+static void Audio_StartTimer(uint32_t ms) {
+    PIT_StopTimer(PIT, AUDIO_PIT_CHANNEL);
+    PIT_ClearStatusFlags(PIT, AUDIO_PIT_CHANNEL, kPIT_TimerFlag);
+    PIT_SetTimerPeriod(PIT, AUDIO_PIT_CHANNEL, ms * pit_ticks_per_ms - 1U);
+    PIT_StartTimer(PIT, AUDIO_PIT_CHANNEL);
+
+    Power_StayAwake(ms);
+}
+
+/* Nota curenta continua cu ceasurile noi, cat mai avea din durata */
+static void Audio_OnRunMode(const RunModeClocks_t* clocks) {
+    bool playing = (PIT->CHANNEL[AUDIO_PIT_CHANNEL].TCTRL & PIT_TCTRL_TEN_MASK) != 0;
+    uint32_t left_ms = 0;
+
+    if (playing) {
+        left_ms = PIT->CHANNEL[AUDIO_PIT_CHANNEL].CVAL / pit_ticks_per_ms + 1U;
+    }
+
+    Audio_SetTimebase(clocks->tpm_hz, clocks->bus_hz);
+    if (playing) {
+        Audio_StartTone(note_period);
+        Audio_StartTimer(left_ms);
+    }
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+/* Un singur ton, dreptunghiular: timbrul nu se poate schimba */
+void Audio_HwTimbre(uint8_t voice, SynthWave_t wave, uint8_t volume) {
+}
+
+void Audio_HwNote(uint8_t voice, uint16_t period, uint16_t ms) {
+    note_period = period;
+    Audio_StartTone(period);
+    Audio_StartTimer(ms);
+}
+
+void Audio_HwStop(uint8_t voice) {
+    PIT_StopTimer(PIT, AUDIO_PIT_CHANNEL);
+    AUDIO_TPM->SC = 0;
+    AUDIO_TPM->CONTROLS[AUDIO_TPM_CHANNEL].CnSC = 0;
+}
+
+void Audio_HwMaskIrq(bool masked) {
+    if (masked) {
+        DisableIRQ(PIT_IRQn);
+    } else {
+        EnableIRQ(PIT_IRQn);
+    }
+}
+
+void Audio_HwInit(void) {
+    pit_config_t pitConfig;
+
+    /* Enable clocks */
+    CLOCK_EnableClock(kCLOCK_PortB);
+    CLOCK_EnableClock(kCLOCK_Tpm2);
+    CLOCK_EnableClock(kCLOCK_Pit0);
+
+    /* PTB2 -> TPM2_CH0 */
+    PORT_SetPinMux(AUDIO_PORT, AUDIO_PIN, AUDIO_PIN_MUX);
+
+    /* Clock source: MCGPLLCLK/2 = 48MHz, prescaler /8 = 6MHz */
+    CLOCK_SetTpmClock(1U);
+    Audio_SetTimebase(AUDIO_TPM_BOOT_HZ, AUDIO_BUS_BOOT_HZ);
+    AUDIO_TPM->SC = 0;
+    AUDIO_TPM->CONTROLS[AUDIO_TPM_CHANNEL].CnSC = 0;
+
+    /* PIT ch1: one-shot, oprit pana la prima nota */
+    PIT_GetDefaultConfig(&pitConfig);
+    PIT_Init(PIT, &pitConfig);
+    PIT_StopTimer(PIT, AUDIO_PIT_CHANNEL);
+    PIT_EnableInterrupts(PIT, AUDIO_PIT_CHANNEL, kPIT_TimerInterruptEnable);
+
+    NVIC_SetPriority(PIT_IRQn, 2);
+    EnableIRQ(PIT_IRQn);
+
+    RunMode_AddListener(Audio_OnRunMode);
+
+    LOG_BOOT("[Audio] Initialized on PTB2 with TPM2_CH0 PWM, PIT ch1 note timer\r\n");
+}
+
+#endif /* !AUDIO_DAC */
@@ -0,0 +1,336 @@
+/*
+ * compositor.c
+ * Compozitor dirty-rectangle pentru ecranul de joc
+ *
+ * Fiecare frame colecteaza zonele modificate (sprite mutat, scor schimbat,
+ * overlay sters), le uneste cand se suprapun sau cand o fereastra comuna
+ * e mai ieftina, apoi compune fundalul + sprite-urile rand cu rand intr-un
+ * strip de RAM si il trimite cu ST7735_BlitAsync. Doua strip-uri alterneaza:
+ * CPU-ul compune in unul in timp ce DMA-ul il goleste pe celalalt.
+ */
+
+#include <stddef.h>
+#include "headers/compositor.h"
+#include "headers/st7735_simple.h"
+#include "headers/profiler.h"
+
+/*============================================================================
+ * BACKGROUND LAYOUT (identic cu Game_DrawField / Game_DrawScore)
+ *============================================================================*/
+
+#define CENTER_LINE_X       79
+#define CENTER_LINE_W       2
+#define CENTER_DASH_Y0      4
+#define CENTER_DASH_H       4
+#define CENTER_DASH_STEP    8       /* Putere a lui 2 - folosit ca masca */
+#define CENTER_DASH_END     (FIELD_HEIGHT - 4)
+
+/* Zona scorului - fundal negru, acopera linia centrala */
+#define SCORE_AREA_X        55
+#define SCORE_AREA_W        50
+#define SCORE_AREA_H        10
+#define SCORE_P1_X          68
+#define SCORE_SEP_X         77
+#define SCORE_P2_X          86
+
+#define WINDOW_CMD_BYTES    11      /* CASET + 4, RASET + 4, RAMWR */
+
+/*============================================================================
+ * TYPES
+ *============================================================================*/
+
+/* Dreptunghi cu coordonate inclusive, deja decupat la ecran */
+typedef struct {
+    int16_t x0, y0, x1, y1;
+} Box_t;
+
+typedef struct {
+    int16_t x, y, w, h;
+    uint16_t color;
+    bool visible;
+} Sprite_t;
+
+typedef struct {
+    int16_t x;
+    char text[4];
+    uint16_t color;
+} Label_t;
+
+enum { LABEL_P1 = 0, LABEL_SEP, LABEL_P2, NUM_LABELS };
+
+/*============================================================================
+ * STATE
+ *============================================================================*/
+
+static Sprite_t sprites[COMP_MAX_SPRITES];
+static Label_t labels[NUM_LABELS];
+static int16_t score_p1 = -1, score_p2 = -1;
+
+static Box_t dirty[COMP_MAX_DIRTY];
+static uint8_t dirty_count = 0;
+
+static uint8_t strip_buf[COMP_STRIP_BUFFERS][COMP_STRIP_PIXELS * 2];
+static volatile bool strip_busy[COMP_STRIP_BUFFERS];
+static uint8_t strip_next = 0;
+
+static uint32_t last_frame_bytes = 0;
+
+/*============================================================================
+ * DIRTY RECTANGLES
+ *============================================================================*/
+
+static inline uint32_t BoxCost(const Box_t *b) {
+    return (uint32_t)(b->x1 - b->x0 + 1) * (b->y1 - b->y0 + 1) * 2 + COMP_WINDOW_COST;
+}
+
+static inline Box_t BoxUnion(const Box_t *a, const Box_t *b) {
+    Box_t u;
+    u.x0 = a->x0 < b->x0 ? a->x0 : b->x0;
+    u.y0 = a->y0 < b->y0 ? a->y0 : b->y0;
+    u.x1 = a->x1 > b->x1 ? a->x1 : b->x1;
+    u.y1 = a->y1 > b->y1 ? a->y1 : b->y1;
+    return u;
+}
+
+static inline bool BoxOverlap(const Box_t *a, const Box_t *b) {
+    return a->x0 <= b->x1 && b->x0 <= a->x1 && a->y0 <= b->y1 && b->y0 <= a->y1;
+}
+
+static void RemoveDirty(uint8_t i) {
+    dirty[i] = dirty[--dirty_count];
+}
+
+static void AddDirty(int16_t x, int16_t y, int16_t w, int16_t h) {
+    Box_t box = { x, y, x + w - 1, y + h - 1 };
+
+    if (box.x0 < 0) box.x0 = 0;
+    if (box.y0 < 0) box.y0 = 0;
+    if (box.x1 >= ST7735_WIDTH) box.x1 = ST7735_WIDTH - 1;
+    if (box.y1 >= ST7735_HEIGHT) box.y1 = ST7735_HEIGHT - 1;
+    if (box.x0 > box.x1 || box.y0 > box.y1) return;
+
+    /* Unim cu orice zona suprapusa sau pentru care o singura fereastra e mai ieftina */
+    uint8_t i = 0;
+    while (i < dirty_count) {
+        Box_t u = BoxUnion(&dirty[i], &box);
+        if (BoxOverlap(&dirty[i], &box) || BoxCost(&u) <= BoxCost(&dirty[i]) + BoxCost(&box)) {
+            box = u;
+            RemoveDirty(i);
+            i = 0;      /* Zona a crescut - reverificam tot */
+        } else {
+            i++;
+        }
+    }
+
+    /* Lista plina - unim cu zona care creste costul cel mai putin */
+    while (dirty_count >= COMP_MAX_DIRTY) {
+        uint8_t best = 0;
+        uint32_t best_extra = UINT32_MAX;
+        for (i = 0; i < dirty_count; i++) {
+            Box_t u = BoxUnion(&dirty[i], &box);
+            uint32_t extra = BoxCost(&u) - BoxCost(&dirty[i]);
+            if (extra < best_extra) {
+                best_extra = extra;
+                best = i;
+            }
+        }
+        box = BoxUnion(&dirty[best], &box);
+        RemoveDirty(best);
+    }
+
+    dirty[dirty_count++] = box;
+}
+
+/*============================================================================
+ * COMPOSITION
+ *============================================================================*/
+
+static inline void PutPixel(uint8_t *row, int16_t i, uint16_t color) {
+    row[i * 2] = color >> 8;
+    row[i * 2 + 1] = color & 0xFF;
+}
+
+/* Umple [from, to] (coordonate ecran) intersectat cu randul [x0, x1] */
+static void PutSpan(uint8_t *row, int16_t x0, int16_t x1, int16_t from, int16_t to, uint16_t color) {
+    if (from < x0) from = x0;
+    if (to > x1) to = x1;
+    for (int16_t x = from; x <= to; x++) {
+        PutPixel(row, x - x0, color);
+    }
+}
+
+static void ComposeLabel(uint8_t *row, int16_t x0, int16_t x1, const Label_t *label, uint8_t glyph_row) {
+    int16_t px = label->x;
+    for (const char *c = label->text; *c; c++, px += FONT_WIDTH) {
+        const uint8_t *glyph = ST7735_GetGlyph(*c);
+        if (glyph == NULL) continue;
+        for (uint8_t col = 0; col < 5; col++) {
+            int16_t x = px + col;
+            if (x >= x0 && x <= x1 && (glyph[col] & (1 << glyph_row))) {
+                PutPixel(row, x - x0, label->color);
+            }
+        }
+    }
+}
+
+/* Compune un rand de ecran [x0, x1] la inaltimea y: fundal, apoi sprite-uri */
+static void ComposeRow(uint8_t *row, int16_t x0, int16_t x1, int16_t y) {
+    bool border = (y == 0 || y == FIELD_HEIGHT - 1);
+    PutSpan(row, x0, x1, x0, x1, border ? COLOR_WHITE : COLOR_BLACK);
+
+    if (!border) {
+        bool in_score = (y >= SCORE_Y && y < SCORE_Y + SCORE_AREA_H);
+
+        if (in_score) {
+            if (y < SCORE_Y + 7 && x1 >= SCORE_AREA_X && x0 < SCORE_AREA_X + SCORE_AREA_W) {
+                for (uint8_t i = 0; i < NUM_LABELS; i++) {
+                    ComposeLabel(row, x0, x1, &labels[i], y - SCORE_Y);
+                }
+            }
+        } else if (y >= CENTER_DASH_Y0 && y < CENTER_DASH_END &&
+                   ((y - CENTER_DASH_Y0) & (CENTER_DASH_STEP - 1)) < CENTER_DASH_H) {
+            PutSpan(row, x0, x1, CENTER_LINE_X, CENTER_LINE_X + CENTER_LINE_W - 1, COLOR_DARK_GRAY);
+        }
+    }
+
+    for (uint8_t i = 0; i < COMP_MAX_SPRITES; i++) {
+        const Sprite_t *s = &sprites[i];
+        if (s->visible && y >= s->y && y < s->y + s->h) {
+            PutSpan(row, x0, x1, s->x, s->x + s->w - 1, s->color);
+        }
+    }
+}
+
+/*============================================================================
+ * STRIP BUFFERS
+ *============================================================================*/
+
+static void StripDone(void *ctx) {
+    *(volatile bool *)ctx = false;
+}
+
+static uint8_t* AcquireStrip(volatile bool **busy_flag) {
+    uint8_t idx = strip_next;
+    strip_next = (strip_next + 1) % COMP_STRIP_BUFFERS;
+
+    /* Buffer-ul inca e citit de DMA - asteptam */
+    while (strip_busy[idx]);
+
+    strip_busy[idx] = true;
+    *busy_flag = &strip_busy[idx];
+    return strip_buf[idx];
+}
+
+static void FlushBox(const Box_t *b) {
+    int16_t w = b->x1 - b->x0 + 1;
+    int16_t rows = COMP_STRIP_PIXELS / w;
+
+    for (int16_t y = b->y0; y <= b->y1; y += rows) {
+        int16_t h = (b->y1 - y + 1 < rows) ? (b->y1 - y + 1) : rows;
+        volatile bool *busy;
+        uint8_t *buf = AcquireStrip(&busy);
+
+        for (int16_t r = 0; r < h; r++) {
+            ComposeRow(buf + (uint32_t)r * w * 2, b->x0, b->x1, y + r);
+        }
+
+        ST7735_BlitAsync(b->x0, y, w, h, buf, StripDone, (void *)busy);
+        last_frame_bytes += (uint32_t)w * h * 2 + WINDOW_CMD_BYTES;
+    }
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+void Compositor_Init(void) {
+    for (uint8_t i = 0; i < COMP_MAX_SPRITES; i++) {
+        sprites[i].visible = false;
+    }
+
+    labels[LABEL_P1].x = SCORE_P1_X;
+    labels[LABEL_P1].color = COLOR_CYAN;
+    labels[LABEL_SEP].x = SCORE_SEP_X;
+    labels[LABEL_SEP].color = COLOR_WHITE;
+    labels[LABEL_SEP].text[0] = '-';
+    labels[LABEL_SEP].text[1] = '\0';
+    labels[LABEL_P2].x = SCORE_P2_X;
+    labels[LABEL_P2].color = COLOR_MAGENTA;
+
+    score_p1 = -1;
+    score_p2 = -1;
+    Compositor_SetScore(0, 0);
+    Compositor_InvalidateAll();
+}
+
+void Compositor_SetSprite(uint8_t id, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (id >= COMP_MAX_SPRITES) return;
+    Sprite_t *s = &sprites[id];
+
+    if (s->visible && s->x == x && s->y == y && s->w == w && s->h == h && s->color == color) {
+        return;
+    }
+
+    if (s->visible) AddDirty(s->x, s->y, s->w, s->h);
+
+    s->x = x;
+    s->y = y;
+    s->w = w;
+    s->h = h;
+    s->color = color;
+    s->visible = true;
+    AddDirty(x, y, w, h);
+}
+
+void Compositor_HideSprite(uint8_t id) {
+    if (id >= COMP_MAX_SPRITES || !sprites[id].visible) return;
+    sprites[id].visible = false;
+    AddDirty(sprites[id].x, sprites[id].y, sprites[id].w, sprites[id].h);
+}
+
+/* Conversie scurta fara snprintf (scorurile sunt mici si pozitive) */
+static void ScoreToText(int16_t value, char *out) {
+    if (value < 0) value = 0;
+    if (value > 99) value = 99;
+    if (value >= 10) {
+        *out++ = '0' + value / 10;
+    }
+    *out++ = '0' + value % 10;
+    *out = '\0';
+}
+
+void Compositor_SetScore(int16_t p1, int16_t p2) {
+    if (p1 == score_p1 && p2 == score_p2) return;
+
+    score_p1 = p1;
+    score_p2 = p2;
+    ScoreToText(p1, labels[LABEL_P1].text);
+    ScoreToText(p2, labels[LABEL_P2].text);
+    AddDirty(SCORE_AREA_X, SCORE_Y, SCORE_AREA_W, SCORE_AREA_H);
+}
+
+void Compositor_Invalidate(int16_t x, int16_t y, int16_t w, int16_t h) {
+    AddDirty(x, y, w, h);
+}
+
+void Compositor_InvalidateAll(void) {
+    dirty_count = 0;
+    AddDirty(0, 0, ST7735_WIDTH, ST7735_HEIGHT);
+}
+
+void Compositor_Flush(void) {
+    last_frame_bytes = 0;
+    if (dirty_count == 0) return;
+
+    /* Faza spi (-DPROFILER): pana la ultimul octet iesit pe SPI */
+    PROF_SPAN_START(PROF_SPI);
+    for (uint8_t i = 0; i < dirty_count; i++) {
+        FlushBox(&dirty[i]);
+    }
+    dirty_count = 0;
+    PROF_SPAN_CLOSE(PROF_SPI, ST7735_IsBusy);
+}
+
+uint32_t Compositor_GetLastFrameBytes(void) {
+    return last_frame_bytes;
+}
@@ -0,0 +1,53 @@
+/*
+ * adc_filter.h
+ * Filtru IIR de ordinul 1 (medie exponentiala) pentru esantioane ADC
+ *
+ * Nu atinge hardware-ul: joystick.c il alimenteaza cu esantioanele
+ * din ring-ul ADC, iar pe host poate fi alimentat cu trasee inregistrate.
+ * Starea e tinuta in Q16, deci rezolutia nu se pierde la pasi mici
+ * (esantioanele trebuie sa aiba cel mult 15 biti).
+ */
+
+#ifndef ADC_FILTER_H
+#define ADC_FILTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================
+ * TYPES
+ *============================================================================*/
+
+typedef struct {
+    int32_t state;          /* Iesirea filtrului, Q16 */
+    uint8_t shift;          /* alpha = 1 / 2^shift */
+    bool primed;            /* Primul esantion initializeaza starea */
+} AdcFilter_t;
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+/**
+ * Initializeaza filtrul
+ * @param shift Constanta de timp in esantioane = 2^shift (0 = fara filtrare)
+ */
+void AdcFilter_Init(AdcFilter_t* f, uint8_t shift);
+
+/**
+ * Adauga un esantion: y += (x - y) / 2^shift
+ * @return Iesirea filtrata, rotunjita la unitati ADC
+ */
+uint16_t AdcFilter_Feed(AdcFilter_t* f, uint16_t sample);
+
+/**
+ * Schimba constanta de timp fara sa piarda starea
+ */
+void AdcFilter_SetShift(AdcFilter_t* f, uint8_t shift);
+
+/**
+ * Iesirea curenta, fara un esantion nou
+ */
+uint16_t AdcFilter_Get(const AdcFilter_t* f);
+
+#endif /* ADC_FILTER_H */
@@ -0,0 +1,58 @@
+/*
+ * app.h
+ * Logica ecranelor, comuna pentru toate variantele (scheduler, FreeRTOS, Zephyr)
+ *
+ * Regula: g_currentScreen, g_needsRedraw si meniurile sunt atinse doar de
+ * cine apeleaza App_Init / App_HandleInput / App_Redraw / App_GameOver
+ * (un singur task); App_GameTick poate rula in alt task daca display-ul
+ * e protejat.
+ */
+
+#ifndef APP_H
+#define APP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "input_events.h"
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+/**
+ * Initializeaza modulele (display, joystick, IR) si ruleaza animatia de intro
+ */
+void App_Init(void);
+
+/**
+ * Trateaza un eveniment de input pe ecranul curent
+ */
+void App_HandleInput(const InputEvent_t* ev);
+
+/**
+ * Redeseneaza meniul / ecranul de pauza daca g_needsRedraw e setat
+ */
+void App_Redraw(void);
+
+/**
+ * Un pas de joc (nimic in pauza)
+ * @return false daca meciul s-a terminat
+ */
+bool App_GameTick(void);
+
+/**
+ * Trece pe ecranul de game over
+ */
+void App_GameOver(void);
+
+/*============================================================================
+ * FURNIZAT DE VARIANTA
+ *============================================================================*/
+
+/**
+ * Porneste/opreste tick-ul de joc (apelat la start, iesire din pauza
+ * in meniu; la game over tick-ul se opreste singur)
+ */
+void App_SetGameRunning(bool running);
+
+#endif /* APP_H */
@@ -0,0 +1,138 @@
+/*
+ * audio.h
+ * Efecte sonore pe buzzer, fara blocare
+ *
+ * Un efect e o melodie scurta in formatul din song.h. Secventiatorul
+ * (audio.c) nu are registre: porneste nota curenta prin Audio_HwNote, iar
+ * portul hardware apeleaza Audio_NoteDone din intreruperea timerului de
+ * nota. Pe KL25Z tonul e PWM pe TPM2_CH0 (PTB2), durata e numarata de
+ * PIT canal 1 - o singura intrerupere per nota, nimic in bucla principala.
+ *
+ * Cu -DAUDIO_DAC portul e audio_dac_kl25z.c: sintetizatorul din synth.h pe
+ * DAC0 (PTE30), cu AUDIO_VOICES efecte simultane, fiecare pe vocea lui.
+ *
+ * Un efect nou ia o voce libera; daca nu e niciuna, il inlocuieste pe cel
+ * cu prioritatea cea mai mica, doar daca are prioritate cel putin egala
+ * (ex: game over acopera o lovitura de paleta, invers nu). Acelasi efect
+ * pornit din nou reia de la inceput pe vocea lui.
+ */
+
+#ifndef AUDIO_H
+#define AUDIO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "song.h"
+#include "synth.h"
+
+/*============================================================================
+ * CONFIGURATION
+ *============================================================================*/
+
+#if defined(AUDIO_DAC)
+#define AUDIO_VOICES        SYNTH_VOICES
+#else
+#define AUDIO_VOICES        1U      /* Buzzer-ul PWM are un singur ton */
+#endif
+
+/*============================================================================
+ * TYPES
+ *============================================================================*/
+
+typedef enum {
+    AUDIO_FX_PADDLE = 0,        /* Lovitura de paleta */
+    AUDIO_FX_WALL,              /* Ricoseu din perete */
+    AUDIO_FX_GOAL,
+    AUDIO_FX_SPEED_UP,
+    AUDIO_FX_GAME_OVER,
+    AUDIO_FX_COUNT
+} AudioEffect_t;
+
+typedef struct {
+    uint32_t played;            /* Efecte pornite */
+    uint32_t preempted;         /* ... care au intrerupt alt efect */
+    uint32_t dropped;           /* Ignorate: toate vocile au prioritate mai mare */
+    uint32_t notes;             /* Note pornite (= intreruperi de nota) */
+} AudioStats_t;
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+/**
+ * Initializeaza portul hardware (buzzer oprit)
+ */
+void Audio_Init(void);
+
+/**
+ * Porneste un efect si se intoarce imediat; nu se apeleaza din ISR
+ */
+void Audio_Play(AudioEffect_t fx);
+
+/**
+ * Opreste toate efectele
+ */
+void Audio_Stop(void);
+
+/**
+ * true cat timp se reda cel putin un efect (inclusiv pauzele dintre note)
+ */
+bool Audio_IsPlaying(void);
+
+/**
+ * Melodia unui efect (NULL pentru un efect necunoscut)
+ */
+const uint8_t* Audio_GetSong(AudioEffect_t fx);
+
+/**
+ * Copiaza contoarele
+ */
+void Audio_GetStats(AudioStats_t* out);
+
+/*============================================================================
+ * PORT HARDWARE (audio_kl25z.c, audio_dac_kl25z.c, sau zephyr/src/audio_zephyr.c)
+ * voice < AUDIO_VOICES
+ *============================================================================*/
+
+/**
+ * Pregateste iesirea si timerul de nota, cu sunetul oprit
+ */
+void Audio_HwInit(void);
+
+/**
+ * Timbrul unei voci, la pornirea unui efect pe ea (ignorat de buzzer)
+ */
+void Audio_HwTimbre(uint8_t voice, SynthWave_t wave, uint8_t volume);
+
+/**
+ * Porneste tonul si timerul de nota; dupa ms milisecunde portul apeleaza
+ * Audio_NoteDone din intrerupere
+ * @param period Perioada in ticuri la SONG_TONE_HZ, 0 = pauza
+ */
+void Audio_HwNote(uint8_t voice, uint16_t period, uint16_t ms);
+
+/**
+ * Opreste tonul si timerul de nota ale unei voci
+ */
+void Audio_HwStop(uint8_t voice);
+
+/**
+ * Blocheaza/deblocheaza intreruperea timerului de nota (sectiune critica
+ * fata de Audio_NoteDone)
+ */
+void Audio_HwMaskIrq(bool masked);
+
+/**
+ * Nota curenta a unei voci s-a terminat - apelat de port din intrerupere
+ */
+void Audio_NoteDone(uint8_t voice);
+
+#if !defined(AUDIO_DAC)
+/**
+ * KL25Z: canalul PIT al notelor. PIT_IRQHandler e in audio_kl25z.c, iar
+ * in varianta FreeRTOS in pong_rtos.c (comun cu tick-ul de joc)
+ */
+void Audio_HwPitIrq(void);
+#endif
+
+#endif /* AUDIO_H */
@@ -0,0 +1,84 @@
+/*
+ * compositor.h
+ * Compozitor dirty-rectangle pentru ecranul de joc
+ * Fundal (teren, linie centrala, scor) + sprite-uri compuse in RAM,
+ * trimise pe DMA doar pentru zonele modificate
+ */
+
+#ifndef COMPOSITOR_H
+#define COMPOSITOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "game_config.h"
+
+/*============================================================================
+ * CONFIGURATION
+ *============================================================================*/
+
+/* Sprite-uri (desenate in ordinea ID-ului, ultimul deasupra) */
+#define COMP_SPRITE_P1          0
+#define COMP_SPRITE_P2          1
+#define COMP_SPRITE_BALL        2
+#define COMP_MAX_SPRITES        3
+
+/* Dreptunghiuri murdare per frame (cele suprapuse se unesc) */
+#define COMP_MAX_DIRTY          8
+
+/* Buffer de compozitie: 2 strip-uri x 512 pixeli = 2 KB RAM */
+#define COMP_STRIP_PIXELS       512
+#define COMP_STRIP_BUFFERS      2
+
+/* Cost fix estimat al unei ferestre noi (CASET/RASET/RAMWR + CS), in octeti */
+#define COMP_WINDOW_COST        16
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+/**
+ * Reseteaza straturile (fara sprite-uri, scor 0-0)
+ * si marcheaza tot ecranul ca murdar
+ */
+void Compositor_Init(void);
+
+/**
+ * Pozitioneaza un sprite dreptunghiular
+ * Zona veche si cea noua devin murdare doar daca s-a schimbat ceva
+ */
+void Compositor_SetSprite(uint8_t id, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+
+/**
+ * Ascunde un sprite (zona lui se redeseneaza cu fundalul)
+ */
+void Compositor_HideSprite(uint8_t id);
+
+/**
+ * Actualizeaza scorul din stratul de fundal
+ * Zona scorului devine murdara doar daca valorile s-au schimbat
+ */
+void Compositor_SetScore(int16_t p1, int16_t p2);
+
+/**
+ * Marcheaza o zona ca murdara (ex: dupa un overlay desenat direct)
+ */
+void Compositor_Invalidate(int16_t x, int16_t y, int16_t w, int16_t h);
+
+/**
+ * Marcheaza tot ecranul ca murdar
+ */
+void Compositor_InvalidateAll(void);
+
+/**
+ * Compune si trimite pe SPI zonele murdare
+ * Transferurile pleaca pe DMA; functia asteapta doar cand ambele
+ * buffere de strip sunt in zbor
+ */
+void Compositor_Flush(void);
+
+/**
+ * Octetii de pixeli + costul ferestrelor trimise la ultimul Flush
+ */
+uint32_t Compositor_GetLastFrameBytes(void);
+
+#endif /* COMPOSITOR_H */
@@ -105,19 +105,13 @@ typedef struct {
  * GAME STRUCTURES
  *============================================================================*/
 
-typedef struct {
-    int16_t x, y;           /* Pozitia bilei */
-    int16_t dx, dy;         /* Viteza bilei */
-    int16_t prev_x, prev_y; /* Pozitia anterioara (pentru stergere) */
-    uint8_t size;
-} Ball_t;
+/* Pozitiile mingii si ale paletelor sunt in Physics_State_t (physics.h) */
 
 typedef struct {
-    int16_t y;              /* Pozitia paletei */
-    int16_t prev_y;         /* Pozitia anterioara */
     int16_t score;          /* Scorul */
     InputType_t input;      /* Tipul de input */
     int16_t target_y;       /* Pentru AI - tinta */
+    int16_t frac_y;         /* Rest sub-pixel al miscarii analogice, Q8.8 */
 } Paddle_t;
 
 typedef struct {
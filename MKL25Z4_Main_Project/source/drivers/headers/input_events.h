@@ -0,0 +1,100 @@
+/*
+ * input_events.h
+ * Coada de evenimente de input cu timestamp, comuna pentru toate sursele
+ *
+ * Fiecare sursa are propriul ring single-producer/single-consumer
+ * (ISR-ul butonului, ISR-ul IR, citirea joystick-ului), deci producatorii
+ * nu au nevoie de lock-uri. Main loop-ul consuma evenimentele in ordinea
+ * timestamp-urilor, indiferent de sursa.
+ */
+
+#ifndef INPUT_EVENTS_H
+#define INPUT_EVENTS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "game_config.h"
+
+/*============================================================================
+ * CONFIGURATION
+ *============================================================================*/
+
+/* Evenimente per sursa (putere a lui 2) */
+#define INPUT_RING_SIZE     16U
+
+/*============================================================================
+ * TYPES
+ *============================================================================*/
+
+typedef enum {
+    INPUT_SRC_BUTTON = 0,   /* PTD4, PORTD_IRQHandler */
+    INPUT_SRC_IR,           /* TPM1_IRQHandler (NEC) */
+    INPUT_SRC_JOYSTICK,     /* Axa Y, pragurile de meniu */
+    INPUT_NUM_SOURCES
+} InputSource_t;
+
+typedef struct {
+    uint32_t stamp_ms;      /* g_systick_ms la producere */
+    int32_t value;          /* Joystick: procent Y; IR: codul NEC */
+    uint8_t source;         /* InputSource_t */
+    uint8_t action;         /* UI_Action_t */
+#if defined(PROFILER)
+    uint32_t stamp_cycles;  /* Prof_Now() la frontul de input (profiler.h) */
+#endif
+} InputEvent_t;
+
+typedef struct {
+    uint32_t consumed;      /* Evenimente scoase din coada */
+    uint32_t dropped;       /* Evenimente pierdute (ring plin) */
+    uint32_t latency_sum_ms;
+    uint32_t latency_max_ms;
+} InputStats_t;
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+/**
+ * Adauga un eveniment in ringul sursei (apelat de producatorul unic al sursei)
+ * Timestamp-ul este g_systick_ms curent
+ * @return false daca ringul e plin (evenimentul e numarat ca pierdut)
+ */
+bool InputEvents_Push(InputSource_t source, UI_Action_t action, int32_t value);
+
+#if defined(PROFILER)
+/**
+ * Ca InputEvents_Push, cu momentul frontului de input dat de sursa
+ * (ex: primul front al cadrului IR, inainte de decodare)
+ */
+bool InputEvents_PushAt(InputSource_t source, UI_Action_t action, int32_t value, uint32_t stamp_cycles);
+
+#define INPUT_EVENTS_PUSH_AT(source, action, value, stamp) \
+    InputEvents_PushAt(source, action, value, stamp)
+#else
+#define INPUT_EVENTS_PUSH_AT(source, action, value, stamp) \
+    InputEvents_Push(source, action, value)
+#endif
+
+/**
+ * Scoate cel mai vechi eveniment, din oricare sursa
+ * @return false daca nu exista evenimente
+ */
+bool InputEvents_Pop(InputEvent_t* ev);
+
+/**
+ * Scoate urmatorul eveniment al unei singure surse
+ * @return false daca ringul sursei e gol
+ */
+bool InputEvents_PopSource(InputSource_t source, InputEvent_t* ev);
+
+/**
+ * Arunca toate evenimentele in asteptare
+ */
+void InputEvents_Flush(void);
+
+/**
+ * Contoare: evenimente consumate/pierdute si latenta input -> actiune
+ */
+void InputEvents_GetStats(InputStats_t* out);
+
+#endif /* INPUT_EVENTS_H */
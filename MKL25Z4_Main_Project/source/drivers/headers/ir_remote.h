@@ -36,6 +36,11 @@
 #define IR_HOLD_TIMEOUT_MS      150
 /* Interval pentru repeat in joc (ms) */
 #define IR_GAME_REPEAT_MS       50
+/* Interval minim intre doua evenimente de meniu (ms) */
+#define IR_MENU_DEBOUNCE_MS     200
+
+/* Latimea raportata cand intre doua fronturi a trecut prea mult timp */
+#define IR_WIDTH_IDLE           0xFFFFFFFFU
 
 /*============================================================================
  * PUBLIC FUNCTIONS
@@ -43,14 +48,15 @@
 
 /**
  * Initializeaza modulul IR:
- * - Configureaza pinul PTA12 ca input cu pull-up
- * - Configureaza TPM1 pentru masurare durata pulsuri
- * - Activeaza intreruperea pe ambele fronturi
+ * - Configureaza pinul PTA12 ca TPM1_CH0 cu pull-up
+ * - Porneste TPM1 free-running cu input capture pe ambele fronturi
+ * - Decodarea NEC ruleaza in ISR-ul TPM1; codurile si repeat-urile
+ *   produc evenimente INPUT_SRC_IR pentru meniu (input_events.h)
  */
 void IR_Init(void);
 
 /**
- * Proceseaza datele IR primite (decodare NEC)
+ * Expira hold-ul si afiseaza codurile noi (decodarea e in ISR)
  * Trebuie apelat periodic in main loop
  */
 void IR_Process(void);
@@ -61,12 +67,6 @@ void IR_Process(void);
  */
 uint32_t IR_GetLastCode(void);
 
-/**
- * Returneaza actiunea pentru meniu (UP/DOWN/SELECT)
- * Cu debounce integrat pentru navigare fluida
- */
-UI_Action_t IR_GetMenuAction(void);
-
 /**
  * Returneaza directia pentru control paleta in joc
  * @return -1=sus, 0=neutru, +1=jos
@@ -85,4 +85,35 @@ bool IR_IsHolding(void);
  */
 void IR_Reset(void);
 
+#if defined(PROFILER)
+/**
+ * Momentul (Prof_Now) primului front al cadrului cu ultimul cod nou,
+ * o singura data per cod - pentru latenta input -> ecran din profiler.h
+ * @return false daca nu a venit niciun cod de la apelul anterior
+ */
+bool IR_TakeInputStamp(uint32_t* stamp);
+#endif
+
+/*============================================================================
+ * PORT HARDWARE (ir_remote_kl25z.c, sau zephyr/src/ir_remote_zephyr.c)
+ *============================================================================*/
+
+/**
+ * Porneste captura fronturilor receptorului IR; apelat din IR_Init
+ */
+void IR_HwInit(void);
+
+/**
+ * Latimea unui puls (timp intre doua fronturi) in us, sau IR_WIDTH_IDLE
+ * Apelat din ISR-ul de captura; avanseaza decodorul NEC
+ */
+void IR_FeedPulse(uint32_t width_us);
+
+/**
+ * Doar KL25Z (power.c): in VLPS TPM1 e oprit, deci primul front al unui
+ * cadru trezeste CPU-ul ca intrerupere de pin PORTA, iar ISR-ul ei il
+ * inregistreaza ca front capturat
+ */
+void IR_HwSetWakeArmed(bool armed);
+
 #endif /* IR_REMOTE_H */
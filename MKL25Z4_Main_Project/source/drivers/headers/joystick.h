@@ -25,35 +25,68 @@
 #define JOYSTICK_SW_GPIO        GPIOD
 #define JOYSTICK_SW_IRQ         PORTD_IRQn
 
+/* Contactul sare cateva ms la apasare si la eliberare: o apasare conteaza
+ * doar dupa atatea ms fara niciun front pe pin */
+#define JOYSTICK_SW_LOCKOUT_MS  25U
+
+/* Rata conversiilor ADC (trigger TPM0) */
+#define JOYSTICK_SAMPLE_HZ      1000U
+
+/* Filtrul IIR: constanta de timp 2^3 = 8 esantioane (8 ms) */
+#define JOYSTICK_FILTER_SHIFT   3U
+
+/* In modul de consum redus (meniuri) un esantion vine la fiecare
+ * Joystick_Process, deci filtrul e mai scurt: 2 esantioane */
+#define JOYSTICK_IDLE_FILTER_SHIFT  1U
+
+/*============================================================================
+ * RESPONSE CURVE
+ *============================================================================*/
+
+typedef enum {
+    JOYSTICK_CURVE_LINEAR = 0,  /* Viteza proportionala cu deflexia */
+    JOYSTICK_CURVE_EXPO         /* Fin langa centru, rapid spre capat */
+} JoystickCurve_t;
+
+#define JOYSTICK_DEFAULT_CURVE  JOYSTICK_CURVE_EXPO
+
 /*============================================================================
  * PUBLIC FUNCTIONS
  *============================================================================*/
 
 /**
  * Initializeaza joystick-ul:
- * - Configureaza ADC pentru citire axe
+ * - Configureaza ADC cu medie hardware si trigger TPM0 la JOYSTICK_SAMPLE_HZ
+ * - Porneste calibrarea centrului (stick-ul trebuie sa fie in repaus)
  * - Configureaza GPIO pentru buton cu intrerupere
  */
 void Joystick_Init(void);
 
 /**
- * Proceseaza joystick-ul (citeste ADC)
+ * Proceseaza joystick-ul: trece esantioanele noi prin filtru (nu blocheaza)
+ * Depasirea pragului de meniu produce un eveniment INPUT_SRC_JOYSTICK
  * Trebuie apelat periodic in main loop
  */
 void Joystick_Process(void);
 
-/**
- * Returneaza actiunea pentru meniu (UP/DOWN/SELECT)
- * Cu debounce integrat pentru navigare fluida
- */
-UI_Action_t Joystick_GetMenuAction(void);
-
 /**
  * Returneaza procentul Y pentru control paleta
  * @return Valoare intre -100 (sus) si +100 (jos)
  */
 int16_t Joystick_GetY_Percent(void);
 
+/**
+ * Viteza paletei din deflexia calibrata, prin curba de raspuns
+ * @return Q8.8 pixeli/frame, negativ = sus; 0 in dead zone si pana
+ *         la terminarea calibrarii (primele 64 ms dupa Joystick_Init)
+ */
+int16_t Joystick_GetPaddleSpeed(void);
+
+/**
+ * Recalculeaza tabelul curbei de raspuns (doar la schimbare, nu per frame)
+ */
+void Joystick_SetCurve(JoystickCurve_t curve);
+
 /**
  * Returneaza directia pentru control paleta in joc
  * @return -1=sus, 0=neutru, +1=jos (bazat pe deadzone)
@@ -61,7 +94,21 @@ int16_t Joystick_GetY_Percent(void);
 int8_t Joystick_GetGameDirection(void);
 
 /**
- * Verifica daca butonul a fost apasat (cu clear automat)
+ * Numarul de conversii ADC terminate de la pornire
+ * (intrarile pierdute cand ring-ul e plin sunt numarate si ele)
+ */
+uint32_t Joystick_GetSampleCount(void);
+
+/**
+ * Mod de consum redus (meniuri): fara trigger TPM0 la JOYSTICK_SAMPLE_HZ,
+ * fiecare Joystick_Process porneste o singura conversie, care se termina
+ * si in VLPS. Iesirea din mod reporneste esantionarea continua.
+ */
+void Joystick_SetLowPower(bool enable);
+
+/**
+ * Consuma o apasare de buton din coada INPUT_SRC_BUTTON
+ * (apasarile rapide succesive nu se pierd)
  * @return true daca butonul a fost apasat
  */
 bool Joystick_ButtonPressed(void);
@@ -71,4 +118,54 @@ bool Joystick_ButtonPressed(void);
  */
 void Joystick_Reset(void);
 
+#if defined(PROFILER)
+/**
+ * Momentul (Prof_Now) esantionului ADC care a pornit sau a intors paleta,
+ * o singura data per pornire - pentru latenta input -> ecran din profiler.h
+ * @return false daca paleta nu a pornit de la apelul anterior
+ */
+bool Joystick_TakeInputStamp(uint32_t* stamp);
+#endif
+
+/*============================================================================
+ * PORT HARDWARE (joystick_kl25z.c, sau zephyr/src/joystick_zephyr.c)
+ *============================================================================*/
+
+/**
+ * Porneste esantionarea ADC la JOYSTICK_SAMPLE_HZ si intreruperea
+ * butonului (apasare -> eveniment INPUT_SRC_BUTTON); apelat din Joystick_Init
+ */
+void Joystick_HwInit(void);
+
+/**
+ * Adauga un esantion ADC (12 biti) in ring-ul lui Joystick_Process
+ * Sigur din ISR; un singur producator
+ */
+void Joystick_PushSample(uint16_t value);
+
+/**
+ * Front pe butonul joystick-ului (din ISR), cu nivelul citit dupa front.
+ * Pune ACTION_SELECT in coada la apasare, daca pinul a stat nemiscat
+ * JOYSTICK_SW_LOCKOUT_MS inainte; sariturile de la apasare si de la
+ * eliberare sunt ignorate
+ */
+void Joystick_PushButton(bool pressed);
+
+/**
+ * Esantionare continua (trigger hardware) sau la cerere
+ */
+void Joystick_HwSetContinuous(bool continuous);
+
+/**
+ * Porneste o conversie (doar cu esantionarea la cerere); rezultatul vine
+ * prin Joystick_PushSample
+ */
+void Joystick_HwStartConversion(void);
+
+/**
+ * O conversie ADC e in curs (rezultatul vine in mai putin de o perioada
+ * de esantionare) - Power_Sleep o asteapta in WAIT, nu in VLPS
+ */
+bool Joystick_HwIsConverting(void);
+
 #endif /* JOYSTICK_H */
@@ -0,0 +1,125 @@
+/*
+ * kv_store.h
+ * Inregistrari persistente in flash: jurnal append-only pe KV_SECTORS
+ * sectoare, cu CRC, compactare si uzura egala
+ *
+ * Un singur sector e activ la un moment dat: header (seq, magic) urmat de
+ * inregistrari {cheie, lungime, CRC16, date} aliniate la 4 octeti. O valoare
+ * noua se scrie mereu dupa ultima inregistrare, niciodata peste cea veche.
+ * Cand sectorul activ se umple, urmatorul sector (cel mai vechi) e sters,
+ * primeste doar valorile curente ale tuturor cheilor, iar header-ul lui cu
+ * seq + 1 e scris ultimul - punctul de commit. Sectoarele sunt sterse pe
+ * rand, deci uzura e aceeasi pe toate.
+ *
+ * La pornire: header-ele tuturor sectoarelor, apoi o singura trecere prin
+ * sectorul cu seq maxim construieste indexul din RAM (cheie -> adresa), deci
+ * KvStore_Get e O(1). O inregistrare cu CRC gresit (scriere intrerupta de
+ * reset) opreste trecerea; sectorul e considerat plin si urmatoarea scriere
+ * il compacteaza. O compactare intrerupta lasa un sector fara header,
+ * ignorat: valorile din sectorul vechi raman valabile.
+ *
+ * KvStore_Set doar memoreaza valoarea in RAM; flash-ul e scris abia de
+ * KvStore_Flush (app.c o apeleaza doar pe ecranele de meniu). Portul
+ * hardware (kv_store_kl25z.c: FTFA prin fsl_flash) furnizeaza KvStore_Hw*;
+ * pe host flash-ul e simulat in host/sim.c.
+ */
+
+#ifndef KV_STORE_H
+#define KV_STORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================
+ * CONFIGURATION
+ *============================================================================*/
+
+#define KV_SECTOR_SIZE      1024U       /* Sectorul FTFA pe KL25Z128 */
+#define KV_SECTORS          4U
+#define KV_SIZE             (KV_SECTORS * KV_SECTOR_SIZE)
+
+#define KV_MAX_KEYS         16U         /* Chei 0..15 */
+#define KV_VALUE_MAX        16U         /* Octeti per valoare */
+
+/*============================================================================
+ * TYPES
+ *============================================================================*/
+
+typedef struct {
+    uint32_t seq;               /* Generatia sectorului activ (0 = niciunul) */
+    uint8_t sector;
+    uint16_t used;              /* Octeti ocupati in sectorul activ */
+    uint32_t records;           /* Inregistrari adaugate de la pornire */
+    uint32_t compactions;       /* = stergeri de sector */
+    uint32_t crc_errors;        /* Inregistrari respinse la citire */
+    uint32_t flash_errors;      /* Comenzi de stergere/scriere esuate */
+} KvStoreStats_t;
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+/**
+ * Initializeaza portul si citeste sectorul activ (o singura trecere)
+ * @return false daca nu exista niciun sector valid (flash gol)
+ */
+bool KvStore_Init(void);
+
+/**
+ * Copiaza valoarea unei chei (inclusiv una nescrisa inca in flash)
+ * @return Lungimea valorii, 0 daca cheia nu exista
+ */
+uint8_t KvStore_Get(uint8_t key, void* dst, uint8_t size);
+
+/**
+ * Memoreaza o valoare in RAM pana la KvStore_Flush; o valoare identica
+ * cu cea din flash nu produce nicio scriere
+ * @return false pentru cheie sau lungime invalida
+ */
+bool KvStore_Set(uint8_t key, const void* src, uint8_t len);
+
+/**
+ * true daca exista valori nescrise in flash
+ */
+bool KvStore_IsDirty(void);
+
+/**
+ * Scrie valorile in asteptare (si compacteaza daca sectorul e plin).
+ * Blocheaza pe durata comenzilor flash: cativa zeci de us per cuvant,
+ * ~14 ms in plus la o compactare. Nu se apeleaza din ISR.
+ * @return false la o eroare flash (valorile raman in asteptare)
+ */
+bool KvStore_Flush(void);
+
+/**
+ * Copiaza starea si contoarele
+ */
+void KvStore_GetStats(KvStoreStats_t* out);
+
+/*============================================================================
+ * HARDWARE PORT (kv_store_kl25z.c / zephyr/src/kv_store_zephyr.c)
+ * Adresele sunt relative la inceputul zonei de KV_SIZE octeti
+ *============================================================================*/
+
+void KvStore_HwInit(void);
+void KvStore_HwRead(uint32_t offset, void* dst, uint32_t len);
+
+/**
+ * Incadreaza toate comenzile unui KvStore_Flush (inclusiv compactarea):
+ * pe KL25Z trecerea VLPR -> RUN si inapoi se face o singura data
+ */
+void KvStore_HwBegin(void);
+void KvStore_HwEnd(void);
+
+/**
+ * @return false daca sectorul nu a putut fi sters
+ */
+bool KvStore_HwErase(uint8_t sector);
+
+/**
+ * Programeaza cuvinte de 32 de biti (offset si len multipli de 4)
+ * @return false la eroare
+ */
+bool KvStore_HwProgram(uint32_t offset, const uint32_t* src, uint32_t len);
+
+#endif /* KV_STORE_H */
@@ -0,0 +1,180 @@
+/*
+ * log.h
+ * Mesaje de consola fara blocare: LOG copiaza formatul si argumentele
+ * intr-un ring din RAM, textul e format si trimis in fundal
+ *
+ * PRINTF (DbgConsole_Printf) formateaza si asteapta UART-ul octet cu
+ * octet: ~87 us per caracter la 115200, milisecunde per linie in bucla
+ * jocului. LOG(fmt, ...) doar salveaza pointerul la format si cel mult
+ * LOG_MAX_ARGS argumente intregi intr-o inregistrare de dimensiune fixa;
+ * cu ringul plin inregistrarea e numarata ca pierduta, apelul nu asteapta
+ * niciodata. Portul hardware (log_kl25z.c) goleste ringul din intreruperea
+ * UART0 TX-empty: Log_NextByte formateaza cate o linie si o da octet cu
+ * octet. Pierderile apar in consola ca o linie "[LOG] n dropped" chiar in
+ * locul unde s-au produs.
+ *
+ * Formatul e un subset printf pentru intregi pe 32 de biti: %d %i %u %x
+ * %X %c %%, cu flag-urile '-' si '0' si latime. Fara %s: pointerul ar fi
+ * citit abia la golire. Argumentele trebuie sa fie int/unsigned (cast-ul
+ * (unsigned int) pentru uint32_t, ca la PRINTF).
+ *
+ * LOG se poate apela si din ISR. Mesajele de pornire folosesc LOG_BOOT
+ * (PRINTF in modul text); dupa Log_Init PRINTF si LOG pot intercala
+ * caractere, deci in bucla principala se foloseste doar LOG.
+ *
+ * Cu -DLOG_TOKENIZED formatul nu mai ajunge pe placa: fiecare LOG isi pune
+ * literalul intr-o sectiune log_fmt fara SHF_ALLOC (ramane in ELF, nu in
+ * flash), iar adresa lui in sectiune e tokenul. Pe fir pleaca un cadru
+ * binar: LOG_FRAME_START + nargs, tokenul si argumentele ca varint (7 biti
+ * pe octet, LSB intai). host/logdec reface textul din sectiunea log_fmt a
+ * ELF-ului; octetii sub 0x80 din afara cadrelor (PRINTF ramase, ex.
+ * statisticile cu %s) trec ca text.
+ */
+
+#ifndef LOG_H
+#define LOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================
+ * CONFIGURATION
+ *============================================================================*/
+
+#define LOG_RING_SIZE       32U     /* Inregistrari (putere a lui 2) */
+#define LOG_MAX_ARGS        4U
+#define LOG_LINE_MAX        96U     /* O linie formata, restul e taiat */
+
+/* Cadrul tokenizat: primul octet nu apare in text ASCII */
+#define LOG_FRAME_START     0xF8U   /* + nargs (0..LOG_MAX_ARGS) */
+#define LOG_FRAME_MAX       (1U + 5U * (1U + LOG_MAX_ARGS))
+
+/*============================================================================
+ * MACROS
+ *============================================================================*/
+
+/* Numarul de argumente, 0..4; cu 5..12 LOG nu compileaza */
+#define LOG_NARGS(...)      LOG_NARGS_(0, ##__VA_ARGS__, LOG_TOO_MANY_ARGS, LOG_TOO_MANY_ARGS, \
+                                       LOG_TOO_MANY_ARGS, LOG_TOO_MANY_ARGS, LOG_TOO_MANY_ARGS, \
+                                       LOG_TOO_MANY_ARGS, LOG_TOO_MANY_ARGS, LOG_TOO_MANY_ARGS, \
+                                       4, 3, 2, 1, 0)
+#define LOG_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, n, ...)  n
+
+#if defined(LOG_TOKENIZED)
+
+/* Sectiune fara flag-uri (nu se incarca in flash); restul directivei
+ * generate de compilator e comentat */
+#if defined(__arm__)
+#define LOG_FMT_SECTION     "log_fmt,\"\",%progbits @"
+#else
+#define LOG_FMT_SECTION     "log_fmt,\"\",@progbits #"
+#endif
+
+/* Literalul in log_fmt; adresa lui (tokenul) nu se dereferentiaza pe placa */
+#define LOG_TOKEN(name, fmt) \
+    static const char name[] __attribute__((section(LOG_FMT_SECTION), used)) = fmt
+
+/* Verificarea printf a argumentelor, fara cod generat */
+#define LOG_CHECK(fmt, ...) do { if (0) Log_CheckFormat(fmt, ##__VA_ARGS__); } while (0)
+
+#define LOG(fmt, ...)       do { LOG_CHECK(fmt, ##__VA_ARGS__); LOG_TOKEN(log_fmt_, fmt); \
+                                 Log_Write(log_fmt_, LOG_NARGS(__VA_ARGS__), ##__VA_ARGS__); } while (0)
+#define LOG_BOOT(fmt, ...)  do { LOG_CHECK(fmt, ##__VA_ARGS__); LOG_TOKEN(log_fmt_, fmt); \
+                                 Log_WriteBlocking(log_fmt_, LOG_NARGS(__VA_ARGS__), ##__VA_ARGS__); } while (0)
+
+#else
+
+#define LOG_TOKEN(name, fmt) \
+    static const char name[] = fmt
+
+#define LOG(fmt, ...)       Log_Write(fmt, LOG_NARGS(__VA_ARGS__), ##__VA_ARGS__)
+#define LOG_BOOT(fmt, ...)  PRINTF(fmt, ##__VA_ARGS__)
+
+#endif
+
+/*============================================================================
+ * TYPES
+ *============================================================================*/
+
+typedef struct {
+    uint32_t written;           /* Inregistrari puse in ring */
+    uint32_t dropped;           /* ... pierdute, ringul era plin */
+    uint32_t max_used;          /* Cel mai plin ring vazut */
+    uint32_t lines;             /* Linii formate la golire */
+    uint32_t bytes;             /* Octeti dati portului */
+} LogStats_t;
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+/**
+ * Goleste ringul si porneste portul (dupa consola placii si RunMode_Init)
+ */
+void Log_Init(void);
+
+/**
+ * Apelat prin LOG: copiaza fmt (trebuie sa fie un literal) si nargs
+ * argumente intregi; timp constant, nu asteapta UART-ul
+ */
+#if defined(LOG_TOKENIZED)
+void Log_Write(const char* fmt, uint8_t nargs, ...);
+
+/**
+ * Apelat prin LOG_BOOT: trimite cadrul pe loc, asteptand UART-ul (dupa ce
+ * ringul s-a golit), ca PRINTF; merge si inainte de Log_Init, nu din ISR
+ */
+void Log_WriteBlocking(const char* fmt, uint8_t nargs, ...);
+
+static inline void __attribute__((format(printf, 1, 2))) Log_CheckFormat(const char* fmt, ...) {
+    (void)fmt;
+}
+#else
+void Log_Write(const char* fmt, uint8_t nargs, ...) __attribute__((format(printf, 1, 3)));
+#endif
+
+/**
+ * true daca nu mai e nimic de trimis (ring gol si linia curenta trimisa)
+ */
+bool Log_IsIdle(void);
+
+/**
+ * Copiaza contoarele
+ */
+void Log_GetStats(LogStats_t* out);
+
+/**
+ * Urmatorul octet de trimis, formatand urmatoarea inregistrare cand linia
+ * curenta s-a terminat; apelat doar de port (consumatorul unic)
+ * @return octetul, sau -1 daca ringul e gol
+ */
+int16_t Log_NextByte(void);
+
+/*============================================================================
+ * PORT HARDWARE (log_kl25z.c sau zephyr/src/log_zephyr.c)
+ *============================================================================*/
+
+/**
+ * Pregateste golirea (intreruperea UART, listener de RunMode)
+ */
+void Log_HwInit(void);
+
+/**
+ * Sectiune critica fata de alti producatori (task-uri, ISR-uri)
+ */
+uint32_t Log_HwLock(void);
+void Log_HwUnlock(uint32_t key);
+
+/**
+ * Exista date noi; apelat din sectiunea critica. Portul porneste golirea
+ * daca nu e deja pornita.
+ */
+void Log_HwKick(void);
+
+/**
+ * Doar cu LOG_TOKENIZED: scrie len octeti direct, asteptand fiecare TDRE;
+ * golirea din intrerupere nu se intercaleaza
+ */
+void Log_HwWriteBlocking(const uint8_t* data, uint8_t len);
+
+#endif /* LOG_H */
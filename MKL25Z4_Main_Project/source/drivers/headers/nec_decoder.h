@@ -0,0 +1,82 @@
+/*
+ * nec_decoder.h
+ * Masina de stare NEC, alimentata cu durata fiecarui puls (in us)
+ *
+ * Nu atinge hardware-ul: ir_remote.c o apeleaza din ISR-ul de input
+ * capture, iar pe host poate fi alimentata cu latimi inregistrate.
+ * Pulsurile alterneaza mark/space; o pauza lunga (linia in repaus)
+ * resincronizeaza decodorul pe urmatorul mark.
+ */
+
+#ifndef NEC_DECODER_H
+#define NEC_DECODER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================
+ * NEC TIMING (us, cu toleranta)
+ *============================================================================*/
+
+#define NEC_LEAD_MARK_MIN       8000U   /* 9 ms */
+#define NEC_LEAD_MARK_MAX       10000U
+#define NEC_LEAD_SPACE_MIN      4000U   /* 4.5 ms = cod nou */
+#define NEC_LEAD_SPACE_MAX      5000U
+#define NEC_RPT_SPACE_MIN       1900U   /* 2.25 ms = repeat */
+#define NEC_RPT_SPACE_MAX       2600U
+#define NEC_BIT_MARK_MIN        300U    /* 560 us */
+#define NEC_BIT_MARK_MAX        850U
+#define NEC_ZERO_SPACE_MIN      300U    /* 560 us */
+#define NEC_ZERO_SPACE_MAX      850U
+#define NEC_ONE_SPACE_MIN       1300U   /* 1690 us */
+#define NEC_ONE_SPACE_MAX       2000U
+
+/* Orice puls mai lung e linie in repaus: urmatorul puls e un mark */
+#define NEC_IDLE_US             12000U
+
+/*============================================================================
+ * TYPES
+ *============================================================================*/
+
+typedef enum {
+    NEC_EVENT_NONE = 0,
+    NEC_EVENT_CODE,         /* Cod complet in decoder->code */
+    NEC_EVENT_REPEAT,       /* Cadru repeat (tasta tinuta apasat) */
+    NEC_EVENT_ERROR         /* Puls invalid - cadrul curent e abandonat */
+} NecEvent_t;
+
+typedef enum {
+    NEC_STATE_WAIT_IDLE = 0,    /* Desincronizat: asteapta o pauza lunga */
+    NEC_STATE_LEAD_MARK,
+    NEC_STATE_LEAD_SPACE,
+    NEC_STATE_BIT_MARK,
+    NEC_STATE_BIT_SPACE,
+    NEC_STATE_STOP_MARK,
+    NEC_STATE_REPEAT_MARK
+} NecState_t;
+
+typedef struct {
+    NecState_t state;
+    uint8_t bits;           /* Biti primiti in cadrul curent */
+    uint32_t shift;         /* Bitii cadrului curent, LSB primul */
+    uint32_t code;          /* Ultimul cod valid */
+} NecDecoder_t;
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+/**
+ * Pune decodorul in asteptarea unei pauze (linia in repaus)
+ */
+void NecDecoder_Reset(NecDecoder_t* d);
+
+/**
+ * Avanseaza masina de stare cu durata pulsului care tocmai s-a terminat
+ * @param width_us Durata pulsului (mark sau space, dupa stare)
+ * @return NEC_EVENT_CODE la ultimul bit al unui cod valid,
+ *         NEC_EVENT_REPEAT la un cadru repeat, altfel NONE/ERROR
+ */
+NecEvent_t NecDecoder_Feed(NecDecoder_t* d, uint32_t width_us);
+
+#endif /* NEC_DECODER_H */
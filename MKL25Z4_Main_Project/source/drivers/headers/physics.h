@@ -0,0 +1,123 @@
+/*
+ * physics.h
+ * Fizica mingii si a paletelor in virgula fixa Q8.8
+ * Functii pure: fara desenare, fara rand(), fara variabile globale
+ *
+ * Mingea se misca sub-pixel si e testata cu swept-AABB pe tot drumul
+ * frame-ului, deci nu poate trece prin paleta nici la viteza maxima.
+ */
+
+#ifndef PHYSICS_H
+#define PHYSICS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "game_config.h"
+
+/*============================================================================
+ * FIXED POINT
+ *============================================================================*/
+
+/* Q8.8 tinut pe 32 de biti (terenul are 160 px, nu incape in int16) */
+typedef int32_t fix_t;
+
+#define FIX_SHIFT           8
+#define FIX_ONE             ((fix_t)1 << FIX_SHIFT)
+#define INT_TO_FIX(v)       ((fix_t)(v) * FIX_ONE)
+#define FIX_TO_INT(v)       ((int16_t)((v) >> FIX_SHIFT))       /* floor */
+
+/*============================================================================
+ * GEOMETRY
+ *============================================================================*/
+
+/* Limitele coltului stanga-sus al mingii (mingea se reflecta in oglinda) */
+#define PHYS_BALL_MIN_Y     INT_TO_FIX(3)
+#define PHYS_BALL_MAX_Y     INT_TO_FIX(FIELD_HEIGHT - BALL_SIZE - 3)
+
+/* Fetele paletelor: muchia stanga a mingii vs P1, muchia dreapta vs P2 */
+#define PHYS_FACE_P1        INT_TO_FIX(PADDLE_X_P1 + PADDLE_WIDTH)
+#define PHYS_FACE_P2        INT_TO_FIX(PADDLE_X_P2)
+
+/* Rezultatul Physics_InterceptY cand mingea nu ajunge la tinta */
+#define PHYS_NO_INTERCEPT   ((fix_t)-1)
+
+/* Viteza verticala minima dupa o lovitura in paleta */
+#define PHYS_MIN_DY         (FIX_ONE / 2)
+
+/*============================================================================
+ * STATE
+ *============================================================================*/
+
+typedef struct {
+    fix_t x, y;             /* Coltul stanga-sus, Q8.8 */
+    fix_t dx, dy;           /* Pixeli pe frame, Q8.8 */
+} PhysBall_t;
+
+typedef struct {
+    PhysBall_t ball;
+    int16_t paddle_y[2];    /* Pozitia paletelor P1/P2, pixeli */
+    uint32_t rng;           /* xorshift32 - aceeasi stare da aceeasi partida */
+} Physics_State_t;
+
+typedef struct {
+    int16_t paddle_dy[2];   /* Deplasarea ceruta pentru P1/P2 in acest frame */
+} Physics_Inputs_t;
+
+/* Evenimente returnate de Physics_Step (bitmask) */
+#define PHYS_EV_WALL        (1U << 0)
+#define PHYS_EV_HIT_P1      (1U << 1)
+#define PHYS_EV_HIT_P2      (1U << 2)
+#define PHYS_EV_GOAL_P1     (1U << 3)   /* P1 a marcat (mingea a iesit in dreapta) */
+#define PHYS_EV_GOAL_P2     (1U << 4)   /* P2 a marcat (mingea a iesit in stanga) */
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+/**
+ * Paletele in centru, mingea in centru cu viteza de start
+ * @param seed Seed pentru generatorul intern (0 e inlocuit)
+ */
+void Physics_Init(Physics_State_t* s, uint32_t seed);
+
+/**
+ * Repune mingea in centru la viteza de start
+ * @param dir_x +1 spre P2, -1 spre P1
+ * Directia verticala e aleasa din generatorul starii
+ */
+void Physics_Serve(Physics_State_t* s, int8_t dir_x);
+
+/**
+ * Accelereaza mingea cu 1 px/frame pe X (si pe Y daca vertical = true)
+ */
+void Physics_SpeedUp(Physics_State_t* s, bool vertical);
+
+/**
+ * Avanseaza simularea cu un frame:
+ * paletele se misca si se limiteaza, mingea se reflecta in pereti
+ * si in palete pe traiectoria continua a frame-ului
+ * @return Evenimentele din acest frame (PHYS_EV_*)
+ */
+uint8_t Physics_Step(Physics_State_t* s, const Physics_Inputs_t* in);
+
+/**
+ * Y-ul mingii in primul frame in care X-ul ei atinge sau depaseste target_x
+ * (doar pereti, fara palete), in timp constant: reflexiile se "desfac"
+ * intr-o miscare liniara si se pliaza inapoi cu modulo 2 * inaltime
+ * @param max_frames Orizontul de predictie
+ * @return Y in Q8.8 sau PHYS_NO_INTERCEPT (dx = 0 sau dincolo de orizont)
+ */
+fix_t Physics_InterceptY(const PhysBall_t* b, fix_t target_x, uint16_t max_frames);
+
+/**
+ * Urmatorul numar din generatorul starii (xorshift32)
+ */
+uint32_t Physics_Random(Physics_State_t* s);
+
+/**
+ * Pozitia Y data, reflectata in limitele mingii
+ * @param flips Daca nu e NULL, primeste numarul de reflexii
+ */
+fix_t Physics_FoldY(fix_t y, uint8_t* flips);
+
+#endif /* PHYSICS_H */
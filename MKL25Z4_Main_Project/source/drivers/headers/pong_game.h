@@ -24,8 +24,8 @@
 void Game_Init(void);
 
 /**
- * Porneste jocul cu countdown animat
- * Tranzitioneaza la SCREEN_GAMEPLAY
+ * Porneste jocul: deseneaza terenul si lanseaza countdown-ul animat
+ * Countdown-ul avanseaza din Game_Update, functia nu blocheaza
  */
 void Game_Start(void);
 
@@ -80,4 +80,10 @@ bool Game_IsPaused(void);
  */
 bool Game_IsRunning(void);
 
+/**
+ * Verifica daca o tranzitie e in curs (countdown, pauza dupa gol, SPEED UP)
+ * @return true cat timp jocul asteapta overlay-ul
+ */
+bool Game_IsInTransition(void);
+
 #endif /* PONG_GAME_H */
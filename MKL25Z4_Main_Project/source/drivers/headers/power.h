@@ -0,0 +1,91 @@
+/*
+ * power.h
+ * Somn tickless intre task-uri: WAIT in timpul jocului, VLPS in meniuri
+ *
+ * SysTick (1 ms) ramane baza de timp cat timp CPU-ul e treaz. Cand
+ * scheduler-ul nu are nimic de rulat pana la urmatoarea activare si
+ * somnul adanc e permis, SysTick e lasat sa ingheteze, LPTMR0 (pe LPO,
+ * 1 kHz, merge si in VLPS) e programat sa trezeasca exact la activare,
+ * iar la trezire g_systick_ms e avansat cu milisecundele dormite.
+ * Orice alta intrerupere (buton, IR, ADC) trezeste si ea CPU-ul; timpul
+ * e corectat inainte ca ISR-ul ei sa ruleze.
+ */
+
+#ifndef POWER_H
+#define POWER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================
+ * CONFIGURATION
+ *============================================================================*/
+
+/* Sub atat nu merita VLPS (iesirea + relock PLL) - se asteapta in WAIT */
+#define POWER_VLPS_MIN_MS       3U
+
+/* Cel mai lung somn cerut LPTMR-ului (CMR are 16 biti) */
+#define POWER_MAX_SLEEP_MS      1000U
+
+/* Dupa un front IR in VLPS ramanem treji cat dureaza un cadru NEC + repeat */
+#define POWER_IR_AWAKE_MS       150U
+
+/* Build instrumentat (-DPOWER_PROBE): pinul e 0 cat CPU-ul e in VLPS,
+ * pentru osciloscop (latenta de trezire) si ampermetru (J4 pe FRDM) */
+#define POWER_PROBE_GPIO        GPIOB
+#define POWER_PROBE_PORT        PORTB
+#define POWER_PROBE_PIN         8U
+
+/*============================================================================
+ * TYPES
+ *============================================================================*/
+
+typedef struct {
+    uint32_t wait_entries;      /* __WFI cu SysTick pornit */
+    uint32_t vlps_entries;
+    uint32_t vlps_aborts;       /* Intrerupere venita intre verificare si WFI */
+    uint32_t pll_relocks;       /* Treziri in PBE (VLPS din PEE), readuse in PEE */
+    uint32_t vlps_ms;           /* Timp total dormit in VLPS (LPTMR) */
+    uint32_t timer_wakeups;     /* Treziri programate (LPTMR) */
+    uint32_t event_wakeups;     /* Treziri din alte surse, inainte de termen */
+} PowerStats_t;
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+/**
+ * Configureaza LPTMR0 (LPO, fara prescaler, oprit pana la primul somn),
+ * permite modurile VLP in SMC si pinul de proba (daca e compilat)
+ */
+void Power_Init(void);
+
+/**
+ * Permite/interzice VLPS (meniuri, pauza) - altfel doar WAIT
+ */
+void Power_SetDeepSleep(bool allowed);
+
+/**
+ * Tine CPU-ul in RUN/WAIT cel putin inca ms milisecunde (sigur din ISR)
+ */
+void Power_StayAwake(uint32_t ms);
+
+/**
+ * Asteapta urmatoarea intrerupere, cel mult max_ms milisecunde.
+ * Se apeleaza cu intreruperile oprite (din Scheduler_Idle) si se intoarce
+ * tot cu ele oprite; ISR-ul care a trezit CPU-ul ruleaza dupa ce
+ * apelantul le reactiveaza, cu g_systick_ms deja corectat.
+ */
+void Power_Sleep(uint32_t max_ms);
+
+/**
+ * Copiaza contoarele de somn
+ */
+void Power_GetStats(PowerStats_t* out);
+
+/**
+ * Afiseaza contoarele de somn pe consola
+ */
+void Power_PrintStats(void);
+
+#endif /* POWER_H */
@@ -0,0 +1,187 @@
+/*
+ * profiler.h
+ * Histograme de durata pe faze ale frame-ului (-DPROFILER)
+ *
+ * Timpul e in cicluri la 48 MHz, din SysTick: g_systick_ms * 48000 +
+ * (LOAD - VAL), cu partea sub o ms scalata la 48 MHz in VLPR (pas de 12
+ * cicluri). Fiecare faza are PROF_BUCKETS cosuri fixe: liniare sub
+ * 4 << PROF_SHIFT cicluri, apoi cate 4 pe octava (eroare sub 19%);
+ * ultimul cos le prinde pe toate peste ~300 ms. In afara de cosuri se
+ * tin exact numarul, suma, minimul si maximul. Fazele de CPU se masoara
+ * doar in RUN: in VLPR (meniuri) codul merge de 12 ori mai incet, deci
+ * esantioanele doar se numara.
+ *
+ * Fazele: input (Joystick_Process + IR_Process), ai (paletele: AI si
+ * input-ul jucatorilor), physics (Physics_Step), render (UpdateSprites +
+ * Compositor_Flush, inclusiv asteptarea unui strip liber) si spi (de la
+ * inceputul Compositor_Flush pana cand coada DMA a display-ului s-a golit).
+ *
+ * Latenta input -> ecran, cate o faza pe sursa (lat_btn, lat_ir,
+ * lat_joy): de la frontul care a produs inputul (ISR-ul butonului,
+ * primul front al cadrului NEC, esantionul ADC care a pornit paleta)
+ * pana cand ultimul octet al zonei redesenate a iesit pe SPI. Cine
+ * consuma inputul il eticheteaza (Prof_LatencyTag) cand schimba ceva pe
+ * ecran, iar dupa desenare Prof_LatencyCommit il leaga de transferurile
+ * din coada; Prof_LatencyDone, din ISR-ul DMA, inchide masuratoarea.
+ *
+ * La fiecare PROF_DUMP_MS, Prof_Poll goleste fazele una cate una si le
+ * trimite prin LOG, cateva linii pe apel (ringul nu se umple):
+ *   [PROF] H seq core_khz shift<<8|sub_bits ignorate_in_vlpr
+ *   [PROF] P faza count min max             (cicluri)
+ *   [PROF] S faza suma_lo suma_hi           (media = suma / count)
+ *   [PROF] B faza cos<<16|n cos<<16|n cos<<16|n   (doar cosurile nenule)
+ * Dump-ul e binar doar cu -DLOG_TOKENIZED: atunci LOG trimite fiecare
+ * linie ca un cadru de cativa octeti (decodat pe host de logdec). Fara
+ * el liniile pleaca ca text ASCII, cu zecile de octeti ale fiecareia.
+ * host/profrep face tabelele de percentile.
+ *
+ * Fara -DPROFILER macro-urile PROF_* nu genereaza nimic.
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================
+ * CONFIGURATION
+ *============================================================================*/
+
+#define PROF_SHIFT          5U      /* Cel mai mic cos: 32 cicluri (0.67 us) */
+#define PROF_SUB_BITS       2U      /* 4 cosuri pe octava */
+#define PROF_BUCKETS        72U
+#define PROF_DUMP_MS        5000U
+#define PROF_CYCLES_PER_MS  48000U  /* Unitatea de timp: ciclu la 48 MHz */
+
+/* Un input neafisat dupa atat nu mai e masurat (paleta la perete,
+ * eveniment fara efect pe ecran) */
+#define PROF_LAT_MAX_MS     500U
+
+/*============================================================================
+ * TYPES
+ *============================================================================*/
+
+/* Ordinea e si cea din host/profdump.c */
+typedef enum {
+    PROF_INPUT = 0,
+    PROF_AI,
+    PROF_PHYSICS,
+    PROF_RENDER,
+    PROF_SPI,
+    PROF_LAT_BUTTON,            /* Latente: ordinea din InputSource_t */
+    PROF_LAT_IR,
+    PROF_LAT_JOYSTICK,
+    PROF_PHASES
+} ProfPhase_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t min;               /* Cicluri */
+    uint32_t max;
+    uint64_t sum;
+    uint16_t buckets[PROF_BUCKETS];     /* Saturate la 65535 */
+} ProfHist_t;
+
+/*============================================================================
+ * MACROS
+ *============================================================================*/
+
+#if defined(PROFILER)
+
+/* Faza sincrona: inceput si sfarsit in aceeasi functie */
+#define PROF_BEGIN(phase)       uint32_t prof_t0_##phase = Prof_Now()
+#define PROF_END(phase)         Prof_Record(phase, Prof_Now() - prof_t0_##phase)
+
+/* Faza care se termina intr-un ISR (spi): Start, Close cand tot e in coada,
+ * End din ISR cand coada s-a golit */
+#define PROF_SPAN_START(phase)          Prof_SpanStart(phase)
+#define PROF_SPAN_CLOSE(phase, busy)    Prof_SpanClose(phase, busy)
+#define PROF_SPAN_END(phase)            Prof_SpanEnd(phase)
+
+#define PROF_POLL()             Prof_Poll()
+
+/* Latenta input -> ecran: source e InputSource_t, stamp = Prof_Now() la front */
+#define PROF_LATENCY_TAG(source, stamp)     Prof_LatencyTag(source, stamp)
+#define PROF_LATENCY_COMMIT(busy)           Prof_LatencyCommit(busy)
+#define PROF_LATENCY_DONE()                 Prof_LatencyDone()
+
+#else
+
+#define PROF_BEGIN(phase)       ((void)0)
+#define PROF_END(phase)         ((void)0)
+#define PROF_SPAN_START(phase)          ((void)0)
+#define PROF_SPAN_CLOSE(phase, busy)    ((void)0)
+#define PROF_SPAN_END(phase)            ((void)0)
+#define PROF_POLL()             ((void)0)
+#define PROF_LATENCY_TAG(source, stamp)     ((void)0)
+#define PROF_LATENCY_COMMIT(busy)           ((void)0)
+#define PROF_LATENCY_DONE()                 ((void)0)
+
+#endif
+
+/*============================================================================
+ * PUBLIC FUNCTIONS (doar cu -DPROFILER)
+ *============================================================================*/
+
+/**
+ * Cicluri la 48 MHz de la pornire, in orice mod de rulare (se reseteaza
+ * la ~89 s; diferentele raman corecte)
+ */
+uint32_t Prof_Now(void);
+
+/**
+ * Adauga o durata in histograma fazei (sigur din ISR)
+ */
+void Prof_Record(ProfPhase_t phase, uint32_t cycles);
+
+void Prof_SpanStart(ProfPhase_t phase);
+
+/**
+ * Totul e in coada; daca busy() e deja false durata se inregistreaza acum
+ */
+void Prof_SpanClose(ProfPhase_t phase, bool (*busy)(void));
+
+/**
+ * Apelat din ISR cand coada s-a golit; ignorat daca span-ul nu e inchis
+ */
+void Prof_SpanEnd(ProfPhase_t phase);
+
+/**
+ * Inputul sursei a schimbat ce trebuie desenat; se pastreaza cel mai
+ * vechi stamp inca neafisat (ignorat daca e mai vechi de PROF_LAT_MAX_MS)
+ */
+void Prof_LatencyTag(uint8_t source, uint32_t stamp);
+
+/**
+ * Dupa desenare: inputurile etichetate asteapta golirea cozii display-ului;
+ * daca busy() e deja false, latenta se inregistreaza acum
+ */
+void Prof_LatencyCommit(bool (*busy)(void));
+
+/**
+ * Apelat din ISR cand coada display-ului s-a golit
+ */
+void Prof_LatencyDone(void);
+
+/**
+ * Din bucla principala (task-ul ui): porneste si continua dump-ul periodic
+ */
+void Prof_Poll(void);
+
+/**
+ * Copiaza si goleste histograma unei faze
+ */
+void Prof_Take(ProfPhase_t phase, ProfHist_t* out);
+
+/**
+ * Esantioane ignorate pentru ca CPU-ul era in VLPR
+ */
+uint32_t Prof_GetSkipped(void);
+
+/**
+ * Limita de jos a unui cos, in cicluri
+ */
+uint32_t Prof_BucketLow(uint8_t bucket);
+
+#endif /* PROFILER_H */
@@ -0,0 +1,102 @@
+/*
+ * run_mode.h
+ * Managerul modului de rulare: RUN (48 MHz) in joc, VLPR (4 MHz) in meniuri
+ *
+ * Configuratiile de ceas sunt cele din board/clock_config.c
+ * (BOARD_BootClockRUN si BOARD_BootClockVLPR). Dupa fiecare schimbare
+ * perifericele care depind de ceas sunt reconfigurate de listener-ele
+ * inregistrate de drivere: SPI0 (baud), TPM0/TPM1 (MOD / prescaler),
+ * TPM2 + PIT ch1 (buzzer), SysTick, PIT; consola de debug (UART0) e reconfigurata aici.
+ *
+ * In VLPR bus-ul are 800 kHz, deci SPI0 merge cu cel mult 400 kHz: un ecran
+ * de meniu ar dura peste o secunda. Redesenarile se fac in RUN, iar
+ * coborarea in VLPR se face doar cu display-ul liber (RunMode_Update).
+ */
+
+#ifndef RUN_MODE_H
+#define RUN_MODE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================
+ * CONFIGURATION
+ *============================================================================*/
+
+#define RUN_MODE_MAX_LISTENERS  8
+
+/*============================================================================
+ * TYPES
+ *============================================================================*/
+
+typedef enum {
+    RUN_MODE_RUN = 0,       /* PEE: core 48 MHz, bus 24 MHz */
+    RUN_MODE_VLPR           /* BLPI: core 4 MHz, bus 800 kHz */
+} RunMode_t;
+
+/* Ceasurile dupa o schimbare de mod */
+typedef struct {
+    RunMode_t mode;
+    uint32_t core_hz;
+    uint32_t bus_hz;        /* SPI0, PIT */
+    uint32_t tpm_hz;        /* SIM_SOPT2[TPMSRC], comun pentru TPM0..2 */
+    uint32_t uart0_hz;      /* SIM_SOPT2[UART0SRC] */
+} RunModeClocks_t;
+
+/* Apelat cu intreruperile oprite, dupa schimbarea ceasurilor */
+typedef void (*RunModeListener_t)(const RunModeClocks_t* clocks);
+
+typedef struct {
+    uint32_t to_vlpr;       /* Treceri RUN -> VLPR */
+    uint32_t to_run;        /* Treceri VLPR -> RUN (fiecare cu relock PLL) */
+} RunModeStats_t;
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+/**
+ * Porneste in RUN (ceasurile de la BOARD_InitBootClocks)
+ */
+void RunMode_Init(void);
+
+/**
+ * Inregistreaza o functie apelata dupa fiecare schimbare de mod
+ * @return false daca lista e plina
+ */
+bool RunMode_AddListener(RunModeListener_t listener);
+
+/**
+ * Trece in modul cerut (nimic daca e deja acolo). Asteapta terminarea
+ * transferului SPI/DMA in curs; nu se apeleaza din ISR.
+ */
+void RunMode_Set(RunMode_t mode);
+
+/**
+ * Politica din task-ul ui: RUN cat e nevoie de viteza, altfel VLPR
+ * dupa ce display-ul a terminat de desenat
+ */
+void RunMode_Update(bool full_speed);
+
+/**
+ * Modul curent
+ */
+RunMode_t RunMode_Get(void);
+
+/**
+ * true intre oprirea consolei si listeneri, cand RunMode_Set schimba
+ * ceasurile cu intreruperile pornite; UART0 nu trebuie atins din ISR
+ */
+bool RunMode_IsSwitching(void);
+
+/**
+ * Ceasurile modului curent
+ */
+const RunModeClocks_t* RunMode_GetClocks(void);
+
+/**
+ * Copiaza contoarele de treceri
+ */
+void RunMode_GetStats(RunModeStats_t* out);
+
+#endif /* RUN_MODE_H */
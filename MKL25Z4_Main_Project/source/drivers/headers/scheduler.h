@@ -0,0 +1,127 @@
+/*
+ * scheduler.h
+ * Scheduler cooperativ run-to-completion
+ *
+ * Fiecare task are o perioada (ms) si o prioritate; dintre task-urile
+ * gata ruleaza cel cu prioritatea cea mai mare, iar la egalitate cel cu
+ * deadline-ul mai apropiat. Un task nu e intrerupt de alt task - doar
+ * de ISR-uri - deci un task lung intarzie restul (se vede in WCET si
+ * in overrun-uri). Cand nu e nimic gata, CPU-ul doarme (Power_Sleep)
+ * pana la urmatoarea activare periodica sau pana la o intrerupere.
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================
+ * CONFIGURATION
+ *============================================================================*/
+
+#define SCHED_MAX_TASKS     8
+
+/*============================================================================
+ * TYPES
+ *============================================================================*/
+
+typedef void (*TaskFn_t)(void);
+
+typedef struct {
+    /* Configurare (initializata static) */
+    const char* name;
+    TaskFn_t run;
+    uint16_t period_ms;     /* 0 = ruleaza doar dupa Scheduler_Notify */
+    uint8_t priority;       /* 0 = cea mai urgenta */
+
+    /* Stare interna */
+    bool enabled;
+    volatile bool notified; /* Setat din ISR */
+    uint32_t release_ms;    /* Urmatoarea activare periodica */
+
+    /* Statistici */
+    uint32_t runs;
+    uint32_t overruns;      /* Terminat dupa deadline (release + perioada) */
+    uint32_t wcet_us;       /* Cea mai lunga rulare */
+    uint32_t total_us;      /* Timp total de rulare */
+} Task_t;
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+/**
+ * Goleste lista de task-uri si statisticile de idle
+ */
+void Scheduler_Init(void);
+
+/**
+ * Adauga un task (prima activare e imediata daca enabled = true)
+ * @return false daca lista e plina
+ */
+bool Scheduler_Add(Task_t* task, bool enabled);
+
+/**
+ * Porneste/opreste un task; la pornire prima activare e imediata
+ */
+void Scheduler_SetEnabled(Task_t* task, bool enabled);
+
+/**
+ * Schimba perioada; se aplica de la urmatoarea activare
+ */
+void Scheduler_SetPeriod(Task_t* task, uint16_t period_ms);
+
+/**
+ * Marcheaza task-ul ca gata (sigur din ISR)
+ */
+void Scheduler_Notify(Task_t* task);
+
+/**
+ * Ruleaza cel mult un task gata
+ * @return true daca a rulat un task
+ */
+bool Scheduler_RunOnce(void);
+
+/**
+ * Doarme daca nu e niciun task gata (verificare cu intreruperile oprite,
+ * ca o notificare sa nu se piarda), cel mult pana la urmatoarea
+ * activare periodica
+ */
+void Scheduler_Idle(void);
+
+/**
+ * Bucla principala: Scheduler_RunOnce / Scheduler_Idle, nu se intoarce
+ */
+void Scheduler_Run(void);
+
+/**
+ * Timp in microsecunde din SysTick (se reseteaza la ~71 minute)
+ */
+uint32_t Scheduler_NowUs(void);
+
+/**
+ * g_systick_ms si ciclii SysTick scursi din milisecunda curenta, cititi
+ * impreuna. Un tick deja ajuns, al carui ISR inca asteapta, e numarat,
+ * deci timpul nu sare inapoi nici cu intreruperile oprite.
+ * @param ticks ciclii de core de la inceputul milisecundei (LOAD - VAL)
+ * @return milisecunda curenta
+ */
+uint32_t Scheduler_ReadTick(uint32_t* ticks);
+
+/**
+ * De cate ori a adormit scheduler-ul
+ */
+uint32_t Scheduler_GetIdleCount(void);
+
+/**
+ * Task-ul de pe pozitia index, sau NULL (pentru statistici)
+ */
+const Task_t* Scheduler_GetTask(uint8_t index);
+
+/**
+ * Afiseaza statisticile task-urilor pe consola
+ */
+void Scheduler_PrintStats(void);
+
+#endif /* SCHEDULER_H */
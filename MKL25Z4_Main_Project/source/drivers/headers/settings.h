@@ -0,0 +1,63 @@
+/*
+ * settings.h
+ * Setarile jucatorilor si rezultatele meciurilor, pastrate in flash
+ * peste reset (kv_store.h)
+ *
+ * La pornire Settings_Init pune in g_player1_input, g_player2_input si
+ * g_currentDifficulty valorile salvate. Schimbarile facute din meniuri si
+ * rezultatul fiecarui meci raman in RAM pana la Settings_Flush, pe care
+ * app.c o apeleaza doar dupa desenarea unui ecran de meniu / game over:
+ * comenzile flash (zeci de us, ~14 ms la o compactare) nu cad niciodata
+ * intr-un cadru de joc.
+ */
+
+#ifndef SETTINGS_H
+#define SETTINGS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================
+ * TYPES
+ *============================================================================*/
+
+typedef struct {
+    uint16_t matches;
+    uint16_t wins[2];           /* P1, P2 */
+    uint8_t last_winner;        /* 0 = niciun meci */
+    uint8_t last_score[2];
+} SettingsResults_t;
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+/**
+ * Citeste store-ul si aplica setarile salvate (valorile lipsa sau
+ * invalide raman cele implicite)
+ */
+void Settings_Init(void);
+
+/**
+ * Adauga un meci terminat la rezultate (scris la urmatorul Settings_Flush)
+ */
+void Settings_RecordMatch(uint8_t winner, uint8_t score1, uint8_t score2);
+
+/**
+ * Rezultatele curente (inclusiv cele nescrise inca)
+ */
+void Settings_GetResults(SettingsResults_t* out);
+
+/**
+ * Compara setarile curente cu cele salvate
+ * @return true daca Settings_Flush are ceva de scris
+ */
+bool Settings_Changed(void);
+
+/**
+ * Scrie in flash ce s-a schimbat; blocheaza cat dureaza comenzile flash
+ * @return false la o eroare flash (se reincearca la urmatorul apel)
+ */
+bool Settings_Flush(void);
+
+#endif /* SETTINGS_H */
@@ -0,0 +1,96 @@
+/*
+ * song.h
+ * Formatul binar al melodiilor si player-ul lor
+ *
+ * Melodiile se scriu ca text (songs/<nume>.song) si sunt compilate pe host de
+ * host/songc in tablouri de octeti (songs.c). Frecventele sunt deja
+ * perioade TPM la SONG_TONE_HZ, deci player-ul nu face nicio impartire
+ * si nicio cautare: fiecare nota e un octet + o citire din tabel.
+ *
+ * Antet:
+ *   [0]      N = intrari in tabelul de perioade (cel mult SONG_MAX_PITCHES)
+ *   [1]      tick_ms initial (durata unui tic)
+ *   [2..]    N perioade uint16 little-endian
+ * Evenimente, cate un octet PPPPPDDD:
+ *   P < 30   nota cu perioada din tabel[P]
+ *   P = 30   pauza
+ *   P = 31   comanda D, eventual cu un octet de argument
+ *   D = 0    aceeasi durata ca nota precedenta
+ *   D = 1..7 durata = 1 << (D - 1) tici
+ * Comenzi: END, TEMPO <tick_ms>, LEN <tici> (durata urmatoarelor note cu
+ * D = 0, pentru valori care nu sunt puteri ale lui 2), LOOP <n> ... ENDLOOP
+ * (corpul se canta de n ori, cel mult SONG_MAX_LOOPS bucle imbricate).
+ */
+
+#ifndef SONG_H
+#define SONG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================
+ * FORMAT
+ *============================================================================*/
+
+/* Ceasul perioadelor: TPM @ 48MHz / 8 in RUN */
+#define SONG_TONE_HZ            6000000U
+
+#define SONG_MAX_PITCHES        30U
+#define SONG_MAX_LOOPS          2U
+
+#define SONG_HEADER_BYTES       2U
+
+#define SONG_PITCH_REST         30U
+#define SONG_PITCH_CMD          31U
+#define SONG_EVENT(p, d)        ((uint8_t)(((p) << 3) | (d)))
+#define SONG_EVENT_PITCH(e)     ((uint8_t)((e) >> 3))
+#define SONG_EVENT_DUR(e)       ((uint8_t)((e) & 7U))
+
+/* D = 1..7: 1 << (D - 1) tici */
+#define SONG_DUR_MAX_CODE       7U
+
+typedef enum {
+    SONG_CMD_END = 0,
+    SONG_CMD_TEMPO,             /* + tick_ms */
+    SONG_CMD_LEN,               /* + tici */
+    SONG_CMD_LOOP,              /* + numar de repetari */
+    SONG_CMD_ENDLOOP
+} SongCmd_t;
+
+/*============================================================================
+ * TYPES
+ *============================================================================*/
+
+typedef struct {
+    uint16_t period;            /* Ticuri la SONG_TONE_HZ; 0 = pauza */
+    uint16_t ms;
+} SongNote_t;
+
+typedef struct {
+    const uint8_t* song;
+    const uint8_t* pc;          /* Urmatorul eveniment */
+    uint8_t tick_ms;
+    uint8_t ticks;              /* Durata precedenta */
+    uint8_t depth;
+    struct {
+        const uint8_t* start;
+        uint8_t left;
+    } loops[SONG_MAX_LOOPS];
+} SongPlayer_t;
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+/**
+ * Porneste o melodie de la inceput
+ */
+void Song_Start(SongPlayer_t* p, const uint8_t* song);
+
+/**
+ * Decodeaza urmatoarea nota (sau pauza)
+ * @return false la sfarsitul melodiei
+ */
+bool Song_Next(SongPlayer_t* p, SongNote_t* out);
+
+#endif /* SONG_H */
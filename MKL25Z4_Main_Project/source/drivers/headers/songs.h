@@ -0,0 +1,17 @@
+/*
+ * songs.h
+ * Generat de host/songc din songs/<nume>.song - nu se editeaza manual
+ */
+
+#ifndef SONGS_H
+#define SONGS_H
+
+#include <stdint.h>
+
+extern const uint8_t song_game_over[23];
+extern const uint8_t song_goal[12];
+extern const uint8_t song_paddle[6];
+extern const uint8_t song_speed_up[15];
+extern const uint8_t song_wall[6];
+
+#endif /* SONGS_H */
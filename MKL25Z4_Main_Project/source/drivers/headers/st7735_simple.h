@@ -49,6 +49,19 @@
 #define FONT_WIDTH   6
 #define FONT_HEIGHT  8
 
+/* Async DMA pipeline */
+#define ST7735_DMA_QUEUE_DEPTH  8   /* Transferuri in asteptare (inclusiv cel activ) */
+
+/* Trafic SPI cumulat (compilat doar cu -DST7735_STATS) */
+typedef struct {
+    uint32_t bytes;         /* Octeti trimisi (comenzi + date) */
+    uint32_t windows;       /* Secvente CASET/RASET/RAMWR */
+    uint32_t cs_toggles;    /* Activari CS */
+} ST7735_Stats_t;
+
+/* Callback apelat din intreruperea DMA cand un transfer s-a terminat */
+typedef void (*ST7735_DoneCallback_t)(void *ctx);
+
 /* Basic Functions */
 void ST7735_Init(void);
 void ST7735_FillScreen(uint16_t color);
@@ -58,11 +71,34 @@ void ST7735_DrawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
 void ST7735_DrawHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
 void ST7735_DrawVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
 
-/* Text Functions */
+/* Text Functions
+ * Textul opac (bg != color) se deseneaza cu o singura fereastra per linie;
+ * textul transparent (bg == color) pastreaza fundalul, pixel cu pixel. */
 void ST7735_DrawChar(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size);
 void ST7735_DrawString(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg);
 void ST7735_DrawStringScaled(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size);
 void ST7735_DrawStringCentered(int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size);
+/* 5 coloane (bit 0 = randul de sus) sau NULL daca nu exista in font */
+const uint8_t* ST7735_GetGlyph(char c);
+
+/* Async DMA Functions
+ * Transferurile se pun in coada si sunt trimise pe SPI0 de DMA, in ordine.
+ * Daca coada e plina, apelul asteapta eliberarea unui slot.
+ * Functiile sincrone de mai sus asteapta golirea cozii inainte sa scrie pe SPI.
+ * Nu se apeleaza din callback (ruleaza in intrerupere). */
+bool ST7735_FillRectAsync(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color,
+                          ST7735_DoneCallback_t cb, void *ctx);
+/* pixels: RGB565 big-endian (octetul high primul), w*h*2 octeti, valid pana la callback.
+ * Dreptunghiul trebuie sa fie complet pe ecran. */
+bool ST7735_BlitAsync(int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t *pixels,
+                      ST7735_DoneCallback_t cb, void *ctx);
+bool ST7735_IsBusy(void);
+void ST7735_WaitIdle(void);
+
+#ifdef ST7735_STATS
+void ST7735_GetStats(ST7735_Stats_t *out);
+void ST7735_ResetStats(void);
+#endif
 
 /* UI Helper Functions */
 void ST7735_DrawMenuBox(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t borderColor, uint16_t fillColor);
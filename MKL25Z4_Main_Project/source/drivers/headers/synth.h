@@ -0,0 +1,100 @@
+/*
+ * synth.h
+ * Sintetizator cu tabele de unda: pana la SYNTH_VOICES voci mixate in
+ * blocuri de esantioane pentru DAC
+ *
+ * Fiecare voce e un acumulator de faza pe 32 de biti care parcurge o
+ * tabela de SYNTH_WAVE_LEN esantioane int8. Mixarea e in virgula fixa:
+ * esantion * volum, deplasat cu SYNTH_MIX_SHIFT si adunat peste mijlocul
+ * DAC-ului; patru voci la volum maxim raman in cei 12 biti fara saturare.
+ *
+ * Nu atinge hardware-ul: audio_dac_kl25z.c mixeaza un bloc din
+ * intreruperea DMA, iar pe host pong_bench -m masoara costul per esantion.
+ * Durata notei e numarata in esantioane de mixer; cand ajunge la 0 se
+ * apeleaza callback-ul din Synth_Init, chiar in mijlocul blocului, ca
+ * nota urmatoare sa inceapa pe esantionul potrivit.
+ */
+
+#ifndef SYNTH_H
+#define SYNTH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================
+ * CONFIGURATION
+ *============================================================================*/
+
+#define SYNTH_VOICES        4U
+#define SYNTH_SAMPLE_HZ     16000U
+#define SYNTH_BLOCK         64U             /* Esantioane per bloc (4 ms) */
+
+#define SYNTH_WAVE_BITS     6U
+#define SYNTH_WAVE_LEN      (1U << SYNTH_WAVE_BITS)
+#define SYNTH_PHASE_SHIFT   (32U - SYNTH_WAVE_BITS)
+
+#define SYNTH_VOLUME_MAX    255U
+#define SYNTH_DAC_MID       2048U           /* Liniste: mijlocul DAC-ului pe 12 biti */
+
+/* 127 * 255 >> 6 = 506 per voce, 4 voci = 2024 < 2048 */
+#define SYNTH_MIX_SHIFT     6U
+
+/*============================================================================
+ * TYPES
+ *============================================================================*/
+
+typedef enum {
+    SYNTH_WAVE_SQUARE = 0,
+    SYNTH_WAVE_TRIANGLE,
+    SYNTH_WAVE_SINE,
+    SYNTH_WAVE_COUNT
+} SynthWave_t;
+
+/* Apelat din Synth_Mix cand nota unei voci s-a terminat */
+typedef void (*SynthNoteDone_t)(uint8_t voice);
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+/**
+ * Opreste toate vocile
+ * @param on_done Callback la sfarsitul fiecarei note (poate fi NULL)
+ */
+void Synth_Init(SynthNoteDone_t on_done);
+
+/**
+ * Alege tabela si volumul unei voci (faza se pastreaza)
+ */
+void Synth_SetVoice(uint8_t voice, SynthWave_t wave, uint8_t volume);
+
+/**
+ * Porneste o nota
+ * @param step     Pasul de faza per esantion (0 = pauza)
+ * @param samples  Durata in esantioane (0 = vocea se opreste)
+ */
+void Synth_Note(uint8_t voice, uint32_t step, uint32_t samples);
+
+/**
+ * Opreste o voce fara callback
+ */
+void Synth_Stop(uint8_t voice);
+
+/**
+ * Pasul de faza pentru o frecventa in mHz (pentru teste si calibrare;
+ * face o impartire pe 64 de biti)
+ */
+uint32_t Synth_StepForMilliHz(uint32_t mhz);
+
+/**
+ * Mixeaza n esantioane DAC pe 12 biti (aliniate la dreapta)
+ * @return Numarul de voci care mai canta dupa bloc
+ */
+uint8_t Synth_Mix(uint16_t* out, uint32_t n);
+
+/**
+ * true daca vocea are o nota (inclusiv pauza) in curs
+ */
+bool Synth_IsActive(uint8_t voice);
+
+#endif /* SYNTH_H */
@@ -0,0 +1,68 @@
+/*
+ * timeline.h
+ * Secvente de pasi temporizati (overlay-uri, pauze) fara blocare
+ *
+ * Fiecare pas are o actiune (desenare) si o durata. Timeline_Update e
+ * apelat din tick-ul jocului (PIT, 50 Hz) si avanseaza la pasul urmator
+ * cand g_systick_ms trece de termen - main loop-ul nu mai sta in delay_ms
+ * si continua sa proceseze input-ul.
+ */
+
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================
+ * TYPES
+ *============================================================================*/
+
+typedef void (*TimelineAction_t)(void);
+
+typedef struct {
+    TimelineAction_t action;    /* Rulat la intrarea in pas (poate fi NULL) */
+    uint16_t hold_ms;           /* Cat ramane pasul activ */
+} TimelineStep_t;
+
+typedef struct {
+    const TimelineStep_t* steps;
+    uint8_t count;
+    uint8_t index;              /* Pasul curent; count = terminat */
+    uint8_t replay;             /* Reia pasul curent la urmatorul Update */
+    uint32_t due_ms;            /* Termenul pasului curent (g_systick_ms) */
+} Timeline_t;
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+/**
+ * Porneste o secventa: primul pas ruleaza imediat
+ * @param steps Tabel constant (trebuie sa existe cat ruleaza secventa)
+ */
+void Timeline_Start(Timeline_t* t, const TimelineStep_t* steps, uint8_t count);
+
+/**
+ * Avanseaza secventa daca pasul curent a expirat
+ * @return true cat timp secventa este in desfasurare
+ */
+bool Timeline_Update(Timeline_t* t);
+
+/**
+ * Verifica daca secventa este in desfasurare
+ */
+bool Timeline_IsActive(const Timeline_t* t);
+
+/**
+ * Opreste secventa fara a rula pasii ramasi
+ */
+void Timeline_Cancel(Timeline_t* t);
+
+/**
+ * La urmatorul Update, pasul curent se redeseneaza si isi reia durata
+ * (ex: dupa pauza, cand ecranul a fost redesenat peste overlay)
+ */
+void Timeline_Replay(Timeline_t* t);
+
+#endif /* TIMELINE_H */
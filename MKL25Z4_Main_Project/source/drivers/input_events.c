@@ -0,0 +1,124 @@
+/*
+ * input_events.c
+ * Ring-uri SPSC per sursa + consum in ordinea timestamp-urilor
+ */
+
+#include "headers/input_events.h"
+#include "headers/profiler.h"
+#include "MKL25Z4.h"
+#include <stddef.h>
+
+/*============================================================================
+ * RINGS
+ *============================================================================*/
+
+#define RING_MASK   (INPUT_RING_SIZE - 1U)
+
+typedef struct {
+    InputEvent_t events[INPUT_RING_SIZE];
+    volatile uint8_t head;      /* Scris doar de producator */
+    volatile uint8_t tail;      /* Scris doar de consumator */
+    volatile uint32_t dropped;  /* Scris doar de producator */
+} InputRing_t;
+
+static InputRing_t rings[INPUT_NUM_SOURCES];
+static InputStats_t stats;
+
+/*============================================================================
+ * PRIVATE FUNCTIONS
+ *============================================================================*/
+
+static bool RingEmpty(const InputRing_t* r) {
+    return r->head == r->tail;
+}
+
+/* a e mai vechi decat b (sigur la overflow-ul lui g_systick_ms) */
+static bool Older(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) < 0;
+}
+
+static void Consume(InputRing_t* r, InputEvent_t* ev) {
+    *ev = r->events[r->tail & RING_MASK];
+    __DMB();    /* Copia e completa inainte ca slotul sa fie eliberat */
+    r->tail++;
+
+    uint32_t latency = g_systick_ms - ev->stamp_ms;
+    stats.consumed++;
+    stats.latency_sum_ms += latency;
+    if (latency > stats.latency_max_ms) stats.latency_max_ms = latency;
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+#if defined(PROFILER)
+bool InputEvents_Push(InputSource_t source, UI_Action_t action, int32_t value) {
+    return InputEvents_PushAt(source, action, value, Prof_Now());
+}
+
+bool InputEvents_PushAt(InputSource_t source, UI_Action_t action, int32_t value, uint32_t stamp_cycles) {
+#else
+bool InputEvents_Push(InputSource_t source, UI_Action_t action, int32_t value) {
+#endif
+    InputRing_t* r = &rings[source];
+    uint8_t head = r->head;
+
+    if ((uint8_t)(head - r->tail) >= INPUT_RING_SIZE) {
+        r->dropped++;
+        return false;
+    }
+
+    InputEvent_t* ev = &r->events[head & RING_MASK];
+    ev->stamp_ms = g_systick_ms;
+    ev->value = value;
+    ev->source = (uint8_t)source;
+    ev->action = (uint8_t)action;
+#if defined(PROFILER)
+    ev->stamp_cycles = stamp_cycles;
+#endif
+
+    __DMB();    /* Evenimentul e scris inainte sa devina vizibil */
+    r->head = head + 1U;
+    return true;
+}
+
+bool InputEvents_Pop(InputEvent_t* ev) {
+    InputRing_t* oldest = NULL;
+
+    for (uint8_t s = 0; s < INPUT_NUM_SOURCES; s++) {
+        InputRing_t* r = &rings[s];
+        if (RingEmpty(r)) continue;
+        if (oldest == NULL ||
+            Older(r->events[r->tail & RING_MASK].stamp_ms,
+                  oldest->events[oldest->tail & RING_MASK].stamp_ms)) {
+            oldest = r;
+        }
+    }
+
+    if (oldest == NULL) return false;
+    Consume(oldest, ev);
+    return true;
+}
+
+bool InputEvents_PopSource(InputSource_t source, InputEvent_t* ev) {
+    InputRing_t* r = &rings[source];
+
+    if (RingEmpty(r)) return false;
+    Consume(r, ev);
+    return true;
+}
+
+void InputEvents_Flush(void) {
+    for (uint8_t s = 0; s < INPUT_NUM_SOURCES; s++) {
+        rings[s].tail = rings[s].head;
+    }
+}
+
+void InputEvents_GetStats(InputStats_t* out) {
+    *out = stats;
+    out->dropped = 0;
+    for (uint8_t s = 0; s < INPUT_NUM_SOURCES; s++) {
+        out->dropped += rings[s].dropped;
+    }
+}
@@ -0,0 +1,193 @@
+/*
+ * ir_remote_kl25z.c
+ * Partea hardware a receptorului IR pe FRDM-KL25Z
+ * Pin: PTA12 (TPM1_CH0, input capture pe ambele fronturi)
+ *
+ * Fronturile sunt marcate in hardware de TPM; ISR-ul transforma distanta
+ * dintre doua fronturi in microsecunde si o da lui IR_FeedPulse.
+ * In VLPS (power.c) TPM1 sta pe loc: primul front vine ca intrerupere de
+ * pin pe PORTA, care trezeste CPU-ul si il inregistreaza ca referinta.
+ * La o schimbare RUN/VLPR prescaler-ul si conversia tick -> us sunt
+ * recalculate; un cadru in curs se pierde (NEC il repeta).
+ */
+
+#include "headers/ir_remote.h"
+#include "headers/power.h"
+#include "headers/run_mode.h"
+#include "headers/log.h"
+#include "MKL25Z4.h"
+#include "fsl_port.h"
+#include "fsl_clock.h"
+#include "fsl_debug_console.h"
+
+/*============================================================================
+ * HARDWARE CONFIGURATION
+ *============================================================================*/
+
+#define IR_PIN          12U
+#define IR_PORT         PORTA
+#define IR_TPM          TPM1
+#define IR_TPM_CHANNEL  0U
+#define IR_IRQ          TPM1_IRQn
+
+/* PTA12 ALT3 = TPM1_CH0 */
+#define IR_PIN_MUX      kPORT_MuxAlt3
+
+/*============================================================================
+ * TIMER
+ * RUN:  TPM1 @ 48MHz / 32 = 1.5MHz, 1 tick = 0.667 us, overflow la ~43.7 ms
+ * VLPR: TPM1 @ 4MHz / 4 = 1MHz, 1 tick = 1 us, overflow la ~65.5 ms
+ * Overflow-ul trebuie sa ramana peste headerul NEC (9 ms + 4.5 ms).
+ *============================================================================*/
+
+#define IR_TPM_MAX_HZ       1500000U
+
+/* Sursa TPM la pornire: MCGPLLCLK/2 */
+#define IR_TPM_BOOT_HZ      48000000U
+
+/*============================================================================
+ * GLOBAL VARIABLES
+ *============================================================================*/
+
+/* Ultimul front capturat */
+static volatile uint16_t last_edge = 0;
+static volatile uint8_t overflows = 0;
+
+/* us per tick in Q16: 65535 ticks * 65536 (1 MHz) incape in 32 de biti */
+static uint32_t tick_us_q16;
+static uint8_t tpm_prescaler;
+
+/*============================================================================
+ * INTERRUPT HANDLER - Input capture TPM1_CH0
+ *============================================================================*/
+
+static void IR_HandleOverflow(void) {
+    if (overflows < 2) overflows++;
+}
+
+static void IR_HandleCapture(uint16_t edge) {
+    uint32_t width;
+
+    /* Un overflow e normal daca frontul nou e "inainte" de cel vechi */
+    if (overflows == 0 || (overflows == 1 && edge < last_edge)) {
+        uint16_t ticks = (uint16_t)(edge - last_edge);
+        width = ((uint32_t)ticks * tick_us_q16) >> 16;
+    } else {
+        width = IR_WIDTH_IDLE;
+    }
+
+    last_edge = edge;
+    overflows = 0;
+
+    IR_FeedPulse(width);
+}
+
+void TPM1_IRQHandler(void) {
+    uint32_t status = IR_TPM->STATUS & (TPM_STATUS_CH0F_MASK | TPM_STATUS_TOF_MASK);
+
+    /* Write-1-to-clear pentru ambele flag-uri */
+    IR_TPM->STATUS = status;
+
+    if (status & TPM_STATUS_CH0F_MASK) {
+        uint16_t edge = (uint16_t)IR_TPM->CONTROLS[IR_TPM_CHANNEL].CnV;
+
+        /* Ambele flag-uri setate: overflow-ul a venit inaintea capturii
+         * doar daca valoarea capturata e mica (dupa wrap) */
+        if ((status & TPM_STATUS_TOF_MASK) && edge < 0x8000U) {
+            IR_HandleOverflow();
+            status &= ~TPM_STATUS_TOF_MASK;
+        }
+        IR_HandleCapture(edge);
+    }
+
+    if (status & TPM_STATUS_TOF_MASK) {
+        IR_HandleOverflow();
+    }
+}
+
+/*============================================================================
+ * INTERRUPT HANDLER - Front IR in VLPS
+ *============================================================================*/
+
+void PORTA_IRQHandler(void) {
+    if (!(PORT_GetPinsInterruptFlags(IR_PORT) & (1U << IR_PIN))) return;
+    PORT_ClearPinsInterruptFlags(IR_PORT, 1U << IR_PIN);
+
+    /* TPM1 a pornit odata cu CPU-ul: frontul de trezire devine ultimul
+     * front capturat (headerul de 9 ms inghite latenta de trezire) */
+    last_edge = (uint16_t)IR_TPM->CNT;
+    overflows = 0;
+    IR_FeedPulse(IR_WIDTH_IDLE);
+
+    /* Restul cadrului vine prin TPM1 - fara VLPS pana se termina */
+    Power_StayAwake(POWER_IR_AWAKE_MS);
+}
+
+void IR_HwSetWakeArmed(bool armed) {
+    uint32_t irqc = armed ? kPORT_InterruptFallingEdge : kPORT_InterruptOrDMADisabled;
+
+    /* Fara ISF (write-1-to-clear): frontul de trezire ramane pentru ISR */
+    IR_PORT->PCR[IR_PIN] = (IR_PORT->PCR[IR_PIN] & ~(PORT_PCR_IRQC_MASK | PORT_PCR_ISF_MASK)) |
+                           PORT_PCR_IRQC(irqc);
+}
+
+/*============================================================================
+ * INITIALIZATION
+ *============================================================================*/
+
+/* Cel mai mic prescaler care aduce TPM1 sub IR_TPM_MAX_HZ */
+static void IR_SetTimebase(uint32_t tpm_hz) {
+    uint8_t ps = 0;
+    while (ps < 7U && (tpm_hz >> ps) > IR_TPM_MAX_HZ) ps++;
+
+    tpm_prescaler = ps;
+    tick_us_q16 = (uint32_t)((1000000ULL << 16) / (tpm_hz >> ps));
+}
+
+static void IR_OnRunMode(const RunModeClocks_t* clocks) {
+    IR_TPM->SC = 0;
+    IR_SetTimebase(clocks->tpm_hz);
+
+    /* Distanta pana la frontul anterior nu mai are sens: urmatorul front
+     * e tratat ca primul dupa pauza */
+    overflows = 2;
+    IR_TPM->STATUS = TPM_STATUS_CH0F_MASK | TPM_STATUS_TOF_MASK;
+    IR_TPM->SC = TPM_SC_PS(tpm_prescaler) | TPM_SC_TOIE_MASK | TPM_SC_CMOD(1);
+}
+
+void IR_HwInit(void) {
+    /* Enable clocks */
+    CLOCK_EnableClock(kCLOCK_PortA);
+    CLOCK_EnableClock(kCLOCK_Tpm1);
+
+    /* PTA12 -> TPM1_CH0, pull-up (iesirea receptorului e activa in 0) */
+    PORT_SetPinMux(IR_PORT, IR_PIN, IR_PIN_MUX);
+    IR_PORT->PCR[IR_PIN] |= PORT_PCR_PE_MASK | PORT_PCR_PS_MASK;
+
+    last_edge = 0;
+    overflows = 0;
+
+    /* Clock source: MCGPLLCLK/2 = 48MHz, prescaler /32 = 1.5MHz */
+    CLOCK_SetTpmClock(1U);
+    IR_SetTimebase(IR_TPM_BOOT_HZ);
+
+    IR_TPM->SC = 0;         /* Stop timer */
+    IR_TPM->CNT = 0;        /* Reset counter */
+    IR_TPM->MOD = 0xFFFF;   /* Free-running */
+
+    /* Input capture pe ambele fronturi, cu intrerupere */
+    IR_TPM->CONTROLS[IR_TPM_CHANNEL].CnSC = TPM_CnSC_ELSB_MASK | TPM_CnSC_ELSA_MASK | TPM_CnSC_CHIE_MASK;
+    IR_TPM->STATUS = TPM_STATUS_CH0F_MASK | TPM_STATUS_TOF_MASK;
+
+    NVIC_SetPriority(IR_IRQ, 2);
+    EnableIRQ(IR_IRQ);
+
+    /* Intreruperea de pin e armata doar cat CPU-ul e in VLPS */
+    NVIC_SetPriority(PORTA_IRQn, 2);
+    EnableIRQ(PORTA_IRQn);
+
+    IR_TPM->SC = TPM_SC_PS(tpm_prescaler) | TPM_SC_TOIE_MASK | TPM_SC_CMOD(1);
+    RunMode_AddListener(IR_OnRunMode);
+
+    LOG_BOOT("[IR] Initialized on PTA12 with TPM1_CH0 input capture\r\n");
+}
@@ -1,15 +1,23 @@
 /*
  * joystick.c
- * Driver pentru joystick analog cu buton
- * VRY pe PTB1 (ADC0_SE9), SW pe PTD4
+ * Driver pentru joystick analog cu buton - partea independenta de hardware
+ *
+ * Esantioanele vin prin Joystick_PushSample (ISR-ul ADC din
+ * joystick_kl25z.c sau thread-ul de esantionare Zephyr) intr-un ring,
+ * iar Joystick_Process le trece prin filtrul IIR - bucla principala
+ * nu mai asteapta dupa ADC.
+ *
+ * Primele esantioane de dupa pornire dau centrul stick-ului, iar cursa
+ * pe fiecare parte se extinde automat la cea mai mare deviatie vazuta.
+ * Viteza paletei vine dintr-un tabel precalculat (curba liniara/expo).
  */
 
 #include "headers/joystick.h"
+#include "headers/input_events.h"
+#include "headers/adc_filter.h"
+#include "headers/profiler.h"
+#include "headers/log.h"
 #include "MKL25Z4.h"
-#include "fsl_adc16.h"
-#include "fsl_gpio.h"
-#include "fsl_port.h"
-#include "fsl_clock.h"
 #include "fsl_debug_console.h"
 
 /*============================================================================
@@ -24,48 +32,104 @@
 /* Dead zone pentru joc (mai mica pentru control precis) */
 #define GAME_DEADZONE       15
 
+/*============================================================================
+ * CALIBRATION + RESPONSE
+ *============================================================================*/
+
+/* Centrul = media primelor 2^6 esantioane (64 ms), stick-ul in repaus */
+#define CALIB_SHIFT         6U
+#define CALIB_SAMPLES       (1U << CALIB_SHIFT)
+
+/* Centru nominal la 12 biti; un centru mai departat de atat = stick miscat la boot */
+#define ADC_CENTER_NOMINAL  2048
+#define CALIB_MAX_OFFSET    400
+
+/* Cursa minima pe o parte - creste automat pana la capatul real */
+#define RANGE_MIN           1200U
+
+/* Deflexia normalizata e Q7: 0 = centru, RESP_ONE = capat de cursa */
+#define RESP_SHIFT          7U
+#define RESP_ONE            (1U << RESP_SHIFT)
+
+/* Ponderea termenului cubic in curba expo (din RESP_ONE) */
+#define RESP_EXPO           80U
+
+/* Viteza la capat de cursa, Q8.8 px/frame */
+#define RESP_MAX_SPEED      ((int32_t)PADDLE_SPEED << 8)
+
+/*============================================================================
+ * SAMPLING
+ *============================================================================*/
+
+/* Putere a lui 2; ISR-ul produce, Joystick_Process consuma */
+#define JOYSTICK_RING_SIZE      8U
+
 /*============================================================================
  * GLOBAL VARIABLES
  *============================================================================*/
 
-static volatile bool btn_pressed_flag = false;
 static int16_t y_percent = 0;
 static bool menu_action_consumed = false;
 
+/* Esantioane ADC, scrise din Joystick_PushSample */
+static volatile uint16_t samples[JOYSTICK_RING_SIZE];
+static volatile uint8_t samples_head = 0;
+static volatile uint8_t samples_tail = 0;
+static volatile uint32_t sample_count = 0;
+static bool low_power = false;
+
+#if defined(PROFILER)
+/* Latenta (profiler.h): Prof_Now() al fiecarui esantion din ring si al
+ * celui care a pornit paleta */
+static uint32_t sample_stamps[JOYSTICK_RING_SIZE];
+static uint32_t last_stamp = 0;
+static uint32_t move_stamp = 0;
+static bool move_stamp_new = false;
+#endif
+
+static AdcFilter_t y_filter;
+
+/* Calibrare: centru + cursa sus/jos (unitati ADC) */
+static uint32_t calib_sum = 0;
+static uint8_t calib_count = 0;
+static bool calibrated = false;
+static int16_t center = ADC_CENTER_NOMINAL;
+static uint16_t range[2] = { RANGE_MIN, RANGE_MIN };   /* [0] = sus, [1] = jos */
+static uint32_t range_scale[2];                         /* RESP_ONE / cursa, Q16 */
+
+/* Deflexie Q7 -> viteza paleta Q8.8 (dead zone inclus) */
+static int16_t response[RESP_ONE + 1];
+static int16_t paddle_speed = 0;
+
+/* Ultimul front pe buton (debounce in Joystick_PushButton) */
+static uint32_t button_last_ms;
+static bool button_seen = false;
+
 /* Extern: timer global din main */
 extern volatile uint32_t g_systick_ms;
 
 /*============================================================================
- * INTERRUPT HANDLER - Buton joystick
+ * PRIVATE FUNCTIONS
  *============================================================================*/
 
-void PORTD_IRQHandler(void) {
-    uint32_t isfr = PORT_GetPinsInterruptFlags(JOYSTICK_SW_PORT);
-    
-    if (isfr & (1U << JOYSTICK_SW_PIN)) {
-        PORT_ClearPinsInterruptFlags(JOYSTICK_SW_PORT, 1U << JOYSTICK_SW_PIN);
-        btn_pressed_flag = true;
-    }
+/* Reciproca cursei, ca deflexia sa se normalizeze fara impartire per esantion */
+static void Joystick_UpdateScale(uint8_t side) {
+    range_scale[side] = ((uint32_t)RESP_ONE << 16) / range[side];
 }
 
-/*============================================================================
- * PRIVATE FUNCTIONS
- *============================================================================*/
-
-static uint16_t ReadADC(uint32_t channel) {
-    adc16_channel_config_t chConfig = {
-        .channelNumber = channel,
-        .enableInterruptOnConversionCompleted = false,
-        .enableDifferentialConversion = false
-    };
-    
-    ADC16_SetChannelConfig(ADC0, 0, &chConfig);
+static void Joystick_FinishCalibration(void) {
+    int16_t measured = (int16_t)(calib_sum >> CALIB_SHIFT);
     
-    /* Asteapta conversie completa */
-    while (0U == (kADC16_ChannelConversionDoneFlag & 
-                  ADC16_GetChannelStatusFlags(ADC0, 0)));
+    if (measured > ADC_CENTER_NOMINAL - CALIB_MAX_OFFSET &&
+        measured < ADC_CENTER_NOMINAL + CALIB_MAX_OFFSET) {
+        center = measured;
+        LOG("[Joystick] Calibrated center: %d\r\n", center);
+    } else {
+        center = ADC_CENTER_NOMINAL;
+        LOG("[Joystick] Center %d out of range, using %d\r\n", measured, center);
+    }
     
-    return ADC16_GetChannelConversionValue(ADC0, 0);
+    calibrated = true;
 }
 
 /*============================================================================
@@ -73,70 +137,142 @@ static uint16_t ReadADC(uint32_t channel) {
  *============================================================================*/
 
 void Joystick_Init(void) {
-    adc16_config_t adcConfig;
+    AdcFilter_Init(&y_filter, JOYSTICK_FILTER_SHIFT);
+    samples_head = samples_tail = 0;
+    low_power = false;
     
-    /* Enable clocks */
-    CLOCK_EnableClock(kCLOCK_Adc0);
-    CLOCK_EnableClock(kCLOCK_PortB);  /* Pentru pinii analogici */
-    CLOCK_EnableClock(kCLOCK_PortD);  /* Pentru buton */
+    /* Calibrarea ruleaza pe primele esantioane din Joystick_Process */
+    calib_sum = 0;
+    calib_count = 0;
+    calibrated = false;
+    for (uint8_t side = 0; side < 2; side++) {
+        range[side] = RANGE_MIN;
+        Joystick_UpdateScale(side);
+    }
+    Joystick_SetCurve(JOYSTICK_DEFAULT_CURVE);
     
-    /* Configure ADC */
-    ADC16_GetDefaultConfig(&adcConfig);
-    adcConfig.resolution = kADC16_ResolutionSE12Bit;
-    ADC16_Init(ADC0, &adcConfig);
-    ADC16_DoAutoCalibration(ADC0);
+    /* ADC + buton: joystick_kl25z.c sau port-ul Zephyr */
+    Joystick_HwInit();
+}
+
+void Joystick_PushSample(uint16_t value) {
+    uint8_t next = (samples_head + 1U) & (JOYSTICK_RING_SIZE - 1U);
     
-    /* Configure button pin PTD4 */
-    PORT_SetPinMux(JOYSTICK_SW_PORT, JOYSTICK_SW_PIN, kPORT_MuxAsGpio);
-    /* Enable pull-up */
-    JOYSTICK_SW_PORT->PCR[JOYSTICK_SW_PIN] |= PORT_PCR_PE_MASK | PORT_PCR_PS_MASK;
+    sample_count++;
     
-    gpio_pin_config_t sw_config = {kGPIO_DigitalInput, 0};
-    GPIO_PinInit(JOYSTICK_SW_GPIO, JOYSTICK_SW_PIN, &sw_config);
+    /* Ring plin (bucla principala blocata): esantionul nou se pierde,
+     * filtrul se reia din urmatoarele */
+    if (next == samples_tail) return;
     
-    /* Configure interrupt on falling edge (button press = GND) */
-    PORT_SetPinInterruptConfig(JOYSTICK_SW_PORT, JOYSTICK_SW_PIN, 
-                               kPORT_InterruptFallingEdge);
+    samples[samples_head] = value;
+#if defined(PROFILER)
+    sample_stamps[samples_head] = Prof_Now();
+#endif
+    __DMB();
+    samples_head = next;
+}
+
+void Joystick_PushButton(bool pressed) {
+    uint32_t now = g_systick_ms;
+    bool quiet = !button_seen || (now - button_last_ms) >= JOYSTICK_SW_LOCKOUT_MS;
     
-    NVIC_SetPriority(JOYSTICK_SW_IRQ, 3);
-    EnableIRQ(JOYSTICK_SW_IRQ);
+    /* Orice front (si cele ignorate) reporneste fereastra */
+    button_seen = true;
+    button_last_ms = now;
     
-    PRINTF("[Joystick] Initialized (VRY=PTB1, SW=PTD4)\r\n");
+    if (pressed && quiet) {
+        InputEvents_Push(INPUT_SRC_BUTTON, ACTION_SELECT, 0);
+    }
 }
 
 void Joystick_Process(void) {
-    uint16_t y_raw = ReadADC(JOYSTICK_VRY_CHANNEL);
+    uint8_t tail = samples_tail;
+    
+    /* La cerere: rezultatul intra in ring si e procesat la urmatorul apel */
+    if (low_power) {
+        Joystick_HwStartConversion();
+    }
     
-    /* Centrul este ~2048 (la 12 biti). Convertim la procent (-100 la +100) */
+    /* Esantioanele noi din ring, prin filtru */
+    if (tail == samples_head) return;
+    while (tail != samples_head) {
+        uint16_t sample = samples[tail];
+        AdcFilter_Feed(&y_filter, sample);
+#if defined(PROFILER)
+        last_stamp = sample_stamps[tail];
+#endif
+        if (calib_count < CALIB_SAMPLES) {
+            calib_sum += sample;
+            calib_count++;
+        }
+        tail = (tail + 1U) & (JOYSTICK_RING_SIZE - 1U);
+    }
+    __DMB();
+    samples_tail = tail;
+    
+    if (!calibrated) {
+        if (calib_count < CALIB_SAMPLES) return;
+        Joystick_FinishCalibration();
+    }
+    
+    /* Deviatia fata de centru; cursa se extinde daca stick-ul ajunge mai departe */
     /* Nota: valorile pot fi inversate in functie de orientarea joystick-ului */
-    y_percent = ((int32_t)y_raw - 2048) * 100 / 2048;
+    int32_t dev = (int32_t)AdcFilter_Get(&y_filter) - center;
+    uint8_t side = (dev > 0) ? 1U : 0U;
+    uint32_t mag = (uint32_t)((dev < 0) ? -dev : dev);
+    
+    if (mag > range[side]) {
+        range[side] = (uint16_t)mag;
+        Joystick_UpdateScale(side);
+    }
+    
+    uint32_t norm = (mag * range_scale[side]) >> 16;
+    if (norm > RESP_ONE) norm = RESP_ONE;
+    
+#if defined(PROFILER)
+    int16_t prev_speed = paddle_speed;
+#endif
+    
+    /* Procent (-100 la +100) si viteza paletei din tabel */
+    y_percent = (int16_t)((norm * 100U) >> RESP_SHIFT);
+    paddle_speed = response[norm];
+    if (!side) {
+        y_percent = -y_percent;
+        paddle_speed = -paddle_speed;
+    }
+    
+#if defined(PROFILER)
+    /* Paleta porneste sau isi schimba sensul: intarzierea filtrului IIR
+     * nu e numarata, doar drumul de la esantion la ecran */
+    if (paddle_speed != 0 && (prev_speed == 0 || (prev_speed < 0) != (paddle_speed < 0))) {
+        move_stamp = last_stamp;
+        move_stamp_new = true;
+    }
+#endif
     
     /* Reset consumed flag cand joystick-ul e in dead zone */
     if (y_percent > -MENU_DEADZONE && y_percent < MENU_DEADZONE) {
         menu_action_consumed = false;
     }
-}
-
-UI_Action_t Joystick_GetMenuAction(void) {
-    /* Verifica buton */
-    if (btn_pressed_flag) {
-        btn_pressed_flag = false;
-        return ACTION_SELECT;
-    }
     
-    /* Verifica miscare joystick (cu debounce) */
+    /* Un eveniment de meniu per deplasare peste prag (debounce) */
     if (!menu_action_consumed) {
         if (y_percent > MENU_THRESHOLD) {
             menu_action_consumed = true;
-            return ACTION_DOWN;  /* Joystick in jos = meniu jos */
-        }
-        if (y_percent < -MENU_THRESHOLD) {
+            INPUT_EVENTS_PUSH_AT(INPUT_SRC_JOYSTICK, ACTION_DOWN, y_percent, last_stamp);  /* Joystick in jos = meniu jos */
+        } else if (y_percent < -MENU_THRESHOLD) {
             menu_action_consumed = true;
-            return ACTION_UP;    /* Joystick in sus = meniu sus */
+            INPUT_EVENTS_PUSH_AT(INPUT_SRC_JOYSTICK, ACTION_UP, y_percent, last_stamp);    /* Joystick in sus = meniu sus */
         }
     }
+}
+
+void Joystick_SetLowPower(bool enable) {
+    if (enable == low_power) return;
     
-    return ACTION_NONE;
+    low_power = enable;
+    AdcFilter_SetShift(&y_filter, enable ? JOYSTICK_IDLE_FILTER_SHIFT : JOYSTICK_FILTER_SHIFT);
+    Joystick_HwSetContinuous(!enable);
 }
 
 int16_t Joystick_GetY_Percent(void) {
@@ -154,15 +290,54 @@ int8_t Joystick_GetGameDirection(void) {
     return 0;  /* Neutru */
 }
 
-bool Joystick_ButtonPressed(void) {
-    if (btn_pressed_flag) {
-        btn_pressed_flag = false;
-        return true;
+int16_t Joystick_GetPaddleSpeed(void) {
+    return paddle_speed;
+}
+
+void Joystick_SetCurve(JoystickCurve_t curve) {
+    const uint32_t dz = GAME_DEADZONE * RESP_ONE / 100U;
+    
+    for (uint32_t i = 0; i <= RESP_ONE; i++) {
+        if (i <= dz) {
+            response[i] = 0;
+            continue;
+        }
+        
+        /* Dead zone scos, restul cursei intins pe 0..RESP_ONE */
+        uint32_t t = (i - dz) * RESP_ONE / (RESP_ONE - dz);
+        
+        /* Expo: amestec de x si x^3 - fin langa centru, aceeasi viteza la capat */
+        if (curve == JOYSTICK_CURVE_EXPO) {
+            uint32_t cube = (t * t * t) >> (2U * RESP_SHIFT);
+            t = (t * (RESP_ONE - RESP_EXPO) + cube * RESP_EXPO) >> RESP_SHIFT;
+        }
+        
+        response[i] = (int16_t)(((int32_t)t * RESP_MAX_SPEED) >> RESP_SHIFT);
     }
-    return false;
+}
+
+uint32_t Joystick_GetSampleCount(void) {
+    return sample_count;
+}
+
+bool Joystick_ButtonPressed(void) {
+    InputEvent_t ev;
+    return InputEvents_PopSource(INPUT_SRC_BUTTON, &ev);
 }
 
 void Joystick_Reset(void) {
-    btn_pressed_flag = false;
+    InputEvent_t ev;
+    while (InputEvents_PopSource(INPUT_SRC_BUTTON, &ev)) {
+    }
     menu_action_consumed = false;
 }
+
+#if defined(PROFILER)
+bool Joystick_TakeInputStamp(uint32_t* stamp) {
+    if (!move_stamp_new) return false;
+    
+    move_stamp_new = false;
+    *stamp = move_stamp;
+    return true;
+}
+#endif
@@ -0,0 +1,166 @@
+/*
+ * joystick_kl25z.c
+ * Partea hardware a joystick-ului pe FRDM-KL25Z
+ * VRY pe PTB1 (ADC0_SE9), SW pe PTD4
+ *
+ * ADC0 converteste la fiecare overflow TPM0 (trigger hardware, medie
+ * hardware pe 8 esantioane); ISR-ul da rezultatul lui
+ * Joystick_PushSample. Procesarea e in joystick.c.
+ * In modul de consum redus TPM0 e oprit si conversiile se pornesc din
+ * software; ADC-ul merge pe ADACK, deci se termina si in VLPS.
+ * MOD-ul TPM0 urmeaza ceasul TPM (RUN 48 MHz, VLPR 4 MHz).
+ */
+
+#include "headers/joystick.h"
+#include "headers/run_mode.h"
+#include "headers/log.h"
+#include "MKL25Z4.h"
+#include "fsl_adc16.h"
+#include "fsl_gpio.h"
+#include "fsl_port.h"
+#include "fsl_clock.h"
+#include "fsl_debug_console.h"
+
+/*============================================================================
+ * SAMPLING
+ * TPM0 fara prescaler: un overflow (= o conversie) la 1 ms
+ *============================================================================*/
+
+#define JOYSTICK_TPM            TPM0
+#define JOYSTICK_TPM_BOOT_HZ    48000000U
+#define JOYSTICK_TPM_MOD(hz)    ((hz) / JOYSTICK_SAMPLE_HZ - 1U)
+
+/* SIM_SOPT7[ADC0TRGSEL]: 1000 = overflow TPM0 */
+#define JOYSTICK_ADC_TRGSEL     8U
+
+/* Canalul axei Y; scrierea lui in SC1[0] porneste o conversie */
+static const adc16_channel_config_t vry_channel = {
+    .channelNumber = JOYSTICK_VRY_CHANNEL,
+    .enableInterruptOnConversionCompleted = true,
+    .enableDifferentialConversion = false
+};
+
+/*============================================================================
+ * INTERRUPT HANDLER - Buton joystick
+ *============================================================================*/
+
+void PORTD_IRQHandler(void) {
+    uint32_t isfr = PORT_GetPinsInterruptFlags(JOYSTICK_SW_PORT);
+
+    if (isfr & (1U << JOYSTICK_SW_PIN)) {
+        PORT_ClearPinsInterruptFlags(JOYSTICK_SW_PORT, 1U << JOYSTICK_SW_PIN);
+        Joystick_PushButton(GPIO_ReadPinInput(JOYSTICK_SW_GPIO, JOYSTICK_SW_PIN) == 0U);
+    }
+}
+
+/*============================================================================
+ * INTERRUPT HANDLER - Conversie ADC completa
+ *============================================================================*/
+
+void ADC0_IRQHandler(void) {
+    /* Citirea rezultatului sterge COCO */
+    Joystick_PushSample((uint16_t)ADC16_GetChannelConversionValue(ADC0, 0));
+}
+
+/*============================================================================
+ * PRIVATE FUNCTIONS
+ *============================================================================*/
+
+/* TPM0 ruleaza liber si da ritmul conversiilor (fara intreruperi) */
+static void Joystick_StartSampling(void) {
+    CLOCK_SetTpmClock(1U);
+
+    JOYSTICK_TPM->SC = 0;
+    JOYSTICK_TPM->CNT = 0;
+    JOYSTICK_TPM->MOD = JOYSTICK_TPM_MOD(JOYSTICK_TPM_BOOT_HZ);
+
+    /* ADC0 trigger A <- overflow TPM0 */
+    SIM->SOPT7 = SIM_SOPT7_ADC0ALTTRGEN_MASK | SIM_SOPT7_ADC0TRGSEL(JOYSTICK_ADC_TRGSEL);
+
+    JOYSTICK_TPM->SC = TPM_SC_PS(0) | TPM_SC_CMOD(1);
+}
+
+/* Perioada ramane 1 ms si dupa o schimbare RUN/VLPR. MOD e scris cu
+ * timerul oprit (altfel intra in vigoare abia la urmatorul overflow). */
+static void Joystick_OnRunMode(const RunModeClocks_t* clocks) {
+    uint32_t sc = JOYSTICK_TPM->SC;
+
+    JOYSTICK_TPM->SC = 0;
+    JOYSTICK_TPM->CNT = 0;
+    JOYSTICK_TPM->MOD = JOYSTICK_TPM_MOD(clocks->tpm_hz);
+    JOYSTICK_TPM->SC = sc & (TPM_SC_PS_MASK | TPM_SC_CMOD_MASK);
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+void Joystick_HwSetContinuous(bool continuous) {
+    if (continuous) {
+        ADC16_EnableHardwareTrigger(ADC0, true);
+        JOYSTICK_TPM->CNT = 0;
+        JOYSTICK_TPM->SC = TPM_SC_PS(0) | TPM_SC_CMOD(1);
+    } else {
+        JOYSTICK_TPM->SC = 0;
+        ADC16_EnableHardwareTrigger(ADC0, false);
+    }
+}
+
+void Joystick_HwStartConversion(void) {
+    ADC16_SetChannelConfig(ADC0, 0, &vry_channel);
+}
+
+bool Joystick_HwIsConverting(void) {
+    return (ADC0->SC2 & ADC_SC2_ADACT_MASK) != 0U;
+}
+
+void Joystick_HwInit(void) {
+    adc16_config_t adcConfig;
+
+    /* Enable clocks */
+    CLOCK_EnableClock(kCLOCK_Adc0);
+    CLOCK_EnableClock(kCLOCK_PortB);  /* Pentru pinii analogici */
+    CLOCK_EnableClock(kCLOCK_PortD);  /* Pentru buton */
+
+    /* Configure ADC */
+    ADC16_GetDefaultConfig(&adcConfig);
+    adcConfig.resolution = kADC16_ResolutionSE12Bit;
+    ADC16_Init(ADC0, &adcConfig);
+    ADC16_DoAutoCalibration(ADC0);
+
+    /* Medie hardware pe 8 conversii, pornite de triggerul hardware. Pe
+     * ADACK / 8 (0.3 - 0.76 MHz) una dureaza 5 + 8 * 20 ADCK = 0.2 - 0.55 ms,
+     * deci incape in perioada TPM0; cu 32 ar dura 0.85 - 2.15 ms si o parte
+     * din triggere ar gasi ADC-ul ocupat. Restul zgomotului il ia filtrul
+     * din joystick.c. */
+    ADC16_SetHardwareAverage(ADC0, kADC16_HardwareAverageCount8);
+    ADC16_EnableHardwareTrigger(ADC0, true);
+
+    ADC16_SetChannelConfig(ADC0, 0, &vry_channel);
+
+    NVIC_SetPriority(ADC0_IRQn, 3);
+    EnableIRQ(ADC0_IRQn);
+
+    Joystick_StartSampling();
+    RunMode_AddListener(Joystick_OnRunMode);
+
+    /* Configure button pin PTD4 */
+    PORT_SetPinMux(JOYSTICK_SW_PORT, JOYSTICK_SW_PIN, kPORT_MuxAsGpio);
+    /* Pull-up; filtrul pasiv taie doar glitch-urile scurte, sariturile
+     * contactului le ignora Joystick_PushButton */
+    JOYSTICK_SW_PORT->PCR[JOYSTICK_SW_PIN] |= PORT_PCR_PE_MASK | PORT_PCR_PS_MASK | PORT_PCR_PFE_MASK;
+
+    gpio_pin_config_t sw_config = {kGPIO_DigitalInput, 0};
+    GPIO_PinInit(JOYSTICK_SW_GPIO, JOYSTICK_SW_PIN, &sw_config);
+
+    /* Intrerupere pe ambele fronturi (apasat = GND): si sariturile de la
+     * eliberare trebuie vazute de debounce */
+    PORT_SetPinInterruptConfig(JOYSTICK_SW_PORT, JOYSTICK_SW_PIN,
+                               kPORT_InterruptEitherEdge);
+
+    NVIC_SetPriority(JOYSTICK_SW_IRQ, 3);
+    EnableIRQ(JOYSTICK_SW_IRQ);
+
+    LOG_BOOT("[Joystick] Initialized (VRY=PTB1, SW=PTD4, ADC @ %u Hz)\r\n",
+             (unsigned int)JOYSTICK_SAMPLE_HZ);
+}
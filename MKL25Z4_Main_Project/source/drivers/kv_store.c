@@ -0,0 +1,313 @@
+/*
+ * kv_store.c
+ * Jurnalul de inregistrari din kv_store.h - partea independenta de hardware
+ *
+ * Layout-ul unui sector (cuvinte de 32 de biti, little endian):
+ *   [0] seq      generatia; scris dupa inregistrarile compactarii
+ *   [1] magic    KV_MAGIC; scris ultimul - sectorul devine valid
+ *   [2...]       inregistrari: cuvant de antet, apoi datele completate
+ *                cu 0xFF pana la multiplu de 4
+ * Antetul unei inregistrari: cheie | lungime << 8 | CRC16 << 16, cu CRC-ul
+ * calculat peste cheie, lungime si date. Cheia < KV_MAX_KEYS, deci un antet
+ * valid nu poate fi 0xFFFFFFFF (flash sters = sfarsitul jurnalului).
+ */
+
+#include "headers/kv_store.h"
+#include <string.h>
+
+/*============================================================================
+ * LAYOUT
+ *============================================================================*/
+
+#define KV_MAGIC            0x50564B31U         /* "1KVP" */
+#define KV_ERASED           0xFFFFFFFFU
+#define KV_HEADER_BYTES     8U
+#define KV_NO_SECTOR        0xFFU
+
+#define KV_PAD(len)         (((uint32_t)(len) + 3U) & ~3U)
+#define KV_RECORD_BYTES(len) (4U + KV_PAD(len))
+#define KV_VALUE_WORDS      (KV_VALUE_MAX / 4U)
+
+/* Toate cheile la lungime maxima trebuie sa incapa intr-un sector gol,
+ * altfel o compactare n-ar mai avea unde sa le scrie */
+typedef char kv_snapshot_fits[(KV_HEADER_BYTES + KV_MAX_KEYS * KV_RECORD_BYTES(KV_VALUE_MAX)
+                               <= KV_SECTOR_SIZE) ? 1 : -1];
+typedef char kv_layout_ok[(KV_SECTORS >= 2U && KV_MAX_KEYS <= 16U && (KV_VALUE_MAX % 4U) == 0) ? 1 : -1];
+
+/*============================================================================
+ * GLOBAL VARIABLES
+ *============================================================================*/
+
+/* Indexul: unde e ultima inregistrare a fiecarei chei (0 = lipsa; offset-ul
+ * 0 e mereu un header de sector, nu o inregistrare) */
+typedef struct {
+    uint16_t offset;
+    uint8_t len;
+} KvIndex_t;
+
+static KvIndex_t index_table[KV_MAX_KEYS];
+
+static uint8_t active = KV_NO_SECTOR;
+static uint16_t write_pos;                  /* In sectorul activ */
+
+/* Valorile care asteapta KvStore_Flush */
+static uint16_t pending_mask;
+static uint8_t pending_len[KV_MAX_KEYS];
+static uint32_t pending_data[KV_MAX_KEYS][KV_VALUE_WORDS];
+
+static KvStoreStats_t stats;
+
+/*============================================================================
+ * PRIVATE FUNCTIONS
+ *============================================================================*/
+
+/* CRC16-CCITT (0x1021, init 0xFFFF), bit cu bit: ruleaza doar la citirea
+ * de la pornire si la scriere, pe cel mult KV_VALUE_MAX + 2 octeti */
+static uint16_t KvStore_Crc16(uint16_t crc, const uint8_t* data, uint32_t len) {
+    while (len--) {
+        crc ^= (uint16_t)(*data++ << 8);
+        for (uint8_t bit = 0; bit < 8U; bit++) {
+            crc = (crc & 0x8000U) ? (uint16_t)((crc << 1) ^ 0x1021U) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static uint32_t KvStore_RecordHeader(uint8_t key, uint8_t len, const void* data) {
+    uint8_t head[2] = { key, len };
+    uint16_t crc = KvStore_Crc16(0xFFFFU, head, 2U);
+
+    crc = KvStore_Crc16(crc, data, len);
+    return (uint32_t)key | ((uint32_t)len << 8) | ((uint32_t)crc << 16);
+}
+
+static uint32_t KvStore_SectorBase(uint8_t sector) {
+    return (uint32_t)sector * KV_SECTOR_SIZE;
+}
+
+/* Sectorul a fost scris de o compactare terminata */
+static bool KvStore_ReadSectorSeq(uint8_t sector, uint32_t* seq) {
+    uint32_t header[2];
+
+    KvStore_HwRead(KvStore_SectorBase(sector), header, sizeof(header));
+    *seq = header[0];
+    return header[1] == KV_MAGIC && header[0] != KV_ERASED;
+}
+
+/* Trecerea prin sectorul activ: indexul si pozitia de scriere */
+static void KvStore_Scan(void) {
+    uint32_t base = KvStore_SectorBase(active);
+    uint32_t pos = KV_HEADER_BYTES;
+    uint32_t data[KV_VALUE_WORDS];
+
+    while (pos + 4U <= KV_SECTOR_SIZE) {
+        uint32_t header;
+        KvStore_HwRead(base + pos, &header, 4U);
+        if (header == KV_ERASED) break;
+
+        uint8_t key = (uint8_t)header;
+        uint8_t len = (uint8_t)(header >> 8);
+        bool ok = key < KV_MAX_KEYS && len != 0 && len <= KV_VALUE_MAX &&
+                  pos + KV_RECORD_BYTES(len) <= KV_SECTOR_SIZE;
+        if (ok) {
+            KvStore_HwRead(base + pos + 4U, data, KV_PAD(len));
+            ok = KvStore_RecordHeader(key, len, data) == header;
+        }
+        if (!ok) {
+            /* Scriere intrerupta: restul sectorului nu mai e sigur de scris */
+            stats.crc_errors++;
+            pos = KV_SECTOR_SIZE;
+            break;
+        }
+
+        index_table[key].offset = (uint16_t)(base + pos);
+        index_table[key].len = len;
+        pos += KV_RECORD_BYTES(len);
+    }
+    write_pos = (uint16_t)pos;
+}
+
+/* Inregistrarea unei valori in asteptare, gata de programat */
+static uint32_t KvStore_BuildPending(uint8_t key, uint32_t* record) {
+    uint8_t len = pending_len[key];
+
+    record[0] = KvStore_RecordHeader(key, len, pending_data[key]);
+    memcpy(&record[1], pending_data[key], KV_PAD(len));
+    return KV_RECORD_BYTES(len);
+}
+
+static void KvStore_FlashError(void) {
+    stats.flash_errors++;
+    write_pos = KV_SECTOR_SIZE;         /* Nimic peste cuvinte scrise pe jumatate */
+}
+
+/* Sectorul urmator primeste valoarea curenta a fiecarei chei: din RAM daca
+ * asteapta scrierea, altfel inregistrarea veche copiata cu CRC cu tot */
+static bool KvStore_Compact(void) {
+    uint8_t target = (active == KV_NO_SECTOR) ? 0U : (uint8_t)((active + 1U) % KV_SECTORS);
+    uint32_t base = KvStore_SectorBase(target);
+    uint32_t pos = KV_HEADER_BYTES;
+    uint32_t record[1U + KV_VALUE_WORDS];
+    KvIndex_t next[KV_MAX_KEYS];
+
+    if (!KvStore_HwErase(target)) {
+        KvStore_FlashError();
+        return false;
+    }
+    stats.compactions++;
+
+    for (uint8_t key = 0; key < KV_MAX_KEYS; key++) {
+        uint32_t bytes;
+
+        if (pending_mask & (1U << key)) {
+            bytes = KvStore_BuildPending(key, record);
+            next[key].len = pending_len[key];
+        } else if (index_table[key].len != 0) {
+            bytes = KV_RECORD_BYTES(index_table[key].len);
+            KvStore_HwRead(index_table[key].offset, record, bytes);
+            next[key].len = index_table[key].len;
+        } else {
+            next[key].offset = 0;
+            next[key].len = 0;
+            continue;
+        }
+
+        if (!KvStore_HwProgram(base + pos, record, bytes)) {
+            KvStore_FlashError();
+            return false;
+        }
+        next[key].offset = (uint16_t)(base + pos);
+        pos += bytes;
+    }
+
+    /* Commit: seq, apoi magic. Pana aici sectorul vechi ramane cel valid. */
+    uint32_t seq = stats.seq + 1U;
+    uint32_t magic = KV_MAGIC;
+    if (!KvStore_HwProgram(base, &seq, 4U) || !KvStore_HwProgram(base + 4U, &magic, 4U)) {
+        KvStore_FlashError();
+        return false;
+    }
+
+    memcpy(index_table, next, sizeof(index_table));
+    active = target;
+    write_pos = (uint16_t)pos;
+    stats.seq = seq;
+    stats.records += __builtin_popcount(pending_mask);
+    pending_mask = 0;
+    return true;
+}
+
+/* Valorile in asteptare dupa ultima inregistrare, sau compactare daca nu mai incap */
+static bool KvStore_Append(void) {
+    uint32_t record[1U + KV_VALUE_WORDS];
+
+    if (active == KV_NO_SECTOR) return KvStore_Compact();
+
+    uint32_t base = KvStore_SectorBase(active);
+    for (uint8_t key = 0; key < KV_MAX_KEYS; key++) {
+        if (!(pending_mask & (1U << key))) continue;
+
+        /* Sectorul plin: compactarea scrie si restul valorilor in asteptare */
+        if (write_pos + KV_RECORD_BYTES(pending_len[key]) > KV_SECTOR_SIZE) {
+            return KvStore_Compact();
+        }
+
+        uint32_t bytes = KvStore_BuildPending(key, record);
+        if (!KvStore_HwProgram(base + write_pos, record, bytes)) {
+            KvStore_FlashError();
+            return false;
+        }
+        index_table[key].offset = (uint16_t)(base + write_pos);
+        index_table[key].len = pending_len[key];
+        write_pos = (uint16_t)(write_pos + bytes);
+        pending_mask &= (uint16_t)~(1U << key);
+        stats.records++;
+    }
+    return true;
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+bool KvStore_Init(void) {
+    uint32_t best_seq = 0;
+
+    KvStore_HwInit();
+
+    memset(index_table, 0, sizeof(index_table));
+    memset(&stats, 0, sizeof(stats));
+    pending_mask = 0;
+    active = KV_NO_SECTOR;
+    write_pos = KV_SECTOR_SIZE;
+
+    for (uint8_t s = 0; s < KV_SECTORS; s++) {
+        uint32_t seq;
+        if (KvStore_ReadSectorSeq(s, &seq) && (active == KV_NO_SECTOR || seq > best_seq)) {
+            active = s;
+            best_seq = seq;
+        }
+    }
+    if (active == KV_NO_SECTOR) return false;
+
+    stats.seq = best_seq;
+    KvStore_Scan();
+    return true;
+}
+
+uint8_t KvStore_Get(uint8_t key, void* dst, uint8_t size) {
+    if (key >= KV_MAX_KEYS) return 0;
+
+    if (pending_mask & (1U << key)) {
+        uint8_t len = pending_len[key];
+        memcpy(dst, pending_data[key], (len < size) ? len : size);
+        return len;
+    }
+
+    uint8_t len = index_table[key].len;
+    if (len != 0) {
+        KvStore_HwRead(index_table[key].offset + 4U, dst, (len < size) ? len : size);
+    }
+    return len;
+}
+
+bool KvStore_Set(uint8_t key, const void* src, uint8_t len) {
+    uint32_t stored[KV_VALUE_WORDS];
+
+    if (key >= KV_MAX_KEYS || len == 0 || len > KV_VALUE_MAX) return false;
+
+    /* Aceeasi valoare ca in flash: nimic de scris (si anuleaza o schimbare
+     * in asteptare, ex: o setare schimbata si pusa la loc) */
+    if (index_table[key].len == len) {
+        KvStore_HwRead(index_table[key].offset + 4U, stored, len);
+        if (memcmp(stored, src, len) == 0) {
+            pending_mask &= (uint16_t)~(1U << key);
+            return true;
+        }
+    }
+
+    memset(pending_data[key], 0xFF, sizeof(pending_data[key]));
+    memcpy(pending_data[key], src, len);
+    pending_len[key] = len;
+    pending_mask |= (uint16_t)(1U << key);
+    return true;
+}
+
+bool KvStore_IsDirty(void) {
+    return pending_mask != 0;
+}
+
+bool KvStore_Flush(void) {
+    if (pending_mask == 0) return true;
+
+    KvStore_HwBegin();
+    bool ok = KvStore_Append();
+    KvStore_HwEnd();
+    return ok;
+}
+
+void KvStore_GetStats(KvStoreStats_t* out) {
+    *out = stats;
+    out->sector = active;
+    out->used = (active == KV_NO_SECTOR) ? 0 : write_pos;
+}
@@ -0,0 +1,126 @@
+/*
+ * kv_store_kl25z.c
+ * Partea hardware a kv_store.h pe FRDM-KL25Z: FTFA prin drivers/fsl_flash
+ *
+ * Zona ocupa ultimii KV_SIZE octeti din cei 128 KB de flash (0x1F000 -
+ * 0x1FFFF); memoria PROGRAM_FLASH din proiect (.cproject) se opreste la
+ * 0x1F000, ca linker-ul sa nu puna cod acolo. Citirea e directa, flash-ul
+ * e mapat in spatiul de adrese.
+ *
+ * Cat ruleaza o comanda FTFA flash-ul nu poate fi citit, iar codul si
+ * vectorii sunt in acelasi bloc: intreruperile sunt oprite pe durata
+ * fiecarei comenzi (o stergere de sector ~14 ms, un cuvant ~65 us). SysTick
+ * pastreaza un singur tic in asteptare, asa ca stergerea e cronometrata pe
+ * LPTMR0 (LPO 1 kHz, merge si cu intreruperile oprite) si ticurile pierdute
+ * sunt adaugate in g_systick_ms. FTFA nu accepta comenzi in VLPR: portul
+ * trece in RUN o data pe KvStore_Flush (KvStore_HwBegin/End), nu la
+ * fiecare comanda.
+ */
+
+#include "headers/kv_store.h"
+#include "headers/run_mode.h"
+#include "headers/log.h"
+#include "headers/game_config.h"
+#include "MKL25Z4.h"
+#include "fsl_flash.h"
+#include "fsl_debug_console.h"
+#include <string.h>
+
+/*============================================================================
+ * HARDWARE CONFIGURATION
+ *============================================================================*/
+
+#define KV_FLASH_BASE       0x0001F000U     /* 128 KB - KV_SIZE */
+
+/* LPTMR0 liber (TFC) pe LPO 1 kHz, prescaler ocolit: 1 tick = 1 ms, ca in power.c */
+#define KV_LPTMR_PSR        (LPTMR_PSR_PCS(1) | LPTMR_PSR_PBYP_MASK)
+
+/*============================================================================
+ * GLOBAL VARIABLES
+ *============================================================================*/
+
+static flash_config_t flash;
+static RunMode_t saved_mode;            /* Modul de dinaintea KvStore_HwBegin */
+
+/*============================================================================
+ * PRIVATE FUNCTIONS
+ *============================================================================*/
+
+/* LPTMR0 e liber in afara Power_Sleep, iar KvStore_Flush nu ruleaza din ISR */
+static void KvStore_StartStopwatch(void) {
+    LPTMR0->CSR = 0;
+    LPTMR0->PSR = KV_LPTMR_PSR;
+    LPTMR0->CSR = LPTMR_CSR_TFC_MASK | LPTMR_CSR_TEN_MASK;
+}
+
+/* Milisecunde de la pornire (o scriere in CNR il ingheata pentru citire) */
+static uint32_t KvStore_StopStopwatch(void) {
+    LPTMR0->CNR = 0;
+    uint32_t ms = LPTMR0->CNR & LPTMR_CNR_COUNTER_MASK;
+    LPTMR0->CSR = 0;
+    return ms;
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+void KvStore_HwInit(void) {
+    status_t status = FLASH_Init(&flash);
+
+    CLOCK_EnableClock(kCLOCK_Lptmr0);
+
+    /* Fara %s: un token per varianta */
+    if (status == kStatus_FLASH_Success) {
+        LOG_BOOT("[KvStore] FTFA ready, %u sectors of %u bytes at 0x%05X\r\n",
+                 KV_SECTORS, KV_SECTOR_SIZE, KV_FLASH_BASE);
+    } else {
+        LOG_BOOT("[KvStore] FTFA init failed (%d), %u sectors of %u bytes at 0x%05X\r\n",
+                 (int)status, KV_SECTORS, KV_SECTOR_SIZE, KV_FLASH_BASE);
+    }
+}
+
+void KvStore_HwRead(uint32_t offset, void* dst, uint32_t len) {
+    memcpy(dst, (const void*)(KV_FLASH_BASE + offset), len);
+}
+
+void KvStore_HwBegin(void) {
+    saved_mode = RunMode_Get();
+
+    if (saved_mode != RUN_MODE_RUN) {
+        RunMode_Set(RUN_MODE_RUN);
+    }
+}
+
+void KvStore_HwEnd(void) {
+    if (saved_mode != RUN_MODE_RUN) {
+        RunMode_Set(saved_mode);
+    }
+}
+
+bool KvStore_HwErase(uint8_t sector) {
+    KvStore_StartStopwatch();
+
+    uint32_t primask = DisableGlobalIRQ();
+    status_t status = FLASH_Erase(&flash, KV_FLASH_BASE + (uint32_t)sector * KV_SECTOR_SIZE,
+                                  KV_SECTOR_SIZE, kFLASH_ApiEraseKey);
+    uint32_t ms = KvStore_StopStopwatch();
+
+    /* Din cele ms ticuri, doar unul ramane in asteptare si ruleaza la
+     * EnableGlobalIRQ; restul se adauga aici (eroare sub 1 ms per stergere) */
+    if (ms > 1U) {
+        g_systick_ms += ms - 1U;
+    }
+    EnableGlobalIRQ(primask);
+
+    return status == kStatus_FLASH_Success;
+}
+
+/* Un cuvant ~65 us: cel mult un tic SysTick, care ramane in asteptare */
+bool KvStore_HwProgram(uint32_t offset, const uint32_t* src, uint32_t len) {
+    uint32_t primask = DisableGlobalIRQ();
+    status_t status = FLASH_Program(&flash, KV_FLASH_BASE + offset, (uint32_t*)src, len);
+    EnableGlobalIRQ(primask);
+
+    return status == kStatus_FLASH_Success;
+}
@@ -0,0 +1,305 @@
+/*
+ * log.c
+ * Ringul de inregistrari din log.h si formatarea lor la golire
+ *
+ * Producatorii (LOG din task-uri sau ISR-uri) scriu sub Log_HwLock, deci
+ * pot fi oricati. Consumatorul e unul singur (ISR-ul UART al portului):
+ * citeste fara lock, ca in input_events.c.
+ *
+ * Cu LOG_TOKENIZED consumatorul nu mai formateaza: "linia" e cadrul binar
+ * al inregistrarii (Log_Encode), iar formatter-ul nu se compileaza.
+ */
+
+#include "headers/log.h"
+#include "MKL25Z4.h"
+#include <stdarg.h>
+#include <string.h>
+
+/*============================================================================
+ * RING
+ *============================================================================*/
+
+#define LOG_RING_MASK   (LOG_RING_SIZE - 1U)
+
+typedef char log_ring_pow2[((LOG_RING_SIZE & LOG_RING_MASK) == 0 && LOG_RING_SIZE <= 128U) ? 1 : -1];
+
+typedef struct {
+    const char* fmt;
+    uint32_t args[LOG_MAX_ARGS];
+    uint8_t nargs;
+} LogRecord_t;
+
+static LogRecord_t ring[LOG_RING_SIZE];
+static volatile uint8_t head;           /* Scris doar sub lock, de producatori */
+static volatile uint8_t tail;           /* Scris doar de consumator */
+
+/* Pierderile: numarul si pozitia (head-ul la ultima pierdere), ca linia
+ * de raport sa iasa dupa inregistrarile care erau deja in ring */
+static volatile uint32_t dropped;
+static volatile uint8_t drop_mark;
+static uint32_t dropped_reported;
+
+/* Linia in curs de trimitere (doar consumatorul) */
+static char line[LOG_LINE_MAX];
+static uint8_t line_len;
+static uint8_t line_pos;
+
+static LogStats_t stats;
+
+/* Raportul de pierderi e si el un token */
+LOG_TOKEN(drop_fmt, "[LOG] %u dropped\r\n");
+
+#if defined(LOG_TOKENIZED)
+/*============================================================================
+ * ENCODER
+ *============================================================================*/
+
+static uint8_t Log_PutVarint(uint8_t* out, uint32_t value) {
+    uint8_t n = 0;
+    while (value >= 0x80U) {
+        out[n++] = (uint8_t)(value | 0x80U);
+        value >>= 7;
+    }
+    out[n++] = (uint8_t)value;
+    return n;
+}
+
+/* Tokenul e adresa formatului in log_fmt (sectiunea incepe de la 0) */
+static uint8_t Log_Encode(uint8_t* out, const char* fmt, const uint32_t* args, uint8_t nargs) {
+    uint8_t n = 0;
+
+    out[n++] = (uint8_t)(LOG_FRAME_START + nargs);
+    n += Log_PutVarint(out + n, (uint32_t)(uintptr_t)fmt);
+    for (uint8_t i = 0; i < nargs; i++) {
+        n += Log_PutVarint(out + n, args[i]);
+    }
+    return n;
+}
+
+typedef char log_frame_fits[(LOG_FRAME_MAX <= LOG_LINE_MAX) ? 1 : -1];
+
+/* Log_FormatNext pune in line cadrul, nu textul */
+#define Log_Format(out, fmt, args, nargs)   Log_Encode((uint8_t*)(out), fmt, args, nargs)
+
+#else
+/*============================================================================
+ * FORMATTER
+ *============================================================================*/
+
+typedef struct {
+    char* out;
+    uint8_t len;
+} LogLine_t;
+
+static void Log_PutChar(LogLine_t* l, char c) {
+    if (l->len < LOG_LINE_MAX) {
+        l->out[l->len++] = c;
+    }
+}
+
+/* Un intreg cu latime, aliniere si umplere, ca printf */
+static void Log_PutNumber(LogLine_t* l, uint32_t value, uint8_t base, bool upper, bool negative,
+                          uint8_t width, bool left, bool zero) {
+    const char* digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    char buf[11];
+    uint8_t n = 0;
+
+    do {
+        buf[n++] = digits[value % base];
+        value /= base;
+    } while (value != 0);
+
+    uint8_t size = (uint8_t)(n + (negative ? 1U : 0U));
+    uint8_t pad = (width > size) ? (uint8_t)(width - size) : 0U;
+
+    if (!left && !zero) {
+        while (pad) { Log_PutChar(l, ' '); pad--; }
+    }
+    if (negative) Log_PutChar(l, '-');
+    if (!left && zero) {
+        while (pad) { Log_PutChar(l, '0'); pad--; }
+    }
+    while (n) Log_PutChar(l, buf[--n]);
+    while (pad) { Log_PutChar(l, ' '); pad--; }
+}
+
+/* Argumentele lipsa (format cu mai multe conversii decat LOG) sunt 0 */
+static uint8_t Log_Format(char* out, const char* fmt, const uint32_t* args, uint8_t nargs) {
+    LogLine_t l = { out, 0 };
+    uint8_t next = 0;
+
+    while (*fmt) {
+        char c = *fmt++;
+        if (c != '%') {
+            Log_PutChar(&l, c);
+            continue;
+        }
+
+        bool left = false, zero = false;
+        uint8_t width = 0;
+        for (;; fmt++) {
+            if (*fmt == '-') left = true;
+            else if (*fmt == '0') zero = true;
+            else break;
+        }
+        while (*fmt >= '0' && *fmt <= '9') {
+            width = (uint8_t)(width * 10U + (uint8_t)(*fmt++ - '0'));
+        }
+
+        char conv = *fmt;
+        if (conv == '\0') break;
+        fmt++;
+        if (conv == '%') {
+            Log_PutChar(&l, '%');
+            continue;
+        }
+
+        uint32_t arg = (next < nargs) ? args[next] : 0U;
+        next++;
+        switch (conv) {
+            case 'd':
+            case 'i':
+                if ((int32_t)arg < 0) {
+                    Log_PutNumber(&l, 0U - arg, 10, false, true, width, left, zero);
+                } else {
+                    Log_PutNumber(&l, arg, 10, false, false, width, left, zero);
+                }
+                break;
+            case 'u': Log_PutNumber(&l, arg, 10, false, false, width, left, zero); break;
+            case 'x': Log_PutNumber(&l, arg, 16, false, false, width, left, zero); break;
+            case 'X': Log_PutNumber(&l, arg, 16, true, false, width, left, zero); break;
+            case 'c': Log_PutChar(&l, (char)arg); break;
+            default:
+                /* Conversie nesuportata: apare ca atare */
+                Log_PutChar(&l, '%');
+                Log_PutChar(&l, conv);
+                break;
+        }
+    }
+    return l.len;
+}
+#endif
+
+/*============================================================================
+ * PRIVATE FUNCTIONS
+ *============================================================================*/
+
+/* Urmatoarea linie din ring (sau raportul de pierderi); false = ring gol */
+static bool Log_FormatNext(void) {
+    uint8_t t = tail;
+    uint32_t lost = dropped - dropped_reported;
+
+    if (lost != 0 && t == drop_mark) {
+        uint32_t arg = lost;
+        dropped_reported += lost;
+        line_len = Log_Format(line, drop_fmt, &arg, 1U);
+    } else if (t != head) {
+        const LogRecord_t* r = &ring[t & LOG_RING_MASK];
+        line_len = Log_Format(line, r->fmt, r->args, r->nargs);
+        __DMB();    /* Inregistrarea e citita inainte ca slotul sa fie eliberat */
+        tail = (uint8_t)(t + 1U);
+    } else {
+        return false;
+    }
+
+    line_pos = 0;
+    stats.lines++;
+    return true;
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+void Log_Init(void) {
+    head = 0;
+    tail = 0;
+    dropped = 0;
+    dropped_reported = 0;
+    drop_mark = 0;
+    line_len = 0;
+    line_pos = 0;
+    memset(&stats, 0, sizeof(stats));
+
+    Log_HwInit();
+}
+
+void Log_Write(const char* fmt, uint8_t nargs, ...) {
+    uint32_t args[LOG_MAX_ARGS];
+    va_list ap;
+
+    va_start(ap, nargs);
+    for (uint8_t i = 0; i < nargs && i < LOG_MAX_ARGS; i++) {
+        args[i] = va_arg(ap, uint32_t);
+    }
+    va_end(ap);
+
+    uint32_t key = Log_HwLock();
+    uint8_t h = head;
+    uint8_t used = (uint8_t)(h - tail);
+
+    if (used >= LOG_RING_SIZE) {
+        dropped++;
+        drop_mark = h;
+        stats.dropped++;
+        Log_HwUnlock(key);
+        return;
+    }
+
+    LogRecord_t* r = &ring[h & LOG_RING_MASK];
+    r->fmt = fmt;
+    r->nargs = (nargs < LOG_MAX_ARGS) ? nargs : (uint8_t)LOG_MAX_ARGS;
+    for (uint8_t i = 0; i < r->nargs; i++) {
+        r->args[i] = args[i];
+    }
+
+    __DMB();    /* Inregistrarea e scrisa inainte sa devina vizibila */
+    head = (uint8_t)(h + 1U);
+
+    stats.written++;
+    if (used + 1U > stats.max_used) stats.max_used = used + 1U;
+    Log_HwKick();
+    Log_HwUnlock(key);
+}
+
+#if defined(LOG_TOKENIZED)
+void Log_WriteBlocking(const char* fmt, uint8_t nargs, ...) {
+    uint32_t args[LOG_MAX_ARGS];
+    uint8_t frame[LOG_FRAME_MAX];
+    va_list ap;
+
+    if (nargs > LOG_MAX_ARGS) nargs = (uint8_t)LOG_MAX_ARGS;
+    va_start(ap, nargs);
+    for (uint8_t i = 0; i < nargs; i++) {
+        args[i] = va_arg(ap, uint32_t);
+    }
+    va_end(ap);
+
+    /* Ce era deja in ring iese inainte, ca ordinea sa ramana cea din cod */
+    while (!Log_IsIdle()) {
+        __NOP();
+    }
+    uint8_t len = Log_Encode(frame, fmt, args, nargs);
+    Log_HwWriteBlocking(frame, len);
+    stats.lines++;
+    stats.bytes += len;
+}
+#endif
+
+bool Log_IsIdle(void) {
+    return line_pos == line_len && tail == head && dropped == dropped_reported;
+}
+
+void Log_GetStats(LogStats_t* out) {
+    *out = stats;
+}
+
+int16_t Log_NextByte(void) {
+    /* O linie poate iesi goala (ex: LOG("")) */
+    while (line_pos == line_len) {
+        if (!Log_FormatNext()) return -1;
+    }
+
+    stats.bytes++;
+    return (int16_t)(uint8_t)line[line_pos++];
+}
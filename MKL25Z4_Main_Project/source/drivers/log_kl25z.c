@@ -0,0 +1,125 @@
+/*
+ * log_kl25z.c
+ * Golirea ringului din log.h pe UART0 (LPSCI), consola placii
+ *
+ * Consola e configurata de BOARD_InitDebugConsole (115200 8N1); aici doar
+ * intreruperea TX-empty: cat timp ringul are date TIE e pornit, iar ISR-ul
+ * scrie urmatorul octet la fiecare TDRE. UART0 are un buffer de un octet
+ * in fata shifter-ului, deci o intrerupere la ~87 us.
+ *
+ * In VLPS ceasul UART0 (PLL sau MCGIRCLK) se opreste: fiecare intrerupere
+ * tine CPU-ul treaz inca LOG_AWAKE_MS (Power_StayAwake), pana la ultimul
+ * octet. O schimbare RUN/VLPR reinitializeaza consola (LPSCI_Init rescrie
+ * C2, deci TIE se pierde); listener-ul il porneste din nou daca mai sunt
+ * date. Intre timp (RunMode_IsSwitching) nici ISR-ul, nici Log_HwKick nu
+ * ating UART0, al carui ceas e oprit.
+ *
+ * Cu LOG_TOKENIZED, LOG_BOOT scrie cadrul direct (Log_HwWriteBlocking) cu
+ * TIE oprit; un LOG dintr-un ISR in acest timp asteapta in ring.
+ */
+
+#include "headers/log.h"
+#include "headers/power.h"
+#include "headers/run_mode.h"
+#include "MKL25Z4.h"
+#include "fsl_lpsci.h"
+#include "fsl_debug_console.h"
+
+/*============================================================================
+ * HARDWARE CONFIGURATION
+ *============================================================================*/
+
+#define LOG_UART            UART0
+
+/* Doua ms: octetul din shifter e trimis si daca SysTick e pe punctul sa
+ * incrementeze g_systick_ms */
+#define LOG_AWAKE_MS        2U
+
+/*============================================================================
+ * GLOBAL VARIABLES
+ *============================================================================*/
+
+static volatile bool hold;      /* Log_HwWriteBlocking in curs: fara TIE */
+
+/*============================================================================
+ * INTERRUPT HANDLER - TX data register empty
+ *============================================================================*/
+
+void UART0_IRQHandler(void) {
+    /* Cerere ramasa de dinainte de DbgConsole_Deinit: listener-ul reporneste TIE */
+    if (RunMode_IsSwitching()) return;
+
+    while (LPSCI_GetStatusFlags(LOG_UART) & kLPSCI_TxDataRegEmptyFlag) {
+        int16_t byte = Log_NextByte();
+        if (byte < 0) {
+            /* Ring gol: ultimul octet iese singur, TIE ar cere in continuu */
+            LPSCI_DisableInterrupts(LOG_UART, kLPSCI_TxDataRegEmptyInterruptEnable);
+            break;
+        }
+        LPSCI_WriteByte(LOG_UART, (uint8_t)byte);
+    }
+    Power_StayAwake(LOG_AWAKE_MS);
+}
+
+/*============================================================================
+ * PRIVATE FUNCTIONS
+ *============================================================================*/
+
+static void Log_OnRunMode(const RunModeClocks_t* clocks) {
+    if (!Log_IsIdle()) {
+        LPSCI_EnableInterrupts(LOG_UART, kLPSCI_TxDataRegEmptyInterruptEnable);
+    }
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+void Log_HwInit(void) {
+    LPSCI_DisableInterrupts(LOG_UART, kLPSCI_TxDataRegEmptyInterruptEnable);
+
+    /* Sub IR, ADC si note: un octet intarziat nu strica nimic */
+    NVIC_SetPriority(UART0_IRQn, 3);
+    EnableIRQ(UART0_IRQn);
+
+    RunMode_AddListener(Log_OnRunMode);
+
+    LOG_BOOT("[LOG] Initialized: %u records on UART0 TX interrupt\r\n", (unsigned int)LOG_RING_SIZE);
+}
+
+uint32_t Log_HwLock(void) {
+    return DisableGlobalIRQ();
+}
+
+void Log_HwUnlock(uint32_t key) {
+    EnableGlobalIRQ(key);
+}
+
+void Log_HwKick(void) {
+    /* Cat RunMode schimba ceasurile consola e oprita; listener-ul o porneste */
+    if (!hold && !RunMode_IsSwitching()) {
+        LPSCI_EnableInterrupts(LOG_UART, kLPSCI_TxDataRegEmptyInterruptEnable);
+    }
+}
+
+void Log_HwWriteBlocking(const uint8_t* data, uint8_t len) {
+    /* Fara consola (TE = 0) cadrul se pierde, ca PRINTF inainte de DbgConsole_Init */
+    if (!(LOG_UART->C2 & UART0_C2_TE_MASK)) return;
+
+    hold = true;
+    LPSCI_DisableInterrupts(LOG_UART, kLPSCI_TxDataRegEmptyInterruptEnable);
+
+    for (uint8_t i = 0; i < len; i++) {
+        while (!(LPSCI_GetStatusFlags(LOG_UART) & kLPSCI_TxDataRegEmptyFlag)) {
+            __NOP();
+        }
+        LPSCI_WriteByte(LOG_UART, data[i]);
+    }
+
+    uint32_t key = Log_HwLock();
+    hold = false;
+    if (!Log_IsIdle()) {
+        Log_HwKick();
+    }
+    Log_HwUnlock(key);
+}
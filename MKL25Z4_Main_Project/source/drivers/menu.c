@@ -8,12 +8,21 @@
 #include "headers/st7735_simple.h"
 #include "headers/joystick.h"
 #include "headers/ir_remote.h"
+#include "headers/input_events.h"
 #include "headers/pong_game.h"
-#include "fsl_debug_console.h"
+#include "headers/log.h"
+#include "MKL25Z4.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 
+#if defined(SDK_OS_FREE_RTOS)
+#include "FreeRTOS.h"
+#include "task.h"
+#elif defined(__ZEPHYR__)
+#include <zephyr/kernel.h>
+#endif
+
 /*============================================================================
  * EXTERNAL VARIABLES
  *============================================================================*/
@@ -60,10 +69,17 @@ static uint8_t g_pause_selection = 0;
  *============================================================================*/
 
 static void delay_ms(uint32_t ms) {
+#if defined(SDK_OS_FREE_RTOS)
+    /* Animatiile ruleaza in task-ul ui - celelalte task-uri merg intre timp */
+    vTaskDelay(pdMS_TO_TICKS(ms));
+#elif defined(__ZEPHYR__)
+    k_msleep(ms);
+#else
     uint32_t start = g_systick_ms;
     while ((g_systick_ms - start) < ms) {
-        __asm volatile("nop");
+        __NOP();
     }
+#endif
 }
 
 /*============================================================================
@@ -340,7 +356,8 @@ void Menu_PlayIntroAnimation(void) {
     uint32_t anim_start, last_blink = 0;
     uint8_t blink_state = 0;
     
-    Joystick_ButtonPressed();
+    /* Apasari ramase de la pornire */
+    InputEvents_Flush();
     
     /* BMO Animation */
     ST7735_FillScreen(BMO_SCREEN_COLOR);
@@ -448,6 +465,9 @@ void Menu_PlayIntroAnimation(void) {
     delay_ms(50);
     ST7735_FillScreen(COLOR_BLACK);
     delay_ms(80);
+    
+    /* Evenimentele din timpul intro-ului nu ajung in meniu */
+    InputEvents_Flush();
 }
 
 /*============================================================================
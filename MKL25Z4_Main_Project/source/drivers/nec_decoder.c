@@ -0,0 +1,106 @@
+/*
+ * nec_decoder.c
+ * Decodor NEC pe fronturi: un pas de masina de stare per puls
+ *
+ * Cadru:  mark 9 ms, space 4.5 ms, 32 x (mark 560 us + space 560/1690 us),
+ *         mark 560 us de stop
+ * Repeat: mark 9 ms, space 2.25 ms, mark 560 us
+ */
+
+#include "headers/nec_decoder.h"
+
+/*============================================================================
+ * PRIVATE FUNCTIONS
+ *============================================================================*/
+
+static bool InRange(uint32_t v, uint32_t min, uint32_t max) {
+    return v >= min && v <= max;
+}
+
+/* Cod valid: comanda urmata de inversul ei (octetii 2 si 3) */
+static bool CodeIsValid(uint32_t code) {
+    uint8_t cmd = (code >> 16) & 0xFF;
+    uint8_t cmd_inv = (code >> 24) & 0xFF;
+    return (cmd ^ cmd_inv) == 0xFF;
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+void NecDecoder_Reset(NecDecoder_t* d) {
+    d->state = NEC_STATE_WAIT_IDLE;
+    d->bits = 0;
+    d->shift = 0;
+}
+
+NecEvent_t NecDecoder_Feed(NecDecoder_t* d, uint32_t width_us) {
+    /* Linia a stat in repaus - urmatorul puls e inceputul unui cadru */
+    if (width_us >= NEC_IDLE_US) {
+        bool aborted = d->state != NEC_STATE_WAIT_IDLE && d->state != NEC_STATE_LEAD_MARK;
+        d->state = NEC_STATE_LEAD_MARK;
+        return aborted ? NEC_EVENT_ERROR : NEC_EVENT_NONE;
+    }
+
+    switch (d->state) {
+        case NEC_STATE_WAIT_IDLE:
+            /* Un mark de 9 ms nu poate fi altceva - resincronizare rapida */
+            if (InRange(width_us, NEC_LEAD_MARK_MIN, NEC_LEAD_MARK_MAX)) {
+                d->state = NEC_STATE_LEAD_SPACE;
+            }
+            return NEC_EVENT_NONE;
+
+        case NEC_STATE_LEAD_MARK:
+            if (!InRange(width_us, NEC_LEAD_MARK_MIN, NEC_LEAD_MARK_MAX)) break;
+            d->state = NEC_STATE_LEAD_SPACE;
+            return NEC_EVENT_NONE;
+
+        case NEC_STATE_LEAD_SPACE:
+            if (InRange(width_us, NEC_LEAD_SPACE_MIN, NEC_LEAD_SPACE_MAX)) {
+                d->bits = 0;
+                d->shift = 0;
+                d->state = NEC_STATE_BIT_MARK;
+                return NEC_EVENT_NONE;
+            }
+            if (InRange(width_us, NEC_RPT_SPACE_MIN, NEC_RPT_SPACE_MAX)) {
+                d->state = NEC_STATE_REPEAT_MARK;
+                return NEC_EVENT_NONE;
+            }
+            break;
+
+        case NEC_STATE_BIT_MARK:
+            if (!InRange(width_us, NEC_BIT_MARK_MIN, NEC_BIT_MARK_MAX)) break;
+            d->state = NEC_STATE_BIT_SPACE;
+            return NEC_EVENT_NONE;
+
+        case NEC_STATE_BIT_SPACE:
+            if (InRange(width_us, NEC_ONE_SPACE_MIN, NEC_ONE_SPACE_MAX)) {
+                d->shift |= 1UL << d->bits;
+            } else if (!InRange(width_us, NEC_ZERO_SPACE_MIN, NEC_ZERO_SPACE_MAX)) {
+                break;
+            }
+            d->bits++;
+            d->state = (d->bits == 32) ? NEC_STATE_STOP_MARK : NEC_STATE_BIT_MARK;
+            return NEC_EVENT_NONE;
+
+        case NEC_STATE_STOP_MARK:
+            if (!InRange(width_us, NEC_BIT_MARK_MIN, NEC_BIT_MARK_MAX)) break;
+            d->state = NEC_STATE_WAIT_IDLE;
+            if (!CodeIsValid(d->shift)) return NEC_EVENT_ERROR;
+            d->code = d->shift;
+            return NEC_EVENT_CODE;
+
+        case NEC_STATE_REPEAT_MARK:
+            if (!InRange(width_us, NEC_BIT_MARK_MIN, NEC_BIT_MARK_MAX)) break;
+            d->state = NEC_STATE_WAIT_IDLE;
+            return NEC_EVENT_REPEAT;
+
+        default:
+            break;
+    }
+
+    /* Puls in afara tolerantelor: abandonam cadrul */
+    d->state = (InRange(width_us, NEC_LEAD_MARK_MIN, NEC_LEAD_MARK_MAX)) ?
+               NEC_STATE_LEAD_SPACE : NEC_STATE_WAIT_IDLE;
+    return NEC_EVENT_ERROR;
+}
@@ -0,0 +1,186 @@
+/*
+ * physics.c
+ * Fizica Pong in Q8.8 cu detectie continua a coliziunilor
+ *
+ * Peretii sus/jos reflecta mingea in oglinda (fara clamp), iar paletele
+ * sunt testate pe segmentul parcurs in frame: daca muchia mingii traverseaza
+ * fata paletei, se calculeaza Y-ul in momentul contactului si restul
+ * drumului continua cu viteza reflectata.
+ *
+ * Pe Cortex-M0+ nu exista impartire hardware - impartirea din swept
+ * ruleaza doar in frame-ul in care mingea traverseaza fata unei palete.
+ */
+
+#include "headers/physics.h"
+#include <stddef.h>
+
+/*============================================================================
+ * HELPERS
+ *============================================================================*/
+
+#define BALL_SIZE_FIX       INT_TO_FIX(BALL_SIZE)
+#define PADDLE_HEIGHT_FIX   INT_TO_FIX(PADDLE_HEIGHT)
+
+uint32_t Physics_Random(Physics_State_t* s) {
+    uint32_t x = s->rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    s->rng = x;
+    return x;
+}
+
+fix_t Physics_FoldY(fix_t y, uint8_t* flips) {
+    uint8_t n = 0;
+
+    for (;;) {
+        if (y < PHYS_BALL_MIN_Y) {
+            y = 2 * PHYS_BALL_MIN_Y - y;
+        } else if (y > PHYS_BALL_MAX_Y) {
+            y = 2 * PHYS_BALL_MAX_Y - y;
+        } else {
+            break;
+        }
+        n++;
+    }
+
+    if (flips != NULL) *flips = n;
+    return y;
+}
+
+fix_t Physics_InterceptY(const PhysBall_t* b, fix_t target_x, uint16_t max_frames) {
+    const fix_t span = PHYS_BALL_MAX_Y - PHYS_BALL_MIN_Y;
+    fix_t dist, speed;
+
+    if (b->dx > 0) {
+        dist = target_x - b->x;
+        speed = b->dx;
+    } else if (b->dx < 0) {
+        dist = b->x - target_x;
+        speed = -b->dx;
+    } else {
+        return PHYS_NO_INTERCEPT;
+    }
+
+    /* Numarul de frame-uri pana la tinta (minim unul, ca la Physics_Step) */
+    int32_t frames = (dist > 0) ? (dist + speed - 1) / speed : 1;
+    if (frames > max_frames) return PHYS_NO_INTERCEPT;
+
+    /* Miscare desfacuta, pliata pe perioada 2 * span */
+    fix_t u = (b->y - PHYS_BALL_MIN_Y + frames * b->dy) % (2 * span);
+    if (u < 0) u += 2 * span;
+    if (u > span) u = 2 * span - u;
+
+    return PHYS_BALL_MIN_Y + u;
+}
+
+/*
+ * Mingea atinge fata paletei dupa num/den din frame.
+ * La lovitura: dx se inverseaza, dy depinde de punctul de impact,
+ * iar x1/y1 devin capatul drumului reflectat.
+ */
+static bool SweepPaddle(Physics_State_t* s, uint8_t p, fix_t num, fix_t den,
+                        fix_t* x1, fix_t* y1, uint8_t* flips) {
+    PhysBall_t* b = &s->ball;
+    fix_t top = INT_TO_FIX(s->paddle_y[p]);
+    fix_t yc = Physics_FoldY(b->y + (b->dy * num) / den, NULL);
+
+    if (yc + BALL_SIZE_FIX < top || yc > top + PADDLE_HEIGHT_FIX) {
+        return false;
+    }
+
+    /* Unghiul depinde de distanta fata de centrul paletei */
+    fix_t hit_pos = (yc + BALL_SIZE_FIX / 2) - (top + PADDLE_HEIGHT_FIX / 2);
+    fix_t dy = hit_pos / 4;
+    if (dy > -PHYS_MIN_DY && dy < PHYS_MIN_DY) {
+        bool up = (dy < 0) || (dy == 0 && (Physics_Random(s) & 1U));
+        dy = up ? -PHYS_MIN_DY : PHYS_MIN_DY;
+    }
+
+    /* Reflexie fata de planul paletei (muchia P2 e cea dreapta) */
+    fix_t face = (p == 0) ? PHYS_FACE_P1 : PHYS_FACE_P2 - BALL_SIZE_FIX;
+    *x1 = 2 * face - *x1;
+
+    b->dx = -b->dx;
+    b->dy = dy;
+    *y1 = Physics_FoldY(yc + (dy * (den - num)) / den, flips);
+    return true;
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+void Physics_Init(Physics_State_t* s, uint32_t seed) {
+    s->rng = seed ? seed : 0x2545F491U;
+    s->paddle_y[0] = PADDLE_START_Y;
+    s->paddle_y[1] = PADDLE_START_Y;
+    s->ball.dx = 0;
+
+    Physics_Serve(s, (Physics_Random(s) & 1U) ? 1 : -1);
+}
+
+void Physics_Serve(Physics_State_t* s, int8_t dir_x) {
+    PhysBall_t* b = &s->ball;
+
+    b->x = INT_TO_FIX(BALL_START_X);
+    b->y = INT_TO_FIX(BALL_START_Y);
+    b->dx = dir_x * INT_TO_FIX(BALL_SPEED_X);
+    b->dy = (Physics_Random(s) & 1U) ? INT_TO_FIX(BALL_SPEED_Y) : -INT_TO_FIX(BALL_SPEED_Y);
+}
+
+void Physics_SpeedUp(Physics_State_t* s, bool vertical) {
+    PhysBall_t* b = &s->ball;
+
+    b->dx += (b->dx > 0) ? FIX_ONE : -FIX_ONE;
+
+    if (vertical) {
+        if (b->dy > 0) b->dy += FIX_ONE;
+        else if (b->dy < 0) b->dy -= FIX_ONE;
+    }
+}
+
+uint8_t Physics_Step(Physics_State_t* s, const Physics_Inputs_t* in) {
+    PhysBall_t* b = &s->ball;
+    uint8_t events = 0;
+    uint8_t flips;
+
+    /*----- PALETE -----*/
+    for (uint8_t p = 0; p < 2; p++) {
+        int16_t y = s->paddle_y[p] + in->paddle_dy[p];
+        if (y < PADDLE_MIN_Y) y = PADDLE_MIN_Y;
+        if (y > PADDLE_MAX_Y) y = PADDLE_MAX_Y;
+        s->paddle_y[p] = y;
+    }
+
+    /*----- MINGE -----*/
+    fix_t x1 = b->x + b->dx;
+    fix_t y1 = Physics_FoldY(b->y + b->dy, &flips);
+
+    if (flips) events |= PHYS_EV_WALL;
+
+    if (b->dx < 0 && b->x >= PHYS_FACE_P1 && x1 < PHYS_FACE_P1) {
+        if (SweepPaddle(s, 0, b->x - PHYS_FACE_P1, -b->dx, &x1, &y1, &flips)) {
+            events |= PHYS_EV_HIT_P1;
+        }
+    } else if (b->dx > 0 && b->x + BALL_SIZE_FIX <= PHYS_FACE_P2 &&
+               x1 + BALL_SIZE_FIX > PHYS_FACE_P2) {
+        if (SweepPaddle(s, 1, PHYS_FACE_P2 - (b->x + BALL_SIZE_FIX), b->dx, &x1, &y1, &flips)) {
+            events |= PHYS_EV_HIT_P2;
+        }
+    }
+
+    /* Un numar impar de reflexii pe ultimul segment inverseaza dy */
+    if (flips & 1U) b->dy = -b->dy;
+    b->x = x1;
+    b->y = y1;
+
+    /*----- GOL -----*/
+    if (b->x < INT_TO_FIX(-BALL_SIZE)) {
+        events |= PHYS_EV_GOAL_P2;
+    } else if (b->x > INT_TO_FIX(FIELD_WIDTH + BALL_SIZE)) {
+        events |= PHYS_EV_GOAL_P1;
+    }
+
+    return events;
+}
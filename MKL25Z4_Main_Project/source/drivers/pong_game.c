@@ -1,15 +1,21 @@
 /*
  * pong_game.c
  * Logica completa pentru jocul Pong
- * Include fizica, coliziuni, AI (CPU) si rendering optimizat
+ * Input, AI (CPU), scor si rendering optimizat
+ * Miscarea si coliziunile sunt in physics.c
  */
 
 #include "headers/pong_game.h"
+#include "headers/physics.h"
+#include "headers/timeline.h"
 #include "headers/st7735_simple.h"
+#include "headers/compositor.h"
 #include "headers/joystick.h"
 #include "headers/ir_remote.h"
-#include "fsl_debug_console.h"
-#include <stdio.h>
+#include "headers/input_events.h"
+#include "headers/audio.h"
+#include "headers/log.h"
+#include "headers/profiler.h"
 #include <stdlib.h>
 
 /*============================================================================
@@ -25,61 +31,35 @@ extern Difficulty_t g_currentDifficulty;
  * GAME STATE
  *============================================================================*/
 
-static Ball_t ball;
+static Physics_State_t phys;
 static Paddle_t paddle1, paddle2;
 static GameState_t game;
 
-/*============================================================================
- * DELAY FUNCTION (pentru animatii)
- *============================================================================*/
-
-static void delay_ms(uint32_t ms) {
-    uint32_t start = g_systick_ms;
-    while ((g_systick_ms - start) < ms) {
-        __asm volatile("nop");
-    }
-}
+/* Countdown, pauza dupa gol, SPEED UP - cat ruleaza, jocul sta pe loc */
+static Timeline_t transition;
 
 /*============================================================================
  * AI / CPU LOGIC
  *============================================================================*/
 
-/* Predictie simpla - unde va ajunge bila */
+/* Orizontul predictiei, in frame-uri */
+#define AI_PREDICT_FRAMES   200
+
+/* Unde va ajunge bila (Y-ul coltului, in pixeli) - timp constant */
 static int16_t AI_PredictBallY(int16_t target_x) {
-    int16_t sim_x = ball.x;
-    int16_t sim_y = ball.y;
-    int16_t sim_dx = ball.dx;
-    int16_t sim_dy = ball.dy;
-    
-    int iterations = 0;
-    while (iterations < 200) {
-        sim_x += sim_dx;
-        sim_y += sim_dy;
-        
-        /* Bounce pe pereti sus/jos */
-        if (sim_y <= 2 || sim_y >= FIELD_HEIGHT - BALL_SIZE - 2) {
-            sim_dy = -sim_dy;
-            if (sim_y <= 2) sim_y = 3;
-            if (sim_y >= FIELD_HEIGHT - BALL_SIZE - 2) {
-                sim_y = FIELD_HEIGHT - BALL_SIZE - 3;
-            }
-        }
-        
-        /* A ajuns la pozitia dorita? */
-        if ((sim_dx > 0 && sim_x >= target_x) || 
-            (sim_dx < 0 && sim_x <= target_x)) {
-            return sim_y;
-        }
-        
-        iterations++;
-    }
+    fix_t y = Physics_InterceptY(&phys.ball, INT_TO_FIX(target_x), AI_PREDICT_FRAMES);
     
-    return FIELD_HEIGHT / 2;  /* Fallback la centru */
+    if (y == PHYS_NO_INTERCEPT) {
+        return FIELD_HEIGHT / 2;  /* Fallback la centru */
+    }
+    return FIX_TO_INT(y);
 }
 
-/* Update AI pentru o paleta */
-static void AI_UpdatePaddle(Paddle_t* paddle, bool is_right_side) {
-    int16_t paddle_center = paddle->y + PADDLE_HEIGHT / 2;
+/* Update AI pentru o paleta - returneaza deplasarea dorita in acest frame */
+static int16_t AI_UpdatePaddle(Paddle_t* paddle, bool is_right_side) {
+    int16_t paddle_center = phys.paddle_y[is_right_side ? 1 : 0] + PADDLE_HEIGHT / 2;
+    int16_t ball_x = FIX_TO_INT(phys.ball.x);
+    int16_t move = 0;
     int16_t target_y;
     int16_t speed;
     int16_t reaction_zone;
@@ -111,12 +91,12 @@ static void AI_UpdatePaddle(Paddle_t* paddle, bool is_right_side) {
             update_interval = 3;
             break;
         default:
-            return;
+            return 0;
     }
     
     /* Verifica daca bila vine spre aceasta paleta */
-    bool ball_coming = (is_right_side && ball.dx > 0) || 
-                       (!is_right_side && ball.dx < 0);
+    bool ball_coming = (is_right_side && phys.ball.dx > 0) || 
+                       (!is_right_side && phys.ball.dx < 0);
     
     if (ball_coming) {
         /* Calculeaza tinta doar periodic */
@@ -137,7 +117,7 @@ static void AI_UpdatePaddle(Paddle_t* paddle, bool is_right_side) {
     }
     
     /* Distanta pana la bila */
-    int16_t ball_dist = is_right_side ? (PADDLE_X_P2 - ball.x) : (ball.x - PADDLE_X_P1);
+    int16_t ball_dist = is_right_side ? (PADDLE_X_P2 - ball_x) : (ball_x - PADDLE_X_P1);
     
     /* Miscare doar daca bila e in zona de reactie */
     if (ball_dist < reaction_zone || !ball_coming) {
@@ -146,123 +126,168 @@ static void AI_UpdatePaddle(Paddle_t* paddle, bool is_right_side) {
         if (make_mistake) {
             int mistake_type = rand() % 3;
             if (mistake_type == 0) {
-                paddle->y -= speed;
+                move = -speed;
             } else if (mistake_type == 1) {
-                paddle->y += speed;
+                move = speed;
             }
         } else {
             if (paddle_center < target_y - 5) {
-                paddle->y += speed;
+                move = speed;
             } else if (paddle_center > target_y + 5) {
-                paddle->y -= speed;
+                move = -speed;
             }
         }
     }
     
-    /* Limiteaza pozitia */
-    if (paddle->y < PADDLE_MIN_Y) paddle->y = PADDLE_MIN_Y;
-    if (paddle->y > PADDLE_MAX_Y) paddle->y = PADDLE_MAX_Y;
+    /* Limitele sunt aplicate de Physics_Step */
+    return move;
+}
+
+/* Viteza analogica Q8.8 -> pixeli intregi in acest frame; restul sub-pixel
+ * ramane in paleta, deci vitezele mici misca paleta la cateva frame-uri */
+static int16_t AnalogMove(Paddle_t* paddle, int16_t speed) {
+    int16_t acc = paddle->frac_y + speed;
+
+    paddle->frac_y = acc & (FIX_ONE - 1);
+    return acc >> FIX_SHIFT;
 }
 
+/*============================================================================
+ * INPUT LATENCY (-DPROFILER)
+ *============================================================================*/
+
+/* Inputul care a pornit o paleta e etichetat abia in frame-ul in care
+ * paleta s-a miscat pe ecran (AnalogMove poate sta cateva frame-uri sub
+ * un pixel, iar la perete paleta nu se misca deloc) */
+
+#if defined(PROFILER)
+static uint32_t lat_stamp[2];
+static uint8_t lat_source[2];
+static bool lat_waiting[2];
+static int16_t lat_y[2];
+
+static void Latency_TakeInputs(void) {
+    const InputType_t input[2] = { paddle1.input, paddle2.input };
+    uint32_t stamp;
+    
+    /* P1 intai: ca in Game_Update, P2 are un dispozitiv doar daca P1 nu il foloseste */
+    for (uint8_t i = 0; i < 2; i++) {
+        lat_y[i] = phys.paddle_y[i];
+        if (input[i] == INPUT_REMOTE && IR_TakeInputStamp(&stamp)) {
+            lat_source[i] = INPUT_SRC_IR;
+        } else if (input[i] == INPUT_JOYSTICK && Joystick_TakeInputStamp(&stamp)) {
+            lat_source[i] = INPUT_SRC_JOYSTICK;
+        } else {
+            continue;
+        }
+        lat_stamp[i] = stamp;
+        lat_waiting[i] = true;
+    }
+}
+
+static void Latency_TagMoved(void) {
+    for (uint8_t i = 0; i < 2; i++) {
+        if (!lat_waiting[i] || phys.paddle_y[i] == lat_y[i]) continue;
+        PROF_LATENCY_TAG(lat_source[i], lat_stamp[i]);
+        lat_waiting[i] = false;
+    }
+}
+
+#define LATENCY_TAKE_INPUTS()   Latency_TakeInputs()
+#define LATENCY_TAG_MOVED()     Latency_TagMoved()
+#else
+#define LATENCY_TAKE_INPUTS()   ((void)0)
+#define LATENCY_TAG_MOVED()     ((void)0)
+#endif
+
 /*============================================================================
  * DRAWING FUNCTIONS
  *============================================================================*/
 
+/* Terenul, scorul si sprite-urile sunt compuse de compositor.c -
+ * aici doar se marcheaza ce s-a schimbat si se trimite frame-ul */
+
 void Game_DrawField(void) {
-    ST7735_FillScreen(COLOR_BLACK);
-    
-    /* Linie centrala punctata */
-    for (int16_t y = 4; y < FIELD_HEIGHT - 4; y += 8) {
-        ST7735_FillRect(79, y, 2, 4, COLOR_DARK_GRAY);
-    }
-    
-    /* Margini sus/jos */
-    ST7735_DrawHLine(0, 0, FIELD_WIDTH, COLOR_WHITE);
-    ST7735_DrawHLine(0, FIELD_HEIGHT - 1, FIELD_WIDTH, COLOR_WHITE);
+    Compositor_InvalidateAll();
+    Compositor_Flush();
 }
 
 void Game_DrawScore(void) {
-    char buf[8];
-    
-    /* Sterge zona scorului */
-    ST7735_FillRect(55, SCORE_Y, 50, 10, COLOR_BLACK);
-    
-    /* Scor P1 (stanga) */
-    snprintf(buf, sizeof(buf), "%d", paddle1.score);
-    ST7735_DrawStringScaled(68, SCORE_Y, buf, COLOR_CYAN, COLOR_BLACK, 1);
-    
-    /* Separator */
-    ST7735_DrawString(77, SCORE_Y, "-", COLOR_WHITE, COLOR_BLACK);
-    
-    /* Scor P2 (dreapta) */
-    snprintf(buf, sizeof(buf), "%d", paddle2.score);
-    ST7735_DrawStringScaled(86, SCORE_Y, buf, COLOR_MAGENTA, COLOR_BLACK, 1);
+    Compositor_SetScore(paddle1.score, paddle2.score);
+    Compositor_Flush();
 }
 
-/* Deseneaza o paleta (cu stergere optimizata) */
-static void DrawPaddle(Paddle_t* paddle, int16_t x, uint16_t color) {
-    if (paddle->y != paddle->prev_y) {
-        if (paddle->y > paddle->prev_y) {
-            int16_t clear_h = paddle->y - paddle->prev_y;
-            if (clear_h > PADDLE_HEIGHT) clear_h = PADDLE_HEIGHT;
-            ST7735_FillRect(x, paddle->prev_y, PADDLE_WIDTH, clear_h, COLOR_BLACK);
-        } else {
-            int16_t clear_h = paddle->prev_y - paddle->y;
-            if (clear_h > PADDLE_HEIGHT) clear_h = PADDLE_HEIGHT;
-            ST7735_FillRect(x, paddle->y + PADDLE_HEIGHT, PADDLE_WIDTH, clear_h, COLOR_BLACK);
-        }
-    }
-    
-    ST7735_FillRect(x, paddle->y, PADDLE_WIDTH, PADDLE_HEIGHT, color);
-    paddle->prev_y = paddle->y;
+/* Actualizeaza sprite-urile din starea jocului */
+static void UpdateSprites(void) {
+    Compositor_SetSprite(COMP_SPRITE_P1, PADDLE_X_P1, phys.paddle_y[0], PADDLE_WIDTH, PADDLE_HEIGHT, COLOR_CYAN);
+    Compositor_SetSprite(COMP_SPRITE_P2, PADDLE_X_P2, phys.paddle_y[1], PADDLE_WIDTH, PADDLE_HEIGHT, COLOR_MAGENTA);
+    Compositor_SetSprite(COMP_SPRITE_BALL, FIX_TO_INT(phys.ball.x), FIX_TO_INT(phys.ball.y),
+                         BALL_SIZE, BALL_SIZE, COLOR_YELLOW);
 }
 
-/* Redeseneaza linia centrala */
-static void RedrawCenterLine(void) {
-    for (int16_t y = 4; y < FIELD_HEIGHT - 4; y += 8) {
-        ST7735_FillRect(79, y, 2, 4, COLOR_DARK_GRAY);
-    }
+/*============================================================================
+ * TRANSITIONS
+ *============================================================================*/
+
+/* Pasii sunt avansati de Game_Update (task-ul de joc, 50 Hz); task-ul
+ * de input ruleaza in continuare Joystick_Process / IR_Process intre ei */
+
+static void DrawCountdownBox(const char* text, uint16_t color, uint16_t border, uint16_t bg) {
+    ST7735_FillRect(40, 50, 80, 30, bg);
+    ST7735_DrawRect(40, 50, 80, 30, border);
+    ST7735_DrawStringCentered(58, text, color, bg, 2);
 }
 
-/* Deseneaza bila */
-static void DrawBall(void) {
-    if (ball.x != ball.prev_x || ball.y != ball.prev_y) {
-        ST7735_FillRect(ball.prev_x, ball.prev_y, ball.size, ball.size, COLOR_BLACK);
-    }
-    
-    ST7735_FillRect(ball.x, ball.y, ball.size, ball.size, COLOR_YELLOW);
-    
-    /* Redeseneaza linia centrala daca bila e in zona */
-    if ((ball.x >= 70 && ball.x <= 90) || (ball.prev_x >= 70 && ball.prev_x <= 90)) {
-        RedrawCenterLine();
-    }
-    
-    /* Redeseneaza scorul daca bila e in zona de sus */
-    if (ball.y < 15 || ball.prev_y < 15) {
-        Game_DrawScore();
-    }
-    
-    ball.prev_x = ball.x;
-    ball.prev_y = ball.y;
+static void Countdown_Ready(void) { DrawCountdownBox("READY", COLOR_YELLOW, COLOR_YELLOW, COLOR_DARK_GRAY); }
+static void Countdown_3(void)     { DrawCountdownBox("3", COLOR_WHITE, COLOR_WHITE, COLOR_DARK_GRAY); }
+static void Countdown_2(void)     { DrawCountdownBox("2", COLOR_WHITE, COLOR_WHITE, COLOR_DARK_GRAY); }
+static void Countdown_1(void)     { DrawCountdownBox("1", COLOR_WHITE, COLOR_WHITE, COLOR_DARK_GRAY); }
+static void Countdown_Go(void)    { DrawCountdownBox("GO!", COLOR_WHITE, COLOR_WHITE, COLOR_GREEN); }
+
+/* Compositor-ul reface fundalul si sprite-urile la urmatorul Flush */
+static void Countdown_Clear(void) { Compositor_Invalidate(40, 50, 80, 30); }
+
+static void SpeedUp_Show(void) {
+    ST7735_FillRect(45, 55, 70, 18, COLOR_ORANGE);
+    ST7735_DrawRect(45, 55, 70, 18, COLOR_WHITE);
+    ST7735_DrawStringCentered(59, "SPEED UP!", COLOR_WHITE, COLOR_ORANGE, 1);
 }
 
+static void SpeedUp_Clear(void) { Compositor_Invalidate(45, 55, 70, 18); }
+
+static const TimelineStep_t countdown_steps[] = {
+    { Countdown_Ready, 700 },
+    { Countdown_3,     400 },
+    { Countdown_2,     400 },
+    { Countdown_1,     400 },
+    { Countdown_Go,    500 },
+    { Countdown_Clear, 0 },
+};
+
+static const TimelineStep_t serve_steps[] = {
+    { NULL, 500 },      /* Bila sta in centru */
+};
+
+static const TimelineStep_t speedup_steps[] = {
+    { SpeedUp_Show,  300 },
+    { SpeedUp_Clear, 0 },
+};
+
+#define STEPS(table)    (table), (uint8_t)(sizeof(table) / sizeof((table)[0]))
+
 /* Reset bila dupa gol */
 static void ResetBall(void) {
-    ST7735_FillRect(ball.prev_x, ball.prev_y, ball.size, ball.size, COLOR_BLACK);
-    
-    ball.x = BALL_START_X;
-    ball.y = BALL_START_Y;
-    ball.prev_x = ball.x;
-    ball.prev_y = ball.y;
-    
-    int8_t dir = (ball.dx > 0) ? -1 : 1;
-    ball.dx = dir * BALL_SPEED_X;
-    ball.dy = (rand() % 2) ? BALL_SPEED_Y : -BALL_SPEED_Y;
+    /* Serveste spre cel care a primit gol */
+    Physics_Serve(&phys, (phys.ball.dx > 0) ? -1 : 1);
     
     game.rally_frames = 0;
     game.speed_level = 0;
     
-    delay_ms(500);
+    /* Afisam bila in centru pe durata pauzei */
+    UpdateSprites();
+    Compositor_Flush();
+    
+    Timeline_Start(&transition, STEPS(serve_steps));
 }
 
 /*============================================================================
@@ -270,31 +295,19 @@ static void ResetBall(void) {
  *============================================================================*/
 
 void Game_Init(void) {
-    /* Reset bila */
-    ball.x = BALL_START_X;
-    ball.y = BALL_START_Y;
-    ball.dx = BALL_SPEED_X;
-    ball.dy = BALL_SPEED_Y;
-    ball.prev_x = ball.x;
-    ball.prev_y = ball.y;
-    ball.size = BALL_SIZE;
-    
-    /* Directie aleatoare */
-    if (rand() % 2) ball.dx = -ball.dx;
-    if (rand() % 2) ball.dy = -ball.dy;
+    /* Bila in centru cu directie aleatoare, palete in centru */
+    Physics_Init(&phys, (uint32_t)rand());
     
     /* Reset palete */
-    paddle1.y = PADDLE_START_Y;
-    paddle1.prev_y = paddle1.y;
     paddle1.score = 0;
     paddle1.input = g_player1_input;
     paddle1.target_y = FIELD_HEIGHT / 2;
+    paddle1.frac_y = 0;
     
-    paddle2.y = PADDLE_START_Y;
-    paddle2.prev_y = paddle2.y;
     paddle2.score = 0;
     paddle2.input = g_player2_input;
     paddle2.target_y = FIELD_HEIGHT / 2;
+    paddle2.frac_y = 0;
     
     /* Pentru Player vs CPU, seteaza dificultatea */
     if (IS_CPU_INPUT(paddle2.input)) {
@@ -319,55 +332,31 @@ void Game_Init(void) {
     game.frame_count = 0;
     game.rally_frames = 0;
     game.speed_level = 0;
+    Timeline_Cancel(&transition);
     
-    PRINTF("[GAME] Init - P1:%d P2:%d\r\n", paddle1.input, paddle2.input);
+    LOG("[GAME] Init - P1:%d P2:%d\r\n", paddle1.input, paddle2.input);
 }
 
 void Game_Start(void) {
-    PRINTF("\r\n=== GAME STARTED ===\r\n");
+    LOG("\r\n=== GAME STARTED ===\r\n");
     
     Game_Init();
-    Game_DrawField();
-    Game_DrawScore();
-    
-    /* Deseneaza paletele initiale */
-    ST7735_FillRect(PADDLE_X_P1, paddle1.y, PADDLE_WIDTH, PADDLE_HEIGHT, COLOR_CYAN);
-    ST7735_FillRect(PADDLE_X_P2, paddle2.y, PADDLE_WIDTH, PADDLE_HEIGHT, COLOR_MAGENTA);
-    
-    /* Countdown animat */
-    ST7735_FillRect(40, 50, 80, 30, COLOR_DARK_GRAY);
-    ST7735_DrawRect(40, 50, 80, 30, COLOR_YELLOW);
-    ST7735_DrawStringCentered(58, "READY", COLOR_YELLOW, COLOR_DARK_GRAY, 2);
-    delay_ms(700);
-    
-    ST7735_FillRect(40, 50, 80, 30, COLOR_DARK_GRAY);
-    ST7735_DrawRect(40, 50, 80, 30, COLOR_WHITE);
-    ST7735_DrawStringCentered(58, "3", COLOR_WHITE, COLOR_DARK_GRAY, 2);
-    delay_ms(400);
-    
-    ST7735_FillRect(40, 50, 80, 30, COLOR_DARK_GRAY);
-    ST7735_DrawRect(40, 50, 80, 30, COLOR_WHITE);
-    ST7735_DrawStringCentered(58, "2", COLOR_WHITE, COLOR_DARK_GRAY, 2);
-    delay_ms(400);
-    
-    ST7735_FillRect(40, 50, 80, 30, COLOR_DARK_GRAY);
-    ST7735_DrawRect(40, 50, 80, 30, COLOR_WHITE);
-    ST7735_DrawStringCentered(58, "1", COLOR_WHITE, COLOR_DARK_GRAY, 2);
-    delay_ms(400);
-    
-    ST7735_FillRect(40, 50, 80, 30, COLOR_GREEN);
-    ST7735_DrawRect(40, 50, 80, 30, COLOR_WHITE);
-    ST7735_DrawStringCentered(58, "GO!", COLOR_WHITE, COLOR_GREEN, 2);
-    delay_ms(500);
-    
-    /* Sterge mesajul */
-    ST7735_FillRect(40, 50, 80, 30, COLOR_BLACK);
-    RedrawCenterLine();
+    
+    /* Teren + scor + palete + bila, compuse intr-un singur frame */
+    Compositor_Init();
+    UpdateSprites();
+    Compositor_Flush();
+    
+    /* Countdown animat - avansat de Game_Update, fara blocare */
+    Timeline_Start(&transition, STEPS(countdown_steps));
 }
 
 void Game_Update(void) {
     if (!game.is_running || game.is_paused) return;
     
+    /* Tranzitie in curs - doar overlay-ul avanseaza */
+    if (Timeline_Update(&transition)) return;
+    
     game.frame_count++;
     game.rally_frames++;
     
@@ -377,132 +366,98 @@ void Game_Update(void) {
         game.speed_level < MAX_SPEED_LEVEL) {
         
         game.speed_level++;
+        Physics_SpeedUp(&phys, game.speed_level % 2 == 0);
+        Audio_Play(AUDIO_FX_SPEED_UP);
         
-        if (ball.dx > 0) ball.dx++;
-        else ball.dx--;
-        
-        if (game.speed_level % 2 == 0) {
-            if (ball.dy > 0) ball.dy++;
-            else if (ball.dy < 0) ball.dy--;
-        }
-        
-        ST7735_FillRect(45, 55, 70, 18, COLOR_ORANGE);
-        ST7735_DrawRect(45, 55, 70, 18, COLOR_WHITE);
-        ST7735_DrawStringCentered(59, "SPEED UP!", COLOR_WHITE, COLOR_ORANGE, 1);
-        delay_ms(300);
-        ST7735_FillRect(45, 55, 70, 18, COLOR_BLACK);
-        RedrawCenterLine();
+        Timeline_Start(&transition, STEPS(speedup_steps));
+        return;
     }
     
+    Physics_Inputs_t inputs = { { 0, 0 } };
+    
+    LATENCY_TAKE_INPUTS();
+    PROF_BEGIN(PROF_AI);
+    
     /*----- MISCARE PALETA 1 (Stanga) -----*/
     if (IS_CPU_INPUT(paddle1.input)) {
-        AI_UpdatePaddle(&paddle1, false);
+        inputs.paddle_dy[0] = AI_UpdatePaddle(&paddle1, false);
     } else if (paddle1.input == INPUT_JOYSTICK) {
-        int8_t dir = Joystick_GetGameDirection();
-        /* Inversam: joystick jos = paleta jos */
-        paddle1.y += dir * (PADDLE_SPEED - 1);
+        /* Joystick jos = paleta jos, viteza proportionala cu deflexia */
+        inputs.paddle_dy[0] = AnalogMove(&paddle1, Joystick_GetPaddleSpeed());
     } else if (paddle1.input == INPUT_REMOTE) {
         int8_t dir = IR_GetGameDirection();
-        paddle1.y += dir * PADDLE_SPEED;
+        inputs.paddle_dy[0] = dir * PADDLE_SPEED;
     }
     
     /*----- MISCARE PALETA 2 (Dreapta) -----*/
     if (IS_CPU_INPUT(paddle2.input)) {
-        AI_UpdatePaddle(&paddle2, true);
+        inputs.paddle_dy[1] = AI_UpdatePaddle(&paddle2, true);
     } else if (paddle2.input == INPUT_JOYSTICK) {
         /* P2 poate folosi acelasi joystick daca P1 nu il foloseste */
         if (paddle1.input != INPUT_JOYSTICK) {
-            int8_t dir = Joystick_GetGameDirection();
-            paddle2.y += dir * (PADDLE_SPEED - 1);
+            inputs.paddle_dy[1] = AnalogMove(&paddle2, Joystick_GetPaddleSpeed());
         }
     } else if (paddle2.input == INPUT_REMOTE) {
         /* P2 poate folosi telecomanda daca P1 nu o foloseste */
         if (paddle1.input != INPUT_REMOTE) {
             int8_t dir = IR_GetGameDirection();
-            paddle2.y += dir * PADDLE_SPEED;
+            inputs.paddle_dy[1] = dir * PADDLE_SPEED;
         }
     }
     
-    /* Limite palete */
-    if (paddle1.y < PADDLE_MIN_Y) paddle1.y = PADDLE_MIN_Y;
-    if (paddle1.y > PADDLE_MAX_Y) paddle1.y = PADDLE_MAX_Y;
-    if (paddle2.y < PADDLE_MIN_Y) paddle2.y = PADDLE_MIN_Y;
-    if (paddle2.y > PADDLE_MAX_Y) paddle2.y = PADDLE_MAX_Y;
+    PROF_END(PROF_AI);
     
-    /*----- MISCARE BILA -----*/
-    ball.x += ball.dx;
-    ball.y += ball.dy;
+    /*----- FIZICA: palete, bila, pereti, coliziuni -----*/
+    PROF_BEGIN(PROF_PHYSICS);
+    uint8_t events = Physics_Step(&phys, &inputs);
+    PROF_END(PROF_PHYSICS);
+    LATENCY_TAG_MOVED();
     
-    /* Coliziune sus/jos */
-    if (ball.y <= 2) {
-        ball.y = 3;
-        ball.dy = -ball.dy;
-    }
-    if (ball.y >= FIELD_HEIGHT - BALL_SIZE - 2) {
-        ball.y = FIELD_HEIGHT - BALL_SIZE - 3;
-        ball.dy = -ball.dy;
-    }
-    
-    /*----- COLIZIUNE CU PALETE -----*/
-    
-    /* Paleta 1 (stanga) */
-    if (ball.dx < 0 && 
-        ball.x <= PADDLE_X_P1 + PADDLE_WIDTH + 1 && 
-        ball.x >= PADDLE_X_P1) {
-        if (ball.y + ball.size >= paddle1.y && 
-            ball.y <= paddle1.y + PADDLE_HEIGHT) {
-            ball.x = PADDLE_X_P1 + PADDLE_WIDTH + 2;
-            ball.dx = -ball.dx;
-            
-            int16_t hit_pos = (ball.y + ball.size / 2) - (paddle1.y + PADDLE_HEIGHT / 2);
-            ball.dy = hit_pos / 4;
-            if (ball.dy == 0) ball.dy = (rand() % 2) ? 1 : -1;
-        }
-    }
-    
-    /* Paleta 2 (dreapta) */
-    if (ball.dx > 0 && 
-        ball.x + ball.size >= PADDLE_X_P2 - 1 && 
-        ball.x <= PADDLE_X_P2 + PADDLE_WIDTH) {
-        if (ball.y + ball.size >= paddle2.y && 
-            ball.y <= paddle2.y + PADDLE_HEIGHT) {
-            ball.x = PADDLE_X_P2 - ball.size - 2;
-            ball.dx = -ball.dx;
-            
-            int16_t hit_pos = (ball.y + ball.size / 2) - (paddle2.y + PADDLE_HEIGHT / 2);
-            ball.dy = hit_pos / 4;
-            if (ball.dy == 0) ball.dy = (rand() % 2) ? 1 : -1;
-        }
+    /*----- SUNET -----*/
+    /* Prioritatile din audio.c: un gol acopera lovitura din acelasi frame */
+    if (events & (PHYS_EV_HIT_P1 | PHYS_EV_HIT_P2)) {
+        Audio_Play(AUDIO_FX_PADDLE);
+    } else if (events & PHYS_EV_WALL) {
+        Audio_Play(AUDIO_FX_WALL);
     }
     
     /*----- GOL -----*/
     
-    if (ball.x < -ball.size) {
+    if (events & PHYS_EV_GOAL_P2) {
         paddle2.score++;
-        Game_DrawScore();
+        Compositor_SetScore(paddle1.score, paddle2.score);
         if (paddle2.score >= game.winning_score) {
             game.winner = 2;
             game.is_running = 0;
+            Audio_Play(AUDIO_FX_GAME_OVER);
         } else {
             ResetBall();
+            Audio_Play(AUDIO_FX_GOAL);
         }
     }
     
-    if (ball.x > FIELD_WIDTH + ball.size) {
+    if (events & PHYS_EV_GOAL_P1) {
         paddle1.score++;
-        Game_DrawScore();
+        Compositor_SetScore(paddle1.score, paddle2.score);
         if (paddle1.score >= game.winning_score) {
             game.winner = 1;
             game.is_running = 0;
+            Audio_Play(AUDIO_FX_GAME_OVER);
         } else {
             ResetBall();
+            Audio_Play(AUDIO_FX_GOAL);
         }
     }
     
     /*----- DESENARE -----*/
-    DrawPaddle(&paddle1, PADDLE_X_P1, COLOR_CYAN);
-    DrawPaddle(&paddle2, PADDLE_X_P2, COLOR_MAGENTA);
-    DrawBall();
+    /* Doar zonele modificate (bila, palete, scor) pleaca pe SPI */
+    PROF_BEGIN(PROF_RENDER);
+    UpdateSprites();
+    Compositor_Flush();
+    PROF_END(PROF_RENDER);
+    
+    /* Latenta se inchide cand frame-ul cu paleta mutata a iesit pe SPI */
+    PROF_LATENCY_COMMIT(ST7735_IsBusy);
 }
 
 uint8_t Game_GetWinner(void) {
@@ -517,6 +472,9 @@ int16_t Game_GetScore(uint8_t player) {
 
 void Game_SetPaused(bool paused) {
     game.is_paused = paused ? 1 : 0;
+    
+    /* La resume terenul e redesenat complet - overlay-ul curent revine */
+    if (!paused) Timeline_Replay(&transition);
 }
 
 bool Game_IsPaused(void) {
@@ -526,3 +484,7 @@ bool Game_IsPaused(void) {
 bool Game_IsRunning(void) {
     return game.is_running != 0;
 }
+
+bool Game_IsInTransition(void) {
+    return Timeline_IsActive(&transition);
+}
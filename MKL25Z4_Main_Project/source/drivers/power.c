@@ -0,0 +1,203 @@
+/*
+ * power.c
+ * Somn tickless: LPTMR0 ca ceas de trezire, VLPS prin fsl_smc
+ *
+ * In VLPS ceasul core/bus e oprit: SysTick, TPM, PIT, SPI/DMA si UART
+ * stau pe loc. Raman LPO (LPTMR0), ADC-ul pe ADACK si intreruperile de
+ * pin (AWIC), deci trezirea vine din LPTMR, buton, primul front IR sau
+ * o conversie ADC. Milisecundele dormite se citesc din LPTMR la trezire.
+ *
+ * LPO nu e calibrat (~1 kHz), deci g_systick_ms poate deriva putin cat
+ * timp se sta in meniuri; in joc ramane pe SysTick.
+ */
+
+#include "headers/power.h"
+#include "headers/ir_remote.h"
+#include "headers/joystick.h"
+#include "headers/st7735_simple.h"
+#include "headers/log.h"
+#include "MKL25Z4.h"
+#include "fsl_smc.h"
+#include "fsl_clock.h"
+#include "fsl_debug_console.h"
+#if defined(POWER_PROBE)
+#include "fsl_port.h"
+#endif
+
+/*============================================================================
+ * HARDWARE CONFIGURATION
+ *============================================================================*/
+
+/* LPTMR0: PCS = 01 (LPO 1 kHz), prescaler ocolit -> 1 tick = 1 ms */
+#define POWER_LPTMR_PSR     (LPTMR_PSR_PCS(1) | LPTMR_PSR_PBYP_MASK)
+
+#if defined(POWER_PROBE)
+#define PROBE_SLEEP()       (POWER_PROBE_GPIO->PCOR = 1U << POWER_PROBE_PIN)
+#define PROBE_AWAKE()       (POWER_PROBE_GPIO->PSOR = 1U << POWER_PROBE_PIN)
+#else
+#define PROBE_SLEEP()       do { } while (0)
+#define PROBE_AWAKE()       do { } while (0)
+#endif
+
+/*============================================================================
+ * GLOBAL VARIABLES
+ *============================================================================*/
+
+static bool deep_allowed = false;
+static volatile uint32_t awake_until = 0;
+static PowerStats_t stats;
+static uint32_t relock_lag_us = 0;      /* Rest sub 1 ms pierdut de SysTick in PBE */
+
+/* Extern: timer global din main */
+extern volatile uint32_t g_systick_ms;
+
+/*============================================================================
+ * INTERRUPT HANDLER - LPTMR0
+ *============================================================================*/
+
+void LPTMR0_IRQHandler(void) {
+    /* Doar trezeste CPU-ul; Power_Sleep a citit deja timerul si l-a oprit */
+    LPTMR0->CSR = 0;
+}
+
+/*============================================================================
+ * PRIVATE FUNCTIONS
+ *============================================================================*/
+
+static bool Power_CanDeepSleep(uint32_t max_ms) {
+    if (!deep_allowed || max_ms < POWER_VLPS_MIN_MS) return false;
+
+    /* Un cadru IR in curs are nevoie de TPM1 */
+    if ((int32_t)(g_systick_ms - awake_until) < 0) return false;
+
+    /* O conversie ADC se termina in sub o milisecunda: trezirea ar veni
+     * inaintea primului tic LPTMR, iar timpul dormit s-ar pierde */
+    if (Joystick_HwIsConverting()) return false;
+
+    /* SPI/DMA se opresc in VLPS */
+    return !ST7735_IsBusy();
+}
+
+/* Cat se asteapta LOCK0, SysTick numara pe ceasul PBE (de 12x mai lent
+ * decat in PEE, cu acelasi LOAD): diferenta se aduna in relock_lag_us si
+ * intra in g_systick_ms cand face o milisecunda */
+static void Power_WaitPllRelock(void) {
+    uint32_t pbe_hz = CLOCK_GetCoreSysClkFreq();
+    uint32_t load = SysTick->LOAD + 1U;
+    uint32_t start = SysTick->VAL;
+
+    while (!(MCG->S & MCG_S_LOCK0_MASK)) {
+        __NOP();
+    }
+    uint32_t ticks = (start + load - SysTick->VAL) % load;
+    CLOCK_SetPeeMode();
+
+    if (pbe_hz != 0U && pbe_hz < SystemCoreClock) {
+        relock_lag_us += ticks * (SystemCoreClock / pbe_hz - 1U) / (SystemCoreClock / 1000000U);
+        g_systick_ms += relock_lag_us / 1000U;
+        relock_lag_us %= 1000U;
+    }
+    stats.pll_relocks++;
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+void Power_Init(void) {
+    CLOCK_EnableClock(kCLOCK_Lptmr0);
+
+    LPTMR0->CSR = 0;
+    LPTMR0->PSR = POWER_LPTMR_PSR;
+
+    NVIC_SetPriority(LPTMR0_IRQn, 3);
+    EnableIRQ(LPTMR0_IRQn);
+
+    SMC_SetPowerModeProtection(SMC, kSMC_AllowPowerModeVlp);
+
+#if defined(POWER_PROBE)
+    PORT_SetPinMux(POWER_PROBE_PORT, POWER_PROBE_PIN, kPORT_MuxAsGpio);
+    POWER_PROBE_GPIO->PSOR = 1U << POWER_PROBE_PIN;
+    POWER_PROBE_GPIO->PDDR |= 1U << POWER_PROBE_PIN;
+#endif
+
+    LOG_BOOT("[POWER] Tickless idle on LPTMR0, VLPS for gaps >= %u ms\r\n",
+             (unsigned int)POWER_VLPS_MIN_MS);
+}
+
+void Power_SetDeepSleep(bool allowed) {
+    deep_allowed = allowed;
+}
+
+void Power_StayAwake(uint32_t ms) {
+    uint32_t until = g_systick_ms + ms;
+
+    /* Doar prelungeste: o nota scurta nu taie fereastra unui cadru IR */
+    if ((int32_t)(until - awake_until) > 0) {
+        awake_until = until;
+    }
+}
+
+void Power_Sleep(uint32_t max_ms) {
+    if (!Power_CanDeepSleep(max_ms)) {
+        stats.wait_entries++;
+        SMC_SetPowerModeWait(SMC);
+        return;
+    }
+    if (max_ms > POWER_MAX_SLEEP_MS) max_ms = POWER_MAX_SLEEP_MS;
+
+    /* TCF se seteaza la incrementarea de dupa CNR == CMR */
+    LPTMR0->CMR = max_ms - 1U;
+    LPTMR0->CSR = LPTMR_CSR_TIE_MASK | LPTMR_CSR_TEN_MASK;
+
+    /* TPM1 nu capteaza in VLPS - primul front IR trezeste prin PORTA */
+    IR_HwSetWakeArmed(true);
+
+    PROBE_SLEEP();
+    status_t status = SMC_SetPowerModeVlps(SMC);
+    PROBE_AWAKE();
+
+    IR_HwSetWakeArmed(false);
+    SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+
+    /* Din PEE, STOP iese in PBE (core pe cristalul de 8 MHz) cu PLL-ul
+     * repornit: inapoi in PEE dupa LOCK0, inainte ca ISR-ul de trezire
+     * (si RunMode) sa vada ceasurile */
+    if (CLOCK_GetMode() == kMCG_ModePBE) {
+        Power_WaitPllRelock();
+    }
+
+    /* Cat s-a dormit: tot intervalul, sau CNR (o scriere il ingheata pentru citire) */
+    uint32_t slept;
+    if (LPTMR0->CSR & LPTMR_CSR_TCF_MASK) {
+        slept = max_ms;
+        stats.timer_wakeups++;
+    } else {
+        LPTMR0->CNR = 0;
+        slept = LPTMR0->CNR & LPTMR_CNR_COUNTER_MASK;
+        if (status != kStatus_SMC_StopAbort) stats.event_wakeups++;
+    }
+    LPTMR0->CSR = 0;
+
+    if (status == kStatus_SMC_StopAbort) {
+        stats.vlps_aborts++;
+    } else {
+        stats.vlps_entries++;
+    }
+    stats.vlps_ms += slept;
+
+    /* SysTick a stat pe loc; ISR-ul care ne-a trezit vede deja timpul corect */
+    g_systick_ms += slept;
+}
+
+void Power_GetStats(PowerStats_t* out) {
+    *out = stats;
+}
+
+void Power_PrintStats(void) {
+    PRINTF("[POWER] wait=%u vlps=%u aborts=%u relocks=%u vlps_ms=%u wakeups timer=%u event=%u\r\n",
+           (unsigned int)stats.wait_entries, (unsigned int)stats.vlps_entries,
+           (unsigned int)stats.vlps_aborts, (unsigned int)stats.pll_relocks,
+           (unsigned int)stats.vlps_ms,
+           (unsigned int)stats.timer_wakeups, (unsigned int)stats.event_wakeups);
+}
@@ -0,0 +1,281 @@
+/*
+ * profiler.c
+ * Histogramele din profiler.h si dump-ul lor periodic prin LOG
+ *
+ * Prof_Record poate veni din ISR (sfarsitul fazei spi e in DMA1_IRQHandler),
+ * deci histogramele se modifica doar cu intreruperile oprite. Dump-ul
+ * copiaza si goleste o faza odata (Prof_Take), apoi o trimite cate
+ * PROF_LINES_PER_POLL linii pe apel, ca ringul LOG sa aiba timp sa se goleasca.
+ *
+ * Latenta are doua trepte per sursa: "pending" (etichetat de cine a consumat
+ * inputul, inca nedesenat) si "sent" (desenat, in coada DMA). Commit muta
+ * pending -> sent doar daca sent e liber, ca un input sa nu fie inchis de
+ * golirea cozii unui frame desenat inaintea lui.
+ */
+
+#include "headers/profiler.h"
+
+#if defined(PROFILER)
+
+#include "headers/run_mode.h"
+#include "headers/scheduler.h"
+#include "headers/input_events.h"
+#include "headers/log.h"
+#include "MKL25Z4.h"
+#include "fsl_common.h"
+#include <string.h>
+
+/*============================================================================
+ * CONSTANTS
+ *============================================================================*/
+
+#define PROF_LINES_PER_POLL     6U
+#define PROF_BUCKETS_PER_LINE   3U
+#define PROF_SUB_MASK           ((1U << PROF_SUB_BITS) - 1U)
+
+/* Starea unui span (faza terminata din ISR) */
+#define SPAN_IDLE       0U
+#define SPAN_OPEN       1U      /* Inca se pun transferuri in coada */
+#define SPAN_CLOSED     2U      /* Asteapta golirea cozii */
+
+#define PROF_LAT_SOURCES    (PROF_PHASES - PROF_LAT_BUTTON)
+
+typedef char prof_lat_sources_match[(PROF_LAT_SOURCES == INPUT_NUM_SOURCES) ? 1 : -1];
+
+/*============================================================================
+ * GLOBAL VARIABLES
+ *============================================================================*/
+
+extern volatile uint32_t g_systick_ms;
+
+static ProfHist_t hist[PROF_PHASES];
+static volatile uint32_t skipped = 0;
+
+static uint32_t span_start[PROF_PHASES];
+static volatile uint8_t span_state[PROF_PHASES];
+
+/* Latenta: stamp-uri per sursa, bitul sursei in masca = slot ocupat */
+static uint32_t lat_pending[PROF_LAT_SOURCES];
+static uint32_t lat_sent[PROF_LAT_SOURCES];
+static volatile uint8_t lat_pending_mask = 0;
+static volatile uint8_t lat_sent_mask = 0;
+
+/* Dump: faza curenta (PROF_PHASES = niciunul in curs) si copia ei */
+static uint32_t last_dump_ms = 0;
+static uint32_t dump_seq = 0;
+static uint8_t dump_phase = PROF_PHASES;
+static uint8_t dump_bucket = 0;
+static bool dump_taken = false;
+static ProfHist_t dump;
+
+/*============================================================================
+ * PRIVATE FUNCTIONS
+ *============================================================================*/
+
+/* Cosul unei durate: liniar pana la 1 << PROF_SUB_BITS, apoi dupa bitul
+ * cel mai semnificativ si urmatorii PROF_SUB_BITS */
+static uint8_t Prof_Bucket(uint32_t cycles) {
+    uint32_t v = cycles >> PROF_SHIFT;
+
+    if (v <= PROF_SUB_MASK) return (uint8_t)v;
+
+    uint32_t msb = 31U - (uint32_t)__builtin_clz(v);
+    uint32_t b = ((msb - PROF_SUB_BITS + 1U) << PROF_SUB_BITS) |
+                 ((v >> (msb - PROF_SUB_BITS)) & PROF_SUB_MASK);
+
+    return (b < PROF_BUCKETS) ? (uint8_t)b : (uint8_t)(PROF_BUCKETS - 1U);
+}
+
+static bool Prof_LatencyStale(uint32_t now, uint32_t stamp) {
+    return (now - stamp) > PROF_LAT_MAX_MS * PROF_CYCLES_PER_MS;
+}
+
+/* Stamp-urile din masca, inregistrate la momentul now */
+static void Prof_LatencyRecord(uint8_t mask, uint32_t now) {
+    for (uint8_t s = 0; s < PROF_LAT_SOURCES; s++) {
+        if (mask & (1U << s)) Prof_Record((ProfPhase_t)(PROF_LAT_BUTTON + s), now - lat_sent[s]);
+    }
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+uint32_t Prof_Now(void) {
+    uint32_t sub;
+    uint32_t ms = Scheduler_ReadTick(&sub);
+
+    /* LOAD + 1 = ciclii unei ms in modul curent (48000 in RUN, 4000 in VLPR) */
+    uint32_t per_ms = SysTick->LOAD + 1U;
+    if (per_ms != PROF_CYCLES_PER_MS) sub = sub * PROF_CYCLES_PER_MS / per_ms;
+
+    return ms * PROF_CYCLES_PER_MS + sub;
+}
+
+void Prof_Record(ProfPhase_t phase, uint32_t cycles) {
+    /* Codul ruleaza in VLPR de 12 ori mai incet; latentele sunt timp real */
+    if (phase < PROF_LAT_BUTTON && RunMode_Get() != RUN_MODE_RUN) {
+        skipped++;
+        return;
+    }
+
+    uint8_t b = Prof_Bucket(cycles);
+    uint32_t key = DisableGlobalIRQ();
+    ProfHist_t* h = &hist[phase];
+
+    if (h->count == 0 || cycles < h->min) h->min = cycles;
+    if (cycles > h->max) h->max = cycles;
+    h->count++;
+    h->sum += cycles;
+    if (h->buckets[b] != UINT16_MAX) h->buckets[b]++;
+    EnableGlobalIRQ(key);
+}
+
+void Prof_SpanStart(ProfPhase_t phase) {
+    span_start[phase] = Prof_Now();
+    span_state[phase] = SPAN_OPEN;
+}
+
+void Prof_SpanClose(ProfPhase_t phase, bool (*busy)(void)) {
+    bool done = false;
+
+    /* busy() si starea citite impreuna: ISR-ul vine fie inainte, fie dupa */
+    uint32_t key = DisableGlobalIRQ();
+    if (span_state[phase] == SPAN_OPEN) {
+        done = !busy();
+        span_state[phase] = done ? SPAN_IDLE : SPAN_CLOSED;
+    }
+    EnableGlobalIRQ(key);
+
+    if (done) Prof_Record(phase, Prof_Now() - span_start[phase]);
+}
+
+void Prof_SpanEnd(ProfPhase_t phase) {
+    /* Coada se poate goli si intre doua zone ale aceluiasi flush */
+    if (span_state[phase] != SPAN_CLOSED) return;
+
+    span_state[phase] = SPAN_IDLE;
+    Prof_Record(phase, Prof_Now() - span_start[phase]);
+}
+
+void Prof_LatencyTag(uint8_t source, uint32_t stamp) {
+    uint8_t bit = (uint8_t)(1U << source);
+    uint32_t now = Prof_Now();
+
+    if (source >= PROF_LAT_SOURCES || Prof_LatencyStale(now, stamp)) return;
+
+    /* Un input mai vechi, inca nedesenat, ramane cel masurat */
+    uint32_t key = DisableGlobalIRQ();
+    if (!(lat_pending_mask & bit) || Prof_LatencyStale(now, lat_pending[source])) {
+        lat_pending[source] = stamp;
+        lat_pending_mask |= bit;
+    }
+    EnableGlobalIRQ(key);
+}
+
+void Prof_LatencyCommit(bool (*busy)(void)) {
+    uint8_t done = 0;
+    uint32_t now = Prof_Now();
+
+    if (!lat_pending_mask) return;
+
+    /* Ca Prof_SpanClose: busy() citit impreuna cu mastile */
+    uint32_t key = DisableGlobalIRQ();
+    for (uint8_t s = 0; s < PROF_LAT_SOURCES; s++) {
+        uint8_t bit = (uint8_t)(1U << s);
+        if (!(lat_pending_mask & bit) || (lat_sent_mask & bit)) continue;
+        lat_pending_mask &= (uint8_t)~bit;
+        if (Prof_LatencyStale(now, lat_pending[s])) continue;
+        lat_sent[s] = lat_pending[s];
+        lat_sent_mask |= bit;
+    }
+    if (!busy()) {
+        done = lat_sent_mask;
+        lat_sent_mask = 0;
+    }
+    EnableGlobalIRQ(key);
+
+    if (done) Prof_LatencyRecord(done, Prof_Now());
+}
+
+void Prof_LatencyDone(void) {
+    uint8_t done = lat_sent_mask;
+
+    if (!done) return;
+
+    lat_sent_mask = 0;
+    Prof_LatencyRecord(done, Prof_Now());
+}
+
+void Prof_Take(ProfPhase_t phase, ProfHist_t* out) {
+    uint32_t key = DisableGlobalIRQ();
+    *out = hist[phase];
+    memset(&hist[phase], 0, sizeof(hist[phase]));
+    EnableGlobalIRQ(key);
+}
+
+void Prof_Poll(void) {
+    uint32_t now = g_systick_ms;
+
+    if (dump_phase >= PROF_PHASES) {
+        if (now - last_dump_ms < PROF_DUMP_MS) return;
+
+        last_dump_ms = now;
+        uint32_t key = DisableGlobalIRQ();
+        uint32_t lost = skipped;
+        skipped = 0;
+        EnableGlobalIRQ(key);
+        LOG("[PROF] H %u %u %u %u\r\n", dump_seq++, PROF_CYCLES_PER_MS,
+            (PROF_SHIFT << 8) | PROF_SUB_BITS, lost);
+        dump_phase = 0;
+        dump_taken = false;
+        return;
+    }
+
+    for (uint8_t lines = 0; lines < PROF_LINES_PER_POLL; lines++) {
+        if (!dump_taken) {
+            Prof_Take((ProfPhase_t)dump_phase, &dump);
+            LOG("[PROF] P %u %u %u %u\r\n", dump_phase, dump.count, dump.min, dump.max);
+            if (dump.count) {
+                LOG("[PROF] S %u %u %u\r\n", dump_phase, (uint32_t)dump.sum, (uint32_t)(dump.sum >> 32));
+                lines++;
+            }
+            dump_taken = true;
+            dump_bucket = 0;
+            continue;
+        }
+
+        /* Urmatoarele cosuri nenule, impachetate cos << 16 | numar */
+        uint32_t packed[PROF_BUCKETS_PER_LINE] = { 0 };
+        uint8_t n = 0;
+        while (dump_bucket < PROF_BUCKETS && n < PROF_BUCKETS_PER_LINE) {
+            if (dump.buckets[dump_bucket]) {
+                packed[n++] = ((uint32_t)dump_bucket << 16) | dump.buckets[dump_bucket];
+            }
+            dump_bucket++;
+        }
+
+        if (n) {
+            LOG("[PROF] B %u %X %X %X\r\n", dump_phase, packed[0], packed[1], packed[2]);
+        }
+        if (dump_bucket >= PROF_BUCKETS) {
+            dump_taken = false;
+            if (++dump_phase >= PROF_PHASES) return;
+        }
+    }
+}
+
+uint32_t Prof_GetSkipped(void) {
+    return skipped;
+}
+
+uint32_t Prof_BucketLow(uint8_t bucket) {
+    if (bucket <= PROF_SUB_MASK) return (uint32_t)bucket << PROF_SHIFT;
+
+    uint32_t msb = (uint32_t)(bucket >> PROF_SUB_BITS) + PROF_SUB_BITS - 1U;
+    uint32_t v = (1UL << msb) | ((uint32_t)(bucket & PROF_SUB_MASK) << (msb - PROF_SUB_BITS));
+
+    return v << PROF_SHIFT;
+}
+
+#endif /* PROFILER */
@@ -0,0 +1,169 @@
+/*
+ * run_mode.c
+ * Trecerile RUN <-> VLPR si reconfigurarea perifericelor dependente de ceas
+ *
+ * RUN -> VLPR: MCG din PEE in BLPI (IRC rapid, 4 MHz), divizoarele din
+ * simConfig_BOARD_BootClockVLPR, apoi SMC in VLPR.
+ * VLPR -> RUN: SMC in RUN intai (MCG nu poate porni PLL-ul in VLPR), apoi
+ * oscilatorul si MCG inapoi in PEE - relock-ul PLL dureaza cateva sute de us,
+ * cu intreruperile pornite (doar listenerii ruleaza cu ele oprite).
+ *
+ * In VLPR PLL-ul si FLL-ul sunt oprite, deci TPM-urile si UART0 trec pe
+ * MCGIRCLK (4 MHz). PMPROT (write-once) e scris de Power_Init cu AVLP,
+ * care acopera si VLPR.
+ */
+
+#include "headers/run_mode.h"
+#include "headers/st7735_simple.h"
+#include "MKL25Z4.h"
+#include "board.h"
+#include "clock_config.h"
+#include "fsl_smc.h"
+#include "fsl_clock.h"
+#include "fsl_debug_console.h"
+
+/*============================================================================
+ * HARDWARE CONFIGURATION
+ *============================================================================*/
+
+/* SIM_SOPT2[TPMSRC] / [UART0SRC]: 01 = MCGFLLCLK sau MCGPLLCLK/2, 11 = MCGIRCLK */
+#define RUN_MODE_CLKSRC_PLLFLL  1U
+#define RUN_MODE_CLKSRC_IRC     3U
+
+/*============================================================================
+ * GLOBAL VARIABLES
+ *============================================================================*/
+
+static RunModeClocks_t clocks;
+static RunModeListener_t listeners[RUN_MODE_MAX_LISTENERS];
+static uint8_t num_listeners = 0;
+static RunModeStats_t stats;
+static volatile bool switching;     /* Consola oprita, ceasurile in schimbare */
+
+/*============================================================================
+ * PRIVATE FUNCTIONS
+ *============================================================================*/
+
+static void RunMode_EnterVlpr(void) {
+    CLOCK_SetSimSafeDivs();
+    CLOCK_SetMcgConfig(&mcgConfig_BOARD_BootClockVLPR);
+    CLOCK_SetSimConfig(&simConfig_BOARD_BootClockVLPR);
+    CLOCK_DeinitOsc0();
+
+#if (defined(FSL_FEATURE_SMC_HAS_LPWUI) && FSL_FEATURE_SMC_HAS_LPWUI)
+    SMC_SetPowerModeVlpr(SMC, false);
+#else
+    SMC_SetPowerModeVlpr(SMC);
+#endif
+    while (SMC_GetPowerModeState(SMC) != kSMC_PowerStateVlpr) {
+    }
+
+    CLOCK_SetTpmClock(RUN_MODE_CLKSRC_IRC);
+    CLOCK_SetLpsci0Clock(RUN_MODE_CLKSRC_IRC);
+    SystemCoreClock = BOARD_BOOTCLOCKVLPR_CORE_CLOCK;
+}
+
+static void RunMode_EnterRun(void) {
+    SMC_SetPowerModeRun(SMC);
+    while (SMC_GetPowerModeState(SMC) != kSMC_PowerStateRun) {
+    }
+
+    CLOCK_SetSimSafeDivs();
+    CLOCK_InitOsc0(&oscConfig_BOARD_BootClockRUN);
+    CLOCK_SetXtal0Freq(oscConfig_BOARD_BootClockRUN.freq);
+    CLOCK_SetMcgConfig(&mcgConfig_BOARD_BootClockRUN);
+    CLOCK_SetSimConfig(&simConfig_BOARD_BootClockRUN);
+
+    CLOCK_SetTpmClock(RUN_MODE_CLKSRC_PLLFLL);
+    CLOCK_SetLpsci0Clock(RUN_MODE_CLKSRC_PLLFLL);
+    SystemCoreClock = BOARD_BOOTCLOCKRUN_CORE_CLOCK;
+}
+
+static void RunMode_ReadClocks(RunMode_t mode) {
+    uint32_t src = (mode == RUN_MODE_VLPR) ? CLOCK_GetInternalRefClkFreq() : CLOCK_GetPllFllSelClkFreq();
+
+    clocks.mode = mode;
+    clocks.core_hz = CLOCK_GetFreq(kCLOCK_CoreSysClk);
+    clocks.bus_hz = CLOCK_GetFreq(kCLOCK_BusClk);
+    clocks.tpm_hz = src;
+    clocks.uart0_hz = src;
+}
+
+/* Consola e a placii (board.c): acelasi baud, divizorul LPSCI recalculat */
+static void RunMode_ReconfigureConsole(void) {
+    DbgConsole_Init(BOARD_DEBUG_UART_BASEADDR, BOARD_DEBUG_UART_BAUDRATE,
+                    BOARD_DEBUG_UART_TYPE, clocks.uart0_hz);
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+void RunMode_Init(void) {
+    num_listeners = 0;
+    RunMode_ReadClocks(RUN_MODE_RUN);
+}
+
+bool RunMode_AddListener(RunModeListener_t listener) {
+    if (num_listeners >= RUN_MODE_MAX_LISTENERS) return false;
+
+    listeners[num_listeners++] = listener;
+    return true;
+}
+
+void RunMode_Set(RunMode_t mode) {
+    if (mode == clocks.mode) return;
+
+    /* SPI0 si UART0 nu se reconfigureaza in mijlocul unui transfer.
+     * DbgConsole_Deinit asteapta TC cu intreruperile oprite: doar octetii
+     * deja scrisi, nu tot ringul din log.c (ISR-ul UART0 ar scrie altii) */
+    ST7735_WaitIdle();
+
+    __disable_irq();
+    DbgConsole_Deinit();
+    switching = true;
+    __enable_irq();
+
+    /* Relock-ul PLL (sute de us) cu intreruperile pornite: ISR-urile vad
+     * ceasurile vechi pana la listeneri, iar log.c nu atinge UART0 */
+    if (mode == RUN_MODE_VLPR) {
+        RunMode_EnterVlpr();
+        stats.to_vlpr++;
+    } else {
+        RunMode_EnterRun();
+        stats.to_run++;
+    }
+
+    __disable_irq();
+    RunMode_ReadClocks(mode);
+    RunMode_ReconfigureConsole();
+    switching = false;
+    for (uint8_t i = 0; i < num_listeners; i++) {
+        listeners[i](&clocks);
+    }
+    __enable_irq();
+}
+
+void RunMode_Update(bool full_speed) {
+    if (full_speed) {
+        RunMode_Set(RUN_MODE_RUN);
+    } else if (!ST7735_IsBusy()) {
+        RunMode_Set(RUN_MODE_VLPR);
+    }
+}
+
+RunMode_t RunMode_Get(void) {
+    return clocks.mode;
+}
+
+bool RunMode_IsSwitching(void) {
+    return switching;
+}
+
+const RunModeClocks_t* RunMode_GetClocks(void) {
+    return &clocks;
+}
+
+void RunMode_GetStats(RunModeStats_t* out) {
+    *out = stats;
+}
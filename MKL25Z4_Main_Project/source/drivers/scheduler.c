@@ -0,0 +1,211 @@
+/*
+ * scheduler.c
+ * Scheduler cooperativ cu prioritati, deadline-uri si statistici
+ *
+ * Timpul vine din g_systick_ms (activari) si din SysTick->VAL
+ * (durata rularilor, la rezolutie de microsecunde). In idle, somnul e
+ * limitat la urmatoarea activare, ca LPTMR-ul sa poata inlocui SysTick.
+ */
+
+#include "headers/scheduler.h"
+#include "headers/power.h"
+#include "MKL25Z4.h"
+#include "fsl_debug_console.h"
+#include <stddef.h>
+
+/*============================================================================
+ * GLOBAL VARIABLES
+ *============================================================================*/
+
+static Task_t* tasks[SCHED_MAX_TASKS];
+static uint8_t num_tasks = 0;
+static uint32_t idle_count = 0;
+
+/* Extern: timer global din main */
+extern volatile uint32_t g_systick_ms;
+
+/*============================================================================
+ * PRIVATE FUNCTIONS
+ *============================================================================*/
+
+/* Task gata: notificat sau cu activarea periodica ajunsa */
+static bool Scheduler_IsDue(const Task_t* t, uint32_t now) {
+    return t->period_ms && (int32_t)(now - t->release_ms) >= 0;
+}
+
+static bool Scheduler_IsReady(const Task_t* t, uint32_t now) {
+    return t->enabled && (t->notified || Scheduler_IsDue(t, now));
+}
+
+/* Task-urile doar notificate nu au perioada - deadline-ul lor e "acum" */
+static uint32_t Scheduler_Deadline(const Task_t* t, uint32_t now) {
+    return t->period_ms ? t->release_ms + t->period_ms : now;
+}
+
+static Task_t* Scheduler_PickNext(uint32_t now) {
+    Task_t* best = NULL;
+
+    for (uint8_t i = 0; i < num_tasks; i++) {
+        Task_t* t = tasks[i];
+        if (!Scheduler_IsReady(t, now)) continue;
+
+        if (best == NULL || t->priority < best->priority ||
+            (t->priority == best->priority &&
+             (int32_t)(Scheduler_Deadline(t, now) - Scheduler_Deadline(best, now)) < 0)) {
+            best = t;
+        }
+    }
+
+    return best;
+}
+
+/* Milisecunde pana la urmatoarea activare periodica (task-uri pornite) */
+static uint32_t Scheduler_MsUntilNext(uint32_t now) {
+    uint32_t next = POWER_MAX_SLEEP_MS;
+
+    for (uint8_t i = 0; i < num_tasks; i++) {
+        const Task_t* t = tasks[i];
+        if (!t->enabled || !t->period_ms) continue;
+
+        int32_t left = (int32_t)(t->release_ms - now);
+        if (left <= 0) return 0;
+        if ((uint32_t)left < next) next = (uint32_t)left;
+    }
+
+    return next;
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+void Scheduler_Init(void) {
+    num_tasks = 0;
+    idle_count = 0;
+}
+
+bool Scheduler_Add(Task_t* task, bool enabled) {
+    if (num_tasks >= SCHED_MAX_TASKS) return false;
+
+    task->runs = 0;
+    task->overruns = 0;
+    task->wcet_us = 0;
+    task->total_us = 0;
+    task->notified = false;
+    tasks[num_tasks++] = task;
+
+    Scheduler_SetEnabled(task, enabled);
+    return true;
+}
+
+void Scheduler_SetEnabled(Task_t* task, bool enabled) {
+    if (enabled && !task->enabled) {
+        task->release_ms = g_systick_ms;
+    }
+    task->enabled = enabled;
+}
+
+void Scheduler_SetPeriod(Task_t* task, uint16_t period_ms) {
+    task->period_ms = period_ms;
+}
+
+void Scheduler_Notify(Task_t* task) {
+    task->notified = true;
+}
+
+bool Scheduler_RunOnce(void) {
+    uint32_t now = g_systick_ms;
+    Task_t* t = Scheduler_PickNext(now);
+
+    if (t == NULL) return false;
+
+    bool due = Scheduler_IsDue(t, now);
+    t->notified = false;
+
+    uint32_t start = Scheduler_NowUs();
+    t->run();
+    uint32_t elapsed = Scheduler_NowUs() - start;
+
+    t->runs++;
+    t->total_us += elapsed;
+    if (elapsed > t->wcet_us) t->wcet_us = elapsed;
+
+    /* Urmatoarea activare; un task intarziat nu recupereaza in rafala */
+    if (due) {
+        uint32_t end = g_systick_ms;
+        uint32_t deadline = t->release_ms + t->period_ms;
+
+        if ((int32_t)(end - deadline) > 0) {
+            t->overruns++;
+            t->release_ms = end;
+        } else {
+            t->release_ms = deadline;
+        }
+    }
+
+    return true;
+}
+
+void Scheduler_Idle(void) {
+    /* Cu intreruperile oprite, un ISR venit dupa verificare tot trezeste __WFI */
+    __disable_irq();
+    uint32_t now = g_systick_ms;
+    if (Scheduler_PickNext(now) == NULL) {
+        idle_count++;
+        Power_Sleep(Scheduler_MsUntilNext(now));
+    }
+    __enable_irq();
+}
+
+void Scheduler_Run(void) {
+    while (1) {
+        if (!Scheduler_RunOnce()) {
+            Scheduler_Idle();
+        }
+    }
+}
+
+uint32_t Scheduler_ReadTick(uint32_t* ticks) {
+    uint32_t ms, val;
+    bool pending;
+
+    /* Recitim daca SysTick a trecut la alta milisecunda intre citiri */
+    do {
+        ms = g_systick_ms;
+        val = SysTick->VAL;
+        /* VAL s-a reincarcat, dar ISR-ul SysTick n-a rulat inca (IRQ-uri
+         * oprite sau apel din alt ISR): g_systick_ms e cu 1 ms in urma, iar
+         * VAL recitit e sigur de dupa reincarcare */
+        pending = (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0U;
+        if (pending) val = SysTick->VAL;
+    } while (ms != g_systick_ms);
+
+    *ticks = SysTick->LOAD - val;
+    return pending ? ms + 1U : ms;
+}
+
+uint32_t Scheduler_NowUs(void) {
+    uint32_t ticks;
+    uint32_t ms = Scheduler_ReadTick(&ticks);
+
+    return ms * 1000U + ticks / (SystemCoreClock / 1000000U);
+}
+
+uint32_t Scheduler_GetIdleCount(void) {
+    return idle_count;
+}
+
+const Task_t* Scheduler_GetTask(uint8_t index) {
+    return (index < num_tasks) ? tasks[index] : NULL;
+}
+
+void Scheduler_PrintStats(void) {
+    PRINTF("[SCHED] task      runs  overruns  wcet_us  total_ms\r\n");
+    for (uint8_t i = 0; i < num_tasks; i++) {
+        const Task_t* t = tasks[i];
+        PRINTF("[SCHED] %-8s %6u %9u %8u %9u\r\n", t->name,
+               (unsigned int)t->runs, (unsigned int)t->overruns,
+               (unsigned int)t->wcet_us, (unsigned int)(t->total_us / 1000U));
+    }
+    PRINTF("[SCHED] idle: %u\r\n", (unsigned int)idle_count);
+}
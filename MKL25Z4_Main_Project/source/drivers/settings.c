@@ -0,0 +1,122 @@
+/*
+ * settings.c
+ * Cheile din kv_store pentru setari si rezultate
+ *
+ * Fiecare grup e o cheie separata, ca o schimbare de dificultate sa nu
+ * rescrie si rezultatele. Settings_Changed compara variabilele globale cu
+ * ultimele valori incarcate sau salvate: la un flash gol valorile implicite
+ * nu sunt scrise, doar prima schimbare facuta din meniu.
+ */
+
+#include "headers/settings.h"
+#include "headers/kv_store.h"
+#include "headers/game_config.h"
+#include "headers/log.h"
+#include "fsl_debug_console.h"
+#include <string.h>
+
+/*============================================================================
+ * KEYS
+ *============================================================================*/
+
+#define SETTINGS_KEY_INPUTS     0U      /* { g_player1_input, g_player2_input } */
+#define SETTINGS_KEY_DIFFICULTY 1U      /* { g_currentDifficulty } */
+#define SETTINGS_KEY_RESULTS    2U      /* SettingsResults_t */
+
+typedef char settings_results_fit[(sizeof(SettingsResults_t) <= KV_VALUE_MAX) ? 1 : -1];
+
+/*============================================================================
+ * GLOBAL VARIABLES
+ *============================================================================*/
+
+static SettingsResults_t results;
+static uint8_t saved_inputs[2];
+static uint8_t saved_difficulty;
+
+/*============================================================================
+ * PRIVATE FUNCTIONS
+ *============================================================================*/
+
+static bool Settings_ValidInput(uint8_t input) {
+    return input <= INPUT_CPU_HARD && input != INPUT_GYROSCOPE;
+}
+
+static void Settings_Snapshot(void) {
+    saved_inputs[0] = (uint8_t)g_player1_input;
+    saved_inputs[1] = (uint8_t)g_player2_input;
+    saved_difficulty = (uint8_t)g_currentDifficulty;
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+void Settings_Init(void) {
+    uint8_t inputs[2];
+    uint8_t difficulty;
+
+    memset(&results, 0, sizeof(results));
+    if (!KvStore_Init()) {
+        Settings_Snapshot();
+        LOG_BOOT("[Settings] Store empty, using defaults\r\n");
+        return;
+    }
+
+    if (KvStore_Get(SETTINGS_KEY_INPUTS, inputs, sizeof(inputs)) == sizeof(inputs) &&
+        Settings_ValidInput(inputs[0]) && Settings_ValidInput(inputs[1])) {
+        g_player1_input = (InputType_t)inputs[0];
+        g_player2_input = (InputType_t)inputs[1];
+    }
+    if (KvStore_Get(SETTINGS_KEY_DIFFICULTY, &difficulty, 1U) == 1U && difficulty <= DIFF_HARD) {
+        g_currentDifficulty = (Difficulty_t)difficulty;
+    }
+    if (KvStore_Get(SETTINGS_KEY_RESULTS, &results, sizeof(results)) != sizeof(results)) {
+        memset(&results, 0, sizeof(results));
+    }
+    Settings_Snapshot();
+
+    LOG_BOOT("[Settings] P1 input %u, P2 input %u, difficulty %u\r\n",
+             g_player1_input, g_player2_input, g_currentDifficulty);
+    LOG_BOOT("[Settings] %u matches (P1 %u - P2 %u)\r\n",
+             results.matches, results.wins[0], results.wins[1]);
+}
+
+void Settings_RecordMatch(uint8_t winner, uint8_t score1, uint8_t score2) {
+    if (winner != 1U && winner != 2U) return;
+
+    if (results.matches < UINT16_MAX) results.matches++;
+    if (results.wins[winner - 1U] < UINT16_MAX) results.wins[winner - 1U]++;
+    results.last_winner = winner;
+    results.last_score[0] = score1;
+    results.last_score[1] = score2;
+    KvStore_Set(SETTINGS_KEY_RESULTS, &results, sizeof(results));
+}
+
+void Settings_GetResults(SettingsResults_t* out) {
+    *out = results;
+}
+
+bool Settings_Changed(void) {
+    bool inputs = saved_inputs[0] != (uint8_t)g_player1_input ||
+                  saved_inputs[1] != (uint8_t)g_player2_input;
+    bool difficulty = saved_difficulty != (uint8_t)g_currentDifficulty;
+
+    Settings_Snapshot();
+    if (inputs) {
+        KvStore_Set(SETTINGS_KEY_INPUTS, saved_inputs, sizeof(saved_inputs));
+    }
+    if (difficulty) {
+        KvStore_Set(SETTINGS_KEY_DIFFICULTY, &saved_difficulty, 1U);
+    }
+    return KvStore_IsDirty();
+}
+
+bool Settings_Flush(void) {
+    if (!Settings_Changed()) return true;
+
+    bool ok = KvStore_Flush();
+    if (!ok) {
+        LOG("[Settings] Flash write failed\r\n");
+    }
+    return ok;
+}
@@ -0,0 +1,95 @@
+/*
+ * song.c
+ * Player-ul formatului binar din song.h
+ *
+ * Nu atinge hardware-ul: audio.c il avanseaza din intreruperea de nota,
+ * iar pe host host/songc il foloseste ca sa verifice ce a compilat.
+ */
+
+#include "headers/song.h"
+#include <stddef.h>
+
+/*============================================================================
+ * PRIVATE FUNCTIONS
+ *============================================================================*/
+
+/* Perioadele sunt citite pe octeti: tabelul poate fi nealiniat */
+static uint16_t Song_Period(const SongPlayer_t* p, uint8_t index) {
+    const uint8_t* entry = &p->song[SONG_HEADER_BYTES + 2U * index];
+    return (uint16_t)(entry[0] | (entry[1] << 8));
+}
+
+/* @return false la END */
+static bool Song_Command(SongPlayer_t* p, uint8_t cmd) {
+    switch (cmd) {
+        case SONG_CMD_TEMPO:
+            p->tick_ms = *p->pc++;
+            break;
+
+        case SONG_CMD_LEN:
+            p->ticks = *p->pc++;
+            break;
+
+        case SONG_CMD_LOOP:
+            if (p->depth < SONG_MAX_LOOPS) {
+                p->loops[p->depth].left = *p->pc++;
+                p->loops[p->depth].start = p->pc;
+                p->depth++;
+            } else {
+                p->pc++;
+            }
+            break;
+
+        case SONG_CMD_ENDLOOP:
+            if (p->depth > 0) {
+                if (p->loops[p->depth - 1].left > 1) {
+                    p->loops[p->depth - 1].left--;
+                    p->pc = p->loops[p->depth - 1].start;
+                } else {
+                    p->depth--;
+                }
+            }
+            break;
+
+        default:
+            return false;
+    }
+    return true;
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+void Song_Start(SongPlayer_t* p, const uint8_t* song) {
+    p->song = song;
+    p->pc = song + SONG_HEADER_BYTES + 2U * song[0];
+    p->tick_ms = song[1];
+    p->ticks = 1;
+    p->depth = 0;
+}
+
+bool Song_Next(SongPlayer_t* p, SongNote_t* out) {
+    if (p->song == NULL) return false;
+
+    for (;;) {
+        uint8_t ev = *p->pc++;
+        uint8_t pitch = SONG_EVENT_PITCH(ev);
+        uint8_t dur = SONG_EVENT_DUR(ev);
+
+        if (pitch == SONG_PITCH_CMD) {
+            if (!Song_Command(p, dur)) {
+                p->pc--;    /* Ramane pe END */
+                return false;
+            }
+            continue;
+        }
+
+        if (dur != 0) {
+            p->ticks = (uint8_t)(1U << (dur - 1U));
+        }
+        out->period = (pitch == SONG_PITCH_REST) ? 0 : Song_Period(p, pitch);
+        out->ms = (uint16_t)(p->ticks * p->tick_ms);
+        return true;
+    }
+}
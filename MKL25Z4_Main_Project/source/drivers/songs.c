@@ -0,0 +1,33 @@
+/*
+ * songs.c
+ * Generat de host/songc din songs/<nume>.song - nu se editeaza manual
+ */
+
+#include "headers/songs.h"
+
+/* game_over: 7 note, 23 octeti */
+const uint8_t song_game_over[23] = {
+    0x04, 0x28, 0xE5, 0x1D, 0x8D, 0x23, 0xCB, 0x2C, 0x96, 0x59, 0xFB, 0x02,
+    0xFA, 0x03, 0x00, 0x08, 0xFC, 0xF9, 0x3C, 0x10, 0xF1, 0x1C, 0xF8
+};
+
+/* goal: 3 note, 12 octeti */
+const uint8_t song_goal[12] = {
+    0x03, 0x0A, 0xCB, 0x2C, 0xCA, 0x3B, 0x96, 0x59, 0x04, 0x08, 0x15, 0xF8
+};
+
+/* paddle: 1 note, 6 octeti */
+const uint8_t song_paddle[6] = {
+    0x01, 0x0F, 0xA2, 0x1A, 0x02, 0xF8
+};
+
+/* speed_up: 4 note, 15 octeti */
+const uint8_t song_speed_up[15] = {
+    0x04, 0x19, 0xCB, 0x2C, 0x8D, 0x23, 0xE5, 0x1D, 0x65, 0x16, 0x02, 0x08,
+    0x10, 0x1B, 0xF8
+};
+
+/* wall: 1 note, 6 octeti */
+const uint8_t song_wall[6] = {
+    0x01, 0x0A, 0x44, 0x35, 0x02, 0xF8
+};
@@ -1,4 +1,6 @@
 #include "headers/st7735_simple.h"
+#include "headers/run_mode.h"
+#include "headers/profiler.h"
 #include "fsl_spi.h"
 #include "fsl_gpio.h"
 #include "fsl_port.h"
@@ -13,48 +15,49 @@
  * RES  -> PTC0
  */
 
+/* Contoare de trafic SPI (doar pentru benchmark, -DST7735_STATS) */
+#ifdef ST7735_STATS
+static ST7735_Stats_t stats;
+#define STATS_ADD(field, n)  (stats.field += (n))
+#else
+#define STATS_ADD(field, n)  ((void)0)
+#endif
+
 /* Pin macros - acces direct la registre pentru viteza maxima */
-#define CS_LOW()     (GPIOC->PCOR = (1U << 4))
+#define CS_LOW()     do { GPIOC->PCOR = (1U << 4); STATS_ADD(cs_toggles, 1); } while (0)
 #define CS_HIGH()    (GPIOC->PSOR = (1U << 4))
 #define DC_LOW()     (GPIOC->PCOR = (1U << 3))
 #define DC_HIGH()    (GPIOC->PSOR = (1U << 3))
 #define RST_LOW()    (GPIOC->PCOR = (1U << 0))
 #define RST_HIGH()   (GPIOC->PSOR = (1U << 0))
 
-/* 5x7 Font */
-static const uint8_t font5x7[] = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5F, 0x00, 0x00, 0x00, 0x07, 0x00, 0x07, 0x00,
-    0x14, 0x7F, 0x14, 0x7F, 0x14, 0x24, 0x2A, 0x7F, 0x2A, 0x12, 0x23, 0x13, 0x08, 0x64, 0x62,
-    0x36, 0x49, 0x55, 0x22, 0x50, 0x00, 0x05, 0x03, 0x00, 0x00, 0x00, 0x1C, 0x22, 0x41, 0x00,
-    0x00, 0x41, 0x22, 0x1C, 0x00, 0x14, 0x08, 0x3E, 0x08, 0x14, 0x08, 0x08, 0x3E, 0x08, 0x08,
-    0x00, 0x50, 0x30, 0x00, 0x00, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00, 0x60, 0x60, 0x00, 0x00,
-    0x20, 0x10, 0x08, 0x04, 0x02, 0x3E, 0x51, 0x49, 0x45, 0x3E, 0x00, 0x42, 0x7F, 0x40, 0x00,
-    0x42, 0x61, 0x51, 0x49, 0x46, 0x21, 0x41, 0x45, 0x4B, 0x31, 0x18, 0x14, 0x12, 0x7F, 0x10,
-    0x27, 0x45, 0x45, 0x45, 0x39, 0x3C, 0x4A, 0x49, 0x49, 0x30, 0x01, 0x71, 0x09, 0x05, 0x03,
-    0x36, 0x49, 0x49, 0x49, 0x36, 0x06, 0x49, 0x49, 0x29, 0x1E, 0x00, 0x36, 0x36, 0x00, 0x00,
-    0x00, 0x56, 0x36, 0x00, 0x00, 0x08, 0x14, 0x22, 0x41, 0x00, 0x14, 0x14, 0x14, 0x14, 0x14,
-    0x00, 0x41, 0x22, 0x14, 0x08, 0x02, 0x01, 0x51, 0x09, 0x06, 0x32, 0x49, 0x79, 0x41, 0x3E,
-    0x7E, 0x11, 0x11, 0x11, 0x7E, 0x7F, 0x49, 0x49, 0x49, 0x36, 0x3E, 0x41, 0x41, 0x41, 0x22,
-    0x7F, 0x41, 0x41, 0x22, 0x1C, 0x7F, 0x49, 0x49, 0x49, 0x41, 0x7F, 0x09, 0x09, 0x09, 0x01,
-    0x3E, 0x41, 0x49, 0x49, 0x7A, 0x7F, 0x08, 0x08, 0x08, 0x7F, 0x00, 0x41, 0x7F, 0x41, 0x00,
-    0x20, 0x40, 0x41, 0x3F, 0x01, 0x7F, 0x08, 0x14, 0x22, 0x41, 0x7F, 0x40, 0x40, 0x40, 0x40,
-    0x7F, 0x02, 0x0C, 0x02, 0x7F, 0x7F, 0x04, 0x08, 0x10, 0x7F, 0x3E, 0x41, 0x41, 0x41, 0x3E,
-    0x7F, 0x09, 0x09, 0x09, 0x06, 0x3E, 0x41, 0x51, 0x21, 0x5E, 0x7F, 0x09, 0x19, 0x29, 0x46,
-    0x46, 0x49, 0x49, 0x49, 0x31, 0x01, 0x01, 0x7F, 0x01, 0x01, 0x3F, 0x40, 0x40, 0x40, 0x3F,
-    0x1F, 0x20, 0x40, 0x20, 0x1F, 0x3F, 0x40, 0x38, 0x40, 0x3F, 0x63, 0x14, 0x08, 0x14, 0x63,
-    0x07, 0x08, 0x70, 0x08, 0x07, 0x61, 0x51, 0x49, 0x45, 0x43, 0x00, 0x7F, 0x41, 0x41, 0x00,
-    0x02, 0x04, 0x08, 0x10, 0x20, 0x00, 0x41, 0x41, 0x7F, 0x00, 0x04, 0x02, 0x01, 0x02, 0x04,
-    0x40, 0x40, 0x40, 0x40, 0x40, 0x00, 0x01, 0x02, 0x04, 0x00, 0x20, 0x54, 0x54, 0x54, 0x78,
-    0x7F, 0x48, 0x44, 0x44, 0x38, 0x38, 0x44, 0x44, 0x44, 0x20, 0x38, 0x44, 0x44, 0x48, 0x7F,
-    0x38, 0x54, 0x54, 0x54, 0x18, 0x08, 0x7E, 0x09, 0x01, 0x02, 0x0C, 0x52, 0x52, 0x52, 0x3E,
-    0x7F, 0x08, 0x04, 0x04, 0x78, 0x00, 0x44, 0x7D, 0x40, 0x00, 0x20, 0x40, 0x44, 0x3D, 0x00,
-    0x7F, 0x10, 0x28, 0x44, 0x00, 0x00, 0x41, 0x7F, 0x40, 0x00, 0x7C, 0x04, 0x18, 0x04, 0x78,
-    0x7C, 0x08, 0x04, 0x04, 0x78, 0x38, 0x44, 0x44, 0x44, 0x38, 0x7C, 0x14, 0x14, 0x14, 0x08,
-    0x08, 0x14, 0x14, 0x18, 0x7C, 0x7C, 0x08, 0x04, 0x04, 0x08, 0x48, 0x54, 0x54, 0x54, 0x20,
-    0x04, 0x3F, 0x44, 0x40, 0x20, 0x3C, 0x40, 0x40, 0x20, 0x7C, 0x1C, 0x20, 0x40, 0x20, 0x1C,
-    0x3C, 0x40, 0x30, 0x40, 0x3C, 0x44, 0x28, 0x10, 0x28, 0x44, 0x0C, 0x50, 0x50, 0x50, 0x3C,
-    0x44, 0x64, 0x54, 0x4C, 0x44
-};
+/* DMA: canalul TX alimenteaza SPI0->D, canalul RX goleste SPI0->D.
+ * Terminarea canalului RX garanteaza ca ultimul octet a iesit fizic pe fir,
+ * deci CS poate fi ridicat direct din intrerupere. */
+#define LCD_DMA_TX_CH   0U
+#define LCD_DMA_RX_CH   1U
+#define LCD_DMA_RX_IRQ  DMA1_IRQn
+
+/* Cerut de la SPI0; in VLPR (bus 800 kHz) iese cel mult 400 kHz */
+#define LCD_SPI_BAUD    12000000U
+
+typedef struct {
+    const uint8_t *src;         /* NULL = umplere cu culoare fixa */
+    uint32_t len;               /* Numar de octeti */
+    ST7735_DoneCallback_t cb;
+    void *ctx;
+    uint16_t color;
+    uint8_t x0, y0, x1, y1;
+} LcdTransfer_t;
+
+static LcdTransfer_t dma_queue[ST7735_DMA_QUEUE_DEPTH];
+static volatile uint8_t dma_head = 0;
+static volatile uint8_t dma_tail = 0;
+static volatile bool dma_busy = false;
+
+/* Buffer circular de 16 octeti (SMOD=1) pentru umplere - trebuie aliniat */
+static uint8_t fill_pattern[16] __attribute__((aligned(16)));
+static volatile uint8_t rx_dummy;
 
 static void delay_ms(uint32_t ms) {
     for (uint32_t i = 0; i < ms * 6000; i++) __asm volatile("nop");
@@ -73,17 +76,25 @@ static inline void SPI_WriteByteFast(uint8_t data) {
 
     /* 4. Citește datele primite (dummy) pentru a curăța flag-ul */
     (void)SPI0->D;
+    STATS_ADD(bytes, 1);
 }
 
-/* SPI Write pentru mai multi bytes - fara overhead */
-static inline void SPI_WriteDataFast(uint8_t *data, uint32_t len) {
+/* SPI Write pentru mai multi bytes - pipeline, asteapta doar loc in TX */
+static inline void SPI_WriteDataFast(const uint8_t *data, uint32_t len) {
+    STATS_ADD(bytes, len);
     while (len--) {
+        while (!(SPI0->S & SPI_S_SPTEF_MASK));
         SPI0->D = *data++;
-        while (!(SPI0->S & SPI_S_SPRF_MASK));
-        (void)SPI0->D;
     }
 }
 
+/* Asteapta ca ultimul octet din pipeline sa iasa pe fir */
+static inline void SPI_Drain(void) {
+    while (!(SPI0->S & SPI_S_SPTEF_MASK));
+    while (!(SPI0->S & SPI_S_SPRF_MASK));
+    (void)SPI0->D;
+}
+
 static void WriteCommand(uint8_t cmd) {
     DC_LOW();
     CS_LOW();
@@ -100,6 +111,7 @@ static void WriteData(uint8_t data) {
 
 /* SetWindow optimizat - mai putine CS toggles */
 static void SetWindow(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1) {
+    STATS_ADD(windows, 1);
     DC_LOW();
     CS_LOW();
     SPI_WriteByteFast(ST7735_CASET);
@@ -122,6 +134,109 @@ static void SetWindow(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1) {
     CS_HIGH();
 }
 
+/*============================================================================
+ * DMA TRANSFER ENGINE
+ *============================================================================*/
+
+/* Porneste urmatorul transfer din coada (din intrerupere sau cu LCD_DMA_RX_IRQ mascat) */
+static void DMA_StartNext(void) {
+    if (dma_tail == dma_head) {
+        dma_busy = false;
+        PROF_SPAN_END(PROF_SPI);
+        PROF_LATENCY_DONE();
+        return;
+    }
+
+    LcdTransfer_t *t = &dma_queue[dma_tail];
+    uint32_t src_cfg;
+    dma_busy = true;
+
+    SetWindow(t->x0, t->y0, t->x1, t->y1);
+
+    if (t->src == NULL) {
+        for (uint8_t i = 0; i < sizeof(fill_pattern); i += 2) {
+            fill_pattern[i] = t->color >> 8;
+            fill_pattern[i + 1] = t->color & 0xFF;
+        }
+        DMA0->DMA[LCD_DMA_TX_CH].SAR = (uint32_t)fill_pattern;
+        src_cfg = DMA_DCR_SINC_MASK | DMA_DCR_SMOD(1);
+    } else {
+        DMA0->DMA[LCD_DMA_TX_CH].SAR = (uint32_t)t->src;
+        src_cfg = DMA_DCR_SINC_MASK;
+    }
+
+    /* TX: memorie -> SPI0->D, 8 biti, cate un octet per cerere SPTEF */
+    STATS_ADD(bytes, t->len);
+    DMA0->DMA[LCD_DMA_TX_CH].DAR = (uint32_t)&SPI0->D;
+    DMA0->DMA[LCD_DMA_TX_CH].DSR_BCR = DMA_DSR_BCR_BCR(t->len);
+    DMA0->DMA[LCD_DMA_TX_CH].DCR = DMA_DCR_ERQ_MASK | DMA_DCR_CS_MASK | DMA_DCR_D_REQ_MASK |
+                                   DMA_DCR_SSIZE(1) | DMA_DCR_DSIZE(1) | src_cfg;
+
+    /* RX: SPI0->D -> dummy, intrerupere la final */
+    DMA0->DMA[LCD_DMA_RX_CH].SAR = (uint32_t)&SPI0->D;
+    DMA0->DMA[LCD_DMA_RX_CH].DAR = (uint32_t)&rx_dummy;
+    DMA0->DMA[LCD_DMA_RX_CH].DSR_BCR = DMA_DSR_BCR_BCR(t->len);
+    DMA0->DMA[LCD_DMA_RX_CH].DCR = DMA_DCR_EINT_MASK | DMA_DCR_ERQ_MASK | DMA_DCR_CS_MASK |
+                                   DMA_DCR_D_REQ_MASK | DMA_DCR_SSIZE(1) | DMA_DCR_DSIZE(1);
+
+    DC_HIGH();
+    CS_LOW();
+    SPI0->C2 |= SPI_C2_RXDMAE_MASK | SPI_C2_TXDMAE_MASK;
+}
+
+void DMA1_IRQHandler(void) {
+    DMA0->DMA[LCD_DMA_RX_CH].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+    DMA0->DMA[LCD_DMA_TX_CH].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+    SPI0->C2 &= ~(SPI_C2_RXDMAE_MASK | SPI_C2_TXDMAE_MASK);
+    CS_HIGH();
+
+    ST7735_DoneCallback_t cb = dma_queue[dma_tail].cb;
+    void *ctx = dma_queue[dma_tail].ctx;
+    dma_tail = (dma_tail + 1) % ST7735_DMA_QUEUE_DEPTH;
+
+    if (cb) cb(ctx);
+    DMA_StartNext();
+}
+
+static void DMA_Enqueue(const LcdTransfer_t *t) {
+    uint8_t next = (dma_head + 1) % ST7735_DMA_QUEUE_DEPTH;
+
+    /* Coada plina - asteptam ca DMA1_IRQHandler sa termine un transfer
+     * (blocaj daca intreruperea nu poate rula: IRQ-uri mascate sau apel
+     * dintr-un ISR de aceeasi prioritate) */
+    while (next == dma_tail) {
+        __NOP();
+    }
+
+    dma_queue[dma_head] = *t;
+
+    DisableIRQ(LCD_DMA_RX_IRQ);
+    dma_head = next;
+    if (!dma_busy) DMA_StartNext();
+    EnableIRQ(LCD_DMA_RX_IRQ);
+}
+
+static void DMA_Init(void) {
+    CLOCK_EnableClock(kCLOCK_Dmamux0);
+    CLOCK_EnableClock(kCLOCK_Dma0);
+
+    DMAMUX0->CHCFG[LCD_DMA_TX_CH] = 0;
+    DMAMUX0->CHCFG[LCD_DMA_RX_CH] = 0;
+    DMAMUX0->CHCFG[LCD_DMA_TX_CH] = DMAMUX_CHCFG_ENBL_MASK |
+                                    DMAMUX_CHCFG_SOURCE(kDmaRequestMux0SPI0Tx & 0xFF);
+    DMAMUX0->CHCFG[LCD_DMA_RX_CH] = DMAMUX_CHCFG_ENBL_MASK |
+                                    DMAMUX_CHCFG_SOURCE(kDmaRequestMux0SPI0Rx & 0xFF);
+
+    NVIC_SetPriority(LCD_DMA_RX_IRQ, 2);
+    EnableIRQ(LCD_DMA_RX_IRQ);
+}
+
+/* Bus-ul s-a schimbat (RUN <-> VLPR): acelasi baud cerut, alt divizor.
+ * RunMode_Set asteapta coada DMA, deci niciun transfer nu e in curs. */
+static void ST7735_OnRunMode(const RunModeClocks_t* clocks) {
+    SPI_MasterSetBaudRate(SPI0, LCD_SPI_BAUD, clocks->bus_hz);
+}
+
 void ST7735_Init(void) {
     spi_master_config_t spiConfig;
     gpio_pin_config_t gpioConfig = {kGPIO_DigitalOutput, 1};
@@ -146,13 +261,16 @@ void ST7735_Init(void) {
     /* Configure SPI0 - viteza rapida pentru afisare fluida */
     SPI_MasterGetDefaultConfig(&spiConfig);
 //    spiConfig.baudRate_Bps = 4000000U;  /* 4 MHz - rapid! */
-    spiConfig.baudRate_Bps = 12000000U; /*12 MHz */
+    spiConfig.baudRate_Bps = LCD_SPI_BAUD; /*12 MHz */
     spiConfig.polarity = kSPI_ClockPolarityActiveHigh;  /* CPOL=0 */
     spiConfig.phase = kSPI_ClockPhaseFirstEdge;         /* CPHA=0 */
     spiConfig.direction = kSPI_MsbFirst;
 
     SPI_MasterInit(SPI0, &spiConfig, CLOCK_GetFreq(kCLOCK_BusClk));
     SPI_Enable(SPI0, true);
+    RunMode_AddListener(ST7735_OnRunMode);
+
+    DMA_Init();
 
     /* Reset display - LONGER delays for slow displays */
     RST_HIGH(); delay_ms(20);
@@ -247,12 +365,14 @@ void ST7735_Init(void) {
     delay_ms(200);
 }
 
+/* Umplerea ecranului merge pe DMA - urmatorul apel sincron asteapta finalul */
 void ST7735_FillScreen(uint16_t color) {
-    ST7735_FillRect(0, 0, ST7735_WIDTH, ST7735_HEIGHT, color);
+    ST7735_FillRectAsync(0, 0, ST7735_WIDTH, ST7735_HEIGHT, color, NULL, NULL);
 }
 
 void ST7735_DrawPixel(int16_t x, int16_t y, uint16_t color) {
     if (x < 0 || x >= ST7735_WIDTH || y < 0 || y >= ST7735_HEIGHT) return;
+    ST7735_WaitIdle();
     SetWindow(x, y, x, y);
     DC_HIGH();
     CS_LOW();
@@ -269,6 +389,7 @@ void ST7735_FillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
     if (y + h > ST7735_HEIGHT) h = ST7735_HEIGHT - y;
     if (w <= 0 || h <= 0) return;
 
+    ST7735_WaitIdle();
     SetWindow(x, y, x + w - 1, y + h - 1);
 
     /* Pregătim cei doi bytes de culoare */
@@ -279,6 +400,8 @@ void ST7735_FillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
     DC_HIGH();
     CS_LOW();
 
+    STATS_ADD(bytes, pixels * 2);
+
     /* --- TURBO MODE: Pipeline Loop --- */
     /* Nu așteptăm răspunsul (RX) pentru fiecare byte, doar verificăm dacă avem loc în TX */
 
@@ -293,9 +416,7 @@ void ST7735_FillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
     }
 
     /* La final, așteptăm ca TOTUL să fie trimis fizic înainte să ridicăm CS */
-    while(!(SPI0->S & SPI_S_SPTEF_MASK)); // Buffer gol
-    while(!(SPI0->S & SPI_S_SPRF_MASK));  // Transmisie completă
-    (void)SPI0->D; // Curățăm flag-ul
+    SPI_Drain();
 
     CS_HIGH();
 }
@@ -307,11 +428,13 @@ void ST7735_DrawHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
     if (x + w > ST7735_WIDTH) w = ST7735_WIDTH - x;
     if (w <= 0) return;
 
+    ST7735_WaitIdle();
     SetWindow(x, y, x + w - 1, y);
     uint8_t hi = color >> 8, lo = color & 0xFF;
 
     DC_HIGH();
     CS_LOW();
+    STATS_ADD(bytes, w * 2);
     while (w--) {
         SPI0->D = hi;
         while (!(SPI0->S & SPI_S_SPRF_MASK));
@@ -330,11 +453,13 @@ void ST7735_DrawVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
     if (y + h > ST7735_HEIGHT) h = ST7735_HEIGHT - y;
     if (h <= 0) return;
 
+    ST7735_WaitIdle();
     SetWindow(x, y, x, y + h - 1);
     uint8_t hi = color >> 8, lo = color & 0xFF;
 
     DC_HIGH();
     CS_LOW();
+    STATS_ADD(bytes, h * 2);
     while (h--) {
         SPI0->D = hi;
         while (!(SPI0->S & SPI_S_SPRF_MASK));
@@ -346,6 +471,56 @@ void ST7735_DrawVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
     CS_HIGH();
 }
 
+/* Umplere asincrona - clipping identic cu ST7735_FillRect */
+bool ST7735_FillRectAsync(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color,
+                          ST7735_DoneCallback_t cb, void *ctx) {
+    if (x >= ST7735_WIDTH || y >= ST7735_HEIGHT) return false;
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > ST7735_WIDTH) w = ST7735_WIDTH - x;
+    if (y + h > ST7735_HEIGHT) h = ST7735_HEIGHT - y;
+    if (w <= 0 || h <= 0) return false;
+
+    LcdTransfer_t t = {
+        .src = NULL,
+        .len = (uint32_t)w * h * 2,
+        .cb = cb,
+        .ctx = ctx,
+        .color = color,
+        .x0 = x, .y0 = y, .x1 = x + w - 1, .y1 = y + h - 1
+    };
+    DMA_Enqueue(&t);
+    return true;
+}
+
+/* Copiere asincrona a unui buffer de pixeli (fara clipping - stride-ul e fix) */
+bool ST7735_BlitAsync(int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t *pixels,
+                      ST7735_DoneCallback_t cb, void *ctx) {
+    if (pixels == NULL || w <= 0 || h <= 0) return false;
+    if (x < 0 || y < 0 || x + w > ST7735_WIDTH || y + h > ST7735_HEIGHT) return false;
+
+    LcdTransfer_t t = {
+        .src = pixels,
+        .len = (uint32_t)w * h * 2,
+        .cb = cb,
+        .ctx = ctx,
+        .color = 0,
+        .x0 = x, .y0 = y, .x1 = x + w - 1, .y1 = y + h - 1
+    };
+    DMA_Enqueue(&t);
+    return true;
+}
+
+bool ST7735_IsBusy(void) {
+    return dma_busy;
+}
+
+void ST7735_WaitIdle(void) {
+    while (dma_busy) {
+        __NOP();
+    }
+}
+
 /* Desenare dreptunghi (doar contur) */
 void ST7735_DrawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
     ST7735_DrawHLine(x, y, w, color);
@@ -354,11 +529,11 @@ void ST7735_DrawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
     ST7735_DrawVLine(x + w - 1, y, h, color);
 }
 
-/* Desenare caracter cu scaling */
-void ST7735_DrawChar(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size) {
-    if (c < 32 || c > 122) return;
-
-    const uint8_t* glyph = &font5x7[(c - 32) * 5];
+/* Desenare caracter pixel cu pixel - folosita doar pentru text transparent
+ * (bg == color), unde fundalul existent trebuie pastrat */
+static void DrawCharTransparent(int16_t x, int16_t y, char c, uint16_t color, uint8_t size) {
+    const uint8_t* glyph = ST7735_GetGlyph(c);
+    if (glyph == NULL) return;
 
     for (int8_t i = 0; i < 5; i++) {
         uint8_t line = glyph[i];
@@ -369,30 +544,95 @@ void ST7735_DrawChar(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg,
                 } else {
                     ST7735_FillRect(x + i * size, y + j * size, size, size, color);
                 }
-            } else if (bg != color) {
-                if (size == 1) {
-                    ST7735_DrawPixel(x + i, y + j, bg);
-                } else {
-                    ST7735_FillRect(x + i * size, y + j * size, size, size, bg);
+            }
+        }
+    }
+}
+
+/* Blitter de text: o singura fereastra pentru toata linia.
+ * Coloanele font5x7 sunt expandate intr-un rand RGB565 (cu scaling pe X),
+ * iar fiecare rand se trimite de `size` ori. Coloana de spatiere dintre
+ * caractere se umple cu bg; caracterele din afara fontului apar ca bg. */
+static void DrawTextLine(int16_t x, int16_t y, const char* str, uint16_t len,
+                         uint16_t color, uint16_t bg, uint8_t size) {
+    static uint8_t line_buf[ST7735_WIDTH * 2];
+
+    if (len == 0 || size == 0) return;
+
+    int16_t w = len * FONT_WIDTH * size - size;   /* fara spatiul dupa ultimul caracter */
+    int16_t h = 7 * size;
+
+    int16_t x0 = x < 0 ? 0 : x;
+    int16_t y0 = y < 0 ? 0 : y;
+    int16_t x1 = x + w - 1;
+    int16_t y1 = y + h - 1;
+    if (x1 >= ST7735_WIDTH) x1 = ST7735_WIDTH - 1;
+    if (y1 >= ST7735_HEIGHT) y1 = ST7735_HEIGHT - 1;
+    if (x0 > x1 || y0 > y1) return;
+
+    uint8_t fg_hi = color >> 8, fg_lo = color & 0xFF;
+    uint8_t bg_hi = bg >> 8, bg_lo = bg & 0xFF;
+    uint32_t line_bytes = (uint32_t)(x1 - x0 + 1) * 2;
+
+    ST7735_WaitIdle();
+    SetWindow(x0, y0, x1, y1);
+    DC_HIGH();
+    CS_LOW();
+
+    int16_t py = y;
+    for (uint8_t row = 0; row < 7; row++) {
+        /* Randurile ecranului acoperite de acest rand al fontului */
+        int16_t row_first = py < y0 ? y0 : py;
+        int16_t row_last = py + size - 1 > y1 ? y1 : py + size - 1;
+        py += size;
+        if (row_first > row_last) continue;
+
+        /* Expandam randul pentru coloanele vizibile */
+        uint8_t *out = line_buf;
+        int16_t px = x;
+        for (uint16_t k = 0; k < len && px <= x1; k++) {
+            const uint8_t* glyph = ST7735_GetGlyph(str[k]);
+            for (uint8_t col = 0; col < FONT_WIDTH && px <= x1; col++) {
+                bool on = (glyph != NULL && col < 5 && (glyph[col] & (1 << row)));
+                for (uint8_t s = 0; s < size; s++, px++) {
+                    if (px < x0 || px > x1) continue;
+                    *out++ = on ? fg_hi : bg_hi;
+                    *out++ = on ? fg_lo : bg_lo;
                 }
             }
         }
+
+        for (int16_t r = row_first; r <= row_last; r++) {
+            SPI_WriteDataFast(line_buf, line_bytes);
+        }
+    }
+
+    SPI_Drain();
+    CS_HIGH();
+}
+
+/* Desenare caracter cu scaling */
+void ST7735_DrawChar(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size) {
+    if (bg == color) {
+        DrawCharTransparent(x, y, c, color, size);
+    } else {
+        DrawTextLine(x, y, &c, 1, color, bg, size);
     }
 }
 
 /* Desenare string simpla (marime 1) */
 void ST7735_DrawString(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg) {
-    while (*str) {
-        ST7735_DrawChar(x, y, *str, color, bg, 1);
-        x += FONT_WIDTH;
-        str++;
-    }
+    ST7735_DrawStringScaled(x, y, str, color, bg, 1);
 }
 
-/* Desenare string cu scaling */
+/* Desenare string cu scaling - o fereastra per linie daca textul e opac */
 void ST7735_DrawStringScaled(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size) {
+    if (bg != color) {
+        DrawTextLine(x, y, str, strlen(str), color, bg, size);
+        return;
+    }
     while (*str) {
-        ST7735_DrawChar(x, y, *str, color, bg, size);
+        DrawCharTransparent(x, y, *str, color, size);
         x += FONT_WIDTH * size;
         str++;
     }
@@ -405,6 +645,18 @@ void ST7735_DrawStringCentered(int16_t y, const char* str, uint16_t color, uint1
     ST7735_DrawStringScaled(x, y, str, color, bg, size);
 }
 
+#ifdef ST7735_STATS
+void ST7735_GetStats(ST7735_Stats_t *out) {
+    ST7735_WaitIdle();
+    *out = stats;
+}
+
+void ST7735_ResetStats(void) {
+    ST7735_WaitIdle();
+    memset(&stats, 0, sizeof(stats));
+}
+#endif
+
 /* Desenare box pentru meniu cu border */
 void ST7735_DrawMenuBox(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t borderColor, uint16_t fillColor) {
     ST7735_FillRect(x + 1, y + 1, w - 2, h - 2, fillColor);
@@ -0,0 +1,151 @@
+/*
+ * synth.c
+ * Mixerul de voci din synth.h
+ *
+ * Mixarea merge voce cu voce peste tot blocul: starea vocii (faza, pas,
+ * tabela, volum) sta in registre, iar bucla interioara are o citire din
+ * tabela, o inmultire, o deplasare si o adunare per esantion. Blocul e
+ * umplut intai cu SYNTH_DAC_MID; o voce tacuta nu costa nimic.
+ */
+
+#include "headers/synth.h"
+#include <stddef.h>
+
+/*============================================================================
+ * WAVETABLES (o perioada, SYNTH_WAVE_LEN esantioane, amplitudine 127)
+ *============================================================================*/
+
+static const int8_t wave_square[SYNTH_WAVE_LEN] = {
+     127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,
+     127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,
+    -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127,
+    -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127,
+};
+
+static const int8_t wave_triangle[SYNTH_WAVE_LEN] = {
+       0,    8,   16,   24,   32,   40,   48,   56,   64,   71,   79,   87,   95,  103,  111,  119,
+     127,  119,  111,  103,   95,   87,   79,   71,   64,   56,   48,   40,   32,   24,   16,    8,
+       0,   -8,  -16,  -24,  -32,  -40,  -48,  -56,  -64,  -71,  -79,  -87,  -95, -103, -111, -119,
+    -127, -119, -111, -103,  -95,  -87,  -79,  -71,  -64,  -56,  -48,  -40,  -32,  -24,  -16,   -8,
+};
+
+static const int8_t wave_sine[SYNTH_WAVE_LEN] = {
+       0,   12,   25,   37,   49,   60,   71,   81,   90,   98,  106,  112,  117,  122,  125,  126,
+     127,  126,  125,  122,  117,  112,  106,   98,   90,   81,   71,   60,   49,   37,   25,   12,
+       0,  -12,  -25,  -37,  -49,  -60,  -71,  -81,  -90,  -98, -106, -112, -117, -122, -125, -126,
+    -127, -126, -125, -122, -117, -112, -106,  -98,  -90,  -81,  -71,  -60,  -49,  -37,  -25,  -12,
+};
+
+static const int8_t* const waves[SYNTH_WAVE_COUNT] = {
+    [SYNTH_WAVE_SQUARE]   = wave_square,
+    [SYNTH_WAVE_TRIANGLE] = wave_triangle,
+    [SYNTH_WAVE_SINE]     = wave_sine,
+};
+
+/*============================================================================
+ * GLOBAL VARIABLES
+ *============================================================================*/
+
+typedef struct {
+    const int8_t* wave;
+    uint32_t phase;
+    uint32_t step;          /* 0 = pauza */
+    uint32_t left;          /* Esantioane ramase din nota; 0 = voce libera */
+    uint8_t volume;
+} SynthVoice_t;
+
+static SynthVoice_t voices[SYNTH_VOICES];
+static SynthNoteDone_t note_done;
+
+/*============================================================================
+ * PRIVATE FUNCTIONS
+ *============================================================================*/
+
+/* Kernel-ul: count esantioane dintr-o voce adunate peste out */
+static void Synth_MixVoice(SynthVoice_t* v, uint16_t* out, uint32_t count) {
+    const int8_t* wave = v->wave;
+    uint32_t phase = v->phase;
+    uint32_t step = v->step;
+    int32_t volume = v->volume;
+
+    while (count--) {
+        *out++ += (uint16_t)((wave[phase >> SYNTH_PHASE_SHIFT] * volume) >> SYNTH_MIX_SHIFT);
+        phase += step;
+    }
+    v->phase = phase;
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+void Synth_Init(SynthNoteDone_t on_done) {
+    note_done = on_done;
+    for (uint8_t i = 0; i < SYNTH_VOICES; i++) {
+        voices[i].wave = wave_square;
+        voices[i].phase = 0;
+        voices[i].step = 0;
+        voices[i].left = 0;
+        voices[i].volume = SYNTH_VOLUME_MAX;
+    }
+}
+
+void Synth_SetVoice(uint8_t voice, SynthWave_t wave, uint8_t volume) {
+    if (voice >= SYNTH_VOICES || wave >= SYNTH_WAVE_COUNT) return;
+
+    voices[voice].wave = waves[wave];
+    voices[voice].volume = volume;
+}
+
+void Synth_Note(uint8_t voice, uint32_t step, uint32_t samples) {
+    if (voice >= SYNTH_VOICES) return;
+
+    voices[voice].step = step;
+    voices[voice].left = samples;
+}
+
+void Synth_Stop(uint8_t voice) {
+    if (voice >= SYNTH_VOICES) return;
+
+    voices[voice].left = 0;
+}
+
+uint32_t Synth_StepForMilliHz(uint32_t mhz) {
+    return (uint32_t)(((uint64_t)mhz << 32) / (SYNTH_SAMPLE_HZ * 1000ULL));
+}
+
+uint8_t Synth_Mix(uint16_t* out, uint32_t n) {
+    uint8_t active = 0;
+
+    for (uint32_t i = 0; i < n; i++) {
+        out[i] = SYNTH_DAC_MID;
+    }
+
+    for (uint8_t i = 0; i < SYNTH_VOICES; i++) {
+        SynthVoice_t* v = &voices[i];
+        uint32_t done = 0;
+
+        /* O nota se poate termina in mijlocul blocului: callback-ul o
+         * porneste pe urmatoarea si mixarea continua de la acel esantion */
+        while (v->left != 0 && done < n) {
+            uint32_t count = n - done;
+            if (count > v->left) count = v->left;
+
+            if (v->step != 0) {
+                Synth_MixVoice(v, &out[done], count);
+            }
+            done += count;
+            v->left -= count;
+
+            if (v->left == 0 && note_done != NULL) {
+                note_done(i);
+            }
+        }
+        if (v->left != 0) active++;
+    }
+    return active;
+}
+
+bool Synth_IsActive(uint8_t voice) {
+    return voice < SYNTH_VOICES && voices[voice].left != 0;
+}
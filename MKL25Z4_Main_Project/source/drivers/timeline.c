@@ -0,0 +1,79 @@
+/*
+ * timeline.c
+ * Secvente de pasi temporizati, avansate din tick-ul jocului
+ */
+
+#include "headers/timeline.h"
+#include "headers/game_config.h"
+#include <stddef.h>
+
+/*============================================================================
+ * PRIVATE FUNCTIONS
+ *============================================================================*/
+
+/* Comparatie sigura la overflow-ul lui g_systick_ms */
+static bool IsDue(uint32_t now, uint32_t due) {
+    return (int32_t)(now - due) >= 0;
+}
+
+static void EnterStep(Timeline_t* t, uint32_t start_ms) {
+    const TimelineStep_t* step = &t->steps[t->index];
+
+    t->due_ms = start_ms + step->hold_ms;
+    if (step->action != NULL) {
+        step->action();
+    }
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+void Timeline_Start(Timeline_t* t, const TimelineStep_t* steps, uint8_t count) {
+    t->steps = steps;
+    t->count = count;
+    t->index = 0;
+    t->replay = 0;
+
+    if (count > 0) {
+        EnterStep(t, g_systick_ms);
+    }
+}
+
+bool Timeline_Update(Timeline_t* t) {
+    uint32_t now = g_systick_ms;
+
+    if (!Timeline_IsActive(t)) return false;
+
+    if (t->replay) {
+        t->replay = 0;
+        EnterStep(t, now);
+        return true;
+    }
+
+    /* Pasii cu durata 0 (sau un tick intarziat) ruleaza in acelasi apel */
+    while (IsDue(now, t->due_ms)) {
+        t->index++;
+        if (t->index >= t->count) {
+            return false;
+        }
+        EnterStep(t, t->due_ms);
+    }
+
+    return true;
+}
+
+bool Timeline_IsActive(const Timeline_t* t) {
+    return t->steps != NULL && t->index < t->count;
+}
+
+void Timeline_Cancel(Timeline_t* t) {
+    t->index = t->count;
+    t->replay = 0;
+}
+
+void Timeline_Replay(Timeline_t* t) {
+    if (Timeline_IsActive(t)) {
+        t->replay = 1;
+    }
+}
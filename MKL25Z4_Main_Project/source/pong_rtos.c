@@ -0,0 +1,347 @@
+/*
+ * pong_rtos.c
+ * Task-urile FreeRTOS ale jocului (build cu -DSDK_OS_FREE_RTOS)
+ *
+ * Fluxul de date:
+ *   ISR-uri -> input_events -> [input] -> ui_queue -> [ui] -> game_wanted -> [game]
+ *   PIT ch0 (50 Hz) -> notificare -> [game] -> ui_queue (game over)
+ *
+ * Task-ul game are nevoie doar de ultima stare ceruta (ruleaza / oprit),
+ * nu de istoricul comenzilor: ui o scrie in game_wanted si trezeste
+ * task-ul cu un bit de notificare, langa bitul tick-ului PIT.
+ *
+ * Starea de ecran (g_currentScreen, g_needsRedraw, meniurile) e atinsa doar
+ * de task-ul ui; celelalte task-uri ii trimit mesaje. Game_Update si
+ * meniurile deseneaza amandoua, deci display-ul e sub display_mutex.
+ *
+ * Modul de rulare (run_mode.c) e schimbat doar de task-ul ui, cu
+ * display_mutex luat: RUN pentru joc si redesenari, VLPR in rest.
+ */
+
+#if defined(SDK_OS_FREE_RTOS)
+
+#include "pong_rtos.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "MKL25Z4.h"
+#include "fsl_common.h"
+#include "fsl_clock.h"
+#include "fsl_pit.h"
+#include "fsl_debug_console.h"
+#include "drivers/headers/game_config.h"
+#include "drivers/headers/joystick.h"
+#include "drivers/headers/ir_remote.h"
+#include "drivers/headers/run_mode.h"
+#include "drivers/headers/audio.h"
+#include "drivers/headers/profiler.h"
+
+/*============================================================================
+ * TYPES
+ *============================================================================*/
+
+typedef enum {
+    UI_MSG_INPUT = 0,       /* Eveniment de la task-ul input */
+    UI_MSG_GAME_OVER        /* Meciul s-a terminat (task-ul game) */
+} UiMsgType_t;
+
+typedef struct {
+    uint8_t type;           /* UiMsgType_t */
+    InputEvent_t ev;
+} UiMsg_t;
+
+typedef struct {
+    const char* name;
+    TaskHandle_t handle;
+    uint32_t runs;
+    uint32_t wcet_us;
+    uint32_t total_us;
+} RtosTask_t;
+
+enum { RTOS_TASK_INPUT = 0, RTOS_TASK_GAME, RTOS_TASK_UI, RTOS_NUM_TASKS };
+
+/*============================================================================
+ * GLOBAL VARIABLES
+ *============================================================================*/
+
+/* Bitii notificarii task-ului game */
+#define GAME_NOTIFY_TICK        (1UL << 0)  /* PIT ch0 */
+#define GAME_NOTIFY_STATE       (1UL << 1)  /* game_wanted s-a schimbat */
+
+static QueueHandle_t ui_queue;
+static SemaphoreHandle_t display_mutex;
+static volatile bool game_wanted = false;   /* Scris doar de ui (App_SetGameRunning) */
+
+static RtosTask_t tasks[RTOS_NUM_TASKS] = {
+    [RTOS_TASK_INPUT] = { .name = "input" },
+    [RTOS_TASK_GAME]  = { .name = "game" },
+    [RTOS_TASK_UI]    = { .name = "ui" },
+};
+
+static RtosQueueStats_t queue_stats;
+
+/* Extern: timer global din main (incrementat din tick hook) */
+extern volatile uint32_t g_systick_ms;
+
+/*============================================================================
+ * PRIVATE FUNCTIONS
+ *============================================================================*/
+
+static void Rtos_Measure(RtosTask_t* t, uint32_t start) {
+    uint32_t elapsed = portGET_RUN_TIME_COUNTER_VALUE() - start;
+
+    t->runs++;
+    t->total_us += elapsed;
+    if (elapsed > t->wcet_us) t->wcet_us = elapsed;
+}
+
+static void Rtos_TrackDepth(QueueHandle_t q, uint8_t* max) {
+    UBaseType_t depth = uxQueueMessagesWaiting(q);
+    if (depth > *max) *max = (uint8_t)depth;
+}
+
+static void Rtos_SendUi(const UiMsg_t* msg) {
+    /* Fara blocare: input-ul nu asteapta dupa meniuri */
+    if (xQueueSend(ui_queue, msg, 0) != pdTRUE) {
+        queue_stats.ui_queue_full++;
+        return;
+    }
+    Rtos_TrackDepth(ui_queue, &queue_stats.ui_queue_max);
+}
+
+/*============================================================================
+ * PIT HANDLER - tick de joc
+ *============================================================================*/
+
+void PIT_IRQHandler(void) {
+    BaseType_t woken = pdFALSE;
+
+    if (PIT_GetStatusFlags(PIT, kPIT_Chnl_0) & kPIT_TimerFlag) {
+        PIT_ClearStatusFlags(PIT, kPIT_Chnl_0, kPIT_TimerFlag);
+        xTaskNotifyFromISR(tasks[RTOS_TASK_GAME].handle, GAME_NOTIFY_TICK, eSetBits, &woken);
+    }
+#if !defined(AUDIO_DAC)
+    /* Canalul 1 e al buzzer-ului (audio_kl25z.c); pe DAC notele sunt
+     * numarate de mixer */
+    Audio_HwPitIrq();
+#endif
+
+    portYIELD_FROM_ISR(woken);
+}
+
+/* Perioada PIT si tick-ul kernel-ului raman aceleasi in RUN si VLPR */
+static void GamePit_OnRunMode(const RunModeClocks_t* clocks) {
+    PIT_SetTimerPeriod(PIT, kPIT_Chnl_0, clocks->bus_hz / RTOS_GAME_HZ - 1U);
+}
+
+static void RtosTick_OnRunMode(const RunModeClocks_t* clocks) {
+    SysTick->LOAD = clocks->core_hz / configTICK_RATE_HZ - 1U;
+    SysTick->VAL = 0;
+}
+
+static void GamePit_Init(void) {
+    pit_config_t pitConfig;
+
+    PIT_GetDefaultConfig(&pitConfig);
+    PIT_Init(PIT, &pitConfig);
+    PIT_SetTimerPeriod(PIT, kPIT_Chnl_0, CLOCK_GetBusClkFreq() / RTOS_GAME_HZ - 1U);
+    PIT_EnableInterrupts(PIT, kPIT_Chnl_0, kPIT_TimerInterruptEnable);
+    RunMode_AddListener(GamePit_OnRunMode);
+
+    /* Sub configMAX_SYSCALL_INTERRUPT_PRIORITY - poate apela API-ul FromISR */
+    NVIC_SetPriority(PIT_IRQn, 2);
+    EnableIRQ(PIT_IRQn);
+}
+
+/*============================================================================
+ * TASKS
+ *============================================================================*/
+
+/* Joystick + IR la fiecare tick; evenimentele merg in coada UI */
+static void InputTaskFn(void* arg) {
+    RtosTask_t* self = &tasks[RTOS_TASK_INPUT];
+    TickType_t last = xTaskGetTickCount();
+    UiMsg_t msg = { .type = UI_MSG_INPUT };
+
+    for (;;) {
+        vTaskDelayUntil(&last, 1);
+
+        uint32_t start = portGET_RUN_TIME_COUNTER_VALUE();
+        PROF_BEGIN(PROF_INPUT);
+        Joystick_Process();
+        IR_Process();
+        PROF_END(PROF_INPUT);
+
+        while (InputEvents_Pop(&msg.ev)) {
+            Rtos_SendUi(&msg);
+        }
+        Rtos_Measure(self, start);
+    }
+}
+
+/* Un pas de joc la fiecare intrerupere PIT, cat timp meciul ruleaza */
+static void GameTaskFn(void* arg) {
+    RtosTask_t* self = &tasks[RTOS_TASK_GAME];
+    bool running = false;
+    uint32_t bits;
+
+    for (;;) {
+        /* Oprit: se trezeste doar la o schimbare de stare. Pornit: si la
+         * tick-uri; timeout-ul acopera un PIT care nu mai vine */
+        if (xTaskNotifyWait(0, UINT32_MAX, &bits,
+                            running ? pdMS_TO_TICKS(2000U / RTOS_GAME_HZ) : portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+
+        /* Mai multe RUN/STOP intre doua treziri conteaza ca ultimul */
+        if ((bits & GAME_NOTIFY_STATE) && game_wanted != running) {
+            running = game_wanted;
+            if (running) {
+                bits &= ~GAME_NOTIFY_TICK;      /* Un tick ramas de la meciul trecut */
+                PIT_StartTimer(PIT, kPIT_Chnl_0);
+            } else {
+                PIT_StopTimer(PIT, kPIT_Chnl_0);
+            }
+        }
+        if (!running || !(bits & GAME_NOTIFY_TICK)) continue;
+
+        uint32_t start = portGET_RUN_TIME_COUNTER_VALUE();
+        xSemaphoreTake(display_mutex, portMAX_DELAY);
+        bool alive = App_GameTick();
+        xSemaphoreGive(display_mutex);
+        Rtos_Measure(self, start);
+
+        if (!alive) {
+            UiMsg_t msg = { .type = UI_MSG_GAME_OVER };
+
+            running = false;
+            PIT_StopTimer(PIT, kPIT_Chnl_0);
+
+            /* Game over nu are voie sa se piarda */
+            xQueueSend(ui_queue, &msg, portMAX_DELAY);
+            Rtos_TrackDepth(ui_queue, &queue_stats.ui_queue_max);
+        }
+    }
+}
+
+/* Init module + intro, apoi meniurile: un mesaj sau la 50 ms */
+static void UiTaskFn(void* arg) {
+    RtosTask_t* self = &tasks[RTOS_TASK_UI];
+    UiMsg_t msg;
+
+    /* delay_ms din animatii foloseste vTaskDelay aici */
+    App_Init();
+
+    GamePit_Init();
+    xTaskCreate(InputTaskFn, tasks[RTOS_TASK_INPUT].name, RTOS_STACK_WORDS(128),
+                NULL, RTOS_INPUT_PRIORITY, &tasks[RTOS_TASK_INPUT].handle);
+    xTaskCreate(GameTaskFn, tasks[RTOS_TASK_GAME].name, RTOS_STACK_WORDS(192),
+                NULL, RTOS_GAME_PRIORITY, &tasks[RTOS_TASK_GAME].handle);
+
+    for (;;) {
+        BaseType_t got = xQueueReceive(ui_queue, &msg, pdMS_TO_TICKS(RTOS_UI_PERIOD_MS));
+
+        uint32_t start = portGET_RUN_TIME_COUNTER_VALUE();
+        xSemaphoreTake(display_mutex, portMAX_DELAY);
+        if (got == pdTRUE || g_needsRedraw) {
+            RunMode_Set(RUN_MODE_RUN);
+        }
+        if (got == pdTRUE) {
+            if (msg.type == UI_MSG_GAME_OVER) {
+                App_GameOver();
+            } else {
+                App_HandleInput(&msg.ev);
+            }
+        }
+        App_Redraw();
+        RunMode_Update(g_currentScreen == SCREEN_GAMEPLAY || g_needsRedraw);
+        xSemaphoreGive(display_mutex);
+        Rtos_Measure(self, start);
+    }
+}
+
+/*============================================================================
+ * KERNEL HOOKS
+ *============================================================================*/
+
+void vApplicationTickHook(void) {
+    g_systick_ms++;
+}
+
+void vApplicationStackOverflowHook(TaskHandle_t task, char* name) {
+    (void)task;
+    PRINTF("[RTOS] Stack overflow: %s\r\n", name);
+    configASSERT(0);
+}
+
+void vApplicationMallocFailedHook(void) {
+    PRINTF("[RTOS] Heap plin\r\n");
+    configASSERT(0);
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+void PongRtos_Start(void) {
+    ui_queue = xQueueCreate(RTOS_UI_QUEUE_LEN, sizeof(UiMsg_t));
+    display_mutex = xSemaphoreCreateMutex();
+    configASSERT(ui_queue && display_mutex);
+
+    /* Listener-ele driverelor se inregistreaza din App_Init */
+    RunMode_Init();
+    RunMode_AddListener(RtosTick_OnRunMode);
+
+    xTaskCreate(UiTaskFn, tasks[RTOS_TASK_UI].name, RTOS_STACK_WORDS(256),
+                NULL, RTOS_UI_PRIORITY, &tasks[RTOS_TASK_UI].handle);
+
+    PRINTF("[RTOS] Starting scheduler\r\n");
+    vTaskStartScheduler();
+
+    /* Ajunge aici doar daca nu e destul heap pentru task-ul idle */
+    for (;;) {
+    }
+}
+
+/* App_SetGameRunning pentru app.c: starea noua + bitul de notificare.
+ * Apelat cu display_mutex luat; xTaskNotify nu blocheaza si nu pierde
+ * nimic - task-ul game citeste game_wanted cand se trezeste */
+void App_SetGameRunning(bool running) {
+    game_wanted = running;
+    queue_stats.game_state_writes++;
+    xTaskNotify(tasks[RTOS_TASK_GAME].handle, GAME_NOTIFY_STATE, eSetBits);
+}
+
+bool PongRtos_GetTaskStats(uint8_t index, RtosTaskStats_t* out) {
+    if (index >= RTOS_NUM_TASKS) return false;
+
+    const RtosTask_t* t = &tasks[index];
+    out->name = t->name;
+    out->runs = t->runs;
+    out->wcet_us = t->wcet_us;
+    out->total_us = t->total_us;
+    out->stack_free_words = t->handle ? uxTaskGetStackHighWaterMark(t->handle) : 0;
+    return true;
+}
+
+void PongRtos_GetQueueStats(RtosQueueStats_t* out) {
+    *out = queue_stats;
+}
+
+void PongRtos_PrintStats(void) {
+    RtosTaskStats_t s;
+
+    PRINTF("[RTOS] task      runs  wcet_us  total_ms  stack_free\r\n");
+    for (uint8_t i = 0; PongRtos_GetTaskStats(i, &s); i++) {
+        PRINTF("[RTOS] %-8s %6u %8u %9u %11u\r\n", s.name,
+               (unsigned int)s.runs, (unsigned int)s.wcet_us,
+               (unsigned int)(s.total_us / 1000U), (unsigned int)s.stack_free_words);
+    }
+    PRINTF("[RTOS] ui_queue max %u/%u full %u, game state writes %u\r\n",
+           (unsigned int)queue_stats.ui_queue_max, (unsigned int)RTOS_UI_QUEUE_LEN,
+           (unsigned int)queue_stats.ui_queue_full,
+           (unsigned int)queue_stats.game_state_writes);
+}
+
+#endif /* SDK_OS_FREE_RTOS */
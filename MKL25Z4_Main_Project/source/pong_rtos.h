@@ -0,0 +1,83 @@
+/*
+ * pong_rtos.h
+ * Varianta FreeRTOS a jocului (build cu -DSDK_OS_FREE_RTOS)
+ *
+ * Logica jocului e aceeasi ca in build-ul cu scheduler cooperativ: functiile
+ * App_* din drivers/app.c. Aici doar se schimba cine le apeleaza:
+ * - input (prio 3): joystick + IR la 1 ms, evenimentele -> coada UI
+ * - game  (prio 2): Game_Update la fiecare intrerupere PIT (50 Hz)
+ * - ui    (prio 1): evenimente, meniuri, desenare (singurul care scrie
+ *                   g_currentScreen / g_needsRedraw)
+ * Evenimentele merg prin coada UI; task-ul game primeste doar ultima stare
+ * ceruta (ruleaza / oprit) printr-o notificare. Display-ul e sub un mutex.
+ */
+
+#ifndef PONG_RTOS_H
+#define PONG_RTOS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "drivers/headers/app.h"
+
+#if defined(SDK_OS_FREE_RTOS)
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*============================================================================
+ * CONFIGURATION
+ *============================================================================*/
+
+#define RTOS_GAME_HZ            50U
+#define RTOS_UI_PERIOD_MS       50U
+#define RTOS_UI_QUEUE_LEN       16U
+
+#define RTOS_INPUT_PRIORITY     (tskIDLE_PRIORITY + 3)
+#define RTOS_GAME_PRIORITY      (tskIDLE_PRIORITY + 2)
+#define RTOS_UI_PRIORITY        (tskIDLE_PRIORITY + 1)
+
+/*============================================================================
+ * TYPES
+ *============================================================================*/
+
+typedef struct {
+    const char* name;
+    uint32_t runs;
+    uint32_t wcet_us;
+    uint32_t total_us;
+    uint32_t stack_free_words;  /* High-water mark: minimul de stiva libera */
+} RtosTaskStats_t;
+
+typedef struct {
+    uint8_t ui_queue_max;       /* Adancimea maxima a cozii UI */
+    uint32_t ui_queue_full;     /* Mesaje pierdute (coada plina) */
+    uint32_t game_state_writes; /* App_SetGameRunning (suprascriu starea, nu se pierd) */
+} RtosQueueStats_t;
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+/**
+ * Creeaza task-urile, cozile si PIT-ul de joc, apoi porneste kernel-ul
+ * (nu se intoarce)
+ */
+void PongRtos_Start(void);
+
+/**
+ * Statisticile task-ului de pe pozitia index
+ * @return false daca index nu exista
+ */
+bool PongRtos_GetTaskStats(uint8_t index, RtosTaskStats_t* out);
+
+/**
+ * Adancimile maxime ale cozilor
+ */
+void PongRtos_GetQueueStats(RtosQueueStats_t* out);
+
+/**
+ * Afiseaza statisticile task-urilor si cozilor pe consola
+ */
+void PongRtos_PrintStats(void);
+#endif /* SDK_OS_FREE_RTOS */
+
+#endif /* PONG_RTOS_H */
@@ -0,0 +1,21 @@
+/*
+ * MKL25Z4.h (compat Zephyr)
+ * Modulele comune din source/drivers folosesc din header-ul CMSIS doar
+ * barierele si __NOP; registrele raman in portul KL25Z.
+ */
+
+#ifndef PONG_ZEPHYR_MKL25Z4_H
+#define PONG_ZEPHYR_MKL25Z4_H
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/barrier.h>
+
+/* Pe Cortex-M le defineste deja CMSIS (inclus de kernel.h) */
+#ifndef __DMB
+#define __DMB()     barrier_dmem_fence_full()
+#endif
+#ifndef __NOP
+#define __NOP()     arch_nop()
+#endif
+
+#endif /* PONG_ZEPHYR_MKL25Z4_H */
@@ -0,0 +1,13 @@
+/*
+ * fsl_debug_console.h (compat Zephyr)
+ * PRINTF din modulele comune merge in printk
+ */
+
+#ifndef PONG_ZEPHYR_FSL_DEBUG_CONSOLE_H
+#define PONG_ZEPHYR_FSL_DEBUG_CONSOLE_H
+
+#include <zephyr/sys/printk.h>
+
+#define PRINTF  printk
+
+#endif /* PONG_ZEPHYR_FSL_DEBUG_CONSOLE_H */
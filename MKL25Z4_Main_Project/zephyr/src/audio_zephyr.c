@@ -0,0 +1,100 @@
+/*
+ * audio_zephyr.c
+ * Partea hardware a buzzer-ului peste API-ul PWM din Zephyr
+ *
+ * Canalul PWM vine din zephyr,user (pwms): pe FRDM-KL25Z TPM2_CH0 pe
+ * PTB2, ca pe bare metal. Durata notei e un k_timer one-shot (in loc de
+ * PIT canal 1), al carui callback ruleaza in ISR-ul ceasului de sistem si
+ * apeleaza Audio_NoteDone. Fara pwms (native_sim) secventiatorul ruleaza
+ * la fel, doar fara ton.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/pwm.h>
+#include "drivers/headers/audio.h"
+
+/*============================================================================
+ * GLOBAL VARIABLES
+ *============================================================================*/
+
+#define AUDIO_HAS_PWM   DT_NODE_HAS_PROP(DT_PATH(zephyr_user), pwms)
+
+#if AUDIO_HAS_PWM
+static const struct pwm_dt_spec buzzer = PWM_DT_SPEC_GET(DT_PATH(zephyr_user));
+#endif
+
+static struct k_timer note_timer;
+static unsigned int irq_key;
+
+/*============================================================================
+ * CALLBACKS
+ *============================================================================*/
+
+static void NoteExpired(struct k_timer* timer) {
+    Audio_NoteDone(0);
+}
+
+/*============================================================================
+ * PRIVATE FUNCTIONS
+ *============================================================================*/
+
+/* Perioada din melodie (ticuri la SONG_TONE_HZ) -> ns pentru API-ul PWM */
+static void Audio_SetTone(uint16_t song_period) {
+#if AUDIO_HAS_PWM
+    if (song_period == 0) {
+        pwm_set_pulse_dt(&buzzer, 0);
+    } else {
+        uint32_t period = (uint32_t)((uint64_t)song_period * NSEC_PER_SEC / SONG_TONE_HZ);
+        pwm_set_dt(&buzzer, period, period / 2U);
+    }
+#else
+    ARG_UNUSED(song_period);
+#endif
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+/* O singura voce, PWM dreptunghiular */
+void Audio_HwTimbre(uint8_t voice, SynthWave_t wave, uint8_t volume) {
+    ARG_UNUSED(voice);
+    ARG_UNUSED(wave);
+    ARG_UNUSED(volume);
+}
+
+void Audio_HwNote(uint8_t voice, uint16_t period, uint16_t ms) {
+    ARG_UNUSED(voice);
+    Audio_SetTone(period);
+    k_timer_start(&note_timer, K_MSEC(ms), K_NO_WAIT);
+}
+
+void Audio_HwStop(uint8_t voice) {
+    ARG_UNUSED(voice);
+    k_timer_stop(&note_timer);
+    Audio_SetTone(0);
+}
+
+/* Callback-ul k_timer ruleaza in ISR: irq_lock e sectiunea critica */
+void Audio_HwMaskIrq(bool masked) {
+    if (masked) {
+        irq_key = irq_lock();
+    } else {
+        irq_unlock(irq_key);
+    }
+}
+
+void Audio_HwInit(void) {
+    k_timer_init(&note_timer, NoteExpired, NULL);
+
+#if AUDIO_HAS_PWM
+    if (!pwm_is_ready_dt(&buzzer)) {
+        printk("[Audio] PWM not ready\n");
+        return;
+    }
+    pwm_set_pulse_dt(&buzzer, 0);
+    printk("[Audio] Initialized (%s ch %u, k_timer note timer)\n", buzzer.dev->name, buzzer.channel);
+#else
+    printk("[Audio] No pwms in zephyr,user, sequencer runs silent\n");
+#endif
+}
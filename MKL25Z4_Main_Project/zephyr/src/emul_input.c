@@ -0,0 +1,134 @@
+/*
+ * emul_input.c
+ * Input scriptat pentru native_sim (CONFIG_PONG_EMUL_INPUT)
+ *
+ * Fara hardware, joystick-ul si receptorul IR sunt alimentate prin
+ * driver-ele adc-emul si gpio-emul: tensiunea pe canalul ADC, nivelul
+ * butonului si fronturile unui cadru NEC sunt generate de un thread care
+ * ruleaza un scenariu fix (meniu, pornirea meciului, miscari de paleta).
+ * Restul aplicatiei ruleaza exact ca pe placa.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/adc.h>
+#include <zephyr/drivers/adc/adc_emul.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+#include "drivers/headers/ir_remote.h"
+
+/*============================================================================
+ * CONFIGURATION
+ *============================================================================*/
+
+/* Tensiuni pe axa Y (referinta adc-emul: 3300 mV) */
+#define JOY_CENTER_MV       1650U
+#define JOY_UP_MV           100U
+#define JOY_DOWN_MV         3200U
+
+/* Timpi NEC (us) */
+#define NEC_LEAD_MARK       9000U
+#define NEC_LEAD_SPACE      4500U
+#define NEC_BIT_MARK        562U
+#define NEC_ZERO_SPACE      562U
+#define NEC_ONE_SPACE       1687U
+
+/* Pas de script: actiune + cat se asteapta dupa ea */
+typedef enum {
+    STEP_JOY = 0,           /* arg = mV */
+    STEP_BUTTON,            /* apasare scurta */
+    STEP_IR                 /* arg = cod NEC */
+} StepType_t;
+
+typedef struct {
+    uint8_t type;
+    uint32_t arg;
+    uint32_t wait_ms;
+} Step_t;
+
+/*============================================================================
+ * GLOBAL VARIABLES
+ *============================================================================*/
+
+static const struct adc_dt_spec vry = ADC_DT_SPEC_GET(DT_PATH(zephyr_user));
+static const struct gpio_dt_spec sw = GPIO_DT_SPEC_GET(DT_PATH(zephyr_user), sw_gpios);
+static const struct gpio_dt_spec ir = GPIO_DT_SPEC_GET(DT_PATH(zephyr_user), ir_gpios);
+
+static const Step_t script[] = {
+    { STEP_BUTTON, 0,               1500 },     /* Intro -> meniu */
+    { STEP_JOY,    JOY_DOWN_MV,     300  },
+    { STEP_JOY,    JOY_CENTER_MV,   500  },
+    { STEP_JOY,    JOY_UP_MV,       300  },
+    { STEP_JOY,    JOY_CENTER_MV,   500  },
+    { STEP_BUTTON, 0,               1000 },     /* Play */
+    { STEP_BUTTON, 0,               1000 },     /* Prima optiune (1 jucator) */
+    { STEP_JOY,    JOY_UP_MV,       800  },
+    { STEP_JOY,    JOY_DOWN_MV,     1200 },
+    { STEP_IR,     IR_CODE_UP,      400  },
+    { STEP_IR,     IR_CODE_DOWN,    400  },
+    { STEP_JOY,    JOY_CENTER_MV,   3000 },
+};
+
+/*============================================================================
+ * PRIVATE FUNCTIONS
+ *============================================================================*/
+
+/* Iesirea receptorului e activa pe 0: mark = 0, space = 1 */
+static void IrLevel(int level, uint32_t us) {
+    gpio_emul_input_set(ir.port, ir.pin, level);
+    k_busy_wait(us);
+}
+
+static void SendNec(uint32_t code) {
+    IrLevel(0, NEC_LEAD_MARK);
+    IrLevel(1, NEC_LEAD_SPACE);
+
+    /* 32 de biti, LSB primul (adresa, ~adresa, comanda, ~comanda) */
+    for (uint8_t i = 0; i < 32; i++) {
+        IrLevel(0, NEC_BIT_MARK);
+        IrLevel(1, (code & (1UL << i)) ? NEC_ONE_SPACE : NEC_ZERO_SPACE);
+    }
+
+    IrLevel(0, NEC_BIT_MARK);
+    gpio_emul_input_set(ir.port, ir.pin, 1);
+}
+
+static void PressButton(void) {
+    /* Buton activ pe 0 (pull-up): nivel fizic 0 = apasat */
+    gpio_emul_input_set(sw.port, sw.pin, 0);
+    k_msleep(50);
+    gpio_emul_input_set(sw.port, sw.pin, 1);
+}
+
+/*============================================================================
+ * SCRIPT THREAD
+ *============================================================================*/
+
+static void EmulThread(void* p1, void* p2, void* p3) {
+    gpio_emul_input_set(sw.port, sw.pin, 1);
+    gpio_emul_input_set(ir.port, ir.pin, 1);
+    adc_emul_const_value_set(vry.dev, vry.channel_id, JOY_CENTER_MV);
+
+    /* Intro-ul (animatia BMO) ruleaza ~4 s */
+    k_msleep(4000);
+
+    for (;;) {
+        for (size_t i = 0; i < ARRAY_SIZE(script); i++) {
+            const Step_t* s = &script[i];
+
+            switch (s->type) {
+                case STEP_JOY:
+                    adc_emul_const_value_set(vry.dev, vry.channel_id, s->arg);
+                    break;
+                case STEP_BUTTON:
+                    PressButton();
+                    break;
+                case STEP_IR:
+                    SendNec(s->arg);
+                    break;
+            }
+            k_msleep(s->wait_ms);
+        }
+    }
+}
+
+K_THREAD_DEFINE(emul_input, 1024, EmulThread, NULL, NULL, NULL, 5, 0, 0);
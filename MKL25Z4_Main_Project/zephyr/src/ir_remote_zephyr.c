@@ -0,0 +1,60 @@
+/*
+ * ir_remote_zephyr.c
+ * Partea hardware a receptorului IR peste API-ul GPIO din Zephyr
+ *
+ * Pinul vine din zephyr,user (ir-gpios), cu intrerupere pe ambele
+ * fronturi. Latimea fiecarui puls se masoara cu ceasul de cicluri al
+ * kernel-ului (in loc de captura TPM1) si merge in IR_FeedPulse; o pauza
+ * mai lunga decat orice simbol NEC e raportata ca IR_WIDTH_IDLE.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/gpio.h>
+#include "drivers/headers/ir_remote.h"
+
+/*============================================================================
+ * CONFIGURATION
+ *============================================================================*/
+
+/* Peste header-ul de 9 ms + 4.5 ms: linia a stat in repaus */
+#define IR_IDLE_US          40000U
+
+/*============================================================================
+ * GLOBAL VARIABLES
+ *============================================================================*/
+
+static const struct gpio_dt_spec ir = GPIO_DT_SPEC_GET(DT_PATH(zephyr_user), ir_gpios);
+
+static struct gpio_callback ir_cb;
+static uint32_t last_edge;
+
+/*============================================================================
+ * CALLBACKS
+ *============================================================================*/
+
+static void IrEdge(const struct device* dev, struct gpio_callback* cb, uint32_t pins) {
+    uint32_t now = k_cycle_get_32();
+    uint32_t width = k_cyc_to_us_floor32(now - last_edge);
+
+    last_edge = now;
+    IR_FeedPulse(width > IR_IDLE_US ? IR_WIDTH_IDLE : width);
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+void IR_HwInit(void) {
+    if (!gpio_is_ready_dt(&ir) ||
+        gpio_pin_configure_dt(&ir, GPIO_INPUT) != 0 ||
+        gpio_pin_interrupt_configure_dt(&ir, GPIO_INT_EDGE_BOTH) != 0) {
+        printk("[IR] GPIO not ready\n");
+        return;
+    }
+
+    last_edge = k_cycle_get_32();
+    gpio_init_callback(&ir_cb, IrEdge, BIT(ir.pin));
+    gpio_add_callback(ir.port, &ir_cb);
+
+    printk("[IR] Initialized (%s pin %u, edge timing)\n", ir.port->name, ir.pin);
+}
@@ -0,0 +1,111 @@
+/*
+ * joystick_zephyr.c
+ * Partea hardware a joystick-ului peste API-urile ADC si GPIO din Zephyr
+ *
+ * Canalul ADC si butonul vin din nodul zephyr,user al devicetree-ului
+ * (io-channels, sw-gpios). Un thread dedicat ruleaza o secventa ADC care
+ * se repeta singura la JOYSTICK_SAMPLE_HZ; fiecare esantion ajunge in
+ * Joystick_PushSample, exact ca din ADC0_IRQHandler pe bare metal.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/adc.h>
+#include <zephyr/drivers/gpio.h>
+#include "drivers/headers/joystick.h"
+
+/*============================================================================
+ * CONFIGURATION
+ *============================================================================*/
+
+#define SAMPLER_STACK_SIZE      768
+#define SAMPLER_PRIORITY        0
+
+/*============================================================================
+ * GLOBAL VARIABLES
+ *============================================================================*/
+
+static const struct adc_dt_spec vry = ADC_DT_SPEC_GET(DT_PATH(zephyr_user));
+static const struct gpio_dt_spec sw = GPIO_DT_SPEC_GET(DT_PATH(zephyr_user), sw_gpios);
+
+static struct gpio_callback sw_cb;
+static int16_t sample_buf;
+
+K_SEM_DEFINE(sampler_start, 0, 1);
+
+/*============================================================================
+ * CALLBACKS
+ *============================================================================*/
+
+static void SwEdge(const struct device* dev, struct gpio_callback* cb, uint32_t pins) {
+    Joystick_PushButton(gpio_pin_get_dt(&sw) == 1);
+}
+
+/* Apelat dupa fiecare conversie; REPEAT reporneste secventa peste interval */
+static enum adc_action SampleDone(const struct device* dev, const struct adc_sequence* seq,
+                                  uint16_t index) {
+    Joystick_PushSample((uint16_t)sample_buf);
+    return ADC_ACTION_REPEAT;
+}
+
+/*============================================================================
+ * SAMPLER THREAD
+ *============================================================================*/
+
+static void SamplerThread(void* p1, void* p2, void* p3) {
+    const struct adc_sequence_options opts = {
+        .interval_us = 1000000U / JOYSTICK_SAMPLE_HZ,
+        .callback = SampleDone,
+    };
+    struct adc_sequence seq = {
+        .options = &opts,
+        .buffer = &sample_buf,
+        .buffer_size = sizeof(sample_buf),
+    };
+
+    k_sem_take(&sampler_start, K_FOREVER);
+
+    adc_sequence_init_dt(&vry, &seq);
+
+    /* Cu ADC_ACTION_REPEAT apelul nu se intoarce decat la eroare */
+    int err = adc_read_dt(&vry, &seq);
+    printk("[Joystick] ADC sampling stopped (%d)\n", err);
+}
+
+K_THREAD_DEFINE(joystick_sampler, SAMPLER_STACK_SIZE, SamplerThread, NULL, NULL, NULL,
+                SAMPLER_PRIORITY, 0, 0);
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+void Joystick_HwInit(void) {
+    if (!adc_is_ready_dt(&vry) || adc_channel_setup_dt(&vry) != 0) {
+        printk("[Joystick] ADC channel not ready\n");
+        return;
+    }
+
+    if (gpio_is_ready_dt(&sw) &&
+        gpio_pin_configure_dt(&sw, GPIO_INPUT) == 0 &&
+        gpio_pin_interrupt_configure_dt(&sw, GPIO_INT_EDGE_BOTH) == 0) {
+        gpio_init_callback(&sw_cb, SwEdge, BIT(sw.pin));
+        gpio_add_callback(sw.port, &sw_cb);
+    } else {
+        printk("[Joystick] button GPIO not ready\n");
+    }
+
+    k_sem_give(&sampler_start);
+
+    printk("[Joystick] Initialized (%s ch %u, ADC @ %u Hz)\n",
+           vry.dev->name, vry.channel_id, (unsigned int)JOYSTICK_SAMPLE_HZ);
+}
+
+/* Somnul e treaba PM-ului din kernel: sampler-ul ruleaza mereu continuu */
+void Joystick_HwSetContinuous(bool continuous) {
+}
+
+void Joystick_HwStartConversion(void) {
+}
+
+bool Joystick_HwIsConverting(void) {
+    return false;
+}
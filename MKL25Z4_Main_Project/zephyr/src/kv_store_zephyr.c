@@ -0,0 +1,104 @@
+/*
+ * kv_store_zephyr.c
+ * Partea hardware a kv_store.h peste API-ul flash_area din Zephyr
+ *
+ * Zona e partitia storage_partition din devicetree, daca exista si are
+ * pagini de stergere de KV_SECTOR_SIZE octeti (pe FRDM-KL25Z, ca FTFA).
+ * Altfel (ex: native_sim, cu pagini de 4 KB) store-ul ruleaza peste un
+ * buffer in RAM: setarile se pastreaza doar pana la reset.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/storage/flash_map.h>
+#include <string.h>
+#include "drivers/headers/kv_store.h"
+
+/*============================================================================
+ * GLOBAL VARIABLES
+ *============================================================================*/
+
+#define KV_HAS_PARTITION    FIXED_PARTITION_EXISTS(storage_partition)
+
+#if KV_HAS_PARTITION
+static const struct flash_area* area;
+#endif
+
+static uint8_t ram_flash[KV_SIZE];
+static bool use_flash;
+
+/*============================================================================
+ * PRIVATE FUNCTIONS
+ *============================================================================*/
+
+#if KV_HAS_PARTITION
+static bool KvStore_AreaUsable(void) {
+    struct flash_sector sector;
+    uint32_t count = 1;
+
+    if (flash_area_open(FIXED_PARTITION_ID(storage_partition), &area) != 0) return false;
+    if (area->fa_size < KV_SIZE) return false;
+
+    /* -ENOMEM cu un singur element inseamna doar ca sunt mai multe pagini */
+    int err = flash_area_get_sectors(FIXED_PARTITION_ID(storage_partition), &count, &sector);
+    return (err == 0 || err == -ENOMEM) && sector.fs_size == KV_SECTOR_SIZE;
+}
+#endif
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+void KvStore_HwInit(void) {
+#if KV_HAS_PARTITION
+    use_flash = KvStore_AreaUsable();
+#endif
+    if (use_flash) {
+        printk("[KvStore] storage_partition, %u sectors of %u bytes\n", KV_SECTORS, KV_SECTOR_SIZE);
+    } else {
+        memset(ram_flash, 0xFF, sizeof(ram_flash));
+        printk("[KvStore] No usable storage_partition, values kept in RAM only\n");
+    }
+}
+
+void KvStore_HwRead(uint32_t offset, void* dst, uint32_t len) {
+#if KV_HAS_PARTITION
+    if (use_flash) {
+        flash_area_read(area, offset, dst, len);
+        return;
+    }
+#endif
+    memcpy(dst, &ram_flash[offset], len);
+}
+
+/* flash_area blocheaza doar firul apelant, fara schimbare de mod */
+void KvStore_HwBegin(void) {
+}
+
+void KvStore_HwEnd(void) {
+}
+
+bool KvStore_HwErase(uint8_t sector) {
+    uint32_t offset = (uint32_t)sector * KV_SECTOR_SIZE;
+
+#if KV_HAS_PARTITION
+    if (use_flash) {
+        return flash_area_erase(area, offset, KV_SECTOR_SIZE) == 0;
+    }
+#endif
+    memset(&ram_flash[offset], 0xFF, KV_SECTOR_SIZE);
+    return true;
+}
+
+bool KvStore_HwProgram(uint32_t offset, const uint32_t* src, uint32_t len) {
+#if KV_HAS_PARTITION
+    if (use_flash) {
+        return flash_area_write(area, offset, src, len) == 0;
+    }
+#endif
+    /* Ca pe flash: scrierea poate doar sa stearga biti */
+    const uint8_t* bytes = (const uint8_t*)src;
+    for (uint32_t i = 0; i < len; i++) {
+        ram_flash[offset + i] &= bytes[i];
+    }
+    return true;
+}
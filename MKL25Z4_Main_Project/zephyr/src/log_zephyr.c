@@ -0,0 +1,69 @@
+/*
+ * log_zephyr.c
+ * Golirea ringului din log.h prin printk, dintr-un k_work
+ *
+ * Consola Zephyr are deja driverul ei de UART, deci portul nu scrie in
+ * registre: Log_HwKick trimite un k_work in coada de sistem (sigur si din
+ * ISR), iar handler-ul strange octetii unei linii si o da lui printk. In
+ * bucla jocului LOG ramane doar copierea in ring, ca pe bare metal.
+ */
+
+#include <zephyr/kernel.h>
+#include "drivers/headers/log.h"
+
+/* printk vrea text; cadrele tokenizate sunt doar pentru UART-ul placii */
+#if defined(LOG_TOKENIZED)
+#error "LOG_TOKENIZED is supported only by log_kl25z.c"
+#endif
+
+/*============================================================================
+ * GLOBAL VARIABLES
+ *============================================================================*/
+
+static struct k_work drain_work;
+
+/*============================================================================
+ * CALLBACKS
+ *============================================================================*/
+
+static void DrainWork(struct k_work* work) {
+    static char text[LOG_LINE_MAX + 1];
+    uint8_t len = 0;
+    int16_t byte;
+
+    while ((byte = Log_NextByte()) >= 0) {
+        text[len++] = (char)byte;
+        if (byte == '\n' || len == LOG_LINE_MAX) {
+            text[len] = '\0';
+            printk("%s", text);
+            len = 0;
+        }
+    }
+    if (len) {
+        text[len] = '\0';
+        printk("%s", text);
+    }
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+void Log_HwInit(void) {
+    k_work_init(&drain_work, DrainWork);
+    printk("[LOG] Initialized: %u records, printk from the system workqueue\n", (unsigned int)LOG_RING_SIZE);
+}
+
+/* Producatorii pot fi si ISR-uri (NEC): irq_lock e sectiunea critica */
+uint32_t Log_HwLock(void) {
+    return irq_lock();
+}
+
+void Log_HwUnlock(uint32_t key) {
+    irq_unlock(key);
+}
+
+/* Deja in coada: k_work_submit nu il adauga a doua oara */
+void Log_HwKick(void) {
+    k_work_submit(&drain_work);
+}
@@ -0,0 +1,234 @@
+/*
+ * main.c (Zephyr)
+ * Thread-urile jocului Pong peste kernel-ul Zephyr
+ *
+ * Aceeasi impartire ca varianta FreeRTOS (source/pong_rtos.c):
+ * - input (prio 1): joystick + IR la 1 ms, evenimentele -> ui_msgq
+ * - game  (prio 2): App_GameTick la 50 Hz (k_timer), cat ruleaza meciul
+ * - ui    (main, prio 3): App_Init, evenimente, meniuri, game over
+ * Starea ecranelor e atinsa doar de ui; display-ul e sub display_mutex.
+ * Un thread de statistici afiseaza periodic frame rate-ul, traficul catre
+ * display, CPU-ul folosit si stiva ramasa pe fiecare thread.
+ */
+
+#include <zephyr/kernel.h>
+#include "drivers/headers/app.h"
+#include "drivers/headers/joystick.h"
+#include "drivers/headers/ir_remote.h"
+#include "drivers/headers/input_events.h"
+#include "pong_zephyr.h"
+
+/*============================================================================
+ * CONFIGURATION
+ *============================================================================*/
+
+#define GAME_PERIOD_MS      20
+#define UI_PERIOD_MS        50
+#define UI_QUEUE_LEN        16
+
+#define INPUT_PRIORITY      1
+#define GAME_PRIORITY       2
+#define STATS_PRIORITY      4
+
+#define INPUT_STACK_SIZE    1024
+#define GAME_STACK_SIZE     1536
+#define STATS_STACK_SIZE    1024
+
+/*============================================================================
+ * TYPES
+ *============================================================================*/
+
+typedef enum {
+    UI_MSG_INPUT = 0,
+    UI_MSG_GAME_OVER
+} UiMsgType_t;
+
+typedef struct {
+    uint8_t type;           /* UiMsgType_t */
+    InputEvent_t ev;
+} UiMsg_t;
+
+/*============================================================================
+ * GLOBAL VARIABLES
+ *============================================================================*/
+
+/* Timer global pentru modulele comune - incrementat de ms_timer */
+volatile uint32_t g_systick_ms = 0;
+
+static void MsTimerExpired(struct k_timer* timer) {
+    g_systick_ms++;
+}
+
+K_TIMER_DEFINE(ms_timer, MsTimerExpired, NULL);
+K_TIMER_DEFINE(input_timer, NULL, NULL);
+K_TIMER_DEFINE(game_timer, NULL, NULL);
+
+K_MSGQ_DEFINE(ui_msgq, sizeof(UiMsg_t), UI_QUEUE_LEN, 4);
+
+/* Thread-ul game are nevoie doar de ultima stare ceruta: ui o scrie in
+ * game_wanted, iar semaforul (maxim 1) il trezeste; give nu blocheaza si
+ * mai multe cereri intre doua treziri se reduc la ultima */
+static atomic_t game_wanted = ATOMIC_INIT(0);
+K_SEM_DEFINE(game_state_sem, 0, 1);
+K_MUTEX_DEFINE(display_mutex);
+
+static k_tid_t ui_tid;
+static uint32_t game_frames = 0;
+static uint32_t ui_queue_full = 0;
+
+/*============================================================================
+ * THREADS
+ *============================================================================*/
+
+static void InputThread(void* p1, void* p2, void* p3) {
+    UiMsg_t msg = { .type = UI_MSG_INPUT };
+
+    k_timer_start(&input_timer, K_MSEC(1), K_MSEC(1));
+
+    for (;;) {
+        k_timer_status_sync(&input_timer);
+
+        Joystick_Process();
+        IR_Process();
+
+        while (InputEvents_Pop(&msg.ev)) {
+            if (k_msgq_put(&ui_msgq, &msg, K_NO_WAIT) != 0) {
+                ui_queue_full++;
+            }
+        }
+    }
+}
+
+static void GameThread(void* p1, void* p2, void* p3) {
+    bool running = false;
+
+    for (;;) {
+        /* Oprit: asteapta o schimbare de stare. Pornit: o verifica intre frame-uri */
+        if (k_sem_take(&game_state_sem, running ? K_NO_WAIT : K_FOREVER) == 0 &&
+            (atomic_get(&game_wanted) != 0) != running) {
+            running = !running;
+            if (running) {
+                k_timer_start(&game_timer, K_MSEC(GAME_PERIOD_MS), K_MSEC(GAME_PERIOD_MS));
+            } else {
+                k_timer_stop(&game_timer);
+            }
+        }
+        if (!running) continue;
+
+        k_timer_status_sync(&game_timer);
+
+        /* Un STOP venit cat s-a asteptat frame-ul: fara inca un pas de joc */
+        if (k_sem_count_get(&game_state_sem) != 0U) continue;
+
+        k_mutex_lock(&display_mutex, K_FOREVER);
+        bool alive = App_GameTick();
+        k_mutex_unlock(&display_mutex);
+        game_frames++;
+
+        if (!alive) {
+            UiMsg_t msg = { .type = UI_MSG_GAME_OVER };
+
+            running = false;
+            k_timer_stop(&game_timer);
+            k_msgq_put(&ui_msgq, &msg, K_FOREVER);
+        }
+    }
+}
+
+K_THREAD_DEFINE(input_tid, INPUT_STACK_SIZE, InputThread, NULL, NULL, NULL,
+                INPUT_PRIORITY, 0, SYS_FOREVER_MS);
+K_THREAD_DEFINE(game_tid, GAME_STACK_SIZE, GameThread, NULL, NULL, NULL,
+                GAME_PRIORITY, 0, SYS_FOREVER_MS);
+
+/* Apelat din app.c cu display_mutex luat: starea noua, apoi trezirea */
+void App_SetGameRunning(bool running) {
+    atomic_set(&game_wanted, running ? 1 : 0);
+    k_sem_give(&game_state_sem);
+}
+
+/*============================================================================
+ * STATISTICS
+ *============================================================================*/
+
+#if CONFIG_PONG_STATS_PERIOD_MS > 0
+static void PrintThread(const char* name, k_tid_t tid) {
+    k_thread_runtime_stats_t rt;
+    size_t unused = 0;
+
+    k_thread_runtime_stats_get(tid, &rt);
+    k_thread_stack_space_get(tid, &unused);
+    printk("[STATS] %-6s cycles=%llu stack_free=%u\n", name,
+           (unsigned long long)rt.execution_cycles, (unsigned int)unused);
+}
+
+static void StatsThread(void* p1, void* p2, void* p3) {
+    k_thread_runtime_stats_t all, prev = {0};
+    PongDisplayStats_t ds, prev_ds = {0};
+    uint32_t prev_frames = 0;
+
+    for (;;) {
+        k_msleep(CONFIG_PONG_STATS_PERIOD_MS);
+
+        k_thread_runtime_stats_all_get(&all);
+        PongDisplay_GetStats(&ds);
+
+        uint64_t busy = all.total_cycles - prev.total_cycles;
+        uint64_t total = all.execution_cycles - prev.execution_cycles;
+        uint32_t frames = game_frames - prev_frames;
+
+        printk("[STATS] fps=%u cpu=%u%% lcd_writes=%u lcd_kB=%u lcd_ms=%u ui_full=%u\n",
+               (unsigned int)(frames * 1000U / CONFIG_PONG_STATS_PERIOD_MS),
+               (unsigned int)(total ? busy * 100U / total : 0),
+               (unsigned int)(ds.writes - prev_ds.writes),
+               (unsigned int)((ds.bytes - prev_ds.bytes) / 1024U),
+               (unsigned int)k_cyc_to_ms_floor32(ds.write_cycles - prev_ds.write_cycles),
+               (unsigned int)ui_queue_full);
+        PrintThread("input", input_tid);
+        PrintThread("game", game_tid);
+        if (ui_tid != NULL) PrintThread("ui", ui_tid);
+
+        prev = all;
+        prev_ds = ds;
+        prev_frames = game_frames;
+    }
+}
+
+K_THREAD_DEFINE(stats_tid, STATS_STACK_SIZE, StatsThread, NULL, NULL, NULL,
+                STATS_PRIORITY, 0, 0);
+#endif
+
+/*============================================================================
+ * MAIN (thread-ul ui)
+ *============================================================================*/
+
+int main(void) {
+    UiMsg_t msg;
+
+    ui_tid = k_current_get();
+    printk("\n=== PONG GAME - Zephyr (%s) ===\n", CONFIG_BOARD);
+
+    k_timer_start(&ms_timer, K_MSEC(1), K_MSEC(1));
+
+    /* Display, joystick, IR, intro */
+    App_Init();
+
+    k_thread_start(input_tid);
+    k_thread_start(game_tid);
+
+    for (;;) {
+        int got = k_msgq_get(&ui_msgq, &msg, K_MSEC(UI_PERIOD_MS));
+
+        k_mutex_lock(&display_mutex, K_FOREVER);
+        if (got == 0) {
+            if (msg.type == UI_MSG_GAME_OVER) {
+                App_GameOver();
+            } else {
+                App_HandleInput(&msg.ev);
+            }
+        }
+        App_Redraw();
+        k_mutex_unlock(&display_mutex);
+    }
+
+    return 0;
+}
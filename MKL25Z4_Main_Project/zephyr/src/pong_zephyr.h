@@ -0,0 +1,30 @@
+/*
+ * pong_zephyr.h
+ * Interfata interna a portului Zephyr (src/)
+ */
+
+#ifndef PONG_ZEPHYR_H
+#define PONG_ZEPHYR_H
+
+#include <stdint.h>
+
+/*============================================================================
+ * TYPES
+ *============================================================================*/
+
+typedef struct {
+    uint32_t writes;        /* Apeluri display_write */
+    uint32_t bytes;         /* Octeti de pixeli trimisi */
+    uint32_t write_cycles;  /* Timp petrecut in display_write (k_cycle_get_32) */
+} PongDisplayStats_t;
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+/**
+ * Contoarele de trafic catre display (st7735_zephyr.c)
+ */
+void PongDisplay_GetStats(PongDisplayStats_t* out);
+
+#endif /* PONG_ZEPHYR_H */
@@ -0,0 +1,261 @@
+/*
+ * st7735_zephyr.c
+ * API-ul din st7735_simple.h peste API-ul de display Zephyr
+ *
+ * Pe placa display-ul e driver-ul sitronix,st7735r (mipi_dbi peste SPI0),
+ * pe native_sim e display-ul SDL. display_write() e sincron, deci variantele
+ * "Async" apeleaza callback-ul inainte sa se intoarca - compositor-ul si
+ * meniurile functioneaza neschimbate.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/sys/byteorder.h>
+#include <string.h>
+#include "drivers/headers/st7735_simple.h"
+#include "pong_zephyr.h"
+
+/*============================================================================
+ * CONFIGURATION
+ *============================================================================*/
+
+/* Randuri trimise intr-un display_write la umplere (buffer pe stiva statica) */
+#define FILL_ROWS       8
+
+/*============================================================================
+ * GLOBAL VARIABLES
+ *============================================================================*/
+
+static const struct device* const display = DEVICE_DT_GET(DT_CHOSEN(zephyr_display));
+
+/* Pixeli in formatul cerut de driver */
+static uint16_t fill_buf[ST7735_WIDTH * FILL_ROWS];
+static uint16_t line_buf[ST7735_WIDTH];
+
+static PongDisplayStats_t stats;
+
+/*============================================================================
+ * PRIVATE FUNCTIONS
+ *============================================================================*/
+
+/* RGB565 in ordinea de octeti asteptata de driver */
+static inline uint16_t ToPanel(uint16_t color) {
+#if defined(CONFIG_PONG_DISPLAY_SWAP_BYTES)
+    return color;
+#else
+    return sys_cpu_to_be16(color);
+#endif
+}
+
+static void Write(int16_t x, int16_t y, int16_t w, int16_t h, const void* buf) {
+    struct display_buffer_descriptor desc = {
+        .buf_size = (uint32_t)w * h * 2U,
+        .width = (uint16_t)w,
+        .height = (uint16_t)h,
+        .pitch = (uint16_t)w,
+    };
+
+    uint32_t start = k_cycle_get_32();
+    display_write(display, (uint16_t)x, (uint16_t)y, &desc, buf);
+    stats.write_cycles += k_cycle_get_32() - start;
+
+    stats.writes++;
+    stats.bytes += desc.buf_size;
+}
+
+/* Decupeaza dreptunghiul la ecran; false daca nu ramane nimic */
+static bool Clip(int16_t* x, int16_t* y, int16_t* w, int16_t* h) {
+    if (*x < 0) { *w += *x; *x = 0; }
+    if (*y < 0) { *h += *y; *y = 0; }
+    if (*x + *w > ST7735_WIDTH) *w = ST7735_WIDTH - *x;
+    if (*y + *h > ST7735_HEIGHT) *h = ST7735_HEIGHT - *y;
+    return *w > 0 && *h > 0;
+}
+
+/* Desenare caracter pixel cu pixel - doar pentru text transparent */
+static void DrawCharTransparent(int16_t x, int16_t y, char c, uint16_t color, uint8_t size) {
+    const uint8_t* glyph = ST7735_GetGlyph(c);
+    if (glyph == NULL) return;
+
+    for (int8_t i = 0; i < 5; i++) {
+        for (int8_t j = 0; j < 7; j++) {
+            if (glyph[i] & (1 << j)) {
+                ST7735_FillRect(x + i * size, y + j * size, size, size, color);
+            }
+        }
+    }
+}
+
+/* Text opac: fiecare rand de font expandat o data, scris de `size` ori */
+static void DrawTextLine(int16_t x, int16_t y, const char* str, uint16_t len,
+                         uint16_t color, uint16_t bg, uint8_t size) {
+    if (len == 0 || size == 0) return;
+
+    int16_t w = len * FONT_WIDTH * size - size;
+    int16_t x0 = x < 0 ? 0 : x;
+    int16_t x1 = x + w - 1;
+    if (x1 >= ST7735_WIDTH) x1 = ST7735_WIDTH - 1;
+    if (x0 > x1) return;
+
+    uint16_t fg = ToPanel(color), bk = ToPanel(bg);
+
+    for (uint8_t row = 0; row < 7; row++) {
+        uint16_t* out = line_buf;
+        int16_t px = x;
+
+        for (uint16_t k = 0; k < len && px <= x1; k++) {
+            const uint8_t* glyph = ST7735_GetGlyph(str[k]);
+            for (uint8_t col = 0; col < FONT_WIDTH && px <= x1; col++) {
+                bool on = (glyph != NULL && col < 5 && (glyph[col] & (1 << row)));
+                for (uint8_t s = 0; s < size; s++, px++) {
+                    if (px >= x0 && px <= x1) *out++ = on ? fg : bk;
+                }
+            }
+        }
+
+        for (uint8_t r = 0; r < size; r++) {
+            int16_t py = y + row * size + r;
+            if (py >= 0 && py < ST7735_HEIGHT) {
+                Write(x0, py, x1 - x0 + 1, 1, line_buf);
+            }
+        }
+    }
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+void ST7735_Init(void) {
+    if (!device_is_ready(display)) {
+        printk("[LCD] %s not ready\n", display->name);
+        return;
+    }
+
+    display_blanking_off(display);
+    ST7735_FillScreen(COLOR_BLACK);
+
+    printk("[LCD] %s ready\n", display->name);
+}
+
+void ST7735_FillScreen(uint16_t color) {
+    ST7735_FillRect(0, 0, ST7735_WIDTH, ST7735_HEIGHT, color);
+}
+
+void ST7735_DrawPixel(int16_t x, int16_t y, uint16_t color) {
+    ST7735_FillRect(x, y, 1, 1, color);
+}
+
+void ST7735_FillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (!Clip(&x, &y, &w, &h)) return;
+
+    uint16_t px = ToPanel(color);
+    int16_t rows = (h < FILL_ROWS) ? h : FILL_ROWS;
+    for (int32_t i = 0; i < (int32_t)w * rows; i++) {
+        fill_buf[i] = px;
+    }
+
+    for (int16_t r = 0; r < h; r += rows) {
+        int16_t n = (h - r < rows) ? (h - r) : rows;
+        Write(x, y + r, w, n, fill_buf);
+    }
+}
+
+void ST7735_DrawHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    ST7735_FillRect(x, y, w, 1, color);
+}
+
+void ST7735_DrawVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    ST7735_FillRect(x, y, 1, h, color);
+}
+
+void ST7735_DrawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    ST7735_DrawHLine(x, y, w, color);
+    ST7735_DrawHLine(x, y + h - 1, w, color);
+    ST7735_DrawVLine(x, y, h, color);
+    ST7735_DrawVLine(x + w - 1, y, h, color);
+}
+
+bool ST7735_FillRectAsync(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color,
+                          ST7735_DoneCallback_t cb, void *ctx) {
+    ST7735_FillRect(x, y, w, h, color);
+    if (cb) cb(ctx);
+    return true;
+}
+
+bool ST7735_BlitAsync(int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t *pixels,
+                      ST7735_DoneCallback_t cb, void *ctx) {
+#if defined(CONFIG_PONG_DISPLAY_SWAP_BYTES)
+    /* Rand cu rand, cu octetii inversati */
+    for (int16_t r = 0; r < h; r++) {
+        const uint8_t* src = pixels + (uint32_t)r * w * 2;
+        for (int16_t i = 0; i < w; i++) {
+            line_buf[i] = sys_get_be16(src + i * 2);
+        }
+        Write(x, y + r, w, 1, line_buf);
+    }
+#else
+    Write(x, y, w, h, pixels);
+#endif
+    if (cb) cb(ctx);
+    return true;
+}
+
+bool ST7735_IsBusy(void) {
+    return false;
+}
+
+void ST7735_WaitIdle(void) {
+}
+
+void ST7735_DrawChar(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size) {
+    if (bg == color) {
+        DrawCharTransparent(x, y, c, color, size);
+    } else {
+        DrawTextLine(x, y, &c, 1, color, bg, size);
+    }
+}
+
+void ST7735_DrawString(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg) {
+    ST7735_DrawStringScaled(x, y, str, color, bg, 1);
+}
+
+void ST7735_DrawStringScaled(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size) {
+    if (bg != color) {
+        DrawTextLine(x, y, str, strlen(str), color, bg, size);
+        return;
+    }
+    while (*str) {
+        DrawCharTransparent(x, y, *str, color, size);
+        x += FONT_WIDTH * size;
+        str++;
+    }
+}
+
+void ST7735_DrawStringCentered(int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size) {
+    int16_t len = strlen(str);
+    int16_t x = (ST7735_WIDTH - len * FONT_WIDTH * size) / 2;
+    ST7735_DrawStringScaled(x, y, str, color, bg, size);
+}
+
+void ST7735_DrawMenuBox(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t borderColor, uint16_t fillColor) {
+    ST7735_FillRect(x + 1, y + 1, w - 2, h - 2, fillColor);
+    ST7735_DrawRect(x, y, w, h, borderColor);
+}
+
+#ifdef ST7735_STATS
+void ST7735_GetStats(ST7735_Stats_t *out) {
+    out->bytes = stats.bytes;
+    out->windows = stats.writes;
+    out->cs_toggles = stats.writes;
+}
+
+void ST7735_ResetStats(void) {
+    memset(&stats, 0, sizeof(stats));
+}
+#endif
+
+void PongDisplay_GetStats(PongDisplayStats_t* out) {
+    *out = stats;
+}